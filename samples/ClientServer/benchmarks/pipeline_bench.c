@@ -0,0 +1,293 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Measures the Read requests rate against a server as the number of requests in progress grows.
+ *
+ * Connects to the server without security and keeps N Read requests in progress using a completion queue
+ * (::SOPC_ClientHelperNew_ServiceAsyncToQueue), for N = 1, 2, 4, ... up to the given maximum.
+ * The synchronous service API (::SOPC_ClientHelperNew_ServiceSync) is measured first as a reference.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "libs2opc_client_config.h"
+#include "libs2opc_client_config_custom.h"
+#include "libs2opc_common_config.h"
+#include "libs2opc_new_client.h"
+#include "libs2opc_request_builder.h"
+
+#include "sopc_encodeable.h"
+#include "sopc_macros.h"
+#include "sopc_time.h"
+
+#define DEFAULT_ENDPOINT_URL "opc.tcp://localhost:4841"
+#define DEFAULT_MAX_CONCURRENCY 256
+#define DEFAULT_DURATION_MS 2000
+
+// Node read by each request (server current time)
+#define READ_NODE_ID "i=2258"
+
+// Maximum number of completions retrieved at once
+#define POLL_BATCH_SIZE 64
+
+static bool parse_uint32(const char* arg, uint32_t* value)
+{
+    char* end = NULL;
+    errno = 0;
+    unsigned long res = strtoul(arg, &end, 10);
+    if (0 != errno || NULL == end || '\0' != *end || 0 == res || res > UINT32_MAX)
+    {
+        return false;
+    }
+    *value = (uint32_t) res;
+    return true;
+}
+
+static void ClientConnectionEvent(SOPC_ClientConnection* config,
+                                  SOPC_ClientConnectionEvent event,
+                                  SOPC_StatusCode status)
+{
+    SOPC_UNUSED_ARG(config);
+    printf("# Unexpected connection event %d with status 0x%08" PRIX32 "\n", event, status);
+}
+
+static OpcUa_ReadRequest* new_read_request(void)
+{
+    OpcUa_ReadRequest* readReq = SOPC_ReadRequest_Create(1, OpcUa_TimestampsToReturn_Neither);
+    if (NULL != readReq &&
+        SOPC_STATUS_OK != SOPC_ReadRequest_SetReadValueFromStrings(readReq, 0, READ_NODE_ID, SOPC_AttributeId_Value,
+                                                                   NULL))
+    {
+        SOPC_Encodeable_Delete(&OpcUa_ReadRequest_EncodeableType, (void**) &readReq);
+    }
+    return readReq;
+}
+
+static SOPC_ReturnStatus send_read_request(SOPC_ClientConnection* connection, SOPC_ClientHelper_CompletionQueue* queue)
+{
+    OpcUa_ReadRequest* readReq = new_read_request();
+    if (NULL == readReq)
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    SOPC_ReturnStatus status = SOPC_ClientHelperNew_ServiceAsyncToQueue(connection, readReq, queue, 0);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Encodeable_Delete(&OpcUa_ReadRequest_EncodeableType, (void**) &readReq);
+    }
+    return status;
+}
+
+static bool is_good_read_response(const SOPC_ClientHelper_Completion* completion)
+{
+    return SOPC_STATUS_OK == completion->status && &OpcUa_ReadResponse_EncodeableType == completion->responseType &&
+           SOPC_IsGoodStatus(((OpcUa_ReadResponse*) completion->response)->ResponseHeader.ServiceResult);
+}
+
+static void print_result(const char* name, uint32_t concurrency, uint64_t nbRequests, int64_t elapsedUs)
+{
+    const double elapsedS = (double) (elapsedUs > 0 ? elapsedUs : 1) / 1e6;
+    const double rate = (double) nbRequests / elapsedS;
+    // Mean latency deduced from the number of requests in progress (Little's law)
+    printf("%s\t%" PRIu32 "\t%.0f\t%.3f\n", name, concurrency, rate, (double) concurrency * 1e3 / rate);
+}
+
+/* Sends one synchronous request at a time during the given duration */
+static bool bench_sync(SOPC_ClientConnection* connection, uint32_t durationMs)
+{
+    SOPC_RealTime* tStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tNow = SOPC_RealTime_Create(NULL);
+    bool ok = (NULL != tStart && NULL != tNow && SOPC_RealTime_GetTime(tStart));
+    uint64_t nbRequests = 0;
+    int64_t elapsedUs = 0;
+
+    while (ok && elapsedUs < (int64_t) durationMs * 1000)
+    {
+        OpcUa_ReadRequest* readReq = new_read_request();
+        OpcUa_ReadResponse* readResp = NULL;
+        ok = (NULL != readReq);
+        ok = ok && SOPC_STATUS_OK == SOPC_ClientHelperNew_ServiceSync(connection, readReq, (void**) &readResp);
+        ok = ok && SOPC_IsGoodStatus(readResp->ResponseHeader.ServiceResult);
+        SOPC_Encodeable_Delete(&OpcUa_ReadResponse_EncodeableType, (void**) &readResp);
+        nbRequests++;
+        ok = ok && SOPC_RealTime_GetTime(tNow);
+        elapsedUs = SOPC_RealTime_DeltaUs(tStart, tNow);
+    }
+
+    if (ok)
+    {
+        print_result("sync", 1, nbRequests, elapsedUs);
+    }
+    else
+    {
+        fprintf(stderr, "# Error: synchronous read failed\n");
+    }
+    SOPC_RealTime_Delete(&tStart);
+    SOPC_RealTime_Delete(&tNow);
+    return ok;
+}
+
+/* Keeps concurrency requests in progress during the given duration: a new request is sent for each completion */
+static bool bench_queue(SOPC_ClientConnection* connection,
+                        SOPC_ClientHelper_CompletionQueue* queue,
+                        uint32_t concurrency,
+                        uint32_t durationMs)
+{
+    SOPC_ClientHelper_Completion completions[POLL_BATCH_SIZE];
+    SOPC_RealTime* tStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tNow = SOPC_RealTime_Create(NULL);
+    bool ok = (NULL != tStart && NULL != tNow && SOPC_RealTime_GetTime(tStart));
+    bool sending = true;
+    uint64_t nbRequests = 0;
+    int64_t elapsedUs = 0;
+
+    for (uint32_t i = 0; ok && i < concurrency; i++)
+    {
+        ok = SOPC_STATUS_OK == send_read_request(connection, queue);
+    }
+
+    // Stop sending after the duration and wait for the requests in progress
+    while (ok && SOPC_ClientHelperNew_CompletionQueue_NbPending(queue) > 0)
+    {
+        const uint32_t nbPolled =
+            SOPC_ClientHelperNew_CompletionQueue_Poll(queue, completions, POLL_BATCH_SIZE, 2 * SOPC_REQUEST_TIMEOUT_MS);
+        ok = (nbPolled > 0);
+        for (uint32_t i = 0; i < nbPolled; i++)
+        {
+            ok = ok && is_good_read_response(&completions[i]);
+            SOPC_Encodeable_Delete(completions[i].responseType, &completions[i].response);
+        }
+        if (sending)
+        {
+            nbRequests += nbPolled;
+            ok = ok && SOPC_RealTime_GetTime(tNow);
+            elapsedUs = SOPC_RealTime_DeltaUs(tStart, tNow);
+            sending = elapsedUs < (int64_t) durationMs * 1000;
+        }
+        for (uint32_t i = 0; ok && sending && i < nbPolled; i++)
+        {
+            ok = SOPC_STATUS_OK == send_read_request(connection, queue);
+        }
+    }
+
+    if (ok)
+    {
+        print_result("queue", concurrency, nbRequests, elapsedUs);
+    }
+    else
+    {
+        fprintf(stderr, "# Error: read with %" PRIu32 " requests in progress failed\n", concurrency);
+    }
+    SOPC_RealTime_Delete(&tStart);
+    SOPC_RealTime_Delete(&tNow);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    const char* endpointUrl = DEFAULT_ENDPOINT_URL;
+    uint32_t maxConcurrency = DEFAULT_MAX_CONCURRENCY;
+    uint32_t durationMs = DEFAULT_DURATION_MS;
+
+    if (argc > 4 || (argc > 2 && !parse_uint32(argv[2], &maxConcurrency)) ||
+        (argc > 3 && !parse_uint32(argv[3], &durationMs)))
+    {
+        fprintf(stderr, "Usage: %s [ENDPOINT_URL [MAX_CONCURRENCY [DURATION_MS]]]\n", argv[0]);
+        fprintf(stderr, "  Defaults: %s, %d requests in progress, %d ms per measurement\n", DEFAULT_ENDPOINT_URL,
+                DEFAULT_MAX_CONCURRENCY, DEFAULT_DURATION_MS);
+        return 1;
+    }
+    if (argc > 1)
+    {
+        endpointUrl = argv[1];
+    }
+    if (maxConcurrency > SOPC_MAX_PENDING_REQUESTS)
+    {
+        maxConcurrency = SOPC_MAX_PENDING_REQUESTS;
+    }
+
+    SOPC_Log_Configuration logConfiguration = SOPC_Common_GetDefaultLogConfiguration();
+    logConfiguration.logSysConfig.fileSystemLogConfig.logDirPath = "./pipeline_bench_logs/";
+    logConfiguration.logLevel = SOPC_LOG_LEVEL_WARNING;
+    SOPC_ReturnStatus status = SOPC_CommonHelper_Initialize(&logConfiguration);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientConfigHelper_Initialize();
+    }
+
+    SOPC_SecureConnection_Config* connConfig = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        connConfig = SOPC_ClientConfigHelper_CreateSecureConnection(
+            "bench", endpointUrl, OpcUa_MessageSecurityMode_None, SOPC_SecurityPolicy_None);
+        status = (NULL == connConfig ? SOPC_STATUS_INVALID_PARAMETERS : SOPC_STATUS_OK);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_SecureConnectionConfig_SetAnonymous(connConfig, "anonymous");
+    }
+
+    SOPC_ClientConnection* connection = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_Connect(connConfig, ClientConnectionEvent, &connection);
+        if (SOPC_STATUS_OK != status)
+        {
+            fprintf(stderr, "# Error: connection to %s failed\n", endpointUrl);
+        }
+    }
+
+    SOPC_ClientHelper_CompletionQueue* queue = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        queue = SOPC_ClientHelperNew_CompletionQueue_Create();
+        status = (NULL == queue ? SOPC_STATUS_OUT_OF_MEMORY : SOPC_STATUS_OK);
+    }
+
+    bool ok = (SOPC_STATUS_OK == status);
+    if (ok)
+    {
+        printf("# Read of " READ_NODE_ID " on %s during %" PRIu32 " ms for each measurement\n", endpointUrl,
+               durationMs);
+        printf("# API\tconcurrency\trequests/s\tlatency (ms)\n");
+        ok = bench_sync(connection, durationMs);
+    }
+    for (uint32_t concurrency = 1; ok && concurrency <= maxConcurrency; concurrency *= 2)
+    {
+        ok = bench_queue(connection, queue, concurrency, durationMs);
+    }
+
+    if (NULL != queue)
+    {
+        SOPC_ClientHelperNew_CompletionQueue_Delete(&queue);
+    }
+    if (NULL != connection)
+    {
+        SOPC_ClientHelperNew_Disconnect(&connection);
+    }
+    SOPC_ClientConfigHelper_Clear();
+    SOPC_CommonHelper_Clear();
+    return (ok ? 0 : 1);
+}
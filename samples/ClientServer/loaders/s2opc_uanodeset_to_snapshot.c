@@ -0,0 +1,113 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "binary/sopc_addspace_snapshot.h"
+#include "sopc_helper_string.h"
+#include "xml_expat/sopc_uanodeset_loader.h"
+
+#define MAX_PARSE_THREADS 256
+
+static void usage(char** argv)
+{
+    printf(
+        "Usage: %s [--threads N] [--reciprocal-refs] XML_FILE SNAPSHOT_FILE\n\n"
+        "Parses an XML UANodeSet into an address space description\n"
+        "and writes it as an address space binary snapshot (format version %d).\n"
+        "The snapshot can then be loaded with SOPC_AddressSpaceSnapshot_LoadFile.\n\n"
+        "Options:\n"
+        "  --threads N        parse the UANodeSet nodes with N threads (1 to %d)\n"
+        "  --reciprocal-refs  add the missing reciprocal references between nodes\n",
+        argv[0], SOPC_ADDSPACE_SNAPSHOT_VERSION, MAX_PARSE_THREADS);
+}
+
+int main(int argc, char** argv)
+{
+    SOPC_UANodeSet_ParseOptions options = {1, false};
+    int argi = 1;
+
+    for (; argi < argc && strncmp(argv[argi], "--", 2) == 0; argi++)
+    {
+        if (strcmp(argv[argi], "--threads") == 0 && argi + 1 < argc)
+        {
+            argi++;
+            SOPC_ReturnStatus status = SOPC_strtouint32_t(argv[argi], &options.nbThreads, 10, '\0');
+            if (SOPC_STATUS_OK != status || 0 == options.nbThreads || options.nbThreads > MAX_PARSE_THREADS)
+            {
+                fprintf(stderr, "Invalid number of threads: %s\n", argv[argi]);
+                usage(argv);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[argi], "--reciprocal-refs") == 0)
+        {
+            options.generateReciprocalReferences = true;
+        }
+        else
+        {
+            usage(argv);
+            return 1;
+        }
+    }
+
+    if (argc - argi != 2)
+    {
+        usage(argv);
+        return 1;
+    }
+
+    const char* xml_filename = argv[argi];
+    const char* snapshot_filename = argv[argi + 1];
+
+    SOPC_UANodeSet_ParseReport report;
+    SOPC_AddressSpace* space = SOPC_UANodeSet_ParseFile(xml_filename, &options, &report);
+    bool ok = (space != NULL);
+
+    if (ok)
+    {
+        printf("Parsed %" PRIu32 " nodes with %" PRIu32 " thread(s), added %" PRIu32
+               " reciprocal references\n"
+               "  read %" PRIu64 " ms, split %" PRIu64 " ms, parse %" PRIu64 " ms, merge %" PRIu64
+               " ms, reciprocal references %" PRIu64 " ms, finalize %" PRIu64 " ms\n",
+               report.nbNodes, report.nbThreads, report.nbReciprocalRefs, report.readDuration, report.splitDuration,
+               report.parseDuration, report.mergeDuration, report.reciprocalRefDuration, report.finalizeDuration);
+
+        SOPC_ReturnStatus status = SOPC_AddressSpaceSnapshot_WriteFile(space, snapshot_filename);
+        ok = (SOPC_STATUS_OK == status);
+        if (!ok)
+        {
+            fprintf(stderr, "Error while writing snapshot %s (status %d)\n", snapshot_filename, (int) status);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Error while parsing %s\n", xml_filename);
+    }
+    SOPC_AddressSpace_Delete(space);
+
+    if (ok)
+    {
+        printf("Address space snapshot written successfully.\n");
+    }
+
+    return ok ? 0 : 1;
+}
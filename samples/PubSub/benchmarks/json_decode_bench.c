@@ -0,0 +1,254 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sopc_dataset_ll_layer.h"
+#include "sopc_helper_endianness_cfg.h"
+#include "sopc_network_layer.h"
+#include "sopc_pubsub_conf.h"
+#include "sopc_reader_layer.h"
+#include "sopc_time.h"
+
+#define DEFAULT_NB_MESSAGES 100000
+#define DEFAULT_NB_FIELDS 16
+
+#define BENCH_PUBLISHER_ID 46
+#define BENCH_GROUP_ID 42
+#define BENCH_GROUP_VERSION 1000
+#define BENCH_WRITER_ID 255
+
+typedef SOPC_NetworkMessage_Error_Code Bench_Read_Func(const SOPC_PubSubConnection* connection,
+                                                       SOPC_Buffer* buffer,
+                                                       SOPC_SubTargetVariableConfig* config,
+                                                       SOPC_UADP_GetSecurity_Func securityCBck,
+                                                       SOPC_UADP_IsWriterSequenceNumberNewer_Func snCBck);
+
+static bool parse_uint32(const char* arg, uint32_t* value)
+{
+    char* end = NULL;
+    errno = 0;
+    unsigned long res = strtoul(arg, &end, 10);
+    if (0 != errno || NULL == end || '\0' != *end || 0 == res || res > UINT32_MAX)
+    {
+        return false;
+    }
+    *value = (uint32_t) res;
+    return true;
+}
+
+/* Fields alternate between UInt32 and Double values */
+static SOPC_BuiltinId field_type(uint16_t index)
+{
+    return (0 == index % 2 ? SOPC_UInt32_Id : SOPC_Double_Id);
+}
+
+/* Builds a subscriber configuration with one reader of the benchmark DataSetMessage */
+static SOPC_PubSubConfiguration* build_sub_config(uint16_t nbFields)
+{
+    SOPC_PubSubConfiguration* config = SOPC_PubSubConfiguration_Create();
+    bool ok = (NULL != config && SOPC_PubSubConfiguration_Allocate_SubConnection_Array(config, 1));
+    SOPC_PubSubConnection* connection = (ok ? SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0) : NULL);
+    ok = ok && SOPC_PubSubConnection_Allocate_ReaderGroup_Array(connection, 1);
+    SOPC_ReaderGroup* group = (ok ? SOPC_PubSubConnection_Get_ReaderGroup_At(connection, 0) : NULL);
+    ok = ok && SOPC_ReaderGroup_Allocate_DataSetReader_Array(group, 1);
+    SOPC_DataSetReader* reader = (ok ? SOPC_ReaderGroup_Get_DataSetReader_At(group, 0) : NULL);
+    ok = ok && SOPC_DataSetReader_Allocate_FieldMetaData_Array(reader, SOPC_TargetVariablesDataType, nbFields);
+    if (ok)
+    {
+        SOPC_ReaderGroup_Set_PublisherId_UInteger(group, BENCH_PUBLISHER_ID);
+        SOPC_ReaderGroup_Set_GroupId(group, BENCH_GROUP_ID);
+        SOPC_ReaderGroup_Set_GroupVersion(group, BENCH_GROUP_VERSION);
+        SOPC_DataSetReader_Set_DataSetWriterId(reader, BENCH_WRITER_ID);
+        for (uint16_t i = 0; i < nbFields; i++)
+        {
+            SOPC_PubSub_ArrayDimension arrDimension = {.valueRank = -1, .arrayDimensions = NULL};
+            SOPC_FieldMetaData* fieldMetaData = SOPC_DataSetReader_Get_FieldMetaData_At(reader, i);
+            SOPC_FieldMetaData_ArrayDimension_Move(fieldMetaData, &arrDimension);
+            SOPC_FieldMetaData_Set_BuiltinType(fieldMetaData, field_type(i));
+        }
+    }
+    if (!ok)
+    {
+        SOPC_PubSubConfiguration_Delete(config);
+        config = NULL;
+    }
+    return config;
+}
+
+/* Builds the published NetworkMessage with one DataSetMessage */
+static SOPC_Dataset_LL_NetworkMessage* build_network_message(uint16_t nbFields)
+{
+    SOPC_Dataset_LL_NetworkMessage* nm = SOPC_Dataset_LL_NetworkMessage_Create(1, 1);
+    if (NULL == nm)
+    {
+        return NULL;
+    }
+    SOPC_Dataset_LL_NetworkMessage_Header* header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
+    SOPC_Dataset_LL_NetworkMessage_Set_PublisherId_Byte(header, BENCH_PUBLISHER_ID);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupId(nm, BENCH_GROUP_ID);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupVersion(nm, BENCH_GROUP_VERSION);
+
+    SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, 0);
+    SOPC_Dataset_LL_DataSetMsg_Set_WriterId(dsm, BENCH_WRITER_ID);
+    const SOPC_DataSet_LL_UadpDataSetMessageContentMask conf = {
+        .validFlag = true,
+        .fieldEncoding = DataSet_LL_FieldEncoding_Variant,
+        .dataSetMessageSequenceNumberFlag = true,
+        .statusFlag = false,
+        .configurationVersionMajorVersionFlag = false,
+        .configurationVersionMinorFlag = false,
+        .dataSetMessageType = DataSet_LL_MessageType_KeyFrame,
+        .timestampFlag = false,
+        .picoSecondsFlag = false,
+    };
+    SOPC_Dataset_LL_DataSetMsg_Set_ContentMask(dsm, &conf);
+    bool ok = SOPC_Dataset_LL_DataSetMsg_Allocate_DataSetField_Array(dsm, nbFields);
+    for (uint16_t i = 0; ok && i < nbFields; i++)
+    {
+        SOPC_Variant* variant = SOPC_Variant_Create();
+        ok = (NULL != variant);
+        if (ok)
+        {
+            variant->BuiltInTypeId = field_type(i);
+            if (SOPC_UInt32_Id == variant->BuiltInTypeId)
+            {
+                variant->Value.Uint32 = 1000000u + i;
+            }
+            else
+            {
+                variant->Value.Doublev = 3.14159 * (double) (i + 1);
+            }
+            ok = SOPC_Dataset_LL_DataSetMsg_Set_DataSetField_Variant_At(dsm, variant, i);
+        }
+    }
+    if (!ok)
+    {
+        SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+        nm = NULL;
+    }
+    return nm;
+}
+
+static SOPC_Buffer* encode_uadp(SOPC_Dataset_LL_NetworkMessage* nm)
+{
+    SOPC_Buffer* buffer = NULL;
+    SOPC_Buffer* buffer_payload = NULL;
+    SOPC_NetworkMessage_Error_Code code = SOPC_UADP_NetworkMessage_Encode_Buffers(nm, NULL, &buffer, &buffer_payload);
+    if (SOPC_NetworkMessage_Error_Code_None == code)
+    {
+        code = SOPC_UADP_NetworkMessage_BuildFinalMessage(NULL, buffer, &buffer_payload);
+    }
+    if (SOPC_NetworkMessage_Error_Code_None != code)
+    {
+        SOPC_Buffer_Delete(buffer);
+        buffer = NULL;
+    }
+    return buffer;
+}
+
+/* Decodes nbMessages times the message and measures the decoding throughput */
+static bool bench_decode(const char* name,
+                         Bench_Read_Func* readFunc,
+                         const SOPC_PubSubConnection* connection,
+                         SOPC_Buffer* buffer,
+                         uint32_t nbMessages)
+{
+    SOPC_RealTime* tStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tEnd = SOPC_RealTime_Create(NULL);
+    bool ok = (NULL != buffer && NULL != tStart && NULL != tEnd && SOPC_RealTime_GetTime(tStart));
+
+    for (uint32_t i = 0; ok && i < nbMessages; i++)
+    {
+        ok = SOPC_STATUS_OK == SOPC_Buffer_SetPosition(buffer, 0) &&
+             SOPC_NetworkMessage_Error_Code_None == readFunc(connection, buffer, NULL, NULL, NULL);
+    }
+    ok = ok && SOPC_RealTime_GetTime(tEnd);
+
+    if (ok)
+    {
+        const int64_t elapsedUs = SOPC_RealTime_DeltaUs(tStart, tEnd);
+        const double elapsedS = (double) (elapsedUs > 0 ? elapsedUs : 1) / 1e6;
+        printf("%s\t%" PRIu32 "\t%.0f\t%.1f\n", name, buffer->length, (double) nbMessages / elapsedS,
+               (double) nbMessages * (double) buffer->length / elapsedS / 1e6);
+    }
+    else
+    {
+        fprintf(stderr, "# Error: %s decoding failed\n", name);
+    }
+
+    SOPC_RealTime_Delete(&tStart);
+    SOPC_RealTime_Delete(&tEnd);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t nbMessages = DEFAULT_NB_MESSAGES;
+    uint32_t nbFields = DEFAULT_NB_FIELDS;
+
+    if (argc > 3 || (argc > 1 && !parse_uint32(argv[1], &nbMessages)) ||
+        (argc > 2 && (!parse_uint32(argv[2], &nbFields) || nbFields > UINT16_MAX)))
+    {
+        fprintf(stderr, "Usage: %s [NB_MESSAGES [NB_FIELDS]]\n", argv[0]);
+        fprintf(stderr, "  Defaults: %d messages of %d fields\n", DEFAULT_NB_MESSAGES, DEFAULT_NB_FIELDS);
+        return 1;
+    }
+
+    SOPC_Helper_Endianness_Check();
+
+    SOPC_PubSubConfiguration* config = build_sub_config((uint16_t) nbFields);
+    SOPC_Dataset_LL_NetworkMessage* nm = build_network_message((uint16_t) nbFields);
+    SOPC_Buffer* uadpBuffer = NULL;
+    SOPC_Buffer* jsonBuffer = NULL;
+    int res = 1;
+    if (NULL != config && NULL != nm)
+    {
+        uadpBuffer = encode_uadp(nm);
+        if (SOPC_NetworkMessage_Error_Code_None != SOPC_JSON_NetworkMessage_Encode(nm, NULL, &jsonBuffer))
+        {
+            jsonBuffer = NULL;
+        }
+    }
+
+    if (NULL != uadpBuffer && NULL != jsonBuffer)
+    {
+        const SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0);
+        printf("# %" PRIu32 " messages of %" PRIu32 " fields\n", nbMessages, nbFields);
+        printf("# Encoding\tbytes/msg\tdecoded msgs/s\tdecoded MB/s\n");
+        res = (bench_decode("UADP", SOPC_Reader_Read_UADP, connection, uadpBuffer, nbMessages) &&
+                       bench_decode("JSON", SOPC_Reader_Read_JSON, connection, jsonBuffer, nbMessages)
+                   ? 0
+                   : 1);
+    }
+    else
+    {
+        fprintf(stderr, "# Error: cannot build the benchmark messages\n");
+    }
+
+    SOPC_Buffer_Delete(uadpBuffer);
+    SOPC_Buffer_Delete(jsonBuffer);
+    SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+    SOPC_PubSubConfiguration_Delete(config);
+    return res;
+}
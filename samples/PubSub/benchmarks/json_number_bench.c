@@ -0,0 +1,212 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sopc_buffer.h"
+#include "sopc_mem_alloc.h"
+#include "sopc_time.h"
+
+#define DEFAULT_NB_VALUES 1000000
+
+// Length of the buffer used to print the numbers with snprintf
+#define PRINTF_BUFFER_LENGTH 32
+
+typedef enum
+{
+    BENCH_DOUBLE,
+    BENCH_FLOAT,
+    BENCH_INT32
+} Bench_Number_Type;
+
+typedef union
+{
+    double d;
+    float f;
+    int32_t i;
+} Bench_Number;
+
+static bool parse_uint32(const char* arg, uint32_t* value)
+{
+    char* end = NULL;
+    errno = 0;
+    unsigned long res = strtoul(arg, &end, 10);
+    if (0 != errno || NULL == end || '\0' != *end || 0 == res || res > UINT32_MAX)
+    {
+        return false;
+    }
+    *value = (uint32_t) res;
+    return true;
+}
+
+/* Deterministic pseudo-random generator (xorshift64) so that runs are comparable */
+static uint64_t next_random(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* Generates process measurement like values: a few significant digits with various magnitudes */
+static void generate_values(Bench_Number_Type type, Bench_Number* values, uint32_t nbValues)
+{
+    uint64_t state = UINT64_C(88172645463325252);
+    for (uint32_t i = 0; i < nbValues; i++)
+    {
+        const uint64_t r = next_random(&state);
+        const double d = (double) (int64_t)(r % 2000000 - 1000000) / (double) (1 + (r >> 32) % 10000);
+        switch (type)
+        {
+        case BENCH_DOUBLE:
+            values[i].d = d;
+            break;
+        case BENCH_FLOAT:
+            values[i].f = (float) d;
+            break;
+        case BENCH_INT32:
+        default:
+            values[i].i = (int32_t)(uint32_t) r;
+            break;
+        }
+    }
+}
+
+static SOPC_ReturnStatus print_with_snprintf(SOPC_Buffer* buf, Bench_Number_Type type, const Bench_Number* value)
+{
+    char buffer[PRINTF_BUFFER_LENGTH];
+    int res = 0;
+    switch (type)
+    {
+    case BENCH_DOUBLE:
+        // Precision needed to read back the same value
+        res = snprintf(buffer, PRINTF_BUFFER_LENGTH, "%.17g", value->d);
+        break;
+    case BENCH_FLOAT:
+        res = snprintf(buffer, PRINTF_BUFFER_LENGTH, "%.9g", (double) value->f);
+        break;
+    case BENCH_INT32:
+    default:
+        res = snprintf(buffer, PRINTF_BUFFER_LENGTH, "%" PRIi32, value->i);
+        break;
+    }
+    if (res <= 0 || res >= PRINTF_BUFFER_LENGTH)
+    {
+        return SOPC_STATUS_NOK;
+    }
+    return SOPC_Buffer_Write(buf, (const uint8_t*) buffer, (uint32_t) res);
+}
+
+static SOPC_ReturnStatus print_with_buffer(SOPC_Buffer* buf, Bench_Number_Type type, const Bench_Number* value)
+{
+    switch (type)
+    {
+    case BENCH_DOUBLE:
+        return SOPC_Buffer_PrintFloatDouble(buf, value->d);
+    case BENCH_FLOAT:
+        return SOPC_Buffer_PrintFloat(buf, value->f);
+    case BENCH_INT32:
+    default:
+        return SOPC_Buffer_PrintI32(buf, value->i);
+    }
+}
+
+/* Prints all the values with the given printer and reports the printing rate and the mean printed length */
+static bool bench_print(const char* name,
+                        SOPC_ReturnStatus (*printFunc)(SOPC_Buffer*, Bench_Number_Type, const Bench_Number*),
+                        Bench_Number_Type type,
+                        const Bench_Number* values,
+                        uint32_t nbValues,
+                        SOPC_Buffer* buf)
+{
+    SOPC_RealTime* tStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tEnd = SOPC_RealTime_Create(NULL);
+    bool ok = (NULL != tStart && NULL != tEnd && SOPC_RealTime_GetTime(tStart));
+    uint64_t nbBytes = 0;
+
+    for (uint32_t i = 0; ok && i < nbValues; i++)
+    {
+        SOPC_Buffer_Reset(buf);
+        ok = SOPC_STATUS_OK == printFunc(buf, type, &values[i]);
+        nbBytes += buf->length;
+    }
+    ok = ok && SOPC_RealTime_GetTime(tEnd);
+
+    if (ok)
+    {
+        const int64_t elapsedUs = SOPC_RealTime_DeltaUs(tStart, tEnd);
+        const double elapsedS = (double) (elapsedUs > 0 ? elapsedUs : 1) / 1e6;
+        printf("%s\t%.0f\t%.1f\t%.1f\n", name, (double) nbValues / elapsedS, elapsedS * 1e9 / (double) nbValues,
+               (double) nbBytes / (double) nbValues);
+    }
+    else
+    {
+        fprintf(stderr, "# Error: printing of %s failed\n", name);
+    }
+
+    SOPC_RealTime_Delete(&tStart);
+    SOPC_RealTime_Delete(&tEnd);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t nbValues = DEFAULT_NB_VALUES;
+
+    if (argc > 2 || (argc > 1 && !parse_uint32(argv[1], &nbValues)))
+    {
+        fprintf(stderr, "Usage: %s [NB_VALUES]\n", argv[0]);
+        fprintf(stderr, "  Defaults: %d values of each type\n", DEFAULT_NB_VALUES);
+        return 1;
+    }
+
+    Bench_Number* values = SOPC_Calloc(nbValues, sizeof(*values));
+    SOPC_Buffer* buf = SOPC_Buffer_Create(PRINTF_BUFFER_LENGTH);
+    if (NULL == values || NULL == buf)
+    {
+        fprintf(stderr, "# Error: cannot allocate the values\n");
+        SOPC_Free(values);
+        SOPC_Buffer_Delete(buf);
+        return 1;
+    }
+
+    static const char* typeNames[] = {"double", "float", "int32"};
+    printf("# %" PRIu32 " values of each type\n", nbValues);
+    printf("# Printer\tvalues/s\tns/value\tbytes/value\n");
+
+    bool ok = true;
+    for (Bench_Number_Type type = BENCH_DOUBLE; ok && type <= BENCH_INT32; type++)
+    {
+        char name[PRINTF_BUFFER_LENGTH];
+        generate_values(type, values, nbValues);
+        snprintf(name, sizeof(name), "%s/snprintf", typeNames[type]);
+        ok = bench_print(name, print_with_snprintf, type, values, nbValues, buf);
+        snprintf(name, sizeof(name), "%s/SOPC", typeNames[type]);
+        ok = ok && bench_print(name, print_with_buffer, type, values, nbValues, buf);
+    }
+
+    SOPC_Free(values);
+    SOPC_Buffer_Delete(buf);
+    return (ok ? 0 : 1);
+}
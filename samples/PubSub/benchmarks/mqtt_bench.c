@@ -0,0 +1,238 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sopc_atomic.h"
+#include "sopc_buffer.h"
+#include "sopc_macros.h"
+#include "sopc_mqtt_transport_layer.h"
+#include "sopc_time.h"
+
+static const char* DEFAULT_BROKER_URI = "127.0.0.1:1883";
+
+#define DEFAULT_NB_MESSAGES 10000
+#define DEFAULT_PAYLOAD_SIZE 64
+#define DEFAULT_MAX_INFLIGHT 100
+
+// Maximum time to wait for the connection of the clients
+#define CONNECTION_TIMEOUT_MS 5000
+// Maximum time to wait for the reception of the messages once all of them are sent
+#define RECEPTION_TIMEOUT_MS 30000
+// Pause when the in-flight window of the publisher is full
+#define SEND_RETRY_SLEEP_MS 1
+
+static int32_t nbFatalError = 0;
+static int32_t nbReceived = 0;
+
+static void on_fatal_error(void* userContext, const char* message)
+{
+    SOPC_UNUSED_ARG(userContext);
+    fprintf(stderr, "# Error: MQTT client fatal error: %s\n", message);
+    SOPC_Atomic_Int_Add(&nbFatalError, 1);
+}
+
+static void on_message_received(uint8_t* data, uint16_t size, void* user)
+{
+    SOPC_UNUSED_ARG(data);
+    SOPC_UNUSED_ARG(size);
+    SOPC_UNUSED_ARG(user);
+    SOPC_Atomic_Int_Add(&nbReceived, 1);
+}
+
+static bool wait_connected(MqttContextClient* client)
+{
+    for (int32_t remTimeMs = CONNECTION_TIMEOUT_MS; remTimeMs > 0 && !SOPC_MQTT_Client_Is_Connected(client);
+         remTimeMs -= 10)
+    {
+        SOPC_Sleep(10);
+    }
+    return SOPC_MQTT_Client_Is_Connected(client);
+}
+
+static bool parse_uint32(const char* arg, uint32_t* value)
+{
+    char* end = NULL;
+    errno = 0;
+    unsigned long res = strtoul(arg, &end, 10);
+    if (0 != errno || NULL == end || '\0' != *end || 0 == res || res > UINT32_MAX)
+    {
+        return false;
+    }
+    *value = (uint32_t) res;
+    return true;
+}
+
+/* Publishes nbMessages with the given QoS and measures the publishing and the end-to-end throughputs */
+static bool bench_qos(const char* uri,
+                      uint8_t qos,
+                      uint32_t nbMessages,
+                      SOPC_Buffer* payload,
+                      uint16_t maxInflight,
+                      double* pubRate,
+                      double* e2eRate)
+{
+    char topicName[32] = {0};
+    snprintf(topicName, sizeof(topicName), "s2opc/bench/qos%" PRIu8, qos);
+    const char* topic[1] = {topicName};
+
+    MqttContextClient* subClient = NULL;
+    MqttContextClient* pubClient = NULL;
+    SOPC_RealTime* tStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tSent = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* tReceived = SOPC_RealTime_Create(NULL);
+    bool ok = (NULL != tStart && NULL != tSent && NULL != tReceived);
+
+    SOPC_Atomic_Int_Set(&nbReceived, 0);
+    SOPC_Atomic_Int_Set(&nbFatalError, 0);
+
+    if (ok)
+    {
+        const uint8_t subQos[1] = {qos};
+        const SOPC_MQTT_Client_Options subOptions = {.subQos = subQos, .maxInflight = 0, .maxBufferedMessages = 0};
+        ok = SOPC_STATUS_OK == SOPC_MQTT_Create_Client(&subClient) &&
+             SOPC_STATUS_OK == SOPC_MQTT_Set_Client_Options(subClient, &subOptions) &&
+             SOPC_STATUS_OK == SOPC_MQTT_InitializeAndConnect_Client(subClient, uri, NULL, NULL, topic, 1,
+                                                                     on_message_received, on_fatal_error, NULL);
+    }
+    if (ok)
+    {
+        const SOPC_MQTT_Client_Options pubOptions = {
+            .subQos = NULL, .maxInflight = maxInflight, .maxBufferedMessages = 0};
+        ok = SOPC_STATUS_OK == SOPC_MQTT_Create_Client(&pubClient) &&
+             SOPC_STATUS_OK == SOPC_MQTT_Set_Client_Options(pubClient, &pubOptions) &&
+             SOPC_STATUS_OK == SOPC_MQTT_InitializeAndConnect_Client(pubClient, uri, NULL, NULL, NULL, 0, NULL,
+                                                                     on_fatal_error, NULL);
+    }
+    // Let the subscription be established once connected
+    ok = ok && wait_connected(subClient) && wait_connected(pubClient);
+    if (ok)
+    {
+        SOPC_Sleep(100);
+        ok = SOPC_RealTime_GetTime(tStart);
+    }
+
+    for (uint32_t i = 0; ok && i < nbMessages; i++)
+    {
+        // Sending fails while the in-flight window is full: retry once acknowledgements are received
+        while (SOPC_STATUS_OK != SOPC_MQTT_Send_Message_QoS(pubClient, topicName, *payload, qos, false))
+        {
+            if (0 != SOPC_Atomic_Int_Get(&nbFatalError) || !SOPC_MQTT_Client_Is_Connected(pubClient))
+            {
+                ok = false;
+                break;
+            }
+            SOPC_Sleep(SEND_RETRY_SLEEP_MS);
+        }
+    }
+    ok = ok && SOPC_RealTime_GetTime(tSent);
+
+    for (int32_t remTimeMs = RECEPTION_TIMEOUT_MS;
+         ok && remTimeMs > 0 && (uint32_t) SOPC_Atomic_Int_Get(&nbReceived) < nbMessages; remTimeMs--)
+    {
+        SOPC_Sleep(1);
+    }
+    ok = ok && SOPC_RealTime_GetTime(tReceived);
+
+    if (ok)
+    {
+        const uint32_t received = (uint32_t) SOPC_Atomic_Int_Get(&nbReceived);
+        const int64_t sentUs = SOPC_RealTime_DeltaUs(tStart, tSent);
+        const int64_t receivedUs = SOPC_RealTime_DeltaUs(tStart, tReceived);
+        *pubRate = (double) nbMessages * 1e6 / (double) (sentUs > 0 ? sentUs : 1);
+        *e2eRate = (double) received * 1e6 / (double) (receivedUs > 0 ? receivedUs : 1);
+        if (received < nbMessages)
+        {
+            fprintf(stderr, "# Warning: QoS %" PRIu8 ", only %" PRIu32 "/%" PRIu32 " messages received\n", qos,
+                    received, nbMessages);
+        }
+    }
+
+    if (NULL != pubClient)
+    {
+        SOPC_MQTT_Release_Client(pubClient);
+    }
+    if (NULL != subClient)
+    {
+        SOPC_MQTT_Release_Client(subClient);
+    }
+    SOPC_RealTime_Delete(&tStart);
+    SOPC_RealTime_Delete(&tSent);
+    SOPC_RealTime_Delete(&tReceived);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t nbMessages = DEFAULT_NB_MESSAGES;
+    uint32_t payloadSize = DEFAULT_PAYLOAD_SIZE;
+    uint32_t maxInflight = DEFAULT_MAX_INFLIGHT;
+    const char* uri = DEFAULT_BROKER_URI;
+
+    if (argc > 5 || (argc > 1 && !parse_uint32(argv[1], &nbMessages)) ||
+        (argc > 2 && (!parse_uint32(argv[2], &payloadSize) || payloadSize > SOPC_PUBSUB_BUFFER_SIZE)) ||
+        (argc > 3 && (!parse_uint32(argv[3], &maxInflight) || maxInflight > UINT16_MAX)))
+    {
+        fprintf(stderr, "Usage: %s [NB_MESSAGES [PAYLOAD_SIZE [MAX_INFLIGHT [BROKER_URI]]]]\n", argv[0]);
+        fprintf(stderr, "  Defaults: %d messages of %d bytes, %d messages in flight, broker %s\n",
+                DEFAULT_NB_MESSAGES, DEFAULT_PAYLOAD_SIZE, DEFAULT_MAX_INFLIGHT, DEFAULT_BROKER_URI);
+        return 1;
+    }
+    if (argc > 4)
+    {
+        uri = argv[4];
+    }
+
+    SOPC_Buffer* payload = SOPC_Buffer_Create(payloadSize);
+    if (NULL == payload)
+    {
+        fprintf(stderr, "# Error: cannot allocate the payload\n");
+        return 1;
+    }
+    memset(payload->data, 0xA5, payloadSize);
+    payload->length = payloadSize;
+
+    printf("# %" PRIu32 " messages of %" PRIu32 " bytes, %" PRIu32 " messages in flight, broker %s\n", nbMessages,
+           payloadSize, maxInflight, uri);
+    printf("# QoS\tpublished msgs/s\treceived msgs/s\n");
+
+    int res = 0;
+    for (uint8_t qos = 0; qos <= 2; qos++)
+    {
+        double pubRate = 0.;
+        double e2eRate = 0.;
+        if (bench_qos(uri, qos, nbMessages, payload, (uint16_t) maxInflight, &pubRate, &e2eRate))
+        {
+            printf("%" PRIu8 "\t%.0f\t%.0f\n", qos, pubRate, e2eRate);
+        }
+        else
+        {
+            fprintf(stderr, "# Error: benchmark of QoS %" PRIu8 " failed, is the broker %s running?\n", qos, uri);
+            res = 1;
+        }
+    }
+
+    SOPC_Buffer_Delete(payload);
+    return res;
+}
@@ -195,7 +195,7 @@ SOPC_ReturnStatus PubSub_Configure(void)
     SOPC_SubTargetVariableConfig* pTargetConfig = NULL;
     if (SOPC_STATUS_OK == status)
     {
-        pTargetConfig = SOPC_SubTargetVariableConfig_Create(&Server_SetTargetVariables);
+        pTargetConfig = SOPC_SubTargetVariableConfig_CreateBatched(&Server_SetTargetVariables, pPubSubConfig);
         if (NULL == pTargetConfig)
         {
             SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Cannot create Sub configuration");
@@ -331,6 +331,15 @@ SOPC_ReturnStatus PubSub_Configure(void)
         sksConfigLength = 0;
     }
 
+    if (SOPC_STATUS_OK == status)
+    {
+        status = Server_BindTargetVariables(pPubSubConfig);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Cannot bind Sub target variables");
+        }
+    }
+
     if (SOPC_STATUS_OK == status)
     {
         free_global_configurations();
@@ -357,6 +366,11 @@ SOPC_ReturnStatus PubSub_Configure(void)
     return status;
 }
 
+void PubSub_TargetVariablesWritten(void)
+{
+    SOPC_SubTargetVariableConfig_BatchDone(g_pTargetConfig);
+}
+
 bool PubSub_IsRunning(void)
 {
     return SOPC_Atomic_Int_Get(&pubsubOnline);
@@ -34,5 +34,7 @@ bool PubSub_Start(void);
 bool PubSub_IsRunning(void);
 void PubSub_Stop(void);
 void PubSub_StopAndClear(void);
+/* Shall be called when the target variables passed to Server_SetTargetVariables are written */
+void PubSub_TargetVariablesWritten(void);
 
 #endif /* PUBSUB_H */
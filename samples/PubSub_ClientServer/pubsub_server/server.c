@@ -28,6 +28,7 @@
 #include "sopc_askpass.h"
 #include "sopc_assert.h"
 #include "sopc_atomic.h"
+#include "sopc_dict.h"
 #include "sopc_encodeable.h"
 #include "sopc_helper_string.h"
 #include "sopc_logger.h"
@@ -51,6 +52,7 @@
 #include "client.h"
 #include "config.h"
 #include "helpers.h"
+#include "pubsub.h"
 #include "server.h"
 
 /* These variables could be stored in a struct Server_Context, which is then passed to all functions.
@@ -66,6 +68,12 @@ static SOPC_AddressSpace* address_space = NULL;
 static uint8_t lastPubSubCommand = 0;
 static char* lastPubSubConfigPath = NULL;
 
+/* Context of the local WriteRequests of the subscriber target variables */
+#define SERVER_TARGET_VARIABLES_WRITE_CONTEXT ((uintptr_t) 1)
+
+/* Handles of the subscriber target variables which values are updated without the Write service: NodeId => handle */
+static SOPC_Dict* targetVariableHandles = NULL;
+
 typedef enum PublisherSendStatus
 {
     PUBLISHER_ACYCLIC_NOT_TRIGGERED = 0,
@@ -562,6 +570,8 @@ void Server_StopAndClear(void)
         SOPC_Sleep(SLEEP_TIMEOUT);
     }
     SOPC_ServerConfigHelper_Clear();
+    SOPC_Dict_Delete(targetVariableHandles);
+    targetVariableHandles = NULL;
 
     if (NULL != lastPubSubConfigPath)
     {
@@ -903,26 +913,172 @@ void Server_SetSubStatusSync(SOPC_PubSubState state)
     Server_SetSubStatus(true, state);
 }
 
+/* Binds the target variable to the handle of its node if its whole Value attribute is written */
+static SOPC_ReturnStatus Server_BindTargetVariable(SOPC_Dict* handles, const SOPC_FieldTarget* target)
+{
+    const SOPC_NodeId* nodeId = SOPC_FieldTarget_Get_NodeId(target);
+    bool found = false;
+    SOPC_Dict_Get(handles, (uintptr_t) nodeId, &found);
+    if (found || SOPC_AttributeId_Value != SOPC_FieldTarget_Get_AttributeId(target) ||
+        NULL != SOPC_FieldTarget_Get_TargetIndexRange(target))
+    {
+        return SOPC_STATUS_OK;
+    }
+
+    SOPC_ServerHelper_NodeHandle* handle = NULL;
+    if (SOPC_STATUS_OK != SOPC_ServerHelper_GetNodeHandle(nodeId, &handle))
+    {
+        // Not a Variable of the address space: the Write service reports the error
+        return SOPC_STATUS_OK;
+    }
+
+    SOPC_NodeId* key = SOPC_Calloc(1, sizeof(*key));
+    SOPC_ReturnStatus status = (NULL != key ? SOPC_NodeId_Copy(key, nodeId) : SOPC_STATUS_OUT_OF_MEMORY);
+    if (SOPC_STATUS_OK == status && !SOPC_Dict_Insert(handles, (uintptr_t) key, (uintptr_t) handle))
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_NodeId_Clear(key);
+        SOPC_Free(key);
+    }
+    return status;
+}
+
+SOPC_ReturnStatus Server_BindTargetVariables(const SOPC_PubSubConfiguration* config)
+{
+    SOPC_Dict* handles = SOPC_NodeId_Dict_Create(true, NULL);
+    SOPC_ReturnStatus status = (NULL != handles ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+
+    const uint32_t nbConnections = SOPC_PubSubConfiguration_Nb_SubConnection(config);
+    for (uint32_t iConn = 0; SOPC_STATUS_OK == status && iConn < nbConnections; iConn++)
+    {
+        const SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, iConn);
+        const uint16_t nbGroups = SOPC_PubSubConnection_Nb_ReaderGroup(connection);
+        for (uint16_t iGroup = 0; SOPC_STATUS_OK == status && iGroup < nbGroups; iGroup++)
+        {
+            const SOPC_ReaderGroup* group = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, iGroup);
+            const uint8_t nbReaders = SOPC_ReaderGroup_Nb_DataSetReader(group);
+            for (uint8_t iReader = 0; SOPC_STATUS_OK == status && iReader < nbReaders; iReader++)
+            {
+                const SOPC_DataSetReader* reader = SOPC_ReaderGroup_Get_DataSetReader_At(group, iReader);
+                const uint16_t nbFields = SOPC_DataSetReader_Nb_FieldMetaData(reader);
+                for (uint16_t iField = 0; SOPC_STATUS_OK == status && iField < nbFields; iField++)
+                {
+                    const SOPC_FieldTarget* target =
+                        SOPC_FieldMetaData_Get_TargetVariable(SOPC_DataSetReader_Get_FieldMetaData_At(reader, iField));
+                    if (NULL != target)
+                    {
+                        status = Server_BindTargetVariable(handles, target);
+                    }
+                }
+            }
+        }
+    }
+
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Dict_Delete(handles);
+        return status;
+    }
+    SOPC_Dict_Delete(targetVariableHandles);
+    targetVariableHandles = handles;
+    return SOPC_STATUS_OK;
+}
+
+static void Server_ClearWriteValues(OpcUa_WriteValue* lwv, int32_t nbValues)
+{
+    for (int32_t i = 0; NULL != lwv && i < nbValues; i++)
+    {
+        OpcUa_WriteValue_Clear(&lwv[i]);
+    }
+    SOPC_Free(lwv);
+}
+
+/* Updates the values of the target variables bound to node handles without the Write service.
+ * Returns false without modifying the WriteValues if a target variable is not bound. */
+static bool Server_UpdateTargetVariables(OpcUa_WriteValue* lwv, int32_t nbValues)
+{
+    if (NULL == targetVariableHandles || NULL == lwv || 0 >= nbValues)
+    {
+        return false;
+    }
+    SOPC_ServerHelper_NodeHandle** handles = SOPC_Calloc((size_t) nbValues, sizeof(*handles));
+    if (NULL == handles)
+    {
+        return false;
+    }
+    bool found = true;
+    for (int32_t i = 0; found && i < nbValues; i++)
+    {
+        handles[i] = (SOPC_ServerHelper_NodeHandle*) SOPC_Dict_Get(targetVariableHandles,
+                                                                   (uintptr_t) &lwv[i].NodeId, &found);
+    }
+    SOPC_DataValue* values = (found ? SOPC_Calloc((size_t) nbValues, sizeof(*values)) : NULL);
+    if (NULL == values)
+    {
+        SOPC_Free(handles);
+        return false;
+    }
+
+    // The values are moved to the batch of updates, they are moved back in case of failure
+    for (int32_t i = 0; i < nbValues; i++)
+    {
+        values[i] = lwv[i].Value;
+        SOPC_DataValue_Initialize(&lwv[i].Value);
+    }
+    SOPC_ReturnStatus status = SOPC_ServerHelper_UpdateValues((size_t) nbValues, handles, values);
+    if (SOPC_STATUS_OK != status)
+    {
+        for (int32_t i = 0; i < nbValues; i++)
+        {
+            lwv[i].Value = values[i];
+        }
+    }
+    SOPC_Free(values);
+    SOPC_Free(handles);
+    return SOPC_STATUS_OK == status;
+}
+
 bool Server_SetTargetVariables(OpcUa_WriteValue* lwv, int32_t nbValues)
 {
+    /* The target variables are batched by the subscriber (see PubSub_Configure):
+     * returning false drops the batch, the next batch is started on next received values. */
     if (!Server_IsRunning())
     {
+        Server_ClearWriteValues(lwv, nbValues);
+        return false;
+    }
+
+    /* Target variables bound to node handles are updated without the Write service:
+     * the updates are applied in order by the server, the batch is done once they are submitted */
+    if (Server_UpdateTargetVariables(lwv, nbValues))
+    {
+        Server_ClearWriteValues(lwv, nbValues);
+        PubSub_TargetVariablesWritten();
         return true;
     }
 
     /* Encapsulate the WriteValues in a WriteRequest and send it as a local service,
-     * acknowledge before the toolkit answers */
+     * the batch is done when the toolkit answers */
     OpcUa_WriteRequest* request = NULL;
     SOPC_ReturnStatus status = SOPC_Encodeable_Create(&OpcUa_WriteRequest_EncodeableType, (void**) &request);
     SOPC_ASSERT(SOPC_STATUS_OK == status);
     if (NULL == request)
     {
+        Server_ClearWriteValues(lwv, nbValues);
         return false;
     }
 
     request->NoOfNodesToWrite = nbValues;
     request->NodesToWrite = lwv;
-    status = SOPC_ServerHelper_LocalServiceAsync(request, 0);
+    status = SOPC_ServerHelper_LocalServiceAsync(request, SERVER_TARGET_VARIABLES_WRITE_CONTEXT);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_UNUSED_RESULT(SOPC_Encodeable_Delete(&OpcUa_WriteRequest_EncodeableType, (void**) &request));
+        return false;
+    }
 
     return true;
 }
@@ -1040,8 +1196,21 @@ void Server_Treat_Local_Service_Response(SOPC_EncodeableType* type, void* respon
     else if (&OpcUa_WriteResponse_EncodeableType == type)
     {
         writeResponse = response;
-        // Service should have succeeded
-        SOPC_ASSERT(0 == (SOPC_GoodStatusOppositeMask & writeResponse->ResponseHeader.ServiceResult));
+        if (SERVER_TARGET_VARIABLES_WRITE_CONTEXT == userContext)
+        {
+            // The batch is done even if it failed, otherwise no other batch would be written
+            if (0 != (SOPC_GoodStatusOppositeMask & writeResponse->ResponseHeader.ServiceResult))
+            {
+                SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Failed writing target variables: 0x%08X",
+                                       (unsigned int) writeResponse->ResponseHeader.ServiceResult);
+            }
+            PubSub_TargetVariablesWritten();
+        }
+        else
+        {
+            // Service should have succeeded
+            SOPC_ASSERT(0 == (SOPC_GoodStatusOppositeMask & writeResponse->ResponseHeader.ServiceResult));
+        }
     }
     else
     {
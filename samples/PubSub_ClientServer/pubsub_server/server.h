@@ -63,6 +63,9 @@ SOPC_Array* Server_GetConfigurationPaths(void); /* Returns an array of char* */
 void Server_SetSubStatusAsync(SOPC_PubSubState state);
 void Server_SetSubStatusSync(SOPC_PubSubState state);
 
+/* Binds the target variables of the configuration to node handles, the other ones are written with the Write service.
+ * Shall be called before the subscriber is started with the configuration. */
+SOPC_ReturnStatus Server_BindTargetVariables(const SOPC_PubSubConfiguration* config);
 bool Server_SetTargetVariables(OpcUa_WriteValue* nodesToWrite, int32_t nbValues);
 SOPC_DataValue* Server_GetSourceVariables(OpcUa_ReadValueId* lrv, int32_t nbValues);
 
@@ -22,6 +22,7 @@
 #include "opcua_identifiers.h"
 #include "opcua_statuscodes.h"
 #include "sopc_address_space.h"
+#include "sopc_address_space_index_internal.h"
 #include "sopc_assert.h"
 #include "sopc_dict.h"
 #include "sopc_mem_alloc.h"
@@ -45,8 +46,10 @@ struct _SOPC_AddressSpace
     bool free_nodes;
     /* Set to true if the NodeId and SOPC_AddressSpace_Node are const */
     bool readOnlyNodes;
+    /* Set to true if the const_nodes and variables arrays shall be cleared and freed with the AddressSpace */
+    bool ownedReadOnlyNodes;
     /* Defined only if readOnlyNodes is true:
-     * - dict_nodes unused
+     * - dict_nodes unused, unless ownedReadOnlyNodes is true: it then indexes const_nodes by NodeId
      * - const_nodes used instead
      * - array of modifiable Variants,
      *   indexes are defined as UInt32 values in SOPC_AddressSpace_Node variants for all Variable nodes.
@@ -55,6 +58,8 @@ struct _SOPC_AddressSpace
     SOPC_AddressSpace_Node* const_nodes;
     uint32_t nb_variables;
     SOPC_Variant* variables;
+    /* References index, NULL when not built */
+    SOPC_AddressSpaceIndex* index;
 };
 
 void SOPC_AddressSpace_Node_Initialize(SOPC_AddressSpace* space,
@@ -443,7 +448,8 @@ SOPC_StatusCode SOPC_AddressSpace_Get_StatusCode(SOPC_AddressSpace* space, SOPC_
 {
     SOPC_ASSERT(space != NULL);
 
-    if (!space->readOnlyNodes)
+    // Owned read only nodes are not constant and keep the value status and source timestamp
+    if (!space->readOnlyNodes || space->ownedReadOnlyNodes)
     {
         return node->value_status;
     }
@@ -457,7 +463,7 @@ bool SOPC_AddressSpace_Set_StatusCode(SOPC_AddressSpace* space, SOPC_AddressSpac
 {
     SOPC_ASSERT(space != NULL);
 
-    if (!space->readOnlyNodes)
+    if (!space->readOnlyNodes || space->ownedReadOnlyNodes)
     {
         node->value_status = status;
         return true;
@@ -469,7 +475,7 @@ SOPC_Value_Timestamp SOPC_AddressSpace_Get_SourceTs(SOPC_AddressSpace* space, SO
 {
     SOPC_ASSERT(space != NULL);
 
-    if (!space->readOnlyNodes)
+    if (!space->readOnlyNodes || space->ownedReadOnlyNodes)
     {
         return node->value_source_ts;
     }
@@ -484,7 +490,7 @@ bool SOPC_AddressSpace_Set_SourceTs(SOPC_AddressSpace* space, SOPC_AddressSpace_
 {
     SOPC_ASSERT(space != NULL);
 
-    if (!space->readOnlyNodes)
+    if (!space->readOnlyNodes || space->ownedReadOnlyNodes)
     {
         node->value_source_ts = ts;
         return true;
@@ -576,6 +582,37 @@ SOPC_AddressSpace* SOPC_AddressSpace_CreateReadOnlyNodes(uint32_t nb_nodes,
     return result;
 }
 
+SOPC_AddressSpace* SOPC_AddressSpace_CreateOwnedReadOnlyNodes(uint32_t nb_nodes,
+                                                              SOPC_AddressSpace_Node* nodes,
+                                                              uint32_t nb_variables,
+                                                              SOPC_Variant* variables)
+{
+    SOPC_AddressSpace* result = SOPC_AddressSpace_CreateReadOnlyNodes(nb_nodes, nodes, nb_variables, variables);
+    if (NULL == result)
+    {
+        return NULL;
+    }
+
+    // Keys and values are parts of const_nodes: nothing to free
+    result->dict_nodes = SOPC_NodeId_Dict_Create(false, NULL);
+    bool res = (NULL != result->dict_nodes && SOPC_Dict_Reserve(result->dict_nodes, nb_nodes));
+    for (uint32_t i = 0; res && i < nb_nodes; i++)
+    {
+        res = SOPC_Dict_Insert(result->dict_nodes, (uintptr_t) SOPC_AddressSpace_Get_NodeId(result, &nodes[i]),
+                               (uintptr_t) &nodes[i]);
+    }
+
+    if (!res)
+    {
+        SOPC_Dict_Delete(result->dict_nodes);
+        SOPC_Free(result);
+        return NULL;
+    }
+    result->ownedReadOnlyNodes = true;
+
+    return result;
+}
+
 bool SOPC_AddressSpace_AreReadOnlyNodes(const SOPC_AddressSpace* space)
 {
     SOPC_ASSERT(space != NULL);
@@ -605,20 +642,89 @@ SOPC_ReturnStatus SOPC_AddressSpace_Append(SOPC_AddressSpace* space, SOPC_Addres
         }
     }
 
-    return SOPC_Dict_Insert(space->dict_nodes, (uintptr_t) id, (uintptr_t) node) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+    if (NULL != space->index)
+    {
+        bool found = false;
+        SOPC_Dict_Get(space->dict_nodes, (uintptr_t) id, &found);
+        if (found)
+        {
+            // The replaced node will be freed and is still referenced by the index
+            SOPC_AddressSpace_DropIndex(space);
+        }
+    }
+
+    if (!SOPC_Dict_Insert(space->dict_nodes, (uintptr_t) id, (uintptr_t) node))
+    {
+        return SOPC_STATUS_NOK;
+    }
+
+    if (NULL != space->index && SOPC_STATUS_OK != SOPC_AddressSpaceIndex_AddNode(space->index, node))
+    {
+        // Index is not consistent anymore
+        SOPC_AddressSpace_DropIndex(space);
+    }
+
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpace_BuildIndex(SOPC_AddressSpace* space)
+{
+    SOPC_ASSERT(space != NULL);
+
+    SOPC_AddressSpace_DropIndex(space);
+    space->index = SOPC_AddressSpaceIndex_Create(space);
+
+    return NULL != space->index ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
+}
+
+SOPC_AddressSpaceIndex* SOPC_AddressSpace_Get_Index(const SOPC_AddressSpace* space)
+{
+    SOPC_ASSERT(space != NULL);
+    return space->index;
+}
+
+void SOPC_AddressSpace_DropIndex(SOPC_AddressSpace* space)
+{
+    SOPC_ASSERT(space != NULL);
+
+    SOPC_AddressSpaceIndex_Delete(space->index);
+    space->index = NULL;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpace_Reserve(SOPC_AddressSpace* space, size_t nb_nodes)
+{
+    SOPC_ASSERT(space != NULL);
+
+    if (space->readOnlyNodes)
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+
+    return SOPC_Dict_Reserve(space->dict_nodes, nb_nodes) ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
 }
 
 void SOPC_AddressSpace_Delete(SOPC_AddressSpace* space)
 {
     if (NULL != space)
     {
+        SOPC_AddressSpace_DropIndex(space);
         SOPC_Dict_Delete(space->dict_nodes);
         space->dict_nodes = NULL;
         for (uint32_t i = 0; i < space->nb_variables; i++)
         {
             SOPC_Variant_Clear(&space->variables[i]);
         }
-        // Do not free variables array which was provided as input
+        if (space->ownedReadOnlyNodes)
+        {
+            // Variable nodes Value field only contains an index in variables array
+            for (uint32_t i = 0; i < space->nb_nodes; i++)
+            {
+                SOPC_AddressSpace_Node_Clear_Local(&space->const_nodes[i]);
+            }
+            SOPC_Free(space->const_nodes);
+            SOPC_Free(space->variables);
+        }
+        // Do not free variables array which was provided as input otherwise
         space->nb_nodes = 0;
         space->const_nodes = NULL;
         space->nb_variables = 0;
@@ -631,7 +737,7 @@ SOPC_AddressSpace_Node* SOPC_AddressSpace_Get_Node(SOPC_AddressSpace* space, con
 {
     SOPC_ASSERT(space != NULL);
 
-    if (!space->readOnlyNodes)
+    if (!space->readOnlyNodes || space->ownedReadOnlyNodes)
     {
         return (SOPC_AddressSpace_Node*) SOPC_Dict_Get(space->dict_nodes, (uintptr_t) key, found);
     }
@@ -115,8 +115,36 @@ SOPC_AddressSpace* SOPC_AddressSpace_CreateReadOnlyNodes(uint32_t nb_nodes,
                                                          uint32_t nb_variables,
                                                          SOPC_Variant* variables);
 
+/**
+ * \brief Create an AddressSpace with read only nodes as ::SOPC_AddressSpace_CreateReadOnlyNodes does,
+ *        except that the AddressSpace takes ownership of the given arrays and indexes the nodes by NodeId.
+ *        It is intended for nodes arrays built at runtime (e.g. decoded from an AddressSpace snapshot)
+ *        which are too large to be searched linearly.
+ *
+ * \note  Contrary to ::SOPC_AddressSpace_CreateReadOnlyNodes, the Variable nodes value status and source timestamp are
+ *        kept in the nodes and are modifiable (see ::SOPC_AddressSpace_Set_StatusCode).
+ *
+ * \note  On call to ::SOPC_AddressSpace_Delete, each node is cleared and the nodes and variables arrays are freed.
+ *
+ * \warning The NodeManagement services are incompatible with an AddressSpace created with this function
+ *
+ * \param nb_nodes      the number of nodes in the nodes array
+ * \param nodes         the array of nodes allocated with ::SOPC_Calloc,
+ *                      the Variable nodes Value field shall contain
+ *                      the index in the variables array containing the actual value as a single UInt32 value.
+ * \param nb_variables  the number of variants in the variables array
+ * \param variables     the array allocated with ::SOPC_Calloc containing the actual Variable nodes Value field.
+ *
+ * \return the created read only nodes AddressSpace or NULL in case of failure (arrays are not freed in this case)
+ */
+SOPC_AddressSpace* SOPC_AddressSpace_CreateOwnedReadOnlyNodes(uint32_t nb_nodes,
+                                                              SOPC_AddressSpace_Node* nodes,
+                                                              uint32_t nb_variables,
+                                                              SOPC_Variant* variables);
+
 /**
  * \brief Returns true if the AddressSpace has been created using ::SOPC_AddressSpace_CreateReadOnlyNodes
+ *        or ::SOPC_AddressSpace_CreateOwnedReadOnlyNodes
  *
  * \param space  the AddressSpace to be evaluated
  *
@@ -135,6 +163,18 @@ bool SOPC_AddressSpace_AreReadOnlyNodes(const SOPC_AddressSpace* space);
  */
 SOPC_ReturnStatus SOPC_AddressSpace_Append(SOPC_AddressSpace* space, SOPC_AddressSpace_Node* node);
 
+/**
+ * \brief Reserves room for the given number of nodes in the AddressSpace,
+ *        avoiding successive resizing of the nodes index when appending a known number of nodes.
+ *
+ * \param space     the AddressSpace in which nodes will be appended
+ * \param nb_nodes  the total number of nodes expected in the AddressSpace
+ *
+ * \return       SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_STATE if the AddressSpace nodes are read only
+ *               and SOPC_STATUS_OUT_OF_MEMORY in case of allocation failure.
+ */
+SOPC_ReturnStatus SOPC_AddressSpace_Reserve(SOPC_AddressSpace* space, size_t nb_nodes);
+
 /**
  * \brief Deletes the AddressSpace content.
  *        It clears the Variable / VariableType nodes values and clear/free each node when
@@ -556,7 +556,7 @@ SOPC_StatusCode SOPC_AddressSpaceAccess_AddVariableNode(SOPC_AddressSpaceAccess*
         // Set hierarchical reference to parent
         OpcUa_ReferenceNode* hierarchicalRef = &varNode->References[1];
         hierarchicalRef->IsInverse = true;
-        status = SOPC_NodeId_Copy(&hierarchicalRef->ReferenceTypeId, &typeDefId->NodeId);
+        status = SOPC_NodeId_Copy(&hierarchicalRef->ReferenceTypeId, refTypeId);
         if (SOPC_STATUS_OK == status)
         {
             status = SOPC_ExpandedNodeId_Copy(&hierarchicalRef->TargetId, parentNodeId);
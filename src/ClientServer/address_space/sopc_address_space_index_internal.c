@@ -0,0 +1,673 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "sopc_address_space_index_internal.h"
+
+#include "sopc_address_space_utils_internal.h"
+#include "sopc_assert.h"
+#include "sopc_dict.h"
+#include "sopc_hash.h"
+#include "sopc_macros.h"
+#include "sopc_mem_alloc.h"
+
+/* References of a node with the same ReferenceType and direction */
+typedef struct refs_group_t
+{
+    bool isForward;
+    SOPC_Array* refIndexes; // int32_t, ascending order, never empty
+} refs_group_t;
+
+typedef struct node_index_t
+{
+    SOPC_Array* groups; // refs_group_t
+} node_index_t;
+
+/* Special values of the type hierarchy indexes */
+#define NO_PARENT_TYPE SIZE_MAX
+#define UNKNOWN_PARENT_TYPE (SIZE_MAX - 1)
+
+struct SOPC_AddressSpaceIndex
+{
+    SOPC_AddressSpace* space;
+
+    /* Types hierarchy: forest of the type nodes of the space, numbered in depth-first order.
+     * A type is a transitive subtype of another if its number is in the interval of the other type subtree. */
+    bool typesReady;      // Set when the hierarchy is computed
+    SOPC_Dict* types;     // const SOPC_NodeId* => uintptr_t index of the type
+    SOPC_Array* typeIds;  // const SOPC_NodeId* of the type for each index
+    size_t* directParent; // Index of the direct parent type, NO_PARENT_TYPE or UNKNOWN_PARENT_TYPE (not indexed)
+    size_t* firstInTree;  // Depth-first number of the type
+    size_t* lastInTree;   // Greatest depth-first number of the type subtree
+
+    /* Nodes references */
+    SOPC_Dict* nodes; // SOPC_AddressSpace_Node* => node_index_t*
+};
+
+static uint64_t ptr_hash(const uintptr_t data)
+{
+    return SOPC_DJBHash((const uint8_t*) &data, sizeof(uintptr_t));
+}
+
+static bool ptr_equal(const uintptr_t a, const uintptr_t b)
+{
+    return a == b;
+}
+
+static uint64_t nodeid_hash(const uintptr_t data)
+{
+    uint64_t hash = 0;
+    SOPC_NodeId_Hash((const SOPC_NodeId*) data, &hash);
+    return hash;
+}
+
+static bool nodeid_equal(const uintptr_t a, const uintptr_t b)
+{
+    return SOPC_NodeId_Equal((const SOPC_NodeId*) a, (const SOPC_NodeId*) b);
+}
+
+static void node_index_free(uintptr_t data)
+{
+    node_index_t* nodeIndex = (node_index_t*) data;
+
+    if (NULL != nodeIndex)
+    {
+        size_t nbGroups = SOPC_Array_Size(nodeIndex->groups);
+        for (size_t i = 0; i < nbGroups; i++)
+        {
+            refs_group_t* group = SOPC_Array_Get_Ptr(nodeIndex->groups, i);
+            SOPC_Array_Delete(group->refIndexes);
+        }
+        SOPC_Array_Delete(nodeIndex->groups);
+        SOPC_Free(nodeIndex);
+    }
+}
+
+/* Note: references array might be reallocated when a reference is added, the type is retrieved from it each time */
+static const SOPC_NodeId* get_group_ref_type(SOPC_AddressSpace* space,
+                                             SOPC_AddressSpace_Node* node,
+                                             const refs_group_t* group)
+{
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, node);
+    return &refs[SOPC_Array_Get(group->refIndexes, int32_t, 0)].ReferenceTypeId;
+}
+
+/*
+ * Types hierarchy
+ */
+
+static bool is_type_node_class(OpcUa_NodeClass nodeClass)
+{
+    return OpcUa_NodeClass_ObjectType == nodeClass || OpcUa_NodeClass_VariableType == nodeClass ||
+           OpcUa_NodeClass_DataType == nodeClass || OpcUa_NodeClass_ReferenceType == nodeClass;
+}
+
+static bool get_type_index(const SOPC_AddressSpaceIndex* index, const SOPC_NodeId* typeId, size_t* typeIdx)
+{
+    bool found = false;
+    *typeIdx = (size_t) SOPC_Dict_Get(index->types, (uintptr_t) typeId, &found);
+    return found;
+}
+
+static void collect_type(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_AddressSpaceIndex* index = (SOPC_AddressSpaceIndex*) user_data;
+    const SOPC_AddressSpace_Node* node = (const SOPC_AddressSpace_Node*) value;
+
+    if (is_type_node_class(node->node_class) && NULL != index->typeIds)
+    {
+        const SOPC_NodeId* typeId = (const SOPC_NodeId*) key;
+        size_t typeIdx = SOPC_Array_Size(index->typeIds);
+        if (!SOPC_Array_Append(index->typeIds, typeId) ||
+            !SOPC_Dict_Insert(index->types, (uintptr_t) typeId, (uintptr_t) typeIdx))
+        {
+            // Stops the collect and indicates the failure
+            SOPC_Array_Delete(index->typeIds);
+            index->typeIds = NULL;
+        }
+    }
+}
+
+/* Returns the closest ancestor of the type which is indexed, the types which are not in the space are skipped */
+static size_t get_indexed_ancestor(SOPC_AddressSpaceIndex* index, size_t typeIdx)
+{
+    if (UNKNOWN_PARENT_TYPE != index->directParent[typeIdx])
+    {
+        return index->directParent[typeIdx];
+    }
+
+    const SOPC_NodeId* current = SOPC_Array_Get(index->typeIds, const SOPC_NodeId*, typeIdx);
+    size_t ancestorIdx = NO_PARENT_TYPE;
+    for (int i = 0; NO_PARENT_TYPE == ancestorIdx && NULL != current && i < RECURSION_LIMIT; i++)
+    {
+        current = SOPC_AddressSpaceUtil_GetDirectParentType(index->space, current);
+        if (NULL != current && !get_type_index(index, current, &ancestorIdx))
+        {
+            ancestorIdx = NO_PARENT_TYPE;
+        }
+    }
+
+    return ancestorIdx;
+}
+
+/* Numbers the types in depth-first order: types in a cycle are not reachable and keep a 0 number */
+static bool number_types(SOPC_AddressSpaceIndex* index, const size_t* ancestors, size_t nbTypes)
+{
+    // Children of each type: children[childrenStart[i], childrenStart[i + 1]) with counting sort
+    size_t* childrenStart = SOPC_Calloc(nbTypes + 1, sizeof(size_t));
+    size_t* children = SOPC_Calloc(nbTypes, sizeof(size_t));
+    size_t* stack = SOPC_Calloc(nbTypes, sizeof(size_t));
+    size_t* nextChild = SOPC_Calloc(nbTypes, sizeof(size_t));
+    bool ok = (NULL != childrenStart && NULL != children && NULL != stack && NULL != nextChild);
+
+    for (size_t i = 0; ok && i < nbTypes; i++)
+    {
+        if (NO_PARENT_TYPE != ancestors[i])
+        {
+            childrenStart[ancestors[i] + 1]++;
+        }
+    }
+    for (size_t i = 0; ok && i < nbTypes; i++)
+    {
+        childrenStart[i + 1] += childrenStart[i];
+        nextChild[i] = childrenStart[i];
+    }
+    for (size_t i = 0; ok && i < nbTypes; i++)
+    {
+        if (NO_PARENT_TYPE != ancestors[i])
+        {
+            children[nextChild[ancestors[i]]] = i;
+            nextChild[ancestors[i]]++;
+        }
+    }
+
+    // Iterative depth-first traversal from each root type, numbers start from 1
+    size_t number = 0;
+    for (size_t root = 0; ok && root < nbTypes; root++)
+    {
+        if (NO_PARENT_TYPE != ancestors[root])
+        {
+            continue;
+        }
+        size_t depth = 0;
+        stack[depth] = root;
+        nextChild[root] = childrenStart[root];
+        number++;
+        index->firstInTree[root] = number;
+        while (depth > 0 || nextChild[root] < childrenStart[root + 1])
+        {
+            size_t current = stack[depth];
+            if (nextChild[current] < childrenStart[current + 1])
+            {
+                size_t child = children[nextChild[current]];
+                nextChild[current]++;
+                depth++;
+                stack[depth] = child;
+                nextChild[child] = childrenStart[child];
+                number++;
+                index->firstInTree[child] = number;
+            }
+            else
+            {
+                index->lastInTree[current] = number;
+                depth--;
+            }
+        }
+        index->lastInTree[root] = number;
+    }
+
+    SOPC_Free(childrenStart);
+    SOPC_Free(children);
+    SOPC_Free(stack);
+    SOPC_Free(nextChild);
+
+    return ok;
+}
+
+static bool build_types_hierarchy(SOPC_AddressSpaceIndex* index)
+{
+    index->types = SOPC_Dict_Create((uintptr_t) NULL, nodeid_hash, nodeid_equal, NULL, NULL);
+    index->typeIds = SOPC_Array_Create(sizeof(const SOPC_NodeId*), 256, NULL);
+
+    if (NULL == index->types || NULL == index->typeIds)
+    {
+        return false;
+    }
+
+    SOPC_AddressSpace_ForEach(index->space, collect_type, (uintptr_t) index);
+
+    if (NULL == index->typeIds)
+    {
+        return false;
+    }
+
+    size_t nbTypes = SOPC_Array_Size(index->typeIds);
+    if (0 == nbTypes)
+    {
+        index->typesReady = true;
+        return true;
+    }
+
+    index->directParent = SOPC_Calloc(nbTypes, sizeof(size_t));
+    index->firstInTree = SOPC_Calloc(nbTypes, sizeof(size_t));
+    index->lastInTree = SOPC_Calloc(nbTypes, sizeof(size_t));
+    size_t* ancestors = SOPC_Calloc(nbTypes, sizeof(size_t));
+
+    bool ok = (NULL != index->directParent && NULL != index->firstInTree && NULL != index->lastInTree &&
+               NULL != ancestors);
+
+    for (size_t i = 0; ok && i < nbTypes; i++)
+    {
+        const SOPC_NodeId* typeId = SOPC_Array_Get(index->typeIds, const SOPC_NodeId*, i);
+        const SOPC_NodeId* parent = SOPC_AddressSpaceUtil_GetDirectParentType(index->space, typeId);
+        size_t parentIdx = NO_PARENT_TYPE;
+        if (NULL != parent && !get_type_index(index, parent, &parentIdx))
+        {
+            parentIdx = UNKNOWN_PARENT_TYPE;
+        }
+        index->directParent[i] = parentIdx;
+    }
+    for (size_t i = 0; ok && i < nbTypes; i++)
+    {
+        ancestors[i] = get_indexed_ancestor(index, i);
+    }
+
+    ok = ok && number_types(index, ancestors, nbTypes);
+    SOPC_Free(ancestors);
+    index->typesReady = ok;
+
+    return ok;
+}
+
+bool SOPC_AddressSpaceIndex_IsTransitiveSubtype(const SOPC_AddressSpaceIndex* index,
+                                                const SOPC_NodeId* type,
+                                                const SOPC_NodeId* parentType,
+                                                bool* isSubtype)
+{
+    SOPC_ASSERT(NULL != index);
+    SOPC_ASSERT(NULL != isSubtype);
+
+    size_t typeIdx = 0;
+    size_t parentIdx = 0;
+
+    if (!index->typesReady || !get_type_index(index, type, &typeIdx) || !get_type_index(index, parentType, &parentIdx))
+    {
+        return false;
+    }
+
+    size_t first = index->firstInTree[typeIdx];
+    if (0 == first || 0 == index->firstInTree[parentIdx])
+    {
+        // Type in a cycle of the hierarchy
+        return false;
+    }
+
+    *isSubtype = index->firstInTree[parentIdx] < first && first <= index->lastInTree[parentIdx];
+    return true;
+}
+
+bool SOPC_AddressSpaceIndex_GetDirectParentType(const SOPC_AddressSpaceIndex* index,
+                                                const SOPC_NodeId* type,
+                                                const SOPC_NodeId** parentType)
+{
+    SOPC_ASSERT(NULL != index);
+    SOPC_ASSERT(NULL != parentType);
+
+    size_t typeIdx = 0;
+
+    if (!index->typesReady || !get_type_index(index, type, &typeIdx) ||
+        UNKNOWN_PARENT_TYPE == index->directParent[typeIdx])
+    {
+        return false;
+    }
+
+    if (NO_PARENT_TYPE == index->directParent[typeIdx])
+    {
+        *parentType = NULL;
+    }
+    else
+    {
+        *parentType = SOPC_Array_Get(index->typeIds, const SOPC_NodeId*, index->directParent[typeIdx]);
+    }
+    return true;
+}
+
+/*
+ * Nodes references
+ */
+
+static bool index_reference(SOPC_AddressSpaceIndex* index,
+                            SOPC_AddressSpace_Node* node,
+                            node_index_t* nodeIndex,
+                            int32_t refIdx)
+{
+    const OpcUa_ReferenceNode* ref = &(*SOPC_AddressSpace_Get_References(index->space, node))[refIdx];
+    bool isForward = !ref->IsInverse;
+    size_t nbGroups = SOPC_Array_Size(nodeIndex->groups);
+    refs_group_t* group = NULL;
+
+    for (size_t i = 0; NULL == group && i < nbGroups; i++)
+    {
+        refs_group_t* current = SOPC_Array_Get_Ptr(nodeIndex->groups, i);
+        if (current->isForward == isForward &&
+            SOPC_NodeId_Equal(get_group_ref_type(index->space, node, current), &ref->ReferenceTypeId))
+        {
+            group = current;
+        }
+    }
+
+    if (NULL == group)
+    {
+        refs_group_t newGroup = {isForward, SOPC_Array_Create(sizeof(int32_t), 1, NULL)};
+        if (NULL == newGroup.refIndexes || !SOPC_Array_Append(nodeIndex->groups, newGroup))
+        {
+            SOPC_Array_Delete(newGroup.refIndexes);
+            return false;
+        }
+        group = SOPC_Array_Get_Ptr(nodeIndex->groups, nbGroups);
+    }
+
+    return SOPC_Array_Append(group->refIndexes, refIdx);
+}
+
+/* Indexes the \p nbRefs first references of the node, replacing the previous node index if any */
+static node_index_t* index_node(SOPC_AddressSpaceIndex* index, SOPC_AddressSpace_Node* node, int32_t nbRefs)
+{
+    node_index_t* nodeIndex = SOPC_Calloc(1, sizeof(node_index_t));
+
+    if (NULL == nodeIndex)
+    {
+        return NULL;
+    }
+
+    nodeIndex->groups = SOPC_Array_Create(sizeof(refs_group_t), 2, NULL);
+    bool ok = (NULL != nodeIndex->groups);
+
+    for (int32_t i = 0; ok && i < nbRefs; i++)
+    {
+        ok = index_reference(index, node, nodeIndex, i);
+    }
+
+    if (ok)
+    {
+        ok = SOPC_Dict_Insert(index->nodes, (uintptr_t) node, (uintptr_t) nodeIndex);
+    }
+
+    if (!ok)
+    {
+        node_index_free((uintptr_t) nodeIndex);
+        nodeIndex = NULL;
+    }
+
+    return nodeIndex;
+}
+
+typedef struct index_nodes_ctx_t
+{
+    SOPC_AddressSpaceIndex* index;
+    bool ok;
+} index_nodes_ctx_t;
+
+static void index_nodes(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_UNUSED_ARG(key);
+    index_nodes_ctx_t* ctx = (index_nodes_ctx_t*) user_data;
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+
+    if (ctx->ok)
+    {
+        int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(ctx->index->space, node);
+        ctx->ok = (NULL != index_node(ctx->index, node, nbRefs));
+    }
+}
+
+static void clear_index(SOPC_AddressSpaceIndex* index)
+{
+    index->typesReady = false;
+    SOPC_Dict_Delete(index->types);
+    SOPC_Array_Delete(index->typeIds);
+    SOPC_Free(index->directParent);
+    SOPC_Free(index->firstInTree);
+    SOPC_Free(index->lastInTree);
+    SOPC_Dict_Delete(index->nodes);
+    index->types = NULL;
+    index->typeIds = NULL;
+    index->directParent = NULL;
+    index->firstInTree = NULL;
+    index->lastInTree = NULL;
+    index->nodes = NULL;
+}
+
+static bool build_index(SOPC_AddressSpaceIndex* index)
+{
+    index_nodes_ctx_t ctx = {index, build_types_hierarchy(index)};
+
+    if (ctx.ok)
+    {
+        index->nodes = SOPC_Dict_Create((uintptr_t) NULL, ptr_hash, ptr_equal, NULL, node_index_free);
+        ctx.ok = (NULL != index->nodes);
+    }
+    if (ctx.ok)
+    {
+        SOPC_AddressSpace_ForEach(index->space, index_nodes, (uintptr_t) &ctx);
+    }
+    if (!ctx.ok)
+    {
+        clear_index(index);
+    }
+
+    return ctx.ok;
+}
+
+SOPC_AddressSpaceIndex* SOPC_AddressSpaceIndex_Create(SOPC_AddressSpace* space)
+{
+    SOPC_ASSERT(NULL != space);
+    SOPC_AddressSpaceIndex* index = SOPC_Calloc(1, sizeof(SOPC_AddressSpaceIndex));
+
+    if (NULL != index)
+    {
+        index->space = space;
+        if (!build_index(index))
+        {
+            SOPC_Free(index);
+            index = NULL;
+        }
+    }
+
+    return index;
+}
+
+void SOPC_AddressSpaceIndex_Delete(SOPC_AddressSpaceIndex* index)
+{
+    if (NULL != index)
+    {
+        clear_index(index);
+        SOPC_Free(index);
+    }
+}
+
+static node_index_t* get_node_index(const SOPC_AddressSpaceIndex* index, SOPC_AddressSpace_Node* node)
+{
+    return (node_index_t*) SOPC_Dict_Get(index->nodes, (uintptr_t) node, NULL);
+}
+
+static bool group_match(SOPC_AddressSpaceIndex* index,
+                        SOPC_AddressSpace_Node* node,
+                        const refs_group_t* group,
+                        const SOPC_NodeId* refTypeId,
+                        bool includeSubtypes)
+{
+    const SOPC_NodeId* groupRefTypeId = get_group_ref_type(index->space, node, group);
+    bool match = SOPC_NodeId_Equal(groupRefTypeId, refTypeId);
+    if (!match && includeSubtypes)
+    {
+        match = SOPC_AddressSpaceUtil_RecursiveIsTransitiveSubtype(index->space, RECURSION_LIMIT, groupRefTypeId,
+                                                                   groupRefTypeId, refTypeId);
+    }
+    return match;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_GetReferences(SOPC_AddressSpaceIndex* index,
+                                                       SOPC_AddressSpace_Node* node,
+                                                       const SOPC_NodeId* refTypeId,
+                                                       bool includeSubtypes,
+                                                       bool isForward,
+                                                       SOPC_Array* refIndexes)
+{
+    SOPC_ASSERT(NULL != index);
+    SOPC_ASSERT(NULL != refTypeId);
+    SOPC_ASSERT(NULL != refIndexes);
+
+    node_index_t* nodeIndex = get_node_index(index, node);
+
+    if (NULL == nodeIndex)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    size_t nbGroups = SOPC_Array_Size(nodeIndex->groups);
+    for (size_t i = 0; i < nbGroups; i++)
+    {
+        refs_group_t* group = SOPC_Array_Get_Ptr(nodeIndex->groups, i);
+        if (group->isForward == isForward && group_match(index, node, group, refTypeId, includeSubtypes) &&
+            !SOPC_Array_Append_Values(refIndexes, SOPC_Array_Get_Ptr(group->refIndexes, 0),
+                                      SOPC_Array_Size(group->refIndexes)))
+        {
+            return SOPC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_GetNextReference(SOPC_AddressSpaceIndex* index,
+                                                          SOPC_AddressSpace_Node* node,
+                                                          const SOPC_NodeId* refTypeId,
+                                                          bool includeSubtypes,
+                                                          bool forward,
+                                                          bool inverse,
+                                                          int32_t fromRefIndex,
+                                                          int32_t* nextRefIndex)
+{
+    SOPC_ASSERT(NULL != index);
+    SOPC_ASSERT(NULL != refTypeId);
+    SOPC_ASSERT(NULL != nextRefIndex);
+
+    node_index_t* nodeIndex = get_node_index(index, node);
+
+    if (NULL == nodeIndex)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(index->space, node);
+    *nextRefIndex = (fromRefIndex > nbRefs) ? fromRefIndex : nbRefs;
+
+    size_t nbGroups = SOPC_Array_Size(nodeIndex->groups);
+    for (size_t i = 0; i < nbGroups; i++)
+    {
+        refs_group_t* group = SOPC_Array_Get_Ptr(nodeIndex->groups, i);
+        if ((group->isForward ? !forward : !inverse) || !group_match(index, node, group, refTypeId, includeSubtypes))
+        {
+            continue;
+        }
+        // Binary search of the first reference of the group from fromRefIndex
+        size_t low = 0;
+        size_t high = SOPC_Array_Size(group->refIndexes);
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (SOPC_Array_Get(group->refIndexes, int32_t, middle) < fromRefIndex)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        if (low < SOPC_Array_Size(group->refIndexes) &&
+            SOPC_Array_Get(group->refIndexes, int32_t, low) < *nextRefIndex)
+        {
+            *nextRefIndex = SOPC_Array_Get(group->refIndexes, int32_t, low);
+        }
+    }
+
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_AddNode(SOPC_AddressSpaceIndex* index, SOPC_AddressSpace_Node* node)
+{
+    SOPC_ASSERT(NULL != index);
+    SOPC_ASSERT(NULL != node);
+
+    if (is_type_node_class(node->node_class))
+    {
+        // The types hierarchy changes
+        clear_index(index);
+        return build_index(index) ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(index->space, node);
+    if (NULL == index_node(index, node, nbRefs))
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_AddReference(SOPC_AddressSpaceIndex* index,
+                                                      SOPC_AddressSpace_Node* node,
+                                                      int32_t refIndex)
+{
+    SOPC_ASSERT(NULL != index);
+    node_index_t* nodeIndex = get_node_index(index, node);
+
+    if (NULL == nodeIndex)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    return index_reference(index, node, nodeIndex, refIndex) ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_RemoveLastReference(SOPC_AddressSpaceIndex* index,
+                                                             SOPC_AddressSpace_Node* node,
+                                                             int32_t refIndex)
+{
+    SOPC_ASSERT(NULL != index);
+    node_index_t* nodeIndex = get_node_index(index, node);
+
+    if (NULL == nodeIndex)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    if (refIndex + 1 != *SOPC_AddressSpace_Get_NoOfReferences(index->space, node))
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    // Rollback case only: index again the node without its last reference
+    return NULL != index_node(index, node, refIndex) ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
+}
@@ -0,0 +1,159 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Index of the references of an AddressSpace.
+ *
+ * The index is built once the AddressSpace nodes are loaded and is maintained when nodes are added
+ * (AddNodes service). It contains:
+ * - the hierarchy of the types (ObjectType, VariableType, DataType and ReferenceType nodes) of any namespace,
+ *   numbered in depth-first order so that a subtype check is a comparison of intervals,
+ * - for each node, the indexes of its references grouped by ReferenceType and direction.
+ *
+ * When the index is not available (not built or dropped after an allocation failure),
+ * the callers fall back on the iteration over the node references.
+ */
+
+#ifndef SOPC_ADDRESS_SPACE_INDEX_INTERNAL_H_
+#define SOPC_ADDRESS_SPACE_INDEX_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sopc_address_space.h"
+#include "sopc_array.h"
+#include "sopc_builtintypes.h"
+
+typedef struct SOPC_AddressSpaceIndex SOPC_AddressSpaceIndex;
+
+/**
+ * \brief Builds the index of the given AddressSpace nodes
+ *
+ * \param space  the AddressSpace to index, it shall not be modified while the index exists
+ *               unless the modification is notified to the index
+ *
+ * \return the index or NULL in case of allocation failure
+ */
+SOPC_AddressSpaceIndex* SOPC_AddressSpaceIndex_Create(SOPC_AddressSpace* space);
+
+void SOPC_AddressSpaceIndex_Delete(SOPC_AddressSpaceIndex* index);
+
+/**
+ * \brief Evaluates if \p type is a transitive subtype of \p parentType (\p type excluded)
+ *        using the types hierarchy of the index.
+ *
+ * \param index          the AddressSpace index
+ * \param type           the type NodeId to evaluate
+ * \param parentType     the expected parent type NodeId
+ * \param[out] isSubtype set with the result when the function returns true
+ *
+ * \return true if both NodeIds are types known by the index and \p isSubtype is set,
+ *         false if the index cannot evaluate it.
+ */
+bool SOPC_AddressSpaceIndex_IsTransitiveSubtype(const SOPC_AddressSpaceIndex* index,
+                                                const SOPC_NodeId* type,
+                                                const SOPC_NodeId* parentType,
+                                                bool* isSubtype);
+
+/**
+ * \brief Returns the direct parent type of \p type when it is known by the index.
+ *
+ * \param[out] parentType  set with the parent type NodeId or NULL if \p type has no parent type
+ *
+ * \return true if \p parentType is set, false if \p type or its parent type are not known by the index.
+ */
+bool SOPC_AddressSpaceIndex_GetDirectParentType(const SOPC_AddressSpaceIndex* index,
+                                                const SOPC_NodeId* type,
+                                                const SOPC_NodeId** parentType);
+
+/**
+ * \brief Appends the indexes (int32_t) in the \p node references of the references of the given ReferenceType
+ *        (or one of its subtypes when \p includeSubtypes is set) in the given direction.
+ *        The indexes are grouped by ReferenceType, in ascending order in each group.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS if the node is not indexed
+ *         and SOPC_STATUS_OUT_OF_MEMORY in case of allocation failure
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_GetReferences(SOPC_AddressSpaceIndex* index,
+                                                       SOPC_AddressSpace_Node* node,
+                                                       const SOPC_NodeId* refTypeId,
+                                                       bool includeSubtypes,
+                                                       bool isForward,
+                                                       SOPC_Array* refIndexes);
+
+/**
+ * \brief Returns the first reference of \p node from \p fromRefIndex which has the given ReferenceType
+ *        (or one of its subtypes when \p includeSubtypes is set) and one of the given directions.
+ *
+ * \param[out] nextRefIndex  set with the index of the reference in the \p node references,
+ *                           or the number of references of \p node (\p fromRefIndex if greater) if there is none
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS if the node is not indexed
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_GetNextReference(SOPC_AddressSpaceIndex* index,
+                                                          SOPC_AddressSpace_Node* node,
+                                                          const SOPC_NodeId* refTypeId,
+                                                          bool includeSubtypes,
+                                                          bool forward,
+                                                          bool inverse,
+                                                          int32_t fromRefIndex,
+                                                          int32_t* nextRefIndex);
+
+/**
+ * \brief Indexes a node appended to the AddressSpace.
+ *        Adding a type node rebuilds the index since the types hierarchy is modified.
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_AddNode(SOPC_AddressSpaceIndex* index, SOPC_AddressSpace_Node* node);
+
+/**
+ * \brief Indexes the reference \p refIndex appended to the references of an indexed \p node
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_AddReference(SOPC_AddressSpaceIndex* index,
+                                                      SOPC_AddressSpace_Node* node,
+                                                      int32_t refIndex);
+
+/**
+ * \brief Removes the reference \p refIndex from the index before it is removed from the references of \p node.
+ *        Only the last reference of the node shall be removed.
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceIndex_RemoveLastReference(SOPC_AddressSpaceIndex* index,
+                                                             SOPC_AddressSpace_Node* node,
+                                                             int32_t refIndex);
+
+/* Index management of the AddressSpace, implemented in sopc_address_space.c */
+
+/**
+ * \brief Builds the index of the AddressSpace, replacing the previous one if any.
+ *        The AddressSpace nodes shall not be read only.
+ *        See ::SOPC_ADDRESS_SPACE_INDEX for the memory cost of the index.
+ */
+SOPC_ReturnStatus SOPC_AddressSpace_BuildIndex(SOPC_AddressSpace* space);
+
+/**
+ * \brief Returns the index of the AddressSpace or NULL if it is not built
+ */
+SOPC_AddressSpaceIndex* SOPC_AddressSpace_Get_Index(const SOPC_AddressSpace* space);
+
+/**
+ * \brief Deletes the index of the AddressSpace, to be used when the index cannot be maintained
+ */
+void SOPC_AddressSpace_DropIndex(SOPC_AddressSpace* space);
+
+#endif /* SOPC_ADDRESS_SPACE_INDEX_INTERNAL_H_ */
@@ -23,6 +23,7 @@
 #include "sopc_address_space_utils_internal.h"
 
 #include "opcua_identifiers.h"
+#include "sopc_address_space_index_internal.h"
 #include "sopc_assert.h"
 #include "sopc_embedded_nodeset2.h"
 #include "sopc_logger.h"
@@ -222,12 +223,18 @@ const SOPC_NodeId* SOPC_AddressSpaceUtil_GetDirectParentType(SOPC_AddressSpace*
     }
     else if (S2OPC_DYNAMIC_TYPE_RESOLUTION)
     {
-        // Parent not found in static array of extracted HasSubtype references, start research in address space
+        // Parent not found in static array of extracted HasSubtype references, use the index if available
+        const SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(addSpace);
+        bool indexed = (NULL != index && SOPC_AddressSpaceIndex_GetDirectParentType(index, childNodeId, &result));
 
+        // otherwise start research in address space
         void* node;
         bool node_found = false;
 
-        node = SOPC_AddressSpace_Get_Node(addSpace, childNodeId, &node_found);
+        if (!indexed)
+        {
+            node = SOPC_AddressSpace_Get_Node(addSpace, childNodeId, &node_found);
+        }
 
         if (node_found)
         {
@@ -244,6 +251,18 @@ bool SOPC_AddressSpaceUtil_RecursiveIsTransitiveSubtype(SOPC_AddressSpace* addSp
                                                         const SOPC_NodeId* currentTypeOrSubtype,
                                                         const SOPC_NodeId* expectedParentType)
 {
+    if (RECURSION_LIMIT <= recursionLimit && originSubtype == currentTypeOrSubtype)
+    {
+        // Use the types hierarchy of the index when both types are indexed and the depth is not restricted
+        const SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(addSpace);
+        bool isSubtype = false;
+        if (NULL != index &&
+            SOPC_AddressSpaceIndex_IsTransitiveSubtype(index, currentTypeOrSubtype, expectedParentType, &isSubtype))
+        {
+            return isSubtype;
+        }
+    }
+
     recursionLimit--;
     if (recursionLimit < 0)
     {
@@ -30,6 +30,7 @@
 
 #include "sopc_node_mgt_helper_internal.h"
 
+#include "sopc_address_space_index_internal.h"
 #include "sopc_address_space_utils_internal.h"
 
 static const SOPC_NodeId DataVariable_Type = {SOPC_IdentifierType_Numeric, 0,
@@ -683,6 +684,13 @@ SOPC_ReturnStatus SOPC_NodeMgtHelperInternal_AddRefChildToParentNode(SOPC_Addres
         {
             // Update number of references
             *nbRefs += 1;
+
+            SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(addSpace);
+            if (NULL != index && SOPC_STATUS_OK != SOPC_AddressSpaceIndex_AddReference(index, parentNode, *nbRefs - 1))
+            {
+                // Index is not consistent anymore
+                SOPC_AddressSpace_DropIndex(addSpace);
+            }
         }
     }
     else
@@ -705,7 +713,13 @@ bool SOPC_NodeMgtHelperInternal_RemoveLastRefInParentNode(SOPC_AddressSpace* add
         return false;
     }
     OpcUa_ReferenceNode** refs = SOPC_AddressSpace_Get_References(addSpace, parentNode);
+    SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(addSpace);
+    if (NULL != index && SOPC_STATUS_OK != SOPC_AddressSpaceIndex_RemoveLastReference(index, parentNode, *nbRefs - 1))
+    {
+        // Index is not consistent anymore
+        SOPC_AddressSpace_DropIndex(addSpace);
+    }
     *nbRefs -= 1;
-    OpcUa_ReferenceNode_Clear(&(*refs[*nbRefs]));
+    OpcUa_ReferenceNode_Clear(&(*refs)[*nbRefs]);
     return true;
 }
@@ -48,6 +48,50 @@ void SOPC_ToolkitServer_AsyncLocalServiceRequest(SOPC_EndpointConfigIdx endpoint
                                requestContext);
 }
 
+SOPC_ReturnStatus SOPC_ToolkitServer_AsyncUpdateValues(size_t nbValues,
+                                                       SOPC_AddressSpace_Node* const* nodes,
+                                                       SOPC_DataValue* values)
+{
+    if (0 == nbValues || NULL == nodes || NULL == values)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    for (size_t i = 0; i < nbValues; i++)
+    {
+        if (NULL == nodes[i])
+        {
+            return SOPC_STATUS_INVALID_PARAMETERS;
+        }
+    }
+    SOPC_Internal_ValuesUpdate* update = SOPC_Calloc(1, sizeof(*update));
+    if (NULL != update)
+    {
+        update->nodes = SOPC_Calloc(nbValues, sizeof(*update->nodes));
+        update->values = SOPC_Calloc(nbValues, sizeof(*update->values));
+    }
+    if (NULL == update || NULL == update->nodes || NULL == update->values)
+    {
+        if (NULL != update)
+        {
+            SOPC_Free(update->nodes);
+            SOPC_Free(update->values);
+        }
+        SOPC_Free(update);
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    update->nbValues = nbValues;
+    memcpy(update->nodes, nodes, nbValues * sizeof(*update->nodes));
+    // Move the values: their content is now owned by the batch
+    memcpy(update->values, values, nbValues * sizeof(*update->values));
+    for (size_t i = 0; i < nbValues; i++)
+    {
+        SOPC_DataValue_Initialize(&values[i]);
+    }
+
+    SOPC_Services_EnqueueEvent(APP_TO_SE_LOCAL_VALUES_UPDATE, 0, (uintptr_t) update, 0);
+    return SOPC_STATUS_OK;
+}
+
 void SOPC_ToolkitServer_AsyncReEvalSecureChannels(bool ownCert)
 {
     SOPC_Services_EnqueueEvent(APP_TO_SE_REEVALUATE_SCS, 0, (uintptr_t) true, (uintptr_t) ownCert);
@@ -33,6 +33,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "sopc_address_space.h"
 #include "sopc_builtintypes.h"
 #include "sopc_enums.h"
 #include "sopc_toolkit_config.h"
@@ -78,6 +79,25 @@ void SOPC_ToolkitServer_AsyncCloseEndpoint(SOPC_EndpointConfigIdx endpointConfig
 void SOPC_ToolkitServer_AsyncLocalServiceRequest(SOPC_EndpointConfigIdx endpointConfigIdx,
                                                  void* requestStruct,
                                                  uintptr_t requestContext);
+
+/**
+ * \brief Request to update locally the Value attribute of the given Variable nodes on server.
+ *
+ *   The values are applied in the given order by the services thread and the monitored items of the nodes are
+ *   notified as for a write service request. No response is provided.
+ *
+ * \param nbValues  Number of nodes and values in the batch
+ * \param nodes     Variable nodes of the server AddressSpace (e.g.: obtained by ::SOPC_AddressSpace_Get_Node)
+ * \param values    The new values of the nodes. Only Value, Status, SourceTimestamp and SourcePicoSeconds are
+ *                  considered. When SourceTimestamp and SourcePicoSeconds are both 0, the current time is used.
+ *                  The values are moved on success: the caller's values are reset.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS if a parameter is NULL or
+ *         \p nbValues is 0 and SOPC_STATUS_OUT_OF_MEMORY in case of allocation failure.
+ */
+SOPC_ReturnStatus SOPC_ToolkitServer_AsyncUpdateValues(size_t nbValues,
+                                                       SOPC_AddressSpace_Node* const* nodes,
+                                                       SOPC_DataValue* values);
 /**
  * \brief Configuration parameters for a connection to a server endpoint.
  *        The connection is either initiated by the client (classic) or by the server (reverse).
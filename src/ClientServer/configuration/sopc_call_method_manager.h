@@ -23,6 +23,7 @@
  *
  * \warning Methods call are blocking for server services treatment,
  *          methods implementation should be lightweight functions (see Part 3 §4.7).
+ *          Long-running methods shall defer their completion with ::SOPC_MethodCall_Defer.
  */
 
 #ifndef SOPC_CALL_METHOD_MANAGER_H_
@@ -57,6 +58,7 @@ typedef struct SOPC_MethodCallFunc SOPC_MethodCallFunc;
  *                        by the function
  *
  * \return status code of the function. Should be SOPC_STATUS_OK if succeeded.
+ *         Shall be OpcUa_GoodCompletesAsynchronously if and only if ::SOPC_MethodCall_Defer was called.
  */
 typedef SOPC_StatusCode SOPC_MethodCallFunc_Ptr(const SOPC_CallContext* callContextPtr,
                                                 const SOPC_NodeId* objectId,
@@ -168,4 +170,49 @@ SOPC_ReturnStatus SOPC_MethodCallManager_AddMethod(SOPC_MethodCallManager* mcm,
                                                    void* param,
                                                    SOPC_MethodCallFunc_Free_Func* fnFree);
 
+/**
+ * \brief Handle of a method call which completes asynchronously (see ::SOPC_MethodCall_Defer)
+ */
+typedef struct SOPC_MethodCallCompletion SOPC_MethodCallCompletion;
+
+/**
+ * \brief Defers the completion of the method call being executed.
+ *
+ * This function shall only be called by a ::SOPC_MethodCallFunc_Ptr function with the call context it received,
+ * the function shall then return OpcUa_GoodCompletesAsynchronously without output arguments.
+ * The server continues to treat the other requests and the Call response is sent once all the deferred methods
+ * of the request are completed with ::SOPC_MethodCall_Complete.
+ *
+ * \note The call context, the object NodeId and the input arguments provided to the method are only valid
+ *       during the method function call: they shall be copied if needed for the completion.
+ *       The address space shall not be modified by the completion.
+ *
+ * \param callContextPtr  the call context provided to the method function
+ *
+ * \return the completion handle to provide to ::SOPC_MethodCall_Complete,
+ *         or NULL if the call context is not the one of a method being executed or in case of allocation failure.
+ */
+SOPC_MethodCallCompletion* SOPC_MethodCall_Defer(const SOPC_CallContext* callContextPtr);
+
+/**
+ * \brief Completes a method call deferred by ::SOPC_MethodCall_Defer.
+ *
+ * This function may be called from any thread, it shall be called exactly once for each completion handle
+ * and before the server is stopped.
+ *
+ * \param completion    the completion handle returned by ::SOPC_MethodCall_Defer, it is deallocated by the server
+ *                      when the function succeeds
+ * \param status        the status code of the method call
+ * \param nbOutputArgs  the number of output arguments
+ * \param outputArgs    the output arguments array of size \p nbOutputArgs (allocated with SOPC_Calloc or NULL if
+ *                      there is no output argument), its ownership is transferred to the server
+ *                      when the function succeeds
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS otherwise.
+ */
+SOPC_ReturnStatus SOPC_MethodCall_Complete(SOPC_MethodCallCompletion* completion,
+                                           SOPC_StatusCode status,
+                                           uint32_t nbOutputArgs,
+                                           SOPC_Variant* outputArgs);
+
 #endif /* SOPC_CALL_METHOD_MANAGER_H_ */
@@ -44,6 +44,24 @@
 #error "Maximum number of secure channel shall be greater than maximum number of session"
 #endif
 
+/* Maximum value accepted in B model */
+#if SOPC_MAX_PENDING_REQUESTS > INT32_MAX
+#error "Max number of pending requests cannot be more than INT32_MAX"
+#endif
+
+/* A request timeout timer is started for each pending request */
+#if SOPC_MAX_PENDING_REQUESTS >= SOPC_MAX_TIMERS
+#error "Max number of pending requests shall be less than max number of timers"
+#endif
+
+#if SOPC_SC_CRYPTO_WORKERS < 0 || SOPC_SC_CRYPTO_WORKERS > 64
+#error "Number of secure channel crypto workers shall be in [0, 64]"
+#endif
+
+#if SOPC_SC_CRYPTO_CHUNKS_WINDOW < 1 || SOPC_SC_CRYPTO_CHUNKS_WINDOW > 1024
+#error "Secure channel crypto chunks window shall be in [1, 1024]"
+#endif
+
 /* Maximum value accepted in B model */
 #if SOPC_MAX_SESSIONS > INT32_MAX
 #error "Max number of sessions cannot be more than INT32_MAX"
@@ -76,9 +94,9 @@
 #error "Maximum subscription publish requests > INT32_MAX / 2"
 #endif
 
-/** Minimum publish interval shall be greater to the event timer resolution */
-#if 2 * SOPC_TIMER_RESOLUTION_MS > SOPC_MIN_SUBSCRIPTION_INTERVAL_DURATION
-#error "Minimum publish interval < 2 * SOPC_TIMER_RESOLUTION_MS"
+/** Minimum publish interval shall be greater to the event timer minimum period */
+#if SOPC_TIMER_MIN_PERIOD_MS > SOPC_MIN_SUBSCRIPTION_INTERVAL_DURATION
+#error "Minimum publish interval < SOPC_TIMER_MIN_PERIOD_MS"
 #endif
 
 /** Minimum number of publish intervals before a keep alive is sent (server to client) */
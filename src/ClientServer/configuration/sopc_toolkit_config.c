@@ -45,6 +45,7 @@
 #include "sopc_user_app_itf.h"
 
 #include "address_space_impl.h"
+#include "sopc_address_space_index_internal.h"
 #include "util_b2c.h"
 
 /* Check IEEE-754 compliance */
@@ -640,6 +641,13 @@ SOPC_Endpoint_Config* SOPC_ToolkitServer_GetEndpointConfig(uint32_t epConfigIdx)
 static void SOPC_Internal_ToolkitServer_SetAddressSpaceConfig(SOPC_AddressSpace* addressSpace)
 {
     SOPC_ASSERT(NULL != addressSpace);
+    // Index the references to accelerate the browse and node management services (see SOPC_ADDRESS_SPACE_INDEX)
+    if (SOPC_ADDRESS_SPACE_INDEX && !SOPC_AddressSpace_AreReadOnlyNodes(addressSpace) &&
+        SOPC_STATUS_OK != SOPC_AddressSpace_BuildIndex(addressSpace))
+    {
+        SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                 "AddressSpace references index could not be built, browse will not be indexed");
+    }
     address_space_bs__nodes = addressSpace;
     sopc_addressSpace_configured = true;
 }
@@ -89,10 +89,17 @@
 #define SOPC_MINIMUM_SECURE_CONNECTION_LIFETIME 1000
 #endif
 
-/** @brief Maximum number of requests sent by client pending */
+/** @brief Maximum number of requests sent by client pending (for all the client connections).
+ *         The pending requests table is allocated on demand and extended up to this maximum.
+ *         Note: a request timeout timer is used for each pending request (see ::SOPC_MAX_TIMERS).
+ */
 #ifndef SOPC_MAX_PENDING_REQUESTS
+#if (defined(__linux__) || defined(_WIN32)) && !defined(__ZEPHYR__)
+#define SOPC_MAX_PENDING_REQUESTS 1024
+#else
 #define SOPC_MAX_PENDING_REQUESTS 128
 #endif
+#endif
 
 /** @brief Maximum time before a response shall be received after sending a request (0 means no limit).
  *  Note: the request timeoutHint parameter is set to SOPC_REQUEST_TIMEOUT_MS/2 to let a margin regarding timeoutHint.
@@ -108,6 +115,31 @@
 #define SOPC_SC_CONNECTION_TIMEOUT_MS 10000
 #endif
 
+/** @brief Number of worker threads which sign and encrypt the chunks of multi-chunk messages
+ *         in addition to the Secure_Channels thread (0 means the chunks are only processed by the Secure_Channels
+ *         thread).
+ *         The worker threads are created when a first signed multi-chunk message is sent.
+ *         Default is 0 on embedded targets, where the number of threads is limited by the platform configuration.
+ *
+ *  Note: the Secure_Channels thread waits for the chunks of each window (see ::SOPC_SC_CRYPTO_CHUNKS_WINDOW) to be
+ *        signed and encrypted. It reduces the time to send a large message when several cores are available,
+ *        but the other secure channels are still not treated while a large message is being sent.
+ */
+#ifndef SOPC_SC_CRYPTO_WORKERS
+#if (defined(__linux__) || defined(_WIN32)) && !defined(__ZEPHYR__)
+#define SOPC_SC_CRYPTO_WORKERS 2
+#else
+#define SOPC_SC_CRYPTO_WORKERS 0
+#endif
+#endif
+
+/** @brief Maximum number of chunks of a message which are encoded before being signed and encrypted together.
+ *         A chunk buffer of the secure channel send buffer size is allocated for each of them.
+ */
+#ifndef SOPC_SC_CRYPTO_CHUNKS_WINDOW
+#define SOPC_SC_CRYPTO_CHUNKS_WINDOW 16
+#endif
+
 /** @brief Maximum number of configured reverse connection from a server endpoint to clients */
 #ifndef SOPC_MAX_REVERSE_CLIENT_CONNECTIONS
 #define SOPC_MAX_REVERSE_CLIENT_CONNECTIONS 5
@@ -174,14 +206,19 @@
 
 /* SUBSCRIPTION CONFIGURATION */
 
-/** @brief Maximum publish requests stored by server for a subscription */
+/** @brief Maximum publish requests stored by server for a subscription.
+ *         It shall cover the number of publish intervals elapsed during a request round trip
+ *         to keep publishing without waiting for the client with short publish intervals.
+ */
 #ifndef SOPC_MAX_SUBSCRIPTION_PUBLISH_REQUESTS
-#define SOPC_MAX_SUBSCRIPTION_PUBLISH_REQUESTS 10
+#define SOPC_MAX_SUBSCRIPTION_PUBLISH_REQUESTS 20
 #endif
 
-/** @brief Minimum publish interval of a subscription in milliseconds */
+/** @brief Minimum publish interval of a subscription in milliseconds.
+ *         It shall be greater or equal to ::SOPC_TIMER_MIN_PERIOD_MS.
+ */
 #ifndef SOPC_MIN_SUBSCRIPTION_INTERVAL_DURATION
-#define SOPC_MIN_SUBSCRIPTION_INTERVAL_DURATION 100 // 100 ms
+#define SOPC_MIN_SUBSCRIPTION_INTERVAL_DURATION 5 // 5 ms
 #endif
 
 /** @brief Maximum publish interval of a subscription in milliseconds */
@@ -254,6 +291,28 @@
 #endif
 #endif
 
+/* ADDRESS SPACE CONFIGURATION */
+
+/** @brief Build an index of the server AddressSpace references when it is configured
+ *         (see ::SOPC_ToolkitServer_SetAddressSpaceConfig). The index accelerates the Browse and TranslateBrowsePaths
+ *         services and the AddNodes service checks. It is never built for an AddressSpace with read only nodes
+ *         (constant AddressSpace).
+ *         Default is false on embedded targets.
+ *
+ *  Note: memory cost of the index on a 64 bits target is about:
+ *        - 150 bytes per node,
+ *        - 60 bytes per group of references of a node with the same ReferenceType and direction,
+ *        - 4 to 8 bytes per reference,
+ *        - 70 bytes per type node (ObjectType, VariableType, DataType and ReferenceType).
+ */
+#ifndef SOPC_ADDRESS_SPACE_INDEX
+#if (defined(__linux__) || defined(_WIN32)) && !defined(__ZEPHYR__)
+#define SOPC_ADDRESS_SPACE_INDEX true
+#else
+#define SOPC_ADDRESS_SPACE_INDEX false
+#endif
+#endif
+
 /* PROFILE MANAGEMENT */
 
 #ifndef S2OPC_NANO_PROFILE
@@ -20,11 +20,126 @@
 #include <stdbool.h>
 
 #include "sopc_assert.h"
+#include "sopc_atomic.h"
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
+#include "sopc_mutexes.h"
 #include "sopc_types.h"
 #include "sopc_user_manager_internal.h"
 
+struct SOPC_UserAuthorization_Cache
+{
+    /* Incremented to invalidate the cached decisions of all the sessions */
+    int32_t generation;
+    uint32_t maxEntriesPerSession;
+    /* Protects the statistics which are read from the application */
+    SOPC_Mutex mutex;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+/* Key of the cached decisions of a session */
+typedef struct
+{
+    SOPC_NodeId nodeId;
+    uint32_t attributeId;
+    SOPC_UserAuthorization_OperationType operationType;
+} SOPC_UserAuthorization_CacheKey;
+
+static uint64_t cacheKeyHash(const uintptr_t data)
+{
+    const SOPC_UserAuthorization_CacheKey* key = (const SOPC_UserAuthorization_CacheKey*) data;
+    uint64_t hash = 0;
+    SOPC_NodeId_Hash(&key->nodeId, &hash);
+    hash = (hash * 31 + key->attributeId) * 31 + (uint64_t) key->operationType;
+    return hash;
+}
+
+static bool cacheKeyEqual(const uintptr_t a, const uintptr_t b)
+{
+    const SOPC_UserAuthorization_CacheKey* keyA = (const SOPC_UserAuthorization_CacheKey*) a;
+    const SOPC_UserAuthorization_CacheKey* keyB = (const SOPC_UserAuthorization_CacheKey*) b;
+    return keyA->attributeId == keyB->attributeId && keyA->operationType == keyB->operationType &&
+           SOPC_NodeId_Equal(&keyA->nodeId, &keyB->nodeId);
+}
+
+static void cacheKeyFree(uintptr_t data)
+{
+    SOPC_UserAuthorization_CacheKey* key = (SOPC_UserAuthorization_CacheKey*) data;
+    if (NULL != key)
+    {
+        SOPC_NodeId_Clear(&key->nodeId);
+        SOPC_Free(key);
+    }
+}
+
+static void cacheUpdateStatistics(SOPC_UserAuthorization_Cache* cache, bool hit)
+{
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&cache->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    if (hit)
+    {
+        cache->hits++;
+    }
+    else
+    {
+        cache->misses++;
+    }
+    status = SOPC_Mutex_Unlock(&cache->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+}
+
+/* Returns the cache of the session, emptied when invalidated, or NULL in case of allocation failure */
+static SOPC_Dict* cacheGetSessionDict(SOPC_UserWithAuthorization* userauthz, SOPC_UserAuthorization_Cache* cache)
+{
+    const int32_t generation = SOPC_Atomic_Int_Get(&cache->generation);
+    if (NULL != userauthz->authorizationCache && generation != userauthz->cacheGeneration)
+    {
+        SOPC_Dict_Delete(userauthz->authorizationCache);
+        userauthz->authorizationCache = NULL;
+    }
+    if (NULL == userauthz->authorizationCache)
+    {
+        userauthz->authorizationCache = SOPC_Dict_Create(0, cacheKeyHash, cacheKeyEqual, cacheKeyFree, NULL);
+        userauthz->cacheGeneration = generation;
+    }
+    return userauthz->authorizationCache;
+}
+
+/* Caches the decision, emptying the cache of the session when full.
+ * A failure only means that the decision will be evaluated again. */
+static void cacheInsertDecision(SOPC_UserWithAuthorization* userauthz,
+                                SOPC_UserAuthorization_Cache* cache,
+                                SOPC_UserAuthorization_OperationType operationType,
+                                const SOPC_NodeId* nodeId,
+                                uint32_t attributeId,
+                                bool authorized)
+{
+    if (SOPC_Dict_Size(userauthz->authorizationCache) >= cache->maxEntriesPerSession)
+    {
+        SOPC_Dict_Delete(userauthz->authorizationCache);
+        userauthz->authorizationCache = SOPC_Dict_Create(0, cacheKeyHash, cacheKeyEqual, cacheKeyFree, NULL);
+    }
+    SOPC_Dict* dict = userauthz->authorizationCache;
+    if (NULL == dict)
+    {
+        return;
+    }
+
+    SOPC_UserAuthorization_CacheKey* key = SOPC_Calloc(1, sizeof(SOPC_UserAuthorization_CacheKey));
+    if (NULL == key)
+    {
+        return;
+    }
+    key->attributeId = attributeId;
+    key->operationType = operationType;
+    SOPC_ReturnStatus status = SOPC_NodeId_Copy(&key->nodeId, nodeId);
+    if (SOPC_STATUS_OK != status || !SOPC_Dict_Insert(dict, (uintptr_t) key, (uintptr_t) authorized))
+    {
+        cacheKeyFree((uintptr_t) key);
+    }
+}
+
 SOPC_ReturnStatus SOPC_UserAuthentication_IsValidUserIdentity(SOPC_UserAuthentication_Manager* authenticationManager,
                                                               const SOPC_ExtensionObject* pUser,
                                                               SOPC_UserAuthentication_Status* pUserAuthenticated)
@@ -66,8 +181,33 @@ SOPC_ReturnStatus SOPC_UserAuthorization_IsAuthorizedOperation(SOPC_UserWithAuth
     SOPC_ASSERT(NULL != authorizationManager->pFunctions);
     SOPC_ASSERT(NULL != authorizationManager->pFunctions->pFuncAuthorizeOperation);
 
-    return (authorizationManager->pFunctions->pFuncAuthorizeOperation)(authorizationManager, operationType, nodeId,
-                                                                       attributeId, user, pbOperationAuthorized);
+    SOPC_UserAuthorization_Cache* cache = authorizationManager->pCache;
+    SOPC_Dict* dict = NULL;
+    if (NULL != cache)
+    {
+        dict = cacheGetSessionDict(userWithAuthorization, cache);
+    }
+    if (NULL != dict)
+    {
+        SOPC_UserAuthorization_CacheKey key = {
+            .nodeId = *nodeId, .attributeId = attributeId, .operationType = operationType};
+        bool found = false;
+        uintptr_t authorized = SOPC_Dict_Get(dict, (uintptr_t) &key, &found);
+        cacheUpdateStatistics(cache, found);
+        if (found)
+        {
+            *pbOperationAuthorized = (0 != authorized);
+            return SOPC_STATUS_OK;
+        }
+    }
+
+    SOPC_ReturnStatus status = (authorizationManager->pFunctions->pFuncAuthorizeOperation)(
+        authorizationManager, operationType, nodeId, attributeId, user, pbOperationAuthorized);
+    if (NULL != dict && SOPC_STATUS_OK == status)
+    {
+        cacheInsertDecision(userWithAuthorization, cache, operationType, nodeId, attributeId, *pbOperationAuthorized);
+    }
+    return status;
 }
 
 void SOPC_UserAuthentication_FreeManager(SOPC_UserAuthentication_Manager** ppAuthenticationManager)
@@ -94,10 +234,75 @@ void SOPC_UserAuthorization_FreeManager(SOPC_UserAuthorization_Manager** ppAutho
     SOPC_UserAuthorization_Manager* authorizationManager = *ppAuthorizationManager;
     SOPC_ASSERT(NULL != authorizationManager->pFunctions);
     SOPC_ASSERT(NULL != authorizationManager->pFunctions->pFuncFree);
+    if (NULL != authorizationManager->pCache)
+    {
+        SOPC_Mutex_Clear(&authorizationManager->pCache->mutex);
+        SOPC_Free(authorizationManager->pCache);
+        authorizationManager->pCache = NULL;
+    }
     authorizationManager->pFunctions->pFuncFree(authorizationManager);
     *ppAuthorizationManager = NULL;
 }
 
+SOPC_ReturnStatus SOPC_UserAuthorization_EnableCache(SOPC_UserAuthorization_Manager* authorizationManager,
+                                                     uint32_t maxEntriesPerSession)
+{
+    if (NULL == authorizationManager || 0 == maxEntriesPerSession)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    if (NULL != authorizationManager->pCache)
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+
+    SOPC_UserAuthorization_Cache* cache = SOPC_Calloc(1, sizeof(SOPC_UserAuthorization_Cache));
+    if (NULL == cache)
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    SOPC_ReturnStatus status = SOPC_Mutex_Initialization(&cache->mutex);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Free(cache);
+        return status;
+    }
+    cache->maxEntriesPerSession = maxEntriesPerSession;
+    authorizationManager->pCache = cache;
+    return SOPC_STATUS_OK;
+}
+
+void SOPC_UserAuthorization_InvalidateCache(SOPC_UserAuthorization_Manager* authorizationManager)
+{
+    if (NULL != authorizationManager && NULL != authorizationManager->pCache)
+    {
+        SOPC_Atomic_Int_Add(&authorizationManager->pCache->generation, 1);
+    }
+}
+
+SOPC_ReturnStatus SOPC_UserAuthorization_GetCacheStatistics(SOPC_UserAuthorization_Manager* authorizationManager,
+                                                            uint64_t* pHits,
+                                                            uint64_t* pMisses)
+{
+    if (NULL == authorizationManager || NULL == pHits || NULL == pMisses)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_UserAuthorization_Cache* cache = authorizationManager->pCache;
+    if (NULL == cache)
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&cache->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    *pHits = cache->hits;
+    *pMisses = cache->misses;
+    status = SOPC_Mutex_Unlock(&cache->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    return SOPC_STATUS_OK;
+}
+
 /** \brief A helper implementation of the validate UserIdentity callback, which always returns OK. */
 static SOPC_ReturnStatus AuthenticateAllowAll(SOPC_UserAuthentication_Manager* authenticationManager,
                                               const SOPC_ExtensionObject* pUserIdentity,
@@ -250,6 +455,7 @@ void SOPC_UserWithAuthorization_Free(SOPC_UserWithAuthorization** ppUserWithAuth
 
     SOPC_UserWithAuthorization* userauthz = *ppUserWithAuthorization;
     SOPC_User_Free(&userauthz->user);
+    SOPC_Dict_Delete(userauthz->authorizationCache);
     SOPC_Free(userauthz);
     *ppUserWithAuthorization = NULL;
 }
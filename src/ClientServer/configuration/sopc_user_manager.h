@@ -41,6 +41,7 @@
 
 typedef struct SOPC_UserAuthentication_Manager SOPC_UserAuthentication_Manager;
 typedef struct SOPC_UserAuthorization_Manager SOPC_UserAuthorization_Manager;
+typedef struct SOPC_UserAuthorization_Cache SOPC_UserAuthorization_Cache;
 
 /** \brief The operation type to authorize, see \p SOPC_UserAuthorization_IsAuthorizedOperation */
 typedef enum
@@ -164,6 +165,9 @@ struct SOPC_UserAuthorization_Manager
 
     /** This field may be used to store instance specific data. */
     void* pData;
+
+    /** Decision cache, see \p SOPC_UserAuthorization_EnableCache. Shall be NULL at manager creation. */
+    SOPC_UserAuthorization_Cache* pCache;
 };
 
 /**
@@ -207,6 +211,49 @@ void SOPC_UserAuthentication_FreeManager(SOPC_UserAuthentication_Manager** ppAut
 /** \brief Deletes a SOPC_UserAuthorization_Manager using its pFuncFree. */
 void SOPC_UserAuthorization_FreeManager(SOPC_UserAuthorization_Manager** ppAuthorizationManager);
 
+/**
+ * \brief Enables the cache of the authorization decisions of the manager.
+ *
+ * When enabled, the decision of \p pFuncAuthorizeOperation is kept for each user session and each
+ * (operation, NodeId, attribute) and \p SOPC_UserAuthorization_IsAuthorizedOperation does not call the callback
+ * again for the same operation in the same session.
+ * The callback shall then only depend on its parameters and on data that is changed together with a call to
+ * \p SOPC_UserAuthorization_InvalidateCache.
+ * Decisions are only cached when the callback returns SOPC_STATUS_OK.
+ *
+ * \param authorizationManager  The authorization manager, it shall not be used by a session yet.
+ * \param maxEntriesPerSession  Maximum number of decisions cached for a session, the cache of the session is emptied
+ *                              when it is reached. It shall not be 0.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_STATE if the cache is already enabled,
+ *         SOPC_STATUS_INVALID_PARAMETERS or SOPC_STATUS_OUT_OF_MEMORY otherwise.
+ */
+SOPC_ReturnStatus SOPC_UserAuthorization_EnableCache(SOPC_UserAuthorization_Manager* authorizationManager,
+                                                     uint32_t maxEntriesPerSession);
+
+/**
+ * \brief Discards the authorization decisions cached for all the sessions using the manager,
+ *        e.g. when the roles of the users changed.
+ *
+ * The decisions are evaluated again from the next authorized operation.
+ * It can be called from any thread. It has no effect when the cache is not enabled.
+ */
+void SOPC_UserAuthorization_InvalidateCache(SOPC_UserAuthorization_Manager* authorizationManager);
+
+/**
+ * \brief Returns the statistics of the authorization decisions cache of the manager.
+ *
+ * \param authorizationManager  The authorization manager.
+ * \param[out] pHits            Number of decisions found in the cache.
+ * \param[out] pMisses          Number of decisions evaluated by the \p pFuncAuthorizeOperation callback.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_STATE if the cache is not enabled,
+ *         SOPC_STATUS_INVALID_PARAMETERS otherwise.
+ */
+SOPC_ReturnStatus SOPC_UserAuthorization_GetCacheStatistics(SOPC_UserAuthorization_Manager* authorizationManager,
+                                                            uint64_t* pHits,
+                                                            uint64_t* pMisses);
+
 /** \brief A helper implementation that always authentication positively a user. */
 SOPC_UserAuthentication_Manager* SOPC_UserAuthentication_CreateManager_AllowAll(void);
 
@@ -25,12 +25,17 @@
 #ifndef SOPC_USER_MANAGER_INTERNAL_H_
 #define SOPC_USER_MANAGER_INTERNAL_H_
 
+#include "sopc_dict.h"
 #include "sopc_user_manager.h"
 
 struct SOPC_UserWithAuthorization
 {
     SOPC_User* user;
     SOPC_UserAuthorization_Manager* authorizationManager;
+    /* Cached authorization decisions of the session, created on first use when the manager cache is enabled */
+    SOPC_Dict* authorizationCache;
+    /* Generation of the manager cache when authorizationCache was created */
+    int32_t cacheGeneration;
 };
 
 #endif /* SOPC_USER_MANAGER_INTERNAL_H_ */
@@ -248,6 +248,26 @@ typedef void SOPC_LibSub_DataChangeCbk(const SOPC_LibSub_ConnectionId c_id,
                                        const SOPC_LibSub_DataId d_id,
                                        const SOPC_LibSub_Value* value);
 
+/**
+  @deprecated This type is deprecated since version 1.5.0 and will be removed in version 1.6.0.
+  @brief
+    Callback type for a batch of data change events (related to a subscription).
+    It is called once for all the data changes of a received notification.
+  @param c_id
+    The connection id on which the datachanges happened
+  @param nb_values
+    The number of data changes in \p d_ids and \p values
+  @param d_ids
+    The data ids of the monitored items (see SOPC_LibSub_AddToSubscription())
+  @param values
+    The new values, the ith value is a const SOPC_DataValue* for the ith data id.
+    The values are not converted to ::SOPC_LibSub_Value and are freed by the LibSub after this function has been
+    called, hence the callback must copy them if they should be used outside the callback. */
+typedef void SOPC_LibSub_DataChangeBatchCbk(const SOPC_LibSub_ConnectionId c_id,
+                                            const uint32_t nb_values,
+                                            const SOPC_LibSub_DataId* d_ids,
+                                            const void* const* values);
+
 /**
   @deprecated This type is deprecated since version 1.5.0 and will be removed in version 1.6.0.
   @brief
@@ -379,6 +399,10 @@ typedef struct
       and checked to be the same during session establishment,
       NULL otherwise (no verification will be done).
       Its type shall be a pointer of ::OpcUa_GetEndpointsResponse.
+ @var SOPC_LibSub_ConnectionCfg::data_change_batch_callback
+   Optional callback for data change notifications, NULL if unused.
+   When set, it is called once per received notification with all its data changes
+   and the data_change_callback is not called.
  */
 typedef struct
 {
@@ -409,6 +433,7 @@ typedef struct
     uint16_t token_target;
     SOPC_LibSub_EventCbk* generic_response_callback;
     const void* expected_endpoints;
+    SOPC_LibSub_DataChangeBatchCbk* data_change_batch_callback;
 } SOPC_LibSub_ConnectionCfg;
 
 /*
@@ -661,6 +661,7 @@ static int32_t ConnectHelper_CreateConfiguration(SOPC_LibSub_ConnectionCfg* cfg_
     cfg_con->n_max_keepalive = MAX_KEEP_ALIVE_COUNT;
     cfg_con->n_max_lifetime = MAX_LIFETIME_COUNT;
     cfg_con->data_change_callback = NULL;
+    cfg_con->data_change_batch_callback = NULL;
     cfg_con->timeout_ms = TIMEOUT_MS;
     cfg_con->sc_lifetime = SC_LIFETIME_MS;
     cfg_con->token_target = PUBLISH_N_TOKEN;
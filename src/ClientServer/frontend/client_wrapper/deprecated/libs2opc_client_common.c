@@ -349,6 +349,7 @@ SOPC_ReturnStatus SOPC_ClientCommon_ConfigureConnection(const SOPC_LibSub_Connec
             pCfgCpy->n_max_keepalive = pCfg->n_max_keepalive;
             pCfgCpy->n_max_lifetime = pCfg->n_max_lifetime;
             pCfgCpy->data_change_callback = pCfg->data_change_callback;
+            pCfgCpy->data_change_batch_callback = pCfg->data_change_batch_callback;
             pCfgCpy->timeout_ms = pCfg->timeout_ms;
             pCfgCpy->sc_lifetime = pCfg->sc_lifetime;
             pCfgCpy->token_target = pCfg->token_target;
@@ -650,6 +651,15 @@ SOPC_ReturnStatus SOPC_ClientCommon_Connect(const SOPC_LibSub_ConfigurationId cf
                                     (uintptr_t) inhibitDisconnectCallback, &pSM);
     }
 
+    if (SOPC_STATUS_OK == status && NULL != pCfg->data_change_batch_callback)
+    {
+        status = SOPC_StaMac_ConfigureDataChangeBatchCallback(pSM, pCfg->data_change_batch_callback);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_StaMac_Delete(&pSM);
+        }
+    }
+
     SOPC_KeyManager_SerializedCertificate_Delete(pUserCertX509);
     SOPC_KeyManager_SerializedAsymmetricKey_Delete(pUserKey);
 
@@ -0,0 +1,134 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Client handles of the monitored items. See monitored_item_handles.h
+ *
+ */
+
+#include <stddef.h>
+
+#include "sopc_array.h"
+#include "sopc_assert.h"
+#include "sopc_mem_alloc.h"
+
+#include "monitored_item_handles.h"
+
+struct SOPC_MonItHandles
+{
+    SOPC_Array* slots;     /* Array of SOPC_MonItHandles_Ctx slots indexed by client handle index */
+    uint32_t freeSlotHead; /* Index + 1 of the first free slot, 0 if none */
+};
+
+static void MonItHandles_Ctx_Free(void* data)
+{
+    SOPC_MonItHandles_Ctx* ctx = (SOPC_MonItHandles_Ctx*) data;
+    SOPC_Free(ctx->nodeId);
+    ctx->nodeId = NULL;
+}
+
+SOPC_MonItHandles* SOPC_MonItHandles_Create(void)
+{
+    SOPC_MonItHandles* handles = SOPC_Calloc(1, sizeof(SOPC_MonItHandles));
+    if (NULL == handles)
+    {
+        return NULL;
+    }
+    handles->slots = SOPC_Array_Create(sizeof(SOPC_MonItHandles_Ctx), 0, MonItHandles_Ctx_Free);
+    if (NULL == handles->slots)
+    {
+        SOPC_Free(handles);
+        return NULL;
+    }
+    handles->freeSlotHead = 0;
+    return handles;
+}
+
+void SOPC_MonItHandles_Delete(SOPC_MonItHandles* handles)
+{
+    if (NULL != handles)
+    {
+        SOPC_Array_Delete(handles->slots);
+        SOPC_Free(handles);
+    }
+}
+
+uint32_t SOPC_MonItHandles_New(SOPC_MonItHandles* handles, uintptr_t userAppCtx, char* nodeId)
+{
+    SOPC_ASSERT(NULL != handles);
+
+    SOPC_MonItHandles_Ctx* ctx = NULL;
+    uint32_t slotIdx = 0;
+    if (0 != handles->freeSlotHead)
+    {
+        slotIdx = handles->freeSlotHead - 1;
+        ctx = SOPC_Array_Get_Ptr(handles->slots, slotIdx);
+        SOPC_ASSERT(!ctx->used);
+        handles->freeSlotHead = ctx->nextFree;
+    }
+    else
+    {
+        const size_t nbSlots = SOPC_Array_Size(handles->slots);
+        if (nbSlots >= MONIT_HANDLE_MAX_SLOTS || !SOPC_Array_Append_Values(handles->slots, NULL, 1))
+        {
+            return 0;
+        }
+        slotIdx = (uint32_t) nbSlots;
+        ctx = SOPC_Array_Get_Ptr(handles->slots, slotIdx);
+        ctx->generation = 0;
+    }
+    ctx->used = true;
+    ctx->nextFree = 0;
+    ctx->userAppCtx = userAppCtx;
+    ctx->nodeId = nodeId;
+    return (ctx->generation << MONIT_HANDLE_INDEX_BITS) | (slotIdx + 1);
+}
+
+SOPC_MonItHandles_Ctx* SOPC_MonItHandles_Get(SOPC_MonItHandles* handles, uint32_t clientHandle)
+{
+    SOPC_ASSERT(NULL != handles);
+
+    const uint32_t slotIdxPlusOne = clientHandle & MONIT_HANDLE_INDEX_MASK;
+    if (0 == slotIdxPlusOne || slotIdxPlusOne > SOPC_Array_Size(handles->slots))
+    {
+        return NULL;
+    }
+    SOPC_MonItHandles_Ctx* ctx = SOPC_Array_Get_Ptr(handles->slots, slotIdxPlusOne - 1);
+    if (!ctx->used || ctx->generation != clientHandle >> MONIT_HANDLE_INDEX_BITS)
+    {
+        return NULL;
+    }
+    return ctx;
+}
+
+void SOPC_MonItHandles_Release(SOPC_MonItHandles* handles, uint32_t clientHandle)
+{
+    SOPC_MonItHandles_Ctx* ctx = SOPC_MonItHandles_Get(handles, clientHandle);
+    if (NULL == ctx)
+    {
+        return;
+    }
+    MonItHandles_Ctx_Free(ctx);
+    ctx->used = false;
+    ctx->userAppCtx = 0;
+    ctx->generation = (ctx->generation + 1) & MONIT_HANDLE_GENERATION_MASK;
+    ctx->nextFree = handles->freeSlotHead;
+    handles->freeSlotHead = clientHandle & MONIT_HANDLE_INDEX_MASK;
+}
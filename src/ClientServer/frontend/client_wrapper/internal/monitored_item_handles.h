@@ -0,0 +1,94 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Client handles of the monitored items of the subscribing client state machine.
+ *
+ * A client handle identifies a slot of an array of monitored item contexts:
+ * - the low ::MONIT_HANDLE_INDEX_BITS bits hold the slot index + 1 (0 is never a valid handle),
+ * - the high bits hold the generation of the slot, incremented each time the slot is released.
+ *
+ * Released slots are chained in a free list and reused first. The handle of a deleted monitored item is therefore
+ * not confused with the handle of the monitored item reusing its slot.
+ */
+
+#ifndef MONITORED_ITEM_HANDLES_H_
+#define MONITORED_ITEM_HANDLES_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MONIT_HANDLE_INDEX_BITS 24
+#define MONIT_HANDLE_INDEX_MASK ((UINT32_C(1) << MONIT_HANDLE_INDEX_BITS) - 1)
+#define MONIT_HANDLE_MAX_SLOTS MONIT_HANDLE_INDEX_MASK
+#define MONIT_HANDLE_GENERATION_MASK (UINT32_MAX >> MONIT_HANDLE_INDEX_BITS)
+
+/* Context of a monitored item, recorded in a slot of the monitored items contexts array */
+typedef struct SOPC_MonItHandles_Ctx
+{
+    bool used;            /* The slot is used by a monitored item */
+    uint32_t generation;  /* Generation of the slot, part of the client handle */
+    uint32_t nextFree;    /* Index + 1 of the next free slot when the slot is free, 0 if none */
+    uintptr_t userAppCtx; /* User application context (new API only) */
+    char* nodeId;         /* NodeId of the monitored item (deprecated API only) */
+} SOPC_MonItHandles_Ctx;
+
+typedef struct SOPC_MonItHandles SOPC_MonItHandles;
+
+/**
+ * \brief Creates an empty set of monitored item client handles.
+ *
+ * \return The created set, or NULL in case of failure.
+ */
+SOPC_MonItHandles* SOPC_MonItHandles_Create(void);
+
+/**
+ * \brief Deletes the set of client handles and the nodeIds of the contexts.
+ */
+void SOPC_MonItHandles_Delete(SOPC_MonItHandles* handles);
+
+/**
+ * \brief Allocates a new client handle and records the monitored item context.
+ *
+ * The first free slot is reused if any, otherwise a new slot is added.
+ *
+ * \param handles     The set of client handles.
+ * \param userAppCtx  The user application context of the monitored item.
+ * \param nodeId      The nodeId of the monitored item or NULL, owned by the context in case of success.
+ *
+ * \return The new client handle, or 0 in case of failure.
+ */
+uint32_t SOPC_MonItHandles_New(SOPC_MonItHandles* handles, uintptr_t userAppCtx, char* nodeId);
+
+/**
+ * \brief Returns the context of the monitored item with the given client handle.
+ *
+ * \return The context, or NULL if the handle is unknown or was released.
+ */
+SOPC_MonItHandles_Ctx* SOPC_MonItHandles_Get(SOPC_MonItHandles* handles, uint32_t clientHandle);
+
+/**
+ * \brief Releases the client handle of a monitored item, its slot is reused by the next allocated handle.
+ *
+ * Unknown or already released handles are ignored.
+ */
+void SOPC_MonItHandles_Release(SOPC_MonItHandles* handles, uint32_t clientHandle);
+
+#endif /* MONITORED_ITEM_HANDLES_H_ */
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "opcua_statuscodes.h"
+#include "sopc_array.h"
 #include "sopc_assert.h"
 #include "sopc_atomic.h"
 #include "sopc_encodeable.h"
@@ -40,6 +41,7 @@
 #include "sopc_user_app_itf.h"
 
 #include "libs2opc_client_internal.h"
+#include "monitored_item_handles.h"
 #include "state_machine.h"
 #include "toolkit_helpers.h"
 
@@ -51,6 +53,7 @@
 static const uintptr_t DICT_TOMBSTONE = UINTPTR_MAX;
 
 /* Structures */
+
 struct SOPC_StaMac_Machine
 {
     SOPC_Mutex mutex;
@@ -60,8 +63,10 @@ struct SOPC_StaMac_Machine
         reverseConfigIdx; /* Reverse configuration index > 0 if reverse connection mechanism shall be used */
     uint32_t iCliId;      /* LibSub connection ID, used by the callback. It shall be unique. */
 
-    /* Keeping three callbacks waiting the deprecated APIs to be removed for the first 2 cbs */
+    /* Keeping four callbacks waiting the deprecated APIs to be removed for the first 3 cbs */
     SOPC_LibSub_DataChangeCbk* pCbkLibSubDataChanged;             /* Callback when subscribed data changed */
+    SOPC_LibSub_DataChangeBatchCbk* pCbkLibSubDataChangedBatch;   /* Callback with all the data changes of a
+                                                                     notification, replaces pCbkLibSubDataChanged */
     SOPC_ClientHelper_DataChangeCbk* pCbkClientHelperDataChanged; /* Callback when subscribed data changed */
     SOPC_StaMacNotification_Fct* pCbkNotification;                /* Callback when subscription notification occurs */
 
@@ -98,9 +103,16 @@ struct SOPC_StaMac_Machine
         pUserCertX509;                      /* X509 serialized certificate for X509IdentiyToken (DER or PEM format) */
     SOPC_SerializedAsymmetricKey* pUserKey; /* Serialized private key for X509IdentiyToken (DER or PEM format) */
     int64_t iTimeoutMs;                     /* See SOPC_LibSub_ConnectionCfg.timeout_ms */
-    SOPC_SLinkedList* dataIdToNodeIdList;   /* A list of data ids to node ids */
-    SOPC_Dict* miCliHandleToUserAppCtxDict; /* A dictionary of monitored client handles to user app contexts
-                                                     (new API only)*/
+    SOPC_MonItHandles* miCliHandles;        /* Monitored items contexts indexed by their client handles,
+                                               it avoids lookups when dispatching notifications */
+    uintptr_t* notifCtxArray;               /* Monitored items contexts given with a notification (new API only),
+                                               reused for each notification */
+    size_t notifCtxArrayCapacity;           /* Number of elements allocated in notifCtxArray */
+    SOPC_LibSub_DataId* batchDataIds;       /* Data ids given to pCbkLibSubDataChangedBatch, reused for each
+                                               notification */
+    const void** batchValues;               /* Values given to pCbkLibSubDataChangedBatch, reused for each
+                                               notification */
+    size_t batchCapacity;                   /* Number of elements allocated in batchDataIds and batchValues */
     SOPC_Dict* miIdToCliHandleDict;         /* A dictionary of ids to client handles (new API only)*/
     uintptr_t userContext;                  /* A state machine user defined context */
 };
@@ -189,6 +201,59 @@ static bool direct_equal(const uintptr_t a, const uintptr_t b)
     return a == b;
 }
 
+/* Allocates a new client handle and records the monitored item context, returns 0 in case of failure.
+ * The nodeId is owned by the context in case of success. */
+static uint32_t StaMac_NewMonItClientHandle(SOPC_StaMac_Machine* pSM, uintptr_t userAppCtx, char* nodeId)
+{
+    const uint32_t clientHandle = SOPC_MonItHandles_New(pSM->miCliHandles, userAppCtx, nodeId);
+    if (0 != clientHandle)
+    {
+        pSM->nMonItClientHandle = clientHandle;
+    }
+    return clientHandle;
+}
+
+/* Returns an array of at least nbElts contexts, reused between notifications, or NULL in case of failure */
+static uintptr_t* StaMac_GetNotifCtxArray(SOPC_StaMac_Machine* pSM, size_t nbElts)
+{
+    if (nbElts > pSM->notifCtxArrayCapacity)
+    {
+        uintptr_t* newArray = SOPC_Realloc(pSM->notifCtxArray, pSM->notifCtxArrayCapacity * sizeof(uintptr_t),
+                                           nbElts * sizeof(uintptr_t));
+        if (NULL == newArray)
+        {
+            return NULL;
+        }
+        pSM->notifCtxArray = newArray;
+        pSM->notifCtxArrayCapacity = nbElts;
+    }
+    return pSM->notifCtxArray;
+}
+
+/* Ensures that the arrays given to the data change batch callback can hold nbElts elements */
+static bool StaMac_ReserveBatchArrays(SOPC_StaMac_Machine* pSM, size_t nbElts)
+{
+    if (nbElts > pSM->batchCapacity)
+    {
+        SOPC_LibSub_DataId* newDataIds = SOPC_Calloc(nbElts, sizeof(SOPC_LibSub_DataId));
+        const void** newValues = SOPC_Calloc(nbElts, sizeof(void*));
+        if (NULL == newDataIds || NULL == newValues)
+        {
+            SOPC_Free(newDataIds);
+            SOPC_Free(newValues);
+            return false;
+        }
+        SOPC_Free(pSM->batchDataIds);
+        SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+        SOPC_Free((void*) pSM->batchValues);
+        SOPC_GCC_DIAGNOSTIC_RESTORE
+        pSM->batchDataIds = newDataIds;
+        pSM->batchValues = newValues;
+        pSM->batchCapacity = nbElts;
+    }
+    return true;
+}
+
 SOPC_ReturnStatus SOPC_StaMac_Create(uint32_t iscConfig,
                                      SOPC_ReverseEndpointConfigIdx reverseConfigIdx,
                                      uint32_t iCliId,
@@ -222,6 +287,7 @@ SOPC_ReturnStatus SOPC_StaMac_Create(uint32_t iscConfig,
         pSM->reverseConfigIdx = reverseConfigIdx;
         pSM->iCliId = iCliId;
         pSM->pCbkLibSubDataChanged = pCbkLibSubDataChanged;
+        pSM->pCbkLibSubDataChangedBatch = NULL;
         pSM->pCbkClientHelperDataChanged = NULL;
         pSM->iSessionCtx = 0;
         pSM->iSessionID = 0;
@@ -246,9 +312,12 @@ SOPC_ReturnStatus SOPC_StaMac_Create(uint32_t iscConfig,
         pSM->pUserCertX509 = NULL;
         pSM->pUserKey = NULL;
         pSM->iTimeoutMs = iTimeoutMs;
-        pSM->dataIdToNodeIdList = SOPC_SLinkedList_Create(0);
-        pSM->miCliHandleToUserAppCtxDict = SOPC_Dict_Create(0, uintptr_hash, direct_equal, NULL, NULL);
-        SOPC_Dict_SetTombstoneKey(pSM->miCliHandleToUserAppCtxDict, DICT_TOMBSTONE); // Necessary for remove
+        pSM->miCliHandles = SOPC_MonItHandles_Create();
+        pSM->notifCtxArray = NULL;
+        pSM->notifCtxArrayCapacity = 0;
+        pSM->batchDataIds = NULL;
+        pSM->batchValues = NULL;
+        pSM->batchCapacity = 0;
         pSM->miIdToCliHandleDict = SOPC_Dict_Create(0, uintptr_hash, direct_equal, NULL, NULL);
         SOPC_Dict_SetTombstoneKey(pSM->miIdToCliHandleDict, DICT_TOMBSTONE); // Necessary for remove
 
@@ -305,8 +374,8 @@ SOPC_ReturnStatus SOPC_StaMac_Create(uint32_t iscConfig,
     }
 
     if (SOPC_STATUS_OK == status && (NULL == pSM->pListReqCtx || NULL == pSM->pListMonIt ||
-                                     NULL == pSM->pListDelMonIt || NULL == pSM->dataIdToNodeIdList ||
-                                     NULL == pSM->miCliHandleToUserAppCtxDict || NULL == pSM->miIdToCliHandleDict))
+                                     NULL == pSM->pListDelMonIt || NULL == pSM->miCliHandles ||
+                                     NULL == pSM->miIdToCliHandleDict))
     {
         status = SOPC_STATUS_OUT_OF_MEMORY;
     }
@@ -335,7 +404,8 @@ SOPC_ReturnStatus SOPC_StaMac_ConfigureDataChangeCallback(SOPC_StaMac_Machine* p
     if (SOPC_STATUS_OK == status)
     {
         if ((NULL != pSM->pCbkLibSubDataChanged && NULL != pCbkClientHelper) ||
-            (NULL == pSM->pCbkLibSubDataChanged && NULL == pCbkClientHelper))
+            (NULL == pSM->pCbkLibSubDataChanged && NULL == pCbkClientHelper) ||
+            (NULL != pSM->pCbkLibSubDataChangedBatch && NULL != pCbkClientHelper))
         {
             /* One and only one callback type should be set */
             status = SOPC_STATUS_INVALID_STATE;
@@ -348,6 +418,34 @@ SOPC_ReturnStatus SOPC_StaMac_ConfigureDataChangeCallback(SOPC_StaMac_Machine* p
     return status;
 }
 
+SOPC_ReturnStatus SOPC_StaMac_ConfigureDataChangeBatchCallback(SOPC_StaMac_Machine* pSM,
+                                                               SOPC_LibSub_DataChangeBatchCbk* pCbkLibSubBatch)
+{
+    if (NULL == pSM || NULL == pCbkLibSubBatch)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pSM->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    /* The batch callback only replaces the LibSub callback */
+    if (NULL != pSM->pCbkNotification || NULL != pSM->pCbkClientHelperDataChanged)
+    {
+        status = SOPC_STATUS_INVALID_STATE;
+    }
+    else
+    {
+        pSM->pCbkLibSubDataChangedBatch = pCbkLibSubBatch;
+    }
+
+    mutStatus = SOPC_Mutex_Unlock(&pSM->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    return status;
+}
+
 void SOPC_StaMac_Delete(SOPC_StaMac_Machine** ppSM)
 {
     if (NULL != ppSM && NULL != *ppSM)
@@ -369,11 +467,14 @@ void SOPC_StaMac_Delete(SOPC_StaMac_Machine** ppSM)
         SOPC_Free((void*) pSM->szPolicyId);
         SOPC_Free((void*) pSM->szUsername);
         SOPC_Free((void*) pSM->szPassword);
-        SOPC_SLinkedList_Apply(pSM->dataIdToNodeIdList, SOPC_SLinkedList_EltGenericFree);
-        SOPC_SLinkedList_Delete(pSM->dataIdToNodeIdList);
-        pSM->dataIdToNodeIdList = NULL;
-        SOPC_Dict_Delete(pSM->miCliHandleToUserAppCtxDict);
-        pSM->miCliHandleToUserAppCtxDict = NULL;
+        SOPC_MonItHandles_Delete(pSM->miCliHandles);
+        pSM->miCliHandles = NULL;
+        SOPC_Free(pSM->notifCtxArray);
+        pSM->notifCtxArray = NULL;
+        SOPC_Free(pSM->batchDataIds);
+        pSM->batchDataIds = NULL;
+        SOPC_Free((void*) pSM->batchValues);
+        pSM->batchValues = NULL;
         SOPC_Dict_Delete(pSM->miIdToCliHandleDict);
         pSM->miIdToCliHandleDict = NULL;
         SOPC_KeyManager_SerializedCertificate_Delete(pSM->pUserCertX509);
@@ -777,16 +878,9 @@ SOPC_ReturnStatus SOPC_StaMac_CreateMonitoredItem(SOPC_StaMac_Machine* pSM,
             }
             else
             {
-                void* result = NULL;
-                if (pSM->nMonItClientHandle < UINT32_MAX)
-                {
-                    pSM->nMonItClientHandle++;
-                    lCliHndl[i] = pSM->nMonItClientHandle;
-                    strcpy(nodeId, lszNodeId[i]);
-                    result = (void*) SOPC_SLinkedList_Append(pSM->dataIdToNodeIdList, pSM->nMonItClientHandle,
-                                                             (uintptr_t) nodeId);
-                }
-                if (NULL == result)
+                strcpy(nodeId, lszNodeId[i]);
+                lCliHndl[i] = StaMac_NewMonItClientHandle(pSM, 0, nodeId);
+                if (0 == lCliHndl[i])
                 {
                     SOPC_Free(nodeId);
                     status = SOPC_STATUS_OUT_OF_MEMORY;
@@ -846,7 +940,8 @@ SOPC_ReturnStatus SOPC_StaMac_NewConfigureNotificationCallback(SOPC_StaMac_Machi
     SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pSM->mutex);
     SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
 
-    if (NULL != pSM->pCbkNotification || NULL != pSM->pCbkClientHelperDataChanged || NULL != pSM->pCbkLibSubDataChanged)
+    if (NULL != pSM->pCbkNotification || NULL != pSM->pCbkClientHelperDataChanged ||
+        NULL != pSM->pCbkLibSubDataChanged || NULL != pSM->pCbkLibSubDataChangedBatch)
     {
         status = SOPC_STATUS_INVALID_STATE;
     }
@@ -878,6 +973,7 @@ SOPC_ReturnStatus SOPC_StaMac_NewCreateMonitoredItems(SOPC_StaMac_Machine* pSM,
     }
 
     uint32_t nElems = (uint32_t) req->NoOfItemsToCreate;
+    uint32_t nbAllocatedHandles = 0;
 
     SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pSM->mutex);
     SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
@@ -899,39 +995,18 @@ SOPC_ReturnStatus SOPC_StaMac_NewCreateMonitoredItems(SOPC_StaMac_Machine* pSM,
     /* Fill the unique client handle parameters an record the user context associated to the MI  */
     if (SOPC_STATUS_OK == status)
     {
-        for (uint32_t i = 0; i < nElems; ++i)
+        for (uint32_t i = 0; SOPC_STATUS_OK == status && i < nElems; ++i)
         {
-            bool alreadyUsedCliHandle = false;
-            uint32_t cpt = 0;
-            if (SOPC_STATUS_OK == status && pSM->nMonItClientHandle < UINT32_MAX)
+            const uintptr_t userCtx = (userAppCtxArray != NULL ? userAppCtxArray[i] : 0);
+            const uint32_t clientHandle = StaMac_NewMonItClientHandle(pSM, userCtx, NULL);
+            if (0 == clientHandle)
             {
-                do
-                {
-                    cpt++;
-                    pSM->nMonItClientHandle++;
-                    uintptr_t result = SOPC_Dict_Get(pSM->miCliHandleToUserAppCtxDict,
-                                                     (uintptr_t) pSM->nMonItClientHandle, &alreadyUsedCliHandle);
-                    SOPC_UNUSED_RESULT(result);
-                    if (!alreadyUsedCliHandle && DICT_TOMBSTONE == (uintptr_t) cpt)
-                    {
-                        alreadyUsedCliHandle = true; // Tombstone value
-                    }
-                } while (cpt < UINT32_MAX && alreadyUsedCliHandle); // Ensure that a free handle id is found
-
-                if (!alreadyUsedCliHandle)
-                {
-                    const uintptr_t userCtx = (userAppCtxArray != NULL ? userAppCtxArray[i] : 0);
-                    bool result = SOPC_Dict_Insert(pSM->miCliHandleToUserAppCtxDict,
-                                                   (uintptr_t) pSM->nMonItClientHandle, userCtx);
-                    if (!result)
-                    {
-                        status = SOPC_STATUS_OUT_OF_MEMORY;
-                    }
-                }
-                if (SOPC_STATUS_OK == status)
-                {
-                    req->ItemsToCreate[i].RequestedParameters.ClientHandle = pSM->nMonItClientHandle;
-                }
+                status = SOPC_STATUS_OUT_OF_MEMORY;
+            }
+            else
+            {
+                req->ItemsToCreate[i].RequestedParameters.ClientHandle = clientHandle;
+                nbAllocatedHandles++;
             }
         }
 
@@ -959,6 +1034,14 @@ SOPC_ReturnStatus SOPC_StaMac_NewCreateMonitoredItems(SOPC_StaMac_Machine* pSM,
     {
         pSM->state = stCreatingMonIt;
     }
+    else
+    {
+        // Request not sent: release the client handles allocated for it
+        for (uint32_t i = 0; i < nbAllocatedHandles; ++i)
+        {
+            SOPC_MonItHandles_Release(pSM->miCliHandles, req->ItemsToCreate[i].RequestedParameters.ClientHandle);
+        }
+    }
 
     mutStatus = SOPC_Mutex_Unlock(&pSM->mutex);
     SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
@@ -1294,6 +1377,10 @@ static bool StaMac_GiveAuthorization_stActivated(SOPC_StaMac_Machine* pSM,
             authorization = true;
         }
         break;
+    case SE_SESSION_REACTIVATING:
+        /* The session is being re-activated on a new secure channel after a connection loss */
+        authorization = true;
+        break;
     default:
         break;
     }
@@ -1403,13 +1490,13 @@ static bool StaMac_GiveAuthorization_SendRequestFailed(SOPC_StaMac_Machine* pSM,
 {
     bool authorization = false;
 
-    SOPC_UNUSED_ARG(pSM);
-
     switch (event)
     {
     case SE_SND_REQUEST_FAILED:
         // We only treat a send request failed event if it concerns a timed out publish request
-        if (&OpcUa_PublishRequest_EncodeableType == pEncType && SOPC_STATUS_TIMEOUT == failureStatus)
+        // or a publish request lost with the previous secure channel during session re-activation
+        if (&OpcUa_PublishRequest_EncodeableType == pEncType &&
+            (SOPC_STATUS_TIMEOUT == failureStatus || stActivating == pSM->state))
         {
             authorization = true;
         }
@@ -1590,6 +1677,12 @@ bool SOPC_StaMac_EventDispatcher(SOPC_StaMac_Machine* pSM,
                 {
                     StaMac_ProcessMsg_CloseSessionResponse(pSM, arg, pParam, appCtx);
                 }
+                else if (SE_SESSION_REACTIVATING == event)
+                {
+                    /* Wait for the session re-activation: SE_ACTIVATED_SESSION or SE_CLOSED_SESSION */
+                    pSM->state = stActivating;
+                    Helpers_Log(SOPC_LOG_LEVEL_WARNING, "Connection lost, re-activating the session.");
+                }
                 else if (SE_RCV_SESSION_RESPONSE == event)
                 {
                     if (&OpcUa_PublishResponse_EncodeableType == pEncType)
@@ -1647,7 +1740,16 @@ bool SOPC_StaMac_EventDispatcher(SOPC_StaMac_Machine* pSM,
         else
         {
             SOPC_ASSERT(SOPC_REQUEST_SCOPE_APPLICATION == requestScope);
-            if (SE_SND_REQUEST_FAILED == event)
+            if (SE_SND_REQUEST_FAILED == event && stActivating == pSM->state)
+            {
+                /* Request lost with the previous secure channel during session re-activation */
+                Helpers_Log(SOPC_LOG_LEVEL_WARNING, "Applicative message lost during session re-activation.");
+                if (NULL != pSM->pCbkGenericEvent)
+                {
+                    (*pSM->pCbkGenericEvent)(pSM->iCliId, SOPC_LibSub_ApplicativeEvent_SendFailed, arg, NULL, appCtx);
+                }
+            }
+            else if (SE_SND_REQUEST_FAILED == event)
             {
                 pSM->state = stClosing;
                 Helpers_Log(SOPC_LOG_LEVEL_ERROR, "Applicative message could not be sent, closing the connection.");
@@ -1797,6 +1899,29 @@ static void StaMac_ProcessMsg_CloseSessionResponse(SOPC_StaMac_Machine* pSM,
     pSM->state = stError;
 }
 
+/* Gives all the data changes of the notification to the LibSub batch callback, without converting the values */
+static void StaMac_ProcessMsg_PubResp_NotifDataBatch(SOPC_StaMac_Machine* pSM, OpcUa_DataChangeNotification* pDataNotif)
+{
+    if (pDataNotif->NoOfMonitoredItems <= 0)
+    {
+        return;
+    }
+
+    size_t nbValues = (size_t) pDataNotif->NoOfMonitoredItems;
+    if (!StaMac_ReserveBatchArrays(pSM, nbValues))
+    {
+        Helpers_Log(SOPC_LOG_LEVEL_ERROR, "Failed to allocate the data changes batch, notification dropped.");
+        return;
+    }
+
+    for (size_t i = 0; i < nbValues; ++i)
+    {
+        pSM->batchDataIds[i] = pDataNotif->MonitoredItems[i].ClientHandle;
+        pSM->batchValues[i] = &pDataNotif->MonitoredItems[i].Value;
+    }
+    (*pSM->pCbkLibSubDataChangedBatch)(pSM->iCliId, (uint32_t) nbValues, pSM->batchDataIds, pSM->batchValues);
+}
+
 static void StaMac_ProcessMsg_PubResp_NotifData(SOPC_StaMac_Machine* pSM,
                                                 OpcUa_PublishResponse* pPubResp,
                                                 OpcUa_DataChangeNotification* pDataNotif)
@@ -1804,46 +1929,40 @@ static void StaMac_ProcessMsg_PubResp_NotifData(SOPC_StaMac_Machine* pSM,
     SOPC_LibSub_Value* plsVal = NULL;
     uintptr_t* newAPImonitoredItemCtxArray = NULL;
     OpcUa_MonitoredItemNotification* pMonItNotif = NULL;
+    SOPC_MonItHandles_Ctx* monItCtx = NULL;
+
+    if (NULL != pSM->pCbkLibSubDataChangedBatch) // deprecated APIs behavior, batched
+    {
+        StaMac_ProcessMsg_PubResp_NotifDataBatch(pSM, pDataNotif);
+        return;
+    }
 
     if (NULL != pSM->pCbkNotification && pDataNotif->NoOfMonitoredItems > 0)
     {
-        newAPImonitoredItemCtxArray = SOPC_Calloc((size_t) pDataNotif->NoOfMonitoredItems, sizeof(uintptr_t));
+        newAPImonitoredItemCtxArray = StaMac_GetNotifCtxArray(pSM, (size_t) pDataNotif->NoOfMonitoredItems);
     }
     for (int32_t i = 0; i < pDataNotif->NoOfMonitoredItems; ++i)
     {
         pMonItNotif = &pDataNotif->MonitoredItems[i];
+        monItCtx = SOPC_MonItHandles_Get(pSM->miCliHandles, pMonItNotif->ClientHandle);
         if (NULL != pSM->pCbkNotification) // new API behavior
         {
             // Retrieve user context associated to each MI and set it in dedicated array (same index as MI)
             if (NULL != newAPImonitoredItemCtxArray)
             {
-                bool found = false;
-                newAPImonitoredItemCtxArray[i] =
-                    SOPC_Dict_Get(pSM->miCliHandleToUserAppCtxDict, (uintptr_t) pMonItNotif->ClientHandle, &found);
-                if (!found)
+                newAPImonitoredItemCtxArray[i] = (NULL != monItCtx ? monItCtx->userAppCtx : 0);
+                if (NULL == monItCtx)
                 {
                     Helpers_Log(SOPC_LOG_LEVEL_ERROR, "Unexpected monitored item client handle not found.");
                 }
             }
         }
-        else // deprecated APIs behavior
+        else if (NULL != pSM->pCbkLibSubDataChanged) // deprecated APIs behavior
         {
             SOPC_ReturnStatus status = Helpers_NewValueFromDataValue(&pMonItNotif->Value, &plsVal);
             if (SOPC_STATUS_OK == status)
             {
-                if (NULL != pSM->pCbkLibSubDataChanged)
-                {
-                    (*pSM->pCbkLibSubDataChanged)(pSM->iCliId, pMonItNotif->ClientHandle, plsVal);
-                }
-                else if (NULL != pSM->pCbkClientHelperDataChanged && INT32_MAX >= pSM->iCliId)
-                {
-                    void* nodeId =
-                        (void*) SOPC_SLinkedList_FindFromId(pSM->dataIdToNodeIdList, pMonItNotif->ClientHandle);
-                    if (NULL != nodeId)
-                    {
-                        (*pSM->pCbkClientHelperDataChanged)((int32_t) pSM->iCliId, (char*) nodeId, &pMonItNotif->Value);
-                    }
-                }
+                (*pSM->pCbkLibSubDataChanged)(pSM->iCliId, pMonItNotif->ClientHandle, plsVal);
                 SOPC_Free(plsVal->value);
                 plsVal->value = NULL;
                 SOPC_Variant_Delete(plsVal->raw_value);
@@ -1851,6 +1970,14 @@ static void StaMac_ProcessMsg_PubResp_NotifData(SOPC_StaMac_Machine* pSM,
                 plsVal = NULL;
             }
         }
+        else if (NULL != pSM->pCbkClientHelperDataChanged && INT32_MAX >= pSM->iCliId)
+        {
+            // The DataValue is given without conversion
+            if (NULL != monItCtx && NULL != monItCtx->nodeId)
+            {
+                (*pSM->pCbkClientHelperDataChanged)((int32_t) pSM->iCliId, monItCtx->nodeId, &pMonItNotif->Value);
+            }
+        }
     }
 
     if (NULL != pSM->pCbkNotification)
@@ -1863,8 +1990,6 @@ static void StaMac_ProcessMsg_PubResp_NotifData(SOPC_StaMac_Machine* pSM,
         pSM->pCbkNotification(pSM->subscriptionAppCtx, pPubResp->ResponseHeader.ServiceResult,
                               &OpcUa_DataChangeNotification_EncodeableType, (uint32_t) pDataNotif->NoOfMonitoredItems,
                               pDataNotif, newAPImonitoredItemCtxArray);
-
-        SOPC_Free(newAPImonitoredItemCtxArray);
     }
 }
 
@@ -1876,16 +2001,14 @@ static void StaMac_ProcessMsg_PubResp_EventNotifList(SOPC_StaMac_Machine* pSM,
     uintptr_t* newAPImonitoredItemCtxArray = NULL;
     if (NULL != pSM->pCbkNotification && pEventNotif->NoOfEvents > 0)
     {
-        newAPImonitoredItemCtxArray = SOPC_Calloc((size_t) pEventNotif->NoOfEvents, sizeof(uintptr_t));
+        newAPImonitoredItemCtxArray = StaMac_GetNotifCtxArray(pSM, (size_t) pEventNotif->NoOfEvents);
     }
     // Retrieve user context associated to each MI and set it in dedicated array (same index as MI)
     for (int32_t i = 0; NULL != newAPImonitoredItemCtxArray && i < pEventNotif->NoOfEvents; ++i)
     {
-        bool found = false;
-        uintptr_t userAppCtx = (uintptr_t) SOPC_Dict_Get(pSM->miCliHandleToUserAppCtxDict,
-                                                         (uintptr_t) pEventNotif->Events[i].ClientHandle, &found);
-        newAPImonitoredItemCtxArray[i] = userAppCtx;
-        if (!found)
+        SOPC_MonItHandles_Ctx* monItCtx = SOPC_MonItHandles_Get(pSM->miCliHandles, pEventNotif->Events[i].ClientHandle);
+        newAPImonitoredItemCtxArray[i] = (NULL != monItCtx ? monItCtx->userAppCtx : 0);
+        if (NULL == monItCtx)
         {
             Helpers_Log(SOPC_LOG_LEVEL_ERROR, "Unexpected monitored item client handle not found.");
         }
@@ -2051,13 +2174,9 @@ static void StaMac_ProcessMsg_DeleteSubscriptionResponse(SOPC_StaMac_Machine* pS
     pSM->nMonItClientHandle = 0;
     SOPC_SLinkedList_Clear(pSM->pListMonIt);
     SOPC_SLinkedList_Clear(pSM->pListDelMonIt);
-    SOPC_SLinkedList_Apply(pSM->dataIdToNodeIdList, SOPC_SLinkedList_EltGenericFree);
-    SOPC_SLinkedList_Clear(pSM->dataIdToNodeIdList);
-    SOPC_Dict_Delete(pSM->miCliHandleToUserAppCtxDict);
-    pSM->miCliHandleToUserAppCtxDict = SOPC_Dict_Create(0, uintptr_hash, direct_equal, NULL, NULL);
-    // Note: avoid to delete the dict by implementing SOPC_Dict_Clear
-    SOPC_ASSERT(NULL != pSM->miCliHandleToUserAppCtxDict);
-    SOPC_Dict_SetTombstoneKey(pSM->miCliHandleToUserAppCtxDict, DICT_TOMBSTONE); // Necessary for remove
+    SOPC_MonItHandles_Delete(pSM->miCliHandles);
+    pSM->miCliHandles = SOPC_MonItHandles_Create();
+    SOPC_ASSERT(NULL != pSM->miCliHandles);
 
     SOPC_Dict_Delete(pSM->miIdToCliHandleDict);
     pSM->miIdToCliHandleDict = SOPC_Dict_Create(0, uintptr_hash, direct_equal, NULL, NULL);
@@ -2107,6 +2226,12 @@ static void StaMac_ProcessMsg_CreateMonitoredItemsResponse(SOPC_StaMac_Machine*
                 }
             }
         }
+        if (!SOPC_IsGoodStatus(pMonItResp->Results[i].StatusCode) && NULL != pMonItReq &&
+            i < pMonItReq->NoOfItemsToCreate)
+        {
+            // Monitored item not created: its client handle can be reused
+            SOPC_MonItHandles_Release(pSM->miCliHandles, pMonItReq->ItemsToCreate[i].RequestedParameters.ClientHandle);
+        }
     }
     if (pMonItResp->NoOfResults > 0)
     {
@@ -2155,7 +2280,7 @@ static void StaMac_ProcessMsg_DeleteMonitoredItemsResponse(SOPC_StaMac_Machine*
             {
                 // Remove internal context associated
                 SOPC_Dict_Remove(pSM->miIdToCliHandleDict, (uintptr_t) pMonItReq->MonitoredItemIds[i]);
-                SOPC_Dict_Remove(pSM->miCliHandleToUserAppCtxDict, miCliHandle);
+                SOPC_MonItHandles_Release(pSM->miCliHandles, (uint32_t) miCliHandle);
             }
             else
             {
@@ -154,6 +154,13 @@ SOPC_ReturnStatus SOPC_StaMac_Create(uint32_t iscConfig,
 SOPC_ReturnStatus SOPC_StaMac_ConfigureDataChangeCallback(SOPC_StaMac_Machine* pSM,
                                                           SOPC_ClientHelper_DataChangeCbk* pCbkClientHelper);
 
+/*
+ * \brief Sets the callback that receives all the data changes of a notification at once (LibSub API only).
+ *        When set, it is called instead of the LibSub data change callback given to SOPC_StaMac_Create().
+ */
+SOPC_ReturnStatus SOPC_StaMac_ConfigureDataChangeBatchCallback(SOPC_StaMac_Machine* pSM,
+                                                               SOPC_LibSub_DataChangeBatchCbk* pCbkLibSubBatch);
+
 /**
  * \brief Deletes and deallocate the machine.
  */
@@ -286,6 +293,7 @@ SOPC_ReturnStatus SOPC_StaMac_CreateMonitoredItem(SOPC_StaMac_Machine* pSM,
  * \param monitoredItemCtxArray Array of context for monitored items for which notification were received in
  *                              \p notification.
  *                              Notification element and monitored item context have the same index in the array.
+ *                              The array is only valid during the callback, it is reused for next notifications.
  *
  */
 typedef void SOPC_StaMacNotification_Fct(uintptr_t subscriptionAppCtx,
@@ -17,17 +17,21 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <string.h>
 
 #include "libs2opc_client_internal.h"
 #include "libs2opc_common_config.h"
 #include "libs2opc_new_client.h"
+#include "libs2opc_request_builder.h"
 
 #include "sopc_assert.h"
 #include "sopc_encodeable.h"
 #include "sopc_logger.h"
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
+#include "sopc_threads.h"
+#include "sopc_time.h"
 #include "sopc_toolkit_async_api.h"
 #include "sopc_toolkit_config.h"
 #include "sopc_toolkit_config_internal.h"
@@ -58,14 +62,31 @@ struct SOPC_ClientConnection
     SOPC_StaMac_Machine* stateMachine; // only if !isDiscovery
 };
 
+/* Minimum number of completions allocated in a completion queue */
+#define COMPLETION_QUEUE_MIN_CAPACITY 16
+
+struct SOPC_ClientHelper_CompletionQueue
+{
+    SOPC_Mutex mutex;     /* protect the queue */
+    SOPC_Condition cond;  /* signaled when a completion is added */
+    uint32_t nbPending;   /* number of requests sent which completions were not retrieved yet */
+    /* Circular buffer of completions not retrieved yet, its capacity is always >= nbPending to guarantee
+     * a completion can be added without allocation */
+    SOPC_ClientHelper_Completion* completions;
+    uint32_t capacity;
+    uint32_t first;
+    uint32_t nbCompleted;
+};
+
 /* The request context is used to manage
    synchronous/asynchronous context for a request */
 typedef struct
 {
     uint16_t secureConnectionIdx;
 
-    bool isAsyncCall; /* If call is async the callback is set */
+    bool isAsyncCall; /* If call is async the callback or the completion queue is set */
     SOPC_ServiceAsyncResp_Fct* asyncRespCb;
+    SOPC_ClientHelper_CompletionQueue* completionQueue;
     uintptr_t userCtx;
 
     SOPC_Mutex mutex; /* protect this context */
@@ -115,12 +136,14 @@ static SOPC_ClientHelper_ReqCtx* SOPC_ClientHelperInternal_GenReqCtx_CreateSync(
     return result;
 }
 
-static SOPC_ClientHelper_ReqCtx* SOPC_ClientHelperInternal_GenReqCtx_CreateAsync(uint16_t secureConnectionIdx,
-                                                                                 bool isDiscoveryModeService,
-                                                                                 SOPC_ServiceAsyncResp_Fct* asyncRespCb,
-                                                                                 uintptr_t userContext)
+static SOPC_ClientHelper_ReqCtx* SOPC_ClientHelperInternal_GenReqCtx_CreateAsync(
+    uint16_t secureConnectionIdx,
+    bool isDiscoveryModeService,
+    SOPC_ServiceAsyncResp_Fct* asyncRespCb,
+    SOPC_ClientHelper_CompletionQueue* completionQueue,
+    uintptr_t userContext)
 {
-    SOPC_ASSERT(NULL != asyncRespCb);
+    SOPC_ASSERT((NULL != asyncRespCb) != (NULL != completionQueue));
 
     SOPC_ClientHelper_ReqCtx* result = SOPC_Calloc(1, sizeof(*result));
     SOPC_ReturnStatus status = SOPC_STATUS_NOK;
@@ -129,6 +152,7 @@ static SOPC_ClientHelper_ReqCtx* SOPC_ClientHelperInternal_GenReqCtx_CreateAsync
         result->secureConnectionIdx = secureConnectionIdx;
         result->isAsyncCall = true;
         result->asyncRespCb = asyncRespCb;
+        result->completionQueue = completionQueue;
         result->userCtx = userContext;
         // finished => already false
         result->status = SOPC_STATUS_NOK;
@@ -255,6 +279,56 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_MayFinalizeSecureConnection(
 /* Lifetime Count of subscriptions */
 #define TMP_MAX_LIFETIME_COUNT 10
 
+// Moves the received response content into a new response allocated for the application
+// (the received response content is reset to avoid its deallocation by caller)
+static SOPC_ReturnStatus SOPC_ClientHelperInternal_MoveResponse(const void* response, void** appResponse)
+{
+    SOPC_EncodeableType* pEncType = *(SOPC_EncodeableType* const*) response;
+
+    SOPC_ReturnStatus status = SOPC_Encodeable_Create(pEncType, appResponse);
+    if (SOPC_STATUS_OK == status)
+    {
+        SOPC_ASSERT(NULL != *appResponse);
+        // Move response to application context
+        *appResponse = memcpy(*appResponse, response, pEncType->AllocationSize);
+        // Avoid dealloc by caller by resetting content of provided response
+        SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+        SOPC_EncodeableObject_Initialize(pEncType, (void*) response);
+        SOPC_GCC_DIAGNOSTIC_RESTORE
+    }
+    else
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "SOPC_ClientInternal_EventCbk: unexpected error for %s creation", pEncType->TypeName);
+    }
+    return status;
+}
+
+// Adds the completion of a request to the completion queue,
+// the capacity of the queue was already reserved when the request was sent
+static void SOPC_ClientHelperInternal_CompletionQueue_Push(SOPC_ClientHelper_CompletionQueue* queue,
+                                                           SOPC_ReturnStatus status,
+                                                           void* response,
+                                                           uintptr_t userContext)
+{
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    SOPC_ASSERT(queue->nbCompleted < queue->nbPending && queue->nbPending <= queue->capacity);
+    SOPC_ClientHelper_Completion* completion =
+        &queue->completions[(queue->first + queue->nbCompleted) % queue->capacity];
+    completion->status = status;
+    completion->responseType = (NULL == response ? NULL : *(SOPC_EncodeableType**) response);
+    completion->response = response;
+    completion->userContext = userContext;
+    queue->nbCompleted++;
+
+    mutStatus = SOPC_Mutex_Unlock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    mutStatus = SOPC_Condition_SignalAll(&queue->cond);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+}
+
 static void SOPC_ClientInternal_EventCbk(SOPC_LibSub_ConnectionId c_id,
                                          SOPC_LibSub_ApplicativeEvent event,
                                          SOPC_StatusCode status, /* Note: actually a ReturnStatus */
@@ -268,7 +342,18 @@ static void SOPC_ClientInternal_EventCbk(SOPC_LibSub_ConnectionId c_id,
     SOPC_ReturnStatus statusMutex = SOPC_Mutex_Lock(&genCtx->mutex);
     SOPC_ASSERT(SOPC_STATUS_OK == statusMutex);
 
-    if (genCtx->isAsyncCall)
+    if (genCtx->isAsyncCall && NULL != genCtx->completionQueue)
+    {
+        isAsync = true;
+        void* appResponse = NULL;
+        if (SOPC_LibSub_ApplicativeEvent_Response == event)
+        {
+            status = SOPC_ClientHelperInternal_MoveResponse(response, &appResponse);
+        } // else: response is NULL and status is not OK
+        SOPC_ClientHelperInternal_CompletionQueue_Push(genCtx->completionQueue, status, appResponse,
+                                                       genCtx->userCtx);
+    }
+    else if (genCtx->isAsyncCall)
     {
         isAsync = true;
         SOPC_EncodeableType* pEncType = NULL;
@@ -284,27 +369,7 @@ static void SOPC_ClientInternal_EventCbk(SOPC_LibSub_ConnectionId c_id,
         SOPC_ASSERT(NULL != responseContext);
         if (SOPC_LibSub_ApplicativeEvent_Response == event)
         {
-            SOPC_EncodeableType* pEncType = *(SOPC_EncodeableType* const*) response;
-
-            void** genResponseContext = (void**) responseContext;
-
-            status = SOPC_Encodeable_Create(pEncType, genResponseContext);
-            if (SOPC_STATUS_OK == status)
-            {
-                SOPC_ASSERT(NULL != *genResponseContext);
-                // Move response to application context
-                *genResponseContext = memcpy(*genResponseContext, response, pEncType->AllocationSize);
-                // Avoid dealloc by caller by resetting content of provided response
-                SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
-                SOPC_EncodeableObject_Initialize(pEncType, (void*) response);
-                SOPC_GCC_DIAGNOSTIC_RESTORE
-            }
-            else
-            {
-                SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
-                                       "SOPC_ClientInternal_EventCbk: unexpected error for %s creation",
-                                       pEncType->TypeName);
-            }
+            status = SOPC_ClientHelperInternal_MoveResponse(response, (void**) responseContext);
         } // else: response is NULL and status is not OK
     }
     genCtx->status = status;
@@ -349,7 +414,7 @@ static void SOPC_ClientInternal_ConnectionStateCallback(SOPC_App_Com_Event event
         }
         else
         {
-            /* Unexpected connection event
+            /* Session re-activation after a connection loss, unexpected connection event
                or asynchronous connection operation response (NOT IMPLEMENTED YET) */
             SOPC_ClientConnectionEvent connEvent;
             SOPC_StatusCode serviceStatus = SOPC_GoodGenericStatus;
@@ -364,7 +429,7 @@ static void SOPC_ClientInternal_ConnectionStateCallback(SOPC_App_Com_Event event
                     (SOPC_StatusCode)(uintptr_t) param; // TODO: casting void to unintptr is not legit, only reverse is
                 break;
             case SE_SESSION_REACTIVATING:
-                connEvent = SOPC_ClientConnectionEvent_Disconnected; // TODO: reconnecting when managed by SM
+                connEvent = SOPC_ClientConnectionEvent_Reconnecting;
                 serviceStatus = OpcUa_BadWouldBlock;
                 break;
             case SE_CLOSED_SESSION:
@@ -376,7 +441,13 @@ static void SOPC_ClientInternal_ConnectionStateCallback(SOPC_App_Com_Event event
                 SOPC_ASSERT(false);
                 return;
             }
-            cc->connCb(cc, connEvent, serviceStatus);
+            // The callback is changed by the connection pool when the connection is acquired or released
+            statusMutex = SOPC_Mutex_Lock(&sopc_client_helper_config.configMutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == statusMutex);
+            SOPC_ClientConnectionEvent_Fct* connCb = cc->connCb;
+            statusMutex = SOPC_Mutex_Unlock(&sopc_client_helper_config.configMutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == statusMutex);
+            connCb(cc, connEvent, serviceStatus);
         }
     }
 }
@@ -601,7 +672,7 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_DiscoveryService(bool isSynch
         else
         {
             reqCtx = SOPC_ClientHelperInternal_GenReqCtx_CreateAsync(
-                res->secureConnectionIdx, true, sopc_client_helper_config.asyncRespCb, userContext);
+                res->secureConnectionIdx, true, sopc_client_helper_config.asyncRespCb, NULL, userContext);
         }
         if (NULL == smReqCtx || NULL == reqCtx)
         {
@@ -963,10 +1034,69 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_FilterService(SOPC_ClientConn
     return SOPC_STATUS_OK;
 }
 
+// Reserves a completion in the completion queue for a new request
+static SOPC_ReturnStatus SOPC_ClientHelperInternal_CompletionQueue_Reserve(SOPC_ClientHelper_CompletionQueue* queue)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    if (UINT32_MAX == queue->nbPending)
+    {
+        status = SOPC_STATUS_INVALID_STATE;
+    }
+    else if (queue->nbPending == queue->capacity)
+    {
+        uint32_t capacity =
+            (queue->capacity < COMPLETION_QUEUE_MIN_CAPACITY ? COMPLETION_QUEUE_MIN_CAPACITY : 2 * queue->capacity);
+        if (capacity <= queue->capacity)
+        {
+            capacity = UINT32_MAX;
+        }
+        SOPC_ClientHelper_Completion* completions = SOPC_Calloc(capacity, sizeof(*completions));
+        if (NULL == completions)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+        else
+        {
+            // Copy the completions not retrieved yet at the beginning of the new buffer
+            for (uint32_t i = 0; i < queue->nbCompleted; i++)
+            {
+                completions[i] = queue->completions[(queue->first + i) % queue->capacity];
+            }
+            SOPC_Free(queue->completions);
+            queue->completions = completions;
+            queue->capacity = capacity;
+            queue->first = 0;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        queue->nbPending++;
+    }
+
+    mutStatus = SOPC_Mutex_Unlock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    return status;
+}
+
+// Cancels the reservation of a completion for a request which was not sent
+static void SOPC_ClientHelperInternal_CompletionQueue_CancelReserve(SOPC_ClientHelper_CompletionQueue* queue)
+{
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    SOPC_ASSERT(queue->nbPending > queue->nbCompleted);
+    queue->nbPending--;
+    mutStatus = SOPC_Mutex_Unlock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+}
+
 static SOPC_ReturnStatus SOPC_ClientHelperInternal_Service(bool isSynchronous,
                                                            SOPC_ClientConnection* secureConnection,
                                                            void* request,
                                                            void** response,
+                                                           SOPC_ClientHelper_CompletionQueue* completionQueue,
                                                            uintptr_t userContext)
 {
     if (NULL == secureConnection || NULL == request)
@@ -991,7 +1121,7 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_Service(bool isSynchronous,
     SOPC_ClientHelper_ReqCtx* reqCtx = NULL;
 
     if (secureConnection != sopc_client_helper_config.secureConnections[secureConnection->secureConnectionIdx] ||
-        (!isSynchronous && NULL == sopc_client_helper_config.asyncRespCb))
+        (!isSynchronous && NULL == completionQueue && NULL == sopc_client_helper_config.asyncRespCb))
     {
         status = SOPC_STATUS_INVALID_STATE;
     }
@@ -1006,10 +1136,15 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_Service(bool isSynchronous,
             reqCtx =
                 SOPC_ClientHelperInternal_GenReqCtx_CreateSync(secureConnection->secureConnectionIdx, response, false);
         }
+        else if (NULL != completionQueue)
+        {
+            reqCtx = SOPC_ClientHelperInternal_GenReqCtx_CreateAsync(secureConnection->secureConnectionIdx, false,
+                                                                     NULL, completionQueue, userContext);
+        }
         else
         {
             reqCtx = SOPC_ClientHelperInternal_GenReqCtx_CreateAsync(
-                secureConnection->secureConnectionIdx, false, sopc_client_helper_config.asyncRespCb, userContext);
+                secureConnection->secureConnectionIdx, false, sopc_client_helper_config.asyncRespCb, NULL, userContext);
         }
         if (NULL == reqCtx)
         {
@@ -1017,6 +1152,16 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_Service(bool isSynchronous,
         }
     }
 
+    if (SOPC_STATUS_OK == status && NULL != completionQueue)
+    {
+        status = SOPC_ClientHelperInternal_CompletionQueue_Reserve(completionQueue);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_ClientHelperInternal_GenReqCtx_ClearAndFree(reqCtx);
+            reqCtx = NULL;
+        }
+    }
+
     mutStatus = SOPC_Mutex_Unlock(&sopc_client_helper_config.configMutex);
     SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
 
@@ -1049,10 +1194,19 @@ static SOPC_ReturnStatus SOPC_ClientHelperInternal_Service(bool isSynchronous,
         statusMutex = SOPC_Mutex_Unlock(&reqCtx->mutex);
         SOPC_ASSERT(SOPC_STATUS_OK == statusMutex);
 
-        if (isSynchronous && NULL != reqCtx)
+        if (isSynchronous)
         {
             SOPC_ClientHelperInternal_GenReqCtx_ClearAndFree(reqCtx);
         }
+        else if (SOPC_STATUS_OK != status)
+        {
+            // Request was not sent: no response expected
+            if (NULL != completionQueue)
+            {
+                SOPC_ClientHelperInternal_CompletionQueue_CancelReserve(completionQueue);
+            }
+            SOPC_ClientHelperInternal_GenReqCtx_ClearAndFree(reqCtx);
+        }
     }
 
     return status;
@@ -1062,14 +1216,638 @@ SOPC_ReturnStatus SOPC_ClientHelperNew_ServiceAsync(SOPC_ClientConnection* secur
                                                     void* request,
                                                     uintptr_t userContext)
 {
-    return SOPC_ClientHelperInternal_Service(false, secureConnection, request, NULL, userContext);
+    return SOPC_ClientHelperInternal_Service(false, secureConnection, request, NULL, NULL, userContext);
 }
 
 SOPC_ReturnStatus SOPC_ClientHelperNew_ServiceSync(SOPC_ClientConnection* secureConnection,
                                                    void* request,
                                                    void** response)
 {
-    return SOPC_ClientHelperInternal_Service(true, secureConnection, request, response, 0);
+    return SOPC_ClientHelperInternal_Service(true, secureConnection, request, response, NULL, 0);
+}
+
+SOPC_ClientHelper_CompletionQueue* SOPC_ClientHelperNew_CompletionQueue_Create(void)
+{
+    SOPC_ClientHelper_CompletionQueue* queue = SOPC_Calloc(1, sizeof(*queue));
+    if (NULL == queue)
+    {
+        return NULL;
+    }
+    SOPC_ReturnStatus status = SOPC_Mutex_Initialization(&queue->mutex);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Condition_Init(&queue->cond);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Mutex_Clear(&queue->mutex);
+        }
+    }
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Free(queue);
+        queue = NULL;
+    }
+    return queue;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_CompletionQueue_Delete(SOPC_ClientHelper_CompletionQueue** queue)
+{
+    if (NULL == queue || NULL == *queue)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_ClientHelper_CompletionQueue* q = *queue;
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&q->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    bool requestsInProgress = q->nbPending > q->nbCompleted;
+    mutStatus = SOPC_Mutex_Unlock(&q->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    if (requestsInProgress)
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+
+    // Delete the responses not retrieved
+    for (uint32_t i = 0; i < q->nbCompleted; i++)
+    {
+        SOPC_ClientHelper_Completion* completion = &q->completions[(q->first + i) % q->capacity];
+        if (NULL != completion->response)
+        {
+            SOPC_Encodeable_Delete(completion->responseType, &completion->response);
+        }
+    }
+    SOPC_Free(q->completions);
+    SOPC_Condition_Clear(&q->cond);
+    SOPC_Mutex_Clear(&q->mutex);
+    SOPC_Free(q);
+    *queue = NULL;
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_ServiceAsyncToQueue(SOPC_ClientConnection* secureConnection,
+                                                           void* request,
+                                                           SOPC_ClientHelper_CompletionQueue* completionQueue,
+                                                           uintptr_t userContext)
+{
+    if (NULL == completionQueue)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    return SOPC_ClientHelperInternal_Service(false, secureConnection, request, NULL, completionQueue, userContext);
+}
+
+uint32_t SOPC_ClientHelperNew_CompletionQueue_Poll(SOPC_ClientHelper_CompletionQueue* queue,
+                                                   SOPC_ClientHelper_Completion* completions,
+                                                   uint32_t maxCompletions,
+                                                   uint32_t timeoutMs)
+{
+    if (NULL == queue || NULL == completions || 0 == maxCompletions)
+    {
+        return 0;
+    }
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    // Wait for a completion only if a request is in progress
+    if (0 == queue->nbCompleted && queue->nbPending > 0 && timeoutMs > 0)
+    {
+        const SOPC_TimeReference deadline =
+            SOPC_TimeReference_AddMilliseconds(SOPC_TimeReference_GetCurrent(), timeoutMs);
+        SOPC_TimeReference now = SOPC_TimeReference_GetCurrent();
+        while (SOPC_STATUS_OK == mutStatus && 0 == queue->nbCompleted && SOPC_TimeReference_Compare(now, deadline) < 0)
+        {
+            mutStatus = SOPC_Mutex_UnlockAndTimedWaitCond(&queue->cond, &queue->mutex, (uint32_t)(deadline - now));
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus || SOPC_STATUS_TIMEOUT == mutStatus);
+            now = SOPC_TimeReference_GetCurrent();
+        }
+    }
+
+    const uint32_t nbCompletions = (queue->nbCompleted < maxCompletions ? queue->nbCompleted : maxCompletions);
+    for (uint32_t i = 0; i < nbCompletions; i++)
+    {
+        completions[i] = queue->completions[queue->first];
+        queue->first = (queue->first + 1) % queue->capacity;
+    }
+    queue->nbCompleted -= nbCompletions;
+    queue->nbPending -= nbCompletions;
+
+    mutStatus = SOPC_Mutex_Unlock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    return nbCompletions;
+}
+
+uint32_t SOPC_ClientHelperNew_CompletionQueue_NbPending(SOPC_ClientHelper_CompletionQueue* queue)
+{
+    if (NULL == queue)
+    {
+        return 0;
+    }
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    const uint32_t nbPending = queue->nbPending;
+    mutStatus = SOPC_Mutex_Unlock(&queue->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    return nbPending;
+}
+
+/* Node read to keep alive the idle connections of a connection pool: Server_ServerStatus_State */
+#define CONNECTION_POOL_KEEP_ALIVE_NODE "i=2259"
+
+typedef struct
+{
+    SOPC_ClientConnection* connection;
+    SOPC_TimeReference lastUse; /* release time or last keep alive response time */
+    bool keepAliveInProgress;   /* set while the keep alive thread uses the connection */
+} SOPC_ClientHelper_PooledConnection;
+
+struct SOPC_ClientHelper_ConnectionPool
+{
+    SOPC_Mutex mutex;        /* protect the pool */
+    SOPC_Condition cond;     /* signaled when the keep alive thread shall stop */
+    SOPC_Condition idleCond; /* signaled when an idle connection is not used by the keep alive thread anymore */
+    SOPC_Thread keepAliveThread;
+    bool stopKeepAlive;
+    uint32_t keepAliveMs;
+
+    /* Idle connections ordered by release time (oldest first) */
+    SOPC_ClientHelper_PooledConnection* idleConnections;
+    uint32_t maxIdleConnections;
+
+    SOPC_ClientHelper_ConnectionPoolStats stats; /* stats.nbIdle is the number of idle connections */
+};
+
+static bool SOPC_ClientHelperInternal_SameString(const char* left, const char* right)
+{
+    if (NULL == left || NULL == right)
+    {
+        return left == right;
+    }
+    return 0 == strcmp(left, right);
+}
+
+static bool SOPC_ClientHelperInternal_SameCertificate(const SOPC_SerializedCertificate* left,
+                                                      const SOPC_SerializedCertificate* right)
+{
+    if (NULL == left || NULL == right)
+    {
+        return left == right;
+    }
+    return left->length == right->length && 0 == memcmp(left->data, right->data, left->length);
+}
+
+/* Returns true if a connection established with one of the configurations can be used for the other one:
+ * same endpoint, security and user. */
+static bool SOPC_ClientHelperInternal_ConnectionPool_SameKey(const SOPC_SecureConnection_Config* left,
+                                                             const SOPC_SecureConnection_Config* right)
+{
+    if (left == right)
+    {
+        return true;
+    }
+    const SOPC_Session_Config* leftSession = &left->sessionConfig;
+    const SOPC_Session_Config* rightSession = &right->sessionConfig;
+    const SOPC_SecureChannel_Config* leftSc = &left->scConfig;
+    const SOPC_SecureChannel_Config* rightSc = &right->scConfig;
+    bool same = SOPC_ClientHelperInternal_SameString(leftSc->url, rightSc->url) &&
+                SOPC_ClientHelperInternal_SameString(left->reverseURL, right->reverseURL) &&
+                SOPC_ClientHelperInternal_SameString(leftSc->reqSecuPolicyUri, rightSc->reqSecuPolicyUri) &&
+                leftSc->msgSecurityMode == rightSc->msgSecurityMode &&
+                leftSession->userTokenType == rightSession->userTokenType &&
+                SOPC_ClientHelperInternal_SameString(leftSession->userPolicyId, rightSession->userPolicyId);
+    if (same && OpcUa_UserTokenType_UserName == leftSession->userTokenType)
+    {
+        same = SOPC_ClientHelperInternal_SameString(leftSession->userToken.userName.userName,
+                                                    rightSession->userToken.userName.userName) &&
+               SOPC_ClientHelperInternal_SameString(leftSession->userToken.userName.userPwd,
+                                                    rightSession->userToken.userName.userPwd);
+    }
+    else if (same && OpcUa_UserTokenType_Certificate == leftSession->userTokenType)
+    {
+        same = SOPC_ClientHelperInternal_SameCertificate(leftSession->userToken.userX509.certX509,
+                                                         rightSession->userToken.userX509.certX509);
+    }
+    return same;
+}
+
+static void SOPC_ClientHelperInternal_ConnectionPool_IdleEventCb(SOPC_ClientConnection* config,
+                                                                 SOPC_ClientConnectionEvent event,
+                                                                 SOPC_StatusCode status)
+{
+    SOPC_UNUSED_ARG(config);
+    SOPC_Logger_TraceInfo(SOPC_LOG_MODULE_CLIENTSERVER,
+                          "ConnectionPool: idle connection event %d received with status 0x%08" PRIX32, event, status);
+}
+
+static void SOPC_ClientHelperInternal_SetConnectionEventCb(SOPC_ClientConnection* secureConnection,
+                                                           SOPC_ClientConnectionEvent_Fct* connectEventCb)
+{
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&sopc_client_helper_config.configMutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    secureConnection->connCb = connectEventCb;
+    mutStatus = SOPC_Mutex_Unlock(&sopc_client_helper_config.configMutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+}
+
+/* Pool mutex shall be locked by the caller */
+static void SOPC_ClientHelperInternal_ConnectionPool_RemoveIdle(SOPC_ClientHelper_ConnectionPool* pool, uint32_t idx)
+{
+    SOPC_ASSERT(idx < pool->stats.nbIdle);
+    pool->stats.nbIdle--;
+    if (idx < pool->stats.nbIdle)
+    {
+        memmove(&pool->idleConnections[idx], &pool->idleConnections[idx + 1],
+                (pool->stats.nbIdle - idx) * sizeof(*pool->idleConnections));
+    }
+}
+
+/* Pool mutex shall be locked by the caller, returns nbIdle if not found */
+static uint32_t SOPC_ClientHelperInternal_ConnectionPool_FindIdle(SOPC_ClientHelper_ConnectionPool* pool,
+                                                                  const SOPC_ClientConnection* secureConnection)
+{
+    uint32_t idx = 0;
+    while (idx < pool->stats.nbIdle && secureConnection != pool->idleConnections[idx].connection)
+    {
+        idx++;
+    }
+    return idx;
+}
+
+static void SOPC_ClientHelperInternal_ConnectionPool_Discard(SOPC_ClientConnection* secureConnection)
+{
+    SOPC_ReturnStatus status = SOPC_ClientHelperNew_Disconnect(&secureConnection);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                 "ConnectionPool: failed to disconnect a discarded connection (status %d)", status);
+    }
+}
+
+static SOPC_ReturnStatus SOPC_ClientHelperInternal_ConnectionPool_KeepAlive(SOPC_ClientConnection* secureConnection)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OUT_OF_MEMORY;
+    OpcUa_ReadRequest* request = SOPC_ReadRequest_Create(1, OpcUa_TimestampsToReturn_Neither);
+    OpcUa_ReadResponse* response = NULL;
+    if (NULL != request)
+    {
+        status = SOPC_ReadRequest_SetReadValueFromStrings(request, 0, CONNECTION_POOL_KEEP_ALIVE_NODE,
+                                                          SOPC_AttributeId_Value, NULL);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Encodeable_Delete(&OpcUa_ReadRequest_EncodeableType, (void**) &request);
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ServiceSync(secureConnection, request, (void**) &response);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        // Any response (including a ServiceFault) keeps the session alive
+        SOPC_Encodeable_Delete(response->encodeableType, (void**) &response);
+    }
+    return status;
+}
+
+/* Sends a keep alive request on the connections idle for keepAliveMs and discards the lost connections */
+static void* SOPC_ClientHelperInternal_ConnectionPool_KeepAliveThread(void* arg)
+{
+    SOPC_ClientHelper_ConnectionPool* pool = (SOPC_ClientHelper_ConnectionPool*) arg;
+    const uint32_t checkPeriodMs = (pool->keepAliveMs > 1 ? pool->keepAliveMs / 2 : 1);
+
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    while (!pool->stopKeepAlive)
+    {
+        mutStatus = SOPC_Mutex_UnlockAndTimedWaitCond(&pool->cond, &pool->mutex, checkPeriodMs);
+        SOPC_ASSERT(SOPC_STATUS_OK == mutStatus || SOPC_STATUS_TIMEOUT == mutStatus);
+
+        uint32_t idx = 0;
+        while (!pool->stopKeepAlive && idx < pool->stats.nbIdle)
+        {
+            SOPC_ClientHelper_PooledConnection* pooled = &pool->idleConnections[idx];
+            SOPC_ClientConnection* secureConnection = pooled->connection;
+            const SOPC_TimeReference keepAliveTime =
+                SOPC_TimeReference_AddMilliseconds(pooled->lastUse, pool->keepAliveMs);
+            if (SOPC_StaMac_IsError(secureConnection->stateMachine))
+            {
+                // Connection lost (re-activation failed): discard it, pool is unlocked during disconnection
+                SOPC_ClientHelperInternal_ConnectionPool_RemoveIdle(pool, idx);
+                pool->stats.discarded++;
+                mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+                SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+                SOPC_ClientHelperInternal_ConnectionPool_Discard(secureConnection);
+                mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+                SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+                // Idle connections might have changed: restart from the beginning
+                idx = 0;
+            }
+            else if (SOPC_StaMac_IsConnected(secureConnection->stateMachine) &&
+                     SOPC_TimeReference_Compare(keepAliveTime, SOPC_TimeReference_GetCurrent()) <= 0)
+            {
+                // The connection is neither acquired nor evicted while the keep alive is in progress
+                pooled->keepAliveInProgress = true;
+                mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+                SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+                SOPC_ReturnStatus status = SOPC_ClientHelperInternal_ConnectionPool_KeepAlive(secureConnection);
+                mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+                SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+                idx = SOPC_ClientHelperInternal_ConnectionPool_FindIdle(pool, secureConnection);
+                SOPC_ASSERT(idx < pool->stats.nbIdle);
+                pooled = &pool->idleConnections[idx];
+                pooled->keepAliveInProgress = false;
+                pooled->lastUse = SOPC_TimeReference_GetCurrent();
+                pool->stats.keepAlives++;
+                mutStatus = SOPC_Condition_SignalAll(&pool->idleCond);
+                SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+                if (SOPC_STATUS_OK != status)
+                {
+                    SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                             "ConnectionPool: keep alive request failed (status %d)", status);
+                }
+                idx++;
+            }
+            else
+            {
+                idx++;
+            }
+        }
+    }
+    mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    return NULL;
+}
+
+SOPC_ClientHelper_ConnectionPool* SOPC_ClientHelperNew_ConnectionPool_Create(uint32_t maxIdleConnections,
+                                                                             uint32_t keepAliveMs)
+{
+    if (0 == keepAliveMs)
+    {
+        return NULL;
+    }
+    SOPC_ClientHelper_ConnectionPool* pool = SOPC_Calloc(1, sizeof(*pool));
+    if (NULL == pool)
+    {
+        return NULL;
+    }
+    pool->keepAliveMs = keepAliveMs;
+    pool->maxIdleConnections = maxIdleConnections;
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    if (maxIdleConnections > 0)
+    {
+        pool->idleConnections = SOPC_Calloc(maxIdleConnections, sizeof(*pool->idleConnections));
+        status = (NULL == pool->idleConnections ? SOPC_STATUS_OUT_OF_MEMORY : SOPC_STATUS_OK);
+    }
+    bool mutexInit = false;
+    bool condInit = false;
+    bool idleCondInit = false;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Mutex_Initialization(&pool->mutex);
+        mutexInit = (SOPC_STATUS_OK == status);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Condition_Init(&pool->cond);
+        condInit = (SOPC_STATUS_OK == status);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Condition_Init(&pool->idleCond);
+        idleCondInit = (SOPC_STATUS_OK == status);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Thread_Create(&pool->keepAliveThread, SOPC_ClientHelperInternal_ConnectionPool_KeepAliveThread,
+                                    pool, "CliConnPool");
+    }
+    if (SOPC_STATUS_OK != status)
+    {
+        if (idleCondInit)
+        {
+            SOPC_Condition_Clear(&pool->idleCond);
+        }
+        if (condInit)
+        {
+            SOPC_Condition_Clear(&pool->cond);
+        }
+        if (mutexInit)
+        {
+            SOPC_Mutex_Clear(&pool->mutex);
+        }
+        SOPC_Free(pool->idleConnections);
+        SOPC_Free(pool);
+        pool = NULL;
+    }
+    return pool;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Delete(SOPC_ClientHelper_ConnectionPool** pool)
+{
+    if (NULL == pool || NULL == *pool)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_ClientHelper_ConnectionPool* p = *pool;
+
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&p->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    p->stopKeepAlive = true;
+    mutStatus = SOPC_Condition_SignalAll(&p->cond);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    mutStatus = SOPC_Mutex_Unlock(&p->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    mutStatus = SOPC_Thread_Join(p->keepAliveThread);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    // No concurrent access to the pool anymore
+    for (uint32_t i = 0; i < p->stats.nbIdle; i++)
+    {
+        SOPC_ClientHelperInternal_ConnectionPool_Discard(p->idleConnections[i].connection);
+    }
+    SOPC_Free(p->idleConnections);
+    SOPC_Condition_Clear(&p->idleCond);
+    SOPC_Condition_Clear(&p->cond);
+    SOPC_Mutex_Clear(&p->mutex);
+    SOPC_Free(p);
+    *pool = NULL;
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Acquire(SOPC_ClientHelper_ConnectionPool* pool,
+                                                              SOPC_SecureConnection_Config* secConnConfig,
+                                                              SOPC_ClientConnectionEvent_Fct* connectEventCb,
+                                                              SOPC_ClientConnection** secureConnection)
+{
+    if (NULL == pool || NULL == secConnConfig || NULL == connectEventCb || NULL == secureConnection)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_S2OPC_Config* pConfig = SOPC_CommonHelper_GetConfiguration();
+    SOPC_ClientConnection* res = NULL;
+
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    bool busyMatch = true;
+    while (NULL == res && busyMatch)
+    {
+        busyMatch = false;
+        SOPC_ClientConnection* lost = NULL;
+        // Reuse the most recently released connection: the least likely to be lost
+        for (uint32_t i = pool->stats.nbIdle; NULL == res && NULL == lost && i > 0; i--)
+        {
+            SOPC_ClientHelper_PooledConnection* pooled = &pool->idleConnections[i - 1];
+            const SOPC_SecureConnection_Config* pooledConfig =
+                pConfig->clientConfig.secureConnections[pooled->connection->secureConnectionIdx];
+            const bool match = SOPC_ClientHelperInternal_ConnectionPool_SameKey(secConnConfig, pooledConfig);
+            if (match && !pooled->keepAliveInProgress && SOPC_StaMac_IsConnected(pooled->connection->stateMachine))
+            {
+                res = pooled->connection;
+                SOPC_ClientHelperInternal_ConnectionPool_RemoveIdle(pool, i - 1);
+                pool->stats.hits++;
+            }
+            else if (match && !pooled->keepAliveInProgress && SOPC_StaMac_IsError(pooled->connection->stateMachine))
+            {
+                lost = pooled->connection;
+                SOPC_ClientHelperInternal_ConnectionPool_RemoveIdle(pool, i - 1);
+                pool->stats.discarded++;
+            }
+            else if (match)
+            {
+                // Used by the keep alive thread or session being re-activated
+                busyMatch = true;
+            }
+        }
+        if (NULL != lost)
+        {
+            // Its configuration might be the requested one: disconnect it before any new connection
+            mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+            SOPC_ClientHelperInternal_ConnectionPool_Discard(lost);
+            mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+            busyMatch = true;
+        }
+        else if (NULL == res && busyMatch)
+        {
+            // A matching connection is used by the keep alive thread or being re-activated. Its configuration might
+            // be the requested one, which cannot be used for a new connection: wait until it is available or lost.
+            mutStatus = SOPC_Mutex_UnlockAndTimedWaitCond(&pool->idleCond, &pool->mutex, CONNECTION_TIMEOUT_MS_STEP);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus || SOPC_STATUS_TIMEOUT == mutStatus);
+        }
+    }
+    mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    if (NULL != res)
+    {
+        SOPC_ClientHelperInternal_SetConnectionEventCb(res, connectEventCb);
+    }
+    else
+    {
+        status = SOPC_ClientHelperNew_Connect(secConnConfig, connectEventCb, &res);
+        if (SOPC_STATUS_OK == status)
+        {
+            mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+            pool->stats.misses++;
+            mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        *secureConnection = res;
+    }
+    return status;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Release(SOPC_ClientHelper_ConnectionPool* pool,
+                                                              SOPC_ClientConnection** secureConnection)
+{
+    if (NULL == pool || NULL == secureConnection || NULL == *secureConnection)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_ClientConnection* released = *secureConnection;
+    if (SOPC_StaMac_HasSubscription(released->stateMachine))
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+    if (!SOPC_StaMac_IsConnected(released->stateMachine))
+    {
+        SOPC_ReturnStatus status = SOPC_ClientHelperNew_Disconnect(secureConnection);
+        if (SOPC_STATUS_OK == status)
+        {
+            SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+            pool->stats.discarded++;
+            mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+        }
+        return status;
+    }
+
+    SOPC_ClientHelperInternal_SetConnectionEventCb(released, SOPC_ClientHelperInternal_ConnectionPool_IdleEventCb);
+
+    SOPC_ClientConnection* evicted = released;
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    if (pool->stats.nbIdle == pool->maxIdleConnections)
+    {
+        // Evict the oldest idle connection not used by the keep alive thread
+        uint32_t idx = 0;
+        while (idx < pool->stats.nbIdle && pool->idleConnections[idx].keepAliveInProgress)
+        {
+            idx++;
+        }
+        if (idx < pool->stats.nbIdle)
+        {
+            evicted = pool->idleConnections[idx].connection;
+            SOPC_ClientHelperInternal_ConnectionPool_RemoveIdle(pool, idx);
+        }
+    }
+    if (evicted != released || pool->stats.nbIdle < pool->maxIdleConnections)
+    {
+        SOPC_ClientHelper_PooledConnection* pooled = &pool->idleConnections[pool->stats.nbIdle];
+        pooled->connection = released;
+        pooled->lastUse = SOPC_TimeReference_GetCurrent();
+        pooled->keepAliveInProgress = false;
+        pool->stats.nbIdle++;
+        if (evicted == released)
+        {
+            evicted = NULL;
+        }
+    }
+    if (NULL != evicted)
+    {
+        pool->stats.discarded++;
+    }
+    mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    if (NULL != evicted)
+    {
+        SOPC_ClientHelperInternal_ConnectionPool_Discard(evicted);
+    }
+    *secureConnection = NULL;
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_GetStatistics(SOPC_ClientHelper_ConnectionPool* pool,
+                                                                    SOPC_ClientHelper_ConnectionPoolStats* stats)
+{
+    if (NULL == pool || NULL == stats)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Lock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    *stats = pool->stats;
+    mutStatus = SOPC_Mutex_Unlock(&pool->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+    return SOPC_STATUS_OK;
 }
 
 struct SOPC_ClientHelper_Subscription
@@ -63,13 +63,14 @@ typedef enum
                                                 - ::SOPC_ClientHelperNew_Disconnect on current connection
                                                 - ::SOPC_ClientHelperNew_Connect to create a new connection
                                               */
-    SOPC_ClientConnectionEvent_Connected,    /**< (NOT IMPLEMENTED YET) Connection established (SC & session), only
-                                                triggered when asynchronous SOPC_ClientHelperNew_StartConnection is used
-                                                or in case of reconnection.
+    SOPC_ClientConnectionEvent_Connected,    /**< Connection established (SC & session), only triggered in case of
+                                                reconnection (or when asynchronous SOPC_ClientHelperNew_StartConnection
+                                                is used, NOT IMPLEMENTED YET).
                                               */
-    SOPC_ClientConnectionEvent_Reconnecting, /**< (NOT IMPLEMENTED YET) Connection temporarily interrupted,
-                                                  attempt to re-establish connection on-going.
-                                                  Do not use connection until Connected event received */
+    SOPC_ClientConnectionEvent_Reconnecting, /**< Connection temporarily interrupted, the session is being re-activated
+                                                  on a new secure channel.
+                                                  Do not use connection until Connected event received.
+                                                  Disconnected event is received if the re-activation fails. */
 } SOPC_ClientConnectionEvent;
 
 /**
@@ -280,6 +281,191 @@ SOPC_ReturnStatus SOPC_ClientHelperNew_ServiceSync(SOPC_ClientConnection* secure
                                                    void* request,
                                                    void** response);
 
+/**
+ * \brief Queue of the completions of the services executed with ::SOPC_ClientHelperNew_ServiceAsyncToQueue.
+ *
+ * It allows to keep many requests in progress on one or several connections without blocking the application thread
+ * nor the client thread: the completions are retrieved by batches using ::SOPC_ClientHelperNew_CompletionQueue_Poll.
+ */
+typedef struct SOPC_ClientHelper_CompletionQueue SOPC_ClientHelper_CompletionQueue;
+
+/**
+ * \brief Completion of a service executed with ::SOPC_ClientHelperNew_ServiceAsyncToQueue
+ */
+typedef struct SOPC_ClientHelper_Completion
+{
+    SOPC_ReturnStatus status; /**< SOPC_STATUS_OK if the response was received, otherwise the request failure status */
+    SOPC_EncodeableType* responseType; /**< Type of the response or NULL if \c status is not SOPC_STATUS_OK */
+    void* response; /**< The service response or NULL if \c status is not SOPC_STATUS_OK.
+                         Caller is responsible of the response memory (e.g. use ::SOPC_Encodeable_Delete). */
+    uintptr_t userContext; /**< The user context provided with the request */
+} SOPC_ClientHelper_Completion;
+
+/**
+ * \brief Creates a completion queue to be used with ::SOPC_ClientHelperNew_ServiceAsyncToQueue
+ *
+ * \return the completion queue or NULL in case of failure
+ */
+SOPC_ClientHelper_CompletionQueue* SOPC_ClientHelperNew_CompletionQueue_Create(void);
+
+/**
+ * \brief Deletes a completion queue and the responses it contains that were not retrieved yet
+ *
+ * \param queue  Pointer to the completion queue to delete, set to NULL during successful call.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters,
+ *         otherwise SOPC_STATUS_INVALID_STATE if requests sent with the queue are still in progress.
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_CompletionQueue_Delete(SOPC_ClientHelper_CompletionQueue** queue);
+
+/**
+ * \brief Executes an OPC UA service on server (read, write, browse, etc.) asynchronously,
+ *        the response or the request failure is added to the given completion queue.
+ *
+ * Contrary to ::SOPC_ClientHelperNew_ServiceAsync, no callback is called from the client thread:
+ * the completions shall be retrieved using ::SOPC_ClientHelperNew_CompletionQueue_Poll.
+ * It allows to keep many requests in progress (up to ::SOPC_MAX_PENDING_REQUESTS for all the connections).
+ *
+ * \note ::SOPC_ClientHelperNew_Connect shall have been called and the connection shall be still active
+ *
+ * \param secureConnection The client connection instance to use to execute the service
+ * \param request          An instance of OPC UA request (see ::SOPC_ClientHelperNew_ServiceAsync)
+ * \param completionQueue  The completion queue to which the completion of the service is added
+ * \param userContext      User defined context provided in the ::SOPC_ClientHelper_Completion of the service
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters,
+ *         SOPC_STATUS_OUT_OF_MEMORY in case of memory allocation failure,
+ *         otherwise SOPC_STATUS_INVALID_STATE if the client is not running.
+ *
+ * \note Request memory is managed by the client after a successful return
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_ServiceAsyncToQueue(SOPC_ClientConnection* secureConnection,
+                                                           void* request,
+                                                           SOPC_ClientHelper_CompletionQueue* completionQueue,
+                                                           uintptr_t userContext);
+
+/**
+ * \brief Retrieves the completions available in the completion queue (in the order they were received).
+ *        If no completion is available and requests are in progress, waits for a completion at most \p timeoutMs.
+ *
+ * \param queue           The completion queue
+ * \param completions     Array into which the retrieved completions are provided
+ * \param maxCompletions  Maximum number of completions to retrieve (number of elements in \p completions)
+ * \param timeoutMs       Maximum time to wait for a completion in milliseconds (0 to return immediately)
+ *
+ * \return the number of completions provided in \p completions.
+ *         The caller is responsible of the memory of the responses provided in the completions.
+ */
+uint32_t SOPC_ClientHelperNew_CompletionQueue_Poll(SOPC_ClientHelper_CompletionQueue* queue,
+                                                   SOPC_ClientHelper_Completion* completions,
+                                                   uint32_t maxCompletions,
+                                                   uint32_t timeoutMs);
+
+/**
+ * \brief Returns the number of requests sent with the completion queue which completions were not retrieved yet
+ *        (requests in progress and completions available).
+ */
+uint32_t SOPC_ClientHelperNew_CompletionQueue_NbPending(SOPC_ClientHelper_CompletionQueue* queue);
+
+/**
+ * \brief Pool of client connections which keeps the released connections activated to reuse them.
+ *
+ * Establishing a connection (secure channel opening with asymmetric cryptography, session creation and activation)
+ * is costly. A connection released into the pool is kept idle and is provided again by
+ * ::SOPC_ClientHelperNew_ConnectionPool_Acquire for a secure connection configuration with the same endpoint URL,
+ * security policy, security mode and user. The idle connections are kept alive by a periodic Read request and the
+ * lost ones are discarded. The session of a connection lost is re-activated on a new secure channel by the client
+ * (see ::SOPC_ClientConnectionEvent_Reconnecting).
+ *
+ * \note A secure connection configuration is used by one connection at most: to keep several connections to the same
+ *       server, several secure connection configurations with the same parameters shall be defined.
+ */
+typedef struct SOPC_ClientHelper_ConnectionPool SOPC_ClientHelper_ConnectionPool;
+
+/**
+ * \brief Statistics of a connection pool
+ */
+typedef struct SOPC_ClientHelper_ConnectionPoolStats
+{
+    uint32_t hits;       /**< Number of acquired connections provided from the idle connections */
+    uint32_t misses;     /**< Number of acquired connections newly established */
+    uint32_t nbIdle;     /**< Number of idle connections in the pool */
+    uint32_t discarded;  /**< Number of connections closed by the pool (lost, idle pool full or pool deleted) */
+    uint32_t keepAlives; /**< Number of keep alive requests sent on idle connections */
+} SOPC_ClientHelper_ConnectionPoolStats;
+
+/**
+ * \brief Creates a connection pool
+ *
+ * \param maxIdleConnections  Maximum number of idle connections kept in the pool, the oldest idle connection is closed
+ *                            when a connection is released in a full pool.
+ * \param keepAliveMs         Delay (ms) without use after which a Read request is sent on an idle connection to keep
+ *                            its session and secure channel alive. It shall be smaller than the session timeout.
+ *
+ * \return the connection pool or NULL in case of failure
+ */
+SOPC_ClientHelper_ConnectionPool* SOPC_ClientHelperNew_ConnectionPool_Create(uint32_t maxIdleConnections,
+                                                                             uint32_t keepAliveMs);
+
+/**
+ * \brief Deletes a connection pool and disconnects its idle connections.
+ *        The connections acquired and not released shall be disconnected with ::SOPC_ClientHelperNew_Disconnect.
+ *
+ * \param pool  Pointer to the connection pool to delete, set to NULL during successful call.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters.
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Delete(SOPC_ClientHelper_ConnectionPool** pool);
+
+/**
+ * \brief Provides an activated connection for the given secure connection configuration: an idle connection of the
+ *        pool with the same endpoint URL, security policy, security mode and user if any, otherwise a new connection
+ *        established with ::SOPC_ClientHelperNew_Connect.
+ *
+ * \note When the matching idle connections are used by the keep alive requests or being re-activated, the call waits
+ *       until one of them is available again or lost. The lost ones are disconnected before any new connection.
+ *
+ * \param pool             The connection pool
+ * \param secConnConfig    The secure connection configuration to use for a new connection
+ * \param connectEventCb   The callback called on connection event while the connection is acquired
+ * \param[out] secureConnection  The acquired connection.
+ *                               It shall be released with ::SOPC_ClientHelperNew_ConnectionPool_Release or
+ *                               disconnected with ::SOPC_ClientHelperNew_Disconnect.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters,
+ *         otherwise the status returned by ::SOPC_ClientHelperNew_Connect.
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Acquire(SOPC_ClientHelper_ConnectionPool* pool,
+                                                              SOPC_SecureConnection_Config* secConnConfig,
+                                                              SOPC_ClientConnectionEvent_Fct* connectEventCb,
+                                                              SOPC_ClientConnection** secureConnection);
+
+/**
+ * \brief Releases a connection into the pool to be reused. The connection is disconnected if it is not activated.
+ *
+ * \note The subscription of the connection shall have been deleted before release.
+ *
+ * \param pool              The connection pool
+ * \param secureConnection  Pointer to the connection to release, set to NULL during successful call.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters,
+ *         SOPC_STATUS_INVALID_STATE if the connection has a subscription,
+ *         otherwise the status returned by ::SOPC_ClientHelperNew_Disconnect.
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_Release(SOPC_ClientHelper_ConnectionPool* pool,
+                                                              SOPC_ClientConnection** secureConnection);
+
+/**
+ * \brief Retrieves the statistics of a connection pool
+ *
+ * \param pool        The connection pool
+ * \param[out] stats  The statistics of the pool
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters.
+ */
+SOPC_ReturnStatus SOPC_ClientHelperNew_ConnectionPool_GetStatistics(SOPC_ClientHelper_ConnectionPool* pool,
+                                                                    SOPC_ClientHelper_ConnectionPoolStats* stats);
+
 typedef struct SOPC_ClientHelper_Subscription SOPC_ClientHelper_Subscription;
 
 /**
@@ -302,6 +488,7 @@ typedef struct SOPC_ClientHelper_Subscription SOPC_ClientHelper_Subscription;
  * \param monitoredItemCtxArray Array of context for monitored items for which notification were received in
  *                              \p notification.
  *                              Notification element and monitored item context have the same index in the array.
+ *                              The array is only valid during the callback, it is reused for next notifications.
  *
  */
 typedef void SOPC_ClientSubscriptionNotification_Fct(const SOPC_ClientHelper_Subscription* subscription,
@@ -38,7 +38,8 @@ Connection objects are instances of the `pys2opc.connection.BaseClientConnection
 With connections, you can `pys2opc.connection.BaseClientConnectionHandler.read_nodes`,
 `pys2opc.connection.BaseClientConnectionHandler.write_nodes` and `pys2opc.connection.BaseClientConnectionHandler.browse_nodes`.
 You can also `pys2opc.connection.BaseClientConnectionHandler.add_nodes_to_subscription`,
-and receive notifications through `pys2opc.connection.BaseClientConnectionHandler.on_datachanged`.
+and receive notifications through `pys2opc.connection.BaseClientConnectionHandler.on_datachanged`,
+or all the notifications of a publish response at once through `pys2opc.connection.BaseClientConnectionHandler.on_datachanged_batch`.
 
 >>> from pys2opc import PyS2OPC_Client as PyS2OPC
 >>> PyS2OPC.get_version()
@@ -118,7 +119,7 @@ Once the types are deduced, values may be modified and they will keep their type
 
 from _pys2opc import ffi, lib as libsub
 from .s2opc import VERSION, PyS2OPC_Client, PyS2OPC_Server, ClientConfiguration, ServerConfiguration, BaseAddressSpaceHandler
-from .connection import BaseClientConnectionHandler
+from .connection import BaseClientConnectionHandler, DataChangeFormat, DataChangeColumns
 from .types import Variant, VariantType, DataValue, AttributeId, ReturnStatus, StatusCode, SecurityPolicy, SecurityMode, NodeClass, LogLevel
 from .request import Request
 
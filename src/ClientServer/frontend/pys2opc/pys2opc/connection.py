@@ -19,11 +19,44 @@
 # under the License.
 
 
+import array
+
 from _pys2opc import ffi, lib as libsub
-from .types import ReturnStatus
+from .types import ReturnStatus, DataValue, _array_typecode
 from .request import Request, LibSubAsyncRequestHandler
 
 
+class DataChangeFormat:
+    """
+    Formats of the data changes given to `pys2opc.connection.BaseClientConnectionHandler.on_datachanged_batch`.
+    """
+    Tuples = 0  # A list of (handle, value, timestamp, status) tuples
+    Columns = 1  # A `pys2opc.connection.DataChangeColumns`
+
+
+class DataChangeColumns:
+    """
+    The data changes of a notification, stored by columns.
+    The ith element of each column describes the same data change.
+
+    Attributes:
+        handles: `array.array` of the handles of the changed nodes (see `pys2opc.connection.BaseClientConnectionHandler.add_nodes_to_subscription`).
+        values: List of the new `pys2opc.types.Variant`s.
+        timestamps: `array.array` of the source timestamps of the values, as Python timestamps.
+        statuses: `array.array` of the status codes of the values (see `pys2opc.types.StatusCode`).
+    """
+    _uint32_typecode = _array_typecode('u', 4)
+
+    def __init__(self):
+        self.handles = array.array(DataChangeColumns._uint32_typecode)
+        self.values = []
+        self.timestamps = array.array('d')
+        self.statuses = array.array(DataChangeColumns._uint32_typecode)
+
+    def __len__(self):
+        return len(self.handles)
+
+
 class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
     """
     Base class giving the prototypes of the callbacks,
@@ -31,7 +64,13 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
 
     The class supports Python's "with" statements.
     In this case, the connection is automatically closed upon exit of the context.
+
+    Attributes:
+        datachange_format: Class attribute: the `pys2opc.connection.DataChangeFormat` of the data changes given to
+                           `pys2opc.connection.BaseClientConnectionHandler.on_datachanged_batch`, when it is overridden.
     """
+    datachange_format = DataChangeFormat.Tuples
+
     def __init__(self, connId, configuration):
         super().__init__()
         self._id = connId
@@ -52,6 +91,28 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
         assert dataId in self._dSubscription, 'Data change notification on unknown NodeId'
         self.on_datachanged(self._dSubscription[dataId], value)
 
+    def _on_datachanged_batch(self, nbValues, dataIds, c_values):
+        """
+        Internal wrapper, calls on_datachanged_batch() with all the data changes of a notification,
+        or on_datachanged() for each data change when on_datachanged_batch() is not overridden.
+        The values are copied, as they are freed after the callback.
+        """
+        values = (DataValue.from_sopc_datavalue(ffi.cast('SOPC_DataValue*', c_values[i])) for i in range(nbValues))
+        if type(self).on_datachanged_batch is BaseClientConnectionHandler.on_datachanged_batch:
+            for i, value in enumerate(values):
+                self._on_datachanged(dataIds[i], value)
+        elif self.datachange_format == DataChangeFormat.Columns:
+            columns = DataChangeColumns()
+            columns.handles.frombytes(ffi.buffer(dataIds, nbValues * ffi.sizeof('SOPC_LibSub_DataId')))
+            for value in values:
+                columns.values.append(value.variant)
+                columns.timestamps.append(value.timestampSource)
+                columns.statuses.append(value.statusCode)
+            self.on_datachanged_batch(columns)
+        else:
+            self.on_datachanged_batch([(dataIds[i], value.variant, value.timestampSource, value.statusCode)
+                                       for i, value in enumerate(values)])
+
     def _on_disconnect(self):
         """
         Internal wrapper, calls on_disconnect()
@@ -78,6 +139,20 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
         `dataValue` is the new value (see `pys2opc.types.DataValue`).
         """
         raise NotImplementedError
+    def on_datachanged_batch(self, dataChanges):
+        """
+        This callback is called once with all the data changes of a received notification,
+        which avoids a callback from the Toolkit for each value.
+        When it is not overridden, `pys2opc.connection.BaseClientConnectionHandler.on_datachanged` is called
+        for each data change instead.
+
+        The format of `dataChanges` is given by `datachange_format` (see `pys2opc.connection.DataChangeFormat`):
+        either a list of (handle, value, timestamp, status) tuples, or a `pys2opc.connection.DataChangeColumns`.
+        The handles are the ones returned by `pys2opc.connection.BaseClientConnectionHandler.add_nodes_to_subscription`,
+        the values are `pys2opc.types.Variant`s, the timestamps are the source timestamps of the values,
+        and the statuses are their `pys2opc.types.StatusCode`.
+        """
+        raise NotImplementedError
     def on_disconnect(self):
         """
         Called when the disconnection of this connection is effective.
@@ -109,6 +184,11 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
 
         The callback `pys2opc.connection.BaseClientConnectionHandler.on_datachanged` will be called once for each new value of the nodes.
         In particular, the callback is at least called once for the initial value.
+        When `pys2opc.connection.BaseClientConnectionHandler.on_datachanged_batch` is overridden,
+        it is called instead with all the new values of a notification.
+
+        All the nodes are added with a single request, and the returned list contains the handle of each node,
+        which identifies the node in `pys2opc.connection.BaseClientConnectionHandler.on_datachanged_batch`.
         """
         # TODO: check format?
         if nodeIds:
@@ -121,6 +201,8 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
             for i, nid in zip(lDataIds, nodeIds):
                 assert i not in self._dSubscription, 'data_id returned by Toolkit is already associated to a NodeId.'
                 self._dSubscription[i] = nid
+            return list(lDataIds)
+        return []
 
     # Specialized request sender
     def read_nodes(self, nodeIds, attributes=None, bWaitResponse=True):
@@ -135,7 +217,8 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
         request = Request.new_read_request(nodeIds, attributes=attributes)
         return self.send_generic_request(self._id, request, bWaitResponse=bWaitResponse)
 
-    def write_nodes(self, nodeIds, datavalues, attributes=None, types=None, bWaitResponse=True, bAutoTypeWithRead=True):
+    def write_nodes(self, nodeIds, datavalues, attributes=None, types=None, bWaitResponse=True, bAutoTypeWithRead=True,
+                    bUseTypeCache=True):
         """
         Forges an `OpcUa_WriteResponse` and sends it.
         When `bWaitResponse`, waits for  and returns the `pys2opc.responses.WriteResponse`,
@@ -147,6 +230,14 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
         The request is only sent when at least one datavalue lacks type in both `datavalue.variantType` and `types`.
         The type deduction may fail if the node does not exist or if the value is a `null`.
 
+        When `bUseTypeCache`, the missing types are first searched in the `typeCache` of the connection
+        (see `pys2opc.request.DataTypeCache`), and only the types that are not cached are read.
+        The types that are read are added to the cache.
+        The cache entry of a node is removed when its write fails with `BadTypeMismatch`.
+
+        All the nodes are written with a single `WriteRequest`,
+        and all the missing types are read with a single `ReadRequest`.
+
         See `pys2opc.request.Request.new_write_request` for details on the other arguments.
 
         Note:
@@ -158,7 +249,8 @@ class BaseClientConnectionHandler(LibSubAsyncRequestHandler):
         # Where there are unknown types, makes a read request first
         if bAutoTypeWithRead:
             sendFct = lambda request,**kwargs: self.send_generic_request(self._id, request, **kwargs)
-            types = Request.helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct)
+            typeCache = self.typeCache if bUseTypeCache else None
+            types = Request.helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct, typeCache=typeCache)
 
         # Make the actual write request
         request = Request.new_write_request(nodeIds, datavalues, attributes=attributes, types=types)
@@ -23,7 +23,7 @@ import threading
 import time
 
 from _pys2opc import ffi, lib as libsub
-from .types import ReturnStatus, EncodeableType, allocator_no_gc, AttributeId, str_to_nodeid, VariantType
+from .types import ReturnStatus, EncodeableType, allocator_no_gc, AttributeId, str_to_nodeid, VariantType, StatusCode
 from .responses import Response, ReadResponse, WriteResponse, BrowseResponse
 
 
@@ -38,6 +38,8 @@ class Request:
     Attributes:
         eventResponseReceived: Event that is set when the response is received (`AsyncRequestHandler.on_generic_response` called for this `Request`).
         requestContext: A (unique) identifier for the request (read-only).
+        typeCacheKeys: For write requests, the list of the (NodeId, attribute) that are written,
+                       used to invalidate the `DataTypeCache` entries of the writes that failed with a type mismatch.
     """
     def __init__(self, payload):
         self.timestampSent = None  # The sender of the request sets the timestamp
@@ -48,6 +50,7 @@ class Request:
         self._requestContextVoid = ffi.new_handle(self)  # Keep the void* to avoid garbage collection, ...
         self._requestContext = ffi.cast('uintptr_t', self._requestContextVoid)  # ... but only use the casted value.
         self.payload = payload
+        self.typeCacheKeys = None
 
     @property
     def requestContext(self):
@@ -137,7 +140,9 @@ class Request:
             nodesToWrite[i].Value = val.to_sopc_datavalue(no_gc=True)[0]
         payload.NodesToWrite = nodesToWrite
 
-        return Request(payload)
+        request = Request(payload)
+        request.typeCacheKeys = list(zip(nodeIds, attributes))
+        return request
 
     @staticmethod
     def new_browse_request(nodeIds, maxReferencesPerNode=1000):
@@ -168,9 +173,11 @@ class Request:
 
         return Request(payload)
 
-    def helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct):
+    def helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct, typeCache=None):
         """
         Internal helper that makes a `Request` to read the missing types, if any, in the provided `datavalues` and `types` list.
+        When a `DataTypeCache` is given, the types are searched in the cache first,
+        and the cache is updated with the types that were read.
         Return the type list.
         Used by `write_nodes` implementations.
         """
@@ -188,18 +195,89 @@ class Request:
 
         # Compute missing types, send the request, and update the missing types.
         sopc_types = [dv.variantType if dv.variantType is not None else ty for dv,ty in zip(datavalues, types)]
+        if typeCache is not None:
+            sopc_types = [ty if ty is not None else typeCache.get(snid, attr, dv.variant)
+                          for snid,attr,dv,ty in zip(nodeIds, attributes, datavalues, sopc_types)]
         missingTypesInfo = [(i, snid, attr) for i,(snid,attr,ty) in enumerate(zip(nodeIds, attributes, sopc_types)) if ty is None]
         if missingTypesInfo:
             _, readNids, readAttrs = zip(*missingTypesInfo)
             request = Request.new_read_request(readNids, readAttrs)
             readDatavalues = sendFct(request, bWaitResponse=True)
-            for (i, _, _), dv in zip(missingTypesInfo, readDatavalues.results):
+            for (i, snid, attr), dv in zip(missingTypesInfo, readDatavalues.results):
                 assert dv.variantType != VariantType.Null, 'Automatic type detection failed, null type read.'
                 sopc_types[i] = dv.variantType
+                if typeCache is not None:
+                    typeCache.update(snid, attr, dv.variant)
 
         return sopc_types
 
 
+class DataTypeCache:
+    """
+    Cache of the types of the nodes to write, so that `write_nodes` implementations do not read
+    the type of a node before each write.
+
+    The cache associates a couple (NodeId, attribute) to the `pys2opc.types.VariantType` of its value
+    and to its value rank (`DataTypeCache.ValueRankScalar` or `DataTypeCache.ValueRankOneDimension`).
+    It is filled lazily with the values read to find the missing types.
+    An entry is removed when a write on its node fails with `pys2opc.types.StatusCode.BadTypeMismatch`,
+    so that the type is read again on the next write.
+
+    The cache is thread-safe, as responses are received in a thread of the Toolkit.
+    """
+    ValueRankScalar = -1
+    ValueRankOneDimension = 1
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._dTypes = {}  # {(NodeId, attribute): (VariantType, ValueRank)}
+
+    def __len__(self):
+        return len(self._dTypes)
+
+    @staticmethod
+    def _value_rank(variant, variantType):
+        return DataTypeCache.ValueRankOneDimension if variant.is_array(variantType) else DataTypeCache.ValueRankScalar
+
+    def get(self, nodeId, attribute, variant):
+        """
+        Returns the cached `pys2opc.types.VariantType` of the attribute of the node,
+        or None if it is unknown or if the value rank of the `pys2opc.types.Variant` to write differs from the cached one.
+        """
+        with self._lock:
+            cached = self._dTypes.get((nodeId, attribute))
+        if cached is None:
+            return None
+        variantType, valueRank = cached
+        if DataTypeCache._value_rank(variant, variantType) != valueRank:
+            return None
+        return variantType
+
+    def update(self, nodeId, attribute, variant):
+        """
+        Caches the type and value rank of the `pys2opc.types.Variant` read from the attribute of the node.
+        """
+        entry = (variant.variantType, DataTypeCache._value_rank(variant, variant.variantType))
+        with self._lock:
+            self._dTypes[(nodeId, attribute)] = entry
+
+    def invalidate_mismatches(self, typeCacheKeys, results):
+        """
+        Removes the entries of the (NodeId, attribute) in `typeCacheKeys` whose write result is `BadTypeMismatch`.
+        """
+        with self._lock:
+            for key, status in zip(typeCacheKeys, results):
+                if status == StatusCode.BadTypeMismatch:
+                    self._dTypes.pop(key, None)
+
+    def clear(self):
+        """
+        Removes all the entries of the cache.
+        """
+        with self._lock:
+            self._dTypes.clear()
+
+
 class AsyncRequestHandler:
     """
     MixIn that implements asynchronous request handling: associates a response to a request.
@@ -217,6 +295,7 @@ class AsyncRequestHandler:
         self._dRequestContexts = {}  # Stores requests by their context {requestContext: Request()}
         self._dPendingResponses = {}  # Stores available responses {requestContext: Response()}. See get_response()
         self._sSkipResponse = set()  # Stores the requestContext of Responses that shall not be stored in _dequeResponses.
+        self.typeCache = DataTypeCache()  # Types of the written nodes, see write_nodes()
 
     def _send_request(self, idx, request):
         """
@@ -264,6 +343,8 @@ class AsyncRequestHandler:
             response.timestampReceived = timestamp  # Passing the timestamp instead of acquiring it here reduces it by ~10µs
             request.response = response
             response.request = request
+            if request.typeCacheKeys is not None and isinstance(response, WriteResponse):
+                self.typeCache.invalidate_mismatches(request.typeCacheKeys, response.results)
             if responseContext not in self._sSkipResponse:
                 self.on_generic_response(request, response)
             else:
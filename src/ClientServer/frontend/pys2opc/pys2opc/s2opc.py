@@ -67,6 +67,10 @@ def _callback_disconnected(clientId):
 def _callback_datachanged(connectionId, dataId, c_value):
     return PyS2OPC_Client._callback_datachanged(connectionId, dataId, c_value)
 
+@ffi.def_extern()
+def _callback_datachanged_batch(connectionId, nbValues, dataIds, c_values):
+    return PyS2OPC_Client._callback_datachanged_batch(connectionId, nbValues, dataIds, c_values)
+
 @ffi.def_extern()
 def _callback_client_event(connectionId, event, status, responsePayload, responseContext):
     timestamp = time.time()
@@ -287,7 +291,8 @@ class PyS2OPC_Client(PyS2OPC):
                                  'timeout_ms': timeout_ms,
                                  'sc_lifetime': sc_lifetime,
                                  'token_target': token_target,
-                                 'generic_response_callback': libsub._callback_client_event}
+                                 'generic_response_callback': libsub._callback_client_event,
+                                 'data_change_batch_callback': libsub._callback_datachanged_batch}
         status = libsub.SOPC_LibSub_ConfigureConnection([dConnectionParameters], pCfgId)
         assert status == ReturnStatus.OK, 'Configuration failed with status {}.'.format(ReturnStatus.get_both_from_id(status))
 
@@ -389,7 +394,8 @@ class PyS2OPC_Client(PyS2OPC):
                                  'timeout_ms': timeout_ms,
                                  'sc_lifetime': sc_lifetime,
                                  'token_target': token_target,
-                                 'generic_response_callback': libsub._callback_client_event}
+                                 'generic_response_callback': libsub._callback_client_event,
+                                 'data_change_batch_callback': libsub._callback_datachanged_batch}
 
         if client_key_encrypted:
             status = libsub.SOPC_ClientConfigHelper_SetClientKeyPasswordCallback(libsub._callback_get_client_key_password)
@@ -471,6 +477,13 @@ class PyS2OPC_Client(PyS2OPC):
         connection = PyS2OPC_Client._dConnections[connectionId]
         connection._on_datachanged(dataId, value)
 
+    @staticmethod
+    def _callback_datachanged_batch(connectionId, nbValues, dataIds, c_values):
+        # The GIL is taken once for all the data changes of the notification
+        assert connectionId in PyS2OPC_Client._dConnections, 'Data change notification on unknown connection'
+        connection = PyS2OPC_Client._dConnections[connectionId]
+        connection._on_datachanged_batch(nbValues, dataIds, c_values)
+
     @staticmethod
     def _callback_client_event(connectionId, event, status, responsePayload, responseContext, timestamp):
         assert connectionId in PyS2OPC_Client._dConnections, 'Event notification on unknown connection'
@@ -898,18 +911,21 @@ class PyS2OPC_Server(PyS2OPC):
         return PyS2OPC_Server._send_request(request, bWaitResponse, epIdx)
 
     @staticmethod
-    def write_nodes(nodeIds, datavalues, attributes=None, types=None, bWaitResponse=True, bAutoTypeWithRead=True, epIdx=None):
+    def write_nodes(nodeIds, datavalues, attributes=None, types=None, bWaitResponse=True, bAutoTypeWithRead=True,
+                    bUseTypeCache=True, epIdx=None):
         """
         Forges an `OpcUa_WriteRequest` and sends it as a local request.
         `epIdx` is the local endpoint index to send this request to.
         If `None`, this function chooses an endpoint.
+        The type cache is shared by all the local endpoints.
 
         See `pys2opc.connection.BaseClientConnectionHandler.write_nodes` for more details.
         """
         # Where there are unknown types, makes a read request first
         if bAutoTypeWithRead:
             sendFct = lambda request,**kwargs: PyS2OPC_Server._send_request(request, epIdx=epIdx, **kwargs)
-            types = Request.helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct)
+            typeCache = PyS2OPC_Server._req_hdler.typeCache if bUseTypeCache else None
+            types = Request.helper_maybe_read_types(nodeIds, datavalues, attributes, types, sendFct, typeCache=typeCache)
 
         # Make the actual write request
         request = Request.new_write_request(nodeIds, datavalues, attributes=attributes, types=types)
@@ -23,6 +23,8 @@ from functools import total_ordering
 import uuid
 from binascii import hexlify, unhexlify
 import time
+import array
+import sys
 
 from _pys2opc import ffi, lib as libsub
 
@@ -428,6 +430,106 @@ def float_to_datetime(t, no_gc=True):
     # (datetime.date(1970,1,1) - datetime.date(1601,1,1)).total_seconds() * 1000 * 1000 * 10
     datetime[0] = int(t*1e7) + 116444736000000000
     return datetime
+
+
+def _array_typecode(kind, size):
+    """Returns the `array.array` typecode of the given kind ('i', 'u' or 'f') and size in bytes."""
+    for code in {'i': 'bhilq', 'u': 'BHILQ', 'f': 'fd'}[kind]:
+        if array.array(code).itemsize == size:
+            return code
+    raise ValueError('No array typecode for kind {} of size {}'.format(kind, size))
+
+
+# Numeric built-in types which arrays are converted with a single copy of their buffer:
+#  built-in type -> (field of SOPC_VariantArrayValue, C type, array.array typecode)
+_NUMERIC_ARRAYS = {libsub.SOPC_Boolean_Id: ('BooleanArr', 'SOPC_Boolean', _array_typecode('u', 1)),
+                   libsub.SOPC_SByte_Id: ('SbyteArr', 'SOPC_SByte', _array_typecode('i', 1)),
+                   libsub.SOPC_Byte_Id: ('ByteArr', 'SOPC_Byte', _array_typecode('u', 1)),
+                   libsub.SOPC_Int16_Id: ('Int16Arr', 'int16_t', _array_typecode('i', 2)),
+                   libsub.SOPC_UInt16_Id: ('Uint16Arr', 'uint16_t', _array_typecode('u', 2)),
+                   libsub.SOPC_Int32_Id: ('Int32Arr', 'int32_t', _array_typecode('i', 4)),
+                   libsub.SOPC_UInt32_Id: ('Uint32Arr', 'uint32_t', _array_typecode('u', 4)),
+                   libsub.SOPC_Int64_Id: ('Int64Arr', 'int64_t', _array_typecode('i', 8)),
+                   libsub.SOPC_UInt64_Id: ('Uint64Arr', 'uint64_t', _array_typecode('u', 8)),
+                   libsub.SOPC_Float_Id: ('FloatvArr', 'float', _array_typecode('f', 4)),
+                   libsub.SOPC_Double_Id: ('DoublevArr', 'double', _array_typecode('f', 8)),
+                   libsub.SOPC_StatusCode_Id: ('StatusArr', 'SOPC_StatusCode', _array_typecode('u', 4)),
+                  }
+
+
+def _format_kind(fmt):
+    """Returns the kind ('i', 'u' or 'f') of a native struct format (as in `memoryview.format`), None if not native numeric."""
+    if fmt[:1] in ('<', '>'):
+        if (fmt[0] == '<') != (sys.byteorder == 'little'):
+            return None
+        fmt = fmt[1:]
+    elif fmt[:1] in ('@', '='):
+        fmt = fmt[1:]
+    if len(fmt) != 1:
+        return None
+    if fmt in 'bhilqn':
+        return 'i'
+    if fmt in 'BHILQN?':
+        return 'u'
+    if fmt in 'fd':
+        return 'f'
+    return None
+
+
+def _is_numeric_buffer(value):
+    """Returns True if the value is an `array.array`, a `memoryview` or a `numpy.ndarray`."""
+    return isinstance(value, (array.array, memoryview)) or\
+           (type(value).__name__ == 'ndarray' and type(value).__module__ == 'numpy')
+
+
+def numeric_array_to_python(sopc_type, content, length, numeric_array_type=list):
+    """
+    Converts the C array of a numeric SOPC_Variant array to Python with a single copy of the C buffer.
+
+    Args:
+        sopc_type: The built-in type of the array (see `pys2opc.types.VariantType`).
+        content: The SOPC_VariantArrayValue of the SOPC_Variant.
+        length: The number of elements in the array.
+        numeric_array_type: The Python type of the result: `list`, `array.array` or `numpy.ndarray`.
+    """
+    field, ctype, typecode = _NUMERIC_ARRAYS[sopc_type]
+    values = array.array(typecode)
+    if length > 0:
+        data = ffi.buffer(getattr(content, field), length * ffi.sizeof(ctype))
+        if numeric_array_type.__name__ == 'ndarray' and numeric_array_type.__module__ == 'numpy':
+            import numpy
+            return numpy.frombuffer(data, dtype=typecode).copy()
+        values.frombytes(data)
+    elif numeric_array_type.__name__ == 'ndarray' and numeric_array_type.__module__ == 'numpy':
+        import numpy
+        return numpy.empty(0, dtype=typecode)
+    if numeric_array_type is array.array:
+        return values
+    return values.tolist()
+
+
+def python_to_numeric_array(value, sopc_type):
+    """
+    Returns a new C array (not garbage collected) of the given numeric built-in type with the values of the sequence.
+    A buffer value (`array.array`, `memoryview` or `numpy.ndarray`) with the C type of the array is copied at once,
+    other buffer values are converted first.
+    """
+    field, ctype, typecode = _NUMERIC_ARRAYS[sopc_type]
+    if not _is_numeric_buffer(value):
+        return allocator_no_gc(ctype + '[]', value)
+    view = memoryview(value)
+    if view.ndim != 1:
+        raise ValueError('Multi dimensional arrays are not supported.')
+    if not view.c_contiguous or _format_kind(view.format) != _format_kind(typecode) or\
+       view.itemsize != ffi.sizeof(ctype):
+        # Values shall be converted to the C type
+        view = memoryview(array.array(typecode, view.tolist()))
+    c_array = allocator_no_gc(ctype + '[]', len(view))
+    if len(view) > 0:
+        ffi.memmove(c_array, view, view.nbytes)
+    return c_array
+
+
 def ntp_to_python(i):
     """uint64_t NTP to Python time."""
     # Epoch is 01/01/1900 here.
@@ -465,9 +567,18 @@ class Variant:
     (you cannot have a DataValue encapsulated in a Variant, but `DataValue` are available).
     It fails for both parsing received OPC UA Variants and encoding `Variant`s to be sent.
 
+    The arrays of numeric types (integers, floats, booleans and status codes) are converted with a single copy
+    of their buffer. Their Python value may be a `list`, an `array.array`, a `memoryview` or a `numpy.ndarray`
+    (one dimension) when it is converted to a SOPC_Variant.
+    The type of the Python value of the numeric arrays converted from a SOPC_Variant is `Variant.numeric_array_type`.
+
     Attributes:
         variantType: Optional: The type of the `Variant` (see `pys2opc.types.VariantType`) when the value is produced from a SOPC_Variant*.
+        numeric_array_type: Class attribute: the type of the Python value of the numeric arrays converted from a SOPC_Variant:
+                            `list` (default), `array.array` or `numpy.ndarray`.
     """
+    numeric_array_type = list
+
     def __init__(self, python_value, variantType=None):
         self._value = python_value
         self.variantType = variantType
@@ -691,9 +802,12 @@ class Variant:
         return k in s._value
 
     @staticmethod
-    def from_sopc_variant(variant):
+    def from_sopc_variant(variant, numeric_array_type=None):
         """
         Returns a Variant initialized from a SOPC_Variant or a SOPC_Variant* (or a void*).
+
+        Args:
+            numeric_array_type: Optional: the type of the Python value of a numeric array (see `Variant.numeric_array_type`).
         """
         variant = ffi.cast('SOPC_Variant *', variant)
         sopc_type = variant.BuiltInTypeId
@@ -758,31 +872,12 @@ class Variant:
             sopc_array = variant.Value.Array
             length = sopc_array.Length
             content = sopc_array.Content
-            if sopc_type == libsub.SOPC_Null_Id:
+            if sopc_type in _NUMERIC_ARRAYS:
+                return Variant(numeric_array_to_python(sopc_type, content, length,
+                                                       numeric_array_type or Variant.numeric_array_type), sopc_type)
+            elif sopc_type == libsub.SOPC_Null_Id:
                 # S2OPC should not be able to be in this case
                 return Variant([], sopc_type)
-            elif sopc_type == libsub.SOPC_Boolean_Id:
-                return Variant([content.BooleanArr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_SByte_Id:
-                return Variant([content.SbyteArr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Byte_Id:
-                return Variant([content.ByteArr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Int16_Id:
-                return Variant([content.Int16Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_UInt16_Id:
-                return Variant([content.Uint16Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Int32_Id:
-                return Variant([content.Int32Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_UInt32_Id:
-                return Variant([content.Uint32Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Int64_Id:
-                return Variant([content.Int64Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_UInt64_Id:
-                return Variant([content.Uint64Arr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Float_Id:
-                return Variant([content.FloatvArr[i] for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_Double_Id:
-                return Variant([content.DoublevArr[i] for i in range(length)], sopc_type)
             elif sopc_type == libsub.SOPC_String_Id:
                 return Variant([string_to_str(ffi.addressof(content.StringArr[i])) for i in range(length)], sopc_type)
             elif sopc_type == libsub.SOPC_DateTime_Id:
@@ -797,8 +892,6 @@ class Variant:
                 return Variant([nodeid_to_str(ffi.addressof(content.NodeIdArr[i])) for i in range(length)], sopc_type)
             #elif sopc_type == libsub.SOPC_ExpandedNodeId_Id:
             #    return Variant([content. for i in range(length)], sopc_type)
-            elif sopc_type == libsub.SOPC_StatusCode_Id:
-                return Variant([content.StatusArr[i] for i in range(length)], sopc_type)
             elif sopc_type == libsub.SOPC_QualifiedName_Id:
                 Qname = content.QnameArr[i]
                 return Variant([(Qname.NamespaceIndex, string_to_str(Qname.Name.Data)) for i in range(length)], sopc_type)
@@ -821,6 +914,21 @@ class Variant:
 
     allocator = ffi.new_allocator(alloc=libsub.SOPC_Malloc, free=libsub.SOPC_Variant_Delete, should_clear_after_alloc=True)
 
+    def is_array(self, sopc_type=None):
+        """
+        Returns True if the Python value of this `Variant` is an array, False if it is a single value.
+
+        Args:
+            sopc_type: Optional: the type of the `Variant` (see `pys2opc.types.VariantType`), defaults to `self.variantType`.
+                       It is required to distinguish arrays of QualifiedName or LocalizedText from single values.
+        """
+        if sopc_type is None:
+            sopc_type = self.variantType
+        # Testing whether this is an array or not is not straightforward because of qualified names and localized text that are couples
+        if sopc_type in (libsub.SOPC_QualifiedName_Id, libsub.SOPC_LocalizedText_Id):
+            return len(self._value) > 0 and isinstance(self._value[0], (list, tuple))  # If self._value has no length -> malformed value
+        return isinstance(self._value, (list, tuple)) or _is_numeric_buffer(self._value)
+
     def to_sopc_variant(self, *, copy_type_from_variant=None, sopc_variant_type=None, no_gc=False):
         """
         Converts the current Variant to a SOPC_Variant*.
@@ -855,11 +963,7 @@ class Variant:
         else:
             variant = Variant.allocator('SOPC_Variant*')
         variant.BuiltInTypeId = sopc_type
-        # Testing whether this is an array or not is not straightforward because of qualified names and localized text that are couples
-        if sopc_type in (libsub.SOPC_QualifiedName_Id, libsub.SOPC_LocalizedText_Id):
-            is_array = len(self._value) > 0 and isinstance(self._value[0], (list, tuple))  # If self._value has no length -> malformed value
-        else:
-            is_array = isinstance(self._value, (list, tuple))
+        is_array = self.is_array(sopc_type)
         if not is_array:
             # Single values
             variant.ArrayType = libsub.SOPC_VariantArrayType_SingleValue
@@ -923,35 +1027,17 @@ class Variant:
             else:
                 raise ValueError('Python to SOPC_Variant conversion not supported for the given type {}.'.format(sopc_type))
         else:
-            # Arrays or Matrices values (but not Matrices)
-            assert not any(map(lambda n:isinstance(n, (list, tuple)), self._value)), 'Multi dimensional arrays are not supported.'
+            # Arrays or Matrices values (but not Matrices), numeric arrays are checked by python_to_numeric_array
+            assert sopc_type in _NUMERIC_ARRAYS or not any(map(lambda n:isinstance(n, (list, tuple)), self._value)),\
+                'Multi dimensional arrays are not supported.'
             variant.ArrayType = libsub.SOPC_VariantArrayType_Array
             variant.Value.Array.Length = len(self._value)
             content = variant.Value.Array.Content
-            if sopc_type == libsub.SOPC_Null_Id:
+            if sopc_type in _NUMERIC_ARRAYS:
+                field, _, _ = _NUMERIC_ARRAYS[sopc_type]
+                setattr(content, field, python_to_numeric_array(self._value, sopc_type))
+            elif sopc_type == libsub.SOPC_Null_Id:
                 pass
-            elif sopc_type == libsub.SOPC_Boolean_Id:
-                content.BooleanArr = allocator_no_gc('SOPC_Boolean[]', self._value)
-            elif sopc_type == libsub.SOPC_SByte_Id:
-                content.SbyteArr = allocator_no_gc('SOPC_SByte[]', self._value)
-            elif sopc_type == libsub.SOPC_Byte_Id:
-                content.ByteArr = allocator_no_gc('SOPC_Byte[]', self._value)
-            elif sopc_type == libsub.SOPC_Int16_Id:
-                content.Int16Arr = allocator_no_gc('int16_t[]', self._value)
-            elif sopc_type == libsub.SOPC_UInt16_Id:
-                content.Uint16Arr = allocator_no_gc('uint16_t[]', self._value)
-            elif sopc_type == libsub.SOPC_Int32_Id:
-                content.Int32Arr = allocator_no_gc('int32_t[]', self._value)
-            elif sopc_type == libsub.SOPC_UInt32_Id:
-                content.Uint32Arr = allocator_no_gc('uint32_t[]', self._value)
-            elif sopc_type == libsub.SOPC_Int64_Id:
-                content.Int64Arr = allocator_no_gc('int64_t[]', self._value)
-            elif sopc_type == libsub.SOPC_UInt64_Id:
-                content.Uint64Arr = allocator_no_gc('uint64_t[]', self._value)
-            elif sopc_type == libsub.SOPC_Float_Id:
-                content.FloatvArr = allocator_no_gc('float[]', self._value)
-            elif sopc_type == libsub.SOPC_Double_Id:
-                content.DoublevArr = allocator_no_gc('double[]', self._value)
             elif sopc_type == libsub.SOPC_String_Id:
                 content.StringArr = allocator_no_gc('SOPC_String[]', [str_to_string(s, no_gc=True)[0] for s in self._value])
             elif sopc_type == libsub.SOPC_DateTime_Id:
@@ -966,8 +1052,6 @@ class Variant:
                 content.NodeIdArr = allocator_no_gc('SOPC_NodeId[]', [str_to_nodeid(v, no_gc=True)[0] for v in self._value])
             #elif sopc_type == libsub.SOPC_ExpandedNodeId_Id:
             #    content.Arr = allocator_no_gc('[]', self._value)
-            elif sopc_type == libsub.SOPC_StatusCode_Id:
-                content.StatusArr = allocator_no_gc('SOPC_StatusCode[]', self._value)
             elif sopc_type == libsub.SOPC_QualifiedName_Id:
                 qnames = allocator_no_gc('SOPC_QualifiedName[]', len(self._value))
                 for i,v in enumerate(self._value):
@@ -33,6 +33,7 @@ ffibuilder.cdef(header + r'''
         void _callback_log(SOPC_Log_Level log_level, SOPC_LibSub_CstString text);
         void _callback_disconnected(SOPC_LibSub_ConnectionId c_id);
         void _callback_datachanged(SOPC_LibSub_ConnectionId c_id, SOPC_LibSub_DataId d_id, SOPC_LibSub_Value* value);
+        void _callback_datachanged_batch(SOPC_LibSub_ConnectionId c_id, uint32_t nb_values, const SOPC_LibSub_DataId* d_ids, const void* const* values);
         void _callback_client_event(SOPC_LibSub_ConnectionId c_id, SOPC_LibSub_ApplicativeEvent event, SOPC_StatusCode status, const void* response, uintptr_t responseContext);
         bool _callback_get_client_key_password(char** password);
         bool _callback_get_user_key_password(const char* certSha1, char** password);
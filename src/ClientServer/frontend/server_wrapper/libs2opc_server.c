@@ -715,6 +715,39 @@ SOPC_ReturnStatus SOPC_ServerHelper_LocalServiceSync(void* request, void** respo
     return status;
 }
 
+SOPC_ReturnStatus SOPC_ServerHelper_GetNodeHandle(const SOPC_NodeId* nodeId, SOPC_ServerHelper_NodeHandle** handle)
+{
+    if (NULL == nodeId || NULL == handle)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    SOPC_AddressSpace* addressSpace = sopc_server_helper_config.addressSpace;
+    if (NULL == addressSpace)
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+    bool found = false;
+    SOPC_AddressSpace_Node* node = SOPC_AddressSpace_Get_Node(addressSpace, nodeId, &found);
+    if (!found || OpcUa_NodeClass_Variable != *SOPC_AddressSpace_Get_NodeClass(addressSpace, node))
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    *handle = (SOPC_ServerHelper_NodeHandle*) node;
+    return SOPC_STATUS_OK;
+}
+
+SOPC_ReturnStatus SOPC_ServerHelper_UpdateValues(size_t nbValues,
+                                                 SOPC_ServerHelper_NodeHandle* const* handles,
+                                                 SOPC_DataValue* values)
+{
+    if (!SOPC_ServerInternal_IsStarted())
+    {
+        return SOPC_STATUS_INVALID_STATE;
+    }
+    // Handles are AddressSpace nodes
+    return SOPC_ToolkitServer_AsyncUpdateValues(nbValues, (SOPC_AddressSpace_Node* const*) handles, values);
+}
+
 SOPC_ReturnStatus SOPC_ServerHelper_LocalServiceAsync(void* request, uintptr_t userContext)
 {
     if (!SOPC_ServerInternal_IsStarted())
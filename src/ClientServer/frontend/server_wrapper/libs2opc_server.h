@@ -188,4 +188,55 @@ SOPC_ReturnStatus SOPC_ServerHelper_LocalServiceAsync(void* request, uintptr_t u
  */
 SOPC_ReturnStatus SOPC_ServerHelper_LocalServiceSync(void* request, void** response);
 
+/**
+ * \brief Opaque handle on a Variable node of the server AddressSpace,
+ *        valid as long as the AddressSpace configured for the server and the node exist.
+ */
+typedef struct SOPC_ServerHelper_NodeHandle SOPC_ServerHelper_NodeHandle;
+
+/**
+ * \brief Resolves the given Variable node of the server AddressSpace once to update its value with
+ *        ::SOPC_ServerHelper_UpdateValues.
+ *
+ * \note The AddressSpace shall have been configured (e.g.: ::SOPC_ServerConfigHelper_SetAddressSpace).
+ *
+ * \warning The handle is invalid if the node is deleted. No AddNodes service shall be treated concurrently to
+ *          this call since it might modify the AddressSpace.
+ *
+ * \param nodeId       The NodeId of a Variable node of the server AddressSpace
+ * \param[out] handle  Pointer into which the handle of the node is provided
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_STATE if the AddressSpace is not configured and
+ *         SOPC_STATUS_INVALID_PARAMETERS if a parameter is NULL or the node is not a Variable of the AddressSpace.
+ */
+SOPC_ReturnStatus SOPC_ServerHelper_GetNodeHandle(const SOPC_NodeId* nodeId, SOPC_ServerHelper_NodeHandle** handle);
+
+/**
+ * \brief Updates the Value attribute of Variable nodes locally on server asynchronously.
+ *        The values are applied in the given order as a batch and the monitored items are notified
+ *        as for a local write service request, without the request and response processing.
+ *
+ * \note ::SOPC_ServerHelper_StartServer or ::SOPC_ServerHelper_Serve shall have been called
+ *       and the server shall still running
+ *
+ * \note Concurrent calls are supported, the batches are applied in the order they are submitted.
+ *       No access restriction nor type check is done: the values shall comply with the Variable nodes DataType and
+ *       ValueRank.
+ *
+ * \param nbValues  Number of handles and values in the batch
+ * \param handles   Handles of the Variable nodes to update, provided by ::SOPC_ServerHelper_GetNodeHandle
+ * \param values    The new values of the nodes. Only Value, Status, SourceTimestamp and SourcePicoSeconds are
+ *                  considered. When SourceTimestamp and SourcePicoSeconds are both 0, the current time is used.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_STATE if the server is not running,
+ *         SOPC_STATUS_INVALID_PARAMETERS if a parameter is invalid and SOPC_STATUS_OUT_OF_MEMORY
+ *         in case of allocation failure.
+ *
+ * \note The values content is moved to the server after a successful return: \p values are reset
+ *       and their content shall not be cleared by caller.
+ */
+SOPC_ReturnStatus SOPC_ServerHelper_UpdateValues(size_t nbValues,
+                                                 SOPC_ServerHelper_NodeHandle* const* handles,
+                                                 SOPC_DataValue* values);
+
 #endif
@@ -675,7 +675,7 @@ SOPC_ReturnStatus SOPC_ServerConfigHelper_SetCurrentTimeRefreshInterval(uint16_t
     {
         return SOPC_STATUS_INVALID_STATE;
     }
-    if (0 == intervalMs || intervalMs >= 2 * SOPC_TIMER_RESOLUTION_MS)
+    if (0 == intervalMs || intervalMs >= SOPC_TIMER_MIN_PERIOD_MS)
     {
         sopc_server_helper_config.configuredCurrentTimeRefreshIntervalMs = intervalMs;
     }
@@ -286,7 +286,7 @@ SOPC_ReturnStatus SOPC_ServerConfigHelper_SetShutdownCountdown(uint16_t secondsT
  *                    It might be set to 0 to deactivate the Server.ServerStatus.CurrentTime value update.
  *
  * \return SOPC_STATUS_OK in case of success, SOPC_INVALID_PARAMETER in case the value is
- *         less than minimum interval defined by 2 times ::SOPC_TIMER_RESOLUTION_MS.
+ *         less than minimum interval defined by ::SOPC_TIMER_MIN_PERIOD_MS.
  *         Otherwise SOPC_STATUS_INVALID_STATE if the configuration is not possible
  *         (toolkit not initialized, server already started).
  *
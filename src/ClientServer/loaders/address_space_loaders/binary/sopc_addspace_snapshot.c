@@ -0,0 +1,452 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "sopc_addspace_snapshot.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sopc_assert.h"
+#include "sopc_common_constants.h"
+#include "sopc_encodeabletype.h"
+#include "sopc_encoder.h"
+#include "sopc_logger.h"
+#include "sopc_macros.h"
+#include "sopc_mem_alloc.h"
+#include "sopc_time.h"
+
+static const char SNAPSHOT_MAGIC[8] = {'S', '2', 'O', 'P', 'C', 'A', 'S', 'B'};
+
+/* Minimum size of an encoded node: NodeClass + NodeId (TwoBytes encoding) */
+#define SNAPSHOT_MIN_ENCODED_NODE_SIZE 6
+
+/* Increment step used for the snapshot encoding buffers */
+#define SNAPSHOT_BUFFER_STEP 65536
+
+typedef struct
+{
+    SOPC_AddressSpace* space;
+    SOPC_Buffer* buf;
+    FILE* fd; // Nodes are flushed in file node by node when defined
+    SOPC_ReturnStatus status;
+    uint32_t nb_nodes;
+    uint32_t nb_variables;
+} snapshot_encode_ctx;
+
+/* Value status and source timestamp of a Variable node, restored once the AddressSpace is created */
+typedef struct
+{
+    SOPC_StatusCode status;
+    SOPC_Value_Timestamp sourceTs;
+} snapshot_value_metadata;
+
+static SOPC_EncodeableType* get_node_encodeable_type(OpcUa_NodeClass node_class)
+{
+    switch (node_class)
+    {
+    case OpcUa_NodeClass_Object:
+        return &OpcUa_ObjectNode_EncodeableType;
+    case OpcUa_NodeClass_Variable:
+        return &OpcUa_VariableNode_EncodeableType;
+    case OpcUa_NodeClass_Method:
+        return &OpcUa_MethodNode_EncodeableType;
+    case OpcUa_NodeClass_ObjectType:
+        return &OpcUa_ObjectTypeNode_EncodeableType;
+    case OpcUa_NodeClass_VariableType:
+        return &OpcUa_VariableTypeNode_EncodeableType;
+    case OpcUa_NodeClass_ReferenceType:
+        return &OpcUa_ReferenceTypeNode_EncodeableType;
+    case OpcUa_NodeClass_DataType:
+        return &OpcUa_DataTypeNode_EncodeableType;
+    case OpcUa_NodeClass_View:
+        return &OpcUa_ViewNode_EncodeableType;
+    default:
+        return NULL;
+    }
+}
+
+static void count_node(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_UNUSED_ARG(key);
+    snapshot_encode_ctx* ctx = (snapshot_encode_ctx*) user_data;
+    const SOPC_AddressSpace_Node* node = (const SOPC_AddressSpace_Node*) value;
+
+    ctx->nb_nodes++;
+    if (OpcUa_NodeClass_Variable == node->node_class)
+    {
+        ctx->nb_variables++;
+    }
+}
+
+static SOPC_ReturnStatus encode_header(snapshot_encode_ctx* ctx)
+{
+    uint32_t version = SOPC_ADDSPACE_SNAPSHOT_VERSION;
+    SOPC_ReturnStatus status = SOPC_Buffer_Write(ctx->buf, (const uint8_t*) SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&version, ctx->buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&ctx->nb_nodes, ctx->buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&ctx->nb_variables, ctx->buf, 0);
+    }
+    return status;
+}
+
+static SOPC_ReturnStatus flush_buffer(snapshot_encode_ctx* ctx)
+{
+    if (NULL == ctx->fd)
+    {
+        return SOPC_STATUS_OK;
+    }
+
+    const size_t length = ctx->buf->length;
+    size_t written = fwrite(ctx->buf->data, 1, length, ctx->fd);
+    SOPC_Buffer_Reset(ctx->buf);
+    return written == length ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+}
+
+static SOPC_ReturnStatus encode_value_metadata(snapshot_encode_ctx* ctx, SOPC_AddressSpace_Node* node)
+{
+    SOPC_StatusCode valueStatus = SOPC_AddressSpace_Get_StatusCode(ctx->space, node);
+    SOPC_Value_Timestamp sourceTs = SOPC_AddressSpace_Get_SourceTs(ctx->space, node);
+    SOPC_ReturnStatus status = SOPC_StatusCode_Write(&valueStatus, ctx->buf, 0);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_DateTime_Write(&sourceTs.timestamp, ctx->buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt16_Write(&sourceTs.picoSeconds, ctx->buf, 0);
+    }
+    return status;
+}
+
+static void encode_node(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_UNUSED_ARG(key);
+    snapshot_encode_ctx* ctx = (snapshot_encode_ctx*) user_data;
+    if (SOPC_STATUS_OK != ctx->status)
+    {
+        return;
+    }
+
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+
+    SOPC_EncodeableType* type = get_node_encodeable_type(node->node_class);
+    int32_t nodeClass = (int32_t) node->node_class;
+    SOPC_ReturnStatus status = (NULL != type ? SOPC_Int32_Write(&nodeClass, ctx->buf, 0) : SOPC_STATUS_NOK);
+
+    if (SOPC_STATUS_OK == status && OpcUa_NodeClass_Variable == node->node_class)
+    {
+        // Value might be stored outside of the node (read only nodes): encode a shallow copy with actual value
+        OpcUa_VariableNode variable = node->data.variable;
+        variable.Value = *SOPC_AddressSpace_Get_Value(ctx->space, node);
+        status = SOPC_EncodeableObject_Encode(type, &variable, ctx->buf, 0);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = encode_value_metadata(ctx, node);
+        }
+    }
+    else if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_EncodeableObject_Encode(type, &node->data, ctx->buf, 0);
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        status = flush_buffer(ctx);
+    }
+    else
+    {
+        char* nodeIdStr = SOPC_NodeId_ToCString(SOPC_AddressSpace_Get_NodeId(ctx->space, node));
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "AddressSpace snapshot: failed to encode node %s with status %d", nodeIdStr, status);
+        SOPC_Free(nodeIdStr);
+    }
+    ctx->status = status;
+}
+
+static SOPC_ReturnStatus encode_snapshot(snapshot_encode_ctx* ctx)
+{
+    SOPC_AddressSpace_ForEach(ctx->space, count_node, (uintptr_t) ctx);
+    ctx->status = encode_header(ctx);
+    if (SOPC_STATUS_OK == ctx->status)
+    {
+        ctx->status = flush_buffer(ctx);
+    }
+    if (SOPC_STATUS_OK == ctx->status)
+    {
+        SOPC_AddressSpace_ForEach(ctx->space, encode_node, (uintptr_t) ctx);
+    }
+    return ctx->status;
+}
+
+SOPC_ReturnStatus SOPC_AddressSpaceSnapshot_Encode(SOPC_AddressSpace* space, SOPC_Buffer* buf)
+{
+    if (NULL == space || NULL == buf)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    snapshot_encode_ctx ctx = {space, buf, NULL, SOPC_STATUS_OK, 0, 0};
+    return encode_snapshot(&ctx);
+}
+
+#if SOPC_HAS_FILESYSTEM
+SOPC_ReturnStatus SOPC_AddressSpaceSnapshot_WriteFile(SOPC_AddressSpace* space, const char* path)
+{
+    if (NULL == space || NULL == path)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    FILE* fd = fopen(path, "wb");
+    if (NULL == fd)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER, "AddressSpace snapshot: cannot open file %s", path);
+        return SOPC_STATUS_NOK;
+    }
+
+    // Buffer only contains 1 node at a time before being flushed in file
+    snapshot_encode_ctx ctx = {space, SOPC_Buffer_CreateResizable(SNAPSHOT_BUFFER_STEP, UINT32_MAX), fd,
+                               SOPC_STATUS_OK, 0, 0};
+    SOPC_ReturnStatus status = SOPC_STATUS_OUT_OF_MEMORY;
+    if (NULL != ctx.buf)
+    {
+        status = encode_snapshot(&ctx);
+    }
+    SOPC_Buffer_Delete(ctx.buf);
+
+    if (0 != fclose(fd) && SOPC_STATUS_OK == status)
+    {
+        status = SOPC_STATUS_NOK;
+    }
+    return status;
+}
+#else
+SOPC_ReturnStatus SOPC_AddressSpaceSnapshot_WriteFile(SOPC_AddressSpace* space, const char* path)
+{
+    SOPC_UNUSED_ARG(space);
+    SOPC_UNUSED_ARG(path);
+    return SOPC_STATUS_NOT_SUPPORTED;
+}
+#endif // SOPC_HAS_FILESYSTEM
+
+static SOPC_ReturnStatus decode_header(SOPC_Buffer* buf, uint32_t* nb_nodes, uint32_t* nb_variables)
+{
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint32_t version = 0;
+
+    SOPC_ReturnStatus status = SOPC_Buffer_Read((uint8_t*) magic, buf, sizeof(magic));
+    if (SOPC_STATUS_OK == status && 0 != memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)))
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER, "AddressSpace snapshot: invalid magic number");
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Read(&version, buf, 0);
+    }
+    if (SOPC_STATUS_OK == status && SOPC_ADDSPACE_SNAPSHOT_VERSION != version)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "AddressSpace snapshot: unsupported format version %" PRIu32 " (expected %d)", version,
+                               SOPC_ADDSPACE_SNAPSHOT_VERSION);
+        status = SOPC_STATUS_NOT_SUPPORTED;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Read(nb_nodes, buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Read(nb_variables, buf, 0);
+    }
+    // Check counts are consistent with the data available before allocating nodes
+    if (SOPC_STATUS_OK == status &&
+        (*nb_variables > *nb_nodes || SOPC_Buffer_Remaining(buf) / SNAPSHOT_MIN_ENCODED_NODE_SIZE < *nb_nodes))
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER, "AddressSpace snapshot: inconsistent nodes count");
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+    return status;
+}
+
+static SOPC_ReturnStatus decode_value_metadata(SOPC_Buffer* buf, snapshot_value_metadata* metadata)
+{
+    SOPC_ReturnStatus status = SOPC_StatusCode_Read(&metadata->status, buf, 0);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_DateTime_Read(&metadata->sourceTs.timestamp, buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt16_Read(&metadata->sourceTs.picoSeconds, buf, 0);
+    }
+    return status;
+}
+
+static SOPC_ReturnStatus decode_node(SOPC_Buffer* buf, SOPC_AddressSpace_Node* node)
+{
+    int32_t nodeClass = 0;
+    SOPC_ReturnStatus status = SOPC_Int32_Read(&nodeClass, buf, 0);
+    SOPC_EncodeableType* type = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        type = get_node_encodeable_type((OpcUa_NodeClass) nodeClass);
+        status = (NULL != type ? SOPC_STATUS_OK : SOPC_STATUS_ENCODING_ERROR);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_EncodeableObject_Decode(type, &node->data, buf, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        node->node_class = (OpcUa_NodeClass) nodeClass;
+    }
+    return status;
+}
+
+SOPC_AddressSpace* SOPC_AddressSpaceSnapshot_Decode(SOPC_Buffer* buf)
+{
+    if (NULL == buf)
+    {
+        return NULL;
+    }
+
+    uint32_t nb_nodes = 0;
+    uint32_t nb_variables = 0;
+    SOPC_AddressSpace_Node* nodes = NULL;
+    SOPC_Variant* variables = NULL;
+    snapshot_value_metadata* metadata = NULL;
+    uint32_t nb_decoded = 0;
+    uint32_t nb_moved_values = 0;
+
+    SOPC_ReturnStatus status = decode_header(buf, &nb_nodes, &nb_variables);
+    if (SOPC_STATUS_OK == status)
+    {
+        // Note: allocate at least 1 element to distinguish allocation failure from empty snapshot
+        nodes = SOPC_Calloc(nb_nodes > 0 ? nb_nodes : 1, sizeof(*nodes));
+        variables = SOPC_Calloc(nb_variables > 0 ? nb_variables : 1, sizeof(*variables));
+        metadata = SOPC_Calloc(nb_variables > 0 ? nb_variables : 1, sizeof(*metadata));
+        status = (NULL != nodes && NULL != variables && NULL != metadata ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    }
+
+    for (; SOPC_STATUS_OK == status && nb_decoded < nb_nodes; nb_decoded++)
+    {
+        SOPC_AddressSpace_Node* node = &nodes[nb_decoded];
+        status = decode_node(buf, node);
+        if (SOPC_STATUS_OK == status && OpcUa_NodeClass_Variable == node->node_class)
+        {
+            if (nb_moved_values < nb_variables)
+            {
+                status = decode_value_metadata(buf, &metadata[nb_moved_values]);
+                // Only the variables values are kept outside of the read only nodes
+                SOPC_Variant_Move(&variables[nb_moved_values], &node->data.variable.Value);
+                SOPC_Variant_Initialize(&node->data.variable.Value);
+                node->data.variable.Value.BuiltInTypeId = SOPC_UInt32_Id;
+                node->data.variable.Value.ArrayType = SOPC_VariantArrayType_SingleValue;
+                node->data.variable.Value.Value.Uint32 = nb_moved_values;
+                nb_moved_values++;
+            }
+            else
+            {
+                status = SOPC_STATUS_ENCODING_ERROR;
+            }
+        }
+    }
+
+    if (SOPC_STATUS_OK == status && (nb_moved_values != nb_variables || SOPC_Buffer_Remaining(buf) != 0))
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER, "AddressSpace snapshot: unexpected content length");
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+
+    SOPC_AddressSpace* space = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        space = SOPC_AddressSpace_CreateOwnedReadOnlyNodes(nb_nodes, nodes, nb_variables, variables);
+        status = (NULL != space ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    }
+
+    for (uint32_t i = 0; SOPC_STATUS_OK == status && i < nb_nodes; i++)
+    {
+        SOPC_AddressSpace_Node* node = &nodes[i];
+        if (OpcUa_NodeClass_Variable == node->node_class)
+        {
+            const snapshot_value_metadata* nodeMetadata = &metadata[node->data.variable.Value.Value.Uint32];
+            SOPC_Value_Timestamp sourceTs = nodeMetadata->sourceTs;
+            // Set an initial timestamp as SOPC_AddressSpace_Append does to return non null timestamps
+            if (0 == sourceTs.timestamp && 0 == sourceTs.picoSeconds)
+            {
+                sourceTs.timestamp = SOPC_Time_GetCurrentTimeUTC();
+            }
+            bool res = SOPC_AddressSpace_Set_StatusCode(space, node, nodeMetadata->status);
+            res = res && SOPC_AddressSpace_Set_SourceTs(space, node, sourceTs);
+            SOPC_ASSERT(res);
+        }
+    }
+    SOPC_Free(metadata);
+
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "AddressSpace snapshot: decoding failed on node %" PRIu32 " with status %d", nb_decoded,
+                               status);
+        // Node class is only set on successfully decoded nodes which are the only ones to clear
+        for (uint32_t i = 0; NULL != nodes && i < nb_nodes; i++)
+        {
+            if (OpcUa_NodeClass_Unspecified != nodes[i].node_class)
+            {
+                SOPC_EncodeableObject_Clear(get_node_encodeable_type(nodes[i].node_class), &nodes[i].data);
+            }
+        }
+        for (uint32_t i = 0; i < nb_moved_values; i++)
+        {
+            SOPC_Variant_Clear(&variables[i]);
+        }
+        SOPC_Free(nodes);
+        SOPC_Free(variables);
+    }
+
+    return space;
+}
+
+SOPC_AddressSpace* SOPC_AddressSpaceSnapshot_LoadFile(const char* path)
+{
+    SOPC_Buffer* buf = NULL;
+    SOPC_ReturnStatus status = SOPC_Buffer_ReadFile(path, &buf);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER, "AddressSpace snapshot: cannot read file %s", path);
+        return NULL;
+    }
+
+    SOPC_AddressSpace* space = SOPC_AddressSpaceSnapshot_Decode(buf);
+    SOPC_Buffer_Delete(buf);
+    return space;
+}
@@ -0,0 +1,96 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * \file
+ *
+ * \brief AddressSpace binary snapshot: a compact and versioned binary representation of an AddressSpace.
+ *
+ * A snapshot is produced once from an AddressSpace built by another loader (e.g. ::SOPC_UANodeSet_Parse)
+ * and then loaded at server startup without any XML parsing, alias resolution or per node allocation
+ * of the nodes themselves: all nodes are decoded in a single contiguous array.
+ *
+ * Format (all values encoded with OPC UA binary encoding, i.e. little endian):
+ * - Header:  magic "S2OPCASB" (8 bytes), format version (UInt32), number of nodes (UInt32),
+ *            number of Variable nodes (UInt32)
+ * - Nodes:   for each node, its NodeClass (Int32) followed by the binary encoding of
+ *            the corresponding OpcUa_<NodeClass>Node structure.
+ *            Variable nodes are then followed by their Value status (StatusCode), source timestamp (DateTime)
+ *            and source picoseconds (UInt16).
+ *
+ * The loaded AddressSpace is a read only nodes AddressSpace (see ::SOPC_AddressSpace_CreateOwnedReadOnlyNodes):
+ * only the Variable nodes values are modifiable.
+ *
+ * \note The snapshot decoding is subject to the encoding constants (maximum string and array lengths)
+ *       configured for the S2OPC common library.
+ */
+
+#ifndef SOPC_ADDSPACE_SNAPSHOT_H_
+#define SOPC_ADDSPACE_SNAPSHOT_H_
+
+#include "sopc_address_space.h"
+#include "sopc_buffer.h"
+
+/** \brief Current version of the AddressSpace snapshot binary format */
+#define SOPC_ADDSPACE_SNAPSHOT_VERSION 2
+
+/**
+ * \brief Encodes the given AddressSpace as a snapshot in the given buffer
+ *
+ * \param space  the AddressSpace to encode, it might be read only nodes AddressSpace
+ * \param buf    the buffer in which snapshot is written from its current position,
+ *               it shall be resizable to contain the complete snapshot.
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_INVALID_PARAMETERS in case of invalid parameters
+ *         and SOPC_STATUS_NOK or encoding error status otherwise.
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceSnapshot_Encode(SOPC_AddressSpace* space, SOPC_Buffer* buf);
+
+/**
+ * \brief Decodes an AddressSpace snapshot from the given buffer
+ *
+ * \param buf  the buffer containing the snapshot from its current position.
+ *             The buffer is not referenced by the returned AddressSpace and might be deleted after call.
+ *
+ * \return the decoded read only nodes AddressSpace or NULL in case of failure (invalid header,
+ *         unsupported version, decoding failure or trailing data)
+ */
+SOPC_AddressSpace* SOPC_AddressSpaceSnapshot_Decode(SOPC_Buffer* buf);
+
+/**
+ * \brief Writes the snapshot of the given AddressSpace in the file \p path
+ *
+ * \param space  the AddressSpace to write as a snapshot
+ * \param path   the path of the file to create or overwrite
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_NOT_SUPPORTED if file system is not available
+ *         and an error status otherwise.
+ */
+SOPC_ReturnStatus SOPC_AddressSpaceSnapshot_WriteFile(SOPC_AddressSpace* space, const char* path);
+
+/**
+ * \brief Loads the AddressSpace snapshot contained in the file \p path
+ *
+ * \param path  the path of the snapshot file to load
+ *
+ * \return the loaded read only nodes AddressSpace or NULL in case of failure
+ */
+SOPC_AddressSpace* SOPC_AddressSpaceSnapshot_LoadFile(const char* path);
+
+#endif /* SOPC_ADDSPACE_SNAPSHOT_H_ */
@@ -30,6 +30,7 @@
 #include "sopc_address_space_utils_internal.h"
 #include "sopc_array.h"
 #include "sopc_assert.h"
+#include "sopc_buffer.h"
 #include "sopc_dict.h"
 #include "sopc_encodeable.h"
 #include "sopc_encoder.h"
@@ -39,7 +40,9 @@
 #include "sopc_helper_string.h"
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
+#include "sopc_mutexes.h"
 #include "sopc_singly_linked_list.h"
+#include "sopc_threads.h"
 #include "sopc_time.h"
 
 typedef enum
@@ -83,6 +86,9 @@ typedef struct parse_complex_value_context_t
     const char* value_tag;
     parse_complex_value_tag_array_t tags;          // C-array of tags
     SOPC_SLinkedList* end_element_restore_context; // restore the C-array of tags on end_element
+    // The C-arrays of tags are static: when set, the mutex is locked while a complex value is parsed
+    SOPC_Mutex* tags_mutex;
+    bool tags_locked;
 } parse_complex_value_context_t;
 
 struct parse_context_t
@@ -113,6 +119,10 @@ struct parse_context_t
 
     // Current node parsing
     SOPC_AddressSpace_Node node;
+
+    // When set, the parsed nodes (SOPC_AddressSpace_Node*) are collected in this array
+    // instead of being appended to the space
+    SOPC_Array* parsed_nodes;
 };
 
 #define NS_SEPARATOR "|"
@@ -122,6 +132,20 @@ struct parse_context_t
 #define UA_EXTENSION_OBJECT_VALUE UA_TYPES_NS NS_SEPARATOR "ExtensionObject"
 #define UA_LIST_EXTENSION_OBJECT_VALUE UA_TYPES_NS NS_SEPARATOR "ListOfExtensionObject"
 
+static void log_parse_error(XML_Parser parser)
+{
+    const enum XML_Error parser_error = XML_GetErrorCode(parser);
+
+    if (parser_error != XML_ERROR_NONE)
+    {
+        fprintf(stderr, "XML parsing failed at line %lu, column %lu. Error code is %d.\n",
+                XML_GetCurrentLineNumber(parser), XML_GetCurrentColumnNumber(parser), (int) XML_GetErrorCode(parser));
+    }
+
+    // else, the error comes from one of the callbacks, that log an error
+    // themselves.
+}
+
 static SOPC_ReturnStatus parse(XML_Parser parser, FILE* fd)
 {
     char buf[65365];
@@ -138,18 +162,7 @@ static SOPC_ReturnStatus parse(XML_Parser parser, FILE* fd)
 
         if (XML_Parse(parser, buf, (int) r, 0) != XML_STATUS_OK)
         {
-            const enum XML_Error parser_error = XML_GetErrorCode(parser);
-
-            if (parser_error != XML_ERROR_NONE)
-            {
-                fprintf(stderr, "XML parsing failed at line %lu, column %lu. Error code is %d.\n",
-                        XML_GetCurrentLineNumber(parser), XML_GetCurrentColumnNumber(parser),
-                        (int) XML_GetErrorCode(parser));
-            }
-
-            // else, the error comes from one of the callbacks, that log an error
-            // themselves.
-
+            log_parse_error(parser);
             return SOPC_STATUS_NOK;
         }
     }
@@ -163,6 +176,28 @@ static SOPC_ReturnStatus parse(XML_Parser parser, FILE* fd)
     return SOPC_STATUS_OK;
 }
 
+static SOPC_ReturnStatus parse_bytes(XML_Parser parser, const char* data, size_t len, bool is_final)
+{
+    static const size_t max_parse_len = 65365;
+
+    do
+    {
+        size_t r = (len > max_parse_len) ? max_parse_len : len;
+        int final = (is_final && r == len) ? 1 : 0;
+
+        if (XML_Parse(parser, data, (int) r, final) != XML_STATUS_OK)
+        {
+            log_parse_error(parser);
+            return SOPC_STATUS_NOK;
+        }
+
+        data += r;
+        len -= r;
+    } while (len > 0);
+
+    return SOPC_STATUS_OK;
+}
+
 static bool start_alias(struct parse_context_t* ctx, const XML_Char** attrs)
 {
     SOPC_ASSERT(ctx->current_alias_alias == NULL);
@@ -506,6 +541,16 @@ static bool parseArrayDimensions(struct parse_context_t* ctx,
     return res;
 }
 
+// Clears the node being parsed if any: a parse failure might occur outside of a node element
+static void clear_current_node(struct parse_context_t* ctx)
+{
+    if (ctx->node.node_class > 0)
+    {
+        SOPC_AddressSpace_Node_Clear(ctx->space, &ctx->node);
+        ctx->node.node_class = 0;
+    }
+}
+
 static bool start_node(struct parse_context_t* ctx, uint32_t element_type, const XML_Char** attrs)
 {
     SOPC_ASSERT(ctx->node.node_class == 0);
@@ -1071,6 +1116,12 @@ static void clear_complex_value_context(parse_complex_value_context_t* complex_v
     complex_value_ctx->end_element_restore_context = NULL;
     complex_value_ctx->is_extension_object = false;
     complex_value_ctx->value_tag = NULL;
+    if (complex_value_ctx->tags_locked)
+    {
+        complex_value_ctx->tags_locked = false;
+        SOPC_ReturnStatus status = SOPC_Mutex_Unlock(complex_value_ctx->tags_mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
 }
 
 static bool type_id_from_tag(const char* tag,
@@ -1173,6 +1224,12 @@ static bool init_value_complex_ctx(struct parse_context_t* ctx,
         ctx->current_array_type = SOPC_VariantArrayType_SingleValue;
         return false;
     }
+    if (NULL != ctx->complex_value_ctx.tags_mutex)
+    {
+        SOPC_ReturnStatus status = SOPC_Mutex_Lock(ctx->complex_value_ctx.tags_mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+        ctx->complex_value_ctx.tags_locked = true;
+    }
     ctx->complex_value_ctx.value_tag = value_tag;
     ctx->complex_value_ctx.tags = complex_type_tags;
     ctx->complex_value_ctx.end_element_restore_context = SOPC_SLinkedList_Create(0);
@@ -2517,6 +2574,17 @@ static bool finalize_node(struct parse_context_t* ctx)
 
     memcpy(node, &ctx->node, sizeof(SOPC_AddressSpace_Node));
 
+    if (NULL != ctx->parsed_nodes)
+    {
+        if (SOPC_Array_Append(ctx->parsed_nodes, node))
+        {
+            return true;
+        }
+        LOG_MEMORY_ALLOCATION_FAILURE;
+        SOPC_Free(node);
+        return false;
+    }
+
     if (SOPC_AddressSpace_Append(ctx->space, node) == SOPC_STATUS_OK)
     {
         return true;
@@ -2795,7 +2863,7 @@ static void end_element_handler(void* user_data, const XML_Char* name)
 
         if (!ok)
         {
-            SOPC_AddressSpace_Node_Clear(ctx->space, &ctx->node);
+            clear_current_node(ctx);
             XML_StopParser(ctx->helper_ctx.parser, false);
             return;
         }
@@ -2922,39 +2990,78 @@ static bool finalize_node_structure_definitions(SOPC_AddressSpace* nodeSet, SOPC
     return true;
 }
 
-SOPC_AddressSpace* SOPC_UANodeSet_Parse(FILE* fd)
+static SOPC_ReturnStatus init_parse_context(struct parse_context_t* ctx, SOPC_AddressSpace* space)
 {
     static const size_t char_data_cap_initial = 4096;
     SOPC_Dict* aliases = SOPC_Dict_Create((uintptr_t) NULL, str_hash, str_equal, uintptr_t_free, uintptr_t_free);
     XML_Parser parser = XML_ParserCreateNS(NULL, NS_SEPARATOR[0]);
     char* char_data_buffer = SOPC_Calloc(char_data_cap_initial, sizeof(char));
-    SOPC_AddressSpace* space = SOPC_AddressSpace_Create(true);
 
-    if ((aliases == NULL) || (parser == NULL) || (char_data_buffer == NULL) || (space == NULL))
+    memset(ctx, 0, sizeof(struct parse_context_t));
+
+    if ((aliases == NULL) || (parser == NULL) || (char_data_buffer == NULL))
     {
         LOG_MEMORY_ALLOCATION_FAILURE;
         SOPC_Dict_Delete(aliases);
         XML_ParserFree(parser);
         SOPC_Free(char_data_buffer);
-        SOPC_AddressSpace_Delete(space);
-        return NULL;
+        return SOPC_STATUS_OUT_OF_MEMORY;
     }
 
-    struct parse_context_t ctx;
-    memset(&ctx, 0, sizeof(struct parse_context_t));
-    XML_SetUserData(parser, &ctx);
+    XML_SetUserData(parser, ctx);
 
-    ctx.aliases = aliases;
-    ctx.state = PARSE_START;
-    ctx.helper_ctx.parser = parser;
-    ctx.space = space;
-    ctx.helper_ctx.char_data_buffer = char_data_buffer;
-    ctx.helper_ctx.char_data_cap = char_data_cap_initial;
+    ctx->aliases = aliases;
+    ctx->state = PARSE_START;
+    ctx->helper_ctx.parser = parser;
+    ctx->space = space;
+    ctx->helper_ctx.char_data_buffer = char_data_buffer;
+    ctx->helper_ctx.char_data_cap = char_data_cap_initial;
 
     XML_SetElementHandler(parser, start_element_handler, end_element_handler);
     XML_SetCharacterDataHandler(parser, char_data_handler);
 
-    SOPC_ReturnStatus res = parse(parser, fd);
+    return SOPC_STATUS_OK;
+}
+
+static void clear_parse_context(struct parse_context_t* ctx)
+{
+    if (ctx->complex_value_ctx.tags_locked)
+    {
+        // Parsing stopped in a complex value: release the static tags
+        clear_complex_value_context(&ctx->complex_value_ctx);
+    }
+
+    XML_ParserFree(ctx->helper_ctx.parser);
+    SOPC_Dict_Delete(ctx->aliases);
+    SOPC_Free(ctx->current_alias_alias);
+    SOPC_Free(ctx->helper_ctx.char_data_buffer);
+    SOPC_Array_Delete(ctx->definition_fields);
+    SOPC_Array_Delete(ctx->structure_definition_nodeIds);
+    SOPC_Array_Delete(ctx->list_nodes);
+    SOPC_Array_Delete(ctx->references);
+    SOPC_Array_Delete(ctx->parsed_nodes);
+}
+
+SOPC_AddressSpace* SOPC_UANodeSet_Parse(FILE* fd)
+{
+    SOPC_AddressSpace* space = SOPC_AddressSpace_Create(true);
+
+    if (space == NULL)
+    {
+        LOG_MEMORY_ALLOCATION_FAILURE;
+        return NULL;
+    }
+
+    struct parse_context_t ctx;
+    SOPC_ReturnStatus res = init_parse_context(&ctx, space);
+
+    if (res != SOPC_STATUS_OK)
+    {
+        SOPC_AddressSpace_Delete(space);
+        return NULL;
+    }
+
+    res = parse(ctx.helper_ctx.parser, fd);
 
     // StructureDefinition in DataType shall be filled using DataType node references
     if (res == SOPC_STATUS_OK && NULL != ctx.structure_definition_nodeIds)
@@ -2966,14 +3073,7 @@ SOPC_AddressSpace* SOPC_UANodeSet_Parse(FILE* fd)
         }
     }
 
-    XML_ParserFree(parser);
-    SOPC_Dict_Delete(aliases);
-    SOPC_Free(ctx.current_alias_alias);
-    SOPC_Free(ctx.helper_ctx.char_data_buffer);
-    SOPC_Array_Delete(ctx.definition_fields);
-    SOPC_Array_Delete(ctx.structure_definition_nodeIds);
-    SOPC_Array_Delete(ctx.list_nodes);
-    SOPC_Array_Delete(ctx.references);
+    clear_parse_context(&ctx);
 
     if (res == SOPC_STATUS_OK)
     {
@@ -2981,8 +3081,721 @@ SOPC_AddressSpace* SOPC_UANodeSet_Parse(FILE* fd)
     }
     else
     {
-        SOPC_AddressSpace_Node_Clear(ctx.space, &ctx.node);
+        clear_current_node(&ctx);
         SOPC_AddressSpace_Delete(space);
         return NULL;
     }
 }
+
+/* Multi-threaded parsing of a UANodeSet file loaded in memory:
+ * - the content is scanned to locate the start tags of the node elements (direct children of UANodeSet),
+ * - the nodes are split into ranges, each range is parsed by a dedicated expat parser as the document made of
+ *   the UANodeSet prefix (up to the first node, Aliases included), the node range and the UANodeSet end tag,
+ * - the nodes parsed by each thread are then appended to the space in the document order.
+ */
+
+// Node elements which are direct children of the UANodeSet element
+static const char* const nodeset_node_tags[] = {"UAObject",     "UAVariable",     "UAMethod",        "UAView",
+                                                "UAObjectType", "UAVariableType", "UAReferenceType", "UADataType",
+                                                NULL};
+
+typedef struct nodeset_layout_t
+{
+    SOPC_Array* node_offsets; // Offsets (size_t) of the node elements start tags in the content
+    bool aliases_after_nodes; // An Aliases element appears after the first node element
+    const char* end_tag;      // Last end tag of the content (UANodeSet end tag), not NULL terminated
+    size_t end_tag_len;
+} nodeset_layout_t;
+
+typedef struct parse_nodes_job_t
+{
+    SOPC_Thread thread;
+    bool started;
+
+    // Document to parse: prefix + nodes + suffix
+    const char* prefix;
+    size_t prefix_len;
+    const char* nodes;
+    size_t nodes_len;
+    const char* suffix;
+    size_t suffix_len;
+
+    SOPC_AddressSpace* space; // Only used to access the node attributes
+    SOPC_Mutex* tags_mutex;
+
+    // Results
+    SOPC_ReturnStatus status;
+    SOPC_Array* parsed_nodes;                 // SOPC_AddressSpace_Node*, in document order
+    SOPC_Array* structure_definition_nodeIds; // DataType nodes with StructureDefinition to finalize
+} parse_nodes_job_t;
+
+static bool starts_with(const char* p, const char* end, const char* token)
+{
+    size_t len = strlen(token);
+    return ((size_t)(end - p) >= len) && (memcmp(p, token, len) == 0);
+}
+
+// Returns the position following the token or end if it is not found
+static const char* skip_after(const char* p, const char* end, const char* token)
+{
+    while (p < end && NULL != (p = memchr(p, token[0], (size_t)(end - p))))
+    {
+        if (starts_with(p, end, token))
+        {
+            return p + strlen(token);
+        }
+        p++;
+    }
+    return end;
+}
+
+static bool is_element_name(const char* p, const char* end, const char* name)
+{
+    size_t len = strlen(name);
+    if (!starts_with(p, end, name) || p + len == end)
+    {
+        return false;
+    }
+    char c = p[len];
+    return (' ' == c || '\t' == c || '\r' == c || '\n' == c || '>' == c || '/' == c);
+}
+
+static bool is_node_element(const char* p, const char* end)
+{
+    if (!starts_with(p, end, "UA"))
+    {
+        return false;
+    }
+    for (size_t i = 0; NULL != nodeset_node_tags[i]; i++)
+    {
+        if (is_element_name(p, end, nodeset_node_tags[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool scan_nodeset_layout(const char* data, size_t len, nodeset_layout_t* layout)
+{
+    const char* end = data + len;
+    const char* p = data;
+
+    layout->node_offsets = SOPC_Array_Create(sizeof(size_t), 0, NULL);
+    if (NULL == layout->node_offsets)
+    {
+        LOG_MEMORY_ALLOCATION_FAILURE;
+        return false;
+    }
+
+    // Note: '<' is not allowed in attribute values and character data, it only starts markup
+    while (p < end && NULL != (p = memchr(p, '<', (size_t)(end - p))))
+    {
+        const char* tag = p + 1;
+
+        if (starts_with(tag, end, "!--"))
+        {
+            p = skip_after(tag + 3, end, "-->");
+        }
+        else if (starts_with(tag, end, "![CDATA["))
+        {
+            p = skip_after(tag + 8, end, "]]>");
+        }
+        else if (starts_with(tag, end, "/"))
+        {
+            layout->end_tag = p;
+            p = tag;
+        }
+        else if (is_node_element(tag, end))
+        {
+            size_t offset = (size_t)(p - data);
+            if (!SOPC_Array_Append(layout->node_offsets, offset))
+            {
+                LOG_MEMORY_ALLOCATION_FAILURE;
+                return false;
+            }
+            p = tag;
+        }
+        else
+        {
+            if (SOPC_Array_Size(layout->node_offsets) > 0 && is_element_name(tag, end, "Aliases"))
+            {
+                layout->aliases_after_nodes = true;
+            }
+            p = tag;
+        }
+    }
+
+    if (NULL != layout->end_tag)
+    {
+        const char* tag_end = memchr(layout->end_tag, '>', (size_t)(end - layout->end_tag));
+        if (NULL == tag_end)
+        {
+            layout->end_tag = NULL;
+        }
+        else
+        {
+            layout->end_tag_len = (size_t)(tag_end - layout->end_tag) + 1;
+        }
+    }
+
+    return true;
+}
+
+static void delete_parsed_nodes(SOPC_AddressSpace* space, SOPC_Array* nodes, size_t from)
+{
+    for (size_t i = from; i < SOPC_Array_Size(nodes); i++)
+    {
+        SOPC_AddressSpace_Node* node = SOPC_Array_Get(nodes, SOPC_AddressSpace_Node*, i);
+        SOPC_AddressSpace_Node_Clear(space, node);
+        SOPC_Free(node);
+    }
+    SOPC_Array_Delete(nodes);
+}
+
+static void* parse_nodes_job(void* arg)
+{
+    parse_nodes_job_t* job = arg;
+    struct parse_context_t ctx;
+
+    job->status = init_parse_context(&ctx, job->space);
+
+    if (SOPC_STATUS_OK != job->status)
+    {
+        return NULL;
+    }
+
+    ctx.complex_value_ctx.tags_mutex = job->tags_mutex;
+    ctx.parsed_nodes = SOPC_Array_Create(sizeof(SOPC_AddressSpace_Node*), 0, NULL);
+
+    if (NULL == ctx.parsed_nodes)
+    {
+        LOG_MEMORY_ALLOCATION_FAILURE;
+        job->status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    if (SOPC_STATUS_OK == job->status && job->prefix_len > 0)
+    {
+        job->status = parse_bytes(ctx.helper_ctx.parser, job->prefix, job->prefix_len, false);
+    }
+    if (SOPC_STATUS_OK == job->status)
+    {
+        job->status = parse_bytes(ctx.helper_ctx.parser, job->nodes, job->nodes_len, 0 == job->suffix_len);
+    }
+    if (SOPC_STATUS_OK == job->status && job->suffix_len > 0)
+    {
+        job->status = parse_bytes(ctx.helper_ctx.parser, job->suffix, job->suffix_len, true);
+    }
+
+    if (SOPC_STATUS_OK == job->status)
+    {
+        job->parsed_nodes = ctx.parsed_nodes;
+        job->structure_definition_nodeIds = ctx.structure_definition_nodeIds;
+        ctx.parsed_nodes = NULL;
+        ctx.structure_definition_nodeIds = NULL;
+    }
+    else
+    {
+        clear_current_node(&ctx);
+        if (NULL != ctx.parsed_nodes)
+        {
+            delete_parsed_nodes(ctx.space, ctx.parsed_nodes, 0);
+            ctx.parsed_nodes = NULL;
+        }
+    }
+
+    clear_parse_context(&ctx);
+
+    return NULL;
+}
+
+/* Reciprocal references generation:
+ * - all the references between nodes of the space are indexed in a hash set,
+ * - for each reference whose reciprocal is not in the set, the reciprocal is recorded as missing,
+ * - the references arrays of the target nodes are resized once and completed with the missing references.
+ */
+
+typedef struct reference_key_t
+{
+    const SOPC_NodeId* source;
+    const SOPC_NodeId* type;
+    const SOPC_NodeId* target;
+    bool is_inverse;
+} reference_key_t;
+
+typedef struct missing_reference_t
+{
+    SOPC_AddressSpace_Node* target; // Node to which the reciprocal reference shall be added
+    SOPC_AddressSpace_Node* source; // Node containing the reference
+    int32_t index;                  // Index of the reference in source node
+} missing_reference_t;
+
+typedef struct reciprocal_refs_ctx_t
+{
+    SOPC_AddressSpace* space;
+    bool ok;
+    size_t nb_references;
+    reference_key_t* keys; // Storage of the keys indexed in references
+    size_t nb_keys;
+    size_t keys_capacity;
+    SOPC_Dict* references;         // Set of reference_key_t* of the space
+    SOPC_Array* missing;           // missing_reference_t in discovery order
+    SOPC_Dict* nb_missing_by_node; // SOPC_AddressSpace_Node* => number of missing references
+} reciprocal_refs_ctx_t;
+
+static uint64_t reference_key_hash(const uintptr_t data)
+{
+    const reference_key_t* key = (const reference_key_t*) data;
+    uint64_t hash = 0;
+    uint64_t id_hash = 0;
+
+    SOPC_NodeId_Hash(key->source, &hash);
+    SOPC_NodeId_Hash(key->target, &id_hash);
+    hash = SOPC_DJBHash_Step(hash, (const uint8_t*) &id_hash, sizeof(uint64_t));
+    SOPC_NodeId_Hash(key->type, &id_hash);
+    hash = SOPC_DJBHash_Step(hash, (const uint8_t*) &id_hash, sizeof(uint64_t));
+    uint8_t is_inverse = key->is_inverse ? 1 : 0;
+    return SOPC_DJBHash_Step(hash, &is_inverse, sizeof(uint8_t));
+}
+
+static bool reference_key_equal(const uintptr_t a, const uintptr_t b)
+{
+    const reference_key_t* left = (const reference_key_t*) a;
+    const reference_key_t* right = (const reference_key_t*) b;
+
+    return left->is_inverse == right->is_inverse && SOPC_NodeId_Equal(left->source, right->source) &&
+           SOPC_NodeId_Equal(left->target, right->target) && SOPC_NodeId_Equal(left->type, right->type);
+}
+
+static uint64_t node_ptr_hash(const uintptr_t data)
+{
+    return SOPC_DJBHash((const uint8_t*) &data, sizeof(uintptr_t));
+}
+
+static bool node_ptr_equal(const uintptr_t a, const uintptr_t b)
+{
+    return a == b;
+}
+
+static bool is_local_reference(const OpcUa_ReferenceNode* ref)
+{
+    return 0 == ref->TargetId.ServerIndex && ref->TargetId.NamespaceUri.Length <= 0;
+}
+
+static void count_references(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_UNUSED_ARG(key);
+    reciprocal_refs_ctx_t* rctx = (reciprocal_refs_ctx_t*) user_data;
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+    int32_t nb_refs = *SOPC_AddressSpace_Get_NoOfReferences(rctx->space, node);
+
+    if (nb_refs > 0)
+    {
+        rctx->nb_references += (size_t) nb_refs;
+    }
+}
+
+static bool index_reference_key(reciprocal_refs_ctx_t* rctx, const reference_key_t* key)
+{
+    SOPC_ASSERT(rctx->nb_keys < rctx->keys_capacity);
+    reference_key_t* stored = &rctx->keys[rctx->nb_keys];
+    *stored = *key;
+    rctx->nb_keys++;
+    return SOPC_Dict_Insert(rctx->references, (uintptr_t) stored, 0);
+}
+
+static void index_references(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    reciprocal_refs_ctx_t* rctx = (reciprocal_refs_ctx_t*) user_data;
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+    int32_t nb_refs = *SOPC_AddressSpace_Get_NoOfReferences(rctx->space, node);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(rctx->space, node);
+
+    for (int32_t i = 0; rctx->ok && i < nb_refs; i++)
+    {
+        if (is_local_reference(&refs[i]))
+        {
+            reference_key_t ref_key = {(const SOPC_NodeId*) key, &refs[i].ReferenceTypeId, &refs[i].TargetId.NodeId,
+                                       refs[i].IsInverse};
+            rctx->ok = index_reference_key(rctx, &ref_key);
+        }
+    }
+}
+
+static void find_missing_references(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    reciprocal_refs_ctx_t* rctx = (reciprocal_refs_ctx_t*) user_data;
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+    int32_t nb_refs = *SOPC_AddressSpace_Get_NoOfReferences(rctx->space, node);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(rctx->space, node);
+
+    for (int32_t i = 0; rctx->ok && i < nb_refs; i++)
+    {
+        if (!is_local_reference(&refs[i]))
+        {
+            continue;
+        }
+
+        bool found = false;
+        SOPC_AddressSpace_Node* target = SOPC_AddressSpace_Get_Node(rctx->space, &refs[i].TargetId.NodeId, &found);
+
+        if (!found)
+        {
+            continue;
+        }
+
+        reference_key_t reciprocal = {SOPC_AddressSpace_Get_NodeId(rctx->space, target), &refs[i].ReferenceTypeId,
+                                      (const SOPC_NodeId*) key, !refs[i].IsInverse};
+        SOPC_Dict_Get(rctx->references, (uintptr_t) &reciprocal, &found);
+
+        if (!found)
+        {
+            missing_reference_t missing = {target, node, i};
+            uintptr_t nb_missing = SOPC_Dict_Get(rctx->nb_missing_by_node, (uintptr_t) target, NULL);
+
+            // Index the reciprocal reference too, in case the reference is duplicated
+            rctx->ok = index_reference_key(rctx, &reciprocal) && SOPC_Array_Append(rctx->missing, missing) &&
+                       SOPC_Dict_Insert(rctx->nb_missing_by_node, (uintptr_t) target, nb_missing + 1);
+        }
+    }
+}
+
+static void reserve_missing_references(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    reciprocal_refs_ctx_t* rctx = (reciprocal_refs_ctx_t*) user_data;
+    SOPC_AddressSpace_Node* node = (SOPC_AddressSpace_Node*) key;
+
+    if (!rctx->ok)
+    {
+        return;
+    }
+
+    int32_t nb_refs = *SOPC_AddressSpace_Get_NoOfReferences(rctx->space, node);
+    OpcUa_ReferenceNode** refs = SOPC_AddressSpace_Get_References(rctx->space, node);
+    size_t nb_refs_size = (size_t)(nb_refs > 0 ? nb_refs : 0);
+
+    if (nb_refs_size + value > INT32_MAX)
+    {
+        rctx->ok = false;
+        return;
+    }
+
+    OpcUa_ReferenceNode* new_refs = SOPC_Calloc(nb_refs_size + value, sizeof(OpcUa_ReferenceNode));
+
+    if (NULL == new_refs)
+    {
+        rctx->ok = false;
+        return;
+    }
+
+    if (nb_refs_size > 0)
+    {
+        memcpy(new_refs, *refs, nb_refs_size * sizeof(OpcUa_ReferenceNode));
+    }
+    SOPC_Free(*refs);
+    *refs = new_refs;
+}
+
+static SOPC_ReturnStatus add_missing_reference(SOPC_AddressSpace* space, const missing_reference_t* missing)
+{
+    int32_t* nb_refs = SOPC_AddressSpace_Get_NoOfReferences(space, missing->target);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, missing->target);
+    const OpcUa_ReferenceNode* source_refs = *SOPC_AddressSpace_Get_References(space, missing->source);
+    const OpcUa_ReferenceNode* source_ref = &source_refs[missing->index];
+    OpcUa_ReferenceNode* ref = &refs[*nb_refs];
+
+    OpcUa_ReferenceNode_Initialize(ref);
+    (*nb_refs)++;
+    ref->IsInverse = !source_ref->IsInverse;
+    SOPC_ReturnStatus status = SOPC_NodeId_Copy(&ref->ReferenceTypeId, &source_ref->ReferenceTypeId);
+
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_NodeId_Copy(&ref->TargetId.NodeId, SOPC_AddressSpace_Get_NodeId(space, missing->source));
+    }
+
+    return status;
+}
+
+static SOPC_ReturnStatus generate_reciprocal_references(SOPC_AddressSpace* space, uint32_t* nb_added)
+{
+    reciprocal_refs_ctx_t rctx;
+    memset(&rctx, 0, sizeof(reciprocal_refs_ctx_t));
+    rctx.space = space;
+    rctx.ok = true;
+
+    SOPC_AddressSpace_ForEach(space, count_references, (uintptr_t) &rctx);
+
+    // Each reference is indexed and might lead to index one missing reciprocal reference
+    rctx.keys_capacity = 2 * rctx.nb_references;
+    rctx.keys = SOPC_Calloc(rctx.keys_capacity > 0 ? rctx.keys_capacity : 1, sizeof(reference_key_t));
+    rctx.references = SOPC_Dict_Create((uintptr_t) NULL, reference_key_hash, reference_key_equal, NULL, NULL);
+    rctx.missing = SOPC_Array_Create(sizeof(missing_reference_t), 0, NULL);
+    rctx.nb_missing_by_node = SOPC_Dict_Create((uintptr_t) NULL, node_ptr_hash, node_ptr_equal, NULL, NULL);
+
+    rctx.ok = NULL != rctx.keys && NULL != rctx.references && NULL != rctx.missing &&
+              NULL != rctx.nb_missing_by_node && SOPC_Dict_Reserve(rctx.references, rctx.nb_references);
+
+    if (rctx.ok)
+    {
+        SOPC_AddressSpace_ForEach(space, index_references, (uintptr_t) &rctx);
+    }
+    if (rctx.ok)
+    {
+        SOPC_AddressSpace_ForEach(space, find_missing_references, (uintptr_t) &rctx);
+    }
+
+    // The keys reference the references arrays which are going to be resized
+    SOPC_Dict_Delete(rctx.references);
+    SOPC_Free(rctx.keys);
+
+    if (rctx.ok)
+    {
+        SOPC_Dict_ForEach(rctx.nb_missing_by_node, reserve_missing_references, (uintptr_t) &rctx);
+    }
+
+    SOPC_ReturnStatus status = rctx.ok ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY;
+    size_t nb_missing = (NULL != rctx.missing) ? SOPC_Array_Size(rctx.missing) : 0;
+
+    for (size_t i = 0; SOPC_STATUS_OK == status && i < nb_missing; i++)
+    {
+        status = add_missing_reference(space, SOPC_Array_Get_Ptr(rctx.missing, i));
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        *nb_added = (uint32_t) nb_missing;
+    }
+    else
+    {
+        LOG_MEMORY_ALLOCATION_FAILURE;
+    }
+
+    SOPC_Array_Delete(rctx.missing);
+    SOPC_Dict_Delete(rctx.nb_missing_by_node);
+
+    return status;
+}
+
+static uint64_t phase_duration(SOPC_TimeReference* phase_start)
+{
+    SOPC_TimeReference now = SOPC_TimeReference_GetCurrent();
+    uint64_t duration = now - *phase_start;
+    *phase_start = now;
+    return duration;
+}
+
+static void split_nodes_jobs(const char* data,
+                             size_t len,
+                             const nodeset_layout_t* layout,
+                             uint32_t nb_jobs,
+                             parse_nodes_job_t* jobs)
+{
+    if (1 == nb_jobs)
+    {
+        jobs[0].nodes = data;
+        jobs[0].nodes_len = len;
+        return;
+    }
+
+    size_t nb_nodes = SOPC_Array_Size(layout->node_offsets);
+    size_t first_offset = SOPC_Array_Get(layout->node_offsets, size_t, 0);
+
+    for (uint32_t i = 0; i < nb_jobs; i++)
+    {
+        size_t start = SOPC_Array_Get(layout->node_offsets, size_t, (nb_nodes * i) / nb_jobs);
+        size_t end = len;
+
+        jobs[i].prefix = data;
+        jobs[i].prefix_len = first_offset;
+        if (i + 1 < nb_jobs)
+        {
+            end = SOPC_Array_Get(layout->node_offsets, size_t, (nb_nodes * (i + 1)) / nb_jobs);
+            jobs[i].suffix = layout->end_tag;
+            jobs[i].suffix_len = layout->end_tag_len;
+        }
+        jobs[i].nodes = data + start;
+        jobs[i].nodes_len = end - start;
+    }
+}
+
+static SOPC_ReturnStatus run_parse_nodes_jobs(uint32_t nb_jobs, parse_nodes_job_t* jobs)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+
+    if (1 == nb_jobs)
+    {
+        parse_nodes_job(&jobs[0]);
+        return jobs[0].status;
+    }
+
+    for (uint32_t i = 0; SOPC_STATUS_OK == status && i < nb_jobs; i++)
+    {
+        status = SOPC_Thread_Create(&jobs[i].thread, parse_nodes_job, &jobs[i], "UANodeSetParse");
+        jobs[i].started = (SOPC_STATUS_OK == status);
+    }
+
+    for (uint32_t i = 0; i < nb_jobs; i++)
+    {
+        if (jobs[i].started)
+        {
+            SOPC_ReturnStatus join_status = SOPC_Thread_Join(jobs[i].thread);
+            SOPC_ASSERT(SOPC_STATUS_OK == join_status);
+            if (SOPC_STATUS_OK == status)
+            {
+                status = jobs[i].status;
+            }
+        }
+    }
+
+    return status;
+}
+
+static SOPC_ReturnStatus merge_parsed_nodes(SOPC_AddressSpace* space,
+                                            SOPC_ReturnStatus status,
+                                            uint32_t nb_jobs,
+                                            parse_nodes_job_t* jobs)
+{
+    for (uint32_t i = 0; i < nb_jobs; i++)
+    {
+        if (NULL == jobs[i].parsed_nodes)
+        {
+            continue;
+        }
+
+        size_t nb_nodes = SOPC_Array_Size(jobs[i].parsed_nodes);
+        size_t j = 0;
+        for (; SOPC_STATUS_OK == status && j < nb_nodes; j++)
+        {
+            SOPC_AddressSpace_Node* node = SOPC_Array_Get(jobs[i].parsed_nodes, SOPC_AddressSpace_Node*, j);
+            status = SOPC_AddressSpace_Append(space, node);
+            if (SOPC_STATUS_OK != status)
+            {
+                // Not appended: clear it with the remaining nodes
+                break;
+            }
+        }
+
+        // Nodes appended are now owned by the space
+        delete_parsed_nodes(space, jobs[i].parsed_nodes, j);
+        jobs[i].parsed_nodes = NULL;
+    }
+
+    return status;
+}
+
+SOPC_AddressSpace* SOPC_UANodeSet_ParseFile(const char* path,
+                                            const SOPC_UANodeSet_ParseOptions* options,
+                                            SOPC_UANodeSet_ParseReport* report)
+{
+    const SOPC_UANodeSet_ParseOptions default_options = {1, false};
+    SOPC_UANodeSet_ParseReport local_report;
+
+    if (NULL == path)
+    {
+        return NULL;
+    }
+    if (NULL == options)
+    {
+        options = &default_options;
+    }
+    if (NULL == report)
+    {
+        report = &local_report;
+    }
+    memset(report, 0, sizeof(SOPC_UANodeSet_ParseReport));
+
+    SOPC_TimeReference phase_start = SOPC_TimeReference_GetCurrent();
+    SOPC_Buffer* buffer = NULL;
+    SOPC_ReturnStatus status = SOPC_Buffer_ReadFile(path, &buffer);
+
+    if (SOPC_STATUS_OK != status)
+    {
+        LOGF("Error while reading input file: %s", path);
+        return NULL;
+    }
+    report->readDuration = phase_duration(&phase_start);
+
+    const char* data = (const char*) buffer->data;
+    size_t len = buffer->length;
+    nodeset_layout_t layout;
+    memset(&layout, 0, sizeof(nodeset_layout_t));
+    bool ok = scan_nodeset_layout(data, len, &layout);
+    size_t nb_nodes = ok ? SOPC_Array_Size(layout.node_offsets) : 0;
+    uint32_t nb_jobs = 1;
+
+    // Split only when each range of nodes can be parsed with the Aliases and closed by the UANodeSet end tag
+    if (ok && options->nbThreads > 1 && nb_nodes > 1 && !layout.aliases_after_nodes && NULL != layout.end_tag)
+    {
+        nb_jobs = (nb_nodes < options->nbThreads) ? (uint32_t) nb_nodes : options->nbThreads;
+    }
+    report->nbThreads = nb_jobs;
+    report->nbNodes = (nb_nodes > UINT32_MAX) ? UINT32_MAX : (uint32_t) nb_nodes;
+    report->splitDuration = phase_duration(&phase_start);
+
+    SOPC_AddressSpace* space = ok ? SOPC_AddressSpace_Create(true) : NULL;
+    parse_nodes_job_t* jobs = SOPC_Calloc(nb_jobs, sizeof(parse_nodes_job_t));
+    SOPC_Mutex tags_mutex;
+    bool mutex_init = false;
+
+    status = (NULL != space && NULL != jobs) ? SOPC_AddressSpace_Reserve(space, nb_nodes) : SOPC_STATUS_OUT_OF_MEMORY;
+    if (SOPC_STATUS_OK == status && nb_jobs > 1)
+    {
+        status = SOPC_Mutex_Initialization(&tags_mutex);
+        mutex_init = (SOPC_STATUS_OK == status);
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        split_nodes_jobs(data, len, &layout, nb_jobs, jobs);
+        for (uint32_t i = 0; i < nb_jobs; i++)
+        {
+            jobs[i].space = space;
+            jobs[i].tags_mutex = mutex_init ? &tags_mutex : NULL;
+        }
+        status = run_parse_nodes_jobs(nb_jobs, jobs);
+        report->parseDuration = phase_duration(&phase_start);
+
+        status = merge_parsed_nodes(space, status, nb_jobs, jobs);
+        report->mergeDuration = phase_duration(&phase_start);
+    }
+
+    if (SOPC_STATUS_OK == status && options->generateReciprocalReferences)
+    {
+        status = generate_reciprocal_references(space, &report->nbReciprocalRefs);
+        report->reciprocalRefDuration = phase_duration(&phase_start);
+    }
+
+    // StructureDefinition in DataType shall be filled using DataType node references
+    for (uint32_t i = 0; NULL != jobs && i < nb_jobs; i++)
+    {
+        if (SOPC_STATUS_OK == status && NULL != jobs[i].structure_definition_nodeIds &&
+            !finalize_node_structure_definitions(space, jobs[i].structure_definition_nodeIds))
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+        SOPC_Array_Delete(jobs[i].structure_definition_nodeIds);
+    }
+    report->finalizeDuration = phase_duration(&phase_start);
+
+    if (mutex_init)
+    {
+        SOPC_Mutex_Clear(&tags_mutex);
+    }
+    SOPC_Free(jobs);
+    SOPC_Array_Delete(layout.node_offsets);
+    SOPC_Buffer_Delete(buffer);
+
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_AddressSpace_Delete(space);
+        space = NULL;
+    }
+
+    return space;
+}
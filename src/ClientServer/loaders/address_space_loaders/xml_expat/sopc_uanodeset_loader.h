@@ -20,9 +20,69 @@
 #ifndef SOPC_NODESET_LOADER_H_
 #define SOPC_NODESET_LOADER_H_
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+
 #include "sopc_address_space.h"
 
+/**
+ * \brief Options of the UANodeSet loader in ::SOPC_UANodeSet_ParseFile
+ */
+typedef struct SOPC_UANodeSet_ParseOptions
+{
+    uint32_t nbThreads; /**< Number of threads used to parse the nodes. The nodes of the UANodeSet are split into
+                             independent ranges of similar size each parsed by a dedicated thread.
+                             0 or 1 parses the whole UANodeSet in the calling thread. */
+    bool generateReciprocalReferences; /**< When set, for each reference between 2 nodes of the UANodeSet, the
+                                            reciprocal reference is added to the target node if it is missing.
+                                            It replaces the offline generation with
+                                            scripts/gen-reciprocal-refs-address-space.xslt */
+} SOPC_UANodeSet_ParseOptions;
+
+/**
+ * \brief Per-phase report of ::SOPC_UANodeSet_ParseFile, durations are in milliseconds
+ */
+typedef struct SOPC_UANodeSet_ParseReport
+{
+    uint64_t readDuration;          /**< Reading the file content into memory */
+    uint64_t splitDuration;         /**< Scanning the content to split the nodes into ranges */
+    uint64_t parseDuration;         /**< Parsing the node ranges (in parallel) */
+    uint64_t mergeDuration;         /**< Appending the parsed nodes into the AddressSpace */
+    uint64_t reciprocalRefDuration; /**< Generating the missing reciprocal references */
+    uint64_t finalizeDuration;      /**< Completing the DataType nodes StructureDefinition */
+    uint32_t nbThreads;             /**< Number of threads actually used to parse the nodes */
+    uint32_t nbNodes;               /**< Number of node elements found in the UANodeSet */
+    uint32_t nbReciprocalRefs;      /**< Number of reciprocal references added */
+} SOPC_UANodeSet_ParseReport;
+
+/**
+ * \brief Parses an XML UANodeSet stream into an AddressSpace using a single thread.
+ *
+ * \param fd  the opened UANodeSet file
+ *
+ * \return the AddressSpace containing the nodes of the UANodeSet or NULL in case of failure
+ */
 SOPC_AddressSpace* SOPC_UANodeSet_Parse(FILE* fd);
 
+/**
+ * \brief Parses an XML UANodeSet file into an AddressSpace, optionally using several threads
+ *        and generating the missing reciprocal references.
+ *
+ * The file content is read into memory and scanned to count and locate the node elements,
+ * the AddressSpace is then reserved for the number of nodes before the node ranges are parsed.
+ *
+ * \param path     the path of the UANodeSet file
+ * \param options  the loader options, NULL to use the defaults (single thread, no reciprocal references)
+ * \param report   optional output for the timing of each loading phase, might be NULL
+ *
+ * \return the AddressSpace containing the nodes of the UANodeSet or NULL in case of failure
+ *
+ * \note The nodes are split only when the node elements are not prefixed by an XML namespace prefix
+ *       and the Aliases element precedes the nodes, otherwise the UANodeSet is parsed by a single thread.
+ */
+SOPC_AddressSpace* SOPC_UANodeSet_ParseFile(const char* path,
+                                            const SOPC_UANodeSet_ParseOptions* options,
+                                            SOPC_UANodeSet_ParseReport* report);
+
 #endif /* SOPC_NODESET_LOADER_H_ */
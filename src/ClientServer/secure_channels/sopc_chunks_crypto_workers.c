@@ -0,0 +1,259 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "sopc_chunks_crypto_workers.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sopc_assert.h"
+#include "sopc_logger.h"
+#include "sopc_macros.h"
+#include "sopc_mutexes.h"
+#include "sopc_threads.h"
+#include "sopc_toolkit_config_constants.h"
+
+typedef struct SOPC_ChunksCryptoWorkers
+{
+    SOPC_Mutex mutex;
+    SOPC_Condition workCond; // Signaled when slices are available or workers shall stop
+    SOPC_Condition doneCond; // Signaled when the last slice is processed
+#if SOPC_SC_CRYPTO_WORKERS > 0
+    SOPC_Thread threads[SOPC_SC_CRYPTO_WORKERS];
+#endif
+    uint32_t nbThreads;
+    bool initialized;
+    bool started; // Worker threads are created on first use only
+    bool stop;
+
+    /* Jobs being processed: slice i contains jobs [i * sliceLength, min((i + 1) * sliceLength, nbJobs)[ */
+    SOPC_CryptoProvider_SymmetricJob* pJobs;
+    uint32_t nbJobs;
+    uint32_t sliceLength;
+    uint32_t nbSlices;
+    uint32_t nextSlice;
+    uint32_t nbSlicesDone;
+} SOPC_ChunksCryptoWorkers;
+
+static SOPC_ChunksCryptoWorkers workers;
+
+/* Processes the slices until none is left. Called with the mutex locked, it returns with the mutex locked. */
+static void process_slices_locked(void)
+{
+    while (workers.nextSlice < workers.nbSlices)
+    {
+        uint32_t slice = workers.nextSlice;
+        workers.nextSlice++;
+        SOPC_CryptoProvider_SymmetricJob* pJobs = &workers.pJobs[slice * workers.sliceLength];
+        uint32_t nbJobs = workers.nbJobs - slice * workers.sliceLength;
+        if (nbJobs > workers.sliceLength)
+        {
+            nbJobs = workers.sliceLength;
+        }
+
+        SOPC_ReturnStatus status = SOPC_Mutex_Unlock(&workers.mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+        // Result is provided by the status of each job
+        SOPC_CryptoProvider_SymmetricSignEncryptBatch(pJobs, nbJobs);
+
+        status = SOPC_Mutex_Lock(&workers.mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+        workers.nbSlicesDone++;
+        if (workers.nbSlicesDone == workers.nbSlices)
+        {
+            status = SOPC_Condition_SignalAll(&workers.doneCond);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+        }
+    }
+}
+
+#if SOPC_SC_CRYPTO_WORKERS > 0
+static void* worker_thread(void* arg)
+{
+    SOPC_UNUSED_ARG(arg);
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    while (!workers.stop)
+    {
+        if (workers.nextSlice < workers.nbSlices)
+        {
+            process_slices_locked();
+        }
+        else
+        {
+            status = SOPC_Mutex_UnlockAndWaitCond(&workers.workCond, &workers.mutex);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+        }
+    }
+    status = SOPC_Mutex_Unlock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+    return NULL;
+}
+#endif
+
+SOPC_ReturnStatus SOPC_ChunksCryptoWorkers_Initialize(void)
+{
+    SOPC_ASSERT(!workers.initialized);
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Initialization(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    status = SOPC_Condition_Init(&workers.workCond);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    status = SOPC_Condition_Init(&workers.doneCond);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+    workers.nbThreads = 0;
+    workers.started = false;
+    workers.stop = false;
+    workers.pJobs = NULL;
+    workers.nbJobs = 0;
+    workers.sliceLength = 0;
+    workers.nbSlices = 0;
+    workers.nextSlice = 0;
+    workers.nbSlicesDone = 0;
+    workers.initialized = true;
+
+    return status;
+}
+
+/* Creates the worker threads on first use, it is attempted only once */
+static void start_workers(void)
+{
+    SOPC_ASSERT(!workers.started);
+    workers.started = true;
+
+#if SOPC_SC_CRYPTO_WORKERS > 0
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    for (uint32_t i = 0; SOPC_STATUS_OK == status && i < SOPC_SC_CRYPTO_WORKERS; i++)
+    {
+        status = SOPC_Thread_Create(&workers.threads[i], worker_thread, NULL, "SC_Crypto");
+        if (SOPC_STATUS_OK == status)
+        {
+            workers.nbThreads++;
+        }
+        else
+        {
+            SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                     "ChunksCryptoWorkers: only %" PRIu32 " worker threads out of %d were created",
+                                     workers.nbThreads, SOPC_SC_CRYPTO_WORKERS);
+        }
+    }
+#endif
+}
+
+void SOPC_ChunksCryptoWorkers_Clear(void)
+{
+    if (!workers.initialized)
+    {
+        return;
+    }
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    workers.stop = true;
+    status = SOPC_Condition_SignalAll(&workers.workCond);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    status = SOPC_Mutex_Unlock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+#if SOPC_SC_CRYPTO_WORKERS > 0
+    for (uint32_t i = 0; i < workers.nbThreads; i++)
+    {
+        status = SOPC_Thread_Join(workers.threads[i]);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
+#endif
+    workers.nbThreads = 0;
+    workers.started = false;
+
+    SOPC_Condition_Clear(&workers.doneCond);
+    SOPC_Condition_Clear(&workers.workCond);
+    SOPC_Mutex_Clear(&workers.mutex);
+    workers.initialized = false;
+}
+
+SOPC_ReturnStatus SOPC_ChunksCryptoWorkers_SignEncrypt(SOPC_CryptoProvider_SymmetricJob* pJobs, uint32_t nbJobs)
+{
+    if (NULL == pJobs || 0 == nbJobs)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    if (workers.initialized && !workers.started && 0 < SOPC_SC_CRYPTO_WORKERS && nbJobs > 1)
+    {
+        start_workers();
+    }
+
+    if (!workers.initialized || 0 == workers.nbThreads || 1 == nbJobs)
+    {
+        return SOPC_CryptoProvider_SymmetricSignEncryptBatch(pJobs, nbJobs);
+    }
+
+    // One slice for each worker and one for the calling thread
+    uint32_t nbParticipants = workers.nbThreads + 1;
+    uint32_t sliceLength = nbJobs / nbParticipants;
+    if (0 != nbJobs % nbParticipants)
+    {
+        sliceLength++;
+    }
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    SOPC_ASSERT(NULL == workers.pJobs); // Only one caller at a time
+
+    workers.pJobs = pJobs;
+    workers.nbJobs = nbJobs;
+    workers.sliceLength = sliceLength;
+    workers.nbSlices = nbJobs / sliceLength + (0 != nbJobs % sliceLength ? 1 : 0);
+    workers.nextSlice = 0;
+    workers.nbSlicesDone = 0;
+    status = SOPC_Condition_SignalAll(&workers.workCond);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+    // The calling thread takes its share of the slices, then waits for the ones processed by the workers
+    process_slices_locked();
+    while (workers.nbSlicesDone < workers.nbSlices)
+    {
+        status = SOPC_Mutex_UnlockAndWaitCond(&workers.doneCond, &workers.mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
+
+    workers.pJobs = NULL;
+    workers.nbJobs = 0;
+    workers.sliceLength = 0;
+    workers.nbSlices = 0;
+    workers.nextSlice = 0;
+    workers.nbSlicesDone = 0;
+    status = SOPC_Mutex_Unlock(&workers.mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+    for (uint32_t i = 0; i < nbJobs; i++)
+    {
+        if (SOPC_STATUS_OK != pJobs[i].status)
+        {
+            return pJobs[i].status;
+        }
+    }
+    return SOPC_STATUS_OK;
+}
@@ -0,0 +1,70 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ *  \file
+ *
+ *  \brief Worker threads signing and encrypting the chunks of multi-chunk messages for the chunks manager.
+ *
+ *  The chunks are encoded (sequence number included) in order by the Secure_Channels thread, then the independent
+ *  symmetric operations of their signature and encryption are shared between the workers and the Secure_Channels
+ *  thread. The chunks are sent in order once all of them are processed.
+ */
+
+#ifndef SOPC_CHUNKS_CRYPTO_WORKERS_H_
+#define SOPC_CHUNKS_CRYPTO_WORKERS_H_
+
+#include <stdint.h>
+
+#include "sopc_crypto_provider.h"
+#include "sopc_enums.h"
+
+/**
+ * \brief Initializes the workers context.
+ *
+ * The ::SOPC_SC_CRYPTO_WORKERS worker threads are only created by the first call to
+ * ::SOPC_ChunksCryptoWorkers_SignEncrypt with several jobs, that is when a first signed multi-chunk message is sent.
+ * When a worker thread cannot be created, the jobs are shared between the already created workers.
+ *
+ * \return SOPC_STATUS_OK in case of success, an error status otherwise.
+ */
+SOPC_ReturnStatus SOPC_ChunksCryptoWorkers_Initialize(void);
+
+/**
+ * \brief Stops and joins the worker threads.
+ */
+void SOPC_ChunksCryptoWorkers_Clear(void);
+
+/**
+ * \brief Signs then encrypts the chunks described by \p pJobs (see ::SOPC_CryptoProvider_SymmetricSignEncryptBatch).
+ *
+ * The jobs are split in consecutive slices processed by the workers and by the calling thread.
+ * The function returns when all the jobs are processed.
+ *
+ * \param pJobs   A valid pointer to an array of \p nbJobs jobs. The status of each job is set.
+ * \param nbJobs  The number of jobs, which shall be greater than 0.
+ *
+ * \note Only one thread shall call this function at a time (the Secure_Channels thread).
+ *
+ * \return SOPC_STATUS_OK when all the jobs succeeded, SOPC_STATUS_INVALID_PARAMETERS when parameters are NULL or 0,
+ *         and otherwise the status of the first job which failed.
+ */
+SOPC_ReturnStatus SOPC_ChunksCryptoWorkers_SignEncrypt(SOPC_CryptoProvider_SymmetricJob* pJobs, uint32_t nbJobs);
+
+#endif /* SOPC_CHUNKS_CRYPTO_WORKERS_H_ */
@@ -29,6 +29,7 @@
 #include "sopc_crypto_provider.h"
 
 #include "sopc_assert.h"
+#include "sopc_chunks_crypto_workers.h"
 #include "sopc_encoder.h"
 #include "sopc_event_timer_manager.h"
 #include "sopc_logger.h"
@@ -41,6 +42,7 @@
 #include "sopc_secure_channels_internal_ctx.h"
 #include "sopc_singly_linked_list.h"
 #include "sopc_sockets_api.h"
+#include "sopc_toolkit_config_constants.h"
 #include "sopc_toolkit_config_internal.h"
 
 static const uint8_t SOPC_HEL[3] = {'H', 'E', 'L'};
@@ -3591,6 +3593,60 @@ static bool SC_Chunks_Encrypt(SOPC_SecureConnection* scConnection,
     return result;
 }
 
+static bool SC_Chunks_PrepareSymmetricJob(SOPC_SecureConnection* scConnection,
+                                          SOPC_Buffer* nonEncryptedBuffer,
+                                          bool toEncrypt,
+                                          bool isPrevCryptoData,
+                                          uint32_t signatureSize,
+                                          uint32_t encryptedDataLength,
+                                          SOPC_CryptoProvider_SymmetricJob* job,
+                                          SOPC_StatusCode* errorStatus)
+{
+    SOPC_SC_SecurityKeySet* senderKeySet = NULL;
+    SOPC_SC_SecurityKeySet* receiverKeySet = NULL;
+
+    if (!SC_Chunks_GetSecurityKeySets(scConnection, isPrevCryptoData, &senderKeySet, &receiverKeySet))
+    {
+        *errorStatus = OpcUa_BadTcpInternalError;
+        return false;
+    }
+
+    // Buffer length shall include the signature and the encrypted part is computed in place
+    const uint32_t lengthToSign = nonEncryptedBuffer->length;
+    SOPC_ReturnStatus status = SOPC_STATUS_NOK;
+    if (signatureSize > 0 && signatureSize <= UINT32_MAX - lengthToSign)
+    {
+        status = SOPC_Buffer_SetDataLength(nonEncryptedBuffer, lengthToSign + signatureSize);
+    }
+    if (SOPC_STATUS_OK == status && toEncrypt &&
+        nonEncryptedBuffer->length != SOPC_UA_SYMMETRIC_SEQUENCE_HEADER_POSITION + encryptedDataLength)
+    {
+        status = SOPC_STATUS_NOK;
+    }
+    if (SOPC_STATUS_OK != status)
+    {
+        *errorStatus = OpcUa_BadTcpInternalError;
+        return false;
+    }
+
+    memset(job, 0, sizeof(*job));
+    job->pProvider = scConnection->cryptoProvider;
+    job->pSignKey = senderKeySet->signKey;
+    if (toEncrypt)
+    {
+        job->pEncryptKey = senderKeySet->encryptKey;
+        job->pIV = senderKeySet->initVector;
+    }
+    job->pData = nonEncryptedBuffer->data;
+    job->lenToSign = lengthToSign;
+    job->offsetToEncrypt = SOPC_UA_SYMMETRIC_SEQUENCE_HEADER_POSITION;
+    job->pOutput = &nonEncryptedBuffer->data[SOPC_UA_SYMMETRIC_SEQUENCE_HEADER_POSITION];
+    job->lenOutput = encryptedDataLength;
+    job->status = SOPC_STATUS_NOK;
+
+    return true;
+}
+
 static bool SC_Chunks_CreateClientSentRequestContext(uint32_t scConnectionIdx,
                                                      SOPC_SecureConnection* scConnection,
                                                      uint32_t requestIdOrHandle,
@@ -3874,13 +3930,16 @@ static bool SC_Chunks_TreatSendBufferMSGCLO(
     uint8_t isFinalChar,
     SOPC_Buffer** inputChunkBuffer,
     SOPC_Buffer** outputBuffer,
-    SOPC_StatusCode* errorStatus)
+    SOPC_StatusCode* errorStatus,
+    SOPC_CryptoProvider_SymmetricJob* deferredCryptoJob, // NULL to sign and encrypt the chunk immediately
+    uint32_t* deferredRequestId)                         // requestId encoded when crypto is deferred
 {
     SOPC_ASSERT(scConnection != NULL);
     SOPC_ASSERT(inputChunkBuffer != NULL);
     SOPC_ASSERT(*inputChunkBuffer != NULL);
     SOPC_ASSERT(outputBuffer != NULL);
     SOPC_ASSERT(errorStatus != NULL);
+    SOPC_ASSERT(NULL == deferredCryptoJob || NULL != deferredRequestId);
     SOPC_Buffer* nonEncryptedBuffer = *inputChunkBuffer;
     SOPC_SecureChannel_Config* scConfig = NULL;
     bool result = false;
@@ -4025,7 +4084,21 @@ static bool SC_Chunks_TreatSendBufferMSGCLO(
         SOPC_ASSERT(SOPC_STATUS_OK == status);
     }
 
-    if (result && toSign)
+    if (result && NULL != deferredCryptoJob)
+    {
+        /* PREPARE SIGNATURE AND ENCRYPTION (done in place by the caller) */
+        SOPC_ASSERT(toSign);
+        result = SC_Chunks_PrepareSymmetricJob(scConnection, nonEncryptedBuffer, toEncrypt, isPrevCryptoData,
+                                               signatureSize, encryptedDataLength, deferredCryptoJob, errorStatus);
+        if (result)
+        {
+            *deferredRequestId = requestId;
+            // Output buffer is the chunk buffer which shall not be reused
+            *outputBuffer = nonEncryptedBuffer;
+            *inputChunkBuffer = NULL;
+        }
+    }
+    else if (result && toSign)
     {
         /* SIGN MESSAGE */
         result = SC_Chunks_EncodeSignature(scConnectionIdx, scConnection, nonEncryptedBuffer, true, isPrevCryptoData,
@@ -4042,7 +4115,7 @@ static bool SC_Chunks_TreatSendBufferMSGCLO(
         }
     }
 
-    if (result)
+    if (result && NULL == deferredCryptoJob)
     {
         /* ENCRYPT MESSAGE */
         if (toEncrypt)
@@ -4061,8 +4134,8 @@ static bool SC_Chunks_TreatSendBufferMSGCLO(
         }
     }
 
-    /* RECORD REQUEST CONTEXT (CLIENT ONLY) */
-    if (result && !scConnection->isServerConnection && isFinalChar == 'F')
+    /* RECORD REQUEST CONTEXT (CLIENT ONLY, recorded by the caller when crypto is deferred) */
+    if (result && NULL == deferredCryptoJob && !scConnection->isServerConnection && isFinalChar == 'F')
     {
         result = SC_Chunks_CreateClientSentRequestContext(scConnectionIdx, scConnection, requestIdOrHandle, sendMsgType,
                                                           requestId, errorStatus);
@@ -4283,6 +4356,116 @@ static uint8_t SC_Chunks_IsNextChunkIntermediateOrFinal(uint32_t nb_chunks_requi
     }
 }
 
+/*
+ * Sends the chunks of a signed message by windows of SOPC_SC_CRYPTO_CHUNKS_WINDOW chunks:
+ * the chunks of a window are encoded in order (consecutive sequence numbers), then they are signed and encrypted
+ * in place by the crypto workers and finally they are sent in order.
+ */
+static bool SC_Chunks_TreatSendMsgChunksWithWorkers(uint32_t scConnectionIdx,
+                                                    SOPC_SecureConnection* scConnection,
+                                                    uint32_t requestIdOrHandle,
+                                                    SOPC_Msg_Type sendMsgType,
+                                                    SOPC_Buffer* inputMsgBuffer,
+                                                    uint32_t nb_chunks,
+                                                    SOPC_StatusCode* errorStatus,
+                                                    const char** errorReason)
+{
+    SOPC_ASSERT(nb_chunks > 1);
+    SOPC_ASSERT(SOPC_MSG_TYPE_SC_MSG == sendMsgType);
+
+    const uint32_t windowLength = nb_chunks < SOPC_SC_CRYPTO_CHUNKS_WINDOW ? nb_chunks : SOPC_SC_CRYPTO_CHUNKS_WINDOW;
+    SOPC_CryptoProvider_SymmetricJob* jobs = SOPC_Calloc(windowLength, sizeof(*jobs));
+    SOPC_Buffer** chunkBuffers = SOPC_Calloc(windowLength, sizeof(*chunkBuffers));
+    bool result = (NULL != jobs && NULL != chunkBuffers);
+    if (!result)
+    {
+        *errorStatus = OpcUa_BadOutOfMemory;
+        *errorReason = "Internal error when allocating chunks to sign and encrypt";
+    }
+
+    uint32_t nb_chunks_sent = 0;
+    while (result && nb_chunks_sent < nb_chunks)
+    {
+        const uint32_t nbWindowChunks =
+            nb_chunks - nb_chunks_sent < windowLength ? nb_chunks - nb_chunks_sent : windowLength;
+        const uint32_t lastSNsent = scConnection->tcpSeqProperties.lastSNsent;
+        const uint32_t clientNextReqId = scConnection->clientNextReqId;
+        uint32_t requestId = 0;
+
+        /* ENCODE THE CHUNKS OF THE WINDOW */
+        for (uint32_t i = 0; result && i < nbWindowChunks; i++)
+        {
+            SOPC_Buffer* inputChunkBuffer = NULL;
+            result = SC_Chunks_NextOutputChunkBuffer(scConnection, inputMsgBuffer, &inputChunkBuffer, errorStatus,
+                                                     errorReason);
+            if (result)
+            {
+                result = SC_Chunks_TreatSendBufferMSGCLO(
+                    scConnectionIdx, scConnection, requestIdOrHandle, sendMsgType,
+                    SC_Chunks_IsNextChunkIntermediateOrFinal(nb_chunks, nb_chunks_sent + i), &inputChunkBuffer,
+                    &chunkBuffers[i], errorStatus, &jobs[i], &requestId);
+            }
+            // Note: input chunk buffer is NULL when forwarded as the output buffer
+            SOPC_Buffer_Delete(inputChunkBuffer);
+        }
+
+        /* SIGN AND ENCRYPT THE CHUNKS OF THE WINDOW */
+        if (result)
+        {
+            SOPC_ReturnStatus status = SOPC_ChunksCryptoWorkers_SignEncrypt(jobs, nbWindowChunks);
+            if (SOPC_STATUS_OK != status)
+            {
+                result = false;
+                *errorStatus = OpcUa_BadEncodingError;
+
+                SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                       "ChunksMgr: treat send buffer: signing or encrypting chunks failed : "
+                                       "(scIdx=%" PRIu32 ", scCfgIdx=%" PRIu32 ", status=%d)",
+                                       scConnectionIdx, scConnection->secureChannelConfigIdx, status);
+            }
+        }
+
+        /* RECORD REQUEST CONTEXT (CLIENT ONLY) */
+        if (result && !scConnection->isServerConnection && nb_chunks_sent + nbWindowChunks == nb_chunks)
+        {
+            result = SC_Chunks_CreateClientSentRequestContext(scConnectionIdx, scConnection, requestIdOrHandle,
+                                                              sendMsgType, requestId, errorStatus);
+        }
+
+        /* SEND THE CHUNKS OF THE WINDOW IN ORDER */
+        for (uint32_t i = 0; i < nbWindowChunks; i++)
+        {
+            if (result)
+            {
+                // Require write of output buffer on socket
+                SOPC_Sockets_EnqueueEvent(SOCKET_WRITE, scConnection->socketIndex, (uintptr_t) chunkBuffers[i], 0);
+            }
+            else
+            {
+                // Deallocate output buffer since not transmitted to socket layer
+                SOPC_Buffer_Delete(chunkBuffers[i]);
+            }
+            chunkBuffers[i] = NULL;
+        }
+
+        if (!result)
+        {
+            // None of the chunks of the window was sent: sequence numbers are reused by the abort chunk.
+            // On client side, the final chunk encoding generated the next requestId: the abort chunk shall use
+            // the requestId of the chunks already sent.
+            scConnection->tcpSeqProperties.lastSNsent = lastSNsent;
+            scConnection->clientNextReqId = clientNextReqId;
+        }
+
+        nb_chunks_sent += nbWindowChunks;
+    }
+
+    SOPC_Free(jobs);
+    SOPC_Free(chunkBuffers);
+
+    return result;
+}
+
 static bool SC_Chunks_TreatSendMessageBuffer(
     uint32_t scConnectionIdx,
     SOPC_SecureConnection* scConnection,
@@ -4340,6 +4523,8 @@ static bool SC_Chunks_TreatSendMessageBuffer(
         // MSG (/CLO) case (symmetric case)
 
         const char* errorReason = NULL;
+        SOPC_SecureChannel_Config* scConfig = SOPC_Toolkit_GetSecureChannelConfig(scConnection);
+        SOPC_ASSERT(scConfig != NULL); // Even on server side guaranteed by the secure connection state manager
 
         /* Part 6 (1.03): §6.7.3 MessageChunks and error handling:
          * If an error occurs creating a MessageChunk then the sender shall [...]
@@ -4375,6 +4560,14 @@ static bool SC_Chunks_TreatSendMessageBuffer(
                 // Deallocation of input buffer transfered to chunks buffer
                 inputMsgBuffer = NULL;
             }
+            else if (SC_Chunks_IsMsgSigned(scConfig->msgSecurityMode))
+            {
+                // Symmetric operations on chunks are independent: they are shared with the crypto workers
+                result = SC_Chunks_TreatSendMsgChunksWithWorkers(scConnectionIdx, scConnection, requestIdOrHandle,
+                                                                 sendMsgType, inputMsgBuffer, nb_chunks, errorStatus,
+                                                                 &errorReason);
+                nb_chunks_sent = nb_chunks;
+            }
             else
             {
                 SOPC_ASSERT(!isOPN);
@@ -4388,7 +4581,7 @@ static bool SC_Chunks_TreatSendMessageBuffer(
             result =
                 SC_Chunks_TreatSendBufferMSGCLO(scConnectionIdx, scConnection, requestIdOrHandle, sendMsgType,
                                                 SC_Chunks_IsNextChunkIntermediateOrFinal(nb_chunks, nb_chunks_sent),
-                                                &inputChunkBuffer, &outputChunkBuffer, errorStatus);
+                                                &inputChunkBuffer, &outputChunkBuffer, errorStatus, NULL, NULL);
 
             if (result)
             {
@@ -4433,7 +4626,7 @@ static bool SC_Chunks_TreatSendMessageBuffer(
                                          SOPC_StatusCode_ToTcpErrorCode(*errorStatus), errorReason);
                 result = SC_Chunks_TreatSendBufferMSGCLO(scConnectionIdx, scConnection, requestIdOrHandle, sendMsgType,
                                                          SOPC_UA_ABORT_FINAL_CHUNK, &inputMsgBuffer, &outputChunkBuffer,
-                                                         errorStatus);
+                                                         errorStatus, NULL, NULL);
             }
 
             if (result)
@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include "sopc_assert.h"
+#include "sopc_chunks_crypto_workers.h"
 #include "sopc_macros.h"
 #include "sopc_secure_channels_internal_ctx.h"
 #include "sopc_sockets_api.h"
@@ -62,6 +63,10 @@ void SOPC_SecureChannelsInternalContext_Initialize(SOPC_SetListenerFunc* setSock
     SOPC_ASSERT(secureChannelsTimerEventHandler != NULL);
 
     setSocketsListener(secureChannelsSocketsEventHandler);
+
+    // Note: crypto worker threads are only created when a first signed multi-chunk message is sent
+    SOPC_ReturnStatus status = SOPC_ChunksCryptoWorkers_Initialize();
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
 }
 
 SOPC_SecureConnection* SC_GetConnection(uint32_t connectionIdx)
@@ -84,6 +89,8 @@ void SOPC_SecureChannelsInternalContext_Clear(void)
     secureChannelsEventHandler = NULL;
     SOPC_Looper_Delete(secureChannelsLooper);
     secureChannelsLooper = NULL;
+    // Secure_Channels thread is stopped: crypto workers are not used anymore
+    SOPC_ChunksCryptoWorkers_Clear();
 }
 
 const SOPC_CertificateList* SC_OwnCertificate(SOPC_SecureConnection* conn)
@@ -31,6 +31,7 @@
 #include "address_space_impl.h"
 #include "app_cb_call_context_internal.h"
 #include "b2c.h"
+#include "call_method_async_impl.h"
 #include "opcua_identifiers.h"
 #include "sopc_address_space_access_internal.h"
 #include "sopc_address_space_utils_internal.h"
@@ -42,8 +43,10 @@
 #include "sopc_mem_alloc.h"
 #include "sopc_numeric_range.h"
 #include "sopc_service_call_context.h"
+#include "sopc_time.h"
 #include "sopc_toolkit_config_internal.h"
 #include "sopc_user_manager.h"
+#include "subscription_core_impl.h"
 #include "util_b2c.h"
 #include "util_variant.h"
 
@@ -66,6 +69,112 @@ void SOPC_AddressSpace_Check_Configured(void)
     }
 }
 
+static OpcUa_WriteValue* new_value_write_value(const SOPC_NodeId* nodeId)
+{
+    OpcUa_WriteValue* wv = SOPC_Calloc(1, sizeof(*wv));
+    if (NULL == wv)
+    {
+        return NULL;
+    }
+    OpcUa_WriteValue_Initialize(wv);
+    wv->AttributeId = SOPC_AttributeId_Value;
+    SOPC_ReturnStatus status = SOPC_NodeId_Copy(&wv->NodeId, nodeId);
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Free(wv);
+        wv = NULL;
+    }
+    return wv;
+}
+
+static void delete_write_value(OpcUa_WriteValue** wv)
+{
+    if (NULL != *wv)
+    {
+        OpcUa_WriteValue_Clear(*wv);
+        SOPC_Free(*wv);
+        *wv = NULL;
+    }
+}
+
+bool SOPC_AddressSpace_UpdateValue(SOPC_AddressSpace_Node* node,
+                                   SOPC_DataValue* value,
+                                   OpcUa_WriteValue** prevWV,
+                                   OpcUa_WriteValue** newWV)
+{
+    SOPC_ASSERT(NULL != address_space_bs__nodes);
+    SOPC_ASSERT(NULL != node);
+    SOPC_ASSERT(NULL != value);
+    SOPC_ASSERT(NULL != prevWV);
+    SOPC_ASSERT(NULL != newWV);
+    *prevWV = NULL;
+    *newWV = NULL;
+
+    OpcUa_NodeClass* nodeClass = SOPC_AddressSpace_Get_NodeClass(address_space_bs__nodes, node);
+    if (OpcUa_NodeClass_Variable != *nodeClass)
+    {
+        SOPC_DataValue_Clear(value);
+        return false;
+    }
+
+    const SOPC_NodeId* nodeId = SOPC_AddressSpace_Get_NodeId(address_space_bs__nodes, node);
+    SOPC_Variant* currentValue = SOPC_AddressSpace_Get_Value(address_space_bs__nodes, node);
+
+    // Notifications are only generated if the node is monitored and the write values could be allocated
+    if (SOPC_SubscriptionCore_HasMonitoredItems(nodeId))
+    {
+        *prevWV = new_value_write_value(nodeId);
+        *newWV = new_value_write_value(nodeId);
+        if (NULL == *prevWV || NULL == *newWV)
+        {
+            delete_write_value(prevWV);
+            delete_write_value(newWV);
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                   "SOPC_AddressSpace_UpdateValue: value updated without data change notification"
+                                   " (out of memory)");
+        }
+    }
+
+    if (NULL != *prevWV)
+    {
+        SOPC_Value_Timestamp prevSourceTs = SOPC_AddressSpace_Get_SourceTs(address_space_bs__nodes, node);
+        (*prevWV)->Value.Status = SOPC_AddressSpace_Get_StatusCode(address_space_bs__nodes, node);
+        (*prevWV)->Value.SourceTimestamp = prevSourceTs.timestamp;
+        (*prevWV)->Value.SourcePicoSeconds = prevSourceTs.picoSeconds;
+        SOPC_Variant_Move(&(*prevWV)->Value.Value, currentValue);
+    }
+    else
+    {
+        SOPC_Variant_Clear(currentValue);
+    }
+    SOPC_Variant_Move(currentValue, &value->Value);
+
+    SOPC_Value_Timestamp newSourceTs = {value->SourceTimestamp, value->SourcePicoSeconds};
+    // If both defined to 0, set current time as source
+    if (0 == newSourceTs.timestamp && 0 == newSourceTs.picoSeconds)
+    {
+        newSourceTs.timestamp = SOPC_Time_GetCurrentTimeUTC();
+    }
+    // Note: status and source timestamp are not stored when nodes are constant read only nodes
+    bool res = SOPC_AddressSpace_Set_StatusCode(address_space_bs__nodes, node, value->Status);
+    SOPC_UNUSED_RESULT(res);
+    res = SOPC_AddressSpace_Set_SourceTs(address_space_bs__nodes, node, newSourceTs);
+    SOPC_UNUSED_RESULT(res);
+    SOPC_DataValue_Clear(value);
+
+    if (NULL != *newWV)
+    {
+        SOPC_Value_Timestamp sourceTs = SOPC_AddressSpace_Get_SourceTs(address_space_bs__nodes, node);
+        (*newWV)->Value.Status = SOPC_AddressSpace_Get_StatusCode(address_space_bs__nodes, node);
+        (*newWV)->Value.SourceTimestamp = sourceTs.timestamp;
+        (*newWV)->Value.SourcePicoSeconds = sourceTs.picoSeconds;
+        // The node keeps the ownership of the value: the data change treatment copies what it keeps
+        SOPC_ReturnStatus status = SOPC_Variant_ShallowCopy(&(*newWV)->Value.Value, currentValue);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
+    return true;
+}
+
 /*------------------------
    INITIALISATION Clause
   ------------------------*/
@@ -161,8 +270,8 @@ void address_space_bs__exec_callMethod(const constants__t_endpoint_config_idx_i
         *address_space_bs__p_rawStatusCode = OpcUa_BadOutOfMemory;
         return;
     }
-    *address_space_bs__p_rawStatusCode =
-        method_c->pMethodFunc(cc, objectId, nbInputArgs, inputArgs, &noOfOutput, &outputArgs, method_c->pParam);
+    *address_space_bs__p_rawStatusCode = SOPC_MethodCallAsync_EndCall(
+        method_c->pMethodFunc(cc, objectId, nbInputArgs, inputArgs, &noOfOutput, &outputArgs, method_c->pParam));
     generate_changes_notifs_after_method_call(SOPC_AddressSpaceAccess_GetOperations(cc->addressSpaceForMethodCall));
     SOPC_AddressSpaceAccess_Delete(&cc->addressSpaceForMethodCall);
     SOPC_CallContext_Free(cc);
@@ -177,6 +286,13 @@ void address_space_bs__exec_callMethod(const constants__t_endpoint_config_idx_i
         *address_space_bs__p_rawStatusCode = OpcUa_BadNotImplemented;
         return;
     }
+    if (OpcUa_GoodCompletesAsynchronously == *address_space_bs__p_rawStatusCode && 0 != noOfOutput)
+    {
+        // Output arguments are provided on completion of the method
+        int32_t nbElts = (int32_t) noOfOutput;
+        SOPC_Clear_Array(&nbElts, (void**) &outputArgs, sizeof(SOPC_Variant), SOPC_Variant_ClearAux);
+        noOfOutput = 0;
+    }
     if (noOfOutput > INT32_MAX)
     {
         noOfOutput = INT32_MAX;
@@ -39,4 +39,21 @@ extern bool sopc_addressSpace_configured;
 
 void SOPC_AddressSpace_Check_Configured(void);
 
+/**
+ * \brief Updates the Value attribute of a Variable node of the server AddressSpace (services thread only).
+ *
+ * \param node         the Variable node to update
+ * \param value        the new value, its content is moved into the node
+ * \param[out] prevWV  set with the previous value of the node,
+ *                     NULL if the node is not monitored or if allocation failed
+ * \param[out] newWV   set with a shallow copy of the new value of the node which shall only be used until the next
+ *                     update of the node value, NULL if the node is not monitored or if allocation failed
+ *
+ * \return true if the value was updated, false if the node is not a Variable (\p value is then cleared)
+ */
+bool SOPC_AddressSpace_UpdateValue(SOPC_AddressSpace_Node* node,
+                                   SOPC_DataValue* value,
+                                   OpcUa_WriteValue** prevWV,
+                                   OpcUa_WriteValue** newWV);
+
 #endif /* ADDRESS_SPACE_IMPL_H_ */
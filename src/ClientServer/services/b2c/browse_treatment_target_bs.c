@@ -0,0 +1,65 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "browse_treatment_target_bs.h"
+
+#include <stddef.h>
+
+#include "address_space_impl.h"
+#include "sopc_address_space_index_internal.h"
+
+/*------------------------
+   INITIALISATION Clause
+  ------------------------*/
+void browse_treatment_target_bs__INITIALISATION(void) {}
+
+/*--------------------
+   OPERATIONS Clause
+  --------------------*/
+void browse_treatment_target_bs__get_next_reference_index(
+    const constants__t_Node_i browse_treatment_target_bs__p_node,
+    const t_entier4 browse_treatment_target_bs__p_fromIndex,
+    const constants__t_BrowseDirection_i browse_treatment_target_bs__p_browseDirection,
+    const t_bool browse_treatment_target_bs__p_refType_defined,
+    const constants__t_NodeId_i browse_treatment_target_bs__p_referenceType,
+    const t_bool browse_treatment_target_bs__p_includeSubtypes,
+    t_entier4* const browse_treatment_target_bs__p_refIndex)
+{
+    // All the references are iterated and filtered by the browse treatment if the node is not indexed
+    *browse_treatment_target_bs__p_refIndex = browse_treatment_target_bs__p_fromIndex;
+
+    SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(address_space_bs__nodes);
+    if (!browse_treatment_target_bs__p_refType_defined || NULL == index)
+    {
+        return;
+    }
+
+    // Indexes start from 1 in the B model
+    int32_t nextRefIndex = 0;
+    SOPC_ReturnStatus status = SOPC_AddressSpaceIndex_GetNextReference(
+        index, browse_treatment_target_bs__p_node, browse_treatment_target_bs__p_referenceType,
+        browse_treatment_target_bs__p_includeSubtypes,
+        constants__e_bd_inverse != browse_treatment_target_bs__p_browseDirection,
+        constants__e_bd_forward != browse_treatment_target_bs__p_browseDirection,
+        browse_treatment_target_bs__p_fromIndex - 1, &nextRefIndex);
+    if (SOPC_STATUS_OK == status)
+    {
+        *browse_treatment_target_bs__p_refIndex = nextRefIndex + 1;
+    }
+}
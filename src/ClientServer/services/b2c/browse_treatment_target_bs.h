@@ -0,0 +1,55 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/** \file
+ *
+ * Hand-written _bs.h: the browse references filter based on the AddressSpace references index
+ */
+
+#ifndef BROWSE_TREATMENT_TARGET_BS_H_
+#define BROWSE_TREATMENT_TARGET_BS_H_
+
+/*--------------------------
+   Added by the Translator
+  --------------------------*/
+#include "b2c.h"
+
+/*--------------
+   SEES Clause
+  --------------*/
+#include "address_space_itf.h"
+#include "constants.h"
+
+/*------------------------
+   INITIALISATION Clause
+  ------------------------*/
+extern void browse_treatment_target_bs__INITIALISATION(void);
+
+/*--------------------
+   OPERATIONS Clause
+  --------------------*/
+extern void browse_treatment_target_bs__get_next_reference_index(
+    const constants__t_Node_i browse_treatment_target_bs__p_node,
+    const t_entier4 browse_treatment_target_bs__p_fromIndex,
+    const constants__t_BrowseDirection_i browse_treatment_target_bs__p_browseDirection,
+    const t_bool browse_treatment_target_bs__p_refType_defined,
+    const constants__t_NodeId_i browse_treatment_target_bs__p_referenceType,
+    const t_bool browse_treatment_target_bs__p_includeSubtypes,
+    t_entier4* const browse_treatment_target_bs__p_refIndex);
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+
+#include "call_method_async_impl.h"
+
+#include "app_cb_call_context_internal.h"
+#include "opcua_statuscodes.h"
+#include "sopc_assert.h"
+#include "sopc_encodeable.h"
+#include "sopc_logger.h"
+#include "sopc_macros.h"
+#include "sopc_mem_alloc.h"
+#include "sopc_services_api.h"
+#include "sopc_services_api_internal.h"
+#include "sopc_singly_linked_list.h"
+
+struct SOPC_MethodCallCompletion
+{
+    uint32_t responseId; // 0 if the result shall be discarded
+    int32_t resultIndex;
+
+    // Method results set by the application
+    SOPC_StatusCode status;
+    uint32_t nbOutputArgs;
+    SOPC_Variant* outputArgs;
+};
+
+typedef struct SOPC_MethodCallAsync_Response
+{
+    uint32_t id;
+    OpcUa_CallResponse* response;
+    uint32_t nbPending; // Number of deferred results not completed yet
+    bool kept;          // The response is not sent by the request treatment
+    uint32_t sessionId;
+    uint32_t reqHandle;
+    uint32_t reqContext;
+} SOPC_MethodCallAsync_Response;
+
+/* Responses waiting for deferred results: id => SOPC_MethodCallAsync_Response* */
+static SOPC_SLinkedList* pendingResponses = NULL;
+static uint32_t lastResponseId = 0;
+
+/* Response of the Call request being treated, only set if one of its methods was deferred */
+static SOPC_MethodCallAsync_Response* treatedResponse = NULL;
+/* Completion deferred by the method being executed */
+static SOPC_MethodCallCompletion* deferredCompletion = NULL;
+
+static void SOPC_MethodCallAsync_ClearOutputArgs(uint32_t nbOutputArgs, SOPC_Variant* outputArgs)
+{
+    int32_t nbElts = (int32_t) nbOutputArgs;
+    SOPC_Clear_Array(&nbElts, (void**) &outputArgs, sizeof(SOPC_Variant), SOPC_Variant_ClearAux);
+}
+
+static void SOPC_MethodCallAsync_DeleteResponse(SOPC_MethodCallAsync_Response* pending)
+{
+    if (NULL != pending)
+    {
+        if (pending->kept)
+        {
+            // The response is not owned by the services anymore
+            SOPC_ReturnStatus status =
+                SOPC_Encodeable_Delete(&OpcUa_CallResponse_EncodeableType, (void**) &pending->response);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+        }
+        SOPC_Free(pending);
+    }
+}
+
+SOPC_MethodCallCompletion* SOPC_MethodCall_Defer(const SOPC_CallContext* callContextPtr)
+{
+    // Only the method being executed by the services thread has an address space access
+    if (NULL == callContextPtr || NULL == callContextPtr->addressSpaceForMethodCall || NULL != deferredCompletion)
+    {
+        return NULL;
+    }
+    deferredCompletion = SOPC_Calloc(1, sizeof(*deferredCompletion));
+    return deferredCompletion;
+}
+
+SOPC_ReturnStatus SOPC_MethodCall_Complete(SOPC_MethodCallCompletion* completion,
+                                           SOPC_StatusCode status,
+                                           uint32_t nbOutputArgs,
+                                           SOPC_Variant* outputArgs)
+{
+    if (NULL == completion || nbOutputArgs > INT32_MAX || (0 != nbOutputArgs && NULL == outputArgs))
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    completion->status = status;
+    completion->nbOutputArgs = nbOutputArgs;
+    completion->outputArgs = outputArgs;
+    SOPC_Services_EnqueueEvent(APP_TO_SE_COMPLETE_METHOD_CALL, 0, (uintptr_t) completion, 0);
+    return SOPC_STATUS_OK;
+}
+
+SOPC_StatusCode SOPC_MethodCallAsync_EndCall(SOPC_StatusCode methodStatus)
+{
+    if (OpcUa_GoodCompletesAsynchronously == methodStatus)
+    {
+        if (NULL == deferredCompletion)
+        {
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                   "MethodCall: method returned GoodCompletesAsynchronously without deferring its "
+                                   "completion");
+            return OpcUa_BadInternalError;
+        }
+    }
+    else if (NULL != deferredCompletion)
+    {
+        // Method result already provided: the completion will be ignored
+        SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                 "MethodCall: method deferred its completion but returned status 0x%08" PRIX32,
+                                 methodStatus);
+        deferredCompletion->responseId = 0;
+        deferredCompletion = NULL;
+    }
+    return methodStatus;
+}
+
+void SOPC_MethodCallAsync_BindResult(OpcUa_CallResponse* response, int32_t resultIndex)
+{
+    SOPC_ASSERT(NULL != response);
+    SOPC_ASSERT(NULL != deferredCompletion); // ensured by SOPC_MethodCallAsync_EndCall
+
+    SOPC_MethodCallCompletion* completion = deferredCompletion;
+    deferredCompletion = NULL;
+    completion->responseId = 0;
+    completion->resultIndex = resultIndex;
+
+    if (NULL == pendingResponses)
+    {
+        pendingResponses = SOPC_SLinkedList_Create(0);
+    }
+    // Only one Call request is treated at a time and its response is kept or not at the end of the treatment
+    SOPC_ASSERT(NULL == treatedResponse || treatedResponse->response == response);
+    if (NULL == treatedResponse && NULL != pendingResponses)
+    {
+        treatedResponse = SOPC_Calloc(1, sizeof(*treatedResponse));
+        if (NULL != treatedResponse)
+        {
+            lastResponseId = (UINT32_MAX == lastResponseId ? 1 : lastResponseId + 1);
+            treatedResponse->id = lastResponseId;
+            treatedResponse->response = response;
+            if (0 == SOPC_SLinkedList_Append(pendingResponses, treatedResponse->id, (uintptr_t) treatedResponse))
+            {
+                SOPC_Free(treatedResponse);
+                treatedResponse = NULL;
+            }
+        }
+    }
+    if (NULL != treatedResponse)
+    {
+        completion->responseId = treatedResponse->id;
+        treatedResponse->nbPending++;
+    }
+    else
+    {
+        // Result discarded: the method completion will be ignored
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "MethodCall: out of memory, deferred method result %" PRIi32 " is discarded",
+                               resultIndex);
+        response->Results[resultIndex].StatusCode = OpcUa_BadOutOfMemory;
+    }
+}
+
+bool SOPC_MethodCallAsync_KeepResponse(OpcUa_CallResponse* response,
+                                       uint32_t sessionId,
+                                       uint32_t reqHandle,
+                                       uint32_t reqContext,
+                                       bool treatmentOk)
+{
+    if (NULL == treatedResponse || treatedResponse->response != response)
+    {
+        return false;
+    }
+    SOPC_MethodCallAsync_Response* pending = treatedResponse;
+    treatedResponse = NULL;
+    if (!treatmentOk)
+    {
+        // The response is sent as a service fault: completions will be ignored
+        SOPC_SLinkedList_RemoveFromId(pendingResponses, pending->id);
+        SOPC_MethodCallAsync_DeleteResponse(pending);
+        return false;
+    }
+    pending->kept = true;
+    pending->sessionId = sessionId;
+    pending->reqHandle = reqHandle;
+    pending->reqContext = reqContext;
+    return true;
+}
+
+bool SOPC_MethodCallAsync_TreatCompletion(SOPC_MethodCallCompletion* completion,
+                                          uint32_t* sessionId,
+                                          SOPC_Internal_AsyncSendMsgData* msgData)
+{
+    SOPC_ASSERT(NULL != completion);
+    SOPC_ASSERT(NULL != sessionId);
+    SOPC_ASSERT(NULL != msgData);
+    SOPC_MethodCallAsync_Response* pending = NULL;
+    if (0 != completion->responseId && NULL != pendingResponses)
+    {
+        pending = (SOPC_MethodCallAsync_Response*) SOPC_SLinkedList_FindFromId(pendingResponses,
+                                                                                 completion->responseId);
+    }
+    if (NULL == pending)
+    {
+        SOPC_MethodCallAsync_ClearOutputArgs(completion->nbOutputArgs, completion->outputArgs);
+        SOPC_Free(completion);
+        return false;
+    }
+
+    OpcUa_CallMethodResult* result = &pending->response->Results[completion->resultIndex];
+    result->StatusCode = completion->status;
+    if (SOPC_IsGoodStatus(completion->status))
+    {
+        result->NoOfOutputArguments = (int32_t) completion->nbOutputArgs;
+        result->OutputArguments = completion->outputArgs;
+    }
+    else
+    {
+        SOPC_MethodCallAsync_ClearOutputArgs(completion->nbOutputArgs, completion->outputArgs);
+    }
+    SOPC_Free(completion);
+
+    SOPC_ASSERT(pending->nbPending > 0);
+    pending->nbPending--;
+    if (0 != pending->nbPending || !pending->kept)
+    {
+        return false;
+    }
+
+    // Last deferred result: the response shall be sent, it is not owned by the pending responses anymore
+    SOPC_SLinkedList_RemoveFromId(pendingResponses, pending->id);
+    *sessionId = pending->sessionId;
+    msgData->msgToSend = pending->response;
+    msgData->requestHandle = pending->reqHandle;
+    msgData->requestId = pending->reqContext;
+    SOPC_Free(pending);
+    return true;
+}
+
+void SOPC_MethodCallAsync_SessionClosed(uint32_t sessionId)
+{
+    bool removed = (NULL != pendingResponses);
+    while (removed)
+    {
+        removed = false;
+        SOPC_SLinkedListIterator it = SOPC_SLinkedList_GetIterator(pendingResponses);
+        while (!removed && SOPC_SLinkedList_HasNext(&it))
+        {
+            SOPC_MethodCallAsync_Response* pending = (SOPC_MethodCallAsync_Response*) SOPC_SLinkedList_Next(&it);
+            if (pending->kept && pending->sessionId == sessionId)
+            {
+                // The completions of the response will be ignored since it cannot be found anymore
+                SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_CLIENTSERVER,
+                                         "MethodCall: session=%" PRIu32
+                                         " closed, Call response with %" PRIu32 " deferred method results discarded",
+                                         sessionId, pending->nbPending);
+                SOPC_SLinkedList_RemoveFromId(pendingResponses, pending->id);
+                SOPC_MethodCallAsync_DeleteResponse(pending);
+                removed = true;
+            }
+        }
+    }
+}
+
+static void SOPC_MethodCallAsync_DeleteResponseElt(uint32_t id, uintptr_t val)
+{
+    SOPC_UNUSED_ARG(id);
+    SOPC_MethodCallAsync_DeleteResponse((SOPC_MethodCallAsync_Response*) val);
+}
+
+void SOPC_MethodCallAsync_Clear(void)
+{
+    if (NULL != pendingResponses)
+    {
+        SOPC_SLinkedList_Apply(pendingResponses, SOPC_MethodCallAsync_DeleteResponseElt);
+        SOPC_SLinkedList_Delete(pendingResponses);
+        pendingResponses = NULL;
+    }
+    treatedResponse = NULL;
+    // Completion deferred by a method which call did not end, it is not known by the application
+    SOPC_Free(deferredCompletion);
+    deferredCompletion = NULL;
+}
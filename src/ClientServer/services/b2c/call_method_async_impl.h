@@ -0,0 +1,97 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Manages the method calls completed asynchronously by the application (see ::SOPC_MethodCall_Defer).
+ *
+ * The deferred method results are kept in the Call response until all the deferred methods of the request are
+ * completed, the response is then sent asynchronously. All functions shall be called by the services thread.
+ */
+
+#ifndef CALL_METHOD_ASYNC_IMPL_H_
+#define CALL_METHOD_ASYNC_IMPL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sopc_call_method_manager.h"
+#include "sopc_services_api_internal.h"
+#include "sopc_types.h"
+
+/**
+ * \brief Checks the status returned by a method function after its call
+ *
+ * \return the status to write in the method result: the method status, or OpcUa_BadInternalError if the method
+ *         returned OpcUa_GoodCompletesAsynchronously without deferring its completion.
+ *         When OpcUa_GoodCompletesAsynchronously is returned, ::SOPC_MethodCallAsync_BindResult shall be called.
+ */
+SOPC_StatusCode SOPC_MethodCallAsync_EndCall(SOPC_StatusCode methodStatus);
+
+/**
+ * \brief Binds the method deferred by the last call to its result index in the Call response
+ */
+void SOPC_MethodCallAsync_BindResult(OpcUa_CallResponse* response, int32_t resultIndex);
+
+/**
+ * \brief Keeps the Call response if it contains deferred results
+ *
+ * \param response     the Call response which has just been treated
+ * \param sessionId    the session of the request
+ * \param reqHandle    the request handle
+ * \param reqContext   the request context (request id)
+ * \param treatmentOk  true if the request treatment succeeded, otherwise the response is not kept
+ *
+ * \return true if the response is kept and will be sent asynchronously, false if it shall be sent immediately
+ */
+bool SOPC_MethodCallAsync_KeepResponse(OpcUa_CallResponse* response,
+                                       uint32_t sessionId,
+                                       uint32_t reqHandle,
+                                       uint32_t reqContext,
+                                       bool treatmentOk);
+
+/**
+ * \brief Writes the result of a completed method in its response. The completion is deallocated.
+ *
+ * \param completion      the completion provided by ::SOPC_MethodCall_Complete
+ * \param[out] sessionId  the session of the request when the response shall be sent
+ * \param[out] msgData    the response and its request handle and context when the response shall be sent
+ *
+ * \return true if it was the last deferred method of the response: the response shall then be sent and
+ *         is not owned by the pending responses anymore
+ */
+bool SOPC_MethodCallAsync_TreatCompletion(SOPC_MethodCallCompletion* completion,
+                                          uint32_t* sessionId,
+                                          SOPC_Internal_AsyncSendMsgData* msgData);
+
+/**
+ * \brief Discards the responses waiting for deferred methods of a closed session.
+ *        The completions of those methods are ignored: their response is not sent to a new session
+ *        with the same session id.
+ *
+ * \param sessionId  the closed session
+ */
+void SOPC_MethodCallAsync_SessionClosed(uint32_t sessionId);
+
+/**
+ * \brief Deallocates the responses waiting for deferred methods
+ */
+void SOPC_MethodCallAsync_Clear(void);
+
+#endif /* CALL_METHOD_ASYNC_IMPL_H_ */
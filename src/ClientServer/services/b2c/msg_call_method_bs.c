@@ -17,7 +17,9 @@
  * under the License.
  */
 
+#include "call_method_async_impl.h"
 #include "msg_call_method_bs.h"
+#include "opcua_statuscodes.h"
 #include "sopc_assert.h"
 #include "sopc_mem_alloc.h"
 #include "util_b2c.h"
@@ -252,4 +254,9 @@ void msg_call_method_bs__write_CallMethod_Res_Status(const constants__t_msg_i ms
         msg_call_method_bs__getCallResult(msg_call_method_bs__p_res_msg, msg_call_method_bs__callMethod);
 
     result->StatusCode = msg_call_method_bs__rawStatusCode;
+    if (OpcUa_GoodCompletesAsynchronously == msg_call_method_bs__rawStatusCode)
+    {
+        SOPC_MethodCallAsync_BindResult(msg_call_method_bs__getCallResponse(msg_call_method_bs__p_res_msg),
+                                        msg_call_method_bs__callMethod - 1);
+    }
 }
@@ -21,40 +21,124 @@
    Exported Declarations
   ------------------------*/
 #include "request_handle_bs.h"
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "sopc_event_timer_manager.h"
+#include "sopc_logger.h"
+#include "sopc_mem_alloc.h"
 #include "sopc_services_api.h"
 
+/* Number of request handles allocated on first request, the table size is then doubled each time all the request
+ * handles are used until SOPC_MAX_PENDING_REQUESTS is reached */
+#define INITIAL_NB_REQUEST_HANDLES 32
+
 typedef struct
 {
     constants__t_msg_type_i request;
     constants__t_msg_type_i response;
     constants__t_application_context_i appContext;
     bool hasAppContext;
+    constants__t_channel_i channel;
+    /* Next request handle in the free request handles list (only used when request handle is free) */
+    constants__t_client_request_handle_i nextFree;
 } SOPC_Internal_RequestContext;
 
-static uint32_t cpt = 0;
-static SOPC_Internal_RequestContext client_requests_context[SOPC_MAX_PENDING_REQUESTS + 1];
-static constants__t_channel_i client_requests_channel[SOPC_MAX_PENDING_REQUESTS + 1];
+/* Index 0 is never used since it is the indeterminate request handle in B model */
+static SOPC_Internal_RequestContext* client_requests_context = NULL;
+static uint32_t nb_client_requests_context = 0; // Number of request handles in client_requests_context
+/* Free request handles are reused in FIFO order to delay as much as possible the reuse of a request handle */
+static constants__t_client_request_handle_i first_free_req_handle = constants__c_client_request_handle_indet;
+static constants__t_client_request_handle_i last_free_req_handle = constants__c_client_request_handle_indet;
+
+static void push_free_req_handle(constants__t_client_request_handle_i req_handle)
+{
+    client_requests_context[req_handle].nextFree = constants__c_client_request_handle_indet;
+    if (constants__c_client_request_handle_indet == last_free_req_handle)
+    {
+        first_free_req_handle = req_handle;
+    }
+    else
+    {
+        client_requests_context[last_free_req_handle].nextFree = req_handle;
+    }
+    last_free_req_handle = req_handle;
+}
+
+static constants__t_client_request_handle_i pop_free_req_handle(void)
+{
+    constants__t_client_request_handle_i req_handle = first_free_req_handle;
+    if (constants__c_client_request_handle_indet != req_handle)
+    {
+        first_free_req_handle = client_requests_context[req_handle].nextFree;
+        if (constants__c_client_request_handle_indet == first_free_req_handle)
+        {
+            last_free_req_handle = constants__c_client_request_handle_indet;
+        }
+    }
+    return req_handle;
+}
+
+/* Extends the request handles table and adds the new request handles to the free list */
+static bool grow_req_handles(void)
+{
+    if (nb_client_requests_context >= SOPC_MAX_PENDING_REQUESTS)
+    {
+        return false;
+    }
+    uint32_t nbContexts = (0 == nb_client_requests_context ? INITIAL_NB_REQUEST_HANDLES : 2 * nb_client_requests_context);
+    if (nbContexts > SOPC_MAX_PENDING_REQUESTS)
+    {
+        nbContexts = SOPC_MAX_PENDING_REQUESTS;
+    }
+    SOPC_Internal_RequestContext* contexts = SOPC_Calloc((size_t) nbContexts + 1, sizeof(*contexts));
+    if (NULL == contexts)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "request_handle_bs: failed to extend the pending requests table to %" PRIu32
+                               " requests",
+                               nbContexts);
+        return false;
+    }
+    if (NULL != client_requests_context)
+    {
+        memcpy(contexts, client_requests_context, ((size_t) nb_client_requests_context + 1) * sizeof(*contexts));
+        SOPC_Free(client_requests_context);
+    }
+    client_requests_context = contexts;
+    for (uint32_t req_handle = nb_client_requests_context + 1; req_handle <= nbContexts; req_handle++)
+    {
+        push_free_req_handle(req_handle);
+    }
+    nb_client_requests_context = nbContexts;
+    return true;
+}
 
 /*------------------------
    INITIALISATION Clause
   ------------------------*/
 void request_handle_bs__INITIALISATION(void)
 {
-    memset(client_requests_context, 0, (SOPC_MAX_PENDING_REQUESTS + 1) * sizeof(SOPC_Internal_RequestContext));
-    memset(client_requests_channel, constants__c_channel_indet,
-           (SOPC_MAX_PENDING_REQUESTS + 1) * sizeof(constants__t_channel_i));
+    // Request handles table is allocated on first request
+    client_requests_context = NULL;
+    nb_client_requests_context = 0;
+    first_free_req_handle = constants__c_client_request_handle_indet;
+    last_free_req_handle = constants__c_client_request_handle_indet;
 }
 
 /*--------------------
    OPERATIONS Clause
   --------------------*/
 
+void request_handle_bs__request_handle_bs_UNINITIALISATION(void)
+{
+    SOPC_Free(client_requests_context);
+    request_handle_bs__INITIALISATION();
+}
+
 void request_handle_bs__client_validate_response_request_handle(
     const constants__t_channel_i request_handle_bs__channel,
     const constants__t_client_request_handle_i request_handle_bs__req_handle,
@@ -66,7 +150,7 @@ void request_handle_bs__client_validate_response_request_handle(
     if (isvalid &&
         (client_requests_context[request_handle_bs__req_handle].response == request_handle_bs__resp_typ ||
          constants__e_msg_service_fault_resp == request_handle_bs__resp_typ) &&
-        client_requests_channel[request_handle_bs__req_handle] == request_handle_bs__channel)
+        client_requests_context[request_handle_bs__req_handle].channel == request_handle_bs__channel)
     {
         *request_handle_bs__ret = true;
     }
@@ -83,31 +167,19 @@ void request_handle_bs__client_fresh_req_handle(
     const constants__t_application_context_i request_handle_bs__app_context,
     constants__t_client_request_handle_i* const request_handle_bs__request_handle)
 {
-    uint32_t startedIdx = cpt;
-    uint8_t noHandleAvailable = false;
     *request_handle_bs__request_handle = constants__c_client_request_handle_indet;
     if (request_handle_bs__resp_typ != constants__c_msg_type_indet)
     {
-        while (false == noHandleAvailable &&
-               *request_handle_bs__request_handle == constants__c_client_request_handle_indet)
+        if (constants__c_client_request_handle_indet != first_free_req_handle || grow_req_handles())
         {
-            cpt = (uint16_t)((cpt + 1) % (SOPC_MAX_PENDING_REQUESTS + 1));
-            if (cpt == startedIdx)
-            {
-                // Note: startedIdx content is never tested (simplest implem)
-                noHandleAvailable = true;
-            }
-            else if (cpt != constants__c_client_request_handle_indet) // avoid 0 which is undetermined in B model
-            {
-                if (client_requests_context[cpt].response == constants__c_msg_type_indet)
-                {
-                    client_requests_context[cpt].request = request_handle_bs__req_typ;
-                    client_requests_context[cpt].response = request_handle_bs__resp_typ;
-                    client_requests_context[cpt].hasAppContext = request_handle_bs__is_applicative;
-                    client_requests_context[cpt].appContext = request_handle_bs__app_context;
-                    *request_handle_bs__request_handle = cpt;
-                }
-            }
+            constants__t_client_request_handle_i req_handle = pop_free_req_handle();
+            SOPC_Internal_RequestContext* context = &client_requests_context[req_handle];
+            context->request = request_handle_bs__req_typ;
+            context->response = request_handle_bs__resp_typ;
+            context->hasAppContext = request_handle_bs__is_applicative;
+            context->appContext = request_handle_bs__app_context;
+            context->channel = constants__c_channel_indet;
+            *request_handle_bs__request_handle = req_handle;
         }
     }
 }
@@ -115,7 +187,7 @@ void request_handle_bs__client_fresh_req_handle(
 void request_handle_bs__is_valid_req_handle(const constants__t_client_request_handle_i request_handle_bs__req_handle,
                                             t_bool* const request_handle_bs__ret)
 {
-    if (request_handle_bs__req_handle > 0 && request_handle_bs__req_handle <= SOPC_MAX_PENDING_REQUESTS)
+    if (request_handle_bs__req_handle > 0 && request_handle_bs__req_handle <= nb_client_requests_context)
     {
         *request_handle_bs__ret =
             client_requests_context[request_handle_bs__req_handle].response != constants__c_msg_type_indet;
@@ -156,15 +228,20 @@ void request_handle_bs__get_req_handle_channel(const constants__t_client_request
     request_handle_bs__is_valid_req_handle(request_handle_bs__req_handle, &isvalid);
     if (isvalid)
     {
-        *request_handle_bs__channel = client_requests_channel[request_handle_bs__req_handle];
+        *request_handle_bs__channel = client_requests_context[request_handle_bs__req_handle].channel;
     }
 }
 
 void request_handle_bs__client_remove_req_handle(
     const constants__t_client_request_handle_i request_handle_bs__req_handle)
 {
-    memset(&client_requests_context[request_handle_bs__req_handle], 0, sizeof(SOPC_Internal_RequestContext));
-    client_requests_channel[request_handle_bs__req_handle] = constants__c_channel_indet;
+    bool isvalid = false;
+    request_handle_bs__is_valid_req_handle(request_handle_bs__req_handle, &isvalid);
+    if (isvalid)
+    {
+        memset(&client_requests_context[request_handle_bs__req_handle], 0, sizeof(SOPC_Internal_RequestContext));
+        push_free_req_handle(request_handle_bs__req_handle);
+    }
 }
 
 void request_handle_bs__client_req_handle_to_request_id(
@@ -184,5 +261,5 @@ void request_handle_bs__client_request_id_to_req_handle(
 void request_handle_bs__set_req_handle_channel(const constants__t_client_request_handle_i request_handle_bs__req_handle,
                                                const constants__t_channel_i request_handle_bs__channel)
 {
-    client_requests_channel[request_handle_bs__req_handle] = request_handle_bs__channel;
+    client_requests_context[request_handle_bs__req_handle].channel = request_handle_bs__channel;
 }
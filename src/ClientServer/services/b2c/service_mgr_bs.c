@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "call_method_async_impl.h"
 #include "constants.h"
 #include "message_out_bs.h"
 #include "service_mgr_bs.h"
@@ -217,6 +218,7 @@ void service_mgr_bs__service_mgr_bs_UNINITIALISATION(void)
             discovery_reqs_to_send[idx] = NULL;
         }
     }
+    SOPC_MethodCallAsync_Clear();
 }
 
 void service_mgr_bs__send_channel_error_msg(const constants__t_channel_i service_mgr_bs__channel,
@@ -236,3 +238,16 @@ void service_mgr_bs__send_channel_msg_buffer(const constants__t_channel_i servic
     SOPC_SecureChannels_EnqueueEvent(SC_SERVICE_SND_MSG, service_mgr_bs__channel, (uintptr_t) service_mgr_bs__buffer,
                                      service_mgr_bs__request_context);
 }
+
+void service_mgr_bs__server_async_method_call_resp(
+    const constants__t_session_i service_mgr_bs__session,
+    const constants__t_server_request_handle_i service_mgr_bs__req_handle,
+    const constants__t_request_context_i service_mgr_bs__req_ctx,
+    const constants__t_msg_i service_mgr_bs__resp_msg,
+    const constants_statuscodes_bs__t_StatusCode_i service_mgr_bs__p_sc,
+    t_bool* const service_mgr_bs__bres)
+{
+    *service_mgr_bs__bres = SOPC_MethodCallAsync_KeepResponse(
+        (OpcUa_CallResponse*) service_mgr_bs__resp_msg, (uint32_t) service_mgr_bs__session, service_mgr_bs__req_handle,
+        service_mgr_bs__req_ctx, constants_statuscodes_bs__e_sc_ok == service_mgr_bs__p_sc);
+}
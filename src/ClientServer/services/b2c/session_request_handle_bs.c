@@ -22,39 +22,92 @@
   ------------------------*/
 #include "session_request_handle_bs.h"
 
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "sopc_assert.h"
+#include "sopc_logger.h"
+#include "sopc_mem_alloc.h"
+
+/* Number of request handles allocated on first request, the table size is then extended to contain the greatest
+ * request handle generated by request_handle_bs */
+#define INITIAL_NB_REQUEST_HANDLES 32
 
 /* Note: due to request handle generation on client side, request handle is unique regardless the session */
-/* Same size of array than request handles array */
-static constants__t_session_i client_requests[SOPC_MAX_PENDING_REQUESTS + 1];
+/* Request handle is the index of the array (index 0 is not used) */
+static constants__t_session_i* client_requests = NULL;
+static uint32_t nb_client_requests = 0; // Greatest request handle that can be stored in client_requests
 
 /* Store number of pending requests remaining for session */
 static uint32_t session_pending_requests_nb[SOPC_MAX_SESSIONS + 1];
 
+/* Extends the table to be able to store the given request handle */
+static bool grow_client_requests(constants__t_client_request_handle_i req_handle)
+{
+    SOPC_ASSERT(req_handle <= SOPC_MAX_PENDING_REQUESTS);
+    uint32_t nbRequests = (0 == nb_client_requests ? INITIAL_NB_REQUEST_HANDLES : 2 * nb_client_requests);
+    if (nbRequests < req_handle)
+    {
+        nbRequests = req_handle;
+    }
+    if (nbRequests > SOPC_MAX_PENDING_REQUESTS)
+    {
+        nbRequests = SOPC_MAX_PENDING_REQUESTS;
+    }
+    constants__t_session_i* requests = SOPC_Calloc((size_t) nbRequests + 1, sizeof(*requests));
+    if (NULL == requests)
+    {
+        return false;
+    }
+    if (NULL != client_requests)
+    {
+        memcpy(requests, client_requests, ((size_t) nb_client_requests + 1) * sizeof(*requests));
+        SOPC_Free(client_requests);
+    }
+    client_requests = requests;
+    nb_client_requests = nbRequests;
+    return true;
+}
+
 /*------------------------
    INITIALISATION Clause
   ------------------------*/
 void session_request_handle_bs__INITIALISATION(void)
 {
-    memset(client_requests, constants__c_session_indet,
-           (SOPC_MAX_PENDING_REQUESTS + 1) * sizeof(constants__t_session_i));
+    // Request handles table is allocated on first request
+    client_requests = NULL;
+    nb_client_requests = 0;
     memset(session_pending_requests_nb, 0, (SOPC_MAX_SESSIONS + 1) * sizeof(uint32_t));
 }
 
 /*--------------------
    OPERATIONS Clause
   --------------------*/
+void session_request_handle_bs__session_request_handle_bs_UNINITIALISATION(void)
+{
+    SOPC_Free(client_requests);
+    session_request_handle_bs__INITIALISATION();
+}
+
 void session_request_handle_bs__client_add_session_request_handle(
     const constants__t_session_i session_request_handle_bs__session,
     const constants__t_client_request_handle_i session_request_handle_bs__req_handle)
 {
     SOPC_ASSERT(session_request_handle_bs__session != constants__c_session_indet);
     SOPC_ASSERT(session_request_handle_bs__req_handle != constants__c_client_request_handle_indet);
+    if (session_request_handle_bs__req_handle > nb_client_requests &&
+        !grow_client_requests(session_request_handle_bs__req_handle))
+    {
+        // Degraded case: the response will not be associated to the session
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "session_request_handle_bs: failed to record request handle %" PRIu32
+                               " for session %" PRIu32,
+                               session_request_handle_bs__req_handle, session_request_handle_bs__session);
+        return;
+    }
     // Request handle freshness is guaranteed by request_handle_bs,
     // in degraded cases an old session number could be overwritten here
     client_requests[session_request_handle_bs__req_handle] = session_request_handle_bs__session;
@@ -68,7 +121,8 @@ void session_request_handle_bs__client_get_session_and_remove_request_handle(
     // Note: validity of request handle is guaranteed by request_handle_bs
     *session_request_handle_bs__session = constants__c_session_indet;
 
-    if (session_request_handle_bs__req_handle != constants__c_client_request_handle_indet)
+    if (session_request_handle_bs__req_handle != constants__c_client_request_handle_indet &&
+        session_request_handle_bs__req_handle <= nb_client_requests)
     {
         if (client_requests[session_request_handle_bs__req_handle] != constants__c_session_indet)
         {
@@ -86,7 +140,7 @@ void session_request_handle_bs__client_remove_all_request_handles(
 {
     SOPC_ASSERT(session_request_handle_bs__session != constants__c_session_indet);
     for (uint32_t idx = 1;
-         idx <= SOPC_MAX_PENDING_REQUESTS && session_pending_requests_nb[session_request_handle_bs__session] > 0; idx++)
+         idx <= nb_client_requests && session_pending_requests_nb[session_request_handle_bs__session] > 0; idx++)
     {
         if (client_requests[idx] == session_request_handle_bs__session)
         {
@@ -33,6 +33,7 @@
 #include "sopc_event_timer_manager.h"
 #include "sopc_logger.h"
 #include "sopc_services_api_internal.h"
+#include "subscription_core_impl.h"
 #include "util_b2c.h"
 
 SOPC_Dict* nodeIdToMonitoredItemQueue = NULL;
@@ -44,6 +45,18 @@ static void free_monitored_item_queue(uintptr_t data)
     SOPC_SLinkedList_Delete(miQueue);
 }
 
+bool SOPC_SubscriptionCore_HasMonitoredItems(const SOPC_NodeId* nodeId)
+{
+    if (NULL == nodeIdToMonitoredItemQueue)
+    {
+        return false;
+    }
+    // Note: the queue of a node is kept once created even if all its monitored items are deleted
+    SOPC_SLinkedList* monitoredItemQueue =
+        (SOPC_SLinkedList*) SOPC_Dict_Get(nodeIdToMonitoredItemQueue, (uintptr_t) nodeId, NULL);
+    return NULL != monitoredItemQueue && SOPC_SLinkedList_GetLength(monitoredItemQueue) > 0;
+}
+
 /*------------------------
    INITIALISATION Clause
   ------------------------*/
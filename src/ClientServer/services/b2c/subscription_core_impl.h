@@ -0,0 +1,36 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SOPC_SUBSCRIPTION_CORE_IMPL_H_
+#define SOPC_SUBSCRIPTION_CORE_IMPL_H_
+
+#include <stdbool.h>
+
+#include "sopc_builtintypes.h"
+
+/**
+ * \brief Returns true if monitored items exist for the given node (services thread only).
+ *
+ * \param nodeId  the NodeId of the node
+ *
+ * \return true if at least one monitored item monitors an attribute of the node, false otherwise
+ */
+bool SOPC_SubscriptionCore_HasMonitoredItems(const SOPC_NodeId* nodeId);
+
+#endif /* SOPC_SUBSCRIPTION_CORE_IMPL_H_ */
@@ -259,6 +259,10 @@ void browse_treatment__fill_browse_result(
          &browse_treatment__l_continue_bri);
       browse_treatment_target_it__init_iter_reference(browse_treatment__p_src_node,
          browse_treatment__p_startIndex,
+         browse_treatment__p_browseDirection,
+         browse_treatment__p_refType_defined,
+         browse_treatment__p_referenceType,
+         browse_treatment__p_includeSubtypes,
          &browse_treatment__l_continue_ref);
       *browse_treatment__p_nextIndex = browse_treatment__p_startIndex;
       while ((browse_treatment__l_continue_ref == true) &&
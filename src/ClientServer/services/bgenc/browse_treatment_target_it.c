@@ -35,9 +35,13 @@
 /*----------------------------
    CONCRETE_VARIABLES Clause
   ----------------------------*/
+constants__t_BrowseDirection_i browse_treatment_target_it__BrowseDirection;
+t_bool browse_treatment_target_it__IncludeSubtypes;
 constants__t_Node_i browse_treatment_target_it__Node;
 t_entier4 browse_treatment_target_it__RefIndex;
 t_entier4 browse_treatment_target_it__RefIndexEnd;
+t_bool browse_treatment_target_it__RefTypeDefined;
+constants__t_NodeId_i browse_treatment_target_it__ReferenceType;
 
 /*------------------------
    INITIALISATION Clause
@@ -46,6 +50,10 @@ void browse_treatment_target_it__INITIALISATION(void) {
    browse_treatment_target_it__Node = constants__c_Node_indet;
    browse_treatment_target_it__RefIndex = 0;
    browse_treatment_target_it__RefIndexEnd = 0;
+   browse_treatment_target_it__BrowseDirection = constants__e_bd_indet;
+   browse_treatment_target_it__RefTypeDefined = false;
+   browse_treatment_target_it__ReferenceType = constants__c_NodeId_indet;
+   browse_treatment_target_it__IncludeSubtypes = false;
 }
 
 /*--------------------
@@ -54,12 +62,26 @@ void browse_treatment_target_it__INITIALISATION(void) {
 void browse_treatment_target_it__init_iter_reference(
    const constants__t_Node_i browse_treatment_target_it__p_node,
    const t_entier4 browse_treatment_target_it__p_startIndex,
+   const constants__t_BrowseDirection_i browse_treatment_target_it__p_browseDirection,
+   const t_bool browse_treatment_target_it__p_refType_defined,
+   const constants__t_NodeId_i browse_treatment_target_it__p_referenceType,
+   const t_bool browse_treatment_target_it__p_includeSubtypes,
    t_bool * const browse_treatment_target_it__p_continue) {
    browse_treatment_target_it__Node = browse_treatment_target_it__p_node;
-   browse_treatment_target_it__RefIndex = browse_treatment_target_it__p_startIndex;
+   browse_treatment_target_it__BrowseDirection = browse_treatment_target_it__p_browseDirection;
+   browse_treatment_target_it__RefTypeDefined = browse_treatment_target_it__p_refType_defined;
+   browse_treatment_target_it__ReferenceType = browse_treatment_target_it__p_referenceType;
+   browse_treatment_target_it__IncludeSubtypes = browse_treatment_target_it__p_includeSubtypes;
    address_space_itf__get_Node_RefIndexEnd(browse_treatment_target_it__p_node,
       &browse_treatment_target_it__RefIndexEnd);
-   *browse_treatment_target_it__p_continue = (browse_treatment_target_it__RefIndexEnd >= browse_treatment_target_it__RefIndex);
+   browse_treatment_target_bs__get_next_reference_index(browse_treatment_target_it__p_node,
+      browse_treatment_target_it__p_startIndex,
+      browse_treatment_target_it__p_browseDirection,
+      browse_treatment_target_it__p_refType_defined,
+      browse_treatment_target_it__p_referenceType,
+      browse_treatment_target_it__p_includeSubtypes,
+      &browse_treatment_target_it__RefIndex);
+   *browse_treatment_target_it__p_continue = (browse_treatment_target_it__RefIndex <= browse_treatment_target_it__RefIndexEnd);
 }
 
 void browse_treatment_target_it__continue_iter_reference(
@@ -69,9 +91,15 @@ void browse_treatment_target_it__continue_iter_reference(
    address_space_itf__get_RefIndex_Reference(browse_treatment_target_it__Node,
       browse_treatment_target_it__RefIndex,
       browse_treatment_target_it__p_ref);
-   browse_treatment_target_it__RefIndex = browse_treatment_target_it__RefIndex +
+   *browse_treatment_target_it__p_nextRefIndex = browse_treatment_target_it__RefIndex +
       1;
+   browse_treatment_target_bs__get_next_reference_index(browse_treatment_target_it__Node,
+      *browse_treatment_target_it__p_nextRefIndex,
+      browse_treatment_target_it__BrowseDirection,
+      browse_treatment_target_it__RefTypeDefined,
+      browse_treatment_target_it__ReferenceType,
+      browse_treatment_target_it__IncludeSubtypes,
+      &browse_treatment_target_it__RefIndex);
    *browse_treatment_target_it__p_continue = (browse_treatment_target_it__RefIndex <= browse_treatment_target_it__RefIndexEnd);
-   *browse_treatment_target_it__p_nextRefIndex = browse_treatment_target_it__RefIndex;
 }
 
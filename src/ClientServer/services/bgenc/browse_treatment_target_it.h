@@ -35,6 +35,11 @@
   --------------------------*/
 #include "b2c.h"
 
+/*-----------------
+   IMPORTS Clause
+  -----------------*/
+#include "browse_treatment_target_bs.h"
+
 /*--------------
    SEES Clause
   --------------*/
@@ -44,9 +49,13 @@
 /*----------------------------
    CONCRETE_VARIABLES Clause
   ----------------------------*/
+extern constants__t_BrowseDirection_i browse_treatment_target_it__BrowseDirection;
+extern t_bool browse_treatment_target_it__IncludeSubtypes;
 extern constants__t_Node_i browse_treatment_target_it__Node;
 extern t_entier4 browse_treatment_target_it__RefIndex;
 extern t_entier4 browse_treatment_target_it__RefIndexEnd;
+extern t_bool browse_treatment_target_it__RefTypeDefined;
+extern constants__t_NodeId_i browse_treatment_target_it__ReferenceType;
 
 /*------------------------
    INITIALISATION Clause
@@ -63,6 +72,10 @@ extern void browse_treatment_target_it__continue_iter_reference(
 extern void browse_treatment_target_it__init_iter_reference(
    const constants__t_Node_i browse_treatment_target_it__p_node,
    const t_entier4 browse_treatment_target_it__p_startIndex,
+   const constants__t_BrowseDirection_i browse_treatment_target_it__p_browseDirection,
+   const t_bool browse_treatment_target_it__p_refType_defined,
+   const constants__t_NodeId_i browse_treatment_target_it__p_referenceType,
+   const t_bool browse_treatment_target_it__p_includeSubtypes,
    t_bool * const browse_treatment_target_it__p_continue);
 
 #endif
@@ -1008,6 +1008,64 @@ void io_dispatch_mgr__internal_server_send_publish_response_prio_event(
    }
 }
 
+void io_dispatch_mgr__internal_server_send_method_call_response(
+   const constants__t_session_i io_dispatch_mgr__p_session,
+   const constants__t_server_request_handle_i io_dispatch_mgr__p_req_handle,
+   const constants__t_request_context_i io_dispatch_mgr__p_req_context,
+   const constants__t_msg_i io_dispatch_mgr__p_call_resp_msg,
+   const constants_statuscodes_bs__t_StatusCode_i io_dispatch_mgr__p_statusCode,
+   t_bool * const io_dispatch_mgr__bres) {
+   {
+      t_bool io_dispatch_mgr__l_valid_session;
+      constants__t_msg_type_i io_dispatch_mgr__l_msg_typ;
+      t_bool io_dispatch_mgr__l_valid_req_context;
+      constants__t_byte_buffer_i io_dispatch_mgr__l_buffer_out;
+      constants_statuscodes_bs__t_StatusCode_i io_dispatch_mgr__l_sc;
+      constants__t_channel_i io_dispatch_mgr__l_channel;
+      t_bool io_dispatch_mgr__l_connected_channel;
+      
+      service_mgr__is_valid_session(io_dispatch_mgr__p_session,
+         &io_dispatch_mgr__l_valid_session);
+      service_mgr__bless_msg_out(io_dispatch_mgr__p_call_resp_msg,
+         &io_dispatch_mgr__l_msg_typ);
+      service_mgr__is_valid_request_context(io_dispatch_mgr__p_req_context,
+         &io_dispatch_mgr__l_valid_req_context);
+      if ((((io_dispatch_mgr__l_valid_session == true) &&
+         (io_dispatch_mgr__l_msg_typ == constants__e_msg_method_call_resp)) &&
+         (io_dispatch_mgr__l_valid_req_context == true)) &&
+         (io_dispatch_mgr__p_statusCode != constants_statuscodes_bs__c_StatusCode_indet)) {
+         service_mgr__server_send_publish_response(io_dispatch_mgr__p_session,
+            io_dispatch_mgr__p_req_handle,
+            io_dispatch_mgr__p_statusCode,
+            io_dispatch_mgr__l_msg_typ,
+            io_dispatch_mgr__p_call_resp_msg,
+            io_dispatch_mgr__bres,
+            &io_dispatch_mgr__l_sc,
+            &io_dispatch_mgr__l_buffer_out,
+            &io_dispatch_mgr__l_channel);
+         channel_mgr__is_connected_channel(io_dispatch_mgr__l_channel,
+            &io_dispatch_mgr__l_connected_channel);
+         if ((*io_dispatch_mgr__bres == true) &&
+            (io_dispatch_mgr__l_connected_channel == true)) {
+            service_mgr__send_channel_msg_buffer(io_dispatch_mgr__l_channel,
+               io_dispatch_mgr__l_buffer_out,
+               io_dispatch_mgr__p_req_context);
+         }
+         else if (io_dispatch_mgr__l_connected_channel == true) {
+            service_mgr__send_channel_error_msg(io_dispatch_mgr__l_channel,
+               io_dispatch_mgr__l_sc,
+               io_dispatch_mgr__p_req_context);
+         }
+      }
+      else {
+         *io_dispatch_mgr__bres = false;
+      }
+      if (io_dispatch_mgr__l_msg_typ != constants__c_msg_type_indet) {
+         service_mgr__dealloc_msg_out(io_dispatch_mgr__p_call_resp_msg);
+      }
+   }
+}
+
 void io_dispatch_mgr__close_all_active_connections(
    const t_bool io_dispatch_mgr__p_clientOnly,
    t_bool * const io_dispatch_mgr__bres) {
@@ -130,6 +130,13 @@ extern void io_dispatch_mgr__internal_server_evaluate_session_timeout(
 extern void io_dispatch_mgr__internal_server_node_changed(
    const t_bool io_dispatch_mgr__p_node_added,
    const constants__t_NodeId_i io_dispatch_mgr__p_nid);
+extern void io_dispatch_mgr__internal_server_send_method_call_response(
+   const constants__t_session_i io_dispatch_mgr__p_session,
+   const constants__t_server_request_handle_i io_dispatch_mgr__p_req_handle,
+   const constants__t_request_context_i io_dispatch_mgr__p_req_context,
+   const constants__t_msg_i io_dispatch_mgr__p_call_resp_msg,
+   const constants_statuscodes_bs__t_StatusCode_i io_dispatch_mgr__p_statusCode,
+   t_bool * const io_dispatch_mgr__bres);
 extern void io_dispatch_mgr__internal_server_send_publish_response_prio_event(
    const constants__t_session_i io_dispatch_mgr__p_session,
    const constants__t_server_request_handle_i io_dispatch_mgr__p_req_handle,
@@ -83,6 +83,7 @@ extern void request_handle_bs__get_req_handle_resp_typ(
 extern void request_handle_bs__is_valid_req_handle(
    const constants__t_client_request_handle_i request_handle_bs__req_handle,
    t_bool * const request_handle_bs__ret);
+extern void request_handle_bs__request_handle_bs_UNINITIALISATION(void);
 extern void request_handle_bs__set_req_handle_channel(
    const constants__t_client_request_handle_i request_handle_bs__req_handle,
    const constants__t_channel_i request_handle_bs__channel);
@@ -399,6 +399,12 @@ void service_mgr__treat_session_nano_extended_service_req(
             service_mgr__req_msg,
             service_mgr__resp_msg,
             service_mgr__StatusCode_service);
+         service_mgr_bs__server_async_method_call_resp(service_mgr__session,
+            service_mgr__req_handle,
+            service_mgr__req_ctx,
+            service_mgr__resp_msg,
+            *service_mgr__StatusCode_service,
+            service_mgr__async_resp_msg);
          break;
       case constants__e_msg_node_add_nodes_req:
          constants__is_ClientNodeManagementActive(&service_mgr__l_bres);
@@ -1784,6 +1790,8 @@ void service_mgr__service_mgr_UNINITIALISATION(void) {
    service_set_view__service_set_view_UNINITIALISATION();
    service_set_discovery_server__service_set_discovery_server_UNINITIALISATION();
    service_mgr_bs__service_mgr_bs_UNINITIALISATION();
+   session_mgr__session_mgr_UNINITIALISATION();
+   request_handle_bs__request_handle_bs_UNINITIALISATION();
    address_space_itf__address_space_bs_UNINITIALISATION();
 }
 
@@ -70,6 +70,13 @@ extern void service_mgr_bs__send_channel_msg_buffer(
    const constants__t_channel_i service_mgr_bs__channel,
    const constants__t_byte_buffer_i service_mgr_bs__buffer,
    const constants__t_request_context_i service_mgr_bs__request_context);
+extern void service_mgr_bs__server_async_method_call_resp(
+   const constants__t_session_i service_mgr_bs__session,
+   const constants__t_server_request_handle_i service_mgr_bs__req_handle,
+   const constants__t_request_context_i service_mgr_bs__req_ctx,
+   const constants__t_msg_i service_mgr_bs__resp_msg,
+   const constants_statuscodes_bs__t_StatusCode_i service_mgr_bs__p_sc,
+   t_bool * const service_mgr_bs__bres);
 extern void service_mgr_bs__service_mgr_bs_UNINITIALISATION(void);
 
 #endif
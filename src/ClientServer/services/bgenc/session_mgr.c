@@ -919,3 +919,7 @@ void session_mgr__session_get_endpoint_config(
    }
 }
 
+void session_mgr__session_mgr_UNINITIALISATION(void) {
+   session_request_handle_bs__session_request_handle_bs_UNINITIALISATION();
+}
+
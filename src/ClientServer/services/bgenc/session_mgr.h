@@ -181,5 +181,6 @@ extern void session_mgr__server_validate_session_service_req(
 extern void session_mgr__session_get_endpoint_config(
    const constants__t_session_i session_mgr__p_session,
    constants__t_endpoint_config_idx_i * const session_mgr__endpoint_config_idx);
+extern void session_mgr__session_mgr_UNINITIALISATION(void);
 
 #endif
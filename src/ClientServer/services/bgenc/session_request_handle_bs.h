@@ -58,5 +58,6 @@ extern void session_request_handle_bs__client_get_session_and_remove_request_han
    constants__t_session_i * const session_request_handle_bs__session);
 extern void session_request_handle_bs__client_remove_all_request_handles(
    const constants__t_session_i session_request_handle_bs__session);
+extern void session_request_handle_bs__session_request_handle_bs_UNINITIALISATION(void);
 
 #endif
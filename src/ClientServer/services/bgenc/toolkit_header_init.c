@@ -52,6 +52,7 @@
 #include "browse_treatment_continuation_points_session_it.h"
 #include "browse_treatment_result_bs.h"
 #include "browse_treatment_result_it.h"
+#include "browse_treatment_target_bs.h"
 #include "browse_treatment_target_it.h"
 #include "call_method_it.h"
 #include "call_method_mgr.h"
@@ -243,6 +244,7 @@ void INITIALISATION(void) {
    browse_treatment_continuation_points__INITIALISATION();
    browse_treatment_result_bs__INITIALISATION();
    browse_treatment_1__INITIALISATION();
+   browse_treatment_target_bs__INITIALISATION();
    browse_treatment_target_it__INITIALISATION();
    browse_treatment_result_it__INITIALISATION();
    browse_treatment__INITIALISATION();
@@ -35,6 +35,7 @@
 #include "sopc_toolkit_config_internal.h"
 #include "sopc_user_app_itf.h"
 
+#include "call_method_async_impl.h"
 #include "io_dispatch_mgr.h"
 #include "monitored_item_pointer_bs.h"
 #include "service_mgr_bs.h"
@@ -242,6 +243,9 @@ static void onServiceEvent(SOPC_EventHandler* handler,
     SOPC_Internal_SessionAppContext* sessionContext = NULL;
     SOPC_ExtensionObject* userToken = NULL;
     SOPC_Internal_DiscoveryContext* discoveryContext = NULL;
+    SOPC_Internal_ValuesUpdate* valuesUpdate = NULL;
+    uint32_t sessionId = 0;
+    SOPC_Internal_AsyncSendMsgData callRespData = {0, 0, NULL};
 
     switch (event)
     {
@@ -337,6 +341,10 @@ static void onServiceEvent(SOPC_EventHandler* handler,
 
         io_dispatch_mgr__internal_server_inactive_session_prio_event((constants__t_session_i) id,
                                                                      (constants__t_sessionState) auxParam, &bres);
+        if (constants__e_session_closed == (constants__t_sessionState) auxParam)
+        {
+            SOPC_MethodCallAsync_SessionClosed(id);
+        }
 
         if (bres == false)
         {
@@ -463,6 +471,60 @@ static void onServiceEvent(SOPC_EventHandler* handler,
                                      id, SOPC_EncodeableType_GetName(encType), auxParam);
         }
         break;
+    case APP_TO_SE_LOCAL_VALUES_UPDATE:
+        /* params = (SOPC_Internal_ValuesUpdate*) batch of values to set */
+        valuesUpdate = (SOPC_Internal_ValuesUpdate*) params;
+        SOPC_ASSERT(NULL != valuesUpdate);
+        SOPC_Logger_TraceDebug(SOPC_LOG_MODULE_CLIENTSERVER,
+                               "ServicesMgr: APP_TO_SE_LOCAL_VALUES_UPDATE nbValues=%" PRIuPTR,
+                               (uintptr_t) valuesUpdate->nbValues);
+
+        for (size_t i = 0; i < valuesUpdate->nbValues; i++)
+        {
+            bres = SOPC_AddressSpace_UpdateValue(valuesUpdate->nodes[i], &valuesUpdate->values[i], &old_value,
+                                                 &new_value);
+            if (!bres)
+            {
+                SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                       "ServicesMgr: APP_TO_SE_LOCAL_VALUES_UPDATE value %" PRIuPTR
+                                       " ignored: node is not a Variable",
+                                       (uintptr_t) i);
+            }
+            else if (NULL != old_value && NULL != new_value)
+            {
+                /* Note: write values deallocation managed by B model */
+                io_dispatch_mgr__internal_server_data_changed(old_value, new_value, &bres);
+                if (!bres)
+                {
+                    SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                           "ServicesMgr: APP_TO_SE_LOCAL_VALUES_UPDATE value %" PRIuPTR
+                                           " data change treatment failed",
+                                           (uintptr_t) i);
+                }
+            }
+        }
+        SOPC_Free(valuesUpdate->nodes);
+        SOPC_Free(valuesUpdate->values);
+        SOPC_Free(valuesUpdate);
+        break;
+    case APP_TO_SE_COMPLETE_METHOD_CALL:
+        /* params = (SOPC_MethodCallCompletion*) completion handle and results */
+        SOPC_Logger_TraceDebug(SOPC_LOG_MODULE_CLIENTSERVER, "ServicesMgr: APP_TO_SE_COMPLETE_METHOD_CALL");
+        SOPC_ASSERT((void*) params != NULL);
+        if (SOPC_MethodCallAsync_TreatCompletion((SOPC_MethodCallCompletion*) params, &sessionId, &callRespData))
+        {
+            io_dispatch_mgr__internal_server_send_method_call_response(
+                (constants__t_session_i) sessionId, callRespData.requestHandle, callRespData.requestId,
+                callRespData.msgToSend, constants_statuscodes_bs__e_sc_ok, &bres);
+            if (bres == false)
+            {
+                SOPC_Logger_TraceError(SOPC_LOG_MODULE_CLIENTSERVER,
+                                       "ServicesMgr: APP_TO_SE_COMPLETE_METHOD_CALL session=%" PRIu32
+                                       " sending call response failed",
+                                       sessionId);
+            }
+        }
+        break;
     case APP_TO_SE_OPEN_REVERSE_ENDPOINT:
         /* id = reverse endpoint description config index */
         SOPC_Logger_TraceDebug(SOPC_LOG_MODULE_CLIENTSERVER,
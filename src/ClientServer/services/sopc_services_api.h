@@ -113,6 +113,15 @@ typedef enum SOPC_Services_Event
                                         params = (OpcUa_<MessageStruct>*) OPC UA message payload structure (header
                                         ignored)<BR/> auxParam = user application session context
                                       */
+    APP_TO_SE_LOCAL_VALUES_UPDATE,   /**< Server side only:<BR/>
+                                        Requests to update the Value attribute of the provided Variable nodes locally
+                                        on the server and to notify the monitored items<BR/>
+                                        params = (SOPC_Internal_ValuesUpdate*) batch of values to set
+                                      */
+    APP_TO_SE_COMPLETE_METHOD_CALL,  /**< Server side only:<BR/>
+                                        Provides the result of a method call completed asynchronously.<BR/>
+                                        params = (SOPC_MethodCallCompletion*) completion handle and results
+                                      */
     /* App to Services events : client side */
     APP_TO_SE_OPEN_REVERSE_ENDPOINT,  /**< Server side only: <BR/>
                                          Requests to open a new reverse endpoint listening for secure channel
@@ -26,6 +26,7 @@
 #ifndef SOPC_SERVICES_API_INTERNAL_H
 #define SOPC_SERVICES_API_INTERNAL_H
 
+#include "sopc_address_space.h"
 #include "sopc_key_manager.h"
 #include "sopc_services_api.h"
 
@@ -50,4 +51,11 @@ typedef struct SOPC_Internal_DiscoveryContext
     uintptr_t discoveryAppContext; /**< User application request context */
 } SOPC_Internal_DiscoveryContext;
 
+typedef struct SOPC_Internal_ValuesUpdate
+{
+    size_t nbValues;                /**< Number of values in the batch */
+    SOPC_AddressSpace_Node** nodes; /**< Variable nodes to update */
+    SOPC_DataValue* values;         /**< New values of the nodes, moved into the nodes */
+} SOPC_Internal_ValuesUpdate;
+
 #endif /* SOPC_SERVICES_API_INTERNAL_H */
@@ -151,9 +151,15 @@ bool SOPC_Common_EncodingConstantsGetInitialized(void);
 #define SOPC_HAS_FILESYSTEM true
 #endif /* SOPC_HAS_FILESYSTEM */
 
-/** @brief Maximum number of timers. */
+/** @brief Maximum number of timers.
+ *         A table of SOPC_MAX_TIMERS booleans is statically allocated, the default is kept low on embedded targets.
+ */
 #ifndef SOPC_MAX_TIMERS
-#define SOPC_MAX_TIMERS UINT8_MAX /* TODO: avoid static maximum (see monitoredItems Id creation) */
+#if (defined(__linux__) || defined(_WIN32)) && !defined(__ZEPHYR__)
+#define SOPC_MAX_TIMERS 2048 /* TODO: avoid static maximum (see monitoredItems Id creation) */
+#else
+#define SOPC_MAX_TIMERS UINT8_MAX
+#endif
 #endif
 
 /** @brief define host-specific console print function
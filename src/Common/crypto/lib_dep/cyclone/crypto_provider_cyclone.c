@@ -170,3 +170,14 @@ SOPC_ReturnStatus SOPC_CryptoProvider_AsymmetricGetLength_MsgCipherText(const SO
 
     return SOPC_STATUS_OK;
 }
+
+/* ------------------------------------------------------------------------------------------------
+ * CryptoProvider hardware support
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* The portable software implementation of CycloneCRYPTO is used */
+bool SOPC_CryptoProvider_SymmetricIsHardwareAccelerated(void)
+{
+    return false;
+}
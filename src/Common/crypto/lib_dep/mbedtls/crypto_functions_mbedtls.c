@@ -65,8 +65,8 @@ static SOPC_ReturnStatus generic_SymmEncrypt(SOPC_SecurityPolicy_ID policyId,
     if (lenOutput >= lenPlainText)
     {
         // IV is modified during the operation, so it must be copied first
-        unsigned char* iv_cpy = (unsigned char*) SOPC_Malloc(symmLen_Block);
-        SOPC_ASSERT(NULL != iv_cpy);
+        unsigned char iv_cpy[16];
+        SOPC_ASSERT(symmLen_Block <= sizeof(iv_cpy));
         memcpy(iv_cpy, pIV, symmLen_Block);
         mbedtls_aes_init(&aes);
 
@@ -82,7 +82,6 @@ static SOPC_ReturnStatus generic_SymmEncrypt(SOPC_SecurityPolicy_ID policyId,
             }
         }
         mbedtls_aes_free(&aes);
-        SOPC_Free(iv_cpy);
     }
     return status;
 }
@@ -106,8 +105,8 @@ static SOPC_ReturnStatus generic_SymmDecrypt(SOPC_SecurityPolicy_ID policyId,
     if (lenOutput >= lenCipherText)
     {
         // IV is modified during the operation, so it must be copied first
-        unsigned char* iv_cpy = (unsigned char*) SOPC_Malloc(symmLen_Block);
-        SOPC_ASSERT(NULL != iv_cpy);
+        unsigned char iv_cpy[16];
+        SOPC_ASSERT(symmLen_Block <= sizeof(iv_cpy));
         memcpy(iv_cpy, pIV, symmLen_Block);
         mbedtls_aes_init(&aes);
 
@@ -123,7 +122,6 @@ static SOPC_ReturnStatus generic_SymmDecrypt(SOPC_SecurityPolicy_ID policyId,
             }
         }
         mbedtls_aes_free(&aes);
-        SOPC_Free(iv_cpy);
     }
     return status;
 }
@@ -995,3 +993,112 @@ SOPC_ReturnStatus CryptoProvider_CTR_Crypt_AES256(const SOPC_CryptoProvider* pPr
 
     return status;
 }
+
+/* ------------------------------------------------------------------------------------------------
+ * Batches of symmetric operations
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* The HMAC and AES contexts are set up once for the whole batch. As consecutive chunks of a secure channel share
+ * their keys, the contexts are only keyed again when the key changes. */
+static SOPC_ReturnStatus generic_SymmSignEncryptBatch(const SOPC_CryptoProvider* pProvider,
+                                                      SOPC_SymmetricBatchItem* pItems,
+                                                      uint32_t nbItems,
+                                                      mbedtls_md_type_t hash_type)
+{
+    const SOPC_CryptoProfile* pProfile = SOPC_CryptoProvider_GetProfileServices(pProvider);
+    SOPC_ASSERT(NULL != pProfile);
+    const SOPC_SecurityPolicy_Config* policy = SOPC_SecurityPolicy_Config_Get(pProfile->SecurityPolicyID);
+    const uint32_t symmLen_Block = policy->symmLen_Block;
+    const uint32_t symmLen_CryptoKey = policy->symmLen_CryptoKey;
+    const uint32_t symmLen_SignKey = policy->symmLen_SignKey;
+    const uint32_t symmLen_Signature = policy->symmLen_Signature;
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    const SOPC_ExposedBuffer* pSignKeySet = NULL;
+    const SOPC_ExposedBuffer* pEncryptKeySet = NULL;
+    unsigned char iv_cpy[16];
+    mbedtls_md_context_t md;
+    mbedtls_aes_context aes;
+
+    SOPC_ASSERT(symmLen_Block <= sizeof(iv_cpy));
+    mbedtls_md_init(&md);
+    mbedtls_aes_init(&aes);
+    const int resSetup = mbedtls_md_setup(&md, mbedtls_md_info_from_type(hash_type), 1);
+
+    for (uint32_t i = 0; i < nbItems; i++)
+    {
+        SOPC_SymmetricBatchItem* pItem = &pItems[i];
+        int res = resSetup;
+
+        if (0 == res)
+        {
+            if (pItem->pSignKey == pSignKeySet)
+            {
+                res = mbedtls_md_hmac_reset(&md);
+            }
+            else
+            {
+                res = mbedtls_md_hmac_starts(&md, (const unsigned char*) pItem->pSignKey, symmLen_SignKey);
+            }
+            pSignKeySet = NULL;
+        }
+        if (0 == res)
+        {
+            res = mbedtls_md_hmac_update(&md, (const unsigned char*) pItem->pData, pItem->lenToSign);
+        }
+        if (0 == res)
+        {
+            res = mbedtls_md_hmac_finish(&md, (unsigned char*) pItem->pData + pItem->lenToSign);
+        }
+        if (0 == res)
+        {
+            pSignKeySet = pItem->pSignKey;
+        }
+
+        if (0 == res && NULL != pItem->pEncryptKey && pItem->pEncryptKey != pEncryptKeySet)
+        {
+            pEncryptKeySet = NULL;
+            res = mbedtls_aes_setkey_enc(&aes, (const unsigned char*) pItem->pEncryptKey, symmLen_CryptoKey * 8);
+            if (0 == res)
+            {
+                pEncryptKeySet = pItem->pEncryptKey;
+            }
+        }
+        if (0 == res && NULL != pItem->pEncryptKey)
+        {
+            // IV is modified during the operation, so it must be copied first
+            memcpy(iv_cpy, pItem->pIV, symmLen_Block);
+            res = mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT,
+                                        pItem->lenToSign + symmLen_Signature - pItem->offsetToEncrypt, iv_cpy,
+                                        (const unsigned char*) pItem->pData + pItem->offsetToEncrypt,
+                                        (unsigned char*) pItem->pOutput);
+        }
+
+        pItem->status = (0 == res) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+        if (SOPC_STATUS_OK != pItem->status)
+        {
+            status = SOPC_STATUS_NOK;
+        }
+    }
+
+    memset(iv_cpy, 0, sizeof(iv_cpy));
+    mbedtls_md_free(&md);
+    mbedtls_aes_free(&aes);
+
+    return status;
+}
+
+SOPC_ReturnStatus CryptoProvider_SymmSignEncryptBatch_HMAC_SHA256(const SOPC_CryptoProvider* pProvider,
+                                                                  SOPC_SymmetricBatchItem* pItems,
+                                                                  uint32_t nbItems)
+{
+    return generic_SymmSignEncryptBatch(pProvider, pItems, nbItems, MBEDTLS_MD_SHA256);
+}
+
+SOPC_ReturnStatus CryptoProvider_SymmSignEncryptBatch_HMAC_SHA1(const SOPC_CryptoProvider* pProvider,
+                                                                SOPC_SymmetricBatchItem* pItems,
+                                                                uint32_t nbItems)
+{
+    return generic_SymmSignEncryptBatch(pProvider, pItems, nbItems, MBEDTLS_MD_SHA1);
+}
@@ -26,6 +26,7 @@
 #define SOPC_CRYPTO_FUNCTIONS_LIB_H_
 
 #include "sopc_crypto_decl.h"
+#include "sopc_crypto_profiles.h"
 
 /* ------------------------------------------------------------------------------------------------
  * Aes128-Sha256-RsaOaep
@@ -183,4 +184,17 @@ SOPC_ReturnStatus CryptoProvider_CTR_Crypt_AES256(const SOPC_CryptoProvider* pPr
                                                   const SOPC_ExposedBuffer* pRandom,
                                                   uint32_t uSequenceNumber,
                                                   uint8_t* pOutput);
+
+/* ------------------------------------------------------------------------------------------------
+ * Batches of symmetric operations
+ * ------------------------------------------------------------------------------------------------
+ */
+
+SOPC_ReturnStatus CryptoProvider_SymmSignEncryptBatch_HMAC_SHA256(const SOPC_CryptoProvider* pProvider,
+                                                                  SOPC_SymmetricBatchItem* pItems,
+                                                                  uint32_t nbItems);
+SOPC_ReturnStatus CryptoProvider_SymmSignEncryptBatch_HMAC_SHA1(const SOPC_CryptoProvider* pProvider,
+                                                                SOPC_SymmetricBatchItem* pItems,
+                                                                uint32_t nbItems);
+
 #endif /* SOPC_CRYPTO_FUNCTIONS_LIB_H_ */
@@ -44,6 +44,7 @@ const SOPC_CryptoProfile sopc_g_cpAes256Sha256RsaPss = {
     .pFnAsymDecrypt = &CryptoProvider_AsymDecrypt_RSA_OAEP_SHA256,
     .pFnAsymSign = &CryptoProvider_AsymSign_RSASSA_PSS,
     .pFnAsymVerify = &CryptoProvider_AsymVerify_RSASSA_PSS,
+    .pFnSymmSignEncryptBatch = &CryptoProvider_SymmSignEncryptBatch_HMAC_SHA256,
 };
 
 const SOPC_CryptoProfile sopc_g_cpAes128Sha256RsaOaep = {
@@ -58,6 +59,7 @@ const SOPC_CryptoProfile sopc_g_cpAes128Sha256RsaOaep = {
     .pFnAsymDecrypt = &CryptoProvider_AsymDecrypt_RSA_OAEP,
     .pFnAsymSign = &CryptoProvider_AsymSign_RSASSA_PKCS1_v15_w_SHA256,
     .pFnAsymVerify = &CryptoProvider_AsymVerify_RSASSA_PKCS1_v15_w_SHA256,
+    .pFnSymmSignEncryptBatch = &CryptoProvider_SymmSignEncryptBatch_HMAC_SHA256,
 };
 
 const SOPC_CryptoProfile sopc_g_cpBasic256Sha256 = {
@@ -72,6 +74,7 @@ const SOPC_CryptoProfile sopc_g_cpBasic256Sha256 = {
     .pFnAsymDecrypt = &CryptoProvider_AsymDecrypt_RSA_OAEP,
     .pFnAsymSign = &CryptoProvider_AsymSign_RSASSA_PKCS1_v15_w_SHA256,
     .pFnAsymVerify = &CryptoProvider_AsymVerify_RSASSA_PKCS1_v15_w_SHA256,
+    .pFnSymmSignEncryptBatch = &CryptoProvider_SymmSignEncryptBatch_HMAC_SHA256,
 };
 
 const SOPC_CryptoProfile sopc_g_cpBasic256 = {
@@ -86,6 +89,7 @@ const SOPC_CryptoProfile sopc_g_cpBasic256 = {
     .pFnAsymDecrypt = &CryptoProvider_AsymDecrypt_RSA_OAEP,
     .pFnAsymSign = &CryptoProvider_AsymSign_RSASSA_PKCS1_v15_w_SHA1,
     .pFnAsymVerify = &CryptoProvider_AsymVerify_RSASSA_PKCS1_v15_w_SHA1,
+    .pFnSymmSignEncryptBatch = &CryptoProvider_SymmSignEncryptBatch_HMAC_SHA1,
 };
 
 const SOPC_CryptoProfile sopc_g_cpNone = {
@@ -100,6 +104,7 @@ const SOPC_CryptoProfile sopc_g_cpNone = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 /* PubSub security policies */
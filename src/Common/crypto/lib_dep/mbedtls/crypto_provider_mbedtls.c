@@ -32,6 +32,10 @@
 // The services which are implemented in this file are declared here
 #include "sopc_crypto_provider_lib_itf.h"
 
+#if defined(MBEDTLS_AESCE_C) && defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
 /* ------------------------------------------------------------------------------------------------
  * CryptoProvider creation
  * ------------------------------------------------------------------------------------------------
@@ -177,3 +181,23 @@ SOPC_ReturnStatus SOPC_CryptoProvider_AsymmetricGetLength_MsgCipherText(const SO
 
     return SOPC_STATUS_OK;
 }
+
+/* ------------------------------------------------------------------------------------------------
+ * CryptoProvider hardware support
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* MbedTLS selects its AES-NI or AESCE code at runtime when it was compiled with them and the processor supports them.
+ * The same conditions are checked here. */
+bool SOPC_CryptoProvider_SymmetricIsHardwareAccelerated(void)
+{
+#if defined(MBEDTLS_AESNI_C) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    return 0 != __builtin_cpu_supports("aes");
+#elif defined(MBEDTLS_AESCE_C) && defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+    return true;
+#elif defined(MBEDTLS_AESCE_C) && defined(__aarch64__) && defined(__linux__)
+    return 0 != (getauxval(AT_HWCAP) & HWCAP_AES);
+#else
+    return false;
+#endif
+}
@@ -49,6 +49,7 @@ const SOPC_CryptoProfile sopc_g_cpAes256Sha256RsaPss = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 const SOPC_CryptoProfile sopc_g_cpAes128Sha256RsaOaep = {
@@ -63,6 +64,7 @@ const SOPC_CryptoProfile sopc_g_cpAes128Sha256RsaOaep = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 const SOPC_CryptoProfile sopc_g_cpBasic256Sha256 = {
@@ -77,6 +79,7 @@ const SOPC_CryptoProfile sopc_g_cpBasic256Sha256 = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 const SOPC_CryptoProfile sopc_g_cpBasic256 = {
@@ -91,6 +94,7 @@ const SOPC_CryptoProfile sopc_g_cpBasic256 = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 const SOPC_CryptoProfile sopc_g_cpNone = {
@@ -105,6 +109,7 @@ const SOPC_CryptoProfile sopc_g_cpNone = {
     .pFnAsymDecrypt = NULL,
     .pFnAsymSign = NULL,
     .pFnAsymVerify = NULL,
+    .pFnSymmSignEncryptBatch = NULL,
 };
 
 /* PubSub security policies */
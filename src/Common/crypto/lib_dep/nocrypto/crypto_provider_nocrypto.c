@@ -96,3 +96,13 @@ SOPC_ReturnStatus SOPC_CryptoProvider_AsymmetricGetLength_MsgCipherText(const SO
     SOPC_UNUSED_ARG(pLenMsg);
     return SOPC_STATUS_NOT_SUPPORTED;
 }
+
+/* ------------------------------------------------------------------------------------------------
+ * CryptoProvider hardware support
+ * ------------------------------------------------------------------------------------------------
+ */
+
+bool SOPC_CryptoProvider_SymmetricIsHardwareAccelerated(void)
+{
+    return false;
+}
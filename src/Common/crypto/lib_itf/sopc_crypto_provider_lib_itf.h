@@ -128,4 +128,21 @@ SOPC_ReturnStatus SOPC_CryptoProvider_AsymmetricGetLength_MsgCipherText(const SO
                                                                         const SOPC_AsymmetricKey* pKey,
                                                                         uint32_t* pLenMsg);
 
+/* ------------------------------------------------------------------------------------------------
+ * CryptoProvider hardware support
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * \brief           Tells whether the symmetric encryption of the cryptographic library relies on the AES instructions
+ *                  of the processor (AES-NI on x86, cryptographic extension on ARMv8).
+ *
+ *   Both the library configuration and the processor running the application are taken into account.
+ *
+ * \note            The implementation is specific to the chosen cryptographic library.
+ *
+ * \return          true when the AES instructions are used, false when the software implementation is used.
+ */
+bool SOPC_CryptoProvider_SymmetricIsHardwareAccelerated(void);
+
 #endif /* SOPC_CRYPTO_PROVIDER_LIB_ITF_H_ */
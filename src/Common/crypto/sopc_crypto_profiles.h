@@ -161,6 +161,29 @@ typedef SOPC_ReturnStatus FnPubSubCrypt(const SOPC_CryptoProvider* pProvider,
                                         uint32_t uSequenceNumber,
                                         uint8_t* pOutput);
 
+/**
+ * \brief   A chunk to sign then encrypt, as given to the FnSymmetricSignEncryptBatch functions.
+ *
+ * The keys and initialization vector are exposed and their lengths were verified against the security policy
+ * by SOPC_CryptoProvider_SymmetricSignEncryptBatch().
+ */
+typedef struct SOPC_SymmetricBatchItem
+{
+    const SOPC_ExposedBuffer* pSignKey;    /**< Symmetric signing key */
+    const SOPC_ExposedBuffer* pEncryptKey; /**< Symmetric encryption key, NULL when the chunk is only signed */
+    const SOPC_ExposedBuffer* pIV;         /**< Initialization vector, NULL when the chunk is only signed */
+    uint8_t* pData;                        /**< Signed bytes, followed by the room for the signature */
+    uint32_t lenToSign;                    /**< Number of signed bytes, the signature is written at pData + lenToSign */
+    uint32_t offsetToEncrypt;              /**< Offset in pData of the first encrypted byte */
+    uint8_t* pOutput;                      /**< Ciphered bytes, from offsetToEncrypt to the end of the signature */
+    SOPC_ReturnStatus status;              /**< Result of the operation on this chunk */
+} SOPC_SymmetricBatchItem;
+
+/* All the items share the profile of pProvider. The function shall set the status of each item. */
+typedef SOPC_ReturnStatus FnSymmetricSignEncryptBatch(const SOPC_CryptoProvider* pProvider,
+                                                      SOPC_SymmetricBatchItem* pItems,
+                                                      uint32_t nbItems);
+
 /* ------------------------------------------------------------------------------------------------
  * The CryptoProfile definitions
  * ------------------------------------------------------------------------------------------------
@@ -190,6 +213,8 @@ struct SOPC_CryptoProfile
     FnAsymmetricDecrypt* const pFnAsymDecrypt;
     FnAsymmetricSign* const pFnAsymSign;
     FnAsymmetricVerify* const pFnAsymVerify;
+    /** Optional: when NULL, SOPC_CryptoProvider_SymmetricSignEncryptBatch() signs and encrypts chunk by chunk */
+    FnSymmetricSignEncryptBatch* const pFnSymmSignEncryptBatch;
 };
 
 /**
@@ -895,33 +895,173 @@ SOPC_ReturnStatus SOPC_CryptoProvider_SymmetricVerify(const SOPC_CryptoProvider*
     return status;
 }
 
-/* ------------------------------------------------------------------------------------------------
- * Random and pseudo-random functionalities
- * ------------------------------------------------------------------------------------------------
- */
+/* Maximum number of chunks given at once to the lib-specific batch function */
+#define SYMMETRIC_BATCH_MAX_ITEMS 16
 
-SOPC_ReturnStatus SOPC_CryptoProvider_GenerateRandomBytes(const SOPC_CryptoProvider* pProvider,
-                                                          uint32_t nBytes,
-                                                          SOPC_ExposedBuffer** ppBuffer)
+/* Verifies the job as SOPC_CryptoProvider_SymmetricSign() and SOPC_CryptoProvider_SymmetricEncrypt() would */
+static SOPC_ReturnStatus checkSymmetricJob(const SOPC_CryptoProvider_SymmetricJob* pJob)
 {
-    if (NULL == pProvider || nBytes == 0 || NULL == ppBuffer)
+    if (NULL == pJob->pProvider || NULL == pJob->pSignKey || NULL == pJob->pData)
     {
         return SOPC_STATUS_INVALID_PARAMETERS;
     }
 
-    const SOPC_CryptoProfile* pProfile = SOPC_CryptoProvider_GetProfileServices(pProvider);
-    const SOPC_CryptoProfile_PubSub* pProfilePubSub = SOPC_CryptoProvider_GetProfilePubSub(pProvider);
-    FnGenerateRandom* pFnRnd = NULL;
-    if (NULL != pProfile)
+    const SOPC_SecurityPolicy_Config* pPolicy = getCSSecurityPolicyFromProvider(pJob->pProvider);
+    const SOPC_CryptoProfile* pProfile = pPolicy->profile;
+    if (NULL == pProfile || NULL == pProfile->pFnSymmSign || 0 == pPolicy->symmLen_Signature ||
+        SOPC_SecretBuffer_GetLength(pJob->pSignKey) != pPolicy->symmLen_SignKey)
     {
-        pFnRnd = pProfile->pFnGenRnd;
+        return SOPC_STATUS_INVALID_PARAMETERS;
     }
-    else if (NULL != pProfilePubSub)
+
+    if (NULL == pJob->pEncryptKey)
     {
-        pFnRnd = pProfilePubSub->pFnGenRnd;
+        // Only signed
+        return SOPC_STATUS_OK;
     }
 
-    if (NULL == pFnRnd)
+    if (NULL == pJob->pIV || NULL == pJob->pOutput || NULL == pProfile->pFnSymmEncrypt ||
+        0 == pPolicy->symmLen_Block || pJob->lenToSign > UINT32_MAX - pPolicy->symmLen_Signature)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    const uint32_t lenSigned = pJob->lenToSign + pPolicy->symmLen_Signature;
+    if (pJob->offsetToEncrypt > lenSigned || lenSigned - pJob->offsetToEncrypt != pJob->lenOutput ||
+        (pJob->lenOutput % pPolicy->symmLen_Block) != 0 ||
+        SOPC_SecretBuffer_GetLength(pJob->pEncryptKey) != pPolicy->symmLen_CryptoKey ||
+        SOPC_SecretBuffer_GetLength(pJob->pIV) != pPolicy->symmLen_Block)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    return SOPC_STATUS_OK;
+}
+
+/* Treats the job with the single chunk functions */
+static SOPC_ReturnStatus symmetricSignEncryptJob(SOPC_CryptoProvider_SymmetricJob* pJob)
+{
+    uint32_t lenSig = 0;
+    SOPC_ReturnStatus status = SOPC_CryptoProvider_SymmetricGetLength_Signature(pJob->pProvider, &lenSig);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_CryptoProvider_SymmetricSign(pJob->pProvider, pJob->pData, pJob->lenToSign, pJob->pSignKey,
+                                                   pJob->pData + pJob->lenToSign, lenSig);
+    }
+    if (SOPC_STATUS_OK == status && NULL != pJob->pEncryptKey)
+    {
+        status = SOPC_CryptoProvider_SymmetricEncrypt(pJob->pProvider, pJob->pData + pJob->offsetToEncrypt,
+                                                      pJob->lenOutput, pJob->pEncryptKey, pJob->pIV, pJob->pOutput,
+                                                      pJob->lenOutput);
+    }
+    return status;
+}
+
+/* Gives the gathered items to the lib-specific batch function, then releases their exposed keys */
+static void flushSymmetricBatch(FnSymmetricSignEncryptBatch* pFnBatch,
+                                SOPC_SymmetricBatchItem* pItems,
+                                SOPC_CryptoProvider_SymmetricJob** ppItemJobs,
+                                uint32_t nbItems)
+{
+    if (0 == nbItems)
+    {
+        return;
+    }
+
+    pFnBatch(ppItemJobs[0]->pProvider, pItems, nbItems);
+
+    for (uint32_t i = 0; i < nbItems; i++)
+    {
+        SOPC_CryptoProvider_SymmetricJob* pJob = ppItemJobs[i];
+        pJob->status = pItems[i].status;
+        SOPC_SecretBuffer_Unexpose(pItems[i].pSignKey, pJob->pSignKey);
+        if (NULL != pJob->pEncryptKey)
+        {
+            SOPC_SecretBuffer_Unexpose(pItems[i].pEncryptKey, pJob->pEncryptKey);
+            SOPC_SecretBuffer_Unexpose(pItems[i].pIV, pJob->pIV);
+        }
+    }
+}
+
+SOPC_ReturnStatus SOPC_CryptoProvider_SymmetricSignEncryptBatch(SOPC_CryptoProvider_SymmetricJob* pJobs,
+                                                                uint32_t nbJobs)
+{
+    if (NULL == pJobs || 0 == nbJobs)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    SOPC_SymmetricBatchItem items[SYMMETRIC_BATCH_MAX_ITEMS];
+    SOPC_CryptoProvider_SymmetricJob* itemJobs[SYMMETRIC_BATCH_MAX_ITEMS];
+    const SOPC_CryptoProfile* pBatchProfile = NULL;
+    uint32_t nbItems = 0;
+
+    for (uint32_t i = 0; i < nbJobs; i++)
+    {
+        SOPC_CryptoProvider_SymmetricJob* pJob = &pJobs[i];
+        pJob->status = checkSymmetricJob(pJob);
+        if (SOPC_STATUS_OK != pJob->status)
+        {
+            continue;
+        }
+
+        const SOPC_CryptoProfile* pProfile = SOPC_CryptoProvider_GetProfileServices(pJob->pProvider);
+        if (NULL != pBatchProfile && (pProfile != pBatchProfile || SYMMETRIC_BATCH_MAX_ITEMS == nbItems))
+        {
+            flushSymmetricBatch(pBatchProfile->pFnSymmSignEncryptBatch, items, itemJobs, nbItems);
+            pBatchProfile = NULL;
+            nbItems = 0;
+        }
+
+        if (NULL == pProfile->pFnSymmSignEncryptBatch)
+        {
+            pJob->status = symmetricSignEncryptJob(pJob);
+            continue;
+        }
+
+        SOPC_SymmetricBatchItem* pItem = &items[nbItems];
+        memset(pItem, 0, sizeof(*pItem));
+        pItem->pSignKey = SOPC_SecretBuffer_Expose(pJob->pSignKey);
+        if (NULL != pJob->pEncryptKey)
+        {
+            pItem->pEncryptKey = SOPC_SecretBuffer_Expose(pJob->pEncryptKey);
+            pItem->pIV = SOPC_SecretBuffer_Expose(pJob->pIV);
+        }
+        pItem->pData = pJob->pData;
+        pItem->lenToSign = pJob->lenToSign;
+        pItem->offsetToEncrypt = pJob->offsetToEncrypt;
+        pItem->pOutput = pJob->pOutput;
+        pItem->status = SOPC_STATUS_NOK;
+        itemJobs[nbItems] = pJob;
+        nbItems++;
+        pBatchProfile = pProfile;
+    }
+
+    if (NULL != pBatchProfile)
+    {
+        flushSymmetricBatch(pBatchProfile->pFnSymmSignEncryptBatch, items, itemJobs, nbItems);
+    }
+
+    for (uint32_t i = 0; i < nbJobs; i++)
+    {
+        if (SOPC_STATUS_OK != pJobs[i].status)
+        {
+            return pJobs[i].status;
+        }
+    }
+    return SOPC_STATUS_OK;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Random and pseudo-random functionalities
+ * ------------------------------------------------------------------------------------------------
+ */
+
+SOPC_ReturnStatus SOPC_CryptoProvider_GenerateRandomBytes(const SOPC_CryptoProvider* pProvider,
+                                                          uint32_t nBytes,
+                                                          SOPC_ExposedBuffer** ppBuffer)
+{
+    if (NULL == pProvider || nBytes == 0 || NULL == ppBuffer)
     {
         return SOPC_STATUS_INVALID_PARAMETERS;
     }
@@ -940,7 +1080,7 @@ SOPC_ReturnStatus SOPC_CryptoProvider_GenerateRandomBytes(const SOPC_CryptoProvi
 
     if (SOPC_STATUS_OK == status)
     {
-        status = pFnRnd(pProvider, pExp, nBytes);
+        status = SOPC_CryptoProvider_FillRandomBytes(pProvider, pExp, nBytes);
         if (SOPC_STATUS_OK == status)
         {
             *ppBuffer = pExp;
@@ -954,6 +1094,35 @@ SOPC_ReturnStatus SOPC_CryptoProvider_GenerateRandomBytes(const SOPC_CryptoProvi
     return status;
 }
 
+SOPC_ReturnStatus SOPC_CryptoProvider_FillRandomBytes(const SOPC_CryptoProvider* pProvider,
+                                                      SOPC_ExposedBuffer* pBuffer,
+                                                      uint32_t nBytes)
+{
+    if (NULL == pProvider || nBytes == 0 || NULL == pBuffer)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    const SOPC_CryptoProfile* pProfile = SOPC_CryptoProvider_GetProfileServices(pProvider);
+    const SOPC_CryptoProfile_PubSub* pProfilePubSub = SOPC_CryptoProvider_GetProfilePubSub(pProvider);
+    FnGenerateRandom* pFnRnd = NULL;
+    if (NULL != pProfile)
+    {
+        pFnRnd = pProfile->pFnGenRnd;
+    }
+    else if (NULL != pProfilePubSub)
+    {
+        pFnRnd = pProfilePubSub->pFnGenRnd;
+    }
+
+    if (NULL == pFnRnd)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    return pFnRnd(pProvider, pBuffer, nBytes);
+}
+
 SOPC_ReturnStatus SOPC_CryptoProvider_GenerateSecureChannelNonce(const SOPC_CryptoProvider* pProvider,
                                                                  SOPC_SecretBuffer** ppNonce)
 {
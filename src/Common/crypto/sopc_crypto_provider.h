@@ -642,6 +642,48 @@ SOPC_ReturnStatus SOPC_CryptoProvider_SymmetricVerify(const SOPC_CryptoProvider*
                                                       const uint8_t* pSignature,
                                                       uint32_t lenOutput);
 
+/**
+ * \brief   A chunk to sign then encrypt with SOPC_CryptoProvider_SymmetricSignEncryptBatch().
+ *
+ * The bytes [0, lenToSign[ of \p pData are signed and the signature is written right after them.
+ * Then the bytes [offsetToEncrypt, lenToSign + signature length[ of \p pData are encrypted in \p pOutput.
+ * The payload to encrypt must already be padded.
+ */
+typedef struct SOPC_CryptoProvider_SymmetricJob
+{
+    const SOPC_CryptoProvider* pProvider; /**< Cryptographic context of the chunk secure channel */
+    SOPC_SecretBuffer* pSignKey;          /**< Symmetric signing key */
+    SOPC_SecretBuffer* pEncryptKey;       /**< Symmetric encryption key, NULL to only sign the chunk */
+    SOPC_SecretBuffer* pIV;               /**< Initialization vector, NULL to only sign the chunk */
+    uint8_t* pData;                       /**< Bytes to sign, followed by the room for the signature */
+    uint32_t lenToSign;                   /**< Number of bytes to sign, the signature is written at pData + lenToSign */
+    uint32_t offsetToEncrypt;             /**< Offset in pData of the first byte to encrypt */
+    uint8_t* pOutput;                     /**< Buffer of the ciphered bytes, it may be pData + offsetToEncrypt */
+    uint32_t lenOutput;                   /**< The exact length of the ciphered bytes */
+    SOPC_ReturnStatus status;             /**< Output: the result of the operation on this chunk */
+} SOPC_CryptoProvider_SymmetricJob;
+
+/**
+ * \brief           Signs then encrypts several chunks, possibly from different secure channels, in one call.
+ *
+ *   Each job is verified as in SOPC_CryptoProvider_SymmetricSign() and SOPC_CryptoProvider_SymmetricEncrypt().
+ *   Consecutive jobs sharing the same security policy are given together to the cryptographic library,
+ *   which may then reuse its hash and cipher contexts from one chunk to the other.
+ *   Jobs are therefore best sorted by security policy and by keys.
+ *
+ * \param pJobs     A valid pointer to an array of \p nbJobs jobs. The status of each job is set.
+ * \param nbJobs    The number of jobs, which shall be greater than 0.
+ *
+ * \note            Content of the output of a job is unspecified when its status is not SOPC_STATUS_OK.
+ *
+ * \note            Specific to client-server security policies.
+ *
+ * \return          SOPC_STATUS_OK when all the jobs succeeded, SOPC_STATUS_INVALID_PARAMETERS when parameters are
+ *                  NULL or 0, and otherwise the status of the first job which failed.
+ */
+SOPC_ReturnStatus SOPC_CryptoProvider_SymmetricSignEncryptBatch(SOPC_CryptoProvider_SymmetricJob* pJobs,
+                                                                uint32_t nbJobs);
+
 /* ------------------------------------------------------------------------------------------------
  * Random and pseudo-random functionalities
  * ------------------------------------------------------------------------------------------------
@@ -672,6 +714,27 @@ SOPC_ReturnStatus SOPC_CryptoProvider_GenerateRandomBytes(const SOPC_CryptoProvi
                                                           uint32_t nBytes,
                                                           SOPC_ExposedBuffer** ppBuffer);
 
+/**
+ * \brief           Fills an existing buffer with truly random data.
+ *
+ *   Same as SOPC_CryptoProvider_GenerateRandomBytes() without allocation, e.g. to renew a nonce for each message.
+ *
+ * \param pProvider An initialized cryptographic context.
+ * \param pBuffer   A valid pointer to a buffer of at least \p nBytes bytes.
+ * \param nBytes    Number of bytes to generate.
+ *
+ * \note            Content of the output is unspecified when return value is not SOPC_STATUS_OK.
+ *
+ * \note            For both client-server and PubSub security policies.
+ *
+ * \return          SOPC_STATUS_OK when successful, SOPC_STATUS_INVALID_PARAMETERS when parameters are NULL or
+ *                  \p pProvider not correctly initialized or \p nBytes is 0,
+ *                  and SOPC_STATUS_NOK when there was an error (e.g. no entropy source).
+ */
+SOPC_ReturnStatus SOPC_CryptoProvider_FillRandomBytes(const SOPC_CryptoProvider* pProvider,
+                                                      SOPC_ExposedBuffer* pBuffer,
+                                                      uint32_t nBytes);
+
 /**
  * \brief           Generates a single truly random nonce for the SecureChannel creation.
  *
@@ -21,21 +21,28 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <inttypes.h>
 #include "sopc_assert.h"
 #include "sopc_buffer.h"
 #include "sopc_common_constants.h"
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
 
-/* 2^32 = 4294967296 maximum number you could represent plus \0 at the end */
-#define SOPC_MAX_LENGTH_UINT32_TO_STRING 11
+/* 2^32 = 4294967296 maximum number you could represent */
+#define SOPC_MAX_DIGITS_UINT32 10
 
-/* 2^31 = 2147483648 maximum number you could represent plus \0 at the end plus '-'*/
-#define SOPC_MAX_LENGTH_INT32_TO_STRING 12
+/* Number of significant digits sufficient to print any double (resp. float) so that it reads back to the same value */
+#define SOPC_MAX_DIGITS_DOUBLE 17
+#define SOPC_MAX_DIGITS_FLOAT 9
 
-/* A MINIMUM of 4 is required  ! (or problems such as infinite management appear.) */
-#define SOPC_PRECISION_PRINTING_FLOAT_NUMBERS 10
+/* Longest printed double: '-0.000' followed by the digits, or '-d.' followed by the digits and 'e-ddd' */
+#define SOPC_MAX_LENGTH_DOUBLE_TO_STRING (SOPC_MAX_DIGITS_DOUBLE + 8)
+
+/* Decimal representation of the numbers from 0 to 99 on 2 digits */
+static const char SOPC_DIGIT_PAIRS[] = "0001020304050607080910111213141516171819"
+                                       "2021222324252627282930313233343536373839"
+                                       "4041424344454647484950515253545556575859"
+                                       "6061626364656667686970717273747576777879"
+                                       "8081828384858687888990919293949596979899";
 
 static SOPC_ReturnStatus SOPC_Buffer_Init(SOPC_Buffer* buffer, uint32_t initial_size, uint32_t maximum_size)
 {
@@ -476,37 +483,421 @@ SOPC_ReturnStatus SOPC_Buffer_ReadFile(const char* path, SOPC_Buffer** buf)
 
 #endif // SOPC_HAS_FILESYSTEM
 
-SOPC_ReturnStatus SOPC_Buffer_PrintU32(SOPC_Buffer* buf, const uint32_t value)
+/* Writes the decimal digits of value backwards from end (excluded), returns the first written character */
+static char* format_u32(uint32_t value, char* end)
 {
-    SOPC_ReturnStatus status = SOPC_STATUS_NOK;
-    char buffer[SOPC_MAX_LENGTH_UINT32_TO_STRING];
-    int res = snprintf(buffer, SOPC_MAX_LENGTH_UINT32_TO_STRING, "%" PRIu32, value);
-    if (res > 0 && res < SOPC_MAX_LENGTH_UINT32_TO_STRING)
+    char* p = end;
+    while (value >= 100)
     {
-        status = SOPC_Buffer_Write(buf, (const uint8_t*) buffer, (uint32_t) strlen(buffer));
+        const uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--p = SOPC_DIGIT_PAIRS[pair + 1];
+        *--p = SOPC_DIGIT_PAIRS[pair];
     }
-    return status;
+    if (value >= 10)
+    {
+        *--p = SOPC_DIGIT_PAIRS[value * 2 + 1];
+        *--p = SOPC_DIGIT_PAIRS[value * 2];
+    }
+    else
+    {
+        *--p = (char) ('0' + value);
+    }
+    return p;
+}
+
+SOPC_ReturnStatus SOPC_Buffer_PrintU32(SOPC_Buffer* buf, const uint32_t value)
+{
+    char buffer[SOPC_MAX_DIGITS_UINT32];
+    char* end = buffer + SOPC_MAX_DIGITS_UINT32;
+    const char* start = format_u32(value, end);
+    return SOPC_Buffer_Write(buf, (const uint8_t*) start, (uint32_t)(end - start));
 }
 
 SOPC_ReturnStatus SOPC_Buffer_PrintI32(SOPC_Buffer* buf, const int32_t value)
 {
-    SOPC_ReturnStatus status = SOPC_STATUS_NOK;
-    char buffer[SOPC_MAX_LENGTH_INT32_TO_STRING];
-    int res = snprintf(buffer, SOPC_MAX_LENGTH_INT32_TO_STRING, "%" PRIi32, value);
-    if (res > 0 && res < SOPC_MAX_LENGTH_INT32_TO_STRING)
+    char buffer[SOPC_MAX_DIGITS_UINT32 + 1]; // '-' + digits
+    char* end = buffer + SOPC_MAX_DIGITS_UINT32 + 1;
+    // Absolute value computed as unsigned to manage INT32_MIN
+    char* start = format_u32(value < 0 ? 0u - (uint32_t) value : (uint32_t) value, end);
+    if (value < 0)
     {
-        status = SOPC_Buffer_Write(buf, (const uint8_t*) buffer, (uint32_t) strlen(buffer));
+        *--start = '-';
     }
-    return status;
+    return SOPC_Buffer_Write(buf, (const uint8_t*) start, (uint32_t)(end - start));
 }
 
-SOPC_ReturnStatus SOPC_Buffer_PrintFloatDouble(SOPC_Buffer* buf, const double value)
+/*
+ * Shortest round-trip formatting of floating point numbers, based on the Grisu2 algorithm of Florian Loitsch
+ * ("Printing Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010).
+ * It generates the shortest (in most cases) digits string that reads back to the exact same value, using only
+ * 64 bits integer arithmetic.
+ */
+
+/* Floating point number f * 2^e with a 64 bits significand */
+typedef struct SOPC_DiyFp
+{
+    uint64_t f;
+    int e;
+} SOPC_DiyFp;
+
+/* Normalized approximation f * 2^e of 10^k */
+typedef struct SOPC_CachedPower
+{
+    uint64_t f;
+    int e;
+    int k;
+} SOPC_CachedPower;
+
+/* Range [ALPHA, GAMMA] of the binary exponent of the scaled value, chosen to generate the digits with 32 bits */
+#define SOPC_GRISU_ALPHA (-60)
+#define SOPC_GRISU_GAMMA (-32)
+
+/* Decimal exponent of the first cached power and step between two cached powers */
+#define SOPC_GRISU_CACHED_POWERS_MIN_DEC_EXP (-300)
+#define SOPC_GRISU_CACHED_POWERS_DEC_STEP 8
+
+/* Normalized powers of ten 10^k for k in [-300, 324] with a step of 8, rounded to the nearest */
+static const SOPC_CachedPower SOPC_GRISU_CACHED_POWERS[] = {
+    {UINT64_C(0xAB70FE17C79AC6CA), -1060, -300},
+    {UINT64_C(0xFF77B1FCBEBCDC4F), -1034, -292},
+    {UINT64_C(0xBE5691EF416BD60C), -1007, -284},
+    {UINT64_C(0x8DD01FAD907FFC3C), -980, -276},
+    {UINT64_C(0xD3515C2831559A83), -954, -268},
+    {UINT64_C(0x9D71AC8FADA6C9B5), -927, -260},
+    {UINT64_C(0xEA9C227723EE8BCB), -901, -252},
+    {UINT64_C(0xAECC49914078536D), -874, -244},
+    {UINT64_C(0x823C12795DB6CE57), -847, -236},
+    {UINT64_C(0xC21094364DFB5637), -821, -228},
+    {UINT64_C(0x9096EA6F3848984F), -794, -220},
+    {UINT64_C(0xD77485CB25823AC7), -768, -212},
+    {UINT64_C(0xA086CFCD97BF97F4), -741, -204},
+    {UINT64_C(0xEF340A98172AACE5), -715, -196},
+    {UINT64_C(0xB23867FB2A35B28E), -688, -188},
+    {UINT64_C(0x84C8D4DFD2C63F3B), -661, -180},
+    {UINT64_C(0xC5DD44271AD3CDBA), -635, -172},
+    {UINT64_C(0x936B9FCEBB25C996), -608, -164},
+    {UINT64_C(0xDBAC6C247D62A584), -582, -156},
+    {UINT64_C(0xA3AB66580D5FDAF6), -555, -148},
+    {UINT64_C(0xF3E2F893DEC3F126), -529, -140},
+    {UINT64_C(0xB5B5ADA8AAFF80B8), -502, -132},
+    {UINT64_C(0x87625F056C7C4A8B), -475, -124},
+    {UINT64_C(0xC9BCFF6034C13053), -449, -116},
+    {UINT64_C(0x964E858C91BA2655), -422, -108},
+    {UINT64_C(0xDFF9772470297EBD), -396, -100},
+    {UINT64_C(0xA6DFBD9FB8E5B88F), -369, -92},
+    {UINT64_C(0xF8A95FCF88747D94), -343, -84},
+    {UINT64_C(0xB94470938FA89BCF), -316, -76},
+    {UINT64_C(0x8A08F0F8BF0F156B), -289, -68},
+    {UINT64_C(0xCDB02555653131B6), -263, -60},
+    {UINT64_C(0x993FE2C6D07B7FAC), -236, -52},
+    {UINT64_C(0xE45C10C42A2B3B06), -210, -44},
+    {UINT64_C(0xAA242499697392D3), -183, -36},
+    {UINT64_C(0xFD87B5F28300CA0E), -157, -28},
+    {UINT64_C(0xBCE5086492111AEB), -130, -20},
+    {UINT64_C(0x8CBCCC096F5088CC), -103, -12},
+    {UINT64_C(0xD1B71758E219652C), -77, -4},
+    {UINT64_C(0x9C40000000000000), -50, 4},
+    {UINT64_C(0xE8D4A51000000000), -24, 12},
+    {UINT64_C(0xAD78EBC5AC620000), 3, 20},
+    {UINT64_C(0x813F3978F8940984), 30, 28},
+    {UINT64_C(0xC097CE7BC90715B3), 56, 36},
+    {UINT64_C(0x8F7E32CE7BEA5C70), 83, 44},
+    {UINT64_C(0xD5D238A4ABE98068), 109, 52},
+    {UINT64_C(0x9F4F2726179A2245), 136, 60},
+    {UINT64_C(0xED63A231D4C4FB27), 162, 68},
+    {UINT64_C(0xB0DE65388CC8ADA8), 189, 76},
+    {UINT64_C(0x83C7088E1AAB65DB), 216, 84},
+    {UINT64_C(0xC45D1DF942711D9A), 242, 92},
+    {UINT64_C(0x924D692CA61BE758), 269, 100},
+    {UINT64_C(0xDA01EE641A708DEA), 295, 108},
+    {UINT64_C(0xA26DA3999AEF774A), 322, 116},
+    {UINT64_C(0xF209787BB47D6B85), 348, 124},
+    {UINT64_C(0xB454E4A179DD1877), 375, 132},
+    {UINT64_C(0x865B86925B9BC5C2), 402, 140},
+    {UINT64_C(0xC83553C5C8965D3D), 428, 148},
+    {UINT64_C(0x952AB45CFA97A0B3), 455, 156},
+    {UINT64_C(0xDE469FBD99A05FE3), 481, 164},
+    {UINT64_C(0xA59BC234DB398C25), 508, 172},
+    {UINT64_C(0xF6C69A72A3989F5C), 534, 180},
+    {UINT64_C(0xB7DCBF5354E9BECE), 561, 188},
+    {UINT64_C(0x88FCF317F22241E2), 588, 196},
+    {UINT64_C(0xCC20CE9BD35C78A5), 614, 204},
+    {UINT64_C(0x98165AF37B2153DF), 641, 212},
+    {UINT64_C(0xE2A0B5DC971F303A), 667, 220},
+    {UINT64_C(0xA8D9D1535CE3B396), 694, 228},
+    {UINT64_C(0xFB9B7CD9A4A7443C), 720, 236},
+    {UINT64_C(0xBB764C4CA7A44410), 747, 244},
+    {UINT64_C(0x8BAB8EEFB6409C1A), 774, 252},
+    {UINT64_C(0xD01FEF10A657842C), 800, 260},
+    {UINT64_C(0x9B10A4E5E9913129), 827, 268},
+    {UINT64_C(0xE7109BFBA19C0C9D), 853, 276},
+    {UINT64_C(0xAC2820D9623BF429), 880, 284},
+    {UINT64_C(0x80444B5E7AA7CF85), 907, 292},
+    {UINT64_C(0xBF21E44003ACDD2D), 933, 300},
+    {UINT64_C(0x8E679C2F5E44FF8F), 960, 308},
+    {UINT64_C(0xD433179D9C8CB841), 986, 316},
+    {UINT64_C(0x9E19DB92B4E31BA9), 1013, 324},
+};
+
+static SOPC_DiyFp diyfp_sub(SOPC_DiyFp x, SOPC_DiyFp y)
+{
+    SOPC_ASSERT(x.e == y.e && x.f >= y.f);
+    SOPC_DiyFp res = {x.f - y.f, x.e};
+    return res;
+}
+
+/* Returns x * y rounded to the 64 most significant bits */
+static SOPC_DiyFp diyfp_mul(SOPC_DiyFp x, SOPC_DiyFp y)
+{
+    const uint64_t xLo = x.f & UINT32_MAX;
+    const uint64_t xHi = x.f >> 32;
+    const uint64_t yLo = y.f & UINT32_MAX;
+    const uint64_t yHi = y.f >> 32;
+
+    const uint64_t p0 = xLo * yLo;
+    const uint64_t p1 = xLo * yHi;
+    const uint64_t p2 = xHi * yLo;
+    const uint64_t p3 = xHi * yHi;
+
+    uint64_t q = (p0 >> 32) + (p1 & UINT32_MAX) + (p2 & UINT32_MAX);
+    q += UINT64_C(1) << 31; // Round the lower half
+
+    SOPC_DiyFp res = {p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64};
+    return res;
+}
+
+static SOPC_DiyFp diyfp_normalize(SOPC_DiyFp x)
+{
+    SOPC_ASSERT(0 != x.f);
+    while (0 == (x.f >> 63))
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+static SOPC_DiyFp diyfp_normalize_to(SOPC_DiyFp x, int e)
+{
+    SOPC_ASSERT(x.e >= e && x.e - e < 64);
+    SOPC_DiyFp res = {x.f << (x.e - e), e};
+    return res;
+}
+
+/*
+ * Computes the normalized value v of a non-zero finite IEEE 754 number from its fraction and biased exponent fields,
+ * and the boundaries m- and m+ of the interval of the real numbers rounded to it (with the same exponent as v).
+ */
+static void grisu_compute_boundaries(uint64_t fraction,
+                                     int biasedExp,
+                                     int fractionBits,
+                                     int bias,
+                                     SOPC_DiyFp* mMinus,
+                                     SOPC_DiyFp* v,
+                                     SOPC_DiyFp* mPlus)
+{
+    SOPC_DiyFp w = {fraction, 1 - bias - fractionBits};
+    if (0 != biasedExp)
+    {
+        w.f += UINT64_C(1) << fractionBits;
+        w.e = biasedExp - bias - fractionBits;
+    }
+    // The lower boundary is closer for a power of two (except for the smallest normal number)
+    const bool lowerBoundaryIsCloser = (0 == fraction && biasedExp > 1);
+    SOPC_DiyFp plus = {2 * w.f + 1, w.e - 1};
+    SOPC_DiyFp minus = {2 * w.f - 1, w.e - 1};
+    if (lowerBoundaryIsCloser)
+    {
+        minus.f = 4 * w.f - 1;
+        minus.e = w.e - 2;
+    }
+    *mPlus = diyfp_normalize(plus);
+    *mMinus = diyfp_normalize_to(minus, mPlus->e);
+    *v = diyfp_normalize(w);
+}
+
+/* Returns the cached power c = 10^k such that the binary exponent of c * 2^e is in [ALPHA, GAMMA] */
+static SOPC_CachedPower grisu_get_cached_power(int e)
+{
+    // k = ceil((ALPHA - e - 1) * log10(2)), with 78913 / 2^18 ~ log10(2)
+    const int f = SOPC_GRISU_ALPHA - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    const int index = (k - SOPC_GRISU_CACHED_POWERS_MIN_DEC_EXP + SOPC_GRISU_CACHED_POWERS_DEC_STEP - 1) /
+                      SOPC_GRISU_CACHED_POWERS_DEC_STEP;
+    SOPC_ASSERT(index >= 0 && (size_t) index < sizeof(SOPC_GRISU_CACHED_POWERS) / sizeof(SOPC_CachedPower));
+    const SOPC_CachedPower cached = SOPC_GRISU_CACHED_POWERS[index];
+    SOPC_ASSERT(cached.e + e + 64 >= SOPC_GRISU_ALPHA && cached.e + e + 64 <= SOPC_GRISU_GAMMA);
+    return cached;
+}
+
+/* Returns the number of digits of n (n < 10^10) and sets pow10 to 10^(digits - 1) */
+static int grisu_find_largest_pow10(uint32_t n, uint32_t* pow10)
+{
+    int digits = 10;
+    uint32_t p = 1000000000;
+    while (digits > 1 && n < p)
+    {
+        p /= 10;
+        digits--;
+    }
+    *pow10 = p;
+    return digits;
+}
+
+/* Moves the last digit towards the value v as long as it stays in the rounding interval */
+static void grisu_round(char* digits, int nbDigits, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK)
+{
+    while (rest < dist && delta - rest >= tenK && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+    {
+        digits[nbDigits - 1]--;
+        rest += tenK;
+    }
+}
+
+/*
+ * Generates the shortest digits of a number in the interval [mMinus, mPlus] and closest to v.
+ * Returns the number of digits and sets decimalExponent so that the number is digits * 10^decimalExponent.
+ */
+static int grisu2(char* digits, int* decimalExponent, SOPC_DiyFp mMinus, SOPC_DiyFp v, SOPC_DiyFp mPlus)
+{
+    // Scale the values so that their binary exponent is in [ALPHA, GAMMA]
+    const SOPC_CachedPower cached = grisu_get_cached_power(mPlus.e);
+    const SOPC_DiyFp c = {cached.f, cached.e};
+    const SOPC_DiyFp w = diyfp_mul(v, c);
+    SOPC_DiyFp wMinus = diyfp_mul(mMinus, c);
+    SOPC_DiyFp wPlus = diyfp_mul(mPlus, c);
+    // Shrink the interval to take into account the imprecision of the multiplications
+    wMinus.f++;
+    wPlus.f--;
+    *decimalExponent = -cached.k;
+
+    uint64_t delta = diyfp_sub(wPlus, wMinus).f;
+    uint64_t dist = diyfp_sub(wPlus, w).f;
+
+    // Split wPlus in integral part p1 (< 2^32) and fractional part p2
+    const SOPC_DiyFp one = {UINT64_C(1) << -wPlus.e, wPlus.e};
+    uint32_t p1 = (uint32_t)(wPlus.f >> -one.e);
+    uint64_t p2 = wPlus.f & (one.f - 1);
+
+    int nbDigits = 0;
+    uint32_t pow10 = 0;
+    int n = grisu_find_largest_pow10(p1, &pow10);
+    while (n > 0)
+    {
+        digits[nbDigits++] = (char) ('0' + p1 / pow10);
+        p1 %= pow10;
+        n--;
+        const uint64_t rest = ((uint64_t) p1 << -one.e) + p2;
+        if (rest <= delta)
+        {
+            *decimalExponent += n;
+            grisu_round(digits, nbDigits, dist, delta, rest, (uint64_t) pow10 << -one.e);
+            return nbDigits;
+        }
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    do
+    {
+        p2 *= 10;
+        digits[nbDigits++] = (char) ('0' + (p2 >> -one.e));
+        p2 &= one.f - 1;
+        m++;
+        delta *= 10;
+        dist *= 10;
+    } while (p2 > delta);
+    *decimalExponent -= m;
+    grisu_round(digits, nbDigits, dist, delta, p2, one.f);
+    return nbDigits;
+}
+
+/*
+ * Writes the digits * 10^decimalExponent number as printf '%g' with precision maxDigits would do once rounded to
+ * these digits, returns the number of written characters.
+ */
+static uint32_t format_shortest(char* out, const char* digits, int nbDigits, int decimalExponent, int maxDigits)
+{
+    // Exponent of the first digit
+    const int exp10 = nbDigits + decimalExponent - 1;
+    char* p = out;
+
+    if (exp10 >= -4 && exp10 < maxDigits)
+    {
+        if (exp10 < 0)
+        {
+            // 0.000ddd
+            *p++ = '0';
+            *p++ = '.';
+            for (int i = exp10 + 1; i < 0; i++)
+            {
+                *p++ = '0';
+            }
+            memcpy(p, digits, (size_t) nbDigits);
+            p += nbDigits;
+        }
+        else if (exp10 + 1 >= nbDigits)
+        {
+            // ddd000
+            memcpy(p, digits, (size_t) nbDigits);
+            p += nbDigits;
+            for (int i = nbDigits; i <= exp10; i++)
+            {
+                *p++ = '0';
+            }
+        }
+        else
+        {
+            // dd.ddd
+            memcpy(p, digits, (size_t) exp10 + 1);
+            p += exp10 + 1;
+            *p++ = '.';
+            memcpy(p, digits + exp10 + 1, (size_t)(nbDigits - exp10 - 1));
+            p += nbDigits - exp10 - 1;
+        }
+    }
+    else
+    {
+        // d.ddde+dd
+        *p++ = digits[0];
+        if (nbDigits > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t) nbDigits - 1);
+            p += nbDigits - 1;
+        }
+        *p++ = 'e';
+        *p++ = (exp10 < 0 ? '-' : '+');
+        uint32_t absExp = (uint32_t)(exp10 < 0 ? -exp10 : exp10);
+        if (absExp >= 100)
+        {
+            *p++ = (char) ('0' + absExp / 100);
+            absExp %= 100;
+        }
+        *p++ = SOPC_DIGIT_PAIRS[absExp * 2];
+        *p++ = SOPC_DIGIT_PAIRS[absExp * 2 + 1];
+    }
+    return (uint32_t)(p - out);
+}
+
+/*
+ * Prints a floating point number given as double value and as IEEE 754 fields of its actual type (sign, fraction and
+ * biased exponent) with the shortest digits that read back to the same value of the actual type.
+ */
+static SOPC_ReturnStatus print_shortest(SOPC_Buffer* buf,
+                                        double value,
+                                        bool negative,
+                                        uint64_t fraction,
+                                        int biasedExp,
+                                        int fractionBits,
+                                        int bias,
+                                        int maxDigits)
 {
     static const char* infinity_str_json_format = "\"Infinity\"";
     static const char* infinity_str_minus_json_format = "\"-Infinity\"";
     static const char* nan_str_json_format = "\"NaN\"";
     SOPC_ReturnStatus status = SOPC_STATUS_NOK;
-    char buffer[SOPC_PRECISION_PRINTING_FLOAT_NUMBERS + 8]; // (decimal + '-.e+ddd' + '\0')
 
     /* Check if value is a special number */
     // If it's a NaN
@@ -515,13 +906,13 @@ SOPC_ReturnStatus SOPC_Buffer_PrintFloatDouble(SOPC_Buffer* buf, const double va
         status = SOPC_Buffer_Write(buf, (const uint8_t*) nan_str_json_format, (uint32_t) strlen(nan_str_json_format));
     }
     // If it's a +Inf
-    else if (1 == isinf(value))
+    else if (isinf(value) && !negative)
     {
         status = SOPC_Buffer_Write(buf, (const uint8_t*) infinity_str_json_format,
                                    (uint32_t) strlen(infinity_str_json_format));
     }
     // If it's a -Inf
-    else if (-1 == isinf(value))
+    else if (isinf(value))
     {
         status = SOPC_Buffer_Write(buf, (const uint8_t*) infinity_str_minus_json_format,
                                    (uint32_t) strlen(infinity_str_minus_json_format));
@@ -529,13 +920,46 @@ SOPC_ReturnStatus SOPC_Buffer_PrintFloatDouble(SOPC_Buffer* buf, const double va
     // Else, it's a normal decimal number
     else
     {
-        int res = snprintf(buffer, SOPC_PRECISION_PRINTING_FLOAT_NUMBERS + 8, "%.*g",
-                           SOPC_PRECISION_PRINTING_FLOAT_NUMBERS, value);
-        if (res > 0 && res < SOPC_PRECISION_PRINTING_FLOAT_NUMBERS + 8)
+        char buffer[SOPC_MAX_LENGTH_DOUBLE_TO_STRING];
+        uint32_t length = 0;
+        if (negative)
+        {
+            buffer[length++] = '-';
+        }
+        if (0 == fraction && 0 == biasedExp)
         {
-            status = SOPC_Buffer_Write(buf, (const uint8_t*) buffer, (uint32_t) strlen(buffer));
+            buffer[length++] = '0';
         }
+        else
+        {
+            char digits[SOPC_MAX_DIGITS_DOUBLE];
+            int decimalExponent = 0;
+            SOPC_DiyFp mMinus;
+            SOPC_DiyFp v;
+            SOPC_DiyFp mPlus;
+            grisu_compute_boundaries(fraction, biasedExp, fractionBits, bias, &mMinus, &v, &mPlus);
+            const int nbDigits = grisu2(digits, &decimalExponent, mMinus, v, mPlus);
+            SOPC_ASSERT(nbDigits <= maxDigits);
+            length += format_shortest(buffer + length, digits, nbDigits, decimalExponent, maxDigits);
+        }
+        status = SOPC_Buffer_Write(buf, (const uint8_t*) buffer, length);
     }
 
     return status;
 }
+
+SOPC_ReturnStatus SOPC_Buffer_PrintFloatDouble(SOPC_Buffer* buf, const double value)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return print_shortest(buf, value, 0 != (bits >> 63), bits & ((UINT64_C(1) << 52) - 1), (int) ((bits >> 52) & 0x7FF),
+                          52, 1023, SOPC_MAX_DIGITS_DOUBLE);
+}
+
+SOPC_ReturnStatus SOPC_Buffer_PrintFloat(SOPC_Buffer* buf, const float value)
+{
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return print_shortest(buf, (double) value, 0 != (bits >> 31), bits & ((UINT32_C(1) << 23) - 1),
+                          (int) ((bits >> 23) & 0xFF), 23, 127, SOPC_MAX_DIGITS_FLOAT);
+}
@@ -257,7 +257,8 @@ SOPC_ReturnStatus SOPC_Buffer_PrintI32(SOPC_Buffer* buf, const int32_t value);
  * position and length if necessary)
  * The float/double format written in the buffer does not take into account the spacing for '-' in the case
  * of a positive value.
- * The output is equivalent to '%.*g' print format with SOPC_PRECISION_PRINTING_FLOAT_NUMBERS as precision.
+ * The value is printed with the shortest digits that read back to the same double value, with the notation used
+ * by the '%.17g' print format (for exemple '0.1' instead of '0.10000000000000001').
  * There is no terminating NULL character added at the end of the printed value.
  *
  * For exemple : '42', '-4.3e+111'
@@ -277,4 +278,19 @@ SOPC_ReturnStatus SOPC_Buffer_PrintI32(SOPC_Buffer* buf, const int32_t value);
  */
 SOPC_ReturnStatus SOPC_Buffer_PrintFloatDouble(SOPC_Buffer* buf, const double value);
 
+/**
+ *  \brief             Print the value into the buffer data bytes from the buffer position (adapting buffer
+ * position and length if necessary)
+ * The value is printed as ::SOPC_Buffer_PrintFloatDouble does, but with the shortest digits that read back to the
+ * same float value (for exemple '0.1' instead of '0.100000001' for the float nearest to 0.1), with the notation used
+ * by the '%.9g' print format.
+ *
+ *  \param value       float to print into the buffer
+ *  \param buf         Pointer to the buffer to write into
+ *
+ *  \return            SOPC_STATUS_OK if succeeded, an error code otherwise (NULL pointer, non allocated buffer
+ * content, full buffer avoiding operation)
+ */
+SOPC_ReturnStatus SOPC_Buffer_PrintFloat(SOPC_Buffer* buf, const float value);
+
 #endif /* SOPC_BUFFER_H_ */
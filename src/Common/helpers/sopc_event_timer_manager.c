@@ -51,6 +51,8 @@ static SOPC_SLinkedList* timers = NULL;
 static SOPC_SLinkedList* periodicTimersToRestart = NULL;
 
 static SOPC_Mutex timersMutex;
+/* Signaled when the next timer to expire changed or when the manager is stopped */
+static SOPC_Condition timersCond;
 static int32_t initialized = 0;
 static int32_t stop = 0;
 static bool timerCreationFailed = false;
@@ -187,15 +189,17 @@ static void SOPC_Internal_EventTimer_Cancel_WithoutLock(uint32_t timerId)
     }
 }
 
-static void SOPC_EventTimer_CyclicTimersEvaluation(void)
+// Caller should lock the mutex
+// Returns the delay in milliseconds until the next timer expiration, bounded by SOPC_TIMER_RESOLUTION_MS
+static uint32_t SOPC_EventTimer_CyclicTimersEvaluation_WithoutLock(void)
 {
     SOPC_SLinkedListIterator timerIt = NULL;
     SOPC_EventTimer* timer = NULL;
     SOPC_TimeReference currentTimeRef = 0;
     int8_t compareResult = 0;
     uint32_t timerId = 0;
+    uint32_t waitMs = SOPC_TIMER_RESOLUTION_MS;
 
-    SOPC_Mutex_Lock(&timersMutex);
     timerIt = SOPC_SLinkedList_GetIterator(timers);
     timer = (SOPC_EventTimer*) SOPC_SLinkedList_Next(&timerIt);
     currentTimeRef = SOPC_TimeReference_GetCurrent();
@@ -275,7 +279,22 @@ static void SOPC_EventTimer_CyclicTimersEvaluation(void)
             SOPC_InternalEventTimer_RestartPeriodicTimer_WithoutLock(timer);
         }
     }
-    SOPC_Mutex_Unlock(&timersMutex);
+
+    // Compute the delay until next timer expiration
+    timer = (SOPC_EventTimer*) SOPC_SLinkedList_GetHead(timers);
+    if (NULL != timer)
+    {
+        currentTimeRef = SOPC_TimeReference_GetCurrent();
+        if (SOPC_TimeReference_Compare(currentTimeRef, timer->endTime) >= 0)
+        {
+            waitMs = 0;
+        }
+        else if (timer->endTime - currentTimeRef < SOPC_TIMER_RESOLUTION_MS)
+        {
+            waitMs = (uint32_t)(timer->endTime - currentTimeRef);
+        }
+    }
+    return waitMs;
 }
 
 static void* SOPC_Internal_ThreadLoop(void* arg)
@@ -287,11 +306,18 @@ static void* SOPC_Internal_ThreadLoop(void* arg)
         return NULL;
     }
 
+    // Wait until next timer expiration instead of a fixed resolution period:
+    // timers creation and manager stop wake up the thread through the condition variable
+    SOPC_Mutex_Lock(&timersMutex);
     while (!is_stopped())
     {
-        SOPC_EventTimer_CyclicTimersEvaluation();
-        SOPC_Sleep(SOPC_TIMER_RESOLUTION_MS);
+        uint32_t waitMs = SOPC_EventTimer_CyclicTimersEvaluation_WithoutLock();
+        if (waitMs > 0 && !is_stopped())
+        {
+            SOPC_Mutex_UnlockAndTimedWaitCond(&timersCond, &timersMutex, waitMs);
+        }
     }
+    SOPC_Mutex_Unlock(&timersMutex);
     return NULL;
 }
 
@@ -303,6 +329,7 @@ void SOPC_EventTimer_Initialize(void)
     }
 
     SOPC_Mutex_Initialization(&timersMutex);
+    SOPC_Condition_Init(&timersCond);
     memset(usedTimerIds, false, sizeof(bool) * (SOPC_MAX_TIMERS + 1)); // 0 idx value is invalid (max idx = MAX + 1)
     timers = SOPC_SLinkedList_Create(SOPC_MAX_TIMERS);
     periodicTimersToRestart = SOPC_SLinkedList_Create(SOPC_MAX_TIMERS);
@@ -328,7 +355,10 @@ void SOPC_EventTimer_PreClear(void)
     if (!is_stopped())
     {
         // Stop timer cyclic evaluation thread
+        SOPC_Mutex_Lock(&timersMutex);
         SOPC_Atomic_Int_Set(&stop, 1);
+        SOPC_Condition_SignalAll(&timersCond);
+        SOPC_Mutex_Unlock(&timersMutex);
         SOPC_Thread_Join(cyclicEvalThread);
     }
 }
@@ -347,6 +377,7 @@ void SOPC_EventTimer_Clear(void)
     SOPC_SLinkedList_Delete(periodicTimersToRestart);
     periodicTimersToRestart = NULL;
     SOPC_Mutex_Unlock(&timersMutex);
+    SOPC_Condition_Clear(&timersCond);
     SOPC_Mutex_Clear(&timersMutex);
 }
 
@@ -360,13 +391,12 @@ static uint32_t SOPC_InternalEventTimer_Create(SOPC_EventHandler* eventHandler,
         return 0;
     }
 
-    if (isPeriodic && msDelay < 2 * SOPC_TIMER_RESOLUTION_MS)
+    if (isPeriodic && msDelay < SOPC_TIMER_MIN_PERIOD_MS)
     {
-        SOPC_Logger_TraceError(
-            SOPC_LOG_MODULE_COMMON,
-            "EventTimerManager: creating an event timer with a period value less than 2 times the event timers "
-            "resolution (%" PRIu64 " < 2*%u) with event=%" PRIi32,
-            msDelay, SOPC_TIMER_RESOLUTION_MS, event.event);
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_COMMON,
+                               "EventTimerManager: creating an event timer with a period value less than the minimum "
+                               "period (%" PRIu64 " < %u) with event=%" PRIi32,
+                               msDelay, SOPC_TIMER_MIN_PERIOD_MS, event.event);
         return 0;
     }
 
@@ -406,6 +436,11 @@ static uint32_t SOPC_InternalEventTimer_Create(SOPC_EventHandler* eventHandler,
             result = 0;
             SOPC_Free(newTimer);
         }
+        else if (newTimer == (SOPC_EventTimer*) SOPC_SLinkedList_GetHead(timers))
+        {
+            // Next timer to expire changed: wake up the evaluation thread to update its waiting delay
+            SOPC_Condition_SignalAll(&timersCond);
+        }
     } // else 0 is invalid value => no timer available
     else
     {
@@ -445,13 +480,12 @@ bool SOPC_EventTimer_ModifyPeriodic(uint32_t timerId, uint64_t msPeriod)
     timer = (SOPC_EventTimer*) SOPC_SLinkedList_FindFromId(timers, timerId);
     if (timer != NULL && timer->isPeriodicTimer)
     {
-        if (msPeriod < 2 * SOPC_TIMER_RESOLUTION_MS)
+        if (msPeriod < SOPC_TIMER_MIN_PERIOD_MS)
         {
-            SOPC_Logger_TraceError(
-                SOPC_LOG_MODULE_COMMON,
-                "EventTimerManager: modifying an event timer with a period value less than 2 times the event timers "
-                "resolution (%" PRIu64 " < 2*%u) with id=%" PRIu32 "event=%" PRIi32,
-                msPeriod, SOPC_TIMER_RESOLUTION_MS, timerId, timer->event.event);
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_COMMON,
+                                   "EventTimerManager: modifying an event timer with a period value less than the "
+                                   "minimum period (%" PRIu64 " < %u) with id=%" PRIu32 "event=%" PRIi32,
+                                   msPeriod, SOPC_TIMER_MIN_PERIOD_MS, timerId, timer->event.event);
         }
         else
         {
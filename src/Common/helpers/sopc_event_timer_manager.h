@@ -34,7 +34,8 @@
 #include "sopc_time.h"
 
 /**
- * Maximum resolution time for the event timers evaluation
+ * Maximum resolution time for the event timers evaluation.
+ * The timers are evaluated on their expiration time, this value bounds the delay between two evaluations.
  *
  */
 #ifndef SOPC_TIMER_RESOLUTION_MS
@@ -45,6 +46,18 @@
 #error "Timer resolution cannot be <= 0"
 #endif
 
+/**
+ * Minimum period of the periodic event timers in milliseconds
+ *
+ */
+#ifndef SOPC_TIMER_MIN_PERIOD_MS
+#define SOPC_TIMER_MIN_PERIOD_MS 2
+#endif
+
+#if SOPC_TIMER_MIN_PERIOD_MS <= 0
+#error "Timer minimum period cannot be <= 0"
+#endif
+
 /**
  * \brief Initialize the event timer manager (necessary to create timers)
  *
@@ -82,7 +95,7 @@ uint32_t SOPC_EventTimer_Create(SOPC_EventHandler* eventHandler, SOPC_Event even
  *
  * \param eventHandler  the event handler where to dispatch the event on timeout
  * \param event         the event to dispatch on timeout
- * \param msPeriod    the period in milliseconds
+ * \param msPeriod    the period in milliseconds, it shall be greater or equal to ::SOPC_TIMER_MIN_PERIOD_MS
  *
  * \return the timer identifier (or value 0 if operation failed)
  *
@@ -88,7 +88,16 @@ static void SOPC_SKscheduler_EventHandler_Callback_Default(SOPC_EventHandler* ha
     SOPC_SKBuilder_Update(task->builder, task->provider, task->manager);
 
     /* Get the remaining time to use all available keys */
-    uint32_t halfAllKeysLifeTime = SOPC_SKManager_GetAllKeysLifeTime(task->manager) / 2;
+    const uint32_t allKeysLifeTime = SOPC_SKManager_GetAllKeysLifeTime(task->manager);
+    uint32_t halfAllKeysLifeTime = allKeysLifeTime / 2;
+    /* Update at the latest a margin before the expiry of the last key, so that the next keys are available in advance
+     * for the key rotation */
+    const uint32_t beforeLastKeyExpiry =
+        (allKeysLifeTime > SOPC_SK_SCHEDULER_PREFETCH_MARGIN ? allKeysLifeTime - SOPC_SK_SCHEDULER_PREFETCH_MARGIN : 0);
+    if (beforeLastKeyExpiry < halfAllKeysLifeTime)
+    {
+        halfAllKeysLifeTime = beforeLastKeyExpiry;
+    }
     if (halfAllKeysLifeTime < SOPC_SK_SCHEDULER_UPDATE_TIMER_MIN)
     {
         halfAllKeysLifeTime = SOPC_SK_SCHEDULER_UPDATE_TIMER_MIN;
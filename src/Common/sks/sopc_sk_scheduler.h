@@ -43,6 +43,11 @@
 // maximal period for update (by default no max)
 #define SOPC_SK_SCHEDULER_UPDATE_TIMER_MAX UINT32_MAX
 
+// keys are updated at the latest this delay (ms) before the expiry of the last available key
+#ifndef SOPC_SK_SCHEDULER_PREFETCH_MARGIN
+#define SOPC_SK_SCHEDULER_PREFETCH_MARGIN 10000
+#endif
+
 typedef struct SOPC_SKscheduler SOPC_SKscheduler;
 
 typedef SOPC_ReturnStatus (*SOPC_SKscheduler_AddTask_Func)(SOPC_SKscheduler* sko,
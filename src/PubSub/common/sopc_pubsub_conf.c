@@ -81,10 +81,16 @@ struct SOPC_PubSubConnection
     char* mqttUsername;
     // Password for MQTT protocol
     char* mqttPassword;
+    // Maximum number of MQTT messages published and not acknowledged
+    uint16_t mqttMaxInflight;
+    // Maximum number of MQTT messages kept while not connected
+    uint16_t mqttMaxBufferedMessages;
 
     bool acyclicPublisher;
 
     SOPC_PubSub_OnFatalError* onFatalError;
+    // Subscriber lookup index, not owned by the configuration
+    SOPC_Reader_Index* readerIndex;
     // For the next version:
     // uint32_t connectionPropertiesLength: not used;
     // KeyValuePair *connectionProperties: not used;
@@ -138,6 +144,8 @@ struct SOPC_WriterGroup
 
     // Topic Specific to Mqtt
     char* mqttTopic;
+    OpcUa_BrokerTransportQualityOfService mqttQos;
+    bool mqttRetain;
 
     double keepAliveTimeMs;
 
@@ -196,6 +204,10 @@ struct SOPC_ReaderGroup
 
     // Topic Specific to Mqtt
     char* mqttTopic;
+    OpcUa_BrokerTransportQualityOfService mqttQos;
+
+    // Subscriber lookup index, not owned by the configuration
+    const SOPC_Reader_GroupIndex* readerIndex;
 };
 
 struct SOPC_DataSetReader
@@ -469,6 +481,18 @@ SOPC_PubSub_OnFatalError* SOPC_PubSubConfiguration_Get_FatalError_Callback(SOPC_
     return connection->onFatalError;
 }
 
+void SOPC_PubSubConnection_Set_ReaderIndex(SOPC_PubSubConnection* connection, SOPC_Reader_Index* index)
+{
+    SOPC_ASSERT(NULL != connection);
+    connection->readerIndex = index;
+}
+
+SOPC_Reader_Index* SOPC_PubSubConnection_Get_ReaderIndex(const SOPC_PubSubConnection* connection)
+{
+    SOPC_ASSERT(NULL != connection);
+    return connection->readerIndex;
+}
+
 // PublisherId
 
 static void SOPC_Conf_PublisherId_Clear(SOPC_Conf_PublisherId* pubId)
@@ -569,6 +593,30 @@ bool SOPC_PubSubConnection_Set_MqttPassword(SOPC_PubSubConnection* connection, c
     return (NULL != connection->mqttPassword);
 }
 
+uint16_t SOPC_PubSubConnection_Get_MqttMaxInflight(const SOPC_PubSubConnection* connection)
+{
+    SOPC_ASSERT(NULL != connection);
+    return connection->mqttMaxInflight;
+}
+
+void SOPC_PubSubConnection_Set_MqttMaxInflight(SOPC_PubSubConnection* connection, uint16_t maxInflight)
+{
+    SOPC_ASSERT(NULL != connection);
+    connection->mqttMaxInflight = maxInflight;
+}
+
+uint16_t SOPC_PubSubConnection_Get_MqttMaxBufferedMessages(const SOPC_PubSubConnection* connection)
+{
+    SOPC_ASSERT(NULL != connection);
+    return connection->mqttMaxBufferedMessages;
+}
+
+void SOPC_PubSubConnection_Set_MqttMaxBufferedMessages(SOPC_PubSubConnection* connection, uint16_t maxBuffered)
+{
+    SOPC_ASSERT(NULL != connection);
+    connection->mqttMaxBufferedMessages = maxBuffered;
+}
+
 bool SOPC_PubSubConnection_Allocate_WriterGroup_Array(SOPC_PubSubConnection* connection, uint16_t nb)
 {
     SOPC_ASSERT(NULL != connection && SOPC_PubSubConnection_Pub == connection->type);
@@ -759,6 +807,18 @@ bool SOPC_ReaderGroup_HasNonZeroDataSetWriterId(const SOPC_ReaderGroup* group)
     return group->hasNonZeroWriterIds;
 }
 
+void SOPC_ReaderGroup_Set_ReaderIndex(SOPC_ReaderGroup* group, const SOPC_Reader_GroupIndex* index)
+{
+    SOPC_ASSERT(NULL != group);
+    group->readerIndex = index;
+}
+
+const SOPC_Reader_GroupIndex* SOPC_ReaderGroup_Get_ReaderIndex(const SOPC_ReaderGroup* group)
+{
+    SOPC_ASSERT(NULL != group);
+    return group->readerIndex;
+}
+
 /** DataSetReader **/
 
 static void SOPC_DataSetMetaData_Clear(SOPC_DataSetMetaData* metaData)
@@ -828,6 +888,18 @@ void SOPC_ReaderGroup_Set_MqttTopic(SOPC_ReaderGroup* reader, const char* topic)
     }
 }
 
+OpcUa_BrokerTransportQualityOfService SOPC_ReaderGroup_Get_MqttQos(const SOPC_ReaderGroup* reader)
+{
+    SOPC_ASSERT(NULL != reader);
+    return reader->mqttQos;
+}
+
+void SOPC_ReaderGroup_Set_MqttQos(SOPC_ReaderGroup* reader, OpcUa_BrokerTransportQualityOfService qos)
+{
+    SOPC_ASSERT(NULL != reader);
+    reader->mqttQos = qos;
+}
+
 char* SOPC_Allocate_MQTT_DefaultTopic(const SOPC_Conf_PublisherId* publisherId, uint16_t groupId)
 {
     SOPC_ASSERT(NULL != publisherId);
@@ -1164,6 +1236,30 @@ void SOPC_WriterGroup_Set_MqttTopic(SOPC_WriterGroup* writer, const char* topic)
     }
 }
 
+OpcUa_BrokerTransportQualityOfService SOPC_WriterGroup_Get_MqttQos(const SOPC_WriterGroup* writer)
+{
+    SOPC_ASSERT(NULL != writer);
+    return writer->mqttQos;
+}
+
+void SOPC_WriterGroup_Set_MqttQos(SOPC_WriterGroup* writer, OpcUa_BrokerTransportQualityOfService qos)
+{
+    SOPC_ASSERT(NULL != writer);
+    writer->mqttQos = qos;
+}
+
+bool SOPC_WriterGroup_Get_MqttRetain(const SOPC_WriterGroup* writer)
+{
+    SOPC_ASSERT(NULL != writer);
+    return writer->mqttRetain;
+}
+
+void SOPC_WriterGroup_Set_MqttRetain(SOPC_WriterGroup* writer, bool retain)
+{
+    SOPC_ASSERT(NULL != writer);
+    writer->mqttRetain = retain;
+}
+
 /* Expected only for acyclic publisher */
 double SOPC_WriterGroup_Get_KeepAlive(const SOPC_WriterGroup* group)
 {
@@ -173,6 +173,12 @@ void SOPC_PubSubConfiguration_Set_FatalError_Callback(SOPC_PubSubConnection* con
                                                       SOPC_PubSub_OnFatalError* callback);
 SOPC_PubSub_OnFatalError* SOPC_PubSubConfiguration_Get_FatalError_Callback(SOPC_PubSubConnection* connection);
 
+/* Subscriber only: lookup index of the ReaderGroups and DataSetReaders of the connection,
+ * built and owned by the subscriber (see ::SOPC_Reader_Index_Connection) */
+typedef struct SOPC_Reader_Index SOPC_Reader_Index;
+void SOPC_PubSubConnection_Set_ReaderIndex(SOPC_PubSubConnection* connection, SOPC_Reader_Index* index);
+SOPC_Reader_Index* SOPC_PubSubConnection_Get_ReaderIndex(const SOPC_PubSubConnection* connection);
+
 /* Publisher only */
 void SOPC_PubSubConnection_Set_AcyclicPublisher(SOPC_PubSubConnection* connection, bool acyclicPublisher);
 bool SOPC_PubSubConnection_Get_AcyclicPublisher(const SOPC_PubSubConnection* connection);
@@ -198,6 +204,20 @@ bool SOPC_PubSubConnection_Set_MqttUsername(SOPC_PubSubConnection* connection, c
 const char* SOPC_PubSubConnection_Get_MqttPassword(const SOPC_PubSubConnection* connection);
 bool SOPC_PubSubConnection_Set_MqttPassword(SOPC_PubSubConnection* connection, const char* password);
 
+/**
+ * Maximum number of MQTT messages published on the connection and not acknowledged yet by the broker (QoS 1 and 2).
+ * 0 (default) uses the MQTT library default.
+ */
+uint16_t SOPC_PubSubConnection_Get_MqttMaxInflight(const SOPC_PubSubConnection* connection);
+void SOPC_PubSubConnection_Set_MqttMaxInflight(SOPC_PubSubConnection* connection, uint16_t maxInflight);
+
+/**
+ * Maximum number of MQTT messages kept by the publisher connection while it is not connected to the broker,
+ * they are sent once the connection is (re-)established. 0 (default) drops the messages published while disconnected.
+ */
+uint16_t SOPC_PubSubConnection_Get_MqttMaxBufferedMessages(const SOPC_PubSubConnection* connection);
+void SOPC_PubSubConnection_Set_MqttMaxBufferedMessages(SOPC_PubSubConnection* connection, uint16_t maxBuffered);
+
 bool SOPC_PubSubConnection_Allocate_WriterGroup_Array(SOPC_PubSubConnection* connection, uint16_t nb);
 uint16_t SOPC_PubSubConnection_Nb_WriterGroup(const SOPC_PubSubConnection* connection);
 SOPC_WriterGroup* SOPC_PubSubConnection_Get_WriterGroup_At(const SOPC_PubSubConnection* connection, uint16_t index);
@@ -239,6 +259,11 @@ bool SOPC_ReaderGroup_Set_PublisherId_String(SOPC_ReaderGroup* group, const SOPC
  */
 bool SOPC_ReaderGroup_HasNonZeroDataSetWriterId(const SOPC_ReaderGroup* group);
 
+/* Subscriber only: lookup index of the DataSetReaders of the group, part of the connection ::SOPC_Reader_Index */
+typedef struct SOPC_Reader_GroupIndex SOPC_Reader_GroupIndex;
+void SOPC_ReaderGroup_Set_ReaderIndex(SOPC_ReaderGroup* group, const SOPC_Reader_GroupIndex* index);
+const SOPC_Reader_GroupIndex* SOPC_ReaderGroup_Get_ReaderIndex(const SOPC_ReaderGroup* group);
+
 const char* SOPC_ReaderGroup_Get_MqttTopic(const SOPC_ReaderGroup* reader);
 
 /**
@@ -248,6 +273,13 @@ const char* SOPC_ReaderGroup_Get_MqttTopic(const SOPC_ReaderGroup* reader);
  */
 void SOPC_ReaderGroup_Set_MqttTopic(SOPC_ReaderGroup* reader, const char* topic);
 
+/**
+ * Quality of service requested for the MQTT topic subscribed by the ReaderGroup.
+ * ::OpcUa_BrokerTransportQualityOfService_NotSpecified (default) uses the MQTT transport default QoS.
+ */
+OpcUa_BrokerTransportQualityOfService SOPC_ReaderGroup_Get_MqttQos(const SOPC_ReaderGroup* reader);
+void SOPC_ReaderGroup_Set_MqttQos(SOPC_ReaderGroup* reader, OpcUa_BrokerTransportQualityOfService qos);
+
 /*******************/
 /** DataSetReader **/
 /*******************/
@@ -346,6 +378,20 @@ const char* SOPC_WriterGroup_Get_MqttTopic(const SOPC_WriterGroup* writer);
  */
 void SOPC_WriterGroup_Set_MqttTopic(SOPC_WriterGroup* writer, const char* topic);
 
+/**
+ * Quality of service requested for the MQTT messages published by the WriterGroup.
+ * ::OpcUa_BrokerTransportQualityOfService_NotSpecified (default) uses the MQTT transport default QoS.
+ */
+OpcUa_BrokerTransportQualityOfService SOPC_WriterGroup_Get_MqttQos(const SOPC_WriterGroup* writer);
+void SOPC_WriterGroup_Set_MqttQos(SOPC_WriterGroup* writer, OpcUa_BrokerTransportQualityOfService qos);
+
+/**
+ * Retain flag of the MQTT messages published by the WriterGroup: the broker keeps the last message of the topic
+ * for the future subscribers. False by default.
+ */
+bool SOPC_WriterGroup_Get_MqttRetain(const SOPC_WriterGroup* writer);
+void SOPC_WriterGroup_Set_MqttRetain(SOPC_WriterGroup* writer, bool retain);
+
 bool SOPC_WriterGroup_Allocate_DataSetWriter_Array(SOPC_WriterGroup* group, uint8_t nb);
 uint8_t SOPC_WriterGroup_Nb_DataSetWriter(const SOPC_WriterGroup* group);
 SOPC_DataSetWriter* SOPC_WriterGroup_Get_DataSetWriter_At(const SOPC_WriterGroup* group, uint8_t index);
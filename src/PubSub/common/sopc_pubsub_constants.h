@@ -27,6 +27,24 @@
 #define SOPC_PUBSUB_BUFFER_SIZE 4096
 #endif
 
+// Max size of a DataSetMessage. DataSetMessages which do not fit in a single message are sent in chunk messages
+#ifndef SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE
+#define SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE (1024 * 1024)
+#endif
+
+// Max number of chunked DataSetMessages reassembled at the same time. Use for subscriber context
+#ifndef SOPC_PUBSUB_CHUNKS_MAX_PENDING_DSM
+#define SOPC_PUBSUB_CHUNKS_MAX_PENDING_DSM 8
+#endif
+// Max memory (bytes) used to reassemble the chunked DataSetMessages of a connection. Use for subscriber context
+#ifndef SOPC_PUBSUB_CHUNKS_MAX_MEMORY
+#define SOPC_PUBSUB_CHUNKS_MAX_MEMORY (2 * SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE)
+#endif
+// Delay (ms) after which an incomplete chunked DataSetMessage is discarded. Use for subscriber context
+#ifndef SOPC_PUBSUB_CHUNKS_TIMEOUT_MS
+#define SOPC_PUBSUB_CHUNKS_TIMEOUT_MS 1000
+#endif
+
 // Size of array. Use for subscriber context
 #ifndef SOPC_PUBSUB_MAX_PUBLISHER_PER_SCHEDULER
 #define SOPC_PUBSUB_MAX_PUBLISHER_PER_SCHEDULER 10
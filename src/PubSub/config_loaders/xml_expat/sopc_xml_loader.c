@@ -83,6 +83,8 @@
 #define ATTR_CONNECTION_IFNAME "interfaceName"
 #define ATTR_CONNECTION_MQTTUSERNAME "mqttUsername"
 #define ATTR_CONNECTION_MQTTPASSWORD "mqttPassword"
+#define ATTR_CONNECTION_MQTT_MAX_INFLIGHT "mqttMaxInflight"
+#define ATTR_CONNECTION_MQTT_MAX_BUFFERED "mqttMaxBufferedMessages"
 #define ATTR_CONNECTION_ACYCLIC_PUBLISHER "acyclicPublisher"
 
 #define ATTR_MESSAGE_PUBLISHING_ITV "publishingInterval"
@@ -96,6 +98,12 @@
 #define ATTR_MESSAGE_GROUP_ID "groupId"
 #define ATTR_MESSAGE_GROUP_VERSION "groupVersion"
 #define ATTR_MESSAGE_MQTT_TOPIC "mqttTopic"
+#define ATTR_MESSAGE_MQTT_QOS "mqttQos"
+#define ATTR_MESSAGE_MQTT_QOS_VAL_BEST_EFFORT "bestEffort"
+#define ATTR_MESSAGE_MQTT_QOS_VAL_AT_MOST_ONCE "atMostOnce"
+#define ATTR_MESSAGE_MQTT_QOS_VAL_AT_LEAST_ONCE "atLeastOnce"
+#define ATTR_MESSAGE_MQTT_QOS_VAL_EXACTLY_ONCE "exactlyOnce"
+#define ATTR_MESSAGE_MQTT_RETAIN "mqttRetain"
 #define ATTR_MESSAGE_KEEP_ALIVE "keepAliveTime"
 #define ATTR_MESSAGE_ENCODING "encoding"
 #define ATTR_MESSAGE_FIXED_SIZE "publisherFixedSize"
@@ -170,6 +178,8 @@ struct sopc_xml_pubsub_message_t
     uint16_t groupId;
     uint32_t groupVersion;
     char* mqttTopic;
+    OpcUa_BrokerTransportQualityOfService mqttQos;
+    bool mqttRetain;
     SOPC_Pubsub_MessageEncodingType encoding;
     struct sopc_xml_pubsub_dataset_t* datasetArr;
     double keepAliveTime;
@@ -191,6 +201,8 @@ struct sopc_xml_pubsub_connection_t
     uint16_t nb_messages;
     char* mqttUsername;
     char* mqttPassword;
+    uint16_t mqttMaxInflight;
+    uint16_t mqttMaxBufferedMessages;
     bool is_acyclic;
     struct sopc_xml_pubsub_message_t* messageArr;
 };
@@ -567,6 +579,14 @@ static bool parse_connection_attributes(const char* attr_name,
     {
         result = copy_any_string_attribute_value(&connection->mqttPassword, attr_val);
     }
+    else if (TEXT_EQUALS(ATTR_CONNECTION_MQTT_MAX_INFLIGHT, attr_name))
+    {
+        result = parse_unsigned_value(attr_val, strlen(attr_val), 16, &connection->mqttMaxInflight);
+    }
+    else if (TEXT_EQUALS(ATTR_CONNECTION_MQTT_MAX_BUFFERED, attr_name))
+    {
+        result = parse_unsigned_value(attr_val, strlen(attr_val), 16, &connection->mqttMaxBufferedMessages);
+    }
     else if (TEXT_EQUALS(ATTR_CONNECTION_ACYCLIC_PUBLISHER, attr_name))
     {
         result = parse_boolean(attr_val, strlen(attr_val), &connection->is_acyclic);
@@ -689,6 +709,35 @@ static bool parse_message_attributes(const char* attr_name,
     {
         result = copy_any_string_attribute_value(&msg->mqttTopic, attr_val);
     }
+    else if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_QOS, attr_name))
+    {
+        result = true;
+        if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_QOS_VAL_BEST_EFFORT, attr_val))
+        {
+            msg->mqttQos = OpcUa_BrokerTransportQualityOfService_BestEffort;
+        }
+        else if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_QOS_VAL_AT_MOST_ONCE, attr_val))
+        {
+            msg->mqttQos = OpcUa_BrokerTransportQualityOfService_AtMostOnce;
+        }
+        else if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_QOS_VAL_AT_LEAST_ONCE, attr_val))
+        {
+            msg->mqttQos = OpcUa_BrokerTransportQualityOfService_AtLeastOnce;
+        }
+        else if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_QOS_VAL_EXACTLY_ONCE, attr_val))
+        {
+            msg->mqttQos = OpcUa_BrokerTransportQualityOfService_ExactlyOnce;
+        }
+        else
+        {
+            LOG_XML_ERRORF("Unexpected '%s' <%s>", ATTR_MESSAGE_MQTT_QOS, attr_val);
+            result = false;
+        }
+    }
+    else if (TEXT_EQUALS(ATTR_MESSAGE_MQTT_RETAIN, attr_name))
+    {
+        result = parse_boolean(attr_val, strlen(attr_val), &msg->mqttRetain);
+    }
     else if (TEXT_EQUALS(ATTR_MESSAGE_KEEP_ALIVE, attr_name))
     {
         result = SOPC_strtodouble(attr_val, strlen(attr_val), sizeof(double) * 8, &msg->keepAliveTime);
@@ -1386,6 +1435,8 @@ static SOPC_PubSubConfiguration* build_pubsub_config(struct parse_context_t* ctx
                 if (allocSuccess)
                 {
                     SOPC_WriterGroup_Set_MqttTopic(writerGroup, msg->mqttTopic);
+                    SOPC_WriterGroup_Set_MqttQos(writerGroup, msg->mqttQos);
+                    SOPC_WriterGroup_Set_MqttRetain(writerGroup, msg->mqttRetain);
                 }
 
                 if (NULL != msg->sksArr && allocSuccess)
@@ -1462,6 +1513,7 @@ static SOPC_PubSubConfiguration* build_pubsub_config(struct parse_context_t* ctx
                 SOPC_ReaderGroup_Set_GroupVersion(readerGroup, msg->groupVersion);
                 SOPC_ReaderGroup_Set_GroupId(readerGroup, msg->groupId);
                 SOPC_ReaderGroup_Set_MqttTopic(readerGroup, msg->mqttTopic);
+                SOPC_ReaderGroup_Set_MqttQos(readerGroup, msg->mqttQos);
 
                 if (SOPC_String_PublisherId == msg->publisher_id.type)
                 {
@@ -1546,6 +1598,8 @@ static SOPC_PubSubConfiguration* build_pubsub_config(struct parse_context_t* ctx
         {
             allocSuccess = SOPC_PubSubConnection_Set_MqttPassword(connection, p_connection->mqttPassword);
         }
+        SOPC_PubSubConnection_Set_MqttMaxInflight(connection, p_connection->mqttMaxInflight);
+        SOPC_PubSubConnection_Set_MqttMaxBufferedMessages(connection, p_connection->mqttMaxBufferedMessages);
     }
     if (!allocSuccess)
     {
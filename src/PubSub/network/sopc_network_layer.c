@@ -19,15 +19,19 @@
 
 // TODO : use conf rather than constants to encode message
 
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "sopc_assert.h"
 #include "sopc_encoder.h"
+#include "sopc_helper_string.h"
 #include "sopc_logger.h"
+#include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
 #include "sopc_network_layer.h"
 #include "sopc_pub_fixed_buffer.h"
+#include "sopc_time.h"
 #include "sopc_version.h"
 
 /**
@@ -49,10 +53,12 @@ static bool Network_Check_ReceivedSecurityMode(SOPC_SecurityMode_Type mode, bool
 /** Extract the message header
  * \param buffer The Buffer to decode
  * \param buffer The header to header to fill with decoded buffer
+ * \param chunk Set to true if the message is a chunk message
  * \return SOPC_NetworkMessage_Error_Code_None if header is correct.*/
 static inline SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessageHeader_Decode(
     SOPC_Buffer* buffer,
-    SOPC_Dataset_LL_NetworkMessage_Header* header);
+    SOPC_Dataset_LL_NetworkMessage_Header* header,
+    bool* chunk);
 
 /**
  * Decode a network message (V1 format)
@@ -63,7 +69,18 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
     SOPC_Dataset_LL_NetworkMessage* nm,
     SOPC_Dataset_LL_NetworkMessage_Header* header,
     const SOPC_UADP_NetworkMessage_Reader_Configuration* readerConf,
-    const SOPC_ReaderGroup* group);
+    const SOPC_ReaderGroup* group,
+    bool chunk);
+
+/**
+ * Decodes the payload of a chunk message and adds it to the reassembly of its DataSetMessage.
+ * dsm_buffer is set to the complete DataSetMessage when the chunk completes it.
+ */
+static inline SOPC_NetworkMessage_Error_Code Decode_Chunk(SOPC_Buffer* buffer_payload,
+                                                          const SOPC_Dataset_LL_DataSetMessage* dsm,
+                                                          SOPC_Conf_PublisherId pubId,
+                                                          SOPC_UADP_Chunks_Reassembly* chunks,
+                                                          SOPC_Buffer** dsm_buffer);
 
 /**
  * Decodes the group header
@@ -481,6 +498,12 @@ static SOPC_ReturnStatus print_variant_into_sopc_buffer(const SOPC_Variant* vari
         status = SOPC_Buffer_Write(buf, (const uint8_t*) bool2str[variant->Value.Boolean],
                                    (uint32_t) strlen(bool2str[variant->Value.Boolean]));
         break;
+    case SOPC_Byte_Id:
+        status = SOPC_Buffer_PrintU32(buf, variant->Value.Byte);
+        break;
+    case SOPC_SByte_Id:
+        status = SOPC_Buffer_PrintI32(buf, variant->Value.Sbyte);
+        break;
     case SOPC_UInt16_Id:
         status = SOPC_Buffer_PrintU32(buf, variant->Value.Uint16);
         break;
@@ -503,7 +526,7 @@ static SOPC_ReturnStatus print_variant_into_sopc_buffer(const SOPC_Variant* vari
         status = SOPC_STATUS_NOT_SUPPORTED;
         break;
     case SOPC_Float_Id:
-        status = SOPC_Buffer_PrintFloatDouble(buf, variant->Value.Floatv);
+        status = SOPC_Buffer_PrintFloat(buf, variant->Value.Floatv);
         break;
     case SOPC_Double_Id:
         status = SOPC_Buffer_PrintFloatDouble(buf, variant->Value.Doublev);
@@ -782,73 +805,58 @@ SOPC_NetworkMessage_Error_Code SOPC_JSON_NetworkMessage_Encode(SOPC_Dataset_LL_N
     return code;
 }
 
-SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Dataset_LL_NetworkMessage* nm,
-                                                                       SOPC_PubSub_SecurityType* security,
-                                                                       SOPC_Buffer** buffer_header,
-                                                                       SOPC_Buffer** buffer_payload)
+/**
+ * Private
+ * Encode the NetworkMessage header until the security header included.
+ * If chunkDsm is not NULL, the header is the one of a chunk message of this DataSetMessage.
+ * The positions of the security token id and nonce in the buffer are set when security is enabled.
+ */
+static SOPC_NetworkMessage_Error_Code Network_Layer_Encode_Header(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                  SOPC_PubSub_SecurityType* security,
+                                                                  const SOPC_Dataset_LL_DataSetMessage* chunkDsm,
+                                                                  SOPC_Buffer* buffer_header,
+                                                                  uint32_t* securityTokenIdPosition,
+                                                                  uint32_t* securityNoncePosition)
 {
+    SOPC_ASSERT(NULL != nm && NULL != buffer_header && NULL != securityTokenIdPosition &&
+                NULL != securityNoncePosition);
+
     SOPC_NetworkMessage_Error_Code res = SOPC_NetworkMessage_Error_Code_None;
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
-    uint32_t* dsmSizeBufferPos = NULL;
     uint8_t byte = 0;
-    bool flags1_enabled = false;
     // security flags is enabled
-    bool securityEnabled = (NULL != security);
+    const bool securityEnabled = (NULL != security);
     bool signedEnabled = false;
     bool encryptedEnabled = false;
+    // Chunk message is indicated in ExtendedFlags2, which needs ExtendedFlags1
+    const bool chunkEnabled = (NULL != chunkDsm);
+    const bool flags2_enabled = chunkEnabled || DATASET_LL_EXTENDED_FLAGS2_ENABLED;
 
-    bool preencodedEnabled = SOPC_DataSet_LL_NetworkMessage_is_Preencode_Buffer_Enabled(nm);
-    SOPC_PubFixedBuffer_Buffer_Ctx* preencode = SOPC_DataSet_LL_NetworkMessage_Get_Preencode_Buffer(nm);
-    SOPC_Dataset_LL_NetworkMessage_Header* header = NULL;
-    uint8_t dsm_count = 0;
-    uint32_t bufferPosition = 0;
-
-    if (NULL == buffer_header || NULL == buffer_payload || NULL != *buffer_header || NULL != *buffer_payload ||
-        NULL == nm || (securityEnabled && NULL == security->groupKeys))
-    {
-        return SOPC_NetworkMessage_Error_Code_InvalidParameters;
-    }
-    if (SOPC_STATUS_OK == status)
-    {
-        *buffer_header = SOPC_Buffer_Create(SOPC_PUBSUB_BUFFER_SIZE);
-        *buffer_payload = SOPC_Buffer_Create(SOPC_PUBSUB_BUFFER_SIZE);
-        if (NULL == *buffer_payload || NULL == *buffer_header)
-        {
-            status = SOPC_STATUS_OUT_OF_MEMORY;
-            res = SOPC_NetworkMessage_Error_Write_Alloc_Failed;
-        }
-    }
-    if (SOPC_STATUS_OK == status)
-    {
-        header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
-        SOPC_ASSERT(NULL != header);
-        dsm_count = SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(nm);
-    }
+    SOPC_Dataset_LL_NetworkMessage_Header* header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
+    SOPC_ASSERT(NULL != header);
+    const bool flags1_enabled = flags2_enabled || Network_Layer_Is_Flags1_Enabled(header, securityEnabled);
+    const uint8_t dsm_count = SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(nm);
 
-    if (SOPC_STATUS_OK == status && NULL != security)
+    if (securityEnabled)
     {
         signedEnabled =
             (SOPC_SecurityMode_Sign == security->mode || SOPC_SecurityMode_SignAndEncrypt == security->mode);
         encryptedEnabled = (SOPC_SecurityMode_SignAndEncrypt == security->mode);
     }
 
-    if (SOPC_STATUS_OK == status)
-    {
-        // UADP version bit 0-3
-        byte = SOPC_Dataset_LL_NetworkMessage_GetVersion(header);
-        // UADP flags bit 4-7
-        //  - PublisherId enabled
-        Network_Message_Set_Bool_Bit(&byte, 4, DATASET_LL_PUBLISHER_ID_ENABLED);
-        //  - GroupHeader enabled
-        Network_Message_Set_Bool_Bit(&byte, 5, DATASET_LL_GROUP_HEADER_ENABLED);
-        //  - PayloadHeader enabled
-        Network_Message_Set_Bool_Bit(&byte, 6, DATASET_LL_PAYLOAD_HEADER_ENABLED);
-        //  - ExtendedFlags1 enabled
-        flags1_enabled = Network_Layer_Is_Flags1_Enabled(header, securityEnabled);
-        Network_Message_Set_Bool_Bit(&byte, 7, flags1_enabled);
-        status = SOPC_Buffer_Write(*buffer_header, &byte, 1);
-        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
-    }
+    // UADP version bit 0-3
+    byte = SOPC_Dataset_LL_NetworkMessage_GetVersion(header);
+    // UADP flags bit 4-7
+    //  - PublisherId enabled
+    Network_Message_Set_Bool_Bit(&byte, 4, DATASET_LL_PUBLISHER_ID_ENABLED);
+    //  - GroupHeader enabled
+    Network_Message_Set_Bool_Bit(&byte, 5, DATASET_LL_GROUP_HEADER_ENABLED);
+    //  - PayloadHeader enabled
+    Network_Message_Set_Bool_Bit(&byte, 6, DATASET_LL_PAYLOAD_HEADER_ENABLED);
+    //  - ExtendedFlags1 enabled
+    Network_Message_Set_Bool_Bit(&byte, 7, flags1_enabled);
+    status = SOPC_Buffer_Write(buffer_header, &byte, 1);
+    res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
 
     if (flags1_enabled && SOPC_STATUS_OK == status)
     {
@@ -858,16 +866,26 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         Network_Message_Set_Bool_Bit(&byte, 4, securityEnabled);
         Network_Message_Set_Bool_Bit(&byte, 5, DATASET_LL_TIMESTAMP_ENABLED);
         Network_Message_Set_Bool_Bit(&byte, 6, DATASET_LL_PICOSECONDS_ENABLED);
-        Network_Message_Set_Bool_Bit(&byte, 7, DATASET_LL_EXTENDED_FLAGS2_ENABLED);
+        Network_Message_Set_Bool_Bit(&byte, 7, flags2_enabled);
+
+        status = SOPC_Buffer_Write(buffer_header, &byte, 1);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
 
-        status = SOPC_Buffer_Write(*buffer_header, &byte, 1);
+    if (flags2_enabled && SOPC_STATUS_OK == status)
+    {
+        // Bit 0: Chunk message
+        // Bit 1: PromotedFields disabled
+        // Bit range 2-4: NetworkMessage with DataSetMessage payload (0)
+        byte = 0;
+        Network_Message_Set_Bool_Bit(&byte, 0, chunkEnabled);
+        status = SOPC_Buffer_Write(buffer_header, &byte, 1);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
     }
 
     if (DATASET_LL_PUBLISHER_ID_ENABLED && SOPC_STATUS_OK == status)
     {
-        status =
-            Network_Layer_PublisherId_Write(*buffer_header, SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header));
+        status = Network_Layer_PublisherId_Write(buffer_header, SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header));
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_PubId_Failed);
     }
 
@@ -891,28 +909,35 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         Network_Message_Set_Bool_Bit(&byte, 2, DATASET_LL_NETWORK_MESSAGE_NUMBER_ENABLED);
         //  - SequenceNumber enabled
         Network_Message_Set_Bool_Bit(&byte, 3, DATASET_LL_SEQUENCE_NUMBER_ENABLED);
-        status = SOPC_Buffer_Write(*buffer_header, &byte, 1);
+        status = SOPC_Buffer_Write(buffer_header, &byte, 1);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
     }
 
     if (DATASET_LL_WRITER_GROUP_ID_ENABLED && SOPC_STATUS_OK == status)
     {
         uint16_t byte_2 = SOPC_Dataset_LL_NetworkMessage_Get_GroupId(nm);
-        status = SOPC_UInt16_Write(&byte_2, *buffer_header, 0);
+        status = SOPC_UInt16_Write(&byte_2, buffer_header, 0);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_GroupId_Failed);
     }
 
     if (DATASET_LL_WRITER_GROUP_VERSION_ENABLED && SOPC_STATUS_OK == status)
     {
         uint32_t version = SOPC_Dataset_LL_NetworkMessage_Get_GroupVersion(nm);
-        status = SOPC_UInt32_Write(&version, *buffer_header, 0);
+        status = SOPC_UInt32_Write(&version, buffer_header, 0);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_GroupVersion_Failed);
     }
 
     // payload header
-    if (SOPC_STATUS_OK == status)
+    if (chunkEnabled && SOPC_STATUS_OK == status)
+    {
+        // - writer id of the chunked DataSetMessage only
+        uint16_t byte_2 = SOPC_Dataset_LL_DataSetMsg_Get_WriterId(chunkDsm);
+        status = SOPC_UInt16_Write(&byte_2, buffer_header, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_WriterId_Failed);
+    }
+    else if (SOPC_STATUS_OK == status)
     {
-        status = SOPC_Buffer_Write(*buffer_header, &dsm_count, 1);
+        status = SOPC_Buffer_Write(buffer_header, &dsm_count, 1);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
 
         for (int i = 0; i < dsm_count && SOPC_STATUS_OK == status; i++)
@@ -920,7 +945,7 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
             SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, i);
             // - writer id
             uint16_t byte_2 = SOPC_Dataset_LL_DataSetMsg_Get_WriterId(dsm);
-            status = SOPC_UInt16_Write(&byte_2, *buffer_header, 0);
+            status = SOPC_UInt16_Write(&byte_2, buffer_header, 0);
             res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_WriterId_Failed);
         }
     }
@@ -937,11 +962,13 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         Network_Message_Set_Bool_Bit(&byte, 2, DATASET_LL_SECURITY_FOOTER_ENABLED);
         // - Force key reset
         Network_Message_Set_Bool_Bit(&byte, 3, DATASET_LL_SECURITY_KEY_RESET_ENABLED);
-        status = SOPC_Buffer_Write(*buffer_header, &byte, 1);
+        status = SOPC_Buffer_Write(buffer_header, &byte, 1);
         res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
         if (SOPC_STATUS_OK == status)
         {
-            status = SOPC_UInt32_Write(&security->groupKeys->tokenId, *buffer_header, 0);
+            status = SOPC_Buffer_GetPosition(buffer_header, securityTokenIdPosition);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+            status = SOPC_UInt32_Write(&security->groupKeys->tokenId, buffer_header, 0);
             res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_TokenId_Failed);
         }
 
@@ -958,19 +985,21 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
             if (SOPC_STATUS_OK == status)
             {
                 uint8_t nonceLength = (uint8_t)(nonceRandomLength + 4);
-                status = SOPC_Byte_Write(&nonceLength, *buffer_header, 0);
+                status = SOPC_Byte_Write(&nonceLength, buffer_header, 0);
                 res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
             }
             if (SOPC_STATUS_OK == status)
             {
-                status = SOPC_Buffer_Write(*buffer_header, security->msgNonceRandom, nonceRandomLength);
+                status = SOPC_Buffer_GetPosition(buffer_header, securityNoncePosition);
+                SOPC_ASSERT(SOPC_STATUS_OK == status);
+                status = SOPC_Buffer_Write(buffer_header, security->msgNonceRandom, nonceRandomLength);
                 res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_SecuHdr_Failed);
             }
         }
 
         if (SOPC_STATUS_OK == status)
         {
-            status = SOPC_UInt32_Write(&security->sequenceNumber, *buffer_header, 0);
+            status = SOPC_UInt32_Write(&security->sequenceNumber, buffer_header, 0);
             res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_SecuHdr_Failed);
         }
 
@@ -982,6 +1011,196 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         }
     }
 
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_ASSERT(SOPC_NetworkMessage_Error_Code_None != res);
+    }
+    return res;
+}
+
+/**
+ * Private
+ * Encode a DataSetMessage in the payload buffer.
+ * If preencode is not NULL, the positions of the DataSetMessage sequence number and fields are stored in it,
+ * offset by payloadPosition, the position of the payload in the message. indexDataSetField is the index in preencode
+ * of the first field of the DataSetMessage and it is updated with the number of fields.
+ */
+static SOPC_NetworkMessage_Error_Code Network_Layer_Encode_DataSetMessage(SOPC_Dataset_LL_DataSetMessage* dsm,
+                                                                          size_t dsmIndex,
+                                                                          SOPC_Buffer* buffer_payload,
+                                                                          SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                                          uint32_t payloadPosition,
+                                                                          size_t* indexDataSetField)
+{
+    SOPC_ASSERT(NULL != dsm && NULL != buffer_payload && NULL != indexDataSetField);
+
+    SOPC_NetworkMessage_Error_Code res = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    uint8_t byte = 0;
+    bool dsmFlags2Enable = false;
+
+    const SOPC_DataSet_LL_UadpDataSetMessageContentMask* conf = SOPC_Dataset_LL_DataSetMsg_Get_ContentMask(dsm);
+    SOPC_ASSERT(NULL != conf);
+
+    dsmFlags2Enable = Network_Layer_DataSetMessage_Is_Flags2_Enabled(*conf);
+
+    // DataSetMessage (1 byte)
+
+    // - DataSet Flags 1
+    //   - fieldEncoding is variant
+    SOPC_ASSERT(DataSet_LL_FieldEncoding_Variant == conf->fieldEncoding && "Only variant encoding supported");
+    SOPC_ASSERT(conf->fieldEncoding <= 2);
+    byte = (uint8_t)(conf->fieldEncoding << 1); // field encoding starts at bit 1
+
+    //   - DataSetMessage isValid
+    Network_Message_Set_Bool_Bit(&byte, 0, conf->validFlag);
+    SOPC_ASSERT(DATASET_LL_DSM_IS_VALID == conf->validFlag && "Only valid DSM allowed");
+
+    //   - sequence number is enabled
+    Network_Message_Set_Bool_Bit(&byte, 3, conf->dataSetMessageSequenceNumberFlag);
+
+    //   - status
+    Network_Message_Set_Bool_Bit(&byte, 4, conf->statusFlag);
+    SOPC_ASSERT(DATASET_LL_DSM_STATUS_ENABLED == conf->statusFlag && "Status not supported");
+
+    //   - major version
+    Network_Message_Set_Bool_Bit(&byte, 5, conf->configurationVersionMajorVersionFlag);
+    SOPC_ASSERT(DATASET_LL_DSM_MAJOR_VERSION_ENABLED == conf->configurationVersionMajorVersionFlag &&
+                "Major version not supported");
+
+    //   - minor version
+    Network_Message_Set_Bool_Bit(&byte, 6, conf->configurationVersionMinorFlag);
+    SOPC_ASSERT(DATASET_LL_DSM_MINOR_VERSION_ENABLED == conf->configurationVersionMinorFlag &&
+                "Minor version not supported");
+
+    //   - DataSet Flags 2
+    Network_Message_Set_Bool_Bit(&byte, 7, dsmFlags2Enable);
+
+    status = SOPC_Buffer_Write(buffer_payload, (uint8_t*) &byte, 1);
+    res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+
+    // - DataSet Flags 2 (1 byte)
+    if (dsmFlags2Enable && SOPC_STATUS_OK == status)
+    {
+        //   - dataSetMessageType (bits 0-3)
+        byte = (uint8_t) conf->dataSetMessageType;
+        SOPC_ASSERT(DataSet_LL_MessageType_DeltaFrame != conf->dataSetMessageType && "Unsupported message type");
+        SOPC_ASSERT(conf->dataSetMessageType <= DataSet_LL_MessageType_KeepAlive && "Unsupported Message type");
+        // - Timestamp enabled
+        Network_Message_Set_Bool_Bit(&byte, 4, conf->timestampFlag);
+        SOPC_ASSERT(DATASET_LL_DSM_TIMESTAMP_ENABLED == conf->timestampFlag && "Timestamp not supported");
+
+        Network_Message_Set_Bool_Bit(&byte, 5, conf->picoSecondsFlag);
+        SOPC_ASSERT(DATASET_LL_DSM_PICOSECONDS_ENABLED == conf->picoSecondsFlag && "Picoseconds not supported");
+        //   - status is disabled
+
+        status = SOPC_Buffer_Write(buffer_payload, (uint8_t*) &byte, 1);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
+
+    // DataSetMessage Sequence Number
+    if (SOPC_STATUS_OK == status && conf->dataSetMessageSequenceNumberFlag)
+    {
+        if (NULL != preencode)
+        {
+            uint32_t bufferPayloadPosition = 0;
+            status = SOPC_Buffer_GetPosition(buffer_payload, &bufferPayloadPosition);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+            SOPC_PubFixedBuffer_Set_DSM_SequenceNumber_Position_At(preencode, bufferPayloadPosition + payloadPosition,
+                                                                   dsmIndex);
+        }
+        uint16_t dsmSN = SOPC_Dataset_LL_DataSetMsg_Get_SequenceNumber(dsm);
+        status = SOPC_UInt16_Write(&dsmSN, buffer_payload, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_DsmSeqNum_Failed);
+    }
+
+    // If message is not a keep alive type, encode data fields
+    if (SOPC_STATUS_OK == status && DataSet_LL_MessageType_KeepAlive != conf->dataSetMessageType)
+    {
+        uint32_t* bufferPayload_dsfPositions = NULL;
+        if (NULL != preencode)
+        {
+            uint16_t nbVariant = SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm);
+            bufferPayload_dsfPositions = SOPC_Calloc(nbVariant, sizeof(uint32_t));
+            if (NULL == bufferPayload_dsfPositions)
+            {
+                status = SOPC_STATUS_OUT_OF_MEMORY;
+                res = SOPC_NetworkMessage_Error_Write_Alloc_Failed;
+            }
+        }
+        if (SOPC_STATUS_OK == status)
+        {
+            status = Network_DataSetFields_To_UADP(buffer_payload, dsm, bufferPayload_dsfPositions);
+            res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_DsmField_Failed);
+        }
+        if (NULL != preencode && SOPC_STATUS_OK == status)
+        {
+            uint16_t nbVariant = SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm);
+            for (int j = 0; j < nbVariant; j++)
+            {
+                SOPC_PubFixedBuffer_DataSetField_Position* dsfPosition =
+                    SOPC_PubFixedBuffer_Get_DataSetField_Position_At(preencode, *indexDataSetField);
+                SOPC_ASSERT(NULL != dsfPosition);
+                SOPC_PubFixedBuffer_DataSetFieldPosition_Set_Position(dsfPosition,
+                                                                      bufferPayload_dsfPositions[j] + payloadPosition);
+                (*indexDataSetField)++;
+            }
+        }
+        if (NULL != bufferPayload_dsfPositions)
+        {
+            SOPC_Free(bufferPayload_dsfPositions);
+        }
+    }
+
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_ASSERT(SOPC_NetworkMessage_Error_Code_None != res);
+    }
+    return res;
+}
+
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                       SOPC_PubSub_SecurityType* security,
+                                                                       SOPC_Buffer** buffer_header,
+                                                                       SOPC_Buffer** buffer_payload)
+{
+    SOPC_NetworkMessage_Error_Code res = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    uint32_t* dsmSizeBufferPos = NULL;
+    // security flags is enabled
+    bool securityEnabled = (NULL != security);
+
+    bool preencodedEnabled = SOPC_DataSet_LL_NetworkMessage_is_Preencode_Buffer_Enabled(nm);
+    SOPC_PubFixedBuffer_Buffer_Ctx* preencode = SOPC_DataSet_LL_NetworkMessage_Get_Preencode_Buffer(nm);
+    uint8_t dsm_count = 0;
+    uint32_t bufferPosition = 0;
+    uint32_t securityTokenIdPosition = 0;
+    uint32_t securityNoncePosition = 0;
+
+    if (NULL == buffer_header || NULL == buffer_payload || NULL != *buffer_header || NULL != *buffer_payload ||
+        NULL == nm || (securityEnabled && NULL == security->groupKeys))
+    {
+        return SOPC_NetworkMessage_Error_Code_InvalidParameters;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        *buffer_header = SOPC_Buffer_Create(SOPC_PUBSUB_BUFFER_SIZE);
+        // Payload may exceed the message size: it is checked once encoded to report that chunks are needed
+        *buffer_payload = SOPC_Buffer_CreateResizable(SOPC_PUBSUB_BUFFER_SIZE, SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE);
+        if (NULL == *buffer_payload || NULL == *buffer_header)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+            res = SOPC_NetworkMessage_Error_Write_Alloc_Failed;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        dsm_count = SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(nm);
+        res = Network_Layer_Encode_Header(nm, security, NULL, *buffer_header, &securityTokenIdPosition,
+                                          &securityNoncePosition);
+        status = (SOPC_NetworkMessage_Error_Code_None == res) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+    }
+
     // payload: write Payload buffer.
 
     // Information used when prencoding buffer
@@ -993,6 +1212,17 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         SOPC_ASSERT(SOPC_STATUS_OK == status);
     }
 
+    if (preencodedEnabled && securityEnabled && SOPC_STATUS_OK == status)
+    {
+        bool setOk = SOPC_PubFixedBuffer_Set_Security_Positions(preencode, securityTokenIdPosition,
+                                                                securityNoncePosition, bufferPosition);
+        if (!setOk)
+        {
+            status = SOPC_STATUS_INVALID_STATE;
+            res = SOPC_UADP_NetworkMessage_Error_Write_SecuHdr_Failed;
+        }
+    }
+
     if (DATASET_LL_PAYLOAD_HEADER_ENABLED && dsm_count > 1 && SOPC_STATUS_OK == status)
     {
         dsmSizeBufferPos = SOPC_Calloc(dsm_count, sizeof(*dsmSizeBufferPos));
@@ -1023,123 +1253,15 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
     {
         // dsmStartBufferPos is set with buffer position before DSM content
         uint32_t dsmStartBufferPos;
-        bool dsmFlags2Enable = false;
         status = SOPC_Buffer_GetPosition(*buffer_payload, &dsmStartBufferPos);
         SOPC_ASSERT(SOPC_STATUS_OK == status);
 
         SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, i);
         SOPC_ASSERT(NULL != dsm);
-        const SOPC_DataSet_LL_UadpDataSetMessageContentMask* conf = SOPC_Dataset_LL_DataSetMsg_Get_ContentMask(dsm);
-        SOPC_ASSERT(NULL != conf);
-
-        dsmFlags2Enable = Network_Layer_DataSetMessage_Is_Flags2_Enabled(*conf);
-
-        // DataSetMessage (1 byte)
-
-        // - DataSet Flags 1
-        //   - fieldEncoding is variant
-        SOPC_ASSERT(DataSet_LL_FieldEncoding_Variant == conf->fieldEncoding && "Only variant encoding supported");
-        SOPC_ASSERT(conf->fieldEncoding <= 2);
-        byte = (uint8_t)(conf->fieldEncoding << 1); // field encoding starts at bit 1
-
-        //   - DataSetMessage isValid
-        Network_Message_Set_Bool_Bit(&byte, 0, conf->validFlag);
-        SOPC_ASSERT(DATASET_LL_DSM_IS_VALID == conf->validFlag && "Only valid DSM allowed");
-
-        //   - sequence number is enabled
-        Network_Message_Set_Bool_Bit(&byte, 3, conf->dataSetMessageSequenceNumberFlag);
-
-        //   - status
-        Network_Message_Set_Bool_Bit(&byte, 4, conf->statusFlag);
-        SOPC_ASSERT(DATASET_LL_DSM_STATUS_ENABLED == conf->statusFlag && "Status not supported");
-
-        //   - major version
-        Network_Message_Set_Bool_Bit(&byte, 5, conf->configurationVersionMajorVersionFlag);
-        SOPC_ASSERT(DATASET_LL_DSM_MAJOR_VERSION_ENABLED == conf->configurationVersionMajorVersionFlag &&
-                    "Major version not supported");
-
-        //   - minor version
-        Network_Message_Set_Bool_Bit(&byte, 6, conf->configurationVersionMinorFlag);
-        SOPC_ASSERT(DATASET_LL_DSM_MINOR_VERSION_ENABLED == conf->configurationVersionMinorFlag &&
-                    "Minor version not supported");
-
-        //   - DataSet Flags 2
-        Network_Message_Set_Bool_Bit(&byte, 7, dsmFlags2Enable);
-
-        status = SOPC_Buffer_Write(*buffer_payload, (uint8_t*) &byte, 1);
-        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
-
-        // - DataSet Flags 2 (1 byte)
-        if (dsmFlags2Enable && SOPC_STATUS_OK == status)
-        {
-            //   - dataSetMessageType (bits 0-3)
-            byte = (uint8_t) conf->dataSetMessageType;
-            SOPC_ASSERT(DataSet_LL_MessageType_DeltaFrame != conf->dataSetMessageType && "Unsupported message type");
-            SOPC_ASSERT(conf->dataSetMessageType <= DataSet_LL_MessageType_KeepAlive && "Unsupported Message type");
-            // - Timestamp enabled
-            Network_Message_Set_Bool_Bit(&byte, 4, conf->timestampFlag);
-            SOPC_ASSERT(DATASET_LL_DSM_TIMESTAMP_ENABLED == conf->timestampFlag && "Timestamp not supported");
-
-            Network_Message_Set_Bool_Bit(&byte, 5, conf->picoSecondsFlag);
-            SOPC_ASSERT(DATASET_LL_DSM_PICOSECONDS_ENABLED == conf->picoSecondsFlag && "Picoseconds not supported");
-            //   - status is disabled
-
-            status = SOPC_Buffer_Write(*buffer_payload, (uint8_t*) &byte, 1);
-            res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
-        }
-
-        // DataSetMessage Sequence Number
-        if (SOPC_STATUS_OK == status && conf->dataSetMessageSequenceNumberFlag)
-        {
-            if (preencodedEnabled)
-            {
-                uint32_t bufferPayloadPosition = 0;
-                status = SOPC_Buffer_GetPosition(*buffer_payload, &bufferPayloadPosition);
-                SOPC_ASSERT(SOPC_STATUS_OK == status);
-                SOPC_PubFixedBuffer_Set_DSM_SequenceNumber_Position_At(
-                    preencode, bufferPayloadPosition + bufferPosition, (size_t) i);
-            }
-            uint16_t dsmSN = SOPC_Dataset_LL_DataSetMsg_Get_SequenceNumber(dsm);
-            status = SOPC_UInt16_Write(&dsmSN, *buffer_payload, 0);
-            res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_DsmSeqNum_Failed);
-        }
-
-        // If message is not a keep alive type, encode data fields
-        if (SOPC_STATUS_OK == status && DataSet_LL_MessageType_KeepAlive != conf->dataSetMessageType)
-        {
-            uint32_t* bufferPayload_dsfPositions = NULL;
-            if (preencodedEnabled)
-            {
-                uint16_t nbVariant = SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm);
-                bufferPayload_dsfPositions = SOPC_Calloc(nbVariant, sizeof(uint32_t));
-                if (NULL == bufferPayload_dsfPositions)
-                {
-                    status = SOPC_STATUS_OUT_OF_MEMORY;
-                }
-            }
-            if (SOPC_STATUS_OK == status)
-            {
-                status = Network_DataSetFields_To_UADP(*buffer_payload, dsm, bufferPayload_dsfPositions);
-                res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_DsmField_Failed);
-            }
-            if (preencodedEnabled && SOPC_STATUS_OK == status)
-            {
-                uint16_t nbVariant = SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm);
-                for (int j = 0; j < nbVariant; j++)
-                {
-                    SOPC_PubFixedBuffer_DataSetField_Position* dsfPosition =
-                        SOPC_PubFixedBuffer_Get_DataSetField_Position_At(preencode, indexDataSetField);
-                    SOPC_ASSERT(NULL != dsfPosition);
-                    SOPC_PubFixedBuffer_DataSetFieldPosition_Set_Position(
-                        dsfPosition, bufferPayload_dsfPositions[j] + bufferPosition);
-                    indexDataSetField++;
-                }
-            }
-            if (NULL != bufferPayload_dsfPositions)
-            {
-                SOPC_Free(bufferPayload_dsfPositions);
-            }
-        }
+        res = Network_Layer_Encode_DataSetMessage(dsm, (size_t) i, *buffer_payload,
+                                                  preencodedEnabled ? preencode : NULL, bufferPosition,
+                                                  &indexDataSetField);
+        status = (SOPC_NetworkMessage_Error_Code_None == res) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
 
         if (NULL != dsmSizeBufferPos && SOPC_STATUS_OK == status)
         {
@@ -1166,6 +1288,24 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
         dsmSizeBufferPos = NULL;
     }
 
+    // Check the final message (header, payload and signature) fits in a message
+    if (SOPC_STATUS_OK == status)
+    {
+        uint32_t sizeSignature = 0;
+        if (securityEnabled)
+        {
+            const bool signedEnabled =
+                (SOPC_SecurityMode_Sign == security->mode || SOPC_SecurityMode_SignAndEncrypt == security->mode);
+            status = SOPC_PubSub_Security_GetSignSize(security, signedEnabled, &sizeSignature);
+            res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Sign_Failed);
+        }
+        if (SOPC_STATUS_OK == status &&
+            (uint64_t)(*buffer_header)->length + (*buffer_payload)->length + sizeSignature > SOPC_PUBSUB_BUFFER_SIZE)
+        {
+            set_status_default(&status, &res, SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge);
+        }
+    }
+
     if (SOPC_STATUS_OK != status)
     {
         if (NULL != *buffer_header)
@@ -1186,39 +1326,180 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Data
     return res;
 }
 
-SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_BuildFinalMessage(SOPC_PubSub_SecurityType* security,
-                                                                          SOPC_Buffer* buffer_header,
-                                                                          SOPC_Buffer** buffer_payload)
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_DataSetMessage(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                              uint8_t dsmIndex,
+                                                                              SOPC_Buffer** dsm_buffer)
+{
+    if (NULL == nm || NULL == dsm_buffer || NULL != *dsm_buffer ||
+        dsmIndex >= SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(nm))
+    {
+        return SOPC_NetworkMessage_Error_Code_InvalidParameters;
+    }
+    SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, dsmIndex);
+    SOPC_ASSERT(NULL != dsm);
+
+    *dsm_buffer = SOPC_Buffer_CreateResizable(SOPC_PUBSUB_BUFFER_SIZE, SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE);
+    if (NULL == *dsm_buffer)
+    {
+        return SOPC_NetworkMessage_Error_Write_Alloc_Failed;
+    }
+    size_t indexDataSetField = 0;
+    SOPC_NetworkMessage_Error_Code res =
+        Network_Layer_Encode_DataSetMessage(dsm, dsmIndex, *dsm_buffer, NULL, 0, &indexDataSetField);
+    if (SOPC_NetworkMessage_Error_Code_None != res)
+    {
+        SOPC_Buffer_Delete(*dsm_buffer);
+        *dsm_buffer = NULL;
+    }
+    return res;
+}
+
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Chunk(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                     SOPC_PubSub_SecurityType* security,
+                                                                     uint8_t dsmIndex,
+                                                                     const SOPC_Buffer* dsm_buffer,
+                                                                     uint32_t* chunkOffset,
+                                                                     SOPC_Buffer** buffer)
 {
+    if (NULL == nm || NULL == dsm_buffer || NULL == chunkOffset || NULL == buffer || NULL != *buffer ||
+        dsmIndex >= SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(nm) || *chunkOffset >= dsm_buffer->length ||
+        dsm_buffer->length > INT32_MAX || (NULL != security && NULL == security->groupKeys))
+    {
+        return SOPC_NetworkMessage_Error_Code_InvalidParameters;
+    }
+
     SOPC_NetworkMessage_Error_Code res = SOPC_NetworkMessage_Error_Code_None;
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
-    if (NULL == buffer_header || NULL == buffer_payload || NULL == *buffer_payload)
+    SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, dsmIndex);
+    SOPC_ASSERT(NULL != dsm);
+    uint32_t securityTokenIdPosition = 0;
+    uint32_t securityNoncePosition = 0;
+    uint32_t sizeSignature = 0;
+    uint32_t chunkLength = 0;
+
+    *buffer = SOPC_Buffer_Create(SOPC_PUBSUB_BUFFER_SIZE);
+    SOPC_Buffer* buffer_payload = SOPC_Buffer_Create(SOPC_PUBSUB_BUFFER_SIZE);
+    if (NULL == *buffer || NULL == buffer_payload)
     {
-        status = SOPC_STATUS_INVALID_PARAMETERS;
-        res = SOPC_NetworkMessage_Error_Code_InvalidParameters;
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+        res = SOPC_NetworkMessage_Error_Write_Alloc_Failed;
     }
 
-    bool signedEnabled = false;
-    bool encryptedEnabled = false;
+    if (SOPC_STATUS_OK == status)
+    {
+        res = Network_Layer_Encode_Header(nm, security, dsm, *buffer, &securityTokenIdPosition,
+                                          &securityNoncePosition);
+        status = (SOPC_NetworkMessage_Error_Code_None == res) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+    }
 
     if (NULL != security && SOPC_STATUS_OK == status)
     {
-        if (NULL == security->groupKeys)
+        const bool signedEnabled =
+            (SOPC_SecurityMode_Sign == security->mode || SOPC_SecurityMode_SignAndEncrypt == security->mode);
+        status = SOPC_PubSub_Security_GetSignSize(security, signedEnabled, &sizeSignature);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Sign_Failed);
+    }
+
+    // Chunk payload: MessageSequenceNumber, ChunkOffset, TotalSize and ChunkData as a ByteString.
+    // The chunk data fills the remaining space of the message. See OPCUA Spec Part 14 - 7.2.2.2.4
+    if (SOPC_STATUS_OK == status)
+    {
+        const uint32_t chunkHeaderSize = 2 + 4 + 4 + 4;
+        const uint32_t usedSize = (*buffer)->length + chunkHeaderSize + sizeSignature;
+        const uint32_t remaining = dsm_buffer->length - *chunkOffset;
+        if (usedSize >= SOPC_PUBSUB_BUFFER_SIZE)
         {
-            // Keys needed when security is enabled
-            status = SOPC_STATUS_INVALID_PARAMETERS;
-            res = SOPC_NetworkMessage_Error_Code_InvalidParameters;
+            set_status_default(&status, &res, SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge);
         }
         else
         {
-            signedEnabled =
-                (SOPC_SecurityMode_Sign == security->mode || SOPC_SecurityMode_SignAndEncrypt == security->mode);
-            encryptedEnabled = (SOPC_SecurityMode_SignAndEncrypt == security->mode);
+            chunkLength = SOPC_PUBSUB_BUFFER_SIZE - usedSize;
+            chunkLength = (remaining < chunkLength ? remaining : chunkLength);
         }
     }
 
-    // Encrypt the Payload if encrypt is enabled
-    if (encryptedEnabled && SOPC_STATUS_OK == status && (*buffer_payload)->length > 0)
+    if (SOPC_STATUS_OK == status)
+    {
+        uint16_t dsmSN = SOPC_Dataset_LL_DataSetMsg_Get_SequenceNumber(dsm);
+        status = SOPC_UInt16_Write(&dsmSN, buffer_payload, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_DsmSeqNum_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(chunkOffset, buffer_payload, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&dsm_buffer->length, buffer_payload, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        const int32_t length = (int32_t) chunkLength;
+        status = SOPC_Int32_Write(&length, buffer_payload, 0);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_Write(buffer_payload, dsm_buffer->data + *chunkOffset, chunkLength);
+        res = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Write_Buffer_Failed);
+    }
+
+    // Each chunk is secured as a complete message
+    if (SOPC_STATUS_OK == status)
+    {
+        res = SOPC_UADP_NetworkMessage_BuildFinalMessage(security, *buffer, &buffer_payload);
+        status = (SOPC_NetworkMessage_Error_Code_None == res) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+    }
+    SOPC_Buffer_Delete(buffer_payload);
+
+    if (SOPC_STATUS_OK == status)
+    {
+        *chunkOffset += chunkLength;
+    }
+    else
+    {
+        SOPC_ASSERT(SOPC_NetworkMessage_Error_Code_None != res);
+        SOPC_Buffer_Delete(*buffer);
+        *buffer = NULL;
+    }
+    return res;
+}
+
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_BuildFinalMessage(SOPC_PubSub_SecurityType* security,
+                                                                          SOPC_Buffer* buffer_header,
+                                                                          SOPC_Buffer** buffer_payload)
+{
+    SOPC_NetworkMessage_Error_Code res = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    if (NULL == buffer_header || NULL == buffer_payload || NULL == *buffer_payload)
+    {
+        status = SOPC_STATUS_INVALID_PARAMETERS;
+        res = SOPC_NetworkMessage_Error_Code_InvalidParameters;
+    }
+
+    bool signedEnabled = false;
+    bool encryptedEnabled = false;
+
+    if (NULL != security && SOPC_STATUS_OK == status)
+    {
+        if (NULL == security->groupKeys)
+        {
+            // Keys needed when security is enabled
+            status = SOPC_STATUS_INVALID_PARAMETERS;
+            res = SOPC_NetworkMessage_Error_Code_InvalidParameters;
+        }
+        else
+        {
+            signedEnabled =
+                (SOPC_SecurityMode_Sign == security->mode || SOPC_SecurityMode_SignAndEncrypt == security->mode);
+            encryptedEnabled = (SOPC_SecurityMode_SignAndEncrypt == security->mode);
+        }
+    }
+
+    // Encrypt the Payload if encrypt is enabled
+    if (encryptedEnabled && SOPC_STATUS_OK == status && (*buffer_payload)->length > 0)
     {
         SOPC_Buffer* payload_encrypted = SOPC_PubSub_Security_Encrypt(security, *buffer_payload);
         if (NULL == payload_encrypted)
@@ -1271,14 +1552,26 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_BuildFinalMessage(SOPC_P
 SOPC_Buffer* SOPC_UADP_NetworkMessage_Get_PreencodedBuffer(SOPC_Dataset_LL_NetworkMessage* nm,
                                                            SOPC_PubSub_SecurityType* security)
 {
-    if (NULL == nm || NULL != security)
+    if (NULL == nm)
     {
         return NULL;
     }
     SOPC_PubFixedBuffer_Buffer_Ctx* preencode = SOPC_DataSet_LL_NetworkMessage_Get_Preencode_Buffer(nm);
+    // Security of the message shall be the one used to preencode it
+    if ((NULL != security) != SOPC_PubFixedBuffer_Is_Secured(preencode))
+    {
+        return NULL;
+    }
     SOPC_Buffer* buffer = SOPC_PubFixedBuffer_Get_UpdatedBuffer(preencode);
-    SOPC_ReturnStatus status = SOPC_Buffer_SetPosition(buffer, 0);
-    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    if (NULL != security)
+    {
+        buffer = SOPC_PubFixedBuffer_Get_SecuredBuffer(preencode, security);
+    }
+    else
+    {
+        SOPC_ReturnStatus status = SOPC_Buffer_SetPosition(buffer, 0);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
     return buffer;
 }
 
@@ -1476,9 +1769,10 @@ static SOPC_NetworkMessage_Error_Code decode_dataSetMessage(
 
 static inline SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessageHeader_Decode(
     SOPC_Buffer* buffer,
-    SOPC_Dataset_LL_NetworkMessage_Header* header)
+    SOPC_Dataset_LL_NetworkMessage_Header* header,
+    bool* chunk)
 {
-    SOPC_ASSERT(NULL != header);
+    SOPC_ASSERT(NULL != header && NULL != chunk);
 
     SOPC_ReturnStatus status;
     SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
@@ -1544,11 +1838,12 @@ static inline SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessageHeader_Deco
         flags2_enabled = false;
     }
 
-    // The following bits are not managed for now:
     // Bit 0: Chunk message
+    // The following bits are not managed for now:
     // Bit 1: PromotedFields enabled
     // Bit range 2-4: UADP NetworkMessage type
     // Others: not used
+    *chunk = false;
     if (flags2_enabled && SOPC_STATUS_OK == status)
     {
         status = SOPC_Byte_Read(&data, buffer, 0);
@@ -1556,10 +1851,10 @@ static inline SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessageHeader_Deco
 
         if (SOPC_STATUS_OK == status)
         {
-            const bool chunkMsg = Network_Message_Get_Bool_Bit(data, 0);
+            *chunk = Network_Message_Get_Bool_Bit(data, 0);
             conf->PromotedFieldsFlag = Network_Message_Get_Bool_Bit(data, 1);
             const uint8_t messageType = (data >> 2) & 0x07;
-            if (chunkMsg || conf->PromotedFieldsFlag || messageType != 0)
+            if (conf->PromotedFieldsFlag || messageType != 0)
             {
                 set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Unsupported_Flags2);
             }
@@ -1811,10 +2106,12 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
     SOPC_Dataset_LL_NetworkMessage* nm,
     SOPC_Dataset_LL_NetworkMessage_Header* header,
     const SOPC_UADP_NetworkMessage_Reader_Configuration* readerConf,
-    const SOPC_ReaderGroup* group)
+    const SOPC_ReaderGroup* group,
+    bool chunk)
 {
     SOPC_ASSERT(NULL != header && NULL != nm && NULL != group && NULL != readerConf &&
                 NULL != readerConf->callbacks.pGetReader_Func && NULL != readerConf->callbacks.pSetDsm_Func);
+    SOPC_ASSERT(!chunk || NULL != readerConf->chunks);
 
     const uint16_t group_id = SOPC_ReaderGroup_Get_GroupId(group);
     const SOPC_DataSetReader** dsmReaders = NULL;
@@ -1824,12 +2121,18 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
     // number of DataSetMessage. Should be one
     SOPC_Byte msg_count = 0;
     SOPC_Buffer* buffer_payload = NULL;
+    // Reassembled DataSetMessage of a chunk message
+    SOPC_Buffer* dsm_buffer = NULL;
 
     SOPC_UADP_Configuration* conf = SOPC_Dataset_LL_NetworkMessage_GetHeaderConfig(header);
 
     // Payload Header
-    // Only DataSetMessage is managed
-    if (conf->PayloadHeaderFlag && SOPC_STATUS_OK == status)
+    // Only DataSetMessage is managed. Payload header of a chunk message only contains the DataSetWriterId
+    if (chunk && !conf->PayloadHeaderFlag)
+    {
+        set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_Chunk_Failed);
+    }
+    else if (conf->PayloadHeaderFlag && !chunk)
     {
         status = SOPC_Byte_Read(&msg_count, buffer, 0);
         code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Byte_Failed);
@@ -1847,8 +2150,15 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
 
     if (SOPC_STATUS_OK == status)
     {
-        dsmReaders = SOPC_Calloc(msg_count, sizeof(SOPC_DataSetReader*));
-        SOPC_ASSERT(NULL != dsmReaders);
+        if (NULL != readerConf->scratch)
+        {
+            dsmReaders = readerConf->scratch->dsmReaders;
+        }
+        else
+        {
+            dsmReaders = SOPC_Calloc(msg_count, sizeof(SOPC_DataSetReader*));
+            SOPC_ASSERT(NULL != dsmReaders);
+        }
     }
 
     // DataSetMessage Writer Ids (Payload Header)
@@ -1866,12 +2176,12 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
             {
                 SOPC_Dataset_LL_DataSetMsg_Set_WriterId(dsm, writer_id);
                 dsmReaders[i] = readerConf->callbacks.pGetReader_Func(group, conf, writer_id, (uint8_t) i);
-            }
 
-            // Check if there is at last one DSM to read, otherwise decoding can be canceled
-            if (dsmReaders[i] != NULL)
-            {
-                mustDecode = true;
+                // Check if there is at last one DSM to read, otherwise decoding can be canceled
+                if (dsmReaders[i] != NULL)
+                {
+                    mustDecode = true;
+                }
             }
         }
         if (!mustDecode)
@@ -1937,7 +2247,14 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
     // No size if there is only one DataSetMessage
     if (msg_count > 1 && conf->PayloadHeaderFlag && SOPC_STATUS_OK == status)
     {
-        dsmSizes = SOPC_Calloc(msg_count, sizeof(uint16_t));
+        if (NULL != readerConf->scratch)
+        {
+            dsmSizes = readerConf->scratch->dsmSizes;
+        }
+        else
+        {
+            dsmSizes = SOPC_Calloc(msg_count, sizeof(uint16_t));
+        }
         if (NULL == dsmSizes)
         {
             status = SOPC_STATUS_OUT_OF_MEMORY;
@@ -1950,6 +2267,19 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
         code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_DsmSize_Failed);
     }
 
+    // Chunk message: the DataSetMessage is decoded once all its chunks are received
+    if (chunk && SOPC_STATUS_OK == status)
+    {
+        code = Decode_Chunk(buffer_payload, SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, 0),
+                            Network_Layer_Convert_PublisherId(SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header)),
+                            readerConf->chunks, &dsm_buffer);
+        status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+        if (SOPC_STATUS_OK == status && NULL == dsm_buffer)
+        {
+            set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete);
+        }
+    }
+
     // Decode DataSetMessages
 
     // Bit 0: DataSetMessage is valid.
@@ -1967,10 +2297,16 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
         if (NULL != reader)
         {
             code = decode_dataSetMessage(
-                dsm, buffer_payload, size,
+                dsm, NULL != dsm_buffer ? dsm_buffer : buffer_payload, size,
                 Network_Layer_Convert_PublisherId(SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header)), readerConf);
             status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
 
+            // The reassembled DataSetMessage shall be entirely decoded
+            if (NULL != dsm_buffer && SOPC_STATUS_OK == status && 0 != SOPC_Buffer_Remaining(dsm_buffer))
+            {
+                set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_DsmSizeCheck_Failed);
+            }
+
             if (SOPC_STATUS_OK == status)
             {
                 status = readerConf->callbacks.pSetDsm_Func(dsm, readerConf->targetConfig, reader);
@@ -1992,13 +2328,10 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
         }
     }
 
-    if (NULL != dsmSizes)
+    // Scratch arrays are kept for the next message
+    if (NULL == readerConf->scratch)
     {
         SOPC_Free(dsmSizes);
-    }
-
-    if (NULL != dsmReaders)
-    {
         SOPC_Free(dsmReaders);
     }
 
@@ -2007,7 +2340,62 @@ static inline SOPC_NetworkMessage_Error_Code Decode_Message_V1(
     {
         SOPC_Buffer_Delete(buffer_payload);
     }
+    SOPC_Buffer_Delete(dsm_buffer);
+
+    return code;
+}
+
+static inline SOPC_NetworkMessage_Error_Code Decode_Chunk(SOPC_Buffer* buffer_payload,
+                                                          const SOPC_Dataset_LL_DataSetMessage* dsm,
+                                                          SOPC_Conf_PublisherId pubId,
+                                                          SOPC_UADP_Chunks_Reassembly* chunks,
+                                                          SOPC_Buffer** dsm_buffer)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    uint16_t sequenceNumber = 0;
+    uint32_t chunkOffset = 0;
+    uint32_t totalSize = 0;
+    int32_t length = 0;
+
+    // MessageSequenceNumber, ChunkOffset, TotalSize and ChunkData as a ByteString
+    // See OPCUA Spec Part 14 - 7.2.2.2.4
+    status = SOPC_UInt16_Read(&sequenceNumber, buffer_payload, 0);
+    code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Short_Failed);
+
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Read(&chunkOffset, buffer_payload, 0);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Int_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Read(&totalSize, buffer_payload, 0);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Int_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Int32_Read(&length, buffer_payload, 0);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Int_Failed);
+    }
+    if (SOPC_STATUS_OK == status && (length <= 0 || (uint32_t) length > SOPC_Buffer_Remaining(buffer_payload)))
+    {
+        set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_Chunk_Failed);
+    }
 
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UADP_Chunks_Reassembly_Add(chunks, &pubId, SOPC_Dataset_LL_DataSetMsg_Get_WriterId(dsm),
+                                                 sequenceNumber, chunkOffset, totalSize,
+                                                 buffer_payload->data + buffer_payload->position, (uint32_t) length,
+                                                 dsm_buffer);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Chunk_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_Read(NULL, buffer_payload, (uint32_t) length);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Chunk_Failed);
+    }
     return code;
 }
 
@@ -2029,6 +2417,7 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Decode(
     SOPC_Dataset_LL_NetworkMessage* nm = NULL;
     SOPC_Dataset_LL_NetworkMessage_Header* header = NULL;
     SOPC_UADP_Configuration* conf = NULL;
+    bool chunk = false;
 
     *uadp_nm = SOPC_Network_Message_Create();
 
@@ -2046,10 +2435,16 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Decode(
         SOPC_ASSERT(NULL != header && NULL != conf);
 
         // Decode Message Header, and determine message version
-        code = SOPC_UADP_NetworkMessageHeader_Decode(buffer, header);
+        code = SOPC_UADP_NetworkMessageHeader_Decode(buffer, header, &chunk);
         status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
     }
 
+    // Chunk messages can only be decoded with a reassembly context
+    if (chunk && NULL == reader_config->chunks && SOPC_STATUS_OK == status)
+    {
+        set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Unsupported_Flags2);
+    }
+
     // Decode GroupHeader
     if (SOPC_STATUS_OK == status)
     {
@@ -2079,7 +2474,7 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Decode(
         switch (version)
         {
         case UADP_VERSION1:
-            code = Decode_Message_V1(buffer, payload_sign_position, nm, header, reader_config, group);
+            code = Decode_Message_V1(buffer, payload_sign_position, nm, header, reader_config, group, chunk);
             status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
             break;
         default:
@@ -2108,6 +2503,1060 @@ void SOPC_UADP_NetworkMessage_Delete(SOPC_UADP_NetworkMessage* uadp_nm)
     }
 }
 
+/* JSON NetworkMessage decoding (OPC UA Part 14, 7.2.3).
+ * The message is tokenized in place: no intermediate tree is built and only the decoded values are allocated. */
+
+/* Maximum nesting depth of the JSON values skipped by the decoder */
+#define JSON_MAX_DEPTH 32
+
+typedef struct
+{
+    const char* data;
+    uint32_t length;
+    uint32_t pos;
+    bool error;
+} Json_Reader;
+
+typedef struct
+{
+    const char* data; /* First character of the token, after the quote for a string */
+    uint32_t length;  /* Length of the token, quotes excluded */
+    bool isString;
+    bool hasEscape;
+} Json_Token;
+
+static void Json_Skip_Whitespaces(Json_Reader* r)
+{
+    while (r->pos < r->length &&
+           (' ' == r->data[r->pos] || '\t' == r->data[r->pos] || '\n' == r->data[r->pos] || '\r' == r->data[r->pos]))
+    {
+        r->pos++;
+    }
+}
+
+/* Returns the next significant character without consuming it, '\0' at the end of the input or in case of error */
+static char Json_Peek(Json_Reader* r)
+{
+    if (r->error)
+    {
+        return '\0';
+    }
+    Json_Skip_Whitespaces(r);
+    return (r->pos < r->length ? r->data[r->pos] : '\0');
+}
+
+static bool Json_Expect(Json_Reader* r, char c)
+{
+    if (c == Json_Peek(r) && '\0' != c)
+    {
+        r->pos++;
+        return true;
+    }
+    r->error = true;
+    return false;
+}
+
+/* Reads a string token, the escape sequences are checked when the string is unescaped */
+static bool Json_Read_String(Json_Reader* r, Json_Token* token)
+{
+    SOPC_ASSERT(r->pos < r->length && '"' == r->data[r->pos]);
+    r->pos++;
+    const uint32_t start = r->pos;
+    token->data = r->data + start;
+    token->isString = true;
+    token->hasEscape = false;
+    while (r->pos < r->length)
+    {
+        const char c = r->data[r->pos];
+        if ('"' == c)
+        {
+            token->length = r->pos - start;
+            r->pos++;
+            return true;
+        }
+        if ((unsigned char) c < 0x20 || ('\\' == c && r->pos + 1 >= r->length))
+        {
+            break;
+        }
+        if ('\\' == c)
+        {
+            token->hasEscape = true;
+            r->pos++;
+        }
+        r->pos++;
+    }
+    r->error = true;
+    return false;
+}
+
+/* Reads a number or a literal (true, false, null) token */
+static bool Json_Read_Primitive(Json_Reader* r, Json_Token* token)
+{
+    const uint32_t start = r->pos;
+    token->data = r->data + start;
+    token->isString = false;
+    token->hasEscape = false;
+    while (r->pos < r->length)
+    {
+        const char c = r->data[r->pos];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || 'E' == c || '+' == c || '-' == c || '.' == c))
+        {
+            break;
+        }
+        r->pos++;
+    }
+    token->length = r->pos - start;
+    if (0 == token->length)
+    {
+        r->error = true;
+    }
+    return !r->error;
+}
+
+/* Reads a scalar value, objects and arrays are not tokens */
+static bool Json_Read_Token(Json_Reader* r, Json_Token* token)
+{
+    const char c = Json_Peek(r);
+    if ('"' == c)
+    {
+        return Json_Read_String(r, token);
+    }
+    if ('\0' == c)
+    {
+        r->error = true;
+        return false;
+    }
+    return Json_Read_Primitive(r, token);
+}
+
+/* Consumes the opening character, returns false if the object or array is empty (closing character consumed) */
+static bool Json_Begin(Json_Reader* r, char open, char close)
+{
+    if (!Json_Expect(r, open))
+    {
+        return false;
+    }
+    if (close == Json_Peek(r))
+    {
+        r->pos++;
+        return false;
+    }
+    return !r->error;
+}
+
+/* Consumes the separator or the closing character, returns true if there is a next member or element */
+static bool Json_Next(Json_Reader* r, char close)
+{
+    const char c = Json_Peek(r);
+    if (',' == c)
+    {
+        r->pos++;
+        return true;
+    }
+    if (close != c || '\0' == c)
+    {
+        r->error = true;
+    }
+    r->pos++;
+    return false;
+}
+
+/* Reads the key of an object member and the name separator */
+static bool Json_Read_Key(Json_Reader* r, Json_Token* key)
+{
+    if ('"' != Json_Peek(r))
+    {
+        r->error = true;
+        return false;
+    }
+    return Json_Read_String(r, key) && Json_Expect(r, ':');
+}
+
+static bool Json_Skip_Value(Json_Reader* r, uint8_t depth)
+{
+    const char c = Json_Peek(r);
+    if ('{' == c || '[' == c)
+    {
+        const char close = ('{' == c ? '}' : ']');
+        if (depth >= JSON_MAX_DEPTH)
+        {
+            r->error = true;
+            return false;
+        }
+        bool more = Json_Begin(r, c, close);
+        while (more)
+        {
+            Json_Token key;
+            if ('}' == close)
+            {
+                Json_Read_Key(r, &key);
+            }
+            Json_Skip_Value(r, (uint8_t)(depth + 1));
+            more = !r->error && Json_Next(r, close);
+        }
+    }
+    else
+    {
+        Json_Token token;
+        Json_Read_Token(r, &token);
+    }
+    return !r->error;
+}
+
+/* Counts the members of the next object or the elements of the next array without consuming them */
+static uint32_t Json_Count(Json_Reader* r, char open, char close)
+{
+    Json_Reader counter = *r;
+    uint32_t count = 0;
+    bool more = Json_Begin(&counter, open, close);
+    while (more)
+    {
+        Json_Token key;
+        if ('}' == close)
+        {
+            Json_Read_Key(&counter, &key);
+        }
+        Json_Skip_Value(&counter, 1);
+        count++;
+        more = !counter.error && Json_Next(&counter, close);
+    }
+    r->error = counter.error;
+    return count;
+}
+
+static bool Json_Token_Equals(const Json_Token* token, const char* value)
+{
+    const size_t length = strlen(value);
+    return !token->hasEscape && length == token->length && 0 == memcmp(token->data, value, length);
+}
+
+static bool Json_Read_Hex4(const char* data, uint32_t* value)
+{
+    *value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        const char c = data[i];
+        uint32_t digit = 0;
+        if (c >= '0' && c <= '9')
+        {
+            digit = (uint32_t)(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = (uint32_t)(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            digit = (uint32_t)(c - 'A' + 10);
+        }
+        else
+        {
+            return false;
+        }
+        *value = (*value << 4) | digit;
+    }
+    return true;
+}
+
+/* Reads the escaped unicode character at data[*i] (after "\u") and encodes it in UTF-8 into out */
+static bool Json_Unescape_Unicode(const Json_Token* token, uint32_t* i, SOPC_Byte* out, int32_t* n)
+{
+    uint32_t cp = 0;
+    if (*i + 4 > token->length || !Json_Read_Hex4(token->data + *i, &cp))
+    {
+        return false;
+    }
+    *i += 4;
+    if (cp >= 0xD800 && cp <= 0xDBFF)
+    {
+        // High surrogate: shall be followed by an escaped low surrogate
+        uint32_t low = 0;
+        if (*i + 6 > token->length || '\\' != token->data[*i] || 'u' != token->data[*i + 1] ||
+            !Json_Read_Hex4(token->data + *i + 2, &low) || low < 0xDC00 || low > 0xDFFF)
+        {
+            return false;
+        }
+        *i += 6;
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    }
+    else if (cp >= 0xDC00 && cp <= 0xDFFF)
+    {
+        return false;
+    }
+
+    if (cp < 0x80)
+    {
+        out[(*n)++] = (SOPC_Byte) cp;
+    }
+    else if (cp < 0x800)
+    {
+        out[(*n)++] = (SOPC_Byte)(0xC0 | (cp >> 6));
+        out[(*n)++] = (SOPC_Byte)(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        out[(*n)++] = (SOPC_Byte)(0xE0 | (cp >> 12));
+        out[(*n)++] = (SOPC_Byte)(0x80 | ((cp >> 6) & 0x3F));
+        out[(*n)++] = (SOPC_Byte)(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        out[(*n)++] = (SOPC_Byte)(0xF0 | (cp >> 18));
+        out[(*n)++] = (SOPC_Byte)(0x80 | ((cp >> 12) & 0x3F));
+        out[(*n)++] = (SOPC_Byte)(0x80 | ((cp >> 6) & 0x3F));
+        out[(*n)++] = (SOPC_Byte)(0x80 | (cp & 0x3F));
+    }
+    return true;
+}
+
+/* Copies the unescaped string token into an initialized string.
+ * The unescaped string is never longer than the token: it is allocated once. */
+static SOPC_ReturnStatus Json_Token_To_String(const Json_Token* token, SOPC_String* string)
+{
+    if (!token->isString || token->length >= INT32_MAX)
+    {
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    SOPC_Byte* data = SOPC_Malloc(token->length + 1);
+    if (NULL == data)
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    bool valid = true;
+    int32_t n = 0;
+    for (uint32_t i = 0; i < token->length && valid; i++)
+    {
+        const char c = token->data[i];
+        if ('\\' != c)
+        {
+            data[n++] = (SOPC_Byte) c;
+            continue;
+        }
+        // The string reader guarantees an escape is not the last character
+        i++;
+        switch (token->data[i])
+        {
+        case '"':
+        case '\\':
+        case '/':
+            data[n++] = (SOPC_Byte) token->data[i];
+            break;
+        case 'b':
+            data[n++] = '\b';
+            break;
+        case 'f':
+            data[n++] = '\f';
+            break;
+        case 'n':
+            data[n++] = '\n';
+            break;
+        case 'r':
+            data[n++] = '\r';
+            break;
+        case 't':
+            data[n++] = '\t';
+            break;
+        case 'u':
+            i++;
+            valid = Json_Unescape_Unicode(token, &i, data, &n);
+            // Loop increment
+            i--;
+            break;
+        default:
+            valid = false;
+            break;
+        }
+    }
+
+    if (!valid)
+    {
+        SOPC_Free(data);
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    data[n] = '\0';
+    string->Length = n;
+    string->DoNotClear = false;
+    string->Data = data;
+    return SOPC_STATUS_OK;
+}
+
+/* Unsigned integers are JSON numbers, 64-bit integers may also be JSON strings */
+static bool Json_Token_To_UInt(const Json_Token* token, bool allowString, uint8_t width, void* dest)
+{
+    return (!token->isString || allowString) && !token->hasEscape && token->length > 0 && token->data[0] >= '0' &&
+           token->data[0] <= '9' && SOPC_strtouint(token->data, token->length, width, dest);
+}
+
+static bool Json_Token_To_Int(const Json_Token* token, bool allowString, uint8_t width, void* dest)
+{
+    return (!token->isString || allowString) && !token->hasEscape && token->length > 0 &&
+           ('-' == token->data[0] || (token->data[0] >= '0' && token->data[0] <= '9')) &&
+           SOPC_strtoint(token->data, token->length, width, dest);
+}
+
+/* Floating point numbers are JSON numbers, except the special values encoded as "NaN", "Infinity" and "-Infinity" */
+static bool Json_Token_To_Double(const Json_Token* token, uint8_t width, void* dest)
+{
+    if (token->isString)
+    {
+        double value = 0.0;
+        if (Json_Token_Equals(token, "NaN"))
+        {
+            value = NAN;
+        }
+        else if (Json_Token_Equals(token, "Infinity"))
+        {
+            value = INFINITY;
+        }
+        else if (Json_Token_Equals(token, "-Infinity"))
+        {
+            value = -INFINITY;
+        }
+        else
+        {
+            return false;
+        }
+        if (32 == width)
+        {
+            *(float*) dest = (float) value;
+        }
+        else
+        {
+            *(double*) dest = value;
+        }
+        return true;
+    }
+    return token->length > 0 && ('-' == token->data[0] || (token->data[0] >= '0' && token->data[0] <= '9')) &&
+           SOPC_strtodouble(token->data, token->length, width, dest);
+}
+
+/* Decodes a scalar value of the given type into the variant.
+ * The type of a value decoded with no expected type (SOPC_Null_Id) is deduced from the JSON type. */
+static SOPC_ReturnStatus Json_Decode_Scalar(const Json_Token* token, SOPC_BuiltinId type, SOPC_Variant* variant)
+{
+    if (!token->isString && Json_Token_Equals(token, "null"))
+    {
+        variant->BuiltInTypeId = SOPC_Null_Id;
+        return SOPC_STATUS_OK;
+    }
+    if (SOPC_Null_Id == type)
+    {
+        if (token->isString)
+        {
+            type = SOPC_String_Id;
+        }
+        else if (Json_Token_Equals(token, "true") || Json_Token_Equals(token, "false"))
+        {
+            type = SOPC_Boolean_Id;
+        }
+        else
+        {
+            type = SOPC_Double_Id;
+        }
+    }
+
+    SOPC_VariantValue* value = &variant->Value;
+    bool valid = false;
+    switch (type)
+    {
+    case SOPC_Boolean_Id:
+        valid = !token->isString && (Json_Token_Equals(token, "true") || Json_Token_Equals(token, "false"));
+        value->Boolean = valid && 't' == token->data[0];
+        break;
+    case SOPC_SByte_Id:
+        valid = Json_Token_To_Int(token, false, 8, &value->Sbyte);
+        break;
+    case SOPC_Byte_Id:
+        valid = Json_Token_To_UInt(token, false, 8, &value->Byte);
+        break;
+    case SOPC_Int16_Id:
+        valid = Json_Token_To_Int(token, false, 16, &value->Int16);
+        break;
+    case SOPC_UInt16_Id:
+        valid = Json_Token_To_UInt(token, false, 16, &value->Uint16);
+        break;
+    case SOPC_Int32_Id:
+        valid = Json_Token_To_Int(token, false, 32, &value->Int32);
+        break;
+    case SOPC_UInt32_Id:
+        valid = Json_Token_To_UInt(token, false, 32, &value->Uint32);
+        break;
+    case SOPC_Int64_Id:
+        valid = Json_Token_To_Int(token, true, 64, &value->Int64);
+        break;
+    case SOPC_UInt64_Id:
+        valid = Json_Token_To_UInt(token, true, 64, &value->Uint64);
+        break;
+    case SOPC_Float_Id:
+        valid = Json_Token_To_Double(token, 32, &value->Floatv);
+        break;
+    case SOPC_Double_Id:
+        valid = Json_Token_To_Double(token, 64, &value->Doublev);
+        break;
+    case SOPC_StatusCode_Id:
+        valid = Json_Token_To_UInt(token, false, 32, &value->Status);
+        break;
+    case SOPC_String_Id:
+        valid = (SOPC_STATUS_OK == Json_Token_To_String(token, &value->String));
+        break;
+    case SOPC_DateTime_Id:
+        valid = token->isString && !token->hasEscape &&
+                SOPC_STATUS_OK == SOPC_Time_FromXsdDateTime(token->data, token->length, &value->Date);
+        break;
+    default:
+        return SOPC_STATUS_NOT_SUPPORTED;
+    }
+
+    if (!valid)
+    {
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    variant->BuiltInTypeId = type;
+    variant->ArrayType = SOPC_VariantArrayType_SingleValue;
+    return SOPC_STATUS_OK;
+}
+
+/* Decodes a one dimension array of scalar values of the given type into the variant */
+static SOPC_ReturnStatus Json_Decode_Array(Json_Reader* r, SOPC_BuiltinId type, SOPC_Variant* variant)
+{
+    if (SOPC_Null_Id == type)
+    {
+        // The type of the elements cannot be deduced
+        return SOPC_STATUS_NOT_SUPPORTED;
+    }
+    const uint32_t length = Json_Count(r, '[', ']');
+    if (r->error || length > INT32_MAX)
+    {
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    if (!SOPC_Variant_Initialize_Array(variant, type, (int32_t) length))
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    bool more = Json_Begin(r, '[', ']');
+    for (int32_t i = 0; more && SOPC_STATUS_OK == status; i++)
+    {
+        Json_Token token;
+        SOPC_Variant element;
+        SOPC_Variant_Initialize(&element);
+        status = valid_bool_to_status(Json_Read_Token(r, &token));
+        if (SOPC_STATUS_OK == status)
+        {
+            status = Json_Decode_Scalar(&token, type, &element);
+        }
+        // A null element keeps the default value of the type
+        if (SOPC_STATUS_OK == status && SOPC_Null_Id != element.BuiltInTypeId &&
+            !SOPC_Variant_CopyInto_ArrayValueAt(variant, type, i, &element.Value))
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+        SOPC_Variant_Clear(&element);
+        more = (SOPC_STATUS_OK == status) && Json_Next(r, ']');
+    }
+    if (SOPC_STATUS_OK == status && r->error)
+    {
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+    return status;
+}
+
+/* Decodes a Variant with the reversible encoding {"Type":<BuiltinId>,"Body":<value>} */
+static SOPC_ReturnStatus Json_Decode_Reversible_Variant(Json_Reader* r, SOPC_Variant* variant)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    uint8_t type = SOPC_Null_Id;
+    bool hasBody = false;
+    Json_Reader body = *r;
+
+    bool more = Json_Begin(r, '{', '}');
+    while (more && SOPC_STATUS_OK == status)
+    {
+        Json_Token key;
+        Json_Token value;
+        Json_Read_Key(r, &key);
+        if (Json_Token_Equals(&key, "Type"))
+        {
+            if (Json_Read_Token(r, &value) &&
+                (!Json_Token_To_UInt(&value, false, 8, &type) || type > SOPC_BUILTINID_MAX))
+            {
+                status = SOPC_STATUS_ENCODING_ERROR;
+            }
+        }
+        else if (Json_Token_Equals(&key, "Body"))
+        {
+            hasBody = true;
+            body = *r;
+            Json_Skip_Value(r, 1);
+        }
+        else if (Json_Token_Equals(&key, "Dimensions"))
+        {
+            // Multi-dimension arrays are not managed
+            status = SOPC_STATUS_NOT_SUPPORTED;
+        }
+        else
+        {
+            Json_Skip_Value(r, 1);
+        }
+        more = (SOPC_STATUS_OK == status) && Json_Next(r, '}');
+    }
+    if (SOPC_STATUS_OK == status && r->error)
+    {
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+
+    if (SOPC_STATUS_OK == status && hasBody && SOPC_Null_Id != type)
+    {
+        if ('[' == Json_Peek(&body))
+        {
+            status = Json_Decode_Array(&body, (SOPC_BuiltinId) type, variant);
+        }
+        else
+        {
+            Json_Token value;
+            status = valid_bool_to_status(Json_Read_Token(&body, &value));
+            if (SOPC_STATUS_OK == status)
+            {
+                status = Json_Decode_Scalar(&value, (SOPC_BuiltinId) type, variant);
+            }
+        }
+    }
+    else if (SOPC_STATUS_OK == status)
+    {
+        // No Body: default value of the type
+        variant->BuiltInTypeId = (SOPC_BuiltinId) type;
+    }
+    return status;
+}
+
+/* Decodes a DataSetMessage field with the expected type of the field, or SOPC_Null_Id if it is unknown */
+static SOPC_ReturnStatus Json_Decode_Field(Json_Reader* r, SOPC_BuiltinId type, SOPC_Variant* variant)
+{
+    const char c = Json_Peek(r);
+    if ('{' == c)
+    {
+        return Json_Decode_Reversible_Variant(r, variant);
+    }
+    if ('[' == c)
+    {
+        return Json_Decode_Array(r, type, variant);
+    }
+    Json_Token token;
+    if (!Json_Read_Token(r, &token))
+    {
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    return Json_Decode_Scalar(&token, type, variant);
+}
+
+/* Decodes the Payload object of a DataSetMessage.
+ * The fields are matched in order with the FieldMetaData of the reader, their names are not used. */
+static SOPC_ReturnStatus Json_Decode_Payload(Json_Reader* r,
+                                             SOPC_Dataset_LL_DataSetMessage* dsm,
+                                             const SOPC_DataSetReader* reader)
+{
+    const uint32_t nbFields = Json_Count(r, '{', '}');
+    if (r->error)
+    {
+        return SOPC_STATUS_ENCODING_ERROR;
+    }
+    if (nbFields > UINT16_MAX)
+    {
+        return SOPC_STATUS_NOT_SUPPORTED;
+    }
+    if (!SOPC_Dataset_LL_DataSetMsg_Allocate_DataSetField_Array(dsm, (uint16_t) nbFields))
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    const uint16_t nbMetaData = SOPC_DataSetReader_Nb_FieldMetaData(reader);
+    bool more = Json_Begin(r, '{', '}');
+    for (uint16_t i = 0; more && SOPC_STATUS_OK == status; i++)
+    {
+        Json_Token name;
+        status = valid_bool_to_status(Json_Read_Key(r, &name));
+
+        SOPC_BuiltinId type = SOPC_Null_Id;
+        if (i < nbMetaData)
+        {
+            type = SOPC_FieldMetaData_Get_BuiltinType(SOPC_DataSetReader_Get_FieldMetaData_At(reader, i));
+        }
+        SOPC_Variant* variant = NULL;
+        if (SOPC_STATUS_OK == status)
+        {
+            variant = SOPC_Variant_Create();
+            status = (NULL == variant ? SOPC_STATUS_OUT_OF_MEMORY : SOPC_STATUS_OK);
+        }
+        if (SOPC_STATUS_OK == status)
+        {
+            status = Json_Decode_Field(r, type, variant);
+        }
+        if (SOPC_STATUS_OK == status)
+        {
+            // The DataSetMessage takes ownership of the variant
+            status = valid_bool_to_status(SOPC_Dataset_LL_DataSetMsg_Set_DataSetField_Variant_At(dsm, variant, i));
+        }
+        else
+        {
+            SOPC_Variant_Delete(variant);
+        }
+        more = (SOPC_STATUS_OK == status) && Json_Next(r, '}');
+    }
+    if (SOPC_STATUS_OK == status && r->error)
+    {
+        status = SOPC_STATUS_ENCODING_ERROR;
+    }
+    return status;
+}
+
+/* Sets the PublisherId of the header. Integer PublisherIds are encoded as strings containing only digits. */
+static SOPC_NetworkMessage_Error_Code Json_Set_PublisherId(SOPC_Dataset_LL_NetworkMessage_Header* header,
+                                                           const Json_Token* token)
+{
+    uint64_t id = 0;
+    if (Json_Token_To_UInt(token, true, 64, &id))
+    {
+        bool digits = true;
+        for (uint32_t i = 0; i < token->length && digits; i++)
+        {
+            digits = token->data[i] >= '0' && token->data[i] <= '9';
+        }
+        if (digits)
+        {
+            SOPC_Dataset_LL_NetworkMessage_Set_PublisherId_UInt64(header, id);
+            return SOPC_NetworkMessage_Error_Code_None;
+        }
+    }
+    if (!token->isString || token->length > INT32_MAX)
+    {
+        return SOPC_JSON_NetworkMessage_Error_Read_PublisherId;
+    }
+
+    // The PublisherId is copied into the header: refer directly to the token when it is not escaped
+    SOPC_String id_string;
+    SOPC_String_Initialize(&id_string);
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    if (token->hasEscape)
+    {
+        status = Json_Token_To_String(token, &id_string);
+    }
+    else
+    {
+        id_string.Length = (int32_t) token->length;
+        id_string.DoNotClear = true;
+        SOPC_GCC_DIAGNOSTIC_PUSH
+        SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+        id_string.Data = (SOPC_Byte*) token->data;
+        SOPC_GCC_DIAGNOSTIC_RESTORE
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        SOPC_Dataset_LL_NetworkMessage_Set_PublisherId_String(header, id_string);
+    }
+    SOPC_String_Clear(&id_string);
+    return checkAndGetErrorCode(status, SOPC_JSON_NetworkMessage_Error_Read_PublisherId);
+}
+
+/* Decodes the NetworkMessage header members and returns in messages the reader positioned on its DataSetMessages:
+ * - the "Messages" member value, an array of DataSetMessages or a single DataSetMessage,
+ * - the message itself when it is a single DataSetMessage or an array of DataSetMessages without header. */
+static SOPC_NetworkMessage_Error_Code Json_Decode_NetworkMessage_Header(Json_Reader* r,
+                                                                        SOPC_Dataset_LL_NetworkMessage_Header* header,
+                                                                        Json_Reader* messages)
+{
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    bool isDataMessage = true;
+    bool hasMessages = false;
+    bool hasPayload = false;
+
+    *messages = *r;
+    if ('[' == Json_Peek(r))
+    {
+        Json_Skip_Value(r, 0);
+    }
+    else
+    {
+        bool more = Json_Begin(r, '{', '}');
+        while (more && SOPC_NetworkMessage_Error_Code_None == code)
+        {
+            Json_Token key;
+            Json_Token value;
+            Json_Read_Key(r, &key);
+            if (Json_Token_Equals(&key, "MessageType"))
+            {
+                // Might be the MessageType of a single DataSetMessage without NetworkMessage header
+                isDataMessage = Json_Read_Token(r, &value) && value.isString && Json_Token_Equals(&value, "ua-data");
+            }
+            else if (Json_Token_Equals(&key, "PublisherId"))
+            {
+                if (Json_Read_Token(r, &value))
+                {
+                    code = Json_Set_PublisherId(header, &value);
+                }
+            }
+            else if (Json_Token_Equals(&key, "Messages"))
+            {
+                hasMessages = true;
+                *messages = *r;
+                Json_Skip_Value(r, 0);
+            }
+            else
+            {
+                hasPayload = hasPayload || Json_Token_Equals(&key, "Payload");
+                Json_Skip_Value(r, 0);
+            }
+            more = !r->error && Json_Next(r, '}');
+        }
+    }
+
+    // Only whitespaces are expected after the message
+    Json_Skip_Whitespaces(r);
+    if (SOPC_NetworkMessage_Error_Code_None == code && (r->error || r->pos != r->length))
+    {
+        code = SOPC_JSON_NetworkMessage_Error_Read_Syntax;
+    }
+    else if (SOPC_NetworkMessage_Error_Code_None == code && hasMessages && !isDataMessage)
+    {
+        // Metadata, discovery and other messages are not managed
+        code = SOPC_JSON_NetworkMessage_Error_Read_MessageType;
+    }
+    else if (SOPC_NetworkMessage_Error_Code_None == code && !hasMessages && '{' == Json_Peek(messages) &&
+             !hasPayload)
+    {
+        code = SOPC_JSON_NetworkMessage_Error_Read_MessageType;
+    }
+    return code;
+}
+
+/* Decodes a DataSetMessage, returns the reader of the DataSetMessage or NULL if it is skipped */
+static SOPC_NetworkMessage_Error_Code Json_Decode_DataSetMessage(
+    Json_Reader* r,
+    SOPC_Dataset_LL_DataSetMessage* dsm,
+    uint8_t dsmIndex,
+    const SOPC_UADP_Configuration* conf,
+    SOPC_Conf_PublisherId pubId,
+    const SOPC_UADP_NetworkMessage_Reader_Configuration* readerConf,
+    const SOPC_ReaderGroup* group,
+    const SOPC_DataSetReader** reader)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_DataSet_LL_UadpDataSetMessageContentMask dsm_conf = *SOPC_Dataset_LL_DataSetMsg_Get_ContentMask(dsm);
+    dsm_conf.fieldEncoding = DataSet_LL_FieldEncoding_Variant;
+    dsm_conf.dataSetMessageType = DataSet_LL_MessageType_KeyFrame;
+    dsm_conf.dataSetMessageSequenceNumberFlag = false;
+    uint16_t writerId = 0;
+    uint32_t dsmSN = 0;
+    bool hasPayload = false;
+    Json_Reader payload = *r;
+
+    *reader = NULL;
+    bool more = Json_Begin(r, '{', '}');
+    while (more && SOPC_NetworkMessage_Error_Code_None == code)
+    {
+        Json_Token key;
+        Json_Token value;
+        Json_Read_Key(r, &key);
+        if (Json_Token_Equals(&key, "DataSetWriterId"))
+        {
+            if (Json_Read_Token(r, &value) && !Json_Token_To_UInt(&value, false, 16, &writerId))
+            {
+                code = SOPC_JSON_NetworkMessage_Error_Read_WriterId;
+            }
+        }
+        else if (Json_Token_Equals(&key, "SequenceNumber"))
+        {
+            dsm_conf.dataSetMessageSequenceNumberFlag = true;
+            if (Json_Read_Token(r, &value) && !Json_Token_To_UInt(&value, false, 32, &dsmSN))
+            {
+                code = SOPC_UADP_NetworkMessage_Error_Read_DsmSeqNum_Failed;
+            }
+        }
+        else if (Json_Token_Equals(&key, "MessageType"))
+        {
+            if (Json_Read_Token(r, &value) && Json_Token_Equals(&value, "ua-keepalive"))
+            {
+                dsm_conf.dataSetMessageType = DataSet_LL_MessageType_KeepAlive;
+            }
+            else if (!r->error && !Json_Token_Equals(&value, "ua-keyframe"))
+            {
+                // Delta frames and events are not managed
+                code = SOPC_UADP_NetworkMessage_Error_Unsupported_DsmType;
+            }
+        }
+        else if (Json_Token_Equals(&key, "Payload"))
+        {
+            hasPayload = true;
+            payload = *r;
+            Json_Skip_Value(r, 0);
+        }
+        else
+        {
+            Json_Skip_Value(r, 0);
+        }
+        more = !r->error && Json_Next(r, '}');
+    }
+    if (SOPC_NetworkMessage_Error_Code_None == code && r->error)
+    {
+        code = SOPC_JSON_NetworkMessage_Error_Read_Syntax;
+    }
+
+    if (SOPC_NetworkMessage_Error_Code_None == code)
+    {
+        SOPC_Dataset_LL_DataSetMsg_Set_WriterId(dsm, writerId);
+        *reader = readerConf->callbacks.pGetReader_Func(group, conf, writerId, dsmIndex);
+    }
+    if (SOPC_NetworkMessage_Error_Code_None != code || NULL == *reader)
+    {
+        return code;
+    }
+
+    /* If tuple [PublisherId, DataSetWriterId] is not defined don't check the dataSetMessage sequence number.
+     * The 32 bits JSON sequence number is truncated as the 16 bits UADP one. */
+    if (dsm_conf.dataSetMessageSequenceNumberFlag && NULL != readerConf->checkDataSetMessageSN_Func && 0 != writerId &&
+        readerConf->checkDataSetMessageSN_Func(&pubId, writerId, (uint16_t) dsmSN))
+    {
+        SOPC_Dataset_LL_DataSetMsg_Set_SequenceNumber(dsm, (uint16_t) dsmSN);
+    }
+    SOPC_Dataset_LL_DataSetMsg_Set_ContentMask(dsm, &dsm_conf);
+
+    if (DataSet_LL_MessageType_KeepAlive != dsm_conf.dataSetMessageType)
+    {
+        status = (hasPayload ? Json_Decode_Payload(&payload, dsm, *reader) : SOPC_STATUS_ENCODING_ERROR);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_DsmFields_Failed);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = readerConf->callbacks.pSetDsm_Func(dsm, readerConf->targetConfig, *reader);
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_BadMetaData);
+    }
+    return code;
+}
+
+SOPC_NetworkMessage_Error_Code SOPC_JSON_NetworkMessage_Decode(
+    SOPC_Buffer* buffer,
+    const SOPC_UADP_NetworkMessage_Reader_Configuration* reader_config,
+    const SOPC_PubSubConnection* connection,
+    SOPC_UADP_NetworkMessage** uadp_nm)
+{
+    if (NULL == uadp_nm || NULL != *uadp_nm || NULL == buffer || NULL == reader_config || NULL == connection ||
+        NULL == reader_config->callbacks.pGetGroup_Func || NULL == reader_config->callbacks.pGetReader_Func ||
+        NULL == reader_config->callbacks.pSetDsm_Func || buffer->position > buffer->length)
+    {
+        return SOPC_NetworkMessage_Error_Code_InvalidParameters;
+    }
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    const SOPC_ReaderGroup* group = NULL;
+    SOPC_Dataset_LL_NetworkMessage* nm = NULL;
+    SOPC_Dataset_LL_NetworkMessage_Header* header = NULL;
+    SOPC_UADP_Configuration* conf = NULL;
+    Json_Reader reader = {.data = (const char*) buffer->data + buffer->position,
+                          .length = buffer->length - buffer->position,
+                          .pos = 0,
+                          .error = false};
+    Json_Reader messages = reader;
+
+    *uadp_nm = SOPC_Network_Message_Create();
+    if (NULL == *uadp_nm || NULL == (*uadp_nm)->nm)
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+        code = SOPC_UADP_NetworkMessage_Error_Read_Alloc_Failed;
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        nm = (*uadp_nm)->nm;
+        header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
+        conf = SOPC_Dataset_LL_NetworkMessage_GetHeaderConfig(header);
+        SOPC_ASSERT(NULL != header && NULL != conf);
+        // JSON messages have no GroupId and GroupVersion, the PublisherId is optional
+        conf->PublisherIdFlag = false;
+
+        code = Json_Decode_NetworkMessage_Header(&reader, header, &messages);
+        status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+    }
+
+    // Use caller callback to identify the group matching the received PublisherId
+    if (SOPC_STATUS_OK == status)
+    {
+        const SOPC_Dataset_LL_PublisherId* pubid = SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header);
+        group = reader_config->callbacks.pGetGroup_Func(connection, conf, pubid, 0, 0);
+        if (NULL == group)
+        {
+            set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_NoMatchingGroup);
+        }
+    }
+
+    // No security for JSON: check that subscriber expects security mode is none
+    if (SOPC_STATUS_OK == status && NULL != reader_config->pGetSecurity_Func)
+    {
+        SOPC_PubSub_SecurityType* security = reader_config->pGetSecurity_Func(
+            SOPC_PUBSUB_SKS_DEFAULT_TOKENID,
+            Network_Layer_Convert_PublisherId(SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header)),
+            SOPC_ReaderGroup_Get_GroupId(group));
+        if (NULL != security && !Network_Check_ReceivedSecurityMode(security->mode, false, false))
+        {
+            set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_SecurityNone_Failed);
+        }
+    }
+
+    // DataSetMessages: an array or a single DataSetMessage
+    const bool isArray = ('[' == Json_Peek(&messages));
+    uint32_t nbDsm = 1;
+    if (SOPC_STATUS_OK == status && isArray)
+    {
+        nbDsm = Json_Count(&messages, '[', ']');
+        if (0 == nbDsm || nbDsm > UINT8_MAX)
+        {
+            set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Unsupported_MessageNum);
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = valid_bool_to_status(SOPC_Dataset_LL_NetworkMessage_Allocate_DataSetMsg_Array(nm, (uint8_t) nbDsm));
+        code = checkAndGetErrorCode(status, SOPC_UADP_NetworkMessage_Error_Read_Alloc_Failed);
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        const SOPC_Conf_PublisherId pubId =
+            Network_Layer_Convert_PublisherId(SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header));
+        bool decoded = false;
+        bool more = !isArray || Json_Begin(&messages, '[', ']');
+        for (uint8_t i = 0; more && SOPC_STATUS_OK == status; i++)
+        {
+            const SOPC_DataSetReader* dsmReader = NULL;
+            SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, i);
+            code = Json_Decode_DataSetMessage(&messages, dsm, i, conf, pubId, reader_config, group, &dsmReader);
+            status = (SOPC_NetworkMessage_Error_Code_None == code) ? SOPC_STATUS_OK : SOPC_STATUS_NOK;
+            decoded = decoded || NULL != dsmReader;
+            more = (SOPC_STATUS_OK == status) && isArray && Json_Next(&messages, ']');
+        }
+        if (SOPC_STATUS_OK == status && messages.error)
+        {
+            set_status_default(&status, &code, SOPC_JSON_NetworkMessage_Error_Read_Syntax);
+        }
+        else if (SOPC_STATUS_OK == status && !decoded)
+        {
+            set_status_default(&status, &code, SOPC_UADP_NetworkMessage_Error_Read_NoMatchingReader);
+        }
+    }
+
+    // Free memory in case of decoding failure
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_ASSERT(SOPC_NetworkMessage_Error_Code_None != code);
+        SOPC_UADP_NetworkMessage_Delete(*uadp_nm);
+        *uadp_nm = NULL;
+    }
+
+    return code;
+}
+
 static SOPC_Conf_PublisherId Network_Layer_Convert_PublisherId(const SOPC_Dataset_LL_PublisherId* src)
 {
     SOPC_Conf_PublisherId result;
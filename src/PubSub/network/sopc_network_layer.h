@@ -27,6 +27,9 @@
  * payload buffer copy, which may be encrypted
  *
  * The payload buffer contains the unencrypted payload
+ *
+ * The DataSetMessages of a NetworkMessage which does not fit in a single message are sent in chunk messages,
+ * and reassembled by the decoder when a reassembly context is provided.
  */
 
 #ifndef SOPC_NETWORK_LAYER_H_
@@ -39,6 +42,7 @@
 #include "sopc_pubsub_conf.h"
 #include "sopc_pubsub_security.h"
 #include "sopc_sub_target_variable.h"
+#include "sopc_uadp_chunks.h"
 
 /** Error code used by encoding and decoding functions */
 typedef enum
@@ -61,6 +65,7 @@ typedef enum
     SOPC_UADP_NetworkMessage_Error_Write_EncryptPaylod_Failed,
     SOPC_UADP_NetworkMessage_Error_Write_PayloadFlush_Failed,
     SOPC_UADP_NetworkMessage_Error_Write_Sign_Failed,
+    SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge,
     SOPC_UADP_NetworkMessage_Error_Read_Byte_Failed = 0x20000000,
     SOPC_UADP_NetworkMessage_Error_Read_Short_Failed,
     SOPC_UADP_NetworkMessage_Error_Read_Int_Failed,
@@ -80,9 +85,11 @@ typedef enum
     SOPC_UADP_NetworkMessage_Error_Read_InvalidBit,
     SOPC_UADP_NetworkMessage_Error_Read_DsmFields_Failed,
     SOPC_UADP_NetworkMessage_Error_Read_DsmSizeCheck_Failed,
+    SOPC_UADP_NetworkMessage_Error_Read_Chunk_Failed,
     SOPC_UADP_NetworkMessage_Error_Read_NoMatchingGroup = 0x30000000,
     SOPC_UADP_NetworkMessage_Error_Read_NoMatchingReader,
     SOPC_UADP_NetworkMessage_Error_Read_BadMetaData,
+    SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete,
     SOPC_UADP_NetworkMessage_Error_Unsupported_Version = 0x40000000,
     SOPC_UADP_NetworkMessage_Error_Unsupported_Flags1,
     SOPC_UADP_NetworkMessage_Error_Unsupported_Flags2,
@@ -106,6 +113,10 @@ typedef enum
     SOPC_JSON_NetworkMessage_Error_Variant_Encode,
     SOPC_JSON_NetworkMessage_Error_Write_Closing_Structure,
     SOPC_JSON_NetworkMessage_Error_Security_Unsupported,
+    SOPC_JSON_NetworkMessage_Error_Read_Syntax,
+    SOPC_JSON_NetworkMessage_Error_Read_MessageType,
+    SOPC_JSON_NetworkMessage_Error_Read_PublisherId,
+    SOPC_JSON_NetworkMessage_Error_Read_WriterId,
 } SOPC_NetworkMessage_Error_Code;
 
 typedef struct SOPC_UADP_Network_Message
@@ -147,8 +158,10 @@ SOPC_NetworkMessage_Error_Code SOPC_JSON_NetworkMessage_Encode(SOPC_Dataset_LL_N
  * @param security is the data use to set security flags. Can be NULL if security is not used
  * @param buffer_header [OUT] pointer to a newly allocated buffer with header flags encoded.
  * @param buffer_payload [OUT] pointer to a newly allocated buffer with payload data encoded.
- * @return ::SOPC_NetworkMessage_Error_Code_None if header and payload buffer are successfully encoded. Appropriate
- * error code otherwise
+ * @return ::SOPC_NetworkMessage_Error_Code_None if header and payload buffer are successfully encoded.
+ * ::SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge if the message does not fit in SOPC_PUBSUB_BUFFER_SIZE
+ * bytes: its DataSetMessages shall be sent in chunk messages (see ::SOPC_UADP_NetworkMessage_Encode_Chunk).
+ * Appropriate error code otherwise
  */
 SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Buffers(SOPC_Dataset_LL_NetworkMessage* nm,
                                                                        SOPC_PubSub_SecurityType* security,
@@ -167,13 +180,51 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_BuildFinalMessage(SOPC_P
                                                                           SOPC_Buffer* buffer_header,
                                                                           SOPC_Buffer** buffer_payload);
 
+/**
+ * @brief Encode a DataSetMessage of a NetworkMessage alone, to be sent in chunk messages with
+ *        ::SOPC_UADP_NetworkMessage_Encode_Chunk when the NetworkMessage does not fit in a single message.
+ *
+ * @param nm is the NetworkMessage containing the DataSetMessage
+ * @param dsmIndex is the index of the DataSetMessage in \p nm
+ * @param dsm_buffer [OUT] pointer to a newly allocated buffer with the DataSetMessage encoded.
+ *                   It is limited to SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE bytes.
+ * @return SOPC_NetworkMessage_Error_Code_None in case of success another code otherwise
+ */
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_DataSetMessage(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                              uint8_t dsmIndex,
+                                                                              SOPC_Buffer** dsm_buffer);
+
+/**
+ * @brief Build the next chunk message of an encoded DataSetMessage (OPC UA Part 14, 7.2.2.2.4).
+ *        The chunk data fills the message up to SOPC_PUBSUB_BUFFER_SIZE bytes.
+ *        Each chunk message is signed and encrypted as a complete NetworkMessage: the nonce and sequence number of
+ *        \p security shall be renewed before each call.
+ *
+ * @param nm is the NetworkMessage containing the DataSetMessage
+ * @param security is the data used to encrypt and sign. Can be NULL if security is not used
+ * @param dsmIndex is the index of the DataSetMessage in \p nm
+ * @param dsm_buffer the DataSetMessage encoded with ::SOPC_UADP_NetworkMessage_Encode_DataSetMessage
+ * @param chunkOffset [IN/OUT] offset of the chunk in \p dsm_buffer: 0 for the first chunk, it is updated to the offset
+ *                    of the next chunk. The last chunk is built when it reaches the length of \p dsm_buffer.
+ * @param buffer [OUT] pointer to a newly allocated buffer with the final chunk message
+ * @return SOPC_NetworkMessage_Error_Code_None in case of success another code otherwise
+ */
+SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Encode_Chunk(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                     SOPC_PubSub_SecurityType* security,
+                                                                     uint8_t dsmIndex,
+                                                                     const SOPC_Buffer* dsm_buffer,
+                                                                     uint32_t* chunkOffset,
+                                                                     SOPC_Buffer** buffer);
+
 /**
  * @brief Get updated preencoded buffer.
  *
  * @param nm NetworkMessage containing preencoded structure
- * @param security the data used to encrypt and sign. Must be NULL, preencode mechanism cannot handle sign and encrypt
+ * @param security the data used to encrypt and sign, with keys and nonce set. It shall be NULL if and only if the
+ *                 preencoded structure was created without security.
+ *                 The updated message is encrypted and signed into a preallocated buffer.
  *
- * @return SOPC_Buffer* pointer to updated preencoded buffer, NULL if an error occur.
+ * @return SOPC_Buffer* pointer to updated preencoded (and secured) buffer, NULL if an error occur.
  */
 SOPC_Buffer* SOPC_UADP_NetworkMessage_Get_PreencodedBuffer(SOPC_Dataset_LL_NetworkMessage* nm,
                                                            SOPC_PubSub_SecurityType* security);
@@ -240,12 +291,26 @@ typedef struct
     SOPC_UADP_NetworkMessage_SetDsm* pSetDsm_Func;
 } SOPC_UADP_NetworkMessage_Reader_Callbacks;
 
+/**
+ * \brief Working state of the decoding of a NetworkMessage. It can be provided by a caller decoding messages
+ *        in a single thread to be reused from one message to the other.
+ */
+typedef struct
+{
+    const SOPC_DataSetReader* dsmReaders[UINT8_MAX]; /**< Reader of each DataSetMessage */
+    uint16_t dsmSizes[UINT8_MAX];                    /**< Size of each DataSetMessage given in the payload header */
+} SOPC_UADP_NetworkMessage_Decode_Scratch;
+
 typedef struct
 {
     SOPC_UADP_NetworkMessage_Reader_Callbacks callbacks;
     SOPC_UADP_GetSecurity_Func* pGetSecurity_Func;
     SOPC_UADP_IsWriterSequenceNumberNewer_Func* checkDataSetMessageSN_Func;
     SOPC_SubTargetVariableConfig* targetConfig;
+    /* Optional: working state reused for each decoded message, allocated for each message if NULL */
+    SOPC_UADP_NetworkMessage_Decode_Scratch* scratch;
+    /* Optional: reassembly of the DataSetMessages received in chunk messages, which are rejected if NULL */
+    SOPC_UADP_Chunks_Reassembly* chunks;
 } SOPC_UADP_NetworkMessage_Reader_Configuration;
 
 /**
@@ -259,6 +324,8 @@ typedef struct
  *
  * \return  ::SOPC_NetworkMessage_Error_Code_None if buffer is successfully decoded  and led to at least 1 variable
  update.
+ *          ::SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete if buffer is a chunk message successfully added to
+ *          the reassembly of its DataSetMessage, which is not complete yet.
  *          Appropriate error code otherwise.
  *          Note that this can simply caused by the fact that the received message does not
  *          fit any Group/PublisherId/WriterId filters.
@@ -269,6 +336,32 @@ SOPC_NetworkMessage_Error_Code SOPC_UADP_NetworkMessage_Decode(
     const SOPC_PubSubConnection* connection,
     SOPC_UADP_NetworkMessage** uadp_nm);
 
+/**
+ * \brief Decode a JSON NetworkMessage (OPC UA Part 14, 7.2.3) into a NetworkMessage
+ *
+ * The message is either a NetworkMessage object with a "Messages" member, a single DataSetMessage object
+ * or an array of DataSetMessages. The same filtering callbacks as the UADP decoding are used. JSON messages have no
+ * GroupId and GroupVersion: the group is identified by the PublisherId only, and the readers by the DataSetWriterId.
+ * A PublisherId containing only digits is decoded as an integer PublisherId.
+ *
+ * The fields of a DataSetMessage payload are matched in order with the FieldMetaData of the reader,
+ * whose types are used to decode the non-reversible values. Reversible Variants ({"Type":...,"Body":...}) and
+ * one dimension arrays of scalar values are also decoded.
+ *
+ * \param buffer the JSON message to decode, from its current position to its length
+ * \param reader_config The configuration for message parsing/filtering
+ * \param connection The related connection
+ * \param uadp_nm a pointer to a new network message (must be freed by caller) if decoding succeeded
+ *
+ * \return  ::SOPC_NetworkMessage_Error_Code_None if buffer is successfully decoded and led to at least 1 variable
+ *          update. Appropriate error code otherwise.
+ */
+SOPC_NetworkMessage_Error_Code SOPC_JSON_NetworkMessage_Decode(
+    SOPC_Buffer* buffer,
+    const SOPC_UADP_NetworkMessage_Reader_Configuration* reader_config,
+    const SOPC_PubSubConnection* connection,
+    SOPC_UADP_NetworkMessage** uadp_nm);
+
 void SOPC_UADP_NetworkMessage_Delete(SOPC_UADP_NetworkMessage* uadp_nm);
 
 #endif /* SOPC_NETWORK_LAYER_H_ */
@@ -0,0 +1,338 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sopc_assert.h"
+#include "sopc_mem_alloc.h"
+#include "sopc_time.h"
+#include "sopc_uadp_chunks.h"
+
+/* Received range [start, end[ of a DataSetMessage */
+typedef struct SOPC_UADP_Chunks_Range
+{
+    uint32_t start;
+    uint32_t end;
+} SOPC_UADP_Chunks_Range;
+
+typedef struct SOPC_UADP_Chunks_Entry
+{
+    bool used;
+    SOPC_Conf_PublisherId pubId; /* String PublisherId is copied */
+    uint16_t writerId;
+    uint16_t sequenceNumber;
+    uint32_t totalSize;
+    uint32_t receivedSize;
+    SOPC_TimeReference expiration;
+    uint64_t creationOrder; /* Order of creation of the entries, used to discard the oldest one */
+    SOPC_Buffer* buffer;
+    uint32_t nbRanges;
+    uint32_t maxRanges;
+    SOPC_UADP_Chunks_Range* ranges; /* Sorted, disjoint and not contiguous ranges */
+} SOPC_UADP_Chunks_Entry;
+
+struct SOPC_UADP_Chunks_Reassembly
+{
+    uint32_t maxPending;
+    uint32_t maxMemory;
+    uint32_t timeoutMs;
+    uint32_t usedMemory;
+    uint64_t nextCreationOrder;
+    SOPC_UADP_Chunks_Entry* entries; /* maxPending entries */
+};
+
+static bool SOPC_UADP_Chunks_PubId_Equal(const SOPC_Conf_PublisherId* a, const SOPC_Conf_PublisherId* b)
+{
+    if (a->type != b->type)
+    {
+        return false;
+    }
+    switch (a->type)
+    {
+    case SOPC_UInteger_PublisherId:
+        return a->data.uint == b->data.uint;
+    case SOPC_String_PublisherId:
+        return SOPC_String_Equal(&a->data.string, &b->data.string);
+    default:
+        return true;
+    }
+}
+
+/* Releases the entry. Its buffer is deleted unless it was moved out of the entry */
+static void SOPC_UADP_Chunks_Entry_Release(SOPC_UADP_Chunks_Reassembly* reassembly, SOPC_UADP_Chunks_Entry* entry)
+{
+    SOPC_ASSERT(reassembly->usedMemory >= entry->totalSize);
+    reassembly->usedMemory -= entry->totalSize;
+    if (SOPC_String_PublisherId == entry->pubId.type)
+    {
+        SOPC_String_Clear(&entry->pubId.data.string);
+    }
+    SOPC_Buffer_Delete(entry->buffer);
+    SOPC_Free(entry->ranges);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static void SOPC_UADP_Chunks_Discard_Expired(SOPC_UADP_Chunks_Reassembly* reassembly, SOPC_TimeReference now)
+{
+    for (uint32_t i = 0; i < reassembly->maxPending; i++)
+    {
+        SOPC_UADP_Chunks_Entry* entry = &reassembly->entries[i];
+        if (entry->used && SOPC_TimeReference_Compare(now, entry->expiration) > 0)
+        {
+            SOPC_UADP_Chunks_Entry_Release(reassembly, entry);
+        }
+    }
+}
+
+/* Returns a free entry for a DataSetMessage of totalSize bytes, discarding the oldest ones if needed */
+static SOPC_UADP_Chunks_Entry* SOPC_UADP_Chunks_Get_Free_Entry(SOPC_UADP_Chunks_Reassembly* reassembly,
+                                                               uint32_t totalSize)
+{
+    SOPC_ASSERT(totalSize <= reassembly->maxMemory);
+    SOPC_UADP_Chunks_Entry* freeEntry = NULL;
+    do
+    {
+        SOPC_UADP_Chunks_Entry* oldest = NULL;
+        freeEntry = NULL;
+        for (uint32_t i = 0; i < reassembly->maxPending; i++)
+        {
+            SOPC_UADP_Chunks_Entry* entry = &reassembly->entries[i];
+            if (!entry->used)
+            {
+                freeEntry = (NULL == freeEntry ? entry : freeEntry);
+            }
+            else if (NULL == oldest || entry->creationOrder < oldest->creationOrder)
+            {
+                oldest = entry;
+            }
+        }
+        if (NULL == freeEntry || reassembly->usedMemory > reassembly->maxMemory - totalSize)
+        {
+            // There is at least one entry used otherwise the DataSetMessage would fit
+            SOPC_ASSERT(NULL != oldest);
+            SOPC_UADP_Chunks_Entry_Release(reassembly, oldest);
+            freeEntry = NULL;
+        }
+    } while (NULL == freeEntry);
+    return freeEntry;
+}
+
+/* Adds the range [start, end[ to the received ranges and returns the number of newly received bytes */
+static SOPC_ReturnStatus SOPC_UADP_Chunks_Add_Range(SOPC_UADP_Chunks_Entry* entry,
+                                                    uint32_t start,
+                                                    uint32_t end,
+                                                    uint32_t* newBytes)
+{
+    // First range which ends after or at the start of the new one: it is merged or inserted before
+    uint32_t first = 0;
+    while (first < entry->nbRanges && entry->ranges[first].end < start)
+    {
+        first++;
+    }
+    // Ranges [first, last[ overlap or are contiguous with the new range and are merged with it
+    uint32_t last = first;
+    uint32_t alreadyReceived = 0;
+    SOPC_UADP_Chunks_Range merged = {.start = start, .end = end};
+    while (last < entry->nbRanges && entry->ranges[last].start <= end)
+    {
+        const SOPC_UADP_Chunks_Range* range = &entry->ranges[last];
+        const uint32_t overlapStart = (range->start > start ? range->start : start);
+        const uint32_t overlapEnd = (range->end < end ? range->end : end);
+        alreadyReceived += (overlapEnd > overlapStart ? overlapEnd - overlapStart : 0);
+        merged.start = (range->start < merged.start ? range->start : merged.start);
+        merged.end = (range->end > merged.end ? range->end : merged.end);
+        last++;
+    }
+
+    if (first == last)
+    {
+        // Insert a new range
+        if (entry->nbRanges == entry->maxRanges)
+        {
+            const uint32_t maxRanges = (0 == entry->maxRanges ? 4 : 2 * entry->maxRanges);
+            SOPC_UADP_Chunks_Range* ranges =
+                SOPC_Realloc(entry->ranges, entry->maxRanges * sizeof(*ranges), maxRanges * sizeof(*ranges));
+            if (NULL == ranges)
+            {
+                return SOPC_STATUS_OUT_OF_MEMORY;
+            }
+            entry->ranges = ranges;
+            entry->maxRanges = maxRanges;
+        }
+        memmove(&entry->ranges[first + 1], &entry->ranges[first],
+                (entry->nbRanges - first) * sizeof(*entry->ranges));
+        entry->nbRanges++;
+    }
+    else if (last - first > 1)
+    {
+        // Remove the ranges merged in the first one
+        memmove(&entry->ranges[first + 1], &entry->ranges[last], (entry->nbRanges - last) * sizeof(*entry->ranges));
+        entry->nbRanges -= last - first - 1;
+    }
+    entry->ranges[first] = merged;
+    *newBytes = (end - start) - alreadyReceived;
+    return SOPC_STATUS_OK;
+}
+
+SOPC_UADP_Chunks_Reassembly* SOPC_UADP_Chunks_Reassembly_Create(uint32_t maxPending,
+                                                                uint32_t maxMemory,
+                                                                uint32_t timeoutMs)
+{
+    if (0 == maxPending || 0 == maxMemory)
+    {
+        return NULL;
+    }
+    SOPC_UADP_Chunks_Reassembly* reassembly = SOPC_Calloc(1, sizeof(*reassembly));
+    if (NULL != reassembly)
+    {
+        reassembly->entries = SOPC_Calloc(maxPending, sizeof(*reassembly->entries));
+        if (NULL == reassembly->entries)
+        {
+            SOPC_Free(reassembly);
+            return NULL;
+        }
+        reassembly->maxPending = maxPending;
+        reassembly->maxMemory = maxMemory;
+        reassembly->timeoutMs = timeoutMs;
+    }
+    return reassembly;
+}
+
+void SOPC_UADP_Chunks_Reassembly_Delete(SOPC_UADP_Chunks_Reassembly** reassembly)
+{
+    if (NULL == reassembly || NULL == *reassembly)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < (*reassembly)->maxPending; i++)
+    {
+        if ((*reassembly)->entries[i].used)
+        {
+            SOPC_UADP_Chunks_Entry_Release(*reassembly, &(*reassembly)->entries[i]);
+        }
+    }
+    SOPC_Free((*reassembly)->entries);
+    SOPC_Free(*reassembly);
+    *reassembly = NULL;
+}
+
+SOPC_ReturnStatus SOPC_UADP_Chunks_Reassembly_Add(SOPC_UADP_Chunks_Reassembly* reassembly,
+                                                  const SOPC_Conf_PublisherId* pubId,
+                                                  uint16_t writerId,
+                                                  uint16_t sequenceNumber,
+                                                  uint32_t chunkOffset,
+                                                  uint32_t totalSize,
+                                                  const uint8_t* data,
+                                                  uint32_t length,
+                                                  SOPC_Buffer** dsmBuffer)
+{
+    if (NULL == reassembly || NULL == pubId || NULL == data || NULL == dsmBuffer || NULL != *dsmBuffer ||
+        0 == length || totalSize > reassembly->maxMemory || chunkOffset > totalSize ||
+        length > totalSize - chunkOffset)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    const SOPC_TimeReference now = SOPC_TimeReference_GetCurrent();
+    SOPC_UADP_Chunks_Discard_Expired(reassembly, now);
+
+    SOPC_UADP_Chunks_Entry* entry = NULL;
+    for (uint32_t i = 0; i < reassembly->maxPending && NULL == entry; i++)
+    {
+        SOPC_UADP_Chunks_Entry* candidate = &reassembly->entries[i];
+        if (candidate->used && writerId == candidate->writerId && sequenceNumber == candidate->sequenceNumber &&
+            SOPC_UADP_Chunks_PubId_Equal(pubId, &candidate->pubId))
+        {
+            entry = candidate;
+        }
+    }
+    if (NULL != entry && totalSize != entry->totalSize)
+    {
+        // Another DataSetMessage with the same sequence number: restart the reassembly
+        SOPC_UADP_Chunks_Entry_Release(reassembly, entry);
+        entry = NULL;
+    }
+
+    if (NULL == entry)
+    {
+        entry = SOPC_UADP_Chunks_Get_Free_Entry(reassembly, totalSize);
+        entry->buffer = SOPC_Buffer_Create(totalSize);
+        status = (NULL != entry->buffer ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+        if (SOPC_STATUS_OK == status && SOPC_String_PublisherId == pubId->type)
+        {
+            entry->pubId.type = SOPC_String_PublisherId;
+            SOPC_String_Initialize(&entry->pubId.data.string);
+            status = SOPC_String_Copy(&entry->pubId.data.string, &pubId->data.string);
+        }
+        else if (SOPC_STATUS_OK == status)
+        {
+            entry->pubId = *pubId;
+        }
+        // Account the entry memory before its release in case of failure
+        entry->used = true;
+        entry->totalSize = totalSize;
+        reassembly->usedMemory += totalSize;
+        entry->writerId = writerId;
+        entry->sequenceNumber = sequenceNumber;
+        entry->expiration = SOPC_TimeReference_AddMilliseconds(now, reassembly->timeoutMs);
+        entry->creationOrder = reassembly->nextCreationOrder;
+        reassembly->nextCreationOrder++;
+    }
+
+    uint32_t newBytes = 0;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UADP_Chunks_Add_Range(entry, chunkOffset, chunkOffset + length, &newBytes);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        memcpy(entry->buffer->data + chunkOffset, data, length);
+        entry->receivedSize += newBytes;
+        if (entry->receivedSize == entry->totalSize)
+        {
+            // Move the complete DataSetMessage to the caller
+            entry->buffer->length = totalSize;
+            entry->buffer->position = 0;
+            *dsmBuffer = entry->buffer;
+            entry->buffer = NULL;
+            SOPC_UADP_Chunks_Entry_Release(reassembly, entry);
+        }
+    }
+    else
+    {
+        SOPC_UADP_Chunks_Entry_Release(reassembly, entry);
+    }
+    return status;
+}
+
+uint32_t SOPC_UADP_Chunks_Reassembly_Nb_Pending(SOPC_UADP_Chunks_Reassembly* reassembly)
+{
+    uint32_t nbPending = 0;
+    if (NULL != reassembly)
+    {
+        SOPC_UADP_Chunks_Discard_Expired(reassembly, SOPC_TimeReference_GetCurrent());
+        for (uint32_t i = 0; i < reassembly->maxPending; i++)
+        {
+            nbPending += (reassembly->entries[i].used ? 1 : 0);
+        }
+    }
+    return nbPending;
+}
@@ -0,0 +1,97 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * \file sopc_uadp_chunks.h
+ *
+ * \brief Reassembly of the DataSetMessages received in UADP chunk NetworkMessages (OPC UA Part 14, 7.2.2.2.4).
+ *
+ * A DataSetMessage is identified by its PublisherId, DataSetWriterId and DataSetMessage sequence number.
+ * The chunks may be received in any order and duplicated chunks are ignored.
+ * The memory used by the reassembly is bounded: the oldest incomplete DataSetMessages are discarded to receive new
+ * ones when the maximum number of DataSetMessages or the maximum memory is reached, and the incomplete
+ * DataSetMessages are discarded after a timeout.
+ *
+ * \note The reassembly context is not thread-safe: it shall be used by a single thread.
+ */
+
+#ifndef SOPC_UADP_CHUNKS_H_
+#define SOPC_UADP_CHUNKS_H_
+
+#include <stdint.h>
+
+#include "sopc_buffer.h"
+#include "sopc_enums.h"
+#include "sopc_pubsub_conf.h"
+
+typedef struct SOPC_UADP_Chunks_Reassembly SOPC_UADP_Chunks_Reassembly;
+
+/**
+ * \brief Creates a reassembly context
+ *
+ * \param maxPending  maximum number of DataSetMessages reassembled at the same time
+ * \param maxMemory   maximum memory (bytes) used by the DataSetMessages reassembled at the same time,
+ *                    it is also the maximum size of a reassembled DataSetMessage
+ * \param timeoutMs   delay (ms) after the first received chunk after which an incomplete DataSetMessage is discarded
+ *
+ * \return the reassembly context or NULL in case of failure
+ */
+SOPC_UADP_Chunks_Reassembly* SOPC_UADP_Chunks_Reassembly_Create(uint32_t maxPending,
+                                                                uint32_t maxMemory,
+                                                                uint32_t timeoutMs);
+
+/**
+ * \brief Deletes a reassembly context and the DataSetMessages being reassembled
+ */
+void SOPC_UADP_Chunks_Reassembly_Delete(SOPC_UADP_Chunks_Reassembly** reassembly);
+
+/**
+ * \brief Adds a received chunk to the reassembly of its DataSetMessage
+ *
+ * \param reassembly      the reassembly context
+ * \param pubId           PublisherId of the NetworkMessage containing the chunk
+ * \param writerId        DataSetWriterId of the DataSetMessage
+ * \param sequenceNumber  sequence number of the DataSetMessage
+ * \param chunkOffset     offset of the chunk data in the DataSetMessage
+ * \param totalSize       total size of the DataSetMessage
+ * \param data            the chunk data
+ * \param length          the chunk data length
+ * \param[out] dsmBuffer  set to a new buffer containing the DataSetMessage when this chunk completes it, left NULL
+ *                        otherwise. The buffer shall be deleted by the caller.
+ *
+ * \return SOPC_STATUS_OK if the chunk is accepted, SOPC_STATUS_INVALID_PARAMETERS if the chunk is not consistent
+ *         or the DataSetMessage is larger than the maximum memory, SOPC_STATUS_OUT_OF_MEMORY in case of allocation
+ *         failure.
+ */
+SOPC_ReturnStatus SOPC_UADP_Chunks_Reassembly_Add(SOPC_UADP_Chunks_Reassembly* reassembly,
+                                                  const SOPC_Conf_PublisherId* pubId,
+                                                  uint16_t writerId,
+                                                  uint16_t sequenceNumber,
+                                                  uint32_t chunkOffset,
+                                                  uint32_t totalSize,
+                                                  const uint8_t* data,
+                                                  uint32_t length,
+                                                  SOPC_Buffer** dsmBuffer);
+
+/**
+ * \brief Returns the number of DataSetMessages being reassembled, after discarding the expired ones
+ */
+uint32_t SOPC_UADP_Chunks_Reassembly_Nb_Pending(SOPC_UADP_Chunks_Reassembly* reassembly);
+
+#endif /* SOPC_UADP_CHUNKS_H_ */
@@ -52,6 +52,7 @@ struct MQTT_CONTEXT_CLIENT
     bool hasSubscribed;
 
     int nbReconnectTries; /* Store number of connection and reconnection tries */
+    SOPC_MQTT_Client_Options options; /* Client options, subQos only valid until initialization */
     MqttClientState* clientState;
     SOPC_PubSub_OnFatalError* cbFatalError;
     void* pUser; /* User Context */
@@ -76,14 +77,29 @@ static uint64_t get_unique_client_id(void);
 /************************************************************************/
 
 SOPC_ReturnStatus SOPC_MQTT_Send_Message(MqttContextClient* contextClient, const char* topic, SOPC_Buffer message)
+{
+    return SOPC_MQTT_Send_Message_QoS(contextClient, topic, message, MQTT_LIB_QOS, false);
+}
+
+SOPC_ReturnStatus SOPC_MQTT_Send_Message_QoS(MqttContextClient* contextClient,
+                                             const char* topic,
+                                             SOPC_Buffer message,
+                                             uint8_t qos,
+                                             bool retain)
 {
     MQTTAsync_message mqttMessage = MQTTAsync_message_initializer;
     MQTTAsync_responseOptions options = MQTTAsync_responseOptions_initializer;
     char mqttTopic[MQTT_LIB_MAX_SIZE_TOPIC_NAME] = {0};
 
+    if (qos > 2)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
     mqttMessage.payloadlen = (int) message.length;
     mqttMessage.payload = message.data;
-    mqttMessage.qos = MQTT_LIB_QOS;
+    mqttMessage.qos = qos;
+    mqttMessage.retained = retain ? 1 : 0;
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
 
     int n = snprintf(mqttTopic, MQTT_LIB_MAX_SIZE_TOPIC_NAME, "%s", topic);
@@ -95,11 +111,19 @@ SOPC_ReturnStatus SOPC_MQTT_Send_Message(MqttContextClient* contextClient, const
     }
     else
     {
-        if (MQTTAsync_isConnected(contextClient->client))
+        /* While reconnecting, the message is buffered by the library if buffering is enabled */
+        if (MQTTAsync_isConnected(contextClient->client) || contextClient->options.maxBufferedMessages > 0)
         {
             int MQTTAsyncResult = MQTTAsync_sendMessage(contextClient->client, mqttTopic, &mqttMessage, &options);
 
-            if (0 != MQTTAsyncResult)
+            if (MQTTASYNC_MAX_BUFFERED_MESSAGES == MQTTAsyncResult)
+            {
+                SOPC_Logger_TraceWarning(SOPC_LOG_MODULE_PUBSUB,
+                                         "Mqtt client %s Message not send, too many messages buffered (%" PRIu16 ")",
+                                         contextClient->clientId, contextClient->options.maxBufferedMessages);
+                status = SOPC_STATUS_NOK;
+            }
+            else if (0 != MQTTAsyncResult)
             {
                 SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB,
                                        "Mqtt client %s Failed to send message, Paho MQTT library error code %d",
@@ -135,6 +159,7 @@ SOPC_ReturnStatus SOPC_MQTT_InitializeAndConnect_Client(MqttContextClient* conte
 {
     MQTTAsync_deliveryComplete* cbDeliveryComplete = NULL;
     MQTTAsync_connectOptions options = MQTTAsync_connectOptions_initializer;
+    MQTTAsync_createOptions createOptions = MQTTAsync_createOptions_initializer;
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
     contextClient->client = NULL;
     contextClient->isSubscriber = false;
@@ -152,6 +177,7 @@ SOPC_ReturnStatus SOPC_MQTT_InitializeAndConnect_Client(MqttContextClient* conte
     uint64_t clientId = get_unique_client_id();
 
     int result = set_subscriber_options(contextClient, nbSubTopic, subTopic);
+    contextClient->options.subQos = NULL;
     if (0 != result)
     {
         status = SOPC_STATUS_NOK;
@@ -160,8 +186,13 @@ SOPC_ReturnStatus SOPC_MQTT_InitializeAndConnect_Client(MqttContextClient* conte
     if (SOPC_STATUS_OK == status)
     {
         snprintf(contextClient->clientId, SOPC_MAX_LENGTH_UINT64_TO_STRING - 1, "%" PRIu64, clientId);
-        int MQTTAsyncResult =
-            MQTTAsync_create(&contextClient->client, uri, contextClient->clientId, MQTTCLIENT_PERSISTENCE_NONE, NULL);
+        if (contextClient->options.maxBufferedMessages > 0)
+        {
+            createOptions.sendWhileDisconnected = 1;
+            createOptions.maxBufferedMessages = contextClient->options.maxBufferedMessages;
+        }
+        int MQTTAsyncResult = MQTTAsync_createWithOptions(&contextClient->client, uri, contextClient->clientId,
+                                                          MQTTCLIENT_PERSISTENCE_NONE, NULL, &createOptions);
         SOPC_Logger_TraceInfo(SOPC_LOG_MODULE_PUBSUB, "MQTTAsync_create returned %p",
                               (const void*) contextClient->client);
         if (MQTTAsyncResult != 0)
@@ -180,6 +211,10 @@ SOPC_ReturnStatus SOPC_MQTT_InitializeAndConnect_Client(MqttContextClient* conte
             options.onSuccess = cb_subscribe_on_connexion_success;
             options.context = contextClient;
             options.automaticReconnect = true;
+            if (contextClient->options.maxInflight > 0)
+            {
+                options.maxInflight = contextClient->options.maxInflight;
+            }
 
             if (NULL != username && NULL != password)
             {
@@ -211,6 +246,17 @@ SOPC_ReturnStatus SOPC_MQTT_Create_Client(MqttContextClient** contextClient)
     return status;
 }
 
+SOPC_ReturnStatus SOPC_MQTT_Set_Client_Options(MqttContextClient* contextClient,
+                                               const SOPC_MQTT_Client_Options* options)
+{
+    if (NULL == contextClient || NULL == options)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    contextClient->options = *options;
+    return SOPC_STATUS_OK;
+}
+
 void SOPC_MQTT_Release_Client(MqttContextClient* contextClient)
 {
     SOPC_ASSERT(NULL != contextClient);
@@ -378,9 +424,10 @@ static int set_subscriber_options(MqttContextClient* contextClient, uint16_t nbS
         contextClient->subContext.nbTopic = nbSubTopic;
         for (int i = 0; i < nbSubTopic; i++)
         {
-            if (NULL != subTopic[i])
+            uint8_t qos = (NULL != contextClient->options.subQos ? contextClient->options.subQos[i] : MQTT_LIB_QOS);
+            if (NULL != subTopic[i] && qos <= 2)
             {
-                contextClient->subContext.qos[i] = MQTT_LIB_QOS;
+                contextClient->subContext.qos[i] = qos;
                 SOPC_GCC_DIAGNOSTIC_IGNORE_DISCARD_QUALIFIER
                 contextClient->subContext.topic[i] = subTopic[i];
                 SOPC_GCC_DIAGNOSTIC_RESTORE
@@ -451,4 +498,42 @@ bool SOPC_MQTT_Client_Is_Connected(MqttContextClient* contextClient)
     return false;
 }
 
+SOPC_ReturnStatus SOPC_MQTT_Send_Message_QoS(MqttContextClient* contextClient,
+                                             const char* topic,
+                                             SOPC_Buffer message,
+                                             uint8_t qos,
+                                             bool retain)
+{
+    SOPC_UNUSED_ARG(contextClient);
+    SOPC_UNUSED_ARG(topic);
+    SOPC_UNUSED_ARG(message);
+    SOPC_UNUSED_ARG(qos);
+    SOPC_UNUSED_ARG(retain);
+    return SOPC_STATUS_NOT_SUPPORTED;
+}
+
+SOPC_ReturnStatus SOPC_MQTT_Set_Client_Options(MqttContextClient* contextClient,
+                                               const SOPC_MQTT_Client_Options* options)
+{
+    SOPC_UNUSED_ARG(contextClient);
+    SOPC_UNUSED_ARG(options);
+    return SOPC_STATUS_NOT_SUPPORTED;
+}
+
 #endif // USE_MQTT_PAHO == 1
+
+uint8_t SOPC_MQTT_Get_QoS(OpcUa_BrokerTransportQualityOfService qos)
+{
+    switch (qos)
+    {
+    case OpcUa_BrokerTransportQualityOfService_BestEffort:
+    case OpcUa_BrokerTransportQualityOfService_AtMostOnce:
+        return 0;
+    case OpcUa_BrokerTransportQualityOfService_AtLeastOnce:
+        return 1;
+    case OpcUa_BrokerTransportQualityOfService_ExactlyOnce:
+        return 2;
+    default:
+        return MQTT_LIB_QOS;
+    }
+}
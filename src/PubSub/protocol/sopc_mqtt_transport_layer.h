@@ -36,7 +36,7 @@
 
 /* MQTT connection hard coded configuration */
 
-#define MQTT_LIB_QOS (2)                   /* QOS of publish, subscribe set to 2*/
+#define MQTT_LIB_QOS (2)                   /* Default QOS of publish, subscribe set to 2*/
 #define MQTT_LIB_MAX_SIZE_TOPIC_NAME (256) /* Maximum length of a topic */
 #define MQTT_LIB_MAX_NB_TOPIC_NAME (256)   /* Maximum subscriber topics that can be handle by client */
 #define MQTT_LIB_CONNECTION_TIMEOUT (4)    /* Connection lib timeout = 4 s*/
@@ -44,6 +44,18 @@
 
 typedef struct MQTT_CONTEXT_CLIENT MqttContextClient; /* MQTT context client */
 
+/* Options of a MQTT client, see ::SOPC_MQTT_Set_Client_Options */
+typedef struct SOPC_MQTT_Client_Options
+{
+    const uint8_t* subQos; /**< QoS (0, 1 or 2) of each topic to subscribe or NULL to use ::MQTT_LIB_QOS.
+                                Array of the number of subscribed topics, read by
+                                ::SOPC_MQTT_InitializeAndConnect_Client */
+    uint16_t maxInflight;  /**< Maximum number of published messages not acknowledged by the broker yet,
+                                0 for the MQTT library default */
+    uint16_t maxBufferedMessages; /**< Maximum number of messages kept while the client is not connected and sent
+                                       once it is reconnected, 0 to drop the messages sent while disconnected */
+} SOPC_MQTT_Client_Options;
+
 typedef enum MQTT_CLIENT_STATE
 {
     SOPC_MQTT_CLIENT_UNITIALIZED =
@@ -73,6 +85,43 @@ typedef void FctMessageReceived(uint8_t* data, /**< Data received */
  */
 SOPC_ReturnStatus SOPC_MQTT_Send_Message(MqttContextClient* contextClient, const char* topic, SOPC_Buffer message);
 
+/**
+ * @brief Send message to topic destination with MQTT client using the given QoS and retain flag.
+ * Same as ::SOPC_MQTT_Send_Message otherwise. The message is also accepted while the client is reconnecting
+ * if messages buffering is enabled (see ::SOPC_MQTT_Client_Options).
+ *
+ * @param contextClient Context for MQTT library containing MQTT client
+ * @param topic Topic destination
+ * @param message Buffer with message information
+ * @param qos QoS of the message: 0 (at most once), 1 (at least once) or 2 (exactly once)
+ * @param retain true if the broker shall keep the message for the future subscribers of the topic
+ * @return ::SOPC_STATUS_OK if succeed sending or buffering message, ::SOPC_STATUS_NOK otherwise
+ */
+SOPC_ReturnStatus SOPC_MQTT_Send_Message_QoS(MqttContextClient* contextClient,
+                                             const char* topic,
+                                             SOPC_Buffer message,
+                                             uint8_t qos,
+                                             bool retain);
+
+/**
+ * @brief Set the options of the MQTT client, shall be called after ::SOPC_MQTT_Create_Client and
+ * before ::SOPC_MQTT_InitializeAndConnect_Client. Default options are used otherwise.
+ *
+ * @param contextClient Context for MQTT library containing MQTT client
+ * @param options The client options, copied by the function
+ * @return ::SOPC_STATUS_OK if succeed, ::SOPC_STATUS_INVALID_PARAMETERS otherwise
+ */
+SOPC_ReturnStatus SOPC_MQTT_Set_Client_Options(MqttContextClient* contextClient,
+                                               const SOPC_MQTT_Client_Options* options);
+
+/**
+ * @brief Convert an OPC UA broker transport quality of service to the MQTT QoS
+ *
+ * @param qos The requested delivery guarantee, ::OpcUa_BrokerTransportQualityOfService_NotSpecified for ::MQTT_LIB_QOS
+ * @return the MQTT QoS: 0, 1 or 2
+ */
+uint8_t SOPC_MQTT_Get_QoS(OpcUa_BrokerTransportQualityOfService qos);
+
 /**
  * @brief Initialize MQTT client and connection, Shall be called after ::SOPC_MQTT_Create_Client
  * To use MQTT client as a subscriber, number of sub topic must be superior to 0 and Topics to subscribe can't be NULL
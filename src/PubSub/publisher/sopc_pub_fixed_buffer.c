@@ -21,6 +21,7 @@
 
 #include "sopc_assert.h"
 #include "sopc_buffer.h"
+#include "sopc_crypto_provider.h"
 #include "sopc_dataset_ll_layer.h"
 #include "sopc_encoder.h"
 #include "sopc_logger.h"
@@ -51,6 +52,18 @@ struct SOPC_PubFixedBuffer_Buffer_Ctx
 
     // Preencoded network message
     SOPC_Buffer* buffer;
+
+    // Security mode used to preencode the network message (None if not secured)
+    SOPC_SecurityMode_Type securityMode;
+    // Position of security header fields updated for each message
+    uint32_t tokenId_position;
+    uint32_t nonce_position; // Random bytes followed by 32 bits sequence number
+    uint32_t nonceRandom_length;
+    // Position of the payload (encrypted part) in preencoded buffer
+    uint32_t payload_position;
+    uint32_t signature_length;
+    // Secured network message: preencoded network message encrypted and signed
+    SOPC_Buffer* securedBuffer;
 };
 
 static SOPC_PubFixedBuffer_Buffer_Ctx* PubFixedBuffer_Create_Preencode_Buffer(SOPC_Dataset_LL_NetworkMessage* nm)
@@ -79,6 +92,8 @@ static SOPC_PubFixedBuffer_Buffer_Ctx* PubFixedBuffer_Create_Preencode_Buffer(SO
     SOPC_ASSERT(NULL != preencode_structure->dataSetFields);
 
     preencode_structure->buffer = NULL;
+    preencode_structure->securityMode = SOPC_SecurityMode_None;
+    preencode_structure->securedBuffer = NULL;
 
     return preencode_structure;
 }
@@ -120,21 +135,104 @@ static void PubFixedBuffer_Initialize_Preencode_Buffer(SOPC_Dataset_LL_NetworkMe
     }
 }
 
-SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Dataset_LL_NetworkMessage* nm)
+static bool PubFixedBuffer_Is_Secured_Mode(SOPC_SecurityMode_Type mode)
+{
+    return SOPC_SecurityMode_Sign == mode || SOPC_SecurityMode_SignAndEncrypt == mode;
+}
+
+/* Initialize the security lengths of preencode and a placeholder security context used to preencode the
+ * security header. The placeholder nonce shall be freed by caller. */
+static SOPC_ReturnStatus PubFixedBuffer_Initialize_Security(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                            const SOPC_PubSub_SecurityType* security,
+                                                            SOPC_PubSub_SecurityType* placeholder,
+                                                            SOPC_PubSubSKS_Keys* placeholderKeys)
+{
+    if (NULL == security->provider)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    preencode->securityMode = security->mode;
+    SOPC_ReturnStatus status =
+        SOPC_CryptoProvider_PubSubGetLength_MessageRandom(security->provider, &preencode->nonceRandom_length);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_CryptoProvider_SymmetricGetLength_Signature(security->provider, &preencode->signature_length);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        memset(placeholderKeys, 0, sizeof(*placeholderKeys));
+        memset(placeholder, 0, sizeof(*placeholder));
+        placeholder->mode = security->mode;
+        placeholder->provider = security->provider;
+        placeholder->groupKeys = placeholderKeys;
+        placeholder->msgNonceRandom = SOPC_Calloc(preencode->nonceRandom_length, sizeof(SOPC_ExposedBuffer));
+        if (NULL == placeholder->msgNonceRandom)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    return status;
+}
+
+/* Check the preencoded message can be secured in place and allocate the secured buffer */
+static SOPC_ReturnStatus PubFixedBuffer_Allocate_SecuredBuffer(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                               const SOPC_PubSub_SecurityType* security)
+{
+    SOPC_Buffer* buffer = preencode->buffer;
+    if (0 == preencode->payload_position || preencode->payload_position > buffer->length ||
+        buffer->length > UINT32_MAX - preencode->signature_length)
+    {
+        return SOPC_STATUS_NOK;
+    }
+    // Encrypted payload shall have the same size as clear payload to be encrypted in place (AES-CTR)
+    uint32_t payloadLength = buffer->length - preencode->payload_position;
+    uint32_t encryptedLength = 0;
+    SOPC_ReturnStatus status =
+        SOPC_CryptoProvider_SymmetricGetLength_Encryption(security->provider, payloadLength, &encryptedLength);
+    if (SOPC_STATUS_OK == status && encryptedLength != payloadLength)
+    {
+        status = SOPC_STATUS_NOT_SUPPORTED;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        preencode->securedBuffer = SOPC_Buffer_Create(buffer->length + preencode->signature_length);
+        if (NULL == preencode->securedBuffer)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    return status;
+}
+
+SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                         const SOPC_PubSub_SecurityType* security)
 {
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
     SOPC_PubFixedBuffer_Buffer_Ctx* preencode = PubFixedBuffer_Create_Preencode_Buffer(nm);
     SOPC_DataSet_LL_NetworkMessage_Set_Preencode_Buffer(nm, preencode);
+    // Security header is preencoded with placeholders
+    SOPC_PubSub_SecurityType placeholderSecurity;
+    SOPC_PubSubSKS_Keys placeholderKeys;
+    SOPC_PubSub_SecurityType* preencodeSecurity = NULL;
     if (NULL == preencode)
     {
         status = SOPC_STATUS_OUT_OF_MEMORY;
     }
-    else
+    else if (NULL != security && PubFixedBuffer_Is_Secured_Mode(security->mode))
+    {
+        preencodeSecurity = &placeholderSecurity;
+        status = PubFixedBuffer_Initialize_Security(preencode, security, &placeholderSecurity, &placeholderKeys);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Failed to initialize security of preencoded PUB message");
+        }
+    }
+    if (SOPC_STATUS_OK == status)
     {
         PubFixedBuffer_Initialize_Preencode_Buffer(nm);
         SOPC_Buffer* buffer_payload = NULL;
         SOPC_NetworkMessage_Error_Code code =
-            SOPC_UADP_NetworkMessage_Encode_Buffers(nm, NULL, &preencode->buffer, &buffer_payload);
+            SOPC_UADP_NetworkMessage_Encode_Buffers(nm, preencodeSecurity, &preencode->buffer, &buffer_payload);
         if (SOPC_NetworkMessage_Error_Code_None != code || NULL == preencode->buffer || NULL == buffer_payload)
         {
             status = SOPC_STATUS_NOK;
@@ -144,6 +242,7 @@ SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Da
         }
         else
         {
+            // Payload is merged in clear: it is encrypted and signed for each message
             code = SOPC_UADP_NetworkMessage_BuildFinalMessage(NULL, preencode->buffer, &buffer_payload);
             if (SOPC_NetworkMessage_Error_Code_None != code || NULL == preencode->buffer || NULL != buffer_payload)
             {
@@ -154,6 +253,20 @@ SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Da
             }
         }
     }
+    if (SOPC_STATUS_OK == status && NULL != preencodeSecurity)
+    {
+        status = PubFixedBuffer_Allocate_SecuredBuffer(preencode, security);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB,
+                                   "Failed to allocate secured buffer of preencoded PUB message (status %d)",
+                                   (int) status);
+        }
+    }
+    if (NULL != preencodeSecurity)
+    {
+        SOPC_Free(placeholderSecurity.msgNonceRandom);
+    }
     return status;
 }
 
@@ -165,6 +278,7 @@ void SOPC_PubFixedBuffer_Delete_Preencode_Buffer(SOPC_PubFixedBuffer_Buffer_Ctx*
         SOPC_Free(preencode->dsm_sequence_numbers);
         SOPC_Free(preencode->dsm_sequence_number_positions);
         SOPC_Buffer_Delete(preencode->buffer);
+        SOPC_Buffer_Delete(preencode->securedBuffer);
         SOPC_Free(preencode);
         preencode = NULL;
     }
@@ -182,6 +296,26 @@ bool SOPC_PubFixedBuffer_Set_DSM_SequenceNumber_Position_At(SOPC_PubFixedBuffer_
     return true;
 }
 
+bool SOPC_PubFixedBuffer_Is_Secured(const SOPC_PubFixedBuffer_Buffer_Ctx* preencode)
+{
+    return NULL != preencode && PubFixedBuffer_Is_Secured_Mode(preencode->securityMode);
+}
+
+bool SOPC_PubFixedBuffer_Set_Security_Positions(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                uint32_t tokenIdPosition,
+                                                uint32_t noncePosition,
+                                                uint32_t payloadPosition)
+{
+    if (!SOPC_PubFixedBuffer_Is_Secured(preencode))
+    {
+        return false;
+    }
+    preencode->tokenId_position = tokenIdPosition;
+    preencode->nonce_position = noncePosition;
+    preencode->payload_position = payloadPosition;
+    return true;
+}
+
 void SOPC_PubFixedBuffer_DataSetFieldPosition_Set_Position(SOPC_PubFixedBuffer_DataSetField_Position* dsfPos,
                                                            uint32_t position)
 {
@@ -219,3 +353,77 @@ SOPC_Buffer* SOPC_PubFixedBuffer_Get_UpdatedBuffer(SOPC_PubFixedBuffer_Buffer_Ct
     }
     return preencode->buffer;
 }
+
+SOPC_Buffer* SOPC_PubFixedBuffer_Get_SecuredBuffer(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                   const SOPC_PubSub_SecurityType* security)
+{
+    if (!SOPC_PubFixedBuffer_Is_Secured(preencode) || NULL == preencode->securedBuffer || NULL == security ||
+        security->mode != preencode->securityMode || NULL == security->groupKeys || NULL == security->msgNonceRandom)
+    {
+        return NULL;
+    }
+    SOPC_Buffer* buffer = preencode->buffer;
+    SOPC_Buffer* secured = preencode->securedBuffer;
+    const uint32_t payloadLength = buffer->length - preencode->payload_position;
+
+    // Update security header of the clear message
+    SOPC_ReturnStatus status = SOPC_Buffer_SetPosition(buffer, preencode->tokenId_position);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&security->groupKeys->tokenId, buffer, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_SetPosition(buffer, preencode->nonce_position);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_Write(buffer, security->msgNonceRandom, preencode->nonceRandom_length);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_UInt32_Write(&security->sequenceNumber, buffer, 0);
+    }
+
+    // Copy the header and encrypt the payload into the secured buffer
+    if (SOPC_STATUS_OK == status)
+    {
+        memcpy(secured->data, buffer->data, preencode->payload_position);
+        if (SOPC_SecurityMode_SignAndEncrypt == preencode->securityMode && payloadLength > 0)
+        {
+            status = SOPC_CryptoProvider_PubSubCrypt(
+                security->provider, buffer->data + preencode->payload_position, payloadLength,
+                security->groupKeys->encryptKey, security->groupKeys->keyNonce, security->msgNonceRandom,
+                preencode->nonceRandom_length, security->sequenceNumber, secured->data + preencode->payload_position,
+                payloadLength);
+        }
+        else
+        {
+            memcpy(secured->data + preencode->payload_position, buffer->data + preencode->payload_position,
+                   payloadLength);
+        }
+    }
+
+    // Sign the whole message, the signature follows the message
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_CryptoProvider_SymmetricSign(security->provider, secured->data, buffer->length,
+                                                   security->groupKeys->signingKey, secured->data + buffer->length,
+                                                   preencode->signature_length);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_SetPosition(secured, 0);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Buffer_SetDataLength(secured, buffer->length + preencode->signature_length);
+    }
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Failed to secure preencoded PUB message (status %d)",
+                               (int) status);
+        return NULL;
+    }
+    return secured;
+}
@@ -20,6 +20,7 @@
 #ifndef SOPC_PUB_FIXED_BUFFER_H_
 #define SOPC_PUB_FIXED_BUFFER_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "sopc_buffer.h"
@@ -34,9 +35,13 @@ typedef struct SOPC_PubFixedBuffer_DataSetField_Position SOPC_PubFixedBuffer_Dat
  * @brief Create and initialize preencode context against nm.
  *
  * @param nm NetworkMessage used to initialize preencoded buffer context.
+ * @param security Security context of the WriterGroup or NULL if security mode is None.
+ *                 Only the security mode and provider are used: the security header is preencoded with
+ *                 placeholders which are updated with the keys, nonce and sequence number of each message.
  * @return SOPC_STATUS_OK in case of success.
  */
-SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Dataset_LL_NetworkMessage* nm);
+SOPC_ReturnStatus SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(SOPC_Dataset_LL_NetworkMessage* nm,
+                                                                         const SOPC_PubSub_SecurityType* security);
 
 /**
  * @brief Free memory allocated by ::SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer.
@@ -48,6 +53,29 @@ void SOPC_PubFixedBuffer_Delete_Preencode_Buffer(SOPC_PubFixedBuffer_Buffer_Ctx*
 /* Return pointer to updated preencode buffer stored in preencode. This buffer should'nt be free by user */
 SOPC_Buffer* SOPC_PubFixedBuffer_Get_UpdatedBuffer(SOPC_PubFixedBuffer_Buffer_Ctx* preencode);
 
+/**
+ * @brief Return the secured (signed and/or encrypted) network message from the preencoded buffer updated with
+ *        ::SOPC_PubFixedBuffer_Get_UpdatedBuffer.
+ *        The security header of the preencoded buffer is updated with \p security token id, nonce and sequence
+ *        number, then the payload is encrypted and the message signed into a preallocated buffer.
+ *
+ * @param preencode Preencode buffer context created with a security context
+ * @param security Security context of the current message, with keys and nonce set
+ * @return pointer to the secured buffer stored in preencode, NULL in case of failure.
+ *         This buffer shouldn't be freed by user.
+ */
+SOPC_Buffer* SOPC_PubFixedBuffer_Get_SecuredBuffer(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                   const SOPC_PubSub_SecurityType* security);
+
+/* Return true if the preencode buffer was created with a security mode Sign or SignAndEncrypt */
+bool SOPC_PubFixedBuffer_Is_Secured(const SOPC_PubFixedBuffer_Buffer_Ctx* preencode);
+
+/* Set position of security header token id and message nonce, and position of payload in final buffer */
+bool SOPC_PubFixedBuffer_Set_Security_Positions(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
+                                                uint32_t tokenIdPosition,
+                                                uint32_t noncePosition,
+                                                uint32_t payloadPosition);
+
 /* Set position of dataSetMessage sequence number in final buffer */
 bool SOPC_PubFixedBuffer_Set_DSM_SequenceNumber_Position_At(SOPC_PubFixedBuffer_Buffer_Ctx* preencode,
                                                             uint32_t position,
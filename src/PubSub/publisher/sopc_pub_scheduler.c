@@ -87,6 +87,8 @@ struct SOPC_PubScheduler_TransportCtx
     // specific to SOPC_PubSubProtocol_MQTT
     MqttContextClient* mqttClient;
     const char* mqttTopic;
+    uint8_t mqttQos;
+    bool mqttRetain;
 
     /* Is publisher in acyclic mode. If yes message will not be considered when looking for most expire one */
     bool isAcyclic;
@@ -110,7 +112,9 @@ typedef struct MessageCtx
     uint64_t publishingIntervalUs;
     int32_t publishingOffsetUs; /**< Negative = not used */
     const char* mqttTopic;
-    bool warned; /**< Have we warned about expired messages yet? */
+    uint8_t mqttQos; /**< MQTT QoS of the messages (0, 1 or 2) */
+    bool mqttRetain; /**< MQTT retain flag of the messages */
+    bool warned;     /**< Have we warned about expired messages yet? */
     uint64_t keepAliveTimeUs;
 } MessageCtx;
 
@@ -217,6 +221,14 @@ static SOPC_ReturnStatus initialize_DataSetField_from_WriterGroup(SOPC_Dataset_N
  */
 static void send_keepAlive_message(MessageCtx* context);
 
+/**
+ * @brief Send the DataSetMessages of a message which does not fit in a single message in chunk messages.
+ *        Each chunk message is secured with its own nonce and sequence number.
+ */
+static void send_chunked_message(MessageCtx* context,
+                                 SOPC_Dataset_LL_NetworkMessage* message,
+                                 SOPC_PubSub_SecurityType* security);
+
 // Clear pub scheduler context
 static void SOPC_PubScheduler_Context_Clear(bool isPubThreadStarted)
 {
@@ -334,6 +346,8 @@ static bool MessageCtx_Array_Init_Next(SOPC_PubScheduler_TransportCtx* ctx,
             context->mqttTopic = SOPC_WriterGroup_Get_MqttTopic(group);
             SOPC_Free(defaultTopic);
         }
+        context->mqttQos = SOPC_MQTT_Get_QoS(SOPC_WriterGroup_Get_MqttQos(group));
+        context->mqttRetain = SOPC_WriterGroup_Get_MqttRetain(group);
     }
     else
     {
@@ -413,32 +427,31 @@ static bool MessageCtx_Array_Init_Next(SOPC_PubScheduler_TransportCtx* ctx,
     {
         context->security->mode = SOPC_WriterGroup_Get_SecurityMode(group);
         context->security->groupKeys = NULL;
+        context->security->keyRing = SOPC_PubSubSKS_KeyRing_Create(SOPC_PUBSUB_SKS_DEFAULT_GROUPID);
         context->security->provider = SOPC_CryptoProvider_CreatePubSub(SOPC_PUBSUB_SECURITY_POLICY);
-        if (NULL == context->security->provider)
+        if (NULL == context->security->provider || NULL == context->security->keyRing)
         {
             SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Publisher: cannot create security provider");
             result = false; /* TODO: it should be possible to avoid this variable and the partial frees when false */
         }
+        else
+        {
+            // Allocate the message nonce buffer of the writer group, it is renewed in place for each message
+            result = (SOPC_STATUS_OK == SOPC_PubSub_Security_RenewRandom(context->security));
+        }
     }
 
     const SOPC_WriterGroup_Options* writerGroupOptions = SOPC_WriterGroup_Get_Options(group);
     if (result && writerGroupOptions->useFixedSizeBuffer)
     {
-        if (NULL != context->security)
+        // Initialise dataSetFields with empty values
+        SOPC_ReturnStatus status = initialize_DataSetField_from_WriterGroup(context->message, group);
+        result = (SOPC_STATUS_OK == status);
+        if (result)
         {
-            SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Cannot use security with fixed size buffer optimisation");
-            result = false;
-        }
-        else
-        {
-            // Initialise dataSetFields with empty values
-            SOPC_ReturnStatus status = initialize_DataSetField_from_WriterGroup(context->message, group);
+            // Security header is preencoded and the message is encrypted and signed for each publication
+            status = SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(context->message, context->security);
             result = (SOPC_STATUS_OK == status);
-            if (result)
-            {
-                status = SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(context->message);
-                result = (SOPC_STATUS_OK == status);
-            }
         }
     }
 
@@ -613,21 +626,14 @@ static void MessageCtx_send_publish_message(MessageCtx* context)
         SOPC_PubSub_SecurityType* security = context->security;
         if (NULL != security)
         {
-            // Update keys
-            if (NULL != security->groupKeys)
-            {
-                SOPC_PubSubSKS_Keys_Delete(security->groupKeys);
-                SOPC_Free(security->groupKeys);
-            }
-            security->groupKeys =
-                SOPC_PubSubSKS_GetSecurityKeys(SOPC_PUBSUB_SKS_DEFAULT_GROUPID, SOPC_PUBSUB_SKS_CURRENT_TOKENID);
+            // Update keys: the key ring only calls the SK manager when the next keys are needed
+            security->groupKeys = SOPC_PubSubSKS_KeyRing_GetKeys(security->keyRing, SOPC_PUBSUB_SKS_CURRENT_TOKENID);
             bool allocSuccess = (NULL != security->groupKeys);
 
-            // Update Nonce Random part
+            // Update Nonce Random part (renewed in place in the writer group nonce buffer)
             if (allocSuccess)
             {
-                security->msgNonceRandom = SOPC_PubSub_Security_Random(security->provider);
-                allocSuccess = (NULL != security->msgNonceRandom);
+                allocSuccess = (SOPC_STATUS_OK == SOPC_PubSub_Security_RenewRandom(security));
                 if (allocSuccess)
                 {
                     security->sequenceNumber = pubSchedulerCtx.sequenceNumber;
@@ -670,7 +676,11 @@ static void MessageCtx_send_publish_message(MessageCtx* context)
             {
                 SOPC_Buffer* buffer_payload = NULL;
                 errorCode = SOPC_UADP_NetworkMessage_Encode_Buffers(message, security, &buffer, &buffer_payload);
-                if (SOPC_NetworkMessage_Error_Code_None != errorCode || buffer == NULL || buffer_payload == NULL)
+                if (SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge == errorCode)
+                {
+                    send_chunked_message(context, message, security);
+                }
+                else if (SOPC_NetworkMessage_Error_Code_None != errorCode || buffer == NULL || buffer_payload == NULL)
                 {
                     SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB,
                                            "Failed to encode PUB message, SOPC_NetworkMessage_Error_Code is : 0x%08X",
@@ -690,12 +700,9 @@ static void MessageCtx_send_publish_message(MessageCtx* context)
             }
         }
 
-        if (NULL != security)
-        {
-            SOPC_Free(security->msgNonceRandom);
-            security->msgNonceRandom = NULL;
-        }
         context->transport->mqttTopic = context->mqttTopic;
+        context->transport->mqttQos = context->mqttQos;
+        context->transport->mqttRetain = context->mqttRetain;
         if (NULL != buffer)
         {
             context->transport->pFctSend(context->transport, buffer);
@@ -728,8 +735,8 @@ static void send_keepAlive_message(MessageCtx* context)
 
     if (NULL != security)
     {
-        security->msgNonceRandom = SOPC_PubSub_Security_Random(security->provider);
-        SOPC_ASSERT(NULL != security->msgNonceRandom);
+        SOPC_ReturnStatus status = SOPC_PubSub_Security_RenewRandom(security);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
         security->sequenceNumber = pubSchedulerCtx.sequenceNumber;
         pubSchedulerCtx.sequenceNumber++;
     }
@@ -756,19 +763,70 @@ static void send_keepAlive_message(MessageCtx* context)
                 (unsigned) errorCode);
         }
     }
-    if (NULL != security)
-    {
-        SOPC_Free(security->msgNonceRandom);
-        security->msgNonceRandom = NULL;
-    }
-
     context->transport->mqttTopic = context->mqttTopic;
+    context->transport->mqttQos = context->mqttQos;
+    context->transport->mqttRetain = context->mqttRetain;
 
     context->transport->pFctSend(context->transport, buffer);
     SOPC_Buffer_Delete(buffer);
     buffer = NULL;
 }
 
+static void send_chunked_message(MessageCtx* context,
+                                 SOPC_Dataset_LL_NetworkMessage* message,
+                                 SOPC_PubSub_SecurityType* security)
+{
+    SOPC_NetworkMessage_Error_Code errorCode = SOPC_NetworkMessage_Error_Code_None;
+    const uint8_t nDsm = SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(message);
+    // The nonce and sequence number prepared for the message are used by the first chunk
+    bool firstChunk = true;
+    bool ok = true;
+
+    context->transport->mqttTopic = context->mqttTopic;
+    context->transport->mqttQos = context->mqttQos;
+    context->transport->mqttRetain = context->mqttRetain;
+
+    for (uint8_t iDsm = 0; ok && iDsm < nDsm; iDsm++)
+    {
+        SOPC_Buffer* dsmBuffer = NULL;
+        uint32_t chunkOffset = 0;
+        errorCode = SOPC_UADP_NetworkMessage_Encode_DataSetMessage(message, iDsm, &dsmBuffer);
+        ok = (SOPC_NetworkMessage_Error_Code_None == errorCode);
+
+        while (ok && chunkOffset < dsmBuffer->length)
+        {
+            if (NULL != security && !firstChunk)
+            {
+                ok = (SOPC_STATUS_OK == SOPC_PubSub_Security_RenewRandom(security));
+                security->sequenceNumber = pubSchedulerCtx.sequenceNumber;
+                pubSchedulerCtx.sequenceNumber++;
+            }
+            firstChunk = false;
+
+            SOPC_Buffer* buffer = NULL;
+            if (ok)
+            {
+                errorCode = SOPC_UADP_NetworkMessage_Encode_Chunk(message, security, iDsm, dsmBuffer, &chunkOffset,
+                                                                  &buffer);
+                ok = (SOPC_NetworkMessage_Error_Code_None == errorCode);
+            }
+            if (ok)
+            {
+                context->transport->pFctSend(context->transport, buffer);
+            }
+            SOPC_Buffer_Delete(buffer);
+        }
+        SOPC_Buffer_Delete(dsmBuffer);
+    }
+
+    if (!ok)
+    {
+        SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB,
+                               "Failed to encode PUB chunk message, SOPC_NetworkMessage_Error_Code is : 0x%08X",
+                               (unsigned) errorCode);
+    }
+}
+
 static void* thread_start_publish(void* arg)
 {
     SOPC_UNUSED_ARG(arg);
@@ -1033,6 +1091,16 @@ static bool SOPC_PubScheduler_Connection_Get_Transport(uint32_t index,
             SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Not enougth space to allocate mqttClient");
             return false;
         }
+        const SOPC_MQTT_Client_Options mqttOptions = {
+            .subQos = NULL,
+            .maxInflight = SOPC_PubSubConnection_Get_MqttMaxInflight(connection),
+            .maxBufferedMessages = SOPC_PubSubConnection_Get_MqttMaxBufferedMessages(connection)};
+        status = SOPC_MQTT_Set_Client_Options(pubSchedulerCtx.transport[index].mqttClient, &mqttOptions);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Publisher MQTT options configuration failed");
+            return false;
+        }
         status = SOPC_MQTT_InitializeAndConnect_Client(
             pubSchedulerCtx.transport[index].mqttClient, &address[strlen(MQTT_PREFIX)],
             SOPC_PubSubConnection_Get_MqttUsername(connection), SOPC_PubSubConnection_Get_MqttPassword(connection),
@@ -1117,7 +1185,8 @@ static void SOPC_PubScheduler_CtxMqtt_Send(SOPC_PubScheduler_TransportCtx* ctx,
 {
     if (ctx != NULL && ctx->mqttClient != NULL && buffer != NULL && buffer->data != NULL && buffer->length > 0)
     {
-        SOPC_ReturnStatus result = SOPC_MQTT_Send_Message(ctx->mqttClient, ctx->mqttTopic, *buffer);
+        SOPC_ReturnStatus result =
+            SOPC_MQTT_Send_Message_QoS(ctx->mqttClient, ctx->mqttTopic, *buffer, ctx->mqttQos, ctx->mqttRetain);
         if (SOPC_STATUS_OK != result)
         {
             SOPC_Logger_TraceError(SOPC_LOG_MODULE_PUBSUB, "Failed to send MQTT message");
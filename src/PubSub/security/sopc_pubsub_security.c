@@ -181,8 +181,15 @@ void SOPC_PubSub_Security_Clear(SOPC_PubSub_SecurityType* security)
 {
     if (NULL != security)
     {
-        SOPC_PubSubSKS_Keys_Delete(security->groupKeys);
-        SOPC_Free(security->groupKeys);
+        if (NULL != security->keyRing)
+        {
+            SOPC_PubSubSKS_KeyRing_Delete(&security->keyRing);
+        }
+        else
+        {
+            SOPC_PubSubSKS_Keys_Delete(security->groupKeys);
+            SOPC_Free(security->groupKeys);
+        }
         security->groupKeys = NULL;
         SOPC_Free(security->msgNonceRandom);
         security->msgNonceRandom = NULL;
@@ -190,20 +197,27 @@ void SOPC_PubSub_Security_Clear(SOPC_PubSub_SecurityType* security)
     }
 }
 
-SOPC_ExposedBuffer* SOPC_PubSub_Security_Random(const SOPC_CryptoProvider* provider)
+SOPC_ReturnStatus SOPC_PubSub_Security_RenewRandom(SOPC_PubSub_SecurityType* security)
 {
-    uint32_t length;
-    SOPC_ReturnStatus status = SOPC_CryptoProvider_PubSubGetLength_MessageRandom(provider, &length);
-    if (SOPC_STATUS_OK != status)
+    if (NULL == security)
     {
-        return NULL;
+        return SOPC_STATUS_INVALID_PARAMETERS;
     }
 
-    SOPC_ExposedBuffer* ppBuffer;
-    status = SOPC_CryptoProvider_GenerateRandomBytes(provider, length, &ppBuffer);
-    if (SOPC_STATUS_OK != status)
+    uint32_t length = 0;
+    SOPC_ReturnStatus status = SOPC_CryptoProvider_PubSubGetLength_MessageRandom(security->provider, &length);
+    if (SOPC_STATUS_OK == status && NULL == security->msgNonceRandom)
     {
-        return NULL;
+        // Allocated once, then renewed in place for each message
+        security->msgNonceRandom = SOPC_Calloc(length, sizeof(SOPC_ExposedBuffer));
+        if (NULL == security->msgNonceRandom)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
     }
-    return ppBuffer;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_CryptoProvider_FillRandomBytes(security->provider, security->msgNonceRandom, length);
+    }
+    return status;
 }
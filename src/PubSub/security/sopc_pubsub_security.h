@@ -40,7 +40,9 @@ typedef struct SOPC_PubSub_SecurityType
 {
     SOPC_SecurityMode_Type mode;
     SOPC_CryptoProvider* provider;
+    /* Keys used to secure the messages. They are owned by keyRing when it is set, otherwise by this object */
     SOPC_PubSubSKS_Keys* groupKeys;
+    SOPC_PubSubSKS_KeyRing* keyRing;
     SOPC_ExposedBuffer* msgNonceRandom;
     uint32_t sequenceNumber;
 } SOPC_PubSub_SecurityType;
@@ -125,6 +127,16 @@ SOPC_ReturnStatus SOPC_PubSub_Security_Sign(const SOPC_PubSub_SecurityType* secu
  */
 bool SOPC_PubSub_Security_Verify(const SOPC_PubSub_SecurityType* security, SOPC_Buffer* src, uint32_t payloadPosition);
 
-SOPC_ExposedBuffer* SOPC_PubSub_Security_Random(const SOPC_CryptoProvider* provider);
+/**
+ * \brief Renews the random part of the message nonce (\p security->msgNonceRandom) for the next message.
+ *
+ * The nonce buffer is allocated by the first call, then it is filled in place by the next ones.
+ * It is freed by ::SOPC_PubSub_Security_Clear.
+ *
+ * \param security SOPC_PubSub_SecurityType object with a crypto provider. Should not be NULL.
+ *
+ * \return SOPC_STATUS_OK in case of success, an error status otherwise.
+ */
+SOPC_ReturnStatus SOPC_PubSub_Security_RenewRandom(SOPC_PubSub_SecurityType* security);
 
 #endif /* SOPC_PUBSUB_SECURITY_H_ */
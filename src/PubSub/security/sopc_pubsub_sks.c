@@ -26,6 +26,29 @@
 #include "sopc_mutexes.h"
 #include "sopc_pubsub_constants.h"
 #include "sopc_pubsub_sks.h"
+#include "sopc_time.h"
+
+// Length of the keys token: signing key, encrypting key and key nonce
+#define SOPC_PUBSUB_SKS_SIGNING_KEY_LENGTH 32
+#define SOPC_PUBSUB_SKS_ENCRYPT_KEY_LENGTH 32
+#define SOPC_PUBSUB_SKS_KEY_NONCE_LENGTH 4
+
+typedef struct SOPC_PubSubSKS_KeyRing_Entry
+{
+    bool used;
+    // Validity is only known for the keys retrieved with the current token
+    bool validityKnown;
+    SOPC_TimeReference validUntil;
+    SOPC_PubSubSKS_Keys keys;
+} SOPC_PubSubSKS_KeyRing_Entry;
+
+struct SOPC_PubSubSKS_KeyRing
+{
+    uint32_t groupId;
+    SOPC_PubSubSKS_KeyRing_Entry entries[SOPC_PUBSUB_SKS_KEY_RING_SIZE]; /* indexed by token id modulo size */
+    SOPC_TimeReference lastKeyValidUntil; /* expiry of the last known key */
+    SOPC_TimeReference nextPrefetch;      /* prefetch is not retried before this time */
+};
 
 static SOPC_SKManager* g_skManager = NULL;
 // Mutex to protect access to g_skManager;
@@ -51,74 +74,226 @@ void SOPC_PubSubSKS_SetSkManager(SOPC_SKManager* skm)
     SOPC_Mutex_Unlock(&g_mutex);
 }
 
-SOPC_PubSubSKS_Keys* SOPC_PubSubSKS_GetSecurityKeys(uint32_t groupid, uint32_t tokenId)
+/* Get up to SOPC_PUBSUB_SKS_MAX_TOKEN_PER_CALL keys from the SK Manager. Keys shall be cleared by the caller */
+static SOPC_ReturnStatus SOPC_PubSubSKS_GetManagerKeys(uint32_t tokenId,
+                                                       uint32_t* firstTokenId,
+                                                       SOPC_ByteString** keys,
+                                                       uint32_t* nbKeys,
+                                                       uint32_t* timeToNextKey,
+                                                       uint32_t* keyLifetime)
 {
-    if (SOPC_PUBSUB_SKS_DEFAULT_GROUPID != groupid)
+    SOPC_String* securityPolicyUri = NULL;
+    SOPC_ReturnStatus status = SOPC_STATUS_INVALID_STATE;
+
+    SOPC_Mutex_Lock(&g_mutex);
+    if (NULL != g_skManager)
     {
-        return NULL;
+        status = SOPC_SKManager_GetKeys(g_skManager, tokenId, SOPC_PUBSUB_SKS_MAX_TOKEN_PER_CALL, &securityPolicyUri,
+                                        firstTokenId, keys, nbKeys, timeToNextKey, keyLifetime);
     }
+    SOPC_Mutex_Unlock(&g_mutex);
 
-    /** Get Keys from SK Manager **/
+    SOPC_String_Clear(securityPolicyUri);
+    SOPC_Free(securityPolicyUri);
+    return status;
+}
 
-    SOPC_Mutex_Lock(&g_mutex);
-    if (NULL == g_skManager)
+static void SOPC_PubSubSKS_ClearManagerKeys(SOPC_ByteString* keys, uint32_t nbKeys)
+{
+    for (uint32_t i = 0; i < nbKeys && NULL != keys; i++)
+    {
+        SOPC_ByteString_Clear(&keys[i]);
+    }
+    SOPC_Free(keys);
+}
+
+/* Split a keys token retrieved from the SK Manager into signing key, encrypting key and key nonce */
+static bool SOPC_PubSubSKS_Keys_Init(SOPC_PubSubSKS_Keys* keys, uint32_t tokenId, const SOPC_ByteString* byteString)
+{
+    if ((SOPC_PUBSUB_SKS_SIGNING_KEY_LENGTH + SOPC_PUBSUB_SKS_ENCRYPT_KEY_LENGTH + SOPC_PUBSUB_SKS_KEY_NONCE_LENGTH) !=
+        byteString->Length)
+    {
+        return false;
+    }
+    keys->tokenId = tokenId;
+    keys->signingKey = SOPC_SecretBuffer_NewFromExposedBuffer(byteString->Data, SOPC_PUBSUB_SKS_SIGNING_KEY_LENGTH);
+    keys->encryptKey = SOPC_SecretBuffer_NewFromExposedBuffer(&byteString->Data[SOPC_PUBSUB_SKS_SIGNING_KEY_LENGTH],
+                                                              SOPC_PUBSUB_SKS_ENCRYPT_KEY_LENGTH);
+    keys->keyNonce = SOPC_SecretBuffer_NewFromExposedBuffer(
+        &byteString->Data[SOPC_PUBSUB_SKS_SIGNING_KEY_LENGTH + SOPC_PUBSUB_SKS_ENCRYPT_KEY_LENGTH],
+        SOPC_PUBSUB_SKS_KEY_NONCE_LENGTH);
+    if (NULL == keys->signingKey || NULL == keys->encryptKey || NULL == keys->keyNonce)
+    {
+        SOPC_PubSubSKS_Keys_Delete(keys);
+        return false;
+    }
+    return true;
+}
+
+SOPC_PubSubSKS_Keys* SOPC_PubSubSKS_GetSecurityKeys(uint32_t groupid, uint32_t tokenId)
+{
+    if (SOPC_PUBSUB_SKS_DEFAULT_GROUPID != groupid)
     {
-        SOPC_Mutex_Unlock(&g_mutex);
         return NULL;
     }
-    // result
-    SOPC_PubSubSKS_Keys* returnedKeys = NULL;
 
-    // Get keys from manager
-    SOPC_String* SecurityPolicyUri = NULL;
+    /** Get Keys from SK Manager **/
+
     uint32_t FirstTokenId = 0;
     SOPC_ByteString* Keys = NULL;
     uint32_t NbKeys = 0;
     uint32_t TimeToNextKey = 0;
     uint32_t KeyLifetime = 0;
     SOPC_ReturnStatus status =
-        SOPC_SKManager_GetKeys(g_skManager, tokenId, SOPC_PUBSUB_SKS_MAX_TOKEN_PER_CALL, &SecurityPolicyUri,
-                               &FirstTokenId, &Keys, &NbKeys, &TimeToNextKey, &KeyLifetime);
-
-    SOPC_Mutex_Unlock(&g_mutex);
+        SOPC_PubSubSKS_GetManagerKeys(tokenId, &FirstTokenId, &Keys, &NbKeys, &TimeToNextKey, &KeyLifetime);
 
     /** Fill Outputs **/
 
+    // result
+    SOPC_PubSubSKS_Keys* returnedKeys = NULL;
+
     // Initialize returned keys if GetKeys returned valid Keys corresponding to requested token
-    SOPC_ByteString* byteString = NULL;
     if (SOPC_STATUS_OK == status && 0 < NbKeys &&
         (SOPC_PUBSUB_SKS_CURRENT_TOKENID == tokenId || tokenId == FirstTokenId))
     {
-        byteString = &Keys[0];
-        if ((32 + 32 + 4) == byteString->Length)
+        returnedKeys = SOPC_Calloc(1, sizeof(SOPC_PubSubSKS_Keys));
+    }
+
+    if (NULL != returnedKeys && !SOPC_PubSubSKS_Keys_Init(returnedKeys, FirstTokenId, &Keys[0]))
+    {
+        SOPC_Free(returnedKeys);
+        returnedKeys = NULL;
+    }
+
+    SOPC_PubSubSKS_ClearManagerKeys(Keys, NbKeys);
+
+    return returnedKeys;
+}
+
+SOPC_PubSubSKS_KeyRing* SOPC_PubSubSKS_KeyRing_Create(uint32_t groupid)
+{
+    if (SOPC_PUBSUB_SKS_DEFAULT_GROUPID != groupid)
+    {
+        return NULL;
+    }
+    SOPC_PubSubSKS_KeyRing* ring = SOPC_Calloc(1, sizeof(SOPC_PubSubSKS_KeyRing));
+    if (NULL != ring)
+    {
+        ring->groupId = groupid;
+    }
+    return ring;
+}
+
+void SOPC_PubSubSKS_KeyRing_Delete(SOPC_PubSubSKS_KeyRing** ring)
+{
+    if (NULL == ring || NULL == *ring)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < SOPC_PUBSUB_SKS_KEY_RING_SIZE; i++)
+    {
+        SOPC_PubSubSKS_Keys_Delete(&(*ring)->entries[i].keys);
+    }
+    SOPC_Free(*ring);
+    *ring = NULL;
+}
+
+/* Refresh the ring with the keys from the given token and the following ones */
+static void SOPC_PubSubSKS_KeyRing_Refresh(SOPC_PubSubSKS_KeyRing* ring, uint32_t tokenId, SOPC_TimeReference now)
+{
+    uint32_t firstTokenId = 0;
+    SOPC_ByteString* keys = NULL;
+    uint32_t nbKeys = 0;
+    uint32_t timeToNextKey = 0;
+    uint32_t keyLifetime = 0;
+    SOPC_ReturnStatus status =
+        SOPC_PubSubSKS_GetManagerKeys(tokenId, &firstTokenId, &keys, &nbKeys, &timeToNextKey, &keyLifetime);
+
+    // The manager returns the validity of the keys only when the current token is requested
+    const bool validityKnown = (SOPC_PUBSUB_SKS_CURRENT_TOKENID == tokenId);
+    for (uint32_t i = 0; SOPC_STATUS_OK == status && i < nbKeys; i++)
+    {
+        const uint32_t keyTokenId = firstTokenId + i;
+        SOPC_PubSubSKS_KeyRing_Entry* entry = &ring->entries[keyTokenId % SOPC_PUBSUB_SKS_KEY_RING_SIZE];
+        // The keys of a token never change: only replace the keys of another token
+        if (!entry->used || keyTokenId != entry->keys.tokenId)
+        {
+            SOPC_PubSubSKS_Keys_Delete(&entry->keys);
+            entry->used = SOPC_PubSubSKS_Keys_Init(&entry->keys, keyTokenId, &keys[i]);
+            entry->validityKnown = false;
+        }
+        if (entry->used && validityKnown)
         {
-            returnedKeys = SOPC_Calloc(1, sizeof(SOPC_PubSubSKS_Keys));
+            entry->validityKnown = true;
+            entry->validUntil =
+                SOPC_TimeReference_AddMilliseconds(now, (uint64_t) timeToNextKey + (uint64_t) i * keyLifetime);
+            ring->lastKeyValidUntil = entry->validUntil;
         }
     }
+    if (validityKnown)
+    {
+        ring->nextPrefetch = SOPC_TimeReference_AddMilliseconds(now, SOPC_PUBSUB_SKS_PREFETCH_RETRY_MS);
+    }
 
-    if (NULL != returnedKeys)
+    SOPC_PubSubSKS_ClearManagerKeys(keys, nbKeys);
+}
+
+static SOPC_PubSubSKS_KeyRing_Entry* SOPC_PubSubSKS_KeyRing_Find(SOPC_PubSubSKS_KeyRing* ring,
+                                                                 uint32_t tokenId,
+                                                                 SOPC_TimeReference now)
+{
+    if (SOPC_PUBSUB_SKS_CURRENT_TOKENID != tokenId)
+    {
+        SOPC_PubSubSKS_KeyRing_Entry* entry = &ring->entries[tokenId % SOPC_PUBSUB_SKS_KEY_RING_SIZE];
+        return (entry->used && tokenId == entry->keys.tokenId ? entry : NULL);
+    }
+    // The current key is the known key with the earliest expiry after now
+    SOPC_PubSubSKS_KeyRing_Entry* current = NULL;
+    for (uint32_t i = 0; i < SOPC_PUBSUB_SKS_KEY_RING_SIZE; i++)
     {
-        returnedKeys->tokenId = FirstTokenId;
-        returnedKeys->signingKey = SOPC_SecretBuffer_NewFromExposedBuffer(byteString->Data, 32);
-        returnedKeys->encryptKey = SOPC_SecretBuffer_NewFromExposedBuffer(&(byteString->Data[32]), 32);
-        returnedKeys->keyNonce = SOPC_SecretBuffer_NewFromExposedBuffer(&(byteString->Data[64]), 4);
-        if (NULL == returnedKeys->signingKey || NULL == returnedKeys->encryptKey || NULL == returnedKeys->keyNonce)
+        SOPC_PubSubSKS_KeyRing_Entry* entry = &ring->entries[i];
+        if (entry->used && entry->validityKnown && SOPC_TimeReference_Compare(now, entry->validUntil) < 0 &&
+            (NULL == current || SOPC_TimeReference_Compare(entry->validUntil, current->validUntil) < 0))
         {
-            SOPC_PubSubSKS_Keys_Delete(returnedKeys);
-            SOPC_Free(returnedKeys);
-            returnedKeys = NULL;
+            current = entry;
         }
     }
+    return current;
+}
 
-    SOPC_String_Clear(SecurityPolicyUri);
-    SOPC_Free(SecurityPolicyUri);
-    for (uint32_t i = 0; i < NbKeys && NULL != Keys; i++)
+SOPC_PubSubSKS_Keys* SOPC_PubSubSKS_KeyRing_GetKeys(SOPC_PubSubSKS_KeyRing* ring, uint32_t tokenId)
+{
+    if (NULL == ring)
     {
-        SOPC_ByteString_Clear(&Keys[i]);
+        return NULL;
     }
-    SOPC_Free(Keys);
+    const SOPC_TimeReference now = SOPC_TimeReference_GetCurrent();
 
-    return returnedKeys;
+    // Prefetch the next keys before the expiry of the last known key
+    const SOPC_TimeReference prefetchTime =
+        SOPC_TimeReference_AddMilliseconds(now, SOPC_PUBSUB_SKS_PREFETCH_MARGIN_MS);
+    bool refreshed = false;
+    if (SOPC_TimeReference_Compare(prefetchTime, ring->lastKeyValidUntil) >= 0 &&
+        SOPC_TimeReference_Compare(now, ring->nextPrefetch) >= 0)
+    {
+        SOPC_PubSubSKS_KeyRing_Refresh(ring, SOPC_PUBSUB_SKS_CURRENT_TOKENID, now);
+        refreshed = true;
+    }
+
+    SOPC_PubSubSKS_KeyRing_Entry* entry = SOPC_PubSubSKS_KeyRing_Find(ring, tokenId, now);
+    if (NULL == entry && !refreshed)
+    {
+        // Unknown key: the current and next keys are most likely requested
+        SOPC_PubSubSKS_KeyRing_Refresh(ring, SOPC_PUBSUB_SKS_CURRENT_TOKENID, now);
+        entry = SOPC_PubSubSKS_KeyRing_Find(ring, tokenId, now);
+    }
+    if (NULL == entry && SOPC_PUBSUB_SKS_CURRENT_TOKENID != tokenId)
+    {
+        // Past key or key after the next ones
+        SOPC_PubSubSKS_KeyRing_Refresh(ring, tokenId, now);
+        entry = SOPC_PubSubSKS_KeyRing_Find(ring, tokenId, now);
+    }
+    return (NULL != entry ? &entry->keys : NULL);
 }
 
 void SOPC_PubSubSKS_Keys_Delete(SOPC_PubSubSKS_Keys* keys)
@@ -23,12 +23,13 @@
  *
  * To define a security keys service, ::SOPC_PubSubSKS_Init and ::SOPC_PubSubSKS_SetSkManager shall be called.
  *
- * The Publisher and Subscriber schedulers will then automatically call ::SOPC_PubSubSKS_GetSecurityKeys.
+ * The Publisher and Subscriber schedulers will then automatically retrieve the keys through a ::SOPC_PubSubSKS_KeyRing.
  */
 
 #ifndef SOPC_PUBSUB_SKS_H_
 #define SOPC_PUBSUB_SKS_H_
 
+#include "sopc_pubsub_constants.h"
 #include "sopc_secret_buffer.h"
 #include "sopc_sk_manager.h"
 
@@ -43,6 +44,21 @@
 // To requested current token in getSecurityKey
 #define SOPC_PUBSUB_SKS_CURRENT_TOKENID SOPC_SK_MANAGER_CURRENT_TOKEN_ID
 
+// Number of keys kept by a key ring. Shall be greater than the number of keys requested per call
+#ifndef SOPC_PUBSUB_SKS_KEY_RING_SIZE
+#define SOPC_PUBSUB_SKS_KEY_RING_SIZE (SOPC_PUBSUB_SKS_MAX_TOKEN_PER_CALL + 1)
+#endif
+
+// Delay (ms) before the expiry of the last known key at which a key ring prefetches the next keys
+#ifndef SOPC_PUBSUB_SKS_PREFETCH_MARGIN_MS
+#define SOPC_PUBSUB_SKS_PREFETCH_MARGIN_MS 2000
+#endif
+
+// Minimal delay (ms) between two prefetches of a key ring when the next keys are not available yet
+#ifndef SOPC_PUBSUB_SKS_PREFETCH_RETRY_MS
+#define SOPC_PUBSUB_SKS_PREFETCH_RETRY_MS 500
+#endif
+
 typedef struct SOPC_PubSubSKS_Keys
 {
     // The ID of the security token that identifies the security key in a SecurityGroup.
@@ -54,6 +70,19 @@ typedef struct SOPC_PubSubSKS_Keys
     SOPC_SecretBuffer* keyNonce;
 } SOPC_PubSubSKS_Keys;
 
+/**
+ * \brief Keys of a security group retrieved from the Security Keys Manager and kept ready to use.
+ *
+ * The ring keeps the current key and the future keys, indexed by their token id.
+ * It is refreshed from the Security Keys Manager in a single call when a key is unknown
+ * or ::SOPC_PUBSUB_SKS_PREFETCH_MARGIN_MS before the expiry of the last known key,
+ * so that a key rotation does not wait for the manager.
+ *
+ * \note A key ring is not thread-safe: it is owned by a single Publisher or Subscriber context.
+ *       The manager mutex is only taken when the ring is refreshed.
+ */
+typedef struct SOPC_PubSubSKS_KeyRing SOPC_PubSubSKS_KeyRing;
+
 /**
  * \brief Initialise the PubSubSKS
  */
@@ -90,4 +119,31 @@ SOPC_PubSubSKS_Keys* SOPC_PubSubSKS_GetSecurityKeys(uint32_t groupid, uint32_t t
  */
 void SOPC_PubSubSKS_Keys_Delete(SOPC_PubSubSKS_Keys* keys);
 
+/**
+ * \brief Create an empty key ring for a security group
+ *
+ * \warning Only ::SOPC_PUBSUB_SKS_DEFAULT_GROUPID is accepted in this version
+ *
+ * \param groupid a Security Group Id
+ * \return the key ring or NULL in case of failure
+ */
+SOPC_PubSubSKS_KeyRing* SOPC_PubSubSKS_KeyRing_Create(uint32_t groupid);
+
+/**
+ * \brief Delete a key ring and clear its keys
+ *
+ * \param ring the key ring to delete, set to NULL
+ */
+void SOPC_PubSubSKS_KeyRing_Delete(SOPC_PubSubSKS_KeyRing** ring);
+
+/**
+ * \brief Return the keys of a token from the key ring, refreshing the ring from the Security Keys Manager if needed
+ *
+ * \param ring the key ring
+ * \param tokenId token id of the requested keys. Current token is requested with ::SOPC_PUBSUB_SKS_CURRENT_TOKENID
+ * \return the keys or NULL if they are not available. The keys are owned by the ring
+ *         and remain valid until the next call to this function with the same ring.
+ */
+SOPC_PubSubSKS_Keys* SOPC_PubSubSKS_KeyRing_GetKeys(SOPC_PubSubSKS_KeyRing* ring, uint32_t tokenId);
+
 #endif /* SOPC_PUBSUB_SKS_H_ */
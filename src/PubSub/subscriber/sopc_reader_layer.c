@@ -21,11 +21,56 @@
 
 #include "sopc_assert.h"
 #include "sopc_dataset_ll_layer.h"
+#include "sopc_dict.h"
+#include "sopc_hash.h"
 #include "sopc_logger.h"
 #include "sopc_macros.h"
+#include "sopc_mem_alloc.h"
 #include "sopc_network_layer.h"
+#include "sopc_pubsub_constants.h"
 #include "sopc_pubsub_helpers.h"
 
+/* Key of an indexed ReaderGroup: a non-null PublisherId and a non-zero GroupId */
+typedef struct SOPC_Reader_GroupKey
+{
+    bool isString;
+    uint64_t uint;
+    const SOPC_String* string;
+    uint16_t groupId;
+} SOPC_Reader_GroupKey;
+
+/* A DataSetReader of a group identified by its non-zero DataSetWriterId */
+typedef struct SOPC_Reader_WriterIdEntry
+{
+    uint16_t writerId;
+    uint8_t readerIdx;
+} SOPC_Reader_WriterIdEntry;
+
+struct SOPC_Reader_GroupIndex
+{
+    uint8_t nbWriterIds;
+    SOPC_Reader_WriterIdEntry* writerIds; /* Sorted by DataSetWriterId then configuration order */
+};
+
+struct SOPC_Reader_Index
+{
+    uint16_t nbGroups;
+    SOPC_Reader_GroupKey* groupKeys; /* Key of each group, only the indexed groups keys are in groupsByKey */
+    uint16_t* nextGroups;            /* Next group index with the same key in configuration order, nbGroups if none */
+    SOPC_Dict* groupsByKey;          /* SOPC_Reader_GroupKey* => first group index with this key */
+    uint16_t nbWildcardGroups;
+    uint16_t* wildcardGroups; /* Groups with a null PublisherId or a zero GroupId, in configuration order */
+    SOPC_Reader_GroupIndex* groups;
+    SOPC_UADP_NetworkMessage_Decode_Scratch scratch;
+    SOPC_UADP_Chunks_Reassembly* chunks;
+};
+
+static bool SOPC_Sub_Match_ReaderGroup(SOPC_ReaderGroup* readerGroup,
+                                       const SOPC_UADP_Configuration* uadp_conf,
+                                       const SOPC_Dataset_LL_PublisherId* pubid,
+                                       const uint32_t groupVersion,
+                                       const uint32_t groupId);
+
 /**
  * Filter at NetworkMessage Level
  *
@@ -89,11 +134,14 @@ SOPC_NetworkMessage_Error_Code SOPC_Reader_Read_UADP(const SOPC_PubSubConnection
                                                      SOPC_UADP_IsWriterSequenceNumberNewer_Func snCBck)
 {
     SOPC_NetworkMessage_Error_Code errorCode = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_Reader_Index* index = (NULL != connection ? SOPC_PubSubConnection_Get_ReaderIndex(connection) : NULL);
     const SOPC_UADP_NetworkMessage_Reader_Configuration readerConf = {
         .pGetSecurity_Func = securityCBck,
         .checkDataSetMessageSN_Func = snCBck,
         .callbacks = SOPC_Reader_NetworkMessage_Default_Readers,
-        .targetConfig = config};
+        .targetConfig = config,
+        .scratch = (NULL != index ? &index->scratch : NULL),
+        .chunks = (NULL != index ? index->chunks : NULL)};
     SOPC_UADP_NetworkMessage* uadp_nm = NULL;
     errorCode = SOPC_UADP_NetworkMessage_Decode(buffer, &readerConf, connection, &uadp_nm);
 
@@ -108,6 +156,138 @@ SOPC_NetworkMessage_Error_Code SOPC_Reader_Read_UADP(const SOPC_PubSubConnection
     return errorCode;
 }
 
+SOPC_NetworkMessage_Error_Code SOPC_Reader_Read_JSON(const SOPC_PubSubConnection* connection,
+                                                     SOPC_Buffer* buffer,
+                                                     SOPC_SubTargetVariableConfig* config,
+                                                     SOPC_UADP_GetSecurity_Func securityCBck,
+                                                     SOPC_UADP_IsWriterSequenceNumberNewer_Func snCBck)
+{
+    const SOPC_UADP_NetworkMessage_Reader_Configuration readerConf = {
+        .pGetSecurity_Func = securityCBck,
+        .checkDataSetMessageSN_Func = snCBck,
+        .callbacks = SOPC_Reader_NetworkMessage_Default_Readers,
+        .targetConfig = config,
+        .scratch = NULL,
+        .chunks = NULL};
+    SOPC_UADP_NetworkMessage* uadp_nm = NULL;
+    SOPC_NetworkMessage_Error_Code errorCode =
+        SOPC_JSON_NetworkMessage_Decode(buffer, &readerConf, connection, &uadp_nm);
+
+    SOPC_UADP_NetworkMessage_Delete(uadp_nm);
+    return errorCode;
+}
+
+static bool SOPC_Sub_Match_ReaderGroup(SOPC_ReaderGroup* readerGroup,
+                                       const SOPC_UADP_Configuration* uadp_conf,
+                                       const SOPC_Dataset_LL_PublisherId* pubid,
+                                       const uint32_t groupVersion,
+                                       const uint32_t groupId)
+{
+    bool match = true;
+
+    if (uadp_conf->GroupVersionFlag)
+    {
+        // Check group version
+        const uint32_t confVersion = SOPC_ReaderGroup_Get_GroupVersion(readerGroup);
+
+        match &= (groupVersion == confVersion) || (0 == confVersion);
+    }
+
+    if (match && uadp_conf->GroupIdFlag)
+    {
+        // Check group Id
+        const uint16_t confGroupId = SOPC_ReaderGroup_Get_GroupId(readerGroup);
+
+        match &= (confGroupId == groupId) || (0 == confGroupId);
+    }
+
+    if (match && uadp_conf->PublisherIdFlag)
+    {
+        // Check PublisherIdFlag
+        const SOPC_Conf_PublisherId* expPubId = SOPC_ReaderGroup_Get_PublisherId(readerGroup);
+        match &= SOPC_Sub_Filter_Reader_PublisherId(expPubId, pubid);
+    }
+    return match;
+}
+
+static bool SOPC_Reader_GroupKey_FromMessage(const SOPC_Dataset_LL_PublisherId* pubid,
+                                             const uint32_t groupId,
+                                             SOPC_Reader_GroupKey* key)
+{
+    if (0 == groupId || groupId > UINT16_MAX)
+    {
+        // Only a group with a zero GroupId might match
+        return false;
+    }
+    key->isString = false;
+    key->uint = 0;
+    key->string = NULL;
+    key->groupId = (uint16_t) groupId;
+    switch (pubid->type)
+    {
+    case DataSet_LL_PubId_Byte_Id:
+        key->uint = pubid->data.byte;
+        break;
+    case DataSet_LL_PubId_UInt16_Id:
+        key->uint = pubid->data.uint16;
+        break;
+    case DataSet_LL_PubId_UInt32_Id:
+        key->uint = pubid->data.uint32;
+        break;
+    case DataSet_LL_PubId_UInt64_Id:
+        key->uint = pubid->data.uint64;
+        break;
+    case DataSet_LL_PubId_String_Id:
+        key->isString = true;
+        key->string = &pubid->data.string;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+/* Finds the first group in configuration order matching the received parameters using the index.
+ * The received message shall contain both the PublisherId and the GroupId. */
+static const SOPC_ReaderGroup* SOPC_Sub_GetIndexedReaderGroup(const SOPC_PubSubConnection* connection,
+                                                              const SOPC_Reader_Index* index,
+                                                              const SOPC_UADP_Configuration* uadp_conf,
+                                                              const SOPC_Dataset_LL_PublisherId* pubid,
+                                                              const uint32_t groupVersion,
+                                                              const uint32_t groupId)
+{
+    uint16_t result = index->nbGroups;
+    SOPC_Reader_GroupKey key;
+
+    if (SOPC_Reader_GroupKey_FromMessage(pubid, groupId, &key))
+    {
+        bool found = false;
+        uintptr_t first = SOPC_Dict_Get(index->groupsByKey, (uintptr_t) &key, &found);
+        // Only the GroupVersion might differ between the groups with the same key
+        const uint16_t firstGroup = (found ? (uint16_t) first : index->nbGroups);
+        for (uint16_t i = firstGroup; i < index->nbGroups && index->nbGroups == result; i = index->nextGroups[i])
+        {
+            SOPC_ReaderGroup* readerGroup = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, i);
+            if (SOPC_Sub_Match_ReaderGroup(readerGroup, uadp_conf, pubid, groupVersion, groupId))
+            {
+                result = i;
+            }
+        }
+    }
+
+    // A matching group with a wildcard configured before the indexed group takes precedence
+    for (uint16_t i = 0; i < index->nbWildcardGroups && index->wildcardGroups[i] < result; i++)
+    {
+        SOPC_ReaderGroup* readerGroup = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, index->wildcardGroups[i]);
+        if (SOPC_Sub_Match_ReaderGroup(readerGroup, uadp_conf, pubid, groupVersion, groupId))
+        {
+            result = index->wildcardGroups[i];
+        }
+    }
+
+    return (result < index->nbGroups ? SOPC_PubSubConnection_Get_ReaderGroup_At(connection, result) : NULL);
+}
+
 static const SOPC_ReaderGroup* SOPC_Sub_GetReaderGroup(const SOPC_PubSubConnection* connection,
                                                        const SOPC_UADP_Configuration* uadp_conf,
                                                        const SOPC_Dataset_LL_PublisherId* pubid,
@@ -115,6 +295,13 @@ static const SOPC_ReaderGroup* SOPC_Sub_GetReaderGroup(const SOPC_PubSubConnecti
                                                        const uint32_t groupId)
 {
     SOPC_ASSERT(NULL != connection && uadp_conf != NULL);
+
+    const SOPC_Reader_Index* index = SOPC_PubSubConnection_Get_ReaderIndex(connection);
+    if (NULL != index && uadp_conf->PublisherIdFlag && uadp_conf->GroupIdFlag)
+    {
+        return SOPC_Sub_GetIndexedReaderGroup(connection, index, uadp_conf, pubid, groupVersion, groupId);
+    }
+
     // Find a matching ReaderGroup in connection
     const uint16_t nbReaderGroup = SOPC_PubSubConnection_Nb_ReaderGroup(connection);
 
@@ -122,38 +309,42 @@ static const SOPC_ReaderGroup* SOPC_Sub_GetReaderGroup(const SOPC_PubSubConnecti
 
     for (uint16_t i = 0; i < nbReaderGroup && NULL == result; i++)
     {
-        bool match = true;
         SOPC_ReaderGroup* readerGroup = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, i);
         SOPC_ASSERT(NULL != readerGroup);
 
-        if (uadp_conf->GroupVersionFlag)
+        if (SOPC_Sub_Match_ReaderGroup(readerGroup, uadp_conf, pubid, groupVersion, groupId))
         {
-            // Check group version
-            const uint32_t confVersion = SOPC_ReaderGroup_Get_GroupVersion(readerGroup);
-
-            match &= (groupVersion == confVersion) || (0 == confVersion);
-        }
-
-        if (match && uadp_conf->GroupIdFlag)
-        {
-            // Check group Id
-            const uint16_t confGroupId = SOPC_ReaderGroup_Get_GroupId(readerGroup);
-
-            match &= (confGroupId == groupId) || (0 == confGroupId);
+            result = readerGroup;
         }
+    }
+    return result;
+}
 
-        if (match && uadp_conf->PublisherIdFlag)
+/* Finds the first reader in configuration order with the given non-zero DataSetWriterId using the index */
+static const SOPC_DataSetReader* SOPC_Sub_GetIndexedReader(const SOPC_ReaderGroup* group,
+                                                           const SOPC_Reader_GroupIndex* groupIndex,
+                                                           const uint16_t writerId)
+{
+    // Lower bound of writerId in the sorted entries
+    uint16_t low = 0;
+    uint16_t high = groupIndex->nbWriterIds;
+    while (low < high)
+    {
+        const uint16_t mid = (uint16_t)(low + (high - low) / 2);
+        if (groupIndex->writerIds[mid].writerId < writerId)
         {
-            // Check PublisherIdFlag
-            const SOPC_Conf_PublisherId* expPubId = SOPC_ReaderGroup_Get_PublisherId(readerGroup);
-            match &= SOPC_Sub_Filter_Reader_PublisherId(expPubId, pubid);
+            low = (uint16_t)(mid + 1);
         }
-        if (match)
+        else
         {
-            result = readerGroup;
+            high = mid;
         }
     }
-    return result;
+    if (low < groupIndex->nbWriterIds && writerId == groupIndex->writerIds[low].writerId)
+    {
+        return SOPC_ReaderGroup_Get_DataSetReader_At(group, groupIndex->writerIds[low].readerIdx);
+    }
+    return NULL;
 }
 
 static const SOPC_DataSetReader* SOPC_Sub_GetReader(const SOPC_ReaderGroup* group,
@@ -167,7 +358,15 @@ static const SOPC_DataSetReader* SOPC_Sub_GetReader(const SOPC_ReaderGroup* grou
     const uint16_t nbReaders = SOPC_ReaderGroup_Nb_DataSetReader(group);
 
     // Note: it has been checked previously that the group does not contain both zero and non-zero writerId
-    if (SOPC_ReaderGroup_HasNonZeroDataSetWriterId(group))
+    const SOPC_Reader_GroupIndex* groupIndex = SOPC_ReaderGroup_Get_ReaderIndex(group);
+    if (SOPC_ReaderGroup_HasNonZeroDataSetWriterId(group) && NULL != groupIndex)
+    {
+        if (0 != writerId)
+        {
+            result = SOPC_Sub_GetIndexedReader(group, groupIndex, writerId);
+        }
+    }
+    else if (SOPC_ReaderGroup_HasNonZeroDataSetWriterId(group))
     {
         for (uint8_t i = 0; i < nbReaders && NULL == result; i++)
         {
@@ -294,3 +493,218 @@ static bool SOPC_Sub_Filter_Reader_FieldMetaData(const SOPC_DataSetReader* reade
 
     return result;
 }
+
+/** Reader lookup index **/
+
+static uint64_t SOPC_Reader_GroupKey_Hash(const uintptr_t data)
+{
+    const SOPC_Reader_GroupKey* key = (const SOPC_Reader_GroupKey*) data;
+    uint64_t hash = SOPC_DJBHash((const uint8_t*) &key->groupId, sizeof(key->groupId));
+    if (key->isString)
+    {
+        if (key->string->Length > 0)
+        {
+            hash = SOPC_DJBHash_Step(hash, key->string->Data, (size_t) key->string->Length);
+        }
+    }
+    else
+    {
+        hash = SOPC_DJBHash_Step(hash, (const uint8_t*) &key->uint, sizeof(key->uint));
+    }
+    return hash;
+}
+
+static bool SOPC_Reader_GroupKey_Equal(const uintptr_t a, const uintptr_t b)
+{
+    const SOPC_Reader_GroupKey* left = (const SOPC_Reader_GroupKey*) a;
+    const SOPC_Reader_GroupKey* right = (const SOPC_Reader_GroupKey*) b;
+    if (left->groupId != right->groupId || left->isString != right->isString)
+    {
+        return false;
+    }
+    return (left->isString ? SOPC_String_Equal(left->string, right->string) : left->uint == right->uint);
+}
+
+static bool SOPC_Reader_GroupKey_FromConf(const SOPC_Conf_PublisherId* pubId,
+                                          const uint16_t groupId,
+                                          SOPC_Reader_GroupKey* key)
+{
+    key->isString = false;
+    key->uint = 0;
+    key->string = NULL;
+    key->groupId = groupId;
+    if (0 == groupId)
+    {
+        return false;
+    }
+    switch (pubId->type)
+    {
+    case SOPC_UInteger_PublisherId:
+        key->uint = pubId->data.uint;
+        return true;
+    case SOPC_String_PublisherId:
+        key->isString = true;
+        key->string = &pubId->data.string;
+        return true;
+    case SOPC_Null_PublisherId:
+    default:
+        return false;
+    }
+}
+
+static SOPC_ReturnStatus SOPC_Reader_GroupIndex_Build(const SOPC_ReaderGroup* group, SOPC_Reader_GroupIndex* groupIndex)
+{
+    const uint8_t nbReaders = SOPC_ReaderGroup_Nb_DataSetReader(group);
+    if (!SOPC_ReaderGroup_HasNonZeroDataSetWriterId(group) || 0 == nbReaders)
+    {
+        return SOPC_STATUS_OK;
+    }
+
+    groupIndex->writerIds = SOPC_Calloc(nbReaders, sizeof(*groupIndex->writerIds));
+    if (NULL == groupIndex->writerIds)
+    {
+        return SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    // Insertion sort by DataSetWriterId keeping the configuration order of equal DataSetWriterIds
+    for (uint8_t i = 0; i < nbReaders; i++)
+    {
+        const uint16_t writerId =
+            SOPC_DataSetReader_Get_DataSetWriterId(SOPC_ReaderGroup_Get_DataSetReader_At(group, i));
+        if (0 != writerId)
+        {
+            uint8_t pos = groupIndex->nbWriterIds;
+            while (pos > 0 && groupIndex->writerIds[pos - 1].writerId > writerId)
+            {
+                groupIndex->writerIds[pos] = groupIndex->writerIds[pos - 1];
+                pos--;
+            }
+            groupIndex->writerIds[pos].writerId = writerId;
+            groupIndex->writerIds[pos].readerIdx = i;
+            groupIndex->nbWriterIds++;
+        }
+    }
+    return SOPC_STATUS_OK;
+}
+
+static void SOPC_Reader_Index_Delete(SOPC_Reader_Index* index)
+{
+    if (NULL == index)
+    {
+        return;
+    }
+    if (NULL != index->groups)
+    {
+        for (uint16_t i = 0; i < index->nbGroups; i++)
+        {
+            SOPC_Free(index->groups[i].writerIds);
+        }
+    }
+    SOPC_Dict_Delete(index->groupsByKey);
+    SOPC_UADP_Chunks_Reassembly_Delete(&index->chunks);
+    SOPC_Free(index->groups);
+    SOPC_Free(index->wildcardGroups);
+    SOPC_Free(index->nextGroups);
+    SOPC_Free(index->groupKeys);
+    SOPC_Free(index);
+}
+
+SOPC_ReturnStatus SOPC_Reader_Index_Connection(SOPC_PubSubConnection* connection)
+{
+    SOPC_ASSERT(NULL != connection);
+    SOPC_Reader_Clear_Index(connection);
+
+    const uint16_t nbGroups = SOPC_PubSubConnection_Nb_ReaderGroup(connection);
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_Reader_Index* index = SOPC_Calloc(1, sizeof(*index));
+    status = (NULL != index ? status : SOPC_STATUS_OUT_OF_MEMORY);
+
+    if (SOPC_STATUS_OK == status)
+    {
+        index->nbGroups = nbGroups;
+        index->groupsByKey =
+            SOPC_Dict_Create((uintptr_t) NULL, SOPC_Reader_GroupKey_Hash, SOPC_Reader_GroupKey_Equal, NULL, NULL);
+        index->chunks = SOPC_UADP_Chunks_Reassembly_Create(
+            SOPC_PUBSUB_CHUNKS_MAX_PENDING_DSM, SOPC_PUBSUB_CHUNKS_MAX_MEMORY, SOPC_PUBSUB_CHUNKS_TIMEOUT_MS);
+        status = (NULL != index->groupsByKey && NULL != index->chunks ? status : SOPC_STATUS_OUT_OF_MEMORY);
+    }
+
+    if (SOPC_STATUS_OK == status && nbGroups > 0)
+    {
+        index->groupKeys = SOPC_Calloc(nbGroups, sizeof(*index->groupKeys));
+        index->nextGroups = SOPC_Calloc(nbGroups, sizeof(*index->nextGroups));
+        index->wildcardGroups = SOPC_Calloc(nbGroups, sizeof(*index->wildcardGroups));
+        index->groups = SOPC_Calloc(nbGroups, sizeof(*index->groups));
+        if (NULL == index->groupKeys || NULL == index->nextGroups || NULL == index->wildcardGroups ||
+            NULL == index->groups)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    for (uint16_t i = 0; i < nbGroups && SOPC_STATUS_OK == status; i++)
+    {
+        SOPC_ReaderGroup* group = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, i);
+        index->nextGroups[i] = nbGroups;
+        if (SOPC_Reader_GroupKey_FromConf(SOPC_ReaderGroup_Get_PublisherId(group), SOPC_ReaderGroup_Get_GroupId(group),
+                                          &index->groupKeys[i]))
+        {
+            bool found = false;
+            uintptr_t last = SOPC_Dict_Get(index->groupsByKey, (uintptr_t) &index->groupKeys[i], &found);
+            if (found)
+            {
+                // Append the group to the groups with the same key
+                while (nbGroups != index->nextGroups[last])
+                {
+                    last = index->nextGroups[last];
+                }
+                index->nextGroups[last] = i;
+            }
+            else if (!SOPC_Dict_Insert(index->groupsByKey, (uintptr_t) &index->groupKeys[i], (uintptr_t) i))
+            {
+                status = SOPC_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        else
+        {
+            index->wildcardGroups[index->nbWildcardGroups] = i;
+            index->nbWildcardGroups++;
+        }
+
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_Reader_GroupIndex_Build(group, &index->groups[i]);
+        }
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        for (uint16_t i = 0; i < nbGroups; i++)
+        {
+            SOPC_ReaderGroup_Set_ReaderIndex(SOPC_PubSubConnection_Get_ReaderGroup_At(connection, i),
+                                             &index->groups[i]);
+        }
+        SOPC_PubSubConnection_Set_ReaderIndex(connection, index);
+    }
+    else
+    {
+        SOPC_Reader_Index_Delete(index);
+    }
+
+    return status;
+}
+
+void SOPC_Reader_Clear_Index(SOPC_PubSubConnection* connection)
+{
+    SOPC_ASSERT(NULL != connection);
+    SOPC_Reader_Index* index = SOPC_PubSubConnection_Get_ReaderIndex(connection);
+    if (NULL != index)
+    {
+        for (uint16_t i = 0; i < index->nbGroups; i++)
+        {
+            SOPC_ReaderGroup_Set_ReaderIndex(SOPC_PubSubConnection_Get_ReaderGroup_At(connection, i), NULL);
+        }
+        SOPC_PubSubConnection_Set_ReaderIndex(connection, NULL);
+        SOPC_Reader_Index_Delete(index);
+    }
+}
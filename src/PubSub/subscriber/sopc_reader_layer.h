@@ -40,6 +40,42 @@ SOPC_NetworkMessage_Error_Code SOPC_Reader_Read_UADP(const SOPC_PubSubConnection
                                                      SOPC_UADP_GetSecurity_Func securityCBck,
                                                      SOPC_UADP_IsWriterSequenceNumberNewer_Func snCBck);
 
+/**
+ * Decode a JSON message and write data
+ * \param connection : configuration element of the connection associated to the received data
+ * \param buffer : data to decode
+ * \param config : configuration to provide to the target module which consumes the decoded data
+ * \param securityCBck : function to retrieve the security information, only used to reject the messages of groups
+ *                       expecting security since JSON messages are not secured
+ * \param snCBck : function to check if sequence number receive is newer or not
+ */
+SOPC_NetworkMessage_Error_Code SOPC_Reader_Read_JSON(const SOPC_PubSubConnection* connection,
+                                                     SOPC_Buffer* buffer,
+                                                     SOPC_SubTargetVariableConfig* config,
+                                                     SOPC_UADP_GetSecurity_Func securityCBck,
+                                                     SOPC_UADP_IsWriterSequenceNumberNewer_Func snCBck);
+
+/**
+ * \brief Builds the lookup index of the ReaderGroups and DataSetReaders of a subscriber connection and attaches it to
+ *        the connection. The ReaderGroups are indexed by (PublisherId, GroupId) and the DataSetReaders of each group
+ *        by DataSetWriterId, so that the default reception filtering functions do not scan the whole configuration
+ *        for each received message. The index also provides the decoding scratch state and the reassembly context
+ *        of the DataSetMessages received in chunk messages used by ::SOPC_Reader_Read_UADP.
+ *
+ * \note The ReaderGroups and DataSetReaders of the connection shall not be modified while the index exists.
+ *       The connection messages shall be read by a single thread while the index exists.
+ *
+ * \param connection  the subscriber connection to index
+ *
+ * \return SOPC_STATUS_OK in case of success, SOPC_STATUS_OUT_OF_MEMORY otherwise
+ */
+SOPC_ReturnStatus SOPC_Reader_Index_Connection(SOPC_PubSubConnection* connection);
+
+/**
+ * \brief Deletes the lookup index attached to the connection by ::SOPC_Reader_Index_Connection, if any
+ */
+void SOPC_Reader_Clear_Index(SOPC_PubSubConnection* connection);
+
 /**
  * Return default reception filtering functions.
  */
@@ -435,6 +435,25 @@ static void on_socket_message_received(void* pInputIdentifier, Socket sock)
     }
 }
 
+/* A JSON message starts with an object or an array, which cannot be the first byte of a UADP message:
+ * the UADP version (bits 0-3) of '{' (0x7B) and '[' (0x5B) is 11 */
+static bool is_json_message(const SOPC_Buffer* buffer)
+{
+    for (uint32_t i = (NULL != buffer ? buffer->position : 0); NULL != buffer && i < buffer->length; i++)
+    {
+        const uint8_t c = buffer->data[i];
+        if ('{' == c || '[' == c)
+        {
+            return true;
+        }
+        if (' ' != c && '\t' != c && '\n' != c && '\r' != c)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
 static SOPC_ReturnStatus on_message_received(SOPC_PubSubConnection* pDecoderContext,
                                              SOPC_PubSubState state,
                                              SOPC_Buffer* buffer,
@@ -451,15 +470,28 @@ static SOPC_ReturnStatus on_message_received(SOPC_PubSubConnection* pDecoderCont
     {
         /* TODO: have a more resilient behavior and avoid stopping the subscriber because of
          *  random bytes found on the network */
-        SOPC_NetworkMessage_Error_Code errorCode =
-            SOPC_Reader_Read_UADP(pDecoderContext, buffer, config, SOPC_SubScheduler_Get_Security_Infos,
-                                  SOPC_SubScheduler_Is_Writer_SN_Newer);
+        SOPC_NetworkMessage_Error_Code errorCode = SOPC_NetworkMessage_Error_Code_None;
+        if (is_json_message(buffer))
+        {
+            errorCode = SOPC_Reader_Read_JSON(pDecoderContext, buffer, config, SOPC_SubScheduler_Get_Security_Infos,
+                                              SOPC_SubScheduler_Is_Writer_SN_Newer);
+        }
+        else
+        {
+            errorCode = SOPC_Reader_Read_UADP(pDecoderContext, buffer, config, SOPC_SubScheduler_Get_Security_Infos,
+                                              SOPC_SubScheduler_Is_Writer_SN_Newer);
+        }
 
         if (SOPC_NetworkMessage_Error_Code_InvalidParameters == errorCode)
         {
             set_new_state(SOPC_PubSubState_Error);
             result = SOPC_STATUS_NOK;
         }
+        else if (SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete == errorCode)
+        {
+            // Chunk of a DataSetMessage which will be decoded once complete
+            result = SOPC_STATUS_OK;
+        }
         else if (SOPC_NetworkMessage_Error_Code_None != errorCode)
         {
             const char* name = SOPC_PubSubConnection_Get_Name(pDecoderContext);
@@ -476,6 +508,8 @@ static SOPC_ReturnStatus on_message_received(SOPC_PubSubConnection* pDecoderCont
 static void uninit_sub_scheduler_ctx(void)
 {
     schedulerCtx.config = NULL;
+    // No value is received anymore: the batch in progress, if any, will not be notified as done
+    SOPC_SubTargetVariableConfig_BatchReset(schedulerCtx.targetConfig);
     schedulerCtx.targetConfig = NULL;
     schedulerCtx.pStateCallback = NULL;
 
@@ -486,6 +520,10 @@ static void uninit_sub_scheduler_ctx(void)
         {
             schedulerCtx.transport[i].fctClear(&schedulerCtx.transport[i]);
         }
+        if (NULL != schedulerCtx.transport[i].connection)
+        {
+            SOPC_Reader_Clear_Index(schedulerCtx.transport[i].connection);
+        }
         SOPC_Logger_TraceInfo(SOPC_LOG_MODULE_PUBSUB,
                               "Transport context freed for connection #%" PRIu32 " (subscriber)", i);
     }
@@ -588,6 +626,8 @@ static SOPC_ReturnStatus init_sub_scheduler_ctx(SOPC_PubSubConfiguration* config
             if (nbReaderGroups > 0)
             {
                 schedulerCtx.transport[iIter].connection = connection;
+                // Index the readers to filter the received messages
+                status = SOPC_Reader_Index_Connection(connection);
 
                 if (SOPC_STATUS_OK == status)
                 {
@@ -647,13 +687,29 @@ static SOPC_ReturnStatus init_sub_scheduler_ctx(SOPC_PubSubConfiguration* config
                             }
                             else
                             {
-                                status = SOPC_MQTT_InitializeAndConnect_Client(
-                                    schedulerCtx.transport[iIter].mqttClient, &address[strlen(MQTT_PREFIX)],
-                                    SOPC_PubSubConnection_Get_MqttUsername(connection),
-                                    SOPC_PubSubConnection_Get_MqttPassword(connection), topic, nbReaderGroups,
-                                    on_mqtt_message_received,
-                                    SOPC_PubSubConfiguration_Get_FatalError_Callback(connection),
-                                    schedulerCtx.transport[iIter].connection);
+                                // QoS of each topic, read by the client initialization
+                                uint8_t qos[MQTT_LIB_MAX_NB_TOPIC_NAME] = {0};
+                                for (uint16_t rg_i = 0; rg_i < nbReaderGroups; rg_i++)
+                                {
+                                    qos[rg_i] = SOPC_MQTT_Get_QoS(SOPC_ReaderGroup_Get_MqttQos(
+                                        SOPC_PubSubConnection_Get_ReaderGroup_At(connection, rg_i)));
+                                }
+                                const SOPC_MQTT_Client_Options mqttOptions = {
+                                    .subQos = qos,
+                                    .maxInflight = SOPC_PubSubConnection_Get_MqttMaxInflight(connection),
+                                    .maxBufferedMessages = 0};
+                                status = SOPC_MQTT_Set_Client_Options(schedulerCtx.transport[iIter].mqttClient,
+                                                                      &mqttOptions);
+                                if (SOPC_STATUS_OK == status)
+                                {
+                                    status = SOPC_MQTT_InitializeAndConnect_Client(
+                                        schedulerCtx.transport[iIter].mqttClient, &address[strlen(MQTT_PREFIX)],
+                                        SOPC_PubSubConnection_Get_MqttUsername(connection),
+                                        SOPC_PubSubConnection_Get_MqttPassword(connection), topic, nbReaderGroups,
+                                        on_mqtt_message_received,
+                                        SOPC_PubSubConfiguration_Get_FatalError_Callback(connection),
+                                        schedulerCtx.transport[iIter].connection);
+                                }
 
                                 schedulerCtx.transport[iIter].fctClear = SOPC_SubScheduler_CtxMqtt_Clear;
                                 schedulerCtx.transport[iIter].protocol = SOPC_PubSubProtocol_MQTT;
@@ -918,42 +974,30 @@ static SOPC_PubSub_SecurityType* SOPC_SubScheduler_Get_Security_Infos(uint32_t t
         return NULL;
     }
 
-    /* Check the validity of the request.
-
-     */
-    SOPC_PubSub_SecurityType* security = NULL;
-
-    /* Keys is not set or new token id used by this publisher */
-    if (NULL == readerCtx->security.groupKeys || tokenId > readerCtx->security.groupKeys->tokenId)
+    /* Check the validity of the request */
+    SOPC_PubSub_SecurityType* security = &readerCtx->security;
+    const uint32_t currentTokenId = (NULL != security->groupKeys ? security->groupKeys->tokenId : 0);
+    if (tokenId < currentTokenId)
     {
-        SOPC_PubSubSKS_Keys* keys = SOPC_PubSubSKS_GetSecurityKeys(SOPC_PUBSUB_SKS_DEFAULT_GROUPID, tokenId);
-        if (NULL != keys && tokenId == keys->tokenId)
-        {
-            security = &readerCtx->security;
-            SOPC_PubSubSKS_Keys_Delete(security->groupKeys);
-            SOPC_Free(security->groupKeys);
-            security->groupKeys = keys;
-            security->sequenceNumber = 0;
-        }
-        else
-        {
-            SOPC_PubSubSKS_Keys_Delete(keys);
-            SOPC_Free(keys);
-            SOPC_Logger_TraceInfo(SOPC_LOG_MODULE_PUBSUB,
-                                  "# Error: Subscriber cannot retrieve Security Keys for Publisher %" PRIu64
-                                  " and token %" PRIu32 ". \n",
-                                  pubId.data.uint, tokenId);
-        }
+        // this token id is too old. The message is not managed
+        return NULL;
     }
-    else if (tokenId < readerCtx->security.groupKeys->tokenId)
+
+    /* Keys of the token used by this publisher. The next keys are prefetched by the key ring:
+     * a new token id does not wait for the SK manager */
+    security->groupKeys = SOPC_PubSubSKS_KeyRing_GetKeys(security->keyRing, tokenId);
+    if (NULL == security->groupKeys)
     {
-        // this token id is not too old. The message is not managed
-        security = NULL;
+        SOPC_Logger_TraceInfo(SOPC_LOG_MODULE_PUBSUB,
+                              "# Error: Subscriber cannot retrieve Security Keys for Publisher %" PRIu64
+                              " and token %" PRIu32 ". \n",
+                              pubId.data.uint, tokenId);
+        return NULL;
     }
-    else
+    if (tokenId != currentTokenId)
     {
-        // this token is still used
-        security = &readerCtx->security;
+        // new token id used by this publisher
+        security->sequenceNumber = 0;
     }
     return security;
 }
@@ -1039,8 +1083,9 @@ static SOPC_SubScheduler_Security_Reader_Ctx* SOPC_SubScheduler_Reader_Ctx_Creat
     ctx->security.mode = mode;
     ctx->security.sequenceNumber = 0;
     ctx->security.groupKeys = NULL;
+    ctx->security.keyRing = SOPC_PubSubSKS_KeyRing_Create(SOPC_PUBSUB_SKS_DEFAULT_GROUPID);
     ctx->security.provider = SOPC_CryptoProvider_CreatePubSub(SOPC_PUBSUB_SECURITY_POLICY);
-    if (NULL == ctx->security.provider)
+    if (NULL == ctx->security.provider || NULL == ctx->security.keyRing)
     {
         SOPC_PubSub_Security_Clear(&ctx->security);
         SOPC_Free(ctx);
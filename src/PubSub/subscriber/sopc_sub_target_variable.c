@@ -21,15 +21,106 @@
 
 #include "opcua_statuscodes.h"
 #include "sopc_assert.h"
+#include "sopc_dict.h"
+#include "sopc_hash.h"
 #include "sopc_mem_alloc.h"
+#include "sopc_mutexes.h"
 #include "sopc_pubsub_helpers.h"
 #include "sopc_sub_target_variable.h"
 
+/* Values received for the target variables of a batched configuration */
+typedef struct SOPC_SubTargetVariable_Buffer
+{
+    SOPC_DataValue* values; /* Last received value of each target variable */
+    bool* updated;          /* Target variables updated since the previous batch */
+    uint32_t* updatedIndexes;
+    uint32_t nbUpdated;
+} SOPC_SubTargetVariable_Buffer;
+
+typedef struct SOPC_SubTargetVariable_Batch
+{
+    SOPC_Dict* firstTargetByReader; /* DataSetReader => index of the target variable of its first field */
+    uint32_t nbTargets;
+    OpcUa_WriteValue* targets; /* Resolved target variables, their values are not used */
+    /* The subscriber fills the back buffer. Buffers are swapped when a batch is started,
+     * the front buffer is then only used to build the batch. */
+    SOPC_SubTargetVariable_Buffer buffers[2];
+    uint32_t backBuffer;
+    bool batchInProgress;
+    SOPC_Mutex mutex; /* Protects the back buffer, the swap and batchInProgress */
+} SOPC_SubTargetVariable_Batch;
+
 struct _SOPC_SubTargetVariableConfig
 {
     SOPC_SetTargetVariables_Func* callback;
+    SOPC_SubTargetVariable_Batch* batch; /* NULL if the values are not batched */
 };
 
+static uint64_t SOPC_SubTargetVariable_Reader_Hash(const uintptr_t reader)
+{
+    return SOPC_DJBHash((const uint8_t*) &reader, sizeof(reader));
+}
+
+static bool SOPC_SubTargetVariable_Reader_Equal(const uintptr_t a, const uintptr_t b)
+{
+    return a == b;
+}
+
+/* Fills the NodeId, AttributeId and IndexRange of the write value of a field target variable */
+static SOPC_ReturnStatus SOPC_SubTargetVariable_Resolve(const SOPC_FieldMetaData* fieldMetaData,
+                                                        OpcUa_WriteValue* value)
+{
+    const SOPC_FieldTarget* targetData = SOPC_FieldMetaData_Get_TargetVariable(fieldMetaData);
+    if (NULL == targetData)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+
+    // Fill write value:
+    // NodeId
+    SOPC_ReturnStatus status = SOPC_NodeId_Copy(&value->NodeId, SOPC_FieldTarget_Get_NodeId(targetData));
+
+    if (SOPC_STATUS_OK == status)
+    {
+        // AttributeId
+        value->AttributeId = SOPC_FieldTarget_Get_AttributeId(targetData);
+
+        // source and target indexes:
+        SOPC_ASSERT(NULL == SOPC_FieldTarget_Get_SourceIndexRange(
+                                targetData)); // We do not manage index range on received data
+
+        const char* targetIndexRange = SOPC_FieldTarget_Get_TargetIndexRange(targetData);
+        if (NULL != targetIndexRange)
+        {
+            status = SOPC_String_CopyFromCString(&value->IndexRange,
+                                                 targetIndexRange); // But server will manage it on written data
+        }
+    }
+    return status;
+}
+
+/* Fills the value of a field target variable with the received variant */
+static SOPC_ReturnStatus SOPC_SubTargetVariable_Set_Value(const SOPC_FieldMetaData* fieldMetaData,
+                                                          const SOPC_Variant* variant,
+                                                          SOPC_DataValue* value)
+{
+    bool isBad = false;
+    bool isCompatibleType = SOPC_PubSubHelpers_IsCompatibleVariant(fieldMetaData, variant, &isBad);
+
+    if (!isCompatibleType)
+    {
+        return SOPC_STATUS_INVALID_PARAMETERS;
+    }
+    if (isBad)
+    {
+        // Bad status code received instead of value, set it as status and keep value Null (default)
+        value->Status = variant->Value.Status;
+        return SOPC_STATUS_OK;
+    }
+    // Nominal case
+    return SOPC_Variant_Copy(&value->Value, variant);
+}
+
 SOPC_SubTargetVariableConfig* SOPC_SubTargetVariableConfig_Create(SOPC_SetTargetVariables_Func* callback)
 {
     SOPC_SubTargetVariableConfig* targetConfig = SOPC_Calloc(1, sizeof(*targetConfig));
@@ -40,11 +131,301 @@ SOPC_SubTargetVariableConfig* SOPC_SubTargetVariableConfig_Create(SOPC_SetTarget
     return targetConfig;
 }
 
+static void SOPC_SubTargetVariable_Batch_Delete(SOPC_SubTargetVariable_Batch* batch)
+{
+    if (NULL == batch)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < batch->nbTargets && NULL != batch->targets; i++)
+    {
+        OpcUa_WriteValue_Clear(&batch->targets[i]);
+    }
+    SOPC_Free(batch->targets);
+    for (size_t iBuffer = 0; iBuffer < 2; iBuffer++)
+    {
+        SOPC_SubTargetVariable_Buffer* buffer = &batch->buffers[iBuffer];
+        for (uint32_t i = 0; i < batch->nbTargets && NULL != buffer->values; i++)
+        {
+            SOPC_DataValue_Clear(&buffer->values[i]);
+        }
+        SOPC_Free(buffer->values);
+        SOPC_Free(buffer->updated);
+        SOPC_Free(buffer->updatedIndexes);
+    }
+    SOPC_Dict_Delete(batch->firstTargetByReader);
+    SOPC_Mutex_Clear(&batch->mutex);
+    SOPC_Free(batch);
+}
+
+/* Resolves the target variables of all the DataSetReaders of the configuration */
+static SOPC_ReturnStatus SOPC_SubTargetVariable_Batch_Resolve(SOPC_SubTargetVariable_Batch* batch,
+                                                              const SOPC_PubSubConfiguration* config,
+                                                              bool countOnly)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    uint32_t iTarget = 0;
+    const uint32_t nbConnections = SOPC_PubSubConfiguration_Nb_SubConnection(config);
+    for (uint32_t iConn = 0; SOPC_STATUS_OK == status && iConn < nbConnections; iConn++)
+    {
+        const SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, iConn);
+        const uint16_t nbGroups = SOPC_PubSubConnection_Nb_ReaderGroup(connection);
+        for (uint16_t iGroup = 0; SOPC_STATUS_OK == status && iGroup < nbGroups; iGroup++)
+        {
+            const SOPC_ReaderGroup* group = SOPC_PubSubConnection_Get_ReaderGroup_At(connection, iGroup);
+            const uint8_t nbReaders = SOPC_ReaderGroup_Nb_DataSetReader(group);
+            for (uint8_t iReader = 0; SOPC_STATUS_OK == status && iReader < nbReaders; iReader++)
+            {
+                const SOPC_DataSetReader* reader = SOPC_ReaderGroup_Get_DataSetReader_At(group, iReader);
+                const uint16_t nbFields = SOPC_DataSetReader_Nb_FieldMetaData(reader);
+                if (!countOnly && !SOPC_Dict_Insert(batch->firstTargetByReader, (uintptr_t) reader,
+                                                    (uintptr_t) iTarget))
+                {
+                    status = SOPC_STATUS_OUT_OF_MEMORY;
+                }
+                for (uint16_t iField = 0; SOPC_STATUS_OK == status && iField < nbFields; iField++, iTarget++)
+                {
+                    if (!countOnly)
+                    {
+                        OpcUa_WriteValue_Initialize(&batch->targets[iTarget]);
+                        status = SOPC_SubTargetVariable_Resolve(SOPC_DataSetReader_Get_FieldMetaData_At(reader, iField),
+                                                                &batch->targets[iTarget]);
+                    }
+                }
+            }
+        }
+    }
+    if (countOnly)
+    {
+        batch->nbTargets = iTarget;
+    }
+    return status;
+}
+
+SOPC_SubTargetVariableConfig* SOPC_SubTargetVariableConfig_CreateBatched(SOPC_SetTargetVariables_Func* callback,
+                                                                         const SOPC_PubSubConfiguration* config)
+{
+    if (NULL == callback || NULL == config)
+    {
+        return NULL;
+    }
+    SOPC_SubTargetVariableConfig* targetConfig = SOPC_SubTargetVariableConfig_Create(callback);
+    SOPC_SubTargetVariable_Batch* batch = SOPC_Calloc(1, sizeof(*batch));
+    SOPC_ReturnStatus status = (NULL != targetConfig && NULL != batch ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Mutex_Initialization(&batch->mutex);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_SubTargetVariable_Batch_Resolve(batch, config, true);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        batch->firstTargetByReader = SOPC_Dict_Create((uintptr_t) NULL, SOPC_SubTargetVariable_Reader_Hash,
+                                                      SOPC_SubTargetVariable_Reader_Equal, NULL, NULL);
+        // At least one element allocated when there is no target variable
+        const size_t nbAllocated = (0 == batch->nbTargets ? 1 : batch->nbTargets);
+        batch->targets = SOPC_Calloc(nbAllocated, sizeof(*batch->targets));
+        for (size_t iBuffer = 0; iBuffer < 2; iBuffer++)
+        {
+            SOPC_SubTargetVariable_Buffer* buffer = &batch->buffers[iBuffer];
+            buffer->values = SOPC_Calloc(nbAllocated, sizeof(*buffer->values));
+            buffer->updated = SOPC_Calloc(nbAllocated, sizeof(*buffer->updated));
+            buffer->updatedIndexes = SOPC_Calloc(nbAllocated, sizeof(*buffer->updatedIndexes));
+            if (NULL == buffer->values || NULL == buffer->updated || NULL == buffer->updatedIndexes)
+            {
+                status = SOPC_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        if (NULL == batch->firstTargetByReader || NULL == batch->targets)
+        {
+            status = SOPC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_SubTargetVariable_Batch_Resolve(batch, config, false);
+    }
+
+    if (SOPC_STATUS_OK != status)
+    {
+        SOPC_SubTargetVariable_Batch_Delete(batch);
+        SOPC_SubTargetVariableConfig_Delete(targetConfig);
+        return NULL;
+    }
+    targetConfig->batch = batch;
+    return targetConfig;
+}
+
 void SOPC_SubTargetVariableConfig_Delete(SOPC_SubTargetVariableConfig* targetConfig)
 {
+    if (NULL != targetConfig)
+    {
+        SOPC_SubTargetVariable_Batch_Delete(targetConfig->batch);
+    }
     SOPC_Free(targetConfig);
 }
 
+/* Starts a batch with the updated values if there is no batch in progress */
+static void SOPC_SubTargetVariable_Batch_Start(SOPC_SubTargetVariableConfig* targetConfig)
+{
+    SOPC_SubTargetVariable_Batch* batch = targetConfig->batch;
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    SOPC_SubTargetVariable_Buffer* front = NULL;
+    if (!batch->batchInProgress && 0 < batch->buffers[batch->backBuffer].nbUpdated)
+    {
+        front = &batch->buffers[batch->backBuffer];
+        batch->backBuffer = 1 - batch->backBuffer;
+        batch->batchInProgress = true;
+    }
+    status = SOPC_Mutex_Unlock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    if (NULL == front)
+    {
+        return;
+    }
+
+    // The front buffer is only used by this batch until it is done: build the batch out of the mutex
+    OpcUa_WriteValue* writeValues = SOPC_Calloc(front->nbUpdated, sizeof(*writeValues));
+    status = (NULL != writeValues ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    for (uint32_t i = 0; i < front->nbUpdated; i++)
+    {
+        const uint32_t iTarget = front->updatedIndexes[i];
+        if (SOPC_STATUS_OK == status)
+        {
+            OpcUa_WriteValue* value = &writeValues[i];
+            OpcUa_WriteValue_Initialize(value);
+            const OpcUa_WriteValue* target = &batch->targets[iTarget];
+            status = SOPC_NodeId_Copy(&value->NodeId, &target->NodeId);
+            value->AttributeId = target->AttributeId;
+            if (SOPC_STATUS_OK == status)
+            {
+                status = SOPC_String_Copy(&value->IndexRange, &target->IndexRange);
+            }
+            // The value is moved to the batch
+            value->Value = front->values[iTarget];
+            SOPC_DataValue_Initialize(&front->values[iTarget]);
+        }
+        else
+        {
+            SOPC_DataValue_Clear(&front->values[iTarget]);
+        }
+        front->updated[iTarget] = false;
+    }
+    const int32_t nbValues = (int32_t) front->nbUpdated;
+    front->nbUpdated = 0;
+
+    if (SOPC_STATUS_OK != status && NULL != writeValues)
+    {
+        for (int32_t i = 0; i < nbValues; i++)
+        {
+            OpcUa_WriteValue_Clear(&writeValues[i]);
+        }
+        SOPC_Free(writeValues);
+    }
+    if (SOPC_STATUS_OK != status || !targetConfig->callback(writeValues, nbValues))
+    {
+        // The batch is lost, next values will be passed in a new batch
+        status = SOPC_Mutex_Lock(&batch->mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+        batch->batchInProgress = false;
+        status = SOPC_Mutex_Unlock(&batch->mutex);
+        SOPC_ASSERT(SOPC_STATUS_OK == status);
+    }
+}
+
+void SOPC_SubTargetVariableConfig_BatchDone(SOPC_SubTargetVariableConfig* targetConfig)
+{
+    if (NULL == targetConfig || NULL == targetConfig->batch)
+    {
+        return;
+    }
+    SOPC_SubTargetVariable_Batch* batch = targetConfig->batch;
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    batch->batchInProgress = false;
+    status = SOPC_Mutex_Unlock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+
+    SOPC_SubTargetVariable_Batch_Start(targetConfig);
+}
+
+void SOPC_SubTargetVariableConfig_BatchReset(SOPC_SubTargetVariableConfig* targetConfig)
+{
+    if (NULL == targetConfig || NULL == targetConfig->batch)
+    {
+        return;
+    }
+    SOPC_SubTargetVariable_Batch* batch = targetConfig->batch;
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    // The front buffer is emptied when a batch is built: only the back buffer holds values
+    SOPC_SubTargetVariable_Buffer* back = &batch->buffers[batch->backBuffer];
+    for (uint32_t i = 0; i < back->nbUpdated; i++)
+    {
+        const uint32_t iTarget = back->updatedIndexes[i];
+        SOPC_DataValue_Clear(&back->values[iTarget]);
+        back->updated[iTarget] = false;
+    }
+    back->nbUpdated = 0;
+    batch->batchInProgress = false;
+    status = SOPC_Mutex_Unlock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+}
+
+/* Stores the received values in the back buffer and starts a batch if possible */
+static bool SOPC_SubTargetVariable_Batch_SetVariables(SOPC_SubTargetVariableConfig* targetConfig,
+                                                      const SOPC_DataSetReader* reader,
+                                                      const SOPC_Dataset_LL_DataSetMessage* dsm,
+                                                      uint16_t nbFields)
+{
+    SOPC_SubTargetVariable_Batch* batch = targetConfig->batch;
+    bool found = false;
+    const uint32_t firstTarget = (uint32_t) SOPC_Dict_Get(batch->firstTargetByReader, (uintptr_t) reader, &found);
+    if (!found)
+    {
+        return false; // Reader not in the configuration given at creation
+    }
+    SOPC_ASSERT(firstTarget + nbFields <= batch->nbTargets);
+
+    SOPC_ReturnStatus status = SOPC_Mutex_Lock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == status);
+    SOPC_SubTargetVariable_Buffer* back = &batch->buffers[batch->backBuffer];
+    for (uint16_t i = 0; i < nbFields; i++)
+    {
+        const uint32_t iTarget = firstTarget + i;
+        const SOPC_Variant* variant = SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, i);
+        SOPC_ASSERT(NULL != variant);
+        const SOPC_FieldMetaData* fieldMetaData = SOPC_DataSetReader_Get_FieldMetaData_At(reader, i);
+        SOPC_ASSERT(NULL != fieldMetaData);
+
+        // The last received value replaces the one which was not passed yet, only if it is valid
+        SOPC_DataValue value;
+        SOPC_DataValue_Initialize(&value);
+        status = SOPC_SubTargetVariable_Set_Value(fieldMetaData, variant, &value);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_DataValue_Clear(&value);
+            break;
+        }
+        SOPC_DataValue_Clear(&back->values[iTarget]);
+        back->values[iTarget] = value;
+        if (!back->updated[iTarget])
+        {
+            back->updated[iTarget] = true;
+            back->updatedIndexes[back->nbUpdated] = iTarget;
+            back->nbUpdated++;
+        }
+    }
+    SOPC_ReturnStatus mutStatus = SOPC_Mutex_Unlock(&batch->mutex);
+    SOPC_ASSERT(SOPC_STATUS_OK == mutStatus);
+
+    SOPC_SubTargetVariable_Batch_Start(targetConfig);
+    return SOPC_STATUS_OK == status;
+}
+
 bool SOPC_SubTargetVariable_SetVariables(SOPC_SubTargetVariableConfig* targetConfig,
                                          const SOPC_DataSetReader* reader,
                                          const SOPC_Dataset_LL_DataSetMessage* dsm)
@@ -67,6 +448,11 @@ bool SOPC_SubTargetVariable_SetVariables(SOPC_SubTargetVariableConfig* targetCon
         return true; // Nothing to do since there is no callback to call
     }
 
+    if (NULL != targetConfig->batch)
+    {
+        return SOPC_SubTargetVariable_Batch_SetVariables(targetConfig, reader, dsm, nbFields);
+    }
+
     OpcUa_WriteValue* writeValues = SOPC_Calloc(nbFields, sizeof(*writeValues));
     if (NULL == writeValues)
     {
@@ -79,63 +465,19 @@ bool SOPC_SubTargetVariable_SetVariables(SOPC_SubTargetVariableConfig* targetCon
         OpcUa_WriteValue* value = &writeValues[i];
         OpcUa_WriteValue_Initialize(value);
 
-        const SOPC_Variant* variant = NULL;
-        SOPC_FieldTarget* targetData = NULL;
-        SOPC_FieldMetaData* fieldMetaData = NULL;
-
         if (SOPC_STATUS_OK == status)
         {
-            variant = SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, i);
+            const SOPC_Variant* variant = SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, i);
             SOPC_ASSERT(NULL != variant);
-            fieldMetaData = SOPC_DataSetReader_Get_FieldMetaData_At(reader, i);
+            const SOPC_FieldMetaData* fieldMetaData = SOPC_DataSetReader_Get_FieldMetaData_At(reader, i);
             SOPC_ASSERT(NULL != fieldMetaData);
-            targetData = SOPC_FieldMetaData_Get_TargetVariable(fieldMetaData);
-            SOPC_ASSERT(NULL != targetData);
-
-            // Fill write value:
-            // NodeId
-            status = SOPC_NodeId_Copy(&value->NodeId, SOPC_FieldTarget_Get_NodeId(targetData));
-        }
-
-        if (SOPC_STATUS_OK == status)
-        {
-            // AttributeId
-            value->AttributeId = SOPC_FieldTarget_Get_AttributeId(targetData);
-
-            // source and target indexes:
-            SOPC_ASSERT(NULL == SOPC_FieldTarget_Get_SourceIndexRange(
-                                    targetData)); // We do not manage index range on received data
-
-            const char* targetIndexRange = SOPC_FieldTarget_Get_TargetIndexRange(targetData);
-            if (NULL != targetIndexRange)
-            {
-                status = SOPC_String_CopyFromCString(&value->IndexRange,
-                                                     targetIndexRange); // But server will manage it on written data
-            }
-        }
+            SOPC_ASSERT(NULL != SOPC_FieldMetaData_Get_TargetVariable(fieldMetaData));
 
-        // Fill value
-        if (SOPC_STATUS_OK == status)
-        {
-            bool isBad = false;
-            bool isCompatibleType = SOPC_PubSubHelpers_IsCompatibleVariant(fieldMetaData, variant, &isBad);
-
-            if (isCompatibleType)
-            {
-                if (isBad)
-                {
-                    // Bad status code received instead of value, set it as status and keep value Null (default)
-                    value->Value.Status = variant->Value.Status;
-                }
-                else
-                {
-                    // Nominal case
-                    status = SOPC_Variant_Copy(&value->Value.Value, variant);
-                }
-            }
-            else
+            status = SOPC_SubTargetVariable_Resolve(fieldMetaData, value);
+            // Fill value
+            if (SOPC_STATUS_OK == status)
             {
-                status = SOPC_STATUS_INVALID_PARAMETERS;
+                status = SOPC_SubTargetVariable_Set_Value(fieldMetaData, variant, &value->Value);
             }
         }
     }
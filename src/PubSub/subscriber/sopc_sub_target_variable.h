@@ -41,6 +41,48 @@ typedef bool SOPC_SetTargetVariables_Func(OpcUa_WriteValue* nodesToWrite, int32_
 /* If callback NULL, creation succeeds and SetVariables will only check input parameters on call */
 SOPC_SubTargetVariableConfig* SOPC_SubTargetVariableConfig_Create(SOPC_SetTargetVariables_Func* callback);
 
+/**
+ * \brief Creates a target configuration which forwards the received values in batches.
+ *
+ * The target variables of all the DataSetReaders of \p config are resolved once at creation.
+ * The received values are stored in a double buffer: the last received value of each target variable replaces the
+ * previous one until the next batch. A batch contains the values of all the target variables updated since the
+ * previous one and is passed to \p callback with the same ownership rules as ::SOPC_SetTargetVariables_Func.
+ * There is only one batch in progress at a time: the next one is passed to \p callback once
+ * ::SOPC_SubTargetVariableConfig_BatchDone is called, so that a slow consumer (e.g. the Write service of an embedded
+ * server) receives fewer and larger batches instead of being overloaded.
+ *
+ * \param callback  the callback which processes a batch of values. Shall not be NULL.
+ * \param config    the PubSub configuration containing the DataSetReaders which may be passed to
+ *                  ::SOPC_SubTargetVariable_SetVariables. It shall outlive the target configuration.
+ *
+ * \return the target configuration or NULL in case of failure or if a field has no target variable
+ */
+SOPC_SubTargetVariableConfig* SOPC_SubTargetVariableConfig_CreateBatched(SOPC_SetTargetVariables_Func* callback,
+                                                                         const SOPC_PubSubConfiguration* config);
+
+/**
+ * \brief Notifies that the last batch passed to the callback of a batched target configuration is processed.
+ *        The values received since then are passed as a new batch if any.
+ *
+ * \note It may be called from any thread, including from the callback itself for a synchronous processing.
+ *
+ * \param targetConfig  a target configuration created with ::SOPC_SubTargetVariableConfig_CreateBatched
+ */
+void SOPC_SubTargetVariableConfig_BatchDone(SOPC_SubTargetVariableConfig* targetConfig);
+
+/**
+ * \brief Drops the values not passed yet and the batch in progress of a batched target configuration.
+ *        The next received values are passed as a new batch without waiting for
+ *        ::SOPC_SubTargetVariableConfig_BatchDone.
+ *
+ * It shall be called when the batch in progress will never be notified as done (e.g. its processing was lost).
+ * It is called by the subscriber scheduler when it stops.
+ *
+ * \param targetConfig  a target configuration created with ::SOPC_SubTargetVariableConfig_CreateBatched
+ */
+void SOPC_SubTargetVariableConfig_BatchReset(SOPC_SubTargetVariableConfig* targetConfig);
+
 void SOPC_SubTargetVariableConfig_Delete(SOPC_SubTargetVariableConfig* targetConfig);
 
 /* Function used by subscriber scheduler to set target variables */
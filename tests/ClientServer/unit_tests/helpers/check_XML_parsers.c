@@ -26,10 +26,12 @@
  */
 
 #include <check.h>
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "check_helpers.h"
 
+#include "binary/sopc_addspace_snapshot.h"
 #include "embedded/sopc_addspace_loader.h"
 #ifdef WITH_EXPAT
 #include "xml_expat/sopc_config_loader.h"
@@ -38,13 +40,21 @@
 #endif
 
 #include "opcua_identifiers.h"
+#include "opcua_statuscodes.h"
+#include "sopc_address_space_access.h"
+#include "sopc_address_space_access_internal.h"
+#include "sopc_address_space_index_internal.h"
+#include "sopc_address_space_utils_internal.h"
 #include "sopc_encodeable.h"
 #include "sopc_helper_endianness_cfg.h"
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
+#include "sopc_node_mgt_helper_internal.h"
 #include "sopc_user_app_itf.h"
 
 #define XML_UA_NODESET_NAME "S2OPC_Test_NodeSet.xml"
+#define XML_RECIPROCAL_REFS_NODESET_NAME "S2OPC_Test_Reciprocal_Refs.xml"
+#define UA_NODESET_SNAPSHOT_NAME "S2OPC_Test_NodeSet.snapshot"
 #define XML_SRV_CONFIG_NAME "S2OPC_Test_XML_Config.xml"
 #define XML_USERS_CONFIG_NAME "S2OPC_Test_Users.xml"
 
@@ -78,15 +88,14 @@ static void check_variable_and_type_common(SOPC_AddressSpace* leftSpace,
             ck_assert_int_gt(SOPC_SECOND_TO_100_NANOSECONDS, right_ts.timestamp - left_ts.timestamp);
         }
     }
-
-    if (SOPC_AddressSpace_AreReadOnlyNodes(leftSpace))
-    {
-        ck_assert_uint_eq(SOPC_GoodGenericStatus, SOPC_AddressSpace_Get_StatusCode(leftSpace, left));
-    }
-
-    if (SOPC_AddressSpace_AreReadOnlyNodes(rightSpace))
+    else
     {
-        ck_assert_uint_eq(SOPC_GoodGenericStatus, SOPC_AddressSpace_Get_StatusCode(rightSpace, right));
+        // Constant read only nodes have no value status (always Good) contrary to owned read only nodes (snapshot)
+        SOPC_StatusCode left_status = SOPC_AddressSpace_Get_StatusCode(leftSpace, left);
+        SOPC_StatusCode right_status = SOPC_AddressSpace_Get_StatusCode(rightSpace, right);
+        ck_assert(left_status == right_status ||
+                  (SOPC_AddressSpace_AreReadOnlyNodes(leftSpace) && SOPC_GoodGenericStatus == left_status) ||
+                  (SOPC_AddressSpace_AreReadOnlyNodes(rightSpace) && SOPC_GoodGenericStatus == right_status));
     }
 
     int32_t compare = -1;
@@ -260,6 +269,29 @@ static void addspace_for_each_equal(const uintptr_t key, const uintptr_t value,
         ck_assert(false);
     }
 }
+
+static void addspace_for_each_equal_value_metadata(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_AddressSpace** addSpaces = (SOPC_AddressSpace**) user_data;
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    SOPC_AddressSpace_Node* left = (SOPC_AddressSpace_Node*) value;
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+    if (OpcUa_NodeClass_Variable != left->node_class)
+    {
+        return;
+    }
+
+    bool found = false;
+    SOPC_AddressSpace_Node* right = SOPC_AddressSpace_Get_Node(addSpaces[1], (SOPC_NodeId*) key, &found);
+    ck_assert(found);
+
+    ck_assert_uint_eq(SOPC_AddressSpace_Get_StatusCode(addSpaces[0], left),
+                      SOPC_AddressSpace_Get_StatusCode(addSpaces[1], right));
+    SOPC_Value_Timestamp leftTs = SOPC_AddressSpace_Get_SourceTs(addSpaces[0], left);
+    SOPC_Value_Timestamp rightTs = SOPC_AddressSpace_Get_SourceTs(addSpaces[1], right);
+    ck_assert_int_eq(leftTs.timestamp, rightTs.timestamp);
+    ck_assert_uint_eq(leftTs.picoSeconds, rightTs.picoSeconds);
+}
 #endif // WITH_CONST_ADDSPACE
 #endif // WITH_EXPAT
 
@@ -299,6 +331,561 @@ START_TEST(test_same_address_space_results)
 }
 END_TEST
 
+START_TEST(test_snapshot_address_space_results)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_snapshot_address_space_results ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* spaceDynamic = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(spaceDynamic);
+    fclose(fd);
+
+    /* Set a specific value status and source timestamp to be restored from the snapshot */
+    const SOPC_NodeId variableId = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Server_ServerStatus};
+    bool found = false;
+    SOPC_AddressSpace_Node* variable = SOPC_AddressSpace_Get_Node(spaceDynamic, &variableId, &found);
+    ck_assert(found);
+    ck_assert_uint_eq(OpcUa_NodeClass_Variable, variable->node_class);
+    SOPC_Value_Timestamp variableTs = {132000000000000000, 42};
+    ck_assert(SOPC_AddressSpace_Set_StatusCode(spaceDynamic, variable, OpcUa_UncertainLastUsableValue));
+    ck_assert(SOPC_AddressSpace_Set_SourceTs(spaceDynamic, variable, variableTs));
+
+    /* Write the snapshot and load it back */
+    SOPC_ReturnStatus status = SOPC_AddressSpaceSnapshot_WriteFile(spaceDynamic, UA_NODESET_SNAPSHOT_NAME);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_AddressSpace* spaceSnapshot = SOPC_AddressSpaceSnapshot_LoadFile(UA_NODESET_SNAPSHOT_NAME);
+    ck_assert_ptr_nonnull(spaceSnapshot);
+    ck_assert(SOPC_AddressSpace_AreReadOnlyNodes(spaceSnapshot));
+
+    /* Check all data present in dynamic are present in snapshot and reciprocally */
+    SOPC_AddressSpace* spaces[2] = {spaceDynamic, spaceSnapshot};
+    SOPC_AddressSpace_ForEach(spaceDynamic, addspace_for_each_equal, (uintptr_t) spaces);
+    SOPC_AddressSpace* spaces2[2] = {spaceSnapshot, spaceDynamic};
+    SOPC_AddressSpace_ForEach(spaceSnapshot, addspace_for_each_equal, (uintptr_t) spaces2);
+
+    /* Check the Variable nodes value status and source timestamp are restored */
+    SOPC_AddressSpace_ForEach(spaceDynamic, addspace_for_each_equal_value_metadata, (uintptr_t) spaces);
+    variable = SOPC_AddressSpace_Get_Node(spaceSnapshot, &variableId, &found);
+    ck_assert(found);
+    ck_assert_uint_eq(OpcUa_UncertainLastUsableValue, SOPC_AddressSpace_Get_StatusCode(spaceSnapshot, variable));
+    ck_assert_int_eq(variableTs.timestamp, SOPC_AddressSpace_Get_SourceTs(spaceSnapshot, variable).timestamp);
+    ck_assert_uint_eq(variableTs.picoSeconds, SOPC_AddressSpace_Get_SourceTs(spaceSnapshot, variable).picoSeconds);
+
+    /* Snapshot of a snapshot shall be decodable, truncated or bad version snapshot shall not */
+    SOPC_Buffer* buf = SOPC_Buffer_CreateResizable(4096, UINT32_MAX);
+    ck_assert_ptr_nonnull(buf);
+    status = SOPC_AddressSpaceSnapshot_Encode(spaceSnapshot, buf);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    status = SOPC_Buffer_SetPosition(buf, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_AddressSpace* spaceSnapshot2 = SOPC_AddressSpaceSnapshot_Decode(buf);
+    ck_assert_ptr_nonnull(spaceSnapshot2);
+    SOPC_AddressSpace_Delete(spaceSnapshot2);
+
+    status = SOPC_Buffer_SetPosition(buf, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    status = SOPC_Buffer_SetDataLength(buf, buf->length - 1);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_ptr_null(SOPC_AddressSpaceSnapshot_Decode(buf));
+
+    // Version is encoded just after the 8 bytes magic
+    status = SOPC_Buffer_SetPosition(buf, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    buf->data[8]++;
+    ck_assert_ptr_null(SOPC_AddressSpaceSnapshot_Decode(buf));
+    SOPC_Buffer_Delete(buf);
+
+    SOPC_AddressSpace_Delete(spaceSnapshot);
+    SOPC_AddressSpace_Delete(spaceDynamic);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_snapshot_address_space_results ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+START_TEST(test_parallel_address_space_results)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_parallel_address_space_results ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* spaceDynamic = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(spaceDynamic);
+    fclose(fd);
+
+    /* The test NodeSet already contains the reciprocal references: none shall be added */
+    SOPC_UANodeSet_ParseOptions options = {4, true};
+    SOPC_UANodeSet_ParseReport report;
+    SOPC_AddressSpace* spaceParallel = SOPC_UANodeSet_ParseFile(XML_UA_NODESET_NAME, &options, &report);
+    ck_assert_ptr_nonnull(spaceParallel);
+    ck_assert_uint_eq(4, report.nbThreads);
+    ck_assert_uint_gt(report.nbNodes, 0);
+    ck_assert_uint_eq(0, report.nbReciprocalRefs);
+
+    /* Check all data present in dynamic are present in parallel and reciprocally */
+    SOPC_AddressSpace* spaces[2] = {spaceDynamic, spaceParallel};
+    SOPC_AddressSpace_ForEach(spaceDynamic, addspace_for_each_equal, (uintptr_t) spaces);
+    SOPC_AddressSpace* spaces2[2] = {spaceParallel, spaceDynamic};
+    SOPC_AddressSpace_ForEach(spaceParallel, addspace_for_each_equal, (uintptr_t) spaces2);
+
+    SOPC_AddressSpace_Delete(spaceParallel);
+    SOPC_AddressSpace_Delete(spaceDynamic);
+
+    ck_assert_ptr_null(SOPC_UANodeSet_ParseFile("not_existing_nodeset.xml", NULL, NULL));
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_parallel_address_space_results ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+#if defined(WITH_EXPAT) && !defined(WITH_CONST_ADDSPACE)
+/* Returns the number of references of node ns=1;i=source with given type and direction to node target */
+static int32_t count_references(SOPC_AddressSpace* space,
+                                uint32_t source,
+                                uint32_t type,
+                                bool isInverse,
+                                uint16_t targetNs,
+                                uint32_t target)
+{
+    const SOPC_NodeId sourceId = {SOPC_IdentifierType_Numeric, 1, .Data.Numeric = source};
+    bool found = false;
+    SOPC_AddressSpace_Node* node = SOPC_AddressSpace_Get_Node(space, &sourceId, &found);
+    ck_assert(found);
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(space, node);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, node);
+    int32_t count = 0;
+
+    for (int32_t i = 0; i < nbRefs; i++)
+    {
+        const SOPC_NodeId* targetId = &refs[i].TargetId.NodeId;
+        if (refs[i].IsInverse == isInverse && SOPC_IdentifierType_Numeric == refs[i].ReferenceTypeId.IdentifierType &&
+            type == refs[i].ReferenceTypeId.Data.Numeric && SOPC_IdentifierType_Numeric == targetId->IdentifierType &&
+            targetNs == targetId->Namespace && target == targetId->Data.Numeric)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+#endif
+
+START_TEST(test_parallel_reciprocal_references)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_parallel_reciprocal_references ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    /* Each of the 4 parse jobs parses 2 nodes: the missing reciprocal references are between nodes of different jobs */
+    SOPC_UANodeSet_ParseOptions options = {4, true};
+    SOPC_UANodeSet_ParseReport report;
+    SOPC_AddressSpace* space = SOPC_UANodeSet_ParseFile(XML_RECIPROCAL_REFS_NODESET_NAME, &options, &report);
+    ck_assert_ptr_nonnull(space);
+    ck_assert_uint_eq(4, report.nbThreads);
+    ck_assert_uint_eq(8, report.nbNodes);
+    ck_assert_uint_eq(3, report.nbReciprocalRefs);
+
+    /* Added reciprocal references */
+    ck_assert_int_eq(1, count_references(space, 7, OpcUaId_HasComponent, true, 1, 1));
+    ck_assert_int_eq(1, count_references(space, 2, OpcUaId_Organizes, false, 1, 8));
+    ck_assert_int_eq(1, count_references(space, 6, OpcUaId_HasComponent, true, 1, 4));
+    /* Already defined in both directions or targeting a node not in the NodeSet: unchanged */
+    ck_assert_int_eq(1, count_references(space, 3, OpcUaId_HasProperty, false, 1, 5));
+    ck_assert_int_eq(1, count_references(space, 5, OpcUaId_HasProperty, true, 1, 3));
+    ck_assert_int_eq(1, count_references(space, 1, OpcUaId_Organizes, true, 0, OpcUaId_ObjectsFolder));
+    ck_assert_int_eq(2, count_references(space, 4, OpcUaId_HasComponent, false, 1, 6));
+
+    /* The same result is obtained with a single parse job */
+    options.nbThreads = 1;
+    SOPC_AddressSpace* spaceSingle = SOPC_UANodeSet_ParseFile(XML_RECIPROCAL_REFS_NODESET_NAME, &options, &report);
+    ck_assert_ptr_nonnull(spaceSingle);
+    ck_assert_uint_eq(1, report.nbThreads);
+    ck_assert_uint_eq(3, report.nbReciprocalRefs);
+    SOPC_AddressSpace* spaces[2] = {spaceSingle, space};
+    SOPC_AddressSpace_ForEach(spaceSingle, addspace_for_each_equal, (uintptr_t) spaces);
+
+    SOPC_AddressSpace_Delete(spaceSingle);
+    SOPC_AddressSpace_Delete(space);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_parallel_reciprocal_references ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+START_TEST(test_add_variable_node_parent_reference)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_add_variable_node_parent_reference ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    const SOPC_NodeId organizes = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Organizes};
+    const SOPC_NodeId newNodeId = {SOPC_IdentifierType_Numeric, 1, .Data.Numeric = 100000};
+
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* space = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(space);
+    fclose(fd);
+    SOPC_AddressSpaceAccess* access = SOPC_AddressSpaceAccess_Create(space, false);
+    ck_assert_ptr_nonnull(access);
+
+    SOPC_ExpandedNodeId parentId;
+    SOPC_ExpandedNodeId_Initialize(&parentId);
+    parentId.NodeId.Data.Numeric = OpcUaId_ObjectsFolder;
+    SOPC_ExpandedNodeId typeDefId;
+    SOPC_ExpandedNodeId_Initialize(&typeDefId);
+    typeDefId.NodeId.Data.Numeric = OpcUaId_BaseDataVariableType;
+    SOPC_QualifiedName browseName;
+    SOPC_QualifiedName_Initialize(&browseName);
+    browseName.NamespaceIndex = 1;
+    ck_assert_int_eq(SOPC_STATUS_OK, SOPC_String_CopyFromCString(&browseName.Name, "AddedVariable"));
+    OpcUa_VariableAttributes varAttributes;
+    OpcUa_VariableAttributes_Initialize(&varAttributes);
+
+    ck_assert_uint_eq(SOPC_GoodGenericStatus,
+                      SOPC_AddressSpaceAccess_AddVariableNode(access, &parentId, &organizes, &newNodeId, &browseName,
+                                                              &varAttributes, &typeDefId));
+
+    /* The inverse reference to the parent has the requested ReferenceType, not the TypeDefinition */
+    bool found = false;
+    SOPC_AddressSpace_Node* node = SOPC_AddressSpace_Get_Node(space, &newNodeId, &found);
+    ck_assert(found);
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(space, node);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, node);
+    int32_t nbParentRefs = 0;
+    for (int32_t i = 0; i < nbRefs; i++)
+    {
+        if (refs[i].IsInverse)
+        {
+            ck_assert(SOPC_NodeId_Equal(&organizes, &refs[i].ReferenceTypeId));
+            ck_assert(SOPC_NodeId_Equal(&parentId.NodeId, &refs[i].TargetId.NodeId));
+            nbParentRefs++;
+        }
+    }
+    ck_assert_int_eq(1, nbParentRefs);
+
+    SOPC_QualifiedName_Clear(&browseName);
+    SOPC_AddressSpaceAccess_Delete(&access);
+    SOPC_AddressSpace_Delete(space);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_add_variable_node_parent_reference ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+START_TEST(test_remove_last_ref_in_parent_node)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_remove_last_ref_in_parent_node ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    const SOPC_NodeId organizes = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Organizes};
+    const SOPC_NodeId parentId = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_ObjectsFolder};
+    const SOPC_NodeId childId = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Server_ServerStatus};
+
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* space = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(space);
+    fclose(fd);
+
+    bool found = false;
+    SOPC_AddressSpace_Node* parent = SOPC_AddressSpace_Get_Node(space, &parentId, &found);
+    ck_assert(found);
+    int32_t* nbRefs = SOPC_AddressSpace_Get_NoOfReferences(space, parent);
+    int32_t initialNbRefs = *nbRefs;
+
+    ck_assert_int_eq(SOPC_STATUS_OK,
+                     SOPC_NodeMgtHelperInternal_AddRefChildToParentNode(space, &parentId, &childId, &organizes));
+    ck_assert_int_eq(initialNbRefs + 1, *nbRefs);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, parent);
+    ck_assert(SOPC_NodeId_Equal(&organizes, &refs[initialNbRefs].ReferenceTypeId));
+    ck_assert(SOPC_NodeId_Equal(&childId, &refs[initialNbRefs].TargetId.NodeId));
+
+    /* The removed reference is the last one of the parent and it is cleared */
+    ck_assert(SOPC_NodeMgtHelperInternal_RemoveLastRefInParentNode(space, &parentId));
+    ck_assert_int_eq(initialNbRefs, *nbRefs);
+    ck_assert_ptr_eq(refs, *SOPC_AddressSpace_Get_References(space, parent));
+    ck_assert_uint_eq(0, refs[initialNbRefs].ReferenceTypeId.Data.Numeric);
+    ck_assert_uint_eq(0, refs[initialNbRefs].TargetId.NodeId.Data.Numeric);
+    for (int32_t i = 0; i < initialNbRefs; i++)
+    {
+        ck_assert(!SOPC_NodeId_Equal(&childId, &refs[i].TargetId.NodeId));
+    }
+
+    SOPC_AddressSpace_Delete(space);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_remove_last_ref_in_parent_node ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+#if defined(WITH_EXPAT) && !defined(WITH_CONST_ADDSPACE)
+static const SOPC_NodeId hierarchicalRefs = {SOPC_IdentifierType_Numeric, 0,
+                                             .Data.Numeric = OpcUaId_HierarchicalReferences};
+static const SOPC_NodeId objectsFolder = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_ObjectsFolder};
+
+static void collect_types(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    const SOPC_AddressSpace_Node* node = (const SOPC_AddressSpace_Node*) value;
+    SOPC_Array* types = (SOPC_Array*) user_data;
+    if (OpcUa_NodeClass_ObjectType == node->node_class || OpcUa_NodeClass_VariableType == node->node_class ||
+        OpcUa_NodeClass_DataType == node->node_class || OpcUa_NodeClass_ReferenceType == node->node_class)
+    {
+        const SOPC_NodeId* typeId = (const SOPC_NodeId*) key;
+        ck_assert(SOPC_Array_Append(types, typeId));
+    }
+}
+
+static const SOPC_NodeId organizesRef = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Organizes};
+static const SOPC_NodeId hasComponentRef = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_HasComponent};
+static const SOPC_NodeId hasTypeDefinitionRef = {SOPC_IdentifierType_Numeric, 0,
+                                                 .Data.Numeric = OpcUaId_HasTypeDefinition};
+static const SOPC_NodeId serverStatus = {SOPC_IdentifierType_Numeric, 0, .Data.Numeric = OpcUaId_Server_ServerStatus};
+
+static int compare_ref_indexes(const void* a, const void* b)
+{
+    return (*(const int32_t*) a > *(const int32_t*) b) - (*(const int32_t*) a < *(const int32_t*) b);
+}
+
+/* Checks the indexed references of the node are the ones found by iteration on the node references */
+static void check_index_references(SOPC_AddressSpace* space, SOPC_AddressSpace_Node* node)
+{
+    const SOPC_NodeId* refTypes[] = {&hierarchicalRefs, &organizesRef, &hasComponentRef, &hasTypeDefinitionRef};
+    SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(space);
+    ck_assert_ptr_nonnull(index);
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(space, node);
+    OpcUa_ReferenceNode* refs = *SOPC_AddressSpace_Get_References(space, node);
+
+    for (size_t t = 0; t < sizeof(refTypes) / sizeof(refTypes[0]); t++)
+    {
+        for (int includeSubtypes = 0; includeSubtypes < 2; includeSubtypes++)
+        {
+            for (int isForward = 0; isForward < 2; isForward++)
+            {
+                SOPC_Array* refIndexes = SOPC_Array_Create(sizeof(int32_t), 8, NULL);
+                ck_assert_ptr_nonnull(refIndexes);
+                ck_assert_int_eq(SOPC_STATUS_OK,
+                                 SOPC_AddressSpaceIndex_GetReferences(index, node, refTypes[t], 0 != includeSubtypes,
+                                                                      0 != isForward, refIndexes));
+                SOPC_Array_Sort(refIndexes, compare_ref_indexes);
+
+                size_t nbFound = 0;
+                for (int32_t i = 0; i < nbRefs; i++)
+                {
+                    bool match = (refs[i].IsInverse != (0 != isForward)) &&
+                                 (SOPC_NodeId_Equal(&refs[i].ReferenceTypeId, refTypes[t]) ||
+                                  (0 != includeSubtypes && SOPC_AddressSpaceUtil_RecursiveIsTransitiveSubtype(
+                                                               space, RECURSION_LIMIT, &refs[i].ReferenceTypeId,
+                                                               &refs[i].ReferenceTypeId, refTypes[t])));
+                    if (match)
+                    {
+                        ck_assert_uint_lt(nbFound, SOPC_Array_Size(refIndexes));
+                        ck_assert_int_eq(i, SOPC_Array_Get(refIndexes, int32_t, nbFound));
+                        nbFound++;
+                    }
+                }
+                ck_assert_uint_eq(nbFound, SOPC_Array_Size(refIndexes));
+                SOPC_Array_Delete(refIndexes);
+            }
+
+            /* Iterate with the next matching reference: forward, inverse and both directions */
+            for (int directions = 1; directions <= 3; directions++)
+            {
+                bool forward = 0 != (directions & 1);
+                bool inverse = 0 != (directions & 2);
+                int32_t next = -1;
+                for (int32_t i = 0; i <= nbRefs; i++)
+                {
+                    bool match = i < nbRefs && (refs[i].IsInverse ? inverse : forward) &&
+                                 (SOPC_NodeId_Equal(&refs[i].ReferenceTypeId, refTypes[t]) ||
+                                  (0 != includeSubtypes && SOPC_AddressSpaceUtil_RecursiveIsTransitiveSubtype(
+                                                               space, RECURSION_LIMIT, &refs[i].ReferenceTypeId,
+                                                               &refs[i].ReferenceTypeId, refTypes[t])));
+                    if (match || i == nbRefs)
+                    {
+                        ck_assert_int_eq(SOPC_STATUS_OK, SOPC_AddressSpaceIndex_GetNextReference(
+                                                             index, node, refTypes[t], 0 != includeSubtypes, forward,
+                                                             inverse, next + 1, &next));
+                        ck_assert_int_eq(i, next);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void check_index_node_references(const uintptr_t key, const uintptr_t value, uintptr_t user_data)
+{
+    SOPC_UNUSED_ARG(key);
+    SOPC_GCC_DIAGNOSTIC_IGNORE_CAST_CONST
+    check_index_references((SOPC_AddressSpace*) user_data, (SOPC_AddressSpace_Node*) value);
+    SOPC_GCC_DIAGNOSTIC_RESTORE
+}
+#endif
+
+START_TEST(test_address_space_index_results)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_address_space_index_results ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* space = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(space);
+    fclose(fd);
+
+    SOPC_Array* types = SOPC_Array_Create(sizeof(const SOPC_NodeId*), 64, NULL);
+    ck_assert_ptr_nonnull(types);
+    SOPC_AddressSpace_ForEach(space, collect_types, (uintptr_t) types);
+    size_t nbTypes = SOPC_Array_Size(types);
+    ck_assert_uint_gt(nbTypes, 0);
+
+    /* Evaluate the types hierarchy without index */
+    bool* expected = SOPC_Calloc(nbTypes * nbTypes, sizeof(bool));
+    ck_assert_ptr_nonnull(expected);
+    for (size_t i = 0; i < nbTypes; i++)
+    {
+        const SOPC_NodeId* type = SOPC_Array_Get(types, const SOPC_NodeId*, i);
+        for (size_t j = 0; j < nbTypes; j++)
+        {
+            expected[i * nbTypes + j] = SOPC_AddressSpaceUtil_RecursiveIsTransitiveSubtype(
+                space, RECURSION_LIMIT, type, type, SOPC_Array_Get(types, const SOPC_NodeId*, j));
+        }
+    }
+
+    ck_assert_ptr_null(SOPC_AddressSpace_Get_Index(space));
+    ck_assert_int_eq(SOPC_STATUS_OK, SOPC_AddressSpace_BuildIndex(space));
+    SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(space);
+    ck_assert_ptr_nonnull(index);
+
+    /* Check the types hierarchy of the index provides the same results */
+    for (size_t i = 0; i < nbTypes; i++)
+    {
+        for (size_t j = 0; j < nbTypes; j++)
+        {
+            bool isSubtype = false;
+            const SOPC_NodeId* type = SOPC_Array_Get(types, const SOPC_NodeId*, i);
+            const SOPC_NodeId* parentType = SOPC_Array_Get(types, const SOPC_NodeId*, j);
+            ck_assert(SOPC_AddressSpaceIndex_IsTransitiveSubtype(index, type, parentType, &isSubtype));
+            ck_assert(expected[i * nbTypes + j] == isSubtype);
+        }
+    }
+    SOPC_Free(expected);
+    SOPC_Array_Delete(types);
+
+    /* Check the indexed references of each node */
+    SOPC_AddressSpace_ForEach(space, check_index_node_references, (uintptr_t) space);
+
+    SOPC_AddressSpace_Delete(space);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_address_space_index_results ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
+START_TEST(test_address_space_index_update)
+{
+// Without EXPAT test cannot be done
+#ifdef WITH_EXPAT
+#ifdef WITH_CONST_ADDSPACE
+    printf("Test test_address_space_index_update ignored since WITH_CONST_ADDSPACE is set\n");
+#else
+    FILE* fd = fopen(XML_UA_NODESET_NAME, "r");
+    ck_assert_ptr_nonnull(fd);
+    SOPC_AddressSpace* space = SOPC_UANodeSet_Parse(fd);
+    ck_assert_ptr_nonnull(space);
+    fclose(fd);
+
+    ck_assert_int_eq(SOPC_STATUS_OK, SOPC_AddressSpace_BuildIndex(space));
+    SOPC_AddressSpaceAccess* access = SOPC_AddressSpaceAccess_Create(space, false);
+    ck_assert_ptr_nonnull(access);
+
+    bool found = false;
+    SOPC_AddressSpace_Node* parent = SOPC_AddressSpace_Get_Node(space, &objectsFolder, &found);
+    ck_assert(found);
+    SOPC_ExpandedNodeId parentId;
+    SOPC_ExpandedNodeId_Initialize(&parentId);
+    parentId.NodeId = objectsFolder;
+    SOPC_ExpandedNodeId typeDefId;
+    SOPC_ExpandedNodeId_Initialize(&typeDefId);
+    typeDefId.NodeId.Data.Numeric = OpcUaId_BaseDataVariableType;
+    OpcUa_VariableAttributes varAttributes;
+    OpcUa_VariableAttributes_Initialize(&varAttributes);
+
+    /* AddNode and AddReference */
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        SOPC_NodeId nodeId = {SOPC_IdentifierType_Numeric, 1, .Data.Numeric = 100000 + i};
+        SOPC_NodeId otherNodeId = {SOPC_IdentifierType_Numeric, 1, .Data.Numeric = 200000 + i};
+        char name[32];
+        snprintf(name, sizeof(name), "IndexedVariable_%" PRIu32, i);
+        SOPC_QualifiedName browseName;
+        SOPC_QualifiedName_Initialize(&browseName);
+        browseName.NamespaceIndex = 1;
+        ck_assert_int_eq(SOPC_STATUS_OK, SOPC_String_CopyFromCString(&browseName.Name, name));
+
+        ck_assert_uint_eq(SOPC_GoodGenericStatus,
+                          SOPC_AddressSpaceAccess_AddVariableNode(access, &parentId, &organizesRef, &nodeId,
+                                                                  &browseName, &varAttributes, &typeDefId));
+        // The index is maintained and not dropped
+        SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(space);
+        ck_assert_ptr_nonnull(index);
+        SOPC_AddressSpace_Node* child = SOPC_AddressSpace_Get_Node(space, &nodeId, &found);
+        ck_assert(found);
+        check_index_references(space, child);
+        check_index_references(space, parent);
+
+        // A duplicated BrowseName is rejected
+        ck_assert_uint_eq(OpcUa_BadBrowseNameDuplicated,
+                          SOPC_AddressSpaceAccess_AddVariableNode(access, &parentId, &organizesRef, &otherNodeId,
+                                                                  &browseName, &varAttributes, &typeDefId));
+        SOPC_QualifiedName_Clear(&browseName);
+    }
+
+    /* RemoveLastReference: rollback of a reference added to the parent */
+    SOPC_AddressSpaceIndex* index = SOPC_AddressSpace_Get_Index(space);
+    int32_t nbRefs = *SOPC_AddressSpace_Get_NoOfReferences(space, parent);
+
+    ck_assert_int_eq(SOPC_STATUS_OK, SOPC_NodeMgtHelperInternal_AddRefChildToParentNode(space, &objectsFolder,
+                                                                                        &serverStatus, &organizesRef));
+    ck_assert_int_eq(nbRefs + 1, *SOPC_AddressSpace_Get_NoOfReferences(space, parent));
+    ck_assert_ptr_eq(index, SOPC_AddressSpace_Get_Index(space));
+    check_index_references(space, parent);
+
+    ck_assert(SOPC_NodeMgtHelperInternal_RemoveLastRefInParentNode(space, &objectsFolder));
+    ck_assert_int_eq(nbRefs, *SOPC_AddressSpace_Get_NoOfReferences(space, parent));
+    index = SOPC_AddressSpace_Get_Index(space);
+    ck_assert_ptr_nonnull(index);
+    check_index_references(space, parent);
+
+    SOPC_AddressSpaceAccess_Delete(&access);
+    SOPC_AddressSpace_Delete(space);
+#endif // WITH_CONST_ADDSPACE
+#else
+    printf("Test test_address_space_index_update ignored since EXPAT is not available\n");
+#endif // WITH_EXPAT
+}
+END_TEST
+
 const char* expectedNamespaces[3] = {"urn:S2OPC:MY_SERVER_HOST", "urn:S2OPC:MY_SERVER_HOST:2", NULL};
 const char* serverExpectedLocales[4] = {"en", "es-ES", "fr-FR", NULL};
 const char* clientExpectedLocales[3] = {"en-US", "fr-FR", NULL};
@@ -1181,6 +1768,13 @@ Suite* tests_make_suite_XML_parsers(void)
     tcase_set_timeout(tc_XML_parsers, 10);
     tcase_add_checked_fixture(tc_XML_parsers, setup, NULL);
     tcase_add_test(tc_XML_parsers, test_same_address_space_results);
+    tcase_add_test(tc_XML_parsers, test_snapshot_address_space_results);
+    tcase_add_test(tc_XML_parsers, test_parallel_address_space_results);
+    tcase_add_test(tc_XML_parsers, test_parallel_reciprocal_references);
+    tcase_add_test(tc_XML_parsers, test_add_variable_node_parent_reference);
+    tcase_add_test(tc_XML_parsers, test_remove_last_ref_in_parent_node);
+    tcase_add_test(tc_XML_parsers, test_address_space_index_results);
+    tcase_add_test(tc_XML_parsers, test_address_space_index_update);
     tcase_add_test(tc_XML_parsers, test_XML_config_configuration);
     tcase_add_test(tc_XML_parsers, test_XML_users_configuration);
     suite_add_tcase(s, tc_XML_parsers);
@@ -0,0 +1,420 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** \file
+ *
+ * \brief Cryptographic test suite. This suite tests the symmetric signature and encryption of batches of chunks
+ *        for the client-server security policies, also when they are shared between the secure channels crypto
+ *        workers, and reports their throughput.
+ *
+ * See check_stack.c for more details.
+ */
+
+#include <check.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "check_helpers.h"
+#include "sopc_chunks_crypto_workers.h"
+#include "sopc_crypto_decl.h"
+#include "sopc_crypto_profiles.h"
+#include "sopc_crypto_provider.h"
+#include "sopc_crypto_provider_lib_itf.h"
+#include "sopc_mem_alloc.h"
+#include "sopc_platform_time.h"
+#include "sopc_secret_buffer.h"
+#include "sopc_toolkit_config_constants.h"
+
+#define NB_CHANNELS 3
+#define NB_CHUNKS_PER_CHANNEL 4
+#define NB_JOBS (NB_CHANNELS * NB_CHUNKS_PER_CHANNEL)
+/* Chunk header which is signed but not encrypted */
+#define CHUNK_HEADER_LENGTH 24
+/* Encrypted part of the chunk, which contains the signature */
+#define CHUNK_ENCRYPTED_LENGTH 8176
+#define CHUNK_LENGTH (CHUNK_HEADER_LENGTH + CHUNK_ENCRYPTED_LENGTH)
+/* Amount of data signed and encrypted by each path of the benchmark */
+#define BENCH_BYTES (2 * 1024 * 1024)
+/* Size of the response message signed and encrypted by the crypto workers benchmark */
+#define BENCH_MSG_BYTES (10 * 1024 * 1024)
+
+static const char* policyUris[] = {SOPC_SecurityPolicy_Basic256Sha256_URI, SOPC_SecurityPolicy_Basic256_URI,
+                                   SOPC_SecurityPolicy_Aes128Sha256RsaOaep_URI,
+                                   SOPC_SecurityPolicy_Aes256Sha256RsaPss_URI};
+
+typedef struct
+{
+    SOPC_CryptoProvider* pProvider;
+    SOPC_SecretBuffer* pSignKey;
+    SOPC_SecretBuffer* pEncryptKey;
+    SOPC_SecretBuffer* pIV;
+    uint32_t lenSig;
+} Channel;
+
+static SOPC_SecretBuffer* new_random_secret(const SOPC_CryptoProvider* pProvider, uint32_t len)
+{
+    SOPC_ExposedBuffer* pExp = NULL;
+    ck_assert(SOPC_CryptoProvider_GenerateRandomBytes(pProvider, len, &pExp) == SOPC_STATUS_OK);
+    SOPC_SecretBuffer* pSecret = SOPC_SecretBuffer_NewFromExposedBuffer(pExp, len);
+    ck_assert_ptr_nonnull(pSecret);
+    SOPC_Free(pExp);
+    return pSecret;
+}
+
+static void channel_init(Channel* pChannel, const char* uri)
+{
+    uint32_t lenKey = 0;
+    uint32_t lenBlock = 0;
+
+    pChannel->pProvider = SOPC_CryptoProvider_Create(uri);
+    ck_assert_ptr_nonnull(pChannel->pProvider);
+    ck_assert(SOPC_CryptoProvider_SymmetricGetLength_SignKey(pChannel->pProvider, &lenKey) == SOPC_STATUS_OK);
+    pChannel->pSignKey = new_random_secret(pChannel->pProvider, lenKey);
+    ck_assert(SOPC_CryptoProvider_SymmetricGetLength_CryptoKey(pChannel->pProvider, &lenKey) == SOPC_STATUS_OK);
+    pChannel->pEncryptKey = new_random_secret(pChannel->pProvider, lenKey);
+    ck_assert(SOPC_CryptoProvider_SymmetricGetLength_Blocks(pChannel->pProvider, &lenBlock, NULL) == SOPC_STATUS_OK);
+    pChannel->pIV = new_random_secret(pChannel->pProvider, lenBlock);
+    ck_assert(SOPC_CryptoProvider_SymmetricGetLength_Signature(pChannel->pProvider, &pChannel->lenSig) ==
+              SOPC_STATUS_OK);
+}
+
+static void channel_clear(Channel* pChannel)
+{
+    SOPC_SecretBuffer_DeleteClear(pChannel->pSignKey);
+    SOPC_SecretBuffer_DeleteClear(pChannel->pEncryptKey);
+    SOPC_SecretBuffer_DeleteClear(pChannel->pIV);
+    SOPC_CryptoProvider_Free(pChannel->pProvider);
+    memset(pChannel, 0, sizeof(*pChannel));
+}
+
+/* The chunk is encrypted in place, after its header */
+static void job_init(SOPC_CryptoProvider_SymmetricJob* pJob, const Channel* pChannel, uint8_t* pChunk, bool encrypt)
+{
+    memset(pJob, 0, sizeof(*pJob));
+    pJob->pProvider = pChannel->pProvider;
+    pJob->pSignKey = pChannel->pSignKey;
+    pJob->pData = pChunk;
+    pJob->lenToSign = CHUNK_LENGTH - pChannel->lenSig;
+    if (encrypt)
+    {
+        pJob->pEncryptKey = pChannel->pEncryptKey;
+        pJob->pIV = pChannel->pIV;
+        pJob->offsetToEncrypt = CHUNK_HEADER_LENGTH;
+        pJob->pOutput = pChunk + CHUNK_HEADER_LENGTH;
+        pJob->lenOutput = CHUNK_ENCRYPTED_LENGTH;
+    }
+}
+
+/* Reference result, with the single chunk functions */
+static void sign_encrypt_chunk(const Channel* pChannel, uint8_t* pChunk, bool encrypt)
+{
+    const uint32_t lenToSign = CHUNK_LENGTH - pChannel->lenSig;
+    ck_assert(SOPC_CryptoProvider_SymmetricSign(pChannel->pProvider, pChunk, lenToSign, pChannel->pSignKey,
+                                                pChunk + lenToSign, pChannel->lenSig) == SOPC_STATUS_OK);
+    if (encrypt)
+    {
+        uint8_t* pEncrypted = pChunk + CHUNK_HEADER_LENGTH;
+        ck_assert(SOPC_CryptoProvider_SymmetricEncrypt(pChannel->pProvider, pEncrypted, CHUNK_ENCRYPTED_LENGTH,
+                                                       pChannel->pEncryptKey, pChannel->pIV, pEncrypted,
+                                                       CHUNK_ENCRYPTED_LENGTH) == SOPC_STATUS_OK);
+    }
+}
+
+START_TEST(test_crypto_symm_batch_results)
+{
+    const char* uri = policyUris[_i];
+    Channel channels[NB_CHANNELS];
+    SOPC_CryptoProvider_SymmetricJob jobs[NB_JOBS];
+    uint8_t* pChunks = SOPC_Calloc(NB_JOBS, CHUNK_LENGTH);
+    uint8_t* pExpected = SOPC_Calloc(NB_JOBS, CHUNK_LENGTH);
+    ck_assert_ptr_nonnull(pChunks);
+    ck_assert_ptr_nonnull(pExpected);
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_init(&channels[i], uri);
+    }
+    for (uint32_t i = 0; i < NB_JOBS * CHUNK_LENGTH; i++)
+    {
+        pChunks[i] = (uint8_t)(i * 7 + 3);
+    }
+    memcpy(pExpected, pChunks, NB_JOBS * CHUNK_LENGTH);
+
+    // Chunks of the channels are interleaved, and the last chunk of each channel is only signed
+    for (uint32_t i = 0; i < NB_JOBS; i++)
+    {
+        const Channel* pChannel = &channels[i % NB_CHANNELS];
+        const bool encrypt = i < NB_JOBS - NB_CHANNELS;
+        job_init(&jobs[i], pChannel, pChunks + i * CHUNK_LENGTH, encrypt);
+        sign_encrypt_chunk(pChannel, pExpected + i * CHUNK_LENGTH, encrypt);
+    }
+
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, NB_JOBS) == SOPC_STATUS_OK);
+    for (uint32_t i = 0; i < NB_JOBS; i++)
+    {
+        ck_assert(SOPC_STATUS_OK == jobs[i].status);
+    }
+    ck_assert(memcmp(pChunks, pExpected, NB_JOBS * CHUNK_LENGTH) == 0);
+
+    // An invalid job does not prevent the others to be treated
+    memcpy(pChunks, pExpected, CHUNK_LENGTH);
+    job_init(&jobs[0], &channels[0], pChunks, true);
+    job_init(&jobs[1], &channels[1], pChunks + CHUNK_LENGTH, true);
+    jobs[1].lenOutput -= 1;
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, 2) == SOPC_STATUS_INVALID_PARAMETERS);
+    ck_assert(SOPC_STATUS_OK == jobs[0].status);
+    ck_assert(SOPC_STATUS_INVALID_PARAMETERS == jobs[1].status);
+
+    // Check invalid parameters
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(NULL, 1) == SOPC_STATUS_INVALID_PARAMETERS);
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, 0) == SOPC_STATUS_INVALID_PARAMETERS);
+    job_init(&jobs[0], &channels[0], pChunks, true);
+    jobs[0].pIV = NULL;
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, 1) == SOPC_STATUS_INVALID_PARAMETERS);
+    job_init(&jobs[0], &channels[0], pChunks, true);
+    jobs[0].offsetToEncrypt += 1;
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, 1) == SOPC_STATUS_INVALID_PARAMETERS);
+    job_init(&jobs[0], &channels[0], pChunks, false);
+    jobs[0].pSignKey = channels[0].pIV;
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(jobs, 1) == SOPC_STATUS_INVALID_PARAMETERS);
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_clear(&channels[i]);
+    }
+    SOPC_Free(pChunks);
+    SOPC_Free(pExpected);
+}
+END_TEST
+
+START_TEST(test_crypto_symm_batch_workers)
+{
+    const char* uri = policyUris[_i];
+    Channel channels[NB_CHANNELS];
+    SOPC_CryptoProvider_SymmetricJob jobs[NB_JOBS];
+    uint8_t* pChunks = SOPC_Calloc(NB_JOBS, CHUNK_LENGTH);
+    uint8_t* pExpected = SOPC_Calloc(NB_JOBS, CHUNK_LENGTH);
+    ck_assert_ptr_nonnull(pChunks);
+    ck_assert_ptr_nonnull(pExpected);
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_init(&channels[i], uri);
+    }
+    for (uint32_t i = 0; i < NB_JOBS * CHUNK_LENGTH; i++)
+    {
+        pChunks[i] = (uint8_t)(i * 5 + 1);
+    }
+    memcpy(pExpected, pChunks, NB_JOBS * CHUNK_LENGTH);
+
+    for (uint32_t i = 0; i < NB_JOBS; i++)
+    {
+        const Channel* pChannel = &channels[i % NB_CHANNELS];
+        const bool encrypt = i < NB_JOBS - NB_CHANNELS;
+        job_init(&jobs[i], pChannel, pChunks + i * CHUNK_LENGTH, encrypt);
+        sign_encrypt_chunk(pChannel, pExpected + i * CHUNK_LENGTH, encrypt);
+    }
+
+    ck_assert(SOPC_ChunksCryptoWorkers_Initialize() == SOPC_STATUS_OK);
+
+    // Each slice of jobs is treated by a worker or by the calling thread, with the same results as one batch
+    ck_assert(SOPC_ChunksCryptoWorkers_SignEncrypt(jobs, NB_JOBS) == SOPC_STATUS_OK);
+    for (uint32_t i = 0; i < NB_JOBS; i++)
+    {
+        ck_assert(SOPC_STATUS_OK == jobs[i].status);
+    }
+    ck_assert(memcmp(pChunks, pExpected, NB_JOBS * CHUNK_LENGTH) == 0);
+
+    // The failure of a job, whichever slice it is in, is reported
+    for (uint32_t i = 0; i < NB_JOBS; i++)
+    {
+        job_init(&jobs[i], &channels[i % NB_CHANNELS], pChunks + i * CHUNK_LENGTH, true);
+    }
+    jobs[NB_JOBS - 1].lenOutput -= 1;
+    ck_assert(SOPC_ChunksCryptoWorkers_SignEncrypt(jobs, NB_JOBS) == SOPC_STATUS_INVALID_PARAMETERS);
+    ck_assert(SOPC_STATUS_OK == jobs[0].status);
+    ck_assert(SOPC_STATUS_INVALID_PARAMETERS == jobs[NB_JOBS - 1].status);
+
+    // Check invalid parameters
+    ck_assert(SOPC_ChunksCryptoWorkers_SignEncrypt(NULL, 1) == SOPC_STATUS_INVALID_PARAMETERS);
+    ck_assert(SOPC_ChunksCryptoWorkers_SignEncrypt(jobs, 0) == SOPC_STATUS_INVALID_PARAMETERS);
+
+    SOPC_ChunksCryptoWorkers_Clear();
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_clear(&channels[i]);
+    }
+    SOPC_Free(pChunks);
+    SOPC_Free(pExpected);
+}
+END_TEST
+
+static double throughput(const SOPC_RealTime* pStart, const SOPC_RealTime* pEnd, uint32_t nbBytes)
+{
+    int64_t elapsedUs = SOPC_RealTime_DeltaUs(pStart, pEnd);
+    if (elapsedUs <= 0)
+    {
+        elapsedUs = 1;
+    }
+    return (double) nbBytes / (double) elapsedUs; // Bytes per microsecond are MB per second
+}
+
+START_TEST(test_crypto_symm_batch_bench)
+{
+    const char* uri = policyUris[_i];
+    const uint32_t nbChunks = BENCH_BYTES / CHUNK_LENGTH;
+    Channel channels[NB_CHANNELS];
+    SOPC_CryptoProvider_SymmetricJob* pJobs = SOPC_Calloc(nbChunks, sizeof(SOPC_CryptoProvider_SymmetricJob));
+    uint8_t* pChunks = SOPC_Calloc(nbChunks, CHUNK_LENGTH);
+    SOPC_RealTime* pStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* pEnd = SOPC_RealTime_Create(NULL);
+    ck_assert_ptr_nonnull(pJobs);
+    ck_assert_ptr_nonnull(pChunks);
+    ck_assert_ptr_nonnull(pStart);
+    ck_assert_ptr_nonnull(pEnd);
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_init(&channels[i], uri);
+    }
+
+    // Chunk by chunk
+    ck_assert(SOPC_RealTime_GetTime(pStart));
+    for (uint32_t i = 0; i < nbChunks; i++)
+    {
+        sign_encrypt_chunk(&channels[i % NB_CHANNELS], pChunks + i * CHUNK_LENGTH, true);
+    }
+    ck_assert(SOPC_RealTime_GetTime(pEnd));
+    const double single = throughput(pStart, pEnd, nbChunks * CHUNK_LENGTH);
+
+    // By batch, each channel giving its chunks in a row
+    for (uint32_t i = 0; i < nbChunks; i++)
+    {
+        const uint32_t iChannel = (uint32_t)(((uint64_t) i * NB_CHANNELS) / nbChunks);
+        job_init(&pJobs[i], &channels[iChannel], pChunks + i * CHUNK_LENGTH, true);
+    }
+    ck_assert(SOPC_RealTime_GetTime(pStart));
+    ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(pJobs, nbChunks) == SOPC_STATUS_OK);
+    ck_assert(SOPC_RealTime_GetTime(pEnd));
+    const double batch = throughput(pStart, pEnd, nbChunks * CHUNK_LENGTH);
+
+    printf("%s sign and encrypt: %.1f MB/s chunk by chunk, %.1f MB/s by batch (AES instructions: %s)\n",
+           SOPC_CryptoProfile_Get(uri)->name, single, batch,
+           SOPC_CryptoProvider_SymmetricIsHardwareAccelerated() ? "yes" : "no");
+
+    for (uint32_t i = 0; i < NB_CHANNELS; i++)
+    {
+        channel_clear(&channels[i]);
+    }
+    SOPC_RealTime_Delete(&pStart);
+    SOPC_RealTime_Delete(&pEnd);
+    SOPC_Free(pJobs);
+    SOPC_Free(pChunks);
+}
+END_TEST
+
+/* A response of BENCH_MSG_BYTES on a SignAndEncrypt secure channel, signed and encrypted by windows of chunks */
+START_TEST(test_crypto_symm_batch_bench_workers)
+{
+    const char* uri = policyUris[_i];
+    const uint32_t nbChunks = BENCH_MSG_BYTES / CHUNK_LENGTH + (0 != BENCH_MSG_BYTES % CHUNK_LENGTH ? 1 : 0);
+    Channel channel;
+    SOPC_CryptoProvider_SymmetricJob* pJobs = SOPC_Calloc(nbChunks, sizeof(SOPC_CryptoProvider_SymmetricJob));
+    uint8_t* pChunks = SOPC_Calloc(nbChunks, CHUNK_LENGTH);
+    SOPC_RealTime* pStart = SOPC_RealTime_Create(NULL);
+    SOPC_RealTime* pEnd = SOPC_RealTime_Create(NULL);
+    ck_assert_ptr_nonnull(pJobs);
+    ck_assert_ptr_nonnull(pChunks);
+    ck_assert_ptr_nonnull(pStart);
+    ck_assert_ptr_nonnull(pEnd);
+
+    channel_init(&channel, uri);
+    for (uint32_t i = 0; i < nbChunks; i++)
+    {
+        job_init(&pJobs[i], &channel, pChunks + i * CHUNK_LENGTH, true);
+    }
+
+    // Chunk by chunk on the calling thread
+    ck_assert(SOPC_RealTime_GetTime(pStart));
+    for (uint32_t i = 0; i < nbChunks; i++)
+    {
+        sign_encrypt_chunk(&channel, pChunks + i * CHUNK_LENGTH, true);
+    }
+    ck_assert(SOPC_RealTime_GetTime(pEnd));
+    const double single = throughput(pStart, pEnd, nbChunks * CHUNK_LENGTH);
+
+    // By windows of chunks on the calling thread only, to separate the gain of the workers from the batch one
+    ck_assert(SOPC_RealTime_GetTime(pStart));
+    for (uint32_t i = 0; i < nbChunks; i += SOPC_SC_CRYPTO_CHUNKS_WINDOW)
+    {
+        const uint32_t nbWindowChunks =
+            nbChunks - i < SOPC_SC_CRYPTO_CHUNKS_WINDOW ? nbChunks - i : SOPC_SC_CRYPTO_CHUNKS_WINDOW;
+        ck_assert(SOPC_CryptoProvider_SymmetricSignEncryptBatch(&pJobs[i], nbWindowChunks) == SOPC_STATUS_OK);
+    }
+    ck_assert(SOPC_RealTime_GetTime(pEnd));
+    const double batch = throughput(pStart, pEnd, nbChunks * CHUNK_LENGTH);
+
+    // By windows of chunks shared with the crypto workers, as the chunks manager does
+    ck_assert(SOPC_ChunksCryptoWorkers_Initialize() == SOPC_STATUS_OK);
+    ck_assert(SOPC_RealTime_GetTime(pStart));
+    for (uint32_t i = 0; i < nbChunks; i += SOPC_SC_CRYPTO_CHUNKS_WINDOW)
+    {
+        const uint32_t nbWindowChunks =
+            nbChunks - i < SOPC_SC_CRYPTO_CHUNKS_WINDOW ? nbChunks - i : SOPC_SC_CRYPTO_CHUNKS_WINDOW;
+        ck_assert(SOPC_ChunksCryptoWorkers_SignEncrypt(&pJobs[i], nbWindowChunks) == SOPC_STATUS_OK);
+    }
+    ck_assert(SOPC_RealTime_GetTime(pEnd));
+    const double workers = throughput(pStart, pEnd, nbChunks * CHUNK_LENGTH);
+    SOPC_ChunksCryptoWorkers_Clear();
+
+    printf("%s sign and encrypt %d MB response: %.1f MB/s chunk by chunk, %.1f MB/s by windows, "
+           "%.1f MB/s by windows with %d crypto workers\n",
+           SOPC_CryptoProfile_Get(uri)->name, BENCH_MSG_BYTES / (1024 * 1024), single, batch, workers,
+           SOPC_SC_CRYPTO_WORKERS);
+
+    channel_clear(&channel);
+    SOPC_RealTime_Delete(&pStart);
+    SOPC_RealTime_Delete(&pEnd);
+    SOPC_Free(pJobs);
+    SOPC_Free(pChunks);
+}
+END_TEST
+
+Suite* tests_make_suite_crypto_symm_batch(void)
+{
+    Suite* s = NULL;
+    TCase *tc_batch = NULL, *tc_bench = NULL;
+    const int nbPolicies = (int)(sizeof(policyUris) / sizeof(policyUris[0]));
+
+    s = suite_create("Crypto tests symmetric batches");
+    tc_batch = tcase_create("Symmetric batches");
+    tc_bench = tcase_create("Symmetric throughput");
+
+    suite_add_tcase(s, tc_batch);
+    tcase_add_loop_test(tc_batch, test_crypto_symm_batch_results, 0, nbPolicies);
+    tcase_add_loop_test(tc_batch, test_crypto_symm_batch_workers, 0, nbPolicies);
+
+    suite_add_tcase(s, tc_bench);
+    tcase_add_loop_test(tc_bench, test_crypto_symm_batch_bench, 0, nbPolicies);
+    tcase_add_loop_test(tc_bench, test_crypto_symm_batch_bench_workers, 0, nbPolicies);
+    tcase_set_timeout(tc_bench, 30);
+
+    return s;
+}
@@ -62,6 +62,7 @@ int main(void)
     srunner_add_suite(sr, tests_make_suite_crypto_B256());
     srunner_add_suite(sr, tests_make_suite_crypto_None());
     srunner_add_suite(sr, tests_make_suite_crypto_PubSub256());
+    srunner_add_suite(sr, tests_make_suite_crypto_symm_batch());
     srunner_add_suite(sr, tests_make_suite_crypto_tools());
     srunner_add_suite(sr, tests_make_suite_hash_based_crypto());
     srunner_add_suite(sr, tests_make_suite_pki());
@@ -74,6 +75,7 @@ int main(void)
     srunner_add_suite(sr, tests_make_suite_logger());
     srunner_add_suite(sr, tests_make_suite_dict(sr));
     srunner_add_suite(sr, tests_make_suite_array());
+    srunner_add_suite(sr, tests_make_suite_monitored_item_handles());
     srunner_add_suite(sr, tests_make_suite_event_handler());
     srunner_add_suite(sr, tests_make_suite_numeric_range());
     srunner_add_suite(sr, tests_make_suite_users());
@@ -39,6 +39,7 @@ Suite* tests_make_suite_crypto_B256S256(void);
 Suite* tests_make_suite_crypto_B256(void);
 Suite* tests_make_suite_crypto_None(void);
 Suite* tests_make_suite_crypto_PubSub256(void);
+Suite* tests_make_suite_crypto_symm_batch(void);
 Suite* tests_make_suite_crypto_tools(void);
 Suite* tests_make_suite_hash_based_crypto(void);
 Suite* tests_make_suite_pki(void);
@@ -60,6 +61,8 @@ Suite* tests_make_suite_dict(SRunner* sr);
 
 Suite* tests_make_suite_array(void);
 
+Suite* tests_make_suite_monitored_item_handles(void);
+
 Suite* tests_make_suite_event_handler(void);
 
 Suite* tests_make_suite_numeric_range(void);
@@ -0,0 +1,163 @@
+/*
+ * Licensed to Systerel under one or more contributor license
+ * agreements. See the NOTICE file distributed with this work
+ * for additional information regarding copyright ownership.
+ * Systerel licenses this file to you under the Apache
+ * License, Version 2.0 (the "License"); you may not use this
+ * file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "check_helpers.h"
+
+#include <check.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "monitored_item_handles.h"
+#include "sopc_mem_alloc.h"
+
+#define HANDLE(generation, slotIdx) ((uint32_t)(((generation) << MONIT_HANDLE_INDEX_BITS) | ((slotIdx) + 1)))
+
+START_TEST(test_monit_handles_new_get)
+{
+    SOPC_MonItHandles* handles = SOPC_MonItHandles_Create();
+    ck_assert_ptr_nonnull(handles);
+
+    // Handles of new slots have generation 0
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        ck_assert_uint_eq(HANDLE(0, i), SOPC_MonItHandles_New(handles, 100 + i, NULL));
+    }
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        SOPC_MonItHandles_Ctx* ctx = SOPC_MonItHandles_Get(handles, HANDLE(0, i));
+        ck_assert_ptr_nonnull(ctx);
+        ck_assert_uint_eq(100 + i, ctx->userAppCtx);
+    }
+
+    // 0, unknown slots and wrong generations are rejected
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, 0));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, HANDLE(0, 10)));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, MONIT_HANDLE_INDEX_MASK));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, HANDLE(1, 0)));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, HANDLE(MONIT_HANDLE_GENERATION_MASK, 5)));
+
+    SOPC_MonItHandles_Delete(handles);
+}
+END_TEST
+
+START_TEST(test_monit_handles_reuse_stale)
+{
+    SOPC_MonItHandles* handles = SOPC_MonItHandles_Create();
+    ck_assert_ptr_nonnull(handles);
+
+    const uint32_t first = SOPC_MonItHandles_New(handles, 1, NULL);
+    const uint32_t second = SOPC_MonItHandles_New(handles, 2, NULL);
+    ck_assert_uint_eq(HANDLE(0, 0), first);
+    ck_assert_uint_eq(HANDLE(0, 1), second);
+
+    // The released slot is reused with the next generation
+    SOPC_MonItHandles_Release(handles, first);
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, first));
+    const uint32_t reused = SOPC_MonItHandles_New(handles, 3, NULL);
+    ck_assert_uint_eq(HANDLE(1, 0), reused);
+
+    // The stale handle is rejected and does not give access to the monitored item reusing its slot
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, first));
+    SOPC_MonItHandles_Ctx* ctx = SOPC_MonItHandles_Get(handles, reused);
+    ck_assert_ptr_nonnull(ctx);
+    ck_assert_uint_eq(3, ctx->userAppCtx);
+
+    // Releasing the stale handle again has no effect on the new monitored item
+    SOPC_MonItHandles_Release(handles, first);
+    ctx = SOPC_MonItHandles_Get(handles, reused);
+    ck_assert_ptr_nonnull(ctx);
+    ck_assert_uint_eq(3, ctx->userAppCtx);
+    ck_assert_uint_eq(HANDLE(0, 2), SOPC_MonItHandles_New(handles, 4, NULL));
+
+    // Last released slot is reused first
+    SOPC_MonItHandles_Release(handles, second);
+    SOPC_MonItHandles_Release(handles, reused);
+    ck_assert_uint_eq(HANDLE(2, 0), SOPC_MonItHandles_New(handles, 5, NULL));
+    ck_assert_uint_eq(HANDLE(1, 1), SOPC_MonItHandles_New(handles, 6, NULL));
+    ck_assert_uint_eq(HANDLE(0, 3), SOPC_MonItHandles_New(handles, 7, NULL));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, second));
+    ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, reused));
+
+    SOPC_MonItHandles_Delete(handles);
+}
+END_TEST
+
+START_TEST(test_monit_handles_generation_wrap)
+{
+    SOPC_MonItHandles* handles = SOPC_MonItHandles_Create();
+    ck_assert_ptr_nonnull(handles);
+
+    // The generation is 8 bits: a slot gives 256 distinct handles before its first handle is reused
+    uint32_t handle = SOPC_MonItHandles_New(handles, 0, NULL);
+    ck_assert_uint_eq(HANDLE(0, 0), handle);
+    for (uint32_t generation = 1; generation <= MONIT_HANDLE_GENERATION_MASK; generation++)
+    {
+        SOPC_MonItHandles_Release(handles, handle);
+        handle = SOPC_MonItHandles_New(handles, generation, NULL);
+        ck_assert_uint_eq(HANDLE(generation, 0), handle);
+        ck_assert_ptr_null(SOPC_MonItHandles_Get(handles, HANDLE(generation - 1, 0)));
+    }
+    SOPC_MonItHandles_Release(handles, handle);
+    ck_assert_uint_eq(HANDLE(0, 0), SOPC_MonItHandles_New(handles, 0, NULL));
+
+    SOPC_MonItHandles_Delete(handles);
+}
+END_TEST
+
+START_TEST(test_monit_handles_node_id)
+{
+    SOPC_MonItHandles* handles = SOPC_MonItHandles_Create();
+    ck_assert_ptr_nonnull(handles);
+
+    // The nodeIds are owned by the contexts: freed on release or on deletion
+    char* nodeId = SOPC_Calloc(strlen("ns=1;i=1") + 1, sizeof(char));
+    ck_assert_ptr_nonnull(nodeId);
+    strcpy(nodeId, "ns=1;i=1");
+    const uint32_t released = SOPC_MonItHandles_New(handles, 0, nodeId);
+    ck_assert_ptr_eq(nodeId, SOPC_MonItHandles_Get(handles, released)->nodeId);
+    SOPC_MonItHandles_Release(handles, released);
+
+    nodeId = SOPC_Calloc(strlen("ns=1;i=2") + 1, sizeof(char));
+    ck_assert_ptr_nonnull(nodeId);
+    strcpy(nodeId, "ns=1;i=2");
+    const uint32_t kept = SOPC_MonItHandles_New(handles, 0, nodeId);
+    SOPC_MonItHandles_Ctx* ctx = SOPC_MonItHandles_Get(handles, kept);
+    ck_assert_ptr_nonnull(ctx);
+    ck_assert_str_eq("ns=1;i=2", ctx->nodeId);
+
+    SOPC_MonItHandles_Delete(handles);
+}
+END_TEST
+
+Suite* tests_make_suite_monitored_item_handles(void)
+{
+    Suite* s;
+    TCase* tc_handles;
+
+    s = suite_create("Monitored item handles tests");
+    tc_handles = tcase_create("Monitored item handles");
+
+    tcase_add_test(tc_handles, test_monit_handles_new_get);
+    tcase_add_test(tc_handles, test_monit_handles_reuse_stale);
+    tcase_add_test(tc_handles, test_monit_handles_generation_wrap);
+    tcase_add_test(tc_handles, test_monit_handles_node_id);
+    suite_add_tcase(s, tc_handles);
+
+    return s;
+}
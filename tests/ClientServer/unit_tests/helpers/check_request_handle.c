@@ -95,29 +95,42 @@ START_TEST(test_request_handle_bs)
     // Remove the first 2
     request_handle_bs__client_remove_req_handle(remove_req_handles[0]);
     request_handle_bs__client_remove_req_handle(remove_req_handles[1]);
+    request_handle_bs__client_remove_req_handle(remove_req_handles[0]);
 
     request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
                                                constants__e_msg_session_create_resp, false, 0, &req_handle);
     // request handle matches expected (implem dependent):
-    //  due to circular behavior 2 is first after SOPC_MAX_PENDING_REQUESTS
-    ck_assert_int_eq(2, req_handle);
+    //  due to FIFO reuse of free request handles 10 is first
+    ck_assert_int_eq(10, req_handle);
 
     request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
                                                constants__e_msg_session_create_resp, false, 0, &req_handle);
-    ck_assert_int_eq(10, req_handle); // request handle matches expected (implem dependent)
+    ck_assert_int_eq(2, req_handle); // request handle matches expected (implem dependent)
+
+    // Check there is no more available (removal of an already removed request handle had no effect)
+    request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
+                                               constants__e_msg_session_create_resp, false, 0, &req_handle);
+    ck_assert_int_eq(constants__c_client_request_handle_indet, req_handle);
 
     // Remove the last 2
-    request_handle_bs__client_remove_req_handle(remove_req_handles[2]);
     request_handle_bs__client_remove_req_handle(remove_req_handles[3]);
+    request_handle_bs__client_remove_req_handle(remove_req_handles[2]);
 
     request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
                                                constants__e_msg_session_create_resp, false, 0, &req_handle);
     // request handle matches expected (implem dependent):
-    //  due to circular behavior 50 is first after 10
-    ck_assert_int_eq(50, req_handle);
+    //  due to FIFO reuse of free request handles 1 is first
+    ck_assert_int_eq(1, req_handle);
     request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
                                                constants__e_msg_session_create_resp, false, 0, &req_handle);
-    ck_assert_int_eq(1, req_handle); // request handle matches expected (implem dependent)
+    ck_assert_int_eq(50, req_handle); // request handle matches expected (implem dependent)
+
+    // Check there is no more available
+    request_handle_bs__client_fresh_req_handle(constants__e_msg_session_create_req,
+                                               constants__e_msg_session_create_resp, false, 0, &req_handle);
+    ck_assert_int_eq(constants__c_client_request_handle_indet, req_handle);
+
+    request_handle_bs__request_handle_bs_UNINITIALISATION();
 }
 END_TEST
 
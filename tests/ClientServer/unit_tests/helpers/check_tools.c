@@ -27,7 +27,10 @@
 
 #include <assert.h>
 #include <check.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "check_helpers.h"
 #include "hexlify.h"
@@ -724,6 +727,96 @@ START_TEST(test_buffer_resizable)
 }
 END_TEST
 
+/* Prints the value with the given printer and returns it as a C string */
+static const char* print_number(SOPC_Buffer* buf, SOPC_ReturnStatus status)
+{
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_uint_lt(buf->length, buf->current_size);
+    buf->data[buf->length] = '\0';
+    return (const char*) buf->data;
+}
+
+START_TEST(test_buffer_print_numbers)
+{
+    SOPC_Buffer* buf = SOPC_Buffer_Create(64);
+    ck_assert_ptr_nonnull(buf);
+
+    /* Integers */
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("0", print_number(buf, SOPC_Buffer_PrintU32(buf, 0)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("4294967295", print_number(buf, SOPC_Buffer_PrintU32(buf, UINT32_MAX)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("-2147483648", print_number(buf, SOPC_Buffer_PrintI32(buf, INT32_MIN)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("2147483647", print_number(buf, SOPC_Buffer_PrintI32(buf, INT32_MAX)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("-7", print_number(buf, SOPC_Buffer_PrintI32(buf, -7)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("1000", print_number(buf, SOPC_Buffer_PrintI32(buf, 1000)));
+
+    /* Shortest representation in the '%g' notation */
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("0.1", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 0.1)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("-0", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, -0.0)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("42", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 42.0)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("0.0001", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 0.0001)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("1e-05", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 0.00001)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("1e+17", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 1e17)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("-4.3e+111", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, -4.3e111)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("5e-324", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 5e-324)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("1.7976931348623157e+308",
+                     print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, 1.7976931348623157e308)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("0.12", print_number(buf, SOPC_Buffer_PrintFloat(buf, 0.12f)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("3.4028235e+38", print_number(buf, SOPC_Buffer_PrintFloat(buf, 3.4028235e38f)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("\"-Infinity\"", print_number(buf, SOPC_Buffer_PrintFloat(buf, -INFINITY)));
+    SOPC_Buffer_Reset(buf);
+    ck_assert_str_eq("\"NaN\"", print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, NAN)));
+
+    /* Any finite value reads back to the same value */
+    uint64_t state = UINT64_C(88172645463325252);
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        // xorshift64 pseudo-random bits
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        double d = 0;
+        memcpy(&d, &state, sizeof(d));
+        if (isfinite(d))
+        {
+            SOPC_Buffer_Reset(buf);
+            const char* str = print_number(buf, SOPC_Buffer_PrintFloatDouble(buf, d));
+            ck_assert_double_eq(d, strtod(str, NULL));
+        }
+
+        float f = 0;
+        const uint32_t bits = (uint32_t)(state >> 32);
+        memcpy(&f, &bits, sizeof(f));
+        if (isfinite(f))
+        {
+            SOPC_Buffer_Reset(buf);
+            const char* str = print_number(buf, SOPC_Buffer_PrintFloat(buf, f));
+            ck_assert_float_eq(f, strtof(str, NULL));
+        }
+    }
+
+    SOPC_Buffer_Delete(buf);
+}
+END_TEST
+
 START_TEST(test_linked_list)
 {
     float value1 = 0.0;
@@ -4974,6 +5067,7 @@ Suite* tests_make_suite_tools(void)
     tcase_add_test(tc_buffer, test_buffer_set_properties);
     tcase_add_test(tc_buffer, test_buffer_append);
     tcase_add_test(tc_buffer, test_buffer_resizable);
+    tcase_add_test(tc_buffer, test_buffer_print_numbers);
     suite_add_tcase(s, tc_buffer);
     tc_linkedlist = tcase_create("Linked List");
     tcase_add_test(tc_linkedlist, test_linked_list);
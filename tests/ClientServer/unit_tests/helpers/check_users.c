@@ -166,6 +166,24 @@ static const SOPC_UserAuthorization_Functions selectiveAuthorizationFunctions =
     .pFuncFree = (SOPC_UserAuthorization_Free_Func*) &SOPC_Free,
     .pFuncAuthorizeOperation = selectiveAuthorizationAllow};
 
+/* Counts the calls to the selective authorization in order to check the decisions cache */
+static uint32_t gNbAuthorizationCalls = 0;
+
+static SOPC_ReturnStatus countingAuthorizationAllow(SOPC_UserAuthorization_Manager* authz,
+                                                    SOPC_UserAuthorization_OperationType operationType,
+                                                    const SOPC_NodeId* nodeId,
+                                                    uint32_t attributeId,
+                                                    const SOPC_User* user,
+                                                    bool* authorized)
+{
+    gNbAuthorizationCalls++;
+    return selectiveAuthorizationAllow(authz, operationType, nodeId, attributeId, user, authorized);
+}
+
+static const SOPC_UserAuthorization_Functions countingAuthorizationFunctions = {
+    .pFuncFree = (SOPC_UserAuthorization_Free_Func*) &SOPC_Free,
+    .pFuncAuthorizeOperation = countingAuthorizationAllow};
+
 /* Fixture setup and teardown functions */
 static inline void setup_user(void)
 {
@@ -489,6 +507,75 @@ START_TEST(test_authorization_selective)
 }
 END_TEST
 
+START_TEST(test_authorization_cache)
+{
+    bool authorized = false;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    SOPC_UserAuthorization_Manager* authorizationManager = SOPC_Calloc(1, sizeof(SOPC_UserAuthorization_Manager));
+    ck_assert_ptr_nonnull(authorizationManager);
+    authorizationManager->pFunctions = &countingAuthorizationFunctions;
+    gNbAuthorizationCalls = 0;
+
+    ck_assert(SOPC_STATUS_INVALID_STATE ==
+              SOPC_UserAuthorization_GetCacheStatistics(authorizationManager, &hits, &misses));
+    ck_assert(SOPC_STATUS_INVALID_PARAMETERS == SOPC_UserAuthorization_EnableCache(authorizationManager, 0));
+    ck_assert(SOPC_STATUS_OK == SOPC_UserAuthorization_EnableCache(authorizationManager, 3));
+    ck_assert(SOPC_STATUS_INVALID_STATE == SOPC_UserAuthorization_EnableCache(authorizationManager, 3));
+
+    SOPC_UserWithAuthorization* userLocal = NULL;
+    SOPC_UserWithAuthorization* userAnonymous = NULL;
+    SOPC_UserWithAuthorization* userUsername = NULL;
+    create_users_with_authorization(authorizationManager, &userLocal, &userAnonymous, &userUsername);
+
+#define TEST_AUTHZ(user, operation, nid, attribute, expected, nbCalls)                                     \
+    authorized = !expected;                                                                                \
+    ck_assert(SOPC_STATUS_OK ==                                                                            \
+              SOPC_UserAuthorization_IsAuthorizedOperation(user, operation, nid, attribute, &authorized)); \
+    ck_assert(authorized == expected);                                                                     \
+    ck_assert_uint_eq(nbCalls, gNbAuthorizationCalls);
+
+    /* Decisions are evaluated once per session */
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, true, 1)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, true, 1)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_WRITE, &authorizedNodeId, ATTRIBUTEID_VALUE, true, 2)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &unauthorizedNodeId, ATTRIBUTEID_VALUE, false, 3)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_WRITE, &authorizedNodeId, ATTRIBUTEID_VALUE, true, 3)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &unauthorizedNodeId, ATTRIBUTEID_VALUE, false, 3)
+    TEST_AUTHZ(userAnonymous, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, false, 4)
+    TEST_AUTHZ(userAnonymous, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, false, 4)
+    ck_assert(SOPC_STATUS_OK == SOPC_UserAuthorization_GetCacheStatistics(authorizationManager, &hits, &misses));
+    ck_assert_uint_eq(4, hits);
+    ck_assert_uint_eq(4, misses);
+
+    /* The cache of the session is emptied when full */
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_BROWSENAME, true,
+               5)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_BROWSENAME, true,
+               5)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, true, 6)
+
+    /* Invalidation discards the decisions of all the sessions */
+    SOPC_UserAuthorization_InvalidateCache(authorizationManager);
+    TEST_AUTHZ(userAnonymous, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_VALUE, false, 7)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_BROWSENAME, true,
+               8)
+    TEST_AUTHZ(userUsername, SOPC_USER_AUTHORIZATION_OPERATION_READ, &authorizedNodeId, ATTRIBUTEID_BROWSENAME, true,
+               8)
+    ck_assert(SOPC_STATUS_OK == SOPC_UserAuthorization_GetCacheStatistics(authorizationManager, &hits, &misses));
+    ck_assert_uint_eq(6, hits);
+    ck_assert_uint_eq(8, misses);
+
+#undef TEST_AUTHZ
+
+    SOPC_UserWithAuthorization_Free(&userLocal);
+    SOPC_UserWithAuthorization_Free(&userAnonymous);
+    SOPC_UserWithAuthorization_Free(&userUsername);
+    SOPC_UserAuthorization_FreeManager(&authorizationManager);
+    ck_assert_ptr_null(authorizationManager);
+}
+END_TEST
+
 Suite* tests_make_suite_users(void)
 {
     Suite* s = NULL;
@@ -516,6 +603,7 @@ Suite* tests_make_suite_users(void)
     tcase_add_checked_fixture(tc_authorization, setup_authorization, teardown_authorization);
     tcase_add_test(tc_authorization, test_authorization_allow_all);
     tcase_add_test(tc_authorization, test_authorization_selective);
+    tcase_add_test(tc_authorization, test_authorization_cache);
     /* TODO: UserAccessLevel and UserWriteMask */
     suite_add_tcase(s, tc_authorization);
 
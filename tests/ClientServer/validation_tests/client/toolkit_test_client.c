@@ -524,6 +524,131 @@ static SOPC_ReturnStatus Client_LoadClientConfiguration(size_t* nbSecConnCfgs,
     return status;
 }
 
+/* Number of read requests in progress at the same time with the completion queue */
+#define NB_QUEUED_READ_REQUESTS 50
+
+static SOPC_ReturnStatus test_completion_queue(SOPC_ClientConnection* connection)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_ClientHelper_CompletionQueue* queue = SOPC_ClientHelperNew_CompletionQueue_Create();
+    if (NULL == queue)
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+
+    // Send all the requests before retrieving any response, use request index as context
+    for (uintptr_t i = 0; SOPC_STATUS_OK == status && i < NB_QUEUED_READ_REQUESTS; i++)
+    {
+        OpcUa_ReadRequest* readReq = SOPC_ReadRequest_Create(1, OpcUa_TimestampsToReturn_Neither);
+        status = (NULL == readReq ? SOPC_STATUS_OUT_OF_MEMORY : SOPC_STATUS_OK);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_ReadRequest_SetReadValueFromStrings(readReq, 0, "i=2258", SOPC_AttributeId_Value, NULL);
+        }
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_ClientHelperNew_ServiceAsyncToQueue(connection, readReq, queue, i);
+        }
+        else
+        {
+            SOPC_Encodeable_Delete(&OpcUa_ReadRequest_EncodeableType, (void**) &readReq);
+        }
+    }
+
+    // Retrieve the responses by batches, each request shall be completed once
+    bool completed[NB_QUEUED_READ_REQUESTS] = {false};
+    uint32_t nbCompleted = 0;
+    SOPC_ClientHelper_Completion completions[16];
+    while (SOPC_STATUS_OK == status && nbCompleted < NB_QUEUED_READ_REQUESTS)
+    {
+        uint32_t nbPolled = SOPC_ClientHelperNew_CompletionQueue_Poll(
+            queue, completions, (uint32_t)(sizeof(completions) / sizeof(completions[0])), 2 * SOPC_REQUEST_TIMEOUT_MS);
+        if (0 == nbPolled)
+        {
+            status = SOPC_STATUS_TIMEOUT;
+        }
+        for (uint32_t i = 0; i < nbPolled; i++)
+        {
+            if (SOPC_STATUS_OK != completions[i].status ||
+                &OpcUa_ReadResponse_EncodeableType != completions[i].responseType ||
+                completions[i].userContext >= NB_QUEUED_READ_REQUESTS || completed[completions[i].userContext] ||
+                !SOPC_IsGoodStatus(((OpcUa_ReadResponse*) completions[i].response)->ResponseHeader.ServiceResult))
+            {
+                status = SOPC_STATUS_NOK;
+            }
+            else
+            {
+                completed[completions[i].userContext] = true;
+            }
+            SOPC_Encodeable_Delete(completions[i].responseType, &completions[i].response);
+        }
+        nbCompleted += nbPolled;
+    }
+
+    if (SOPC_STATUS_OK == status && 0 != SOPC_ClientHelperNew_CompletionQueue_NbPending(queue))
+    {
+        status = SOPC_STATUS_NOK;
+    }
+    if (NULL != queue)
+    {
+        SOPC_ReturnStatus deleteStatus = SOPC_ClientHelperNew_CompletionQueue_Delete(&queue);
+        SOPC_ASSERT(SOPC_STATUS_OK == deleteStatus || SOPC_STATUS_OK != status);
+    }
+
+    printf(">>Test_Client_Toolkit: %d read requests with completion queue: %s\n", NB_QUEUED_READ_REQUESTS,
+           SOPC_STATUS_OK == status ? "OK" : "NOK");
+    return status;
+}
+
+// Releases the connection into a pool and acquires it again with the same configuration: connection shall be reused
+static SOPC_ReturnStatus test_connection_pool(SOPC_SecureConnection_Config* secConnConfig,
+                                              SOPC_ClientConnection** connection)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    SOPC_ClientConnection* released = *connection;
+    SOPC_ClientConnection* acquired = NULL;
+    SOPC_ClientHelper_ConnectionPoolStats stats;
+    SOPC_ClientHelper_ConnectionPool* pool = SOPC_ClientHelperNew_ConnectionPool_Create(1, 1000);
+    if (NULL == pool)
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Release(pool, connection);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Acquire(pool, secConnConfig, SOPC_Client_ConnEventCb, &acquired);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_GetStatistics(pool, &stats);
+    }
+    if (SOPC_STATUS_OK == status && (released != acquired || 1 != stats.hits || 0 != stats.misses))
+    {
+        status = SOPC_STATUS_NOK;
+    }
+    // The connection is disconnected on pool deletion
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Release(pool, &acquired);
+    }
+    if (NULL != pool)
+    {
+        SOPC_ReturnStatus deleteStatus = SOPC_ClientHelperNew_ConnectionPool_Delete(&pool);
+        SOPC_ASSERT(SOPC_STATUS_OK == deleteStatus);
+    }
+    if (NULL != acquired)
+    {
+        *connection = acquired;
+    }
+
+    printf(">>Test_Client_Toolkit: connection reused from connection pool: %s\n",
+           SOPC_STATUS_OK == status ? "OK" : "NOK");
+    return status;
+}
+
 static SOPC_ReturnStatus test_subscription(SOPC_ClientConnection* connection)
 {
     SOPC_ReturnStatus status = SOPC_STATUS_OK;
@@ -845,6 +970,16 @@ int main(void)
     test_results_set_WriteRequest(NULL);
     tlibw_free_WriteRequest((OpcUa_WriteRequest**) &pWriteReqCopy);
 
+    if (SOPC_STATUS_OK == status)
+    {
+        status = test_completion_queue(secureConnections[0]);
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        status = test_connection_pool(secureConnConfigArray[1], &secureConnections[1]);
+    }
+
     if (SOPC_STATUS_OK == status)
     {
         status = test_subscription(secureConnections[0]);
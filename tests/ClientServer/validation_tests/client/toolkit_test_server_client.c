@@ -38,6 +38,9 @@
 #include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
 #include "sopc_pki_stack.h"
+#include "sopc_secure_channels_api.h"
+#include "sopc_secure_channels_internal_ctx.h"
+#include "sopc_threads.h"
 #include "sopc_time.h"
 #include "sopc_toolkit_async_api.h"
 #include "sopc_toolkit_config.h"
@@ -46,6 +49,7 @@
 #endif
 
 #include "opcua_identifiers.h"
+#include "opcua_statuscodes.h"
 
 #include "embedded/sopc_addspace_loader.h"
 
@@ -120,6 +124,37 @@ static void SOPC_Client_ConnEventCb(SOPC_ClientConnection* config,
 
 static OpcUa_GetEndpointsResponse* expectedEndpoints = NULL;
 
+static SOPC_ReturnStatus client_create_secure_connection(const char* userDefinedId,
+                                                         SOPC_SecureConnection_Config** outSecureConnConfig)
+{
+    SOPC_ReturnStatus status = SOPC_STATUS_OK;
+    /* connect to the endpoint */
+    SOPC_SecureConnection_Config* secureConnConfig = SOPC_ClientConfigHelper_CreateSecureConnection(
+        userDefinedId, DEFAULT_ENDPOINT_URL, MSG_SECURITY_MODE, REQ_SECURITY_POLICY);
+    if (NULL != secureConnConfig)
+    {
+        status = SOPC_SecureConnectionConfig_SetExpectedEndpointsDescription(secureConnConfig, expectedEndpoints);
+    }
+    else
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_SecureConnectionConfig_SetServerCertificateFromPath(secureConnConfig, SRV_CERT_PATH);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_SecureConnectionConfig_SetUserX509FromPaths(
+            secureConnConfig, SOPC_UserTokenPolicy_X509Basic256Sha256_ID, USER_CERT_PATH, USER_KEY_PATH, true);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        *outSecureConnConfig = secureConnConfig;
+    }
+    return status;
+}
+
 static SOPC_ReturnStatus client_create_configuration(SOPC_SecureConnection_Config** outSecureConnConfig)
 {
     SOPC_ReturnStatus status = SOPC_ClientConfigHelper_Initialize();
@@ -192,29 +227,9 @@ static SOPC_ReturnStatus client_create_configuration(SOPC_SecureConnection_Confi
     {
         printf(">>Test_Client: PKI created\n");
     }
-    /* connect to the endpoint */
-    SOPC_SecureConnection_Config* secureConnConfig = SOPC_ClientConfigHelper_CreateSecureConnection(
-        "Test", DEFAULT_ENDPOINT_URL, MSG_SECURITY_MODE, REQ_SECURITY_POLICY);
-    if (NULL != secureConnConfig)
-    {
-        status = SOPC_SecureConnectionConfig_SetExpectedEndpointsDescription(secureConnConfig, expectedEndpoints);
-    }
-    else
-    {
-        status = SOPC_STATUS_OUT_OF_MEMORY;
-    }
     if (SOPC_STATUS_OK == status)
     {
-        status = SOPC_SecureConnectionConfig_SetServerCertificateFromPath(secureConnConfig, SRV_CERT_PATH);
-    }
-    if (SOPC_STATUS_OK == status)
-    {
-        status = SOPC_SecureConnectionConfig_SetUserX509FromPaths(
-            secureConnConfig, SOPC_UserTokenPolicy_X509Basic256Sha256_ID, USER_CERT_PATH, USER_KEY_PATH, true);
-    }
-    if (SOPC_STATUS_OK == status)
-    {
-        *outSecureConnConfig = secureConnConfig;
+        status = client_create_secure_connection("Test", outSecureConnConfig);
     }
     return status;
 }
@@ -327,6 +342,579 @@ static SOPC_ReturnStatus client_send_read_req_test(SOPC_ClientConnection* secure
     return status;
 }
 
+// Subscription notified at a high rate: value updated every SUB_RATE_UPDATE_PERIOD_MS during SUB_RATE_DURATION_MS
+#define SUB_RATE_PUBLISH_INTERVAL_MS 10
+#define SUB_RATE_UPDATE_PERIOD_MS 2
+#define SUB_RATE_DURATION_MS 2000
+#define SUB_RATE_NB_PUBLISH_TOKENS 5
+
+static int32_t subRateNotifications = 0;
+
+static void client_subscription_rate_notification_cb(const SOPC_ClientHelper_Subscription* subscription,
+                                                     SOPC_StatusCode status,
+                                                     SOPC_EncodeableType* notificationType,
+                                                     uint32_t nbNotifElts,
+                                                     const void* notification,
+                                                     uintptr_t* monitoredItemCtxArray)
+{
+    SOPC_UNUSED_ARG(subscription);
+    SOPC_UNUSED_ARG(notification);
+    SOPC_UNUSED_ARG(monitoredItemCtxArray);
+    if (SOPC_IsGoodStatus(status) && &OpcUa_DataChangeNotification_EncodeableType == notificationType &&
+        nbNotifElts > 0)
+    {
+        SOPC_Atomic_Int_Add(&subRateNotifications, 1);
+    }
+}
+
+static SOPC_ReturnStatus client_subscription_rate_test(SOPC_ClientConnection* secureConnection)
+{
+    SOPC_ServerHelper_NodeHandle* nodeHandle = NULL;
+    SOPC_NodeId* nodeId = SOPC_NodeId_FromCString(node_id_str, (int32_t) strlen(node_id_str));
+    SOPC_ReturnStatus status = SOPC_ServerHelper_GetNodeHandle(nodeId, &nodeHandle);
+    SOPC_NodeId_Clear(nodeId);
+    SOPC_Free(nodeId);
+
+    SOPC_ClientHelper_Subscription* subscription = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        OpcUa_CreateSubscriptionRequest* createSubReq =
+            SOPC_CreateSubscriptionRequest_Create(SUB_RATE_PUBLISH_INTERVAL_MS, 1000, 100, 0, true, 0);
+        subscription = SOPC_ClientHelperNew_CreateSubscription(secureConnection, createSubReq,
+                                                               client_subscription_rate_notification_cb, 0);
+        status = (NULL != subscription ? SOPC_STATUS_OK : SOPC_STATUS_NOK);
+    }
+
+    // The publishing interval is not revised to the former 100 ms minimum
+    double revisedInterval = 0;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_Subscription_GetRevisedParameters(subscription, &revisedInterval, NULL, NULL);
+    }
+    if (SOPC_STATUS_OK == status && revisedInterval > SUB_RATE_PUBLISH_INTERVAL_MS)
+    {
+        printf(">>Client: revised publishing interval %f ms instead of %d ms\n", revisedInterval,
+               SUB_RATE_PUBLISH_INTERVAL_MS);
+        status = SOPC_STATUS_NOK;
+    }
+    // Several publish requests are needed to cover the round trip at a short interval
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_Subscription_SetAvailableTokens(subscription, SUB_RATE_NB_PUBLISH_TOKENS);
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        OpcUa_CreateMonitoredItemsResponse createMonItResp;
+        OpcUa_CreateMonitoredItemsResponse_Initialize(&createMonItResp);
+        OpcUa_CreateMonitoredItemsRequest* createMonItReq =
+            SOPC_CreateMonitoredItemsRequest_Create(0, 1, OpcUa_TimestampsToReturn_Both);
+        status = (NULL != createMonItReq ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_CreateMonitoredItemsRequest_SetMonitoredItemIdFromStrings(createMonItReq, 0, node_id_str,
+                                                                                   SOPC_AttributeId_Value, NULL);
+        }
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_ClientHelperNew_Subscription_CreateMonitoredItems(subscription, createMonItReq, NULL,
+                                                                            &createMonItResp);
+        }
+        if (SOPC_STATUS_OK == status && (!SOPC_IsGoodStatus(createMonItResp.ResponseHeader.ServiceResult) ||
+                                         1 != createMonItResp.NoOfResults ||
+                                         !SOPC_IsGoodStatus(createMonItResp.Results[0].StatusCode)))
+        {
+            status = SOPC_STATUS_NOK;
+        }
+        OpcUa_CreateMonitoredItemsResponse_Clear(&createMonItResp);
+        if (NULL != createMonItReq)
+        {
+            OpcUa_CreateMonitoredItemsRequest_Clear(createMonItReq);
+            SOPC_Free(createMonItReq);
+        }
+    }
+
+    // Update the value faster than the publishing interval so that each publish cycle has a notification
+    SOPC_TimeReference startTime = SOPC_TimeReference_GetCurrent();
+    SOPC_TimeReference elapsedMs = 0;
+    if (SOPC_STATUS_OK == status)
+    {
+        SOPC_Atomic_Int_Set(&subRateNotifications, 0);
+        startTime = SOPC_TimeReference_GetCurrent();
+    }
+    for (uint64_t value = write_value + 1; SOPC_STATUS_OK == status && elapsedMs < SUB_RATE_DURATION_MS; value++)
+    {
+        SOPC_DataValue dataValue;
+        SOPC_DataValue_Initialize(&dataValue);
+        dataValue.Value.BuiltInTypeId = SOPC_UInt64_Id;
+        dataValue.Value.ArrayType = SOPC_VariantArrayType_SingleValue;
+        dataValue.Value.Value.Uint64 = value;
+        status = SOPC_ServerHelper_UpdateValues(1, &nodeHandle, &dataValue);
+        SOPC_Sleep(SUB_RATE_UPDATE_PERIOD_MS);
+        elapsedMs = SOPC_TimeReference_GetCurrent() - startTime;
+    }
+
+    // Wide tolerance on the notifications count: the lower bound is still far above the former 100 ms minimum
+    if (SOPC_STATUS_OK == status)
+    {
+        const int32_t nbNotifications = SOPC_Atomic_Int_Get(&subRateNotifications);
+        const uint64_t nbExpected = elapsedMs / SUB_RATE_PUBLISH_INTERVAL_MS;
+        printf(">>Client: %" PRIi32 " notifications received in %" PRIu64 " ms (%" PRIu64 " expected)\n",
+               nbNotifications, elapsedMs, nbExpected);
+        if ((uint64_t) nbNotifications * 5 < nbExpected || (uint64_t) nbNotifications * 2 > nbExpected * 3)
+        {
+            status = SOPC_STATUS_NOK;
+        }
+    }
+
+    if (NULL != subscription)
+    {
+        SOPC_ReturnStatus delSubStatus = SOPC_ClientHelperNew_DeleteSubscription(&subscription);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = delSubStatus;
+        }
+    }
+    return status;
+}
+
+// Deferred method call: the method completion is provided by another thread once another request is treated
+#define DEFERRED_METHOD_OBJECT_ID "ns=1;s=TestObject"
+#define DEFERRED_METHOD_ID "ns=1;s=MethodO"
+#define DEFERRED_METHOD_OUTPUT 42
+#define DEFERRED_METHOD_TIMEOUT_MS 5000
+
+static SOPC_MethodCallCompletion* deferredMethodCompletion = NULL;
+static int32_t deferredMethodCalled = false;
+
+static SOPC_StatusCode SOPC_Method_Deferred(const SOPC_CallContext* callContextPtr,
+                                            const SOPC_NodeId* objectId,
+                                            uint32_t nbInputArgs,
+                                            const SOPC_Variant* inputArgs,
+                                            uint32_t* nbOutputArgs,
+                                            SOPC_Variant** outputArgs,
+                                            void* param)
+{
+    SOPC_UNUSED_ARG(objectId);
+    SOPC_UNUSED_ARG(nbInputArgs);
+    SOPC_UNUSED_ARG(inputArgs);
+    SOPC_UNUSED_ARG(param);
+    *nbOutputArgs = 0;
+    *outputArgs = NULL;
+    deferredMethodCompletion = SOPC_MethodCall_Defer(callContextPtr);
+    if (NULL == deferredMethodCompletion)
+    {
+        return OpcUa_BadOutOfMemory;
+    }
+    SOPC_Atomic_Int_Set(&deferredMethodCalled, true);
+    return OpcUa_GoodCompletesAsynchronously;
+}
+
+static SOPC_ReturnStatus deferredMethodCompleterStatus = SOPC_STATUS_NOK;
+
+static void* client_deferred_method_completer(void* arg)
+{
+    SOPC_ClientConnection* secureConnection = (SOPC_ClientConnection*) arg;
+    uint32_t waitedMs = 0;
+    while (!SOPC_Atomic_Int_Get(&deferredMethodCalled) && waitedMs < DEFERRED_METHOD_TIMEOUT_MS)
+    {
+        SOPC_Sleep(10);
+        waitedMs += 10;
+    }
+    if (!SOPC_Atomic_Int_Get(&deferredMethodCalled))
+    {
+        printf(">>Client: Deferred method not called\n");
+        deferredMethodCompleterStatus = SOPC_STATUS_TIMEOUT;
+        return NULL;
+    }
+
+    // The server treats other requests while the method call is not completed
+    SOPC_ReturnStatus status = client_send_write_test(secureConnection);
+
+    SOPC_Variant* output = SOPC_Calloc(1, sizeof(*output));
+    if (NULL == output)
+    {
+        status = SOPC_STATUS_OUT_OF_MEMORY;
+    }
+    else
+    {
+        SOPC_Variant_Initialize(output);
+        output->BuiltInTypeId = SOPC_UInt32_Id;
+        output->ArrayType = SOPC_VariantArrayType_SingleValue;
+        output->Value.Uint32 = DEFERRED_METHOD_OUTPUT;
+    }
+    // The method call is completed in any case to send the Call response
+    SOPC_ReturnStatus completeStatus =
+        SOPC_MethodCall_Complete(deferredMethodCompletion, SOPC_GoodGenericStatus, (NULL != output ? 1 : 0), output);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = completeStatus;
+    }
+    deferredMethodCompleterStatus = status;
+    return NULL;
+}
+
+static SOPC_ReturnStatus client_create_deferred_method_call_request(OpcUa_CallRequest** outCallRequest)
+{
+    SOPC_NodeId* objectId =
+        SOPC_NodeId_FromCString(DEFERRED_METHOD_OBJECT_ID, (int32_t) strlen(DEFERRED_METHOD_OBJECT_ID));
+    SOPC_NodeId* methodId = SOPC_NodeId_FromCString(DEFERRED_METHOD_ID, (int32_t) strlen(DEFERRED_METHOD_ID));
+    OpcUa_CallRequest* callRequest = SOPC_CallRequest_Create(1);
+    SOPC_ReturnStatus status =
+        (NULL != objectId && NULL != methodId && NULL != callRequest ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_CallRequest_SetMethodToCall(callRequest, 0, objectId, methodId, 0, NULL);
+    }
+    SOPC_NodeId_Clear(objectId);
+    SOPC_Free(objectId);
+    SOPC_NodeId_Clear(methodId);
+    SOPC_Free(methodId);
+    if (SOPC_STATUS_OK != status && NULL != callRequest)
+    {
+        SOPC_Encodeable_Delete(&OpcUa_CallRequest_EncodeableType, (void**) &callRequest);
+    }
+    *outCallRequest = callRequest;
+    return status;
+}
+
+static SOPC_ReturnStatus client_deferred_method_call_test(SOPC_ClientConnection* secureConnection)
+{
+    SOPC_Atomic_Int_Set(&deferredMethodCalled, false);
+    OpcUa_CallRequest* callRequest = NULL;
+    SOPC_ReturnStatus status = client_create_deferred_method_call_request(&callRequest);
+
+    SOPC_Thread completer;
+    bool completerStarted = false;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_Thread_Create(&completer, client_deferred_method_completer, secureConnection, "MethCompleter");
+        completerStarted = (SOPC_STATUS_OK == status);
+    }
+
+    // The response is received once the completer thread completed the method call
+    OpcUa_CallResponse* callResponse = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ServiceSync(secureConnection, callRequest, (void**) &callResponse);
+    }
+    else if (NULL != callRequest)
+    {
+        SOPC_Encodeable_Delete(&OpcUa_CallRequest_EncodeableType, (void**) &callRequest);
+    }
+    if (completerStarted)
+    {
+        SOPC_ReturnStatus joinStatus = SOPC_Thread_Join(completer);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = (SOPC_STATUS_OK == joinStatus ? deferredMethodCompleterStatus : joinStatus);
+        }
+    }
+
+    if (SOPC_STATUS_OK == status)
+    {
+        if (!SOPC_IsGoodStatus(callResponse->ResponseHeader.ServiceResult) || 1 != callResponse->NoOfResults ||
+            !SOPC_IsGoodStatus(callResponse->Results[0].StatusCode) ||
+            1 != callResponse->Results[0].NoOfOutputArguments ||
+            SOPC_UInt32_Id != callResponse->Results[0].OutputArguments[0].BuiltInTypeId ||
+            DEFERRED_METHOD_OUTPUT != callResponse->Results[0].OutputArguments[0].Value.Uint32)
+        {
+            printf(">>Client: Unexpected deferred method call result\n");
+            status = SOPC_STATUS_NOK;
+        }
+    }
+
+    if (NULL != callResponse)
+    {
+        SOPC_Encodeable_Delete(callResponse->encodeableType, (void**) &callResponse);
+    }
+    return status;
+}
+
+// Deferred method call on a closed session: the method is completed once the session of the caller is closed and
+// another session (which may reuse the closed session index) is activated. The completion shall not lead to a response
+// sent on the new session and the server shall continue to treat the requests of the new session.
+static SOPC_ReturnStatus client_deferred_method_session_closed_test(SOPC_SecureConnection_Config* closedConnConfig,
+                                                                    SOPC_SecureConnection_Config* newConnConfig)
+{
+    SOPC_Atomic_Int_Set(&deferredMethodCalled, false);
+    SOPC_ClientConnection* closedConnection = NULL;
+    SOPC_ClientConnection* newConnection = NULL;
+    SOPC_ClientHelper_CompletionQueue* queue = SOPC_ClientHelperNew_CompletionQueue_Create();
+    OpcUa_CallRequest* callRequest = NULL;
+    SOPC_ReturnStatus status = (NULL != queue ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_create_deferred_method_call_request(&callRequest);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_Connect(closedConnConfig, &SOPC_Client_ConnEventCb, &closedConnection);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ServiceAsyncToQueue(closedConnection, callRequest, queue, 0);
+        if (SOPC_STATUS_OK == status)
+        {
+            callRequest = NULL;
+        }
+    }
+    if (NULL != callRequest)
+    {
+        SOPC_Encodeable_Delete(&OpcUa_CallRequest_EncodeableType, (void**) &callRequest);
+    }
+
+    uint32_t waitedMs = 0;
+    while (SOPC_STATUS_OK == status && !SOPC_Atomic_Int_Get(&deferredMethodCalled) &&
+           waitedMs < DEFERRED_METHOD_TIMEOUT_MS)
+    {
+        SOPC_Sleep(10);
+        waitedMs += 10;
+    }
+    if (SOPC_STATUS_OK == status && !SOPC_Atomic_Int_Get(&deferredMethodCalled))
+    {
+        printf(">>Client: Deferred method not called\n");
+        status = SOPC_STATUS_TIMEOUT;
+    }
+
+    // Close the session of the caller while the method call is not completed
+    if (NULL != closedConnection)
+    {
+        SOPC_ReturnStatus disconnectStatus = SOPC_ClientHelperNew_Disconnect(&closedConnection);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = disconnectStatus;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_Connect(newConnConfig, &SOPC_Client_ConnEventCb, &newConnection);
+    }
+
+    // The method call is completed in any case to release the completion
+    if (SOPC_Atomic_Int_Get(&deferredMethodCalled))
+    {
+        SOPC_ReturnStatus completeStatus =
+            SOPC_MethodCall_Complete(deferredMethodCompletion, SOPC_GoodGenericStatus, 0, NULL);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = completeStatus;
+        }
+    }
+
+    // The new session is still served once the method call of the closed session is completed
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_send_read_req_test(newConnection);
+    }
+
+    // The request of the closed session failed and no response was received for it
+    if (NULL != queue)
+    {
+        SOPC_ClientHelper_Completion completion;
+        memset(&completion, 0, sizeof(completion));
+        uint32_t nbPolled =
+            SOPC_ClientHelperNew_CompletionQueue_Poll(queue, &completion, 1, DEFERRED_METHOD_TIMEOUT_MS);
+        if (SOPC_STATUS_OK == status && (1 != nbPolled || SOPC_STATUS_OK == completion.status))
+        {
+            printf(">>Client: Unexpected completion of the deferred method call on closed session\n");
+            status = SOPC_STATUS_NOK;
+        }
+        if (NULL != completion.response)
+        {
+            SOPC_Encodeable_Delete(completion.responseType, &completion.response);
+        }
+        SOPC_ReturnStatus deleteStatus = SOPC_ClientHelperNew_CompletionQueue_Delete(&queue);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = deleteStatus;
+        }
+    }
+
+    if (NULL != newConnection)
+    {
+        SOPC_ReturnStatus disconnectStatus = SOPC_ClientHelperNew_Disconnect(&newConnection);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = disconnectStatus;
+        }
+    }
+    return status;
+}
+
+// Connection pool: idle connections kept alive every POOL_KEEP_ALIVE_MS and at most 1 idle connection
+#define POOL_KEEP_ALIVE_MS 100
+#define POOL_MAX_IDLE_CONNECTIONS 1
+#define POOL_REACTIVATION_TIMEOUT_MS 10000
+
+static int32_t poolReconnectingEvents = 0;
+static int32_t poolConnectedEvents = 0;
+
+// Connection event callback of the connections acquired from the pool: only session re-activation is expected
+static void SOPC_Client_PoolConnEventCb(SOPC_ClientConnection* config,
+                                        SOPC_ClientConnectionEvent event,
+                                        SOPC_StatusCode status)
+{
+    SOPC_UNUSED_ARG(config);
+    SOPC_UNUSED_ARG(status);
+    if (SOPC_ClientConnectionEvent_Reconnecting == event)
+    {
+        SOPC_Atomic_Int_Add(&poolReconnectingEvents, 1);
+    }
+    else if (SOPC_ClientConnectionEvent_Connected == event)
+    {
+        SOPC_Atomic_Int_Add(&poolConnectedEvents, 1);
+    }
+    else
+    {
+        SOPC_ASSERT(false && "Unexpected connection event");
+    }
+}
+
+// Closes the secure channels on server side as a network loss would do: the client re-activates its sessions
+static void server_close_secure_channels(void)
+{
+    for (uint32_t scIdx = 1; scIdx <= SOPC_MAX_SECURE_CONNECTIONS_PLUS_BUFFERED; scIdx++)
+    {
+        SOPC_SecureConnection* scConnection = SC_GetConnection(scIdx);
+        // Note: state is read outside the secure channels thread, no connection is being established concurrently
+        if (scConnection->isServerConnection && (SECURE_CONNECTION_STATE_SC_CONNECTED == scConnection->state ||
+                                                 SECURE_CONNECTION_STATE_SC_CONNECTED_RENEW == scConnection->state))
+        {
+            SOPC_ReturnStatus status = SOPC_SecureChannels_EnqueueEvent(SC_DISCONNECT, scIdx, (uintptr_t) NULL, 0);
+            SOPC_ASSERT(SOPC_STATUS_OK == status);
+        }
+    }
+}
+
+static SOPC_ReturnStatus client_check_pool_stats(SOPC_ClientHelper_ConnectionPool* pool,
+                                                 uint32_t hits,
+                                                 uint32_t misses,
+                                                 uint32_t nbIdle,
+                                                 uint32_t discarded)
+{
+    SOPC_ClientHelper_ConnectionPoolStats stats;
+    SOPC_ReturnStatus status = SOPC_ClientHelperNew_ConnectionPool_GetStatistics(pool, &stats);
+    if (SOPC_STATUS_OK == status &&
+        (hits != stats.hits || misses != stats.misses || nbIdle != stats.nbIdle || discarded != stats.discarded))
+    {
+        printf(">>Client: pool statistics hits=%" PRIu32 " misses=%" PRIu32 " nbIdle=%" PRIu32 " discarded=%" PRIu32
+               " instead of %" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "\n",
+               stats.hits, stats.misses, stats.nbIdle, stats.discarded, hits, misses, nbIdle, discarded);
+        status = SOPC_STATUS_NOK;
+    }
+    return status;
+}
+
+/* Checks the connection pool keep alive, eviction and session re-activation.
+ * It shall be run while no other client connection is established, since all server secure channels are closed. */
+static SOPC_ReturnStatus client_connection_pool_test(SOPC_SecureConnection_Config* firstConfig,
+                                                     SOPC_SecureConnection_Config* secondConfig)
+{
+    SOPC_ClientConnection* first = NULL;
+    SOPC_ClientConnection* second = NULL;
+    SOPC_ClientHelper_ConnectionPool* pool =
+        SOPC_ClientHelperNew_ConnectionPool_Create(POOL_MAX_IDLE_CONNECTIONS, POOL_KEEP_ALIVE_MS);
+    SOPC_ReturnStatus status = (NULL != pool ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+
+    // No idle connection: both connections are established
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Acquire(pool, firstConfig, SOPC_Client_PoolConnEventCb, &first);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Acquire(pool, secondConfig, SOPC_Client_PoolConnEventCb, &second);
+    }
+
+    // Keep alive: an idle connection is read periodically and stays activated
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Release(pool, &first);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        SOPC_Sleep(5 * POOL_KEEP_ALIVE_MS);
+        SOPC_ClientHelper_ConnectionPoolStats stats;
+        status = SOPC_ClientHelperNew_ConnectionPool_GetStatistics(pool, &stats);
+        if (SOPC_STATUS_OK == status && 0 == stats.keepAlives)
+        {
+            printf(">>Client: no keep alive request sent on idle connection\n");
+            status = SOPC_STATUS_NOK;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_check_pool_stats(pool, 0, 2, 1, 0);
+    }
+
+    // Eviction: the oldest idle connection is disconnected when a connection is released in a full pool
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Release(pool, &second);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_check_pool_stats(pool, 0, 2, 1, 1);
+    }
+
+    // Re-activation: the idle connection is provided for the configuration of the evicted one,
+    // its session is re-activated on a new secure channel after the loss of the current one
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Acquire(pool, firstConfig, SOPC_Client_PoolConnEventCb, &second);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_check_pool_stats(pool, 1, 2, 0, 1);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        server_close_secure_channels();
+        uint32_t elapsedMs = 0;
+        while (0 == SOPC_Atomic_Int_Get(&poolConnectedEvents) && elapsedMs < POOL_REACTIVATION_TIMEOUT_MS)
+        {
+            SOPC_Sleep(10);
+            elapsedMs += 10;
+        }
+        if (0 == SOPC_Atomic_Int_Get(&poolReconnectingEvents) || 1 != SOPC_Atomic_Int_Get(&poolConnectedEvents))
+        {
+            printf(">>Client: session of the pooled connection not re-activated\n");
+            status = SOPC_STATUS_NOK;
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_send_write_test(second);
+    }
+    // The re-activated connection is kept in the pool
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ClientHelperNew_ConnectionPool_Release(pool, &second);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_check_pool_stats(pool, 1, 2, 1, 1);
+    }
+
+    if (NULL != first)
+    {
+        SOPC_ReturnStatus discoStatus = SOPC_ClientHelperNew_Disconnect(&first);
+        SOPC_ASSERT(SOPC_STATUS_OK == discoStatus);
+    }
+    if (NULL != second)
+    {
+        SOPC_ReturnStatus discoStatus = SOPC_ClientHelperNew_Disconnect(&second);
+        SOPC_ASSERT(SOPC_STATUS_OK == discoStatus);
+    }
+    if (NULL != pool)
+    {
+        SOPC_ReturnStatus deleteStatus = SOPC_ClientHelperNew_ConnectionPool_Delete(&pool);
+        SOPC_ASSERT(SOPC_STATUS_OK == deleteStatus);
+    }
+    return status;
+}
+
 #ifdef WITH_EXPAT
 #if 0 != S2OPC_NODE_MANAGEMENT
 static SOPC_ReturnStatus client_send_add_nodes_req_test(SOPC_ClientConnection* secureConnection)
@@ -555,6 +1143,36 @@ static SOPC_ReturnStatus Server_SetServerConfiguration(void)
         status = SOPC_ServerConfigHelper_SetAddressSpace(address_space);
     }
 
+    // Method call management: the method completes asynchronously
+    SOPC_MethodCallManager* mcm = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        mcm = SOPC_MethodCallManager_Create();
+        status = (NULL != mcm ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ServerConfigHelper_SetMethodCallManager(mcm);
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_MethodCallManager_Free(mcm);
+        }
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        SOPC_NodeId* methodId = SOPC_NodeId_FromCString(DEFERRED_METHOD_ID, (int32_t) strlen(DEFERRED_METHOD_ID));
+        status = (NULL != methodId ? SOPC_STATUS_OK : SOPC_STATUS_OUT_OF_MEMORY);
+        if (SOPC_STATUS_OK == status)
+        {
+            status = SOPC_MethodCallManager_AddMethod(mcm, methodId, &SOPC_Method_Deferred, NULL, NULL);
+        }
+        if (SOPC_STATUS_OK != status)
+        {
+            SOPC_NodeId_Clear(methodId);
+            SOPC_Free(methodId);
+        }
+    }
+
     // Note: user manager are AllowAll by default
 
     return status;
@@ -644,6 +1262,30 @@ START_TEST(test_server_client)
     }
     ck_assert_int_eq(SOPC_STATUS_OK, status);
 
+    /* Create the configurations of the connection pool test */
+    SOPC_SecureConnection_Config* poolConnConfigs[2] = {NULL, NULL};
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_create_secure_connection("TestPool1", &poolConnConfigs[0]);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_create_secure_connection("TestPool2", &poolConnConfigs[1]);
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    /* Create the configurations of the deferred method call on closed session test */
+    SOPC_SecureConnection_Config* deferredConnConfigs[2] = {NULL, NULL};
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_create_secure_connection("TestDeferred1", &deferredConnConfigs[0]);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_create_secure_connection("TestDeferred2", &deferredConnConfigs[1]);
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
     /* Connect client to server */
     SOPC_ClientConnection* connection = NULL;
     if (SOPC_STATUS_OK == status)
@@ -682,6 +1324,51 @@ START_TEST(test_server_client)
     }
     ck_assert_int_eq(SOPC_STATUS_OK, status);
 
+    /* Run a subscription notification rate test */
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_subscription_rate_test(connection);
+        if (SOPC_STATUS_OK == status)
+        {
+            printf(">>Client: Test Subscription Rate Success\n");
+        }
+        else
+        {
+            printf(">>Client: Test Subscription Rate Failed\n");
+        }
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    /* Run a method call test with a method completed asynchronously */
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_deferred_method_call_test(connection);
+        if (SOPC_STATUS_OK == status)
+        {
+            printf(">>Client: Test Deferred Method Call Success\n");
+        }
+        else
+        {
+            printf(">>Client: Test Deferred Method Call Failed\n");
+        }
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    /* Run a method call test with a method completed asynchronously after the session of the caller is closed */
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_deferred_method_session_closed_test(deferredConnConfigs[0], deferredConnConfigs[1]);
+        if (SOPC_STATUS_OK == status)
+        {
+            printf(">>Client: Test Deferred Method Call On Closed Session Success\n");
+        }
+        else
+        {
+            printf(">>Client: Test Deferred Method Call On Closed Session Failed\n");
+        }
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
 #ifdef WITH_EXPAT
 #if 0 != S2OPC_NODE_MANAGEMENT
     /* Run an add nodes service test */
@@ -708,6 +1395,21 @@ START_TEST(test_server_client)
     }
     ck_assert_int_eq(SOPC_STATUS_OK, status);
 
+    /* Run a connection pool test (no other connection shall be established) */
+    if (SOPC_STATUS_OK == status)
+    {
+        status = client_connection_pool_test(poolConnConfigs[0], poolConnConfigs[1]);
+        if (SOPC_STATUS_OK == status)
+        {
+            printf(">>Client: Test Connection Pool Success\n");
+        }
+        else
+        {
+            printf(">>Client: Test Connection Pool Failed\n");
+        }
+    }
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
     /* Clear client wrapper layer*/
     SOPC_ClientConfigHelper_Clear();
 
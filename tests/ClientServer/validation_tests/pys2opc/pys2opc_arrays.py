@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Licensed to Systerel under one or more contributor license
+# agreements. See the NOTICE file distributed with this work
+# for additional information regarding copyright ownership.
+# Systerel licenses this file to you under the Apache
+# License, Version 2.0 (the "License"); you may not use this
+# file except in compliance with the License. You may obtain
+# a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+
+"""
+PyS2OPC numeric arrays conversion tests (no server required).
+Converts large arrays of every numeric built-in type to SOPC_Variant and back,
+from and to list, array.array, memoryview and numpy.ndarray (when numpy is available).
+"""
+
+import array
+import sys
+import time
+
+from pys2opc import Variant, VariantType
+from pys2opc.types import _NUMERIC_ARRAYS
+
+from tap_logger import TapLogger
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+ARRAY_LENGTH = 1000000
+
+def array_values(variantType, typecode):
+    """Values covering the range of the type"""
+    if variantType == VariantType.Boolean:
+        return [i % 2 for i in range(ARRAY_LENGTH)]
+    if typecode in 'fd':
+        return [i * 0.25 - ARRAY_LENGTH for i in range(ARRAY_LENGTH)]
+    nbits = 8 * array.array(typecode).itemsize
+    if typecode.islower():
+        return [(i % 2**nbits) - 2**(nbits-1) for i in range(ARRAY_LENGTH)]
+    return [i % 2**nbits for i in range(ARRAY_LENGTH)]
+
+if __name__ == '__main__':
+    logger = TapLogger('pys2opc_arrays.tap')
+    output_types = [list, array.array] + ([numpy.ndarray] if numpy is not None else [])
+    for variantType, (_, _, typecode) in _NUMERIC_ARRAYS.items():
+        logger.begin_section('{} arrays -'.format(VariantType.get_name_from_id(variantType)))
+        values = array_values(variantType, typecode)
+        inputs = [values, array.array(typecode, values), memoryview(array.array(typecode, values))]
+        if numpy is not None:
+            inputs.append(numpy.array(values, dtype=typecode))
+            # Not the C type: converted before the copy
+            inputs.append(numpy.array(values, dtype='float64' if typecode in 'fd' else 'int64'))
+        for value in inputs:
+            t0 = time.perf_counter()
+            sopc_variant = Variant(value, variantType).to_sopc_variant()
+            for output_type in output_types:
+                result = Variant.from_sopc_variant(sopc_variant, output_type).get_python()
+                logger.add_test('{} to {}'.format(type(value).__name__, output_type.__name__),
+                                isinstance(result, output_type) and len(result) == ARRAY_LENGTH and
+                                list(result) == values)
+            print('{} {} round trips: {:.3f}s'.format(type(value).__name__, VariantType.get_name_from_id(variantType),
+                                                      time.perf_counter() - t0))
+
+    logger.begin_section('Malformed arrays -')
+    try:
+        Variant(memoryview(array.array('d', [0.]*4)).cast('B').cast('d', (2, 2)), VariantType.Double).to_sopc_variant()
+        logger.add_test('Multi dimensional array is rejected', False)
+    except ValueError:
+        logger.add_test('Multi dimensional array is rejected', True)
+
+    logger.finalize_report()
+    sys.exit(1 if logger.has_failed_tests else 0)
@@ -40,12 +40,12 @@ S2OPC_ROOT='../../../../'
 BINARY_DIR= S2OPC_ROOT + 'build/bin'
 VALIDATION_DIR= S2OPC_ROOT + 'validation'
 
-from itertools import product
+from itertools import product, cycle
 import time
 import threading
 import os
 
-from pys2opc import PyS2OPC_Client as PyS2OPC, BaseClientConnectionHandler, SecurityMode, SecurityPolicy, AttributeId, VariantType, Variant, NodeClass, DataValue, StatusCode
+from pys2opc import PyS2OPC_Client as PyS2OPC, BaseClientConnectionHandler, DataChangeFormat, SecurityMode, SecurityPolicy, AttributeId, VariantType, Variant, NodeClass, DataValue, StatusCode
 
 import sys; sys.path.insert(0, VALIDATION_DIR)
 from tap_logger import TapLogger
@@ -271,12 +271,19 @@ class ConnectionHandler(BaseClientConnectionHandler):
         """
         # Writes the new values
         self.logger.begin_section('Write Tests -')
+        self.typeCache.clear()
         self.test_write_and_assert()
+        self.logger.add_test('Types of the written nodes are cached', len(self.typeCache) == len(variantInfoList))
         self._test_read(readInitValues = False, onlyValues = True)
         # Writes back the old values
         self.logger.begin_section('Write initValue Tests -')
         self.test_write_and_assert(resetInitValues = True)
         self._test_read(onlyValues = True)
+        # A write that fails with a type mismatch removes the type from the cache
+        self.logger.begin_section('Write type mismatch Tests -')
+        response = self.write_nodes(['ns=1;i=1001'], [DataValue.from_python('String:S2OPC')], types=[VariantType.String])
+        self.logger.add_test('Write with wrong type fails', response.results == [StatusCode.BadTypeMismatch])
+        self.logger.add_test('Type is removed from the cache', len(self.typeCache) == len(variantInfoList) - 1)
 
     def test_browse(self):
         """
@@ -305,11 +312,24 @@ class ConnectionHandler(BaseClientConnectionHandler):
                 nids.append(nid)
                 self.expectedChangesInit[nid] = initVal
                 self.expectedChangesNew[nid] = newVal
-            self.add_nodes_to_subscription(nids)
+            handles = self.add_nodes_to_subscription(nids)
+            assert len(handles) == len(nids)
         else:
             self.subscriptionComplete.set()
 
 
+class BatchConnectionHandler(ConnectionHandler):
+    """
+    ConnectionHandler which receives the data changes of each notification at once, in columns.
+    """
+    datachange_format = DataChangeFormat.Columns
+
+    def on_datachanged_batch(self, dataChanges):
+        for handle, value, timestamp, status in zip(dataChanges.handles, dataChanges.values,
+                                                    dataChanges.timestamps, dataChanges.statuses):
+            self.on_datachanged(self._dSubscription[handle], DataValue(timestamp, 0, status, value))
+
+
 if __name__ == '__main__':
     logger_ = TapLogger('validation_pys2opc.tap')
 
@@ -340,7 +360,9 @@ if __name__ == '__main__':
 
         # Do the read/write with multiple connections
         print('Asynch Write/Reads on new connections')
-        connections = [PyS2OPC.connect(cfg, ConnectionHandler) for cfg in configs]
+        # Half of the connections receive their data changes by batch
+        connections = [PyS2OPC.connect(cfg, HandlerClass)
+                       for cfg, HandlerClass in zip(configs, cycle([ConnectionHandler, BatchConnectionHandler]))]
         for conn in connections:
             conn.set_logger(logger_)
             conn.configure_subscription()
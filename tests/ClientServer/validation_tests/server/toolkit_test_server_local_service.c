@@ -573,6 +573,85 @@ static SOPC_ReturnStatus check_readDataTypeDefinition(const SOPC_AddressSpace* a
     return status;
 }
 
+static SOPC_ReturnStatus check_updateValues(void)
+{
+    const SOPC_NodeId int64VarId = {SOPC_IdentifierType_Numeric, 1, .Data.Numeric = 1001};
+    const SOPC_NodeId objectsFolderId = {SOPC_IdentifierType_Numeric, OPCUA_NAMESPACE_INDEX,
+                                         .Data.Numeric = OpcUaId_ObjectsFolder};
+    const int64_t values[2] = {-4242, 424242};
+
+    // Only Variable nodes have a handle
+    SOPC_ServerHelper_NodeHandle* handles[2] = {NULL, NULL};
+    SOPC_ReturnStatus status = SOPC_ServerHelper_GetNodeHandle(&objectsFolderId, &handles[0]);
+    status = (SOPC_STATUS_INVALID_PARAMETERS == status ? SOPC_STATUS_OK : SOPC_STATUS_NOK);
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ServerHelper_GetNodeHandle(&int64VarId, &handles[0]);
+    }
+    handles[1] = handles[0];
+
+    // Update the same node twice in the batch: the last value is the final one
+    SOPC_DataValue dataValues[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+        SOPC_DataValue_Initialize(&dataValues[i]);
+        dataValues[i].Value.BuiltInTypeId = SOPC_Int64_Id;
+        dataValues[i].Value.ArrayType = SOPC_VariantArrayType_SingleValue;
+        dataValues[i].Value.Value.Int64 = values[i];
+        dataValues[i].Status = SOPC_GoodGenericStatus;
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ServerHelper_UpdateValues(2, handles, dataValues);
+    }
+    // Values are moved
+    if (SOPC_STATUS_OK == status && SOPC_Null_Id != dataValues[1].Value.BuiltInTypeId)
+    {
+        status = SOPC_STATUS_NOK;
+    }
+
+    // Local services are treated after the update by the services thread
+    OpcUa_ReadRequest* readReq = NULL;
+    OpcUa_ReadResponse* readResp = NULL;
+    if (SOPC_STATUS_OK == status)
+    {
+        readReq = SOPC_ReadRequest_Create(1, OpcUa_TimestampsToReturn_Source);
+        status = (NULL == readReq ? SOPC_STATUS_OUT_OF_MEMORY : SOPC_STATUS_OK);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ReadRequest_SetReadValue(readReq, 0, &int64VarId, SOPC_AttributeId_Value, NULL);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        status = SOPC_ServerHelper_LocalServiceSync(readReq, (void**) &readResp);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        if (!SOPC_IsGoodStatus(readResp->ResponseHeader.ServiceResult) || 1 != readResp->NoOfResults ||
+            !SOPC_IsGoodStatus(readResp->Results[0].Status) ||
+            SOPC_Int64_Id != readResp->Results[0].Value.BuiltInTypeId ||
+            values[1] != readResp->Results[0].Value.Value.Int64 || 0 == readResp->Results[0].SourceTimestamp)
+        {
+            status = SOPC_STATUS_NOK;
+        }
+    }
+
+    if (NULL != readResp)
+    {
+        SOPC_Encodeable_Delete(readResp->encodeableType, (void**) &readResp);
+    }
+    if (SOPC_STATUS_OK == status)
+    {
+        printf("<Test_Server_Local_Service: update values: OK\n");
+    }
+    else
+    {
+        printf("<Test_Server_Local_Service: update values: NOK\n");
+    }
+    return status;
+}
+
 int main(int argc, char* argv[])
 {
     SOPC_UNUSED_ARG(argc);
@@ -938,6 +1017,12 @@ int main(int argc, char* argv[])
         status = check_readDataTypeDefinition(address_space);
     }
 
+    // Check direct update of values with pre-resolved node handles
+    if (SOPC_STATUS_OK == status)
+    {
+        status = check_updateValues();
+    }
+
     // Asynchronous request to stop the server
     SOPC_ReturnStatus stopStatus = SOPC_ServerHelper_StopServer();
 
@@ -227,6 +227,38 @@ START_TEST(test_callback_subscription)
 }
 END_TEST
 
+START_TEST(test_callback_subscription_qos)
+{
+    MqttContextClient* contextClient;
+    SOPC_Atomic_Int_Set(&nbFatalError, 0);
+    SOPC_Atomic_Int_Set(&nbReceived, 0);
+    SOPC_ReturnStatus status = SOPC_MQTT_Create_Client(&contextClient);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    const uint8_t subQos[NB_TOPIC] = {0, 1, 2};
+    const SOPC_MQTT_Client_Options options = {.subQos = subQos, .maxInflight = 2, .maxBufferedMessages = 10};
+    status = SOPC_MQTT_Set_Client_Options(contextClient, &options);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    status = SOPC_MQTT_InitializeAndConnect_Client(contextClient, URI_MQTT_BROKER, NULL, NULL, MQTT_LIB_TOPIC_NAME,
+                                                   NB_TOPIC, cbMessageArrivedTest, &onFatalError, NULL);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    WAIT_AND_CHECK_EQ(SOPC_MQTT_Client_Is_Connected(contextClient), 1, MAX_WAIT_MS);
+
+    for (uint8_t i = 0; i < NB_TOPIC; i++)
+    {
+        status = SOPC_MQTT_Send_Message_QoS(contextClient, MQTT_LIB_TOPIC_NAME[i], encoded_network_msg, i, false);
+        ck_assert_int_eq(SOPC_STATUS_OK, status);
+    }
+    status = SOPC_MQTT_Send_Message_QoS(contextClient, MQTT_LIB_TOPIC_NAME[0], encoded_network_msg, 3, false);
+    ck_assert_int_eq(SOPC_STATUS_INVALID_PARAMETERS, status);
+
+    WAIT_AND_CHECK_EQ(SOPC_Atomic_Int_Get(&nbReceived), NB_TOPIC, MAX_WAIT_MS);
+    SOPC_MQTT_Release_Client(contextClient);
+    SOPC_Sleep(100);
+    ck_assert_int_eq(SOPC_Atomic_Int_Get(&nbFatalError), 0);
+}
+END_TEST
+
 START_TEST(test_connexion_authentification)
 {
     MqttContextClient* contextClient;
@@ -277,6 +309,7 @@ int main(void)
     TCase* tc_subscriber_client = tcase_create("Mqtt subscriber");
     suite_add_tcase(suite, tc_subscriber_client);
     tcase_add_test(tc_subscriber_client, test_callback_subscription);
+    tcase_add_test(tc_subscriber_client, test_callback_subscription_qos);
 
     sr = srunner_create(suite);
 
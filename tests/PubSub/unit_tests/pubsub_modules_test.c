@@ -33,10 +33,14 @@
 #include "sopc_dataset_layer.h"
 #include "sopc_dataset_ll_layer.h"
 #include "sopc_helper_endianness_cfg.h"
+#include "sopc_macros.h"
 #include "sopc_mem_alloc.h"
 #include "sopc_network_layer.h"
+#include "sopc_pub_fixed_buffer.h"
 #include "sopc_pub_scheduler.h"
 #include "sopc_pub_source_variable.h"
+#include "sopc_pubsub_constants.h"
+#include "sopc_pubsub_sks.h"
 #include "sopc_reader_layer.h"
 #include "sopc_sub_target_variable.h"
 #include "sopc_time.h"
@@ -53,7 +57,7 @@ SOPC_Variant varArr[NB_VARS] = {{true, SOPC_UInt32_Id, SOPC_VariantArrayType_Sin
 
 /* Test network message layer JSON encoded */
 
-#define ENCODED_DATA_SIZE_JSON 548
+#define ENCODED_DATA_SIZE_JSON 547
 #define NB_VARS_JSON 9
 
 static SOPC_Byte gSampleText[] = "This is a text !";
@@ -61,8 +65,8 @@ static const SOPC_Variant varArrJSON[NB_VARS_JSON] = {
     {true, SOPC_Boolean_Id, SOPC_VariantArrayType_SingleValue, {.Boolean = true}},
     {true, SOPC_UInt32_Id, SOPC_VariantArrayType_SingleValue, {.Uint32 = 64839}},
     {true, SOPC_Int32_Id, SOPC_VariantArrayType_SingleValue, {.Int32 = -65133}},
-    {true, SOPC_Double_Id, SOPC_VariantArrayType_SingleValue, {.Doublev = (double) 5462.16515561}}, // ~ 5462.165156
-    {true, SOPC_Float_Id, SOPC_VariantArrayType_SingleValue, {.Floatv = (float) 546216515561}},     // ~ 5.462165094e+11
+    {true, SOPC_Double_Id, SOPC_VariantArrayType_SingleValue, {.Doublev = (double) 5462.16515561}}, // 5462.16515561
+    {true, SOPC_Float_Id, SOPC_VariantArrayType_SingleValue, {.Floatv = (float) 546216515561}},     // ~ 5.462165e+11
     {true, SOPC_Float_Id, SOPC_VariantArrayType_SingleValue, {.Floatv = (float) 1.0 / 0.0}},
     {true, SOPC_Float_Id, SOPC_VariantArrayType_SingleValue, {.Floatv = (float) -1.0 / 0.0}},
     {true, SOPC_Double_Id, SOPC_VariantArrayType_SingleValue, {.Doublev = NAN}},
@@ -95,11 +99,11 @@ static const uint8_t encoded_network_msg_json[ENCODED_DATA_SIZE_JSON] =
     "},"
     "\"0-3\":{"
     "\"Type\":11,"
-    "\"Body\":5462.165156"
+    "\"Body\":5462.16515561"
     "},"
     "\"0-4\":{"
     "\"Type\":10,"
-    "\"Body\":5.462165094e+11"
+    "\"Body\":5.462165e+11"
     "},"
     "\"0-5\":{"
     "\"Type\":10,"
@@ -481,6 +485,105 @@ START_TEST(test_hl_network_msg_encode_json)
 }
 END_TEST
 
+/* JSON decoding: the first DataSetMessage is decoded, the second one is skipped */
+static const SOPC_DataSetReader* getReader_JsonTest(const SOPC_ReaderGroup* group,
+                                                    const SOPC_UADP_Configuration* uadp_conf,
+                                                    const uint16_t dataSetWriterId,
+                                                    const uint8_t dataSetIndex)
+{
+    SOPC_UNUSED_ARG(uadp_conf);
+    SOPC_UNUSED_ARG(dataSetIndex);
+    return (DATASET_MSG_WRITER_ID_BASE == dataSetWriterId ? SOPC_ReaderGroup_Get_DataSetReader_At(group, 0) : NULL);
+}
+
+static SOPC_ReturnStatus setDsm_JsonTest(const SOPC_Dataset_LL_DataSetMessage* dsm,
+                                         SOPC_SubTargetVariableConfig* targetConfig,
+                                         const SOPC_DataSetReader* reader)
+{
+    SOPC_UNUSED_ARG(dsm);
+    SOPC_UNUSED_ARG(targetConfig);
+    SOPC_UNUSED_ARG(reader);
+    return SOPC_STATUS_OK;
+}
+
+START_TEST(test_hl_network_msg_decode_json)
+{
+    SOPC_DataSetReader* dsr[1];
+    SOPC_PubSubConfiguration* config = build_Sub_Config(dsr, 1);
+    ck_assert_ptr_nonnull(config);
+    SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0);
+    ck_assert_ptr_nonnull(connection);
+
+    const SOPC_UADP_NetworkMessage_Reader_Configuration readerConf = {
+        .pGetSecurity_Func = NULL,
+        .callbacks = {.pGetGroup_Func = SOPC_Reader_NetworkMessage_Default_Readers.pGetGroup_Func,
+                      .pGetReader_Func = &getReader_JsonTest,
+                      .pSetDsm_Func = &setDsm_JsonTest},
+        .checkDataSetMessageSN_Func = NULL,
+        .targetConfig = NULL};
+
+    SOPC_Buffer* buffer = SOPC_Buffer_Create(ENCODED_DATA_SIZE_JSON);
+    ck_assert_ptr_nonnull(buffer);
+    SOPC_ReturnStatus status = SOPC_Buffer_Write(buffer, encoded_network_msg_json, ENCODED_DATA_SIZE_JSON);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_Buffer_SetPosition(buffer, 0);
+
+    SOPC_UADP_NetworkMessage* uadp_nm = NULL;
+    SOPC_NetworkMessage_Error_Code code = SOPC_JSON_NetworkMessage_Decode(buffer, &readerConf, connection, &uadp_nm);
+    ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    ck_assert_ptr_nonnull(uadp_nm);
+
+    // The numeric PublisherId string is decoded as an integer
+    SOPC_Dataset_LL_NetworkMessage_Header* header = SOPC_Dataset_LL_NetworkMessage_GetHeader(uadp_nm->nm);
+    const SOPC_Dataset_LL_PublisherId* pubId = SOPC_Dataset_LL_NetworkMessage_Get_PublisherId(header);
+    ck_assert_ptr_nonnull(pubId);
+    ck_assert_int_eq(DataSet_LL_PubId_UInt64_Id, pubId->type);
+    ck_assert_uint_eq(NETWORK_MSG_PUBLISHER_ID, pubId->data.uint64);
+    ck_assert_uint_eq(2, SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(uadp_nm->nm));
+
+    const SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(uadp_nm->nm, 0);
+    ck_assert_uint_eq(DATASET_MSG_WRITER_ID_BASE, SOPC_Dataset_LL_DataSetMsg_Get_WriterId(dsm));
+    ck_assert_uint_eq(NB_VARS_JSON, SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm));
+    for (uint16_t i = 0; i < NB_VARS_JSON; i++)
+    {
+        const SOPC_Variant* var = SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, i);
+        ck_assert_ptr_nonnull(var);
+        ck_assert_int_eq(varArrJSON[i].BuiltInTypeId, var->BuiltInTypeId);
+        ck_assert_int_eq(SOPC_VariantArrayType_SingleValue, var->ArrayType);
+    }
+    ck_assert(SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 0)->Value.Boolean);
+    ck_assert_uint_eq(64839, SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 1)->Value.Uint32);
+    ck_assert_int_eq(-65133, SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 2)->Value.Int32);
+    // Shortest round-trip printing gives back the exact published values
+    ck_assert_double_eq(5462.16515561, SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 3)->Value.Doublev);
+    ck_assert_float_eq((float) 546216515561, SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 4)->Value.Floatv);
+    ck_assert(isinf(SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 5)->Value.Floatv) &&
+              SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 5)->Value.Floatv > 0);
+    ck_assert(isinf(SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 6)->Value.Floatv) &&
+              SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 6)->Value.Floatv < 0);
+    ck_assert(isnan(SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 7)->Value.Doublev));
+    ck_assert(SOPC_String_Equal(&varArrJSON[8].Value.String,
+                                &SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 8)->Value.String));
+
+    // The second DataSetMessage has no reader
+    dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(uadp_nm->nm, 1);
+    ck_assert_uint_eq(10, SOPC_Dataset_LL_DataSetMsg_Get_WriterId(dsm));
+    ck_assert_uint_eq(0, SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm));
+    SOPC_UADP_NetworkMessage_Delete(uadp_nm);
+    uadp_nm = NULL;
+
+    // Truncated message
+    buffer->length--;
+    SOPC_Buffer_SetPosition(buffer, 0);
+    code = SOPC_JSON_NetworkMessage_Decode(buffer, &readerConf, connection, &uadp_nm);
+    ck_assert_uint_eq(SOPC_JSON_NetworkMessage_Error_Read_Syntax, code);
+    ck_assert_ptr_null(uadp_nm);
+
+    SOPC_Buffer_Delete(buffer);
+    SOPC_PubSubConfiguration_Delete(config);
+}
+END_TEST
+
 START_TEST(test_hl_network_msg_encode)
 {
     SOPC_Helper_Endianness_Check();
@@ -556,6 +659,331 @@ START_TEST(test_hl_network_msg_encode)
 }
 END_TEST
 
+START_TEST(test_hl_network_msg_encode_preencoded_secured)
+{
+    SOPC_Helper_Endianness_Check();
+
+    SOPC_Dataset_LL_NetworkMessage* nm = SOPC_Dataset_LL_NetworkMessage_CreateEmpty();
+    SOPC_Dataset_LL_NetworkMessage_Header* header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
+
+    bool res = SOPC_Dataset_LL_NetworkMessage_Allocate_DataSetMsg_Array(nm, 1);
+    ck_assert_int_eq(true, res);
+
+    SOPC_Dataset_LL_NetworkMessage_Set_PublisherId_Byte(header, NETWORK_MSG_PUBLISHER_ID);
+    SOPC_Dataset_LL_NetworkMessage_SetVersion(header, NETWORK_MSG_VERSION);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupId(nm, NETWORK_MSG_GROUP_ID);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupVersion(nm, NETWORK_MSG_GROUP_VERSION);
+
+    SOPC_Dataset_LL_DataSetMessage* msg_dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, 0);
+    SOPC_Dataset_LL_DataSetMsg_Set_WriterId(msg_dsm, (uint16_t)(DATASET_MSG_WRITER_ID_BASE));
+    res = SOPC_Dataset_LL_DataSetMsg_Allocate_DataSetField_Array(msg_dsm, NB_VARS);
+    ck_assert_int_eq(true, res);
+
+    SOPC_DataSet_LL_UadpDataSetMessageContentMask conf = {
+        .validFlag = true,
+        .fieldEncoding = DataSet_LL_FieldEncoding_Variant,
+        .dataSetMessageSequenceNumberFlag = true,
+        .statusFlag = false,
+        .configurationVersionMajorVersionFlag = false,
+        .configurationVersionMinorFlag = false,
+        .dataSetMessageType = DataSet_LL_MessageType_KeyFrame,
+        .timestampFlag = false,
+        .picoSecondsFlag = false,
+    };
+    SOPC_Dataset_LL_DataSetMsg_Set_ContentMask(msg_dsm, &conf);
+
+    for (uint16_t i = 0; i < NB_VARS; i++)
+    {
+        SOPC_Variant* var = SOPC_Variant_Create();
+        SOPC_ReturnStatus status = SOPC_Variant_Copy(var, &varArr[i]);
+        ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+        res = SOPC_Dataset_LL_DataSetMsg_Set_DataSetField_Variant_At(msg_dsm, var, i);
+        ck_assert_int_eq(true, res);
+    }
+
+    // Security context with arbitrary keys
+    SOPC_CryptoProvider* provider = SOPC_CryptoProvider_CreatePubSub(SOPC_PUBSUB_SECURITY_POLICY);
+    ck_assert_ptr_nonnull(provider);
+    uint32_t signKeyLength = 0;
+    uint32_t cryptoKeyLength = 0;
+    uint32_t keyNonceLength = 0;
+    SOPC_ReturnStatus status = SOPC_CryptoProvider_SymmetricGetLength_SignKey(provider, &signKeyLength);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    status = SOPC_CryptoProvider_SymmetricGetLength_CryptoKey(provider, &cryptoKeyLength);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    status = SOPC_CryptoProvider_PubSubGetLength_KeyNonce(provider, &keyNonceLength);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_ExposedBuffer keyData[64];
+    for (uint8_t i = 0; i < sizeof(keyData); i++)
+    {
+        keyData[i] = (SOPC_ExposedBuffer)(i * 7 + 1);
+    }
+    ck_assert_uint_le(signKeyLength, sizeof(keyData));
+    ck_assert_uint_le(cryptoKeyLength, sizeof(keyData));
+    ck_assert_uint_le(keyNonceLength, sizeof(keyData));
+    SOPC_PubSubSKS_Keys keys = {.tokenId = 3,
+                                .signingKey = SOPC_SecretBuffer_NewFromExposedBuffer(keyData, signKeyLength),
+                                .encryptKey = SOPC_SecretBuffer_NewFromExposedBuffer(keyData, cryptoKeyLength),
+                                .keyNonce = SOPC_SecretBuffer_NewFromExposedBuffer(keyData, keyNonceLength)};
+    SOPC_ExposedBuffer msgNonceRandom[4] = {0x0A, 0x0B, 0x0C, 0x0D};
+    SOPC_PubSub_SecurityType security = {.mode = SOPC_SecurityMode_SignAndEncrypt,
+                                         .provider = provider,
+                                         .groupKeys = NULL,
+                                         .msgNonceRandom = NULL,
+                                         .sequenceNumber = 0};
+
+    // Keys and nonce are not needed to preencode the message
+    status = SOPC_DataSet_LL_NetworkMessage_Create_Preencode_Buffer(nm, &security);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    // Security is mandatory for a secured preencoded message
+    ck_assert_ptr_null(SOPC_UADP_NetworkMessage_Get_PreencodedBuffer(nm, NULL));
+
+    security.groupKeys = &keys;
+    security.msgNonceRandom = msgNonceRandom;
+    for (uint32_t iMsg = 0; iMsg < 3; iMsg++)
+    {
+        security.sequenceNumber = 42 + iMsg;
+        keys.tokenId = 3 + iMsg / 2;
+        msgNonceRandom[0] = (SOPC_ExposedBuffer) iMsg;
+        SOPC_Dataset_LL_DataSetMsg_Set_SequenceNumber(msg_dsm, (uint16_t)(100 + iMsg));
+
+        SOPC_Buffer* preencoded = SOPC_UADP_NetworkMessage_Get_PreencodedBuffer(nm, &security);
+        ck_assert_ptr_nonnull(preencoded);
+
+        // Secured preencoded message is the same as the encoded one
+        SOPC_Buffer* buffer = NULL;
+        SOPC_Buffer* buffer_payload = NULL;
+        SOPC_NetworkMessage_Error_Code errorCode =
+            SOPC_UADP_NetworkMessage_Encode_Buffers(nm, &security, &buffer, &buffer_payload);
+        ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, errorCode);
+        errorCode = SOPC_UADP_NetworkMessage_BuildFinalMessage(&security, buffer, &buffer_payload);
+        ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, errorCode);
+        ck_assert_ptr_nonnull(buffer);
+
+        ck_assert_uint_eq(buffer->length, preencoded->length);
+        ck_assert_int_eq(0, memcmp(buffer->data, preencoded->data, buffer->length));
+        SOPC_Buffer_Delete(buffer);
+    }
+
+    SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+    SOPC_SecretBuffer_DeleteClear(keys.signingKey);
+    SOPC_SecretBuffer_DeleteClear(keys.encryptKey);
+    SOPC_SecretBuffer_DeleteClear(keys.keyNonce);
+    SOPC_CryptoProvider_Free(provider);
+}
+END_TEST
+
+#define CHUNKED_BYTESTRING_LENGTH 10000
+#define MAX_CHUNKS 8
+
+START_TEST(test_hl_network_msg_chunks)
+{
+    SOPC_Helper_Endianness_Check();
+
+    SOPC_Dataset_LL_NetworkMessage* nm = SOPC_Dataset_LL_NetworkMessage_CreateEmpty();
+    SOPC_Dataset_LL_NetworkMessage_Header* header = SOPC_Dataset_LL_NetworkMessage_GetHeader(nm);
+    bool res = SOPC_Dataset_LL_NetworkMessage_Allocate_DataSetMsg_Array(nm, 1);
+    ck_assert_int_eq(true, res);
+    SOPC_Dataset_LL_NetworkMessage_Set_PublisherId_Byte(header, NETWORK_MSG_PUBLISHER_ID);
+    SOPC_Dataset_LL_NetworkMessage_SetVersion(header, NETWORK_MSG_VERSION);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupId(nm, NETWORK_MSG_GROUP_ID);
+    SOPC_Dataset_LL_NetworkMessage_Set_GroupVersion(nm, NETWORK_MSG_GROUP_VERSION);
+
+    SOPC_Dataset_LL_DataSetMessage* msg_dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, 0);
+    SOPC_Dataset_LL_DataSetMsg_Set_WriterId(msg_dsm, (uint16_t)(DATASET_MSG_WRITER_ID_BASE));
+    SOPC_Dataset_LL_DataSetMsg_Set_SequenceNumber(msg_dsm, 321);
+    res = SOPC_Dataset_LL_DataSetMsg_Allocate_DataSetField_Array(msg_dsm, 1);
+    ck_assert_int_eq(true, res);
+    SOPC_DataSet_LL_UadpDataSetMessageContentMask conf = {
+        .validFlag = true,
+        .fieldEncoding = DataSet_LL_FieldEncoding_Variant,
+        .dataSetMessageSequenceNumberFlag = true,
+        .statusFlag = false,
+        .configurationVersionMajorVersionFlag = false,
+        .configurationVersionMinorFlag = false,
+        .dataSetMessageType = DataSet_LL_MessageType_KeyFrame,
+        .timestampFlag = false,
+        .picoSecondsFlag = false,
+    };
+    SOPC_Dataset_LL_DataSetMsg_Set_ContentMask(msg_dsm, &conf);
+
+    // A single field larger than a message
+    SOPC_Variant* var = SOPC_Variant_Create();
+    ck_assert_ptr_nonnull(var);
+    var->BuiltInTypeId = SOPC_ByteString_Id;
+    var->ArrayType = SOPC_VariantArrayType_SingleValue;
+    SOPC_ByteString* bs = &var->Value.Bstring;
+    bs->Data = SOPC_Malloc(CHUNKED_BYTESTRING_LENGTH);
+    ck_assert_ptr_nonnull(bs->Data);
+    bs->Length = CHUNKED_BYTESTRING_LENGTH;
+    for (int32_t i = 0; i < bs->Length; i++)
+    {
+        bs->Data[i] = (SOPC_Byte)(i * 13);
+    }
+    res = SOPC_Dataset_LL_DataSetMsg_Set_DataSetField_Variant_At(msg_dsm, var, 0);
+    ck_assert_int_eq(true, res);
+
+    // The DataSetMessage does not fit in a single message
+    SOPC_Buffer* buffer = NULL;
+    SOPC_Buffer* buffer_payload = NULL;
+    SOPC_NetworkMessage_Error_Code code = SOPC_UADP_NetworkMessage_Encode_Buffers(nm, NULL, &buffer, &buffer_payload);
+    ck_assert_uint_eq(SOPC_UADP_NetworkMessage_Error_Write_MessageTooLarge, code);
+    ck_assert_ptr_null(buffer);
+    ck_assert_ptr_null(buffer_payload);
+
+    // Encode it in chunks
+    SOPC_Buffer* dsm_buffer = NULL;
+    code = SOPC_UADP_NetworkMessage_Encode_DataSetMessage(nm, 0, &dsm_buffer);
+    ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    ck_assert_ptr_nonnull(dsm_buffer);
+    ck_assert_uint_gt(dsm_buffer->length, CHUNKED_BYTESTRING_LENGTH);
+
+    SOPC_Buffer* chunks[MAX_CHUNKS] = {NULL};
+    size_t nbChunks = 0;
+    uint32_t chunkOffset = 0;
+    while (chunkOffset < dsm_buffer->length)
+    {
+        ck_assert_uint_lt(nbChunks, MAX_CHUNKS);
+        const uint32_t previousOffset = chunkOffset;
+        code = SOPC_UADP_NetworkMessage_Encode_Chunk(nm, NULL, 0, dsm_buffer, &chunkOffset, &chunks[nbChunks]);
+        ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, code);
+        ck_assert_ptr_nonnull(chunks[nbChunks]);
+        ck_assert_uint_le(chunks[nbChunks]->length, SOPC_PUBSUB_BUFFER_SIZE);
+        ck_assert_uint_gt(chunkOffset, previousOffset);
+        nbChunks++;
+    }
+    ck_assert_uint_eq(dsm_buffer->length, chunkOffset);
+    ck_assert_uint_ge(nbChunks, 3);
+
+    SOPC_DataSetReader* dsr[1];
+    SOPC_PubSubConfiguration* config = build_Sub_Config(dsr, 1);
+    ck_assert_ptr_nonnull(config);
+    SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0);
+    ck_assert_ptr_nonnull(connection);
+
+    SOPC_UADP_NetworkMessage_Reader_Configuration readerConf = {
+        .pGetSecurity_Func = NULL,
+        .callbacks = {.pGetGroup_Func = SOPC_Reader_NetworkMessage_Default_Readers.pGetGroup_Func,
+                      .pGetReader_Func = &getReader_JsonTest,
+                      .pSetDsm_Func = &setDsm_JsonTest},
+        .checkDataSetMessageSN_Func = NULL,
+        .targetConfig = NULL,
+        .chunks = NULL};
+
+    // Chunks are rejected without a reassembly context
+    SOPC_UADP_NetworkMessage* uadp_nm = NULL;
+    code = SOPC_UADP_NetworkMessage_Decode(chunks[0], &readerConf, connection, &uadp_nm);
+    ck_assert_uint_eq(SOPC_UADP_NetworkMessage_Error_Unsupported_Flags2, code);
+    ck_assert_ptr_null(uadp_nm);
+
+    readerConf.chunks = SOPC_UADP_Chunks_Reassembly_Create(2, SOPC_PUBSUB_MAX_CHUNKED_DSM_SIZE, 10000);
+    ck_assert_ptr_nonnull(readerConf.chunks);
+
+    // Chunks are received in reverse order and the last one is duplicated
+    for (size_t i = 0; i <= nbChunks; i++)
+    {
+        SOPC_Buffer* chunk = chunks[i < nbChunks ? nbChunks - 1 - i : 0];
+        SOPC_Buffer_SetPosition(chunk, 0);
+        code = SOPC_UADP_NetworkMessage_Decode(chunk, &readerConf, connection, &uadp_nm);
+        if (i + 1 < nbChunks)
+        {
+            ck_assert_uint_eq(SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete, code);
+            ck_assert_ptr_null(uadp_nm);
+            ck_assert_uint_eq(1, SOPC_UADP_Chunks_Reassembly_Nb_Pending(readerConf.chunks));
+        }
+        else if (i + 1 == nbChunks)
+        {
+            ck_assert_uint_eq(SOPC_NetworkMessage_Error_Code_None, code);
+            ck_assert_ptr_nonnull(uadp_nm);
+            ck_assert_uint_eq(0, SOPC_UADP_Chunks_Reassembly_Nb_Pending(readerConf.chunks));
+
+            ck_assert_uint_eq(1, SOPC_Dataset_LL_NetworkMessage_Nb_DataSetMsg(uadp_nm->nm));
+            const SOPC_Dataset_LL_DataSetMessage* dsm =
+                SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(uadp_nm->nm, 0);
+            ck_assert_uint_eq(DATASET_MSG_WRITER_ID_BASE, SOPC_Dataset_LL_DataSetMsg_Get_WriterId(dsm));
+            ck_assert_uint_eq(1, SOPC_Dataset_LL_DataSetMsg_Nb_DataSetField(dsm));
+            const SOPC_Variant* rcvVar = SOPC_Dataset_LL_DataSetMsg_Get_Variant_At(dsm, 0);
+            ck_assert_ptr_nonnull(rcvVar);
+            ck_assert_int_eq(SOPC_ByteString_Id, rcvVar->BuiltInTypeId);
+            ck_assert(SOPC_ByteString_Equal(bs, &rcvVar->Value.Bstring));
+            SOPC_UADP_NetworkMessage_Delete(uadp_nm);
+            uadp_nm = NULL;
+        }
+        else
+        {
+            // A chunk of an already reassembled DataSetMessage starts a new reassembly
+            ck_assert_uint_eq(SOPC_UADP_NetworkMessage_Error_Read_Chunk_Incomplete, code);
+            ck_assert_ptr_null(uadp_nm);
+        }
+    }
+
+    for (size_t i = 0; i < nbChunks; i++)
+    {
+        SOPC_Buffer_Delete(chunks[i]);
+    }
+    SOPC_UADP_Chunks_Reassembly_Delete(&readerConf.chunks);
+    ck_assert_ptr_null(readerConf.chunks);
+    SOPC_Buffer_Delete(dsm_buffer);
+    SOPC_PubSubConfiguration_Delete(config);
+    SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+}
+END_TEST
+
+START_TEST(test_hl_network_msg_chunks_reassembly_limits)
+{
+    const uint8_t data[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    SOPC_Conf_PublisherId pubId = {.type = SOPC_UInteger_PublisherId, .data.uint = NETWORK_MSG_PUBLISHER_ID};
+    SOPC_Buffer* dsmBuffer = NULL;
+
+    SOPC_UADP_Chunks_Reassembly* reassembly = SOPC_UADP_Chunks_Reassembly_Create(2, 40, 100);
+    ck_assert_ptr_nonnull(reassembly);
+
+    // Inconsistent chunks
+    SOPC_ReturnStatus status =
+        SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, 1, 10, 16, data, 8, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_INVALID_PARAMETERS, status);
+    status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, 1, 0, 0, data, 0, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_INVALID_PARAMETERS, status);
+    // DataSetMessage larger than the maximum memory
+    status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, 1, 0, 41, data, 8, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_INVALID_PARAMETERS, status);
+    ck_assert_uint_eq(0, SOPC_UADP_Chunks_Reassembly_Nb_Pending(reassembly));
+
+    // The oldest DataSetMessage is discarded when the maximum number is reached: the first chunk of SN 0 is lost
+    for (uint16_t sn = 0; sn < 3; sn++)
+    {
+        status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, sn, 0, 16, data, 8, &dsmBuffer);
+        ck_assert_int_eq(SOPC_STATUS_OK, status);
+        ck_assert_ptr_null(dsmBuffer);
+    }
+    ck_assert_uint_eq(2, SOPC_UADP_Chunks_Reassembly_Nb_Pending(reassembly));
+    status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, 0, 8, 16, data + 8, 8, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_ptr_null(dsmBuffer);
+    status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 1, 2, 8, 16, data + 8, 8, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_ptr_nonnull(dsmBuffer);
+    ck_assert_uint_eq(16, dsmBuffer->length);
+    ck_assert_int_eq(0, memcmp(data, dsmBuffer->data, sizeof(data)));
+    SOPC_Buffer_Delete(dsmBuffer);
+    dsmBuffer = NULL;
+
+    // The oldest DataSetMessage is discarded when the maximum memory is reached
+    ck_assert_uint_eq(1, SOPC_UADP_Chunks_Reassembly_Nb_Pending(reassembly));
+    status = SOPC_UADP_Chunks_Reassembly_Add(reassembly, &pubId, 2, 0, 0, 32, data, 8, &dsmBuffer);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_uint_eq(1, SOPC_UADP_Chunks_Reassembly_Nb_Pending(reassembly));
+
+    // Incomplete DataSetMessages are discarded after the timeout
+    SOPC_Sleep(150);
+    ck_assert_uint_eq(0, SOPC_UADP_Chunks_Reassembly_Nb_Pending(reassembly));
+
+    SOPC_UADP_Chunks_Reassembly_Delete(&reassembly);
+    ck_assert_ptr_null(reassembly);
+}
+END_TEST
+
 START_TEST(test_hl_network_msg_decode)
 {
     SOPC_Helper_Endianness_Check();
@@ -1213,6 +1641,73 @@ START_TEST(test_target_variable_layer)
 }
 END_TEST
 
+static int setTargetVariablesCb_BatchTest_nbCalls = 0;
+
+static bool setTargetVariablesCb_BatchTest(OpcUa_WriteValue* nodesToWrite, int32_t nbValues)
+{
+    setTargetVariablesCb_BatchTest_nbCalls++;
+    return setTargetVariablesCb(nodesToWrite, nbValues, NB_VARS);
+}
+
+START_TEST(test_target_variable_layer_batched)
+{
+    SOPC_Dataset_LL_NetworkMessage* nm = build_NetworkMessage_From_VarArr();
+    SOPC_DataSetReader* dsr[1];
+    SOPC_PubSubConfiguration* config = build_Sub_Config(dsr, 1);
+    ck_assert_ptr_nonnull(config);
+    const SOPC_Dataset_LL_DataSetMessage* dsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(nm, 0);
+
+    SOPC_SubTargetVariableConfig* targetConfig =
+        SOPC_SubTargetVariableConfig_CreateBatched(&setTargetVariablesCb_BatchTest, config);
+    ck_assert_ptr_nonnull(targetConfig);
+
+    // First values are passed immediately
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(1, setTargetVariablesCb_BatchTest_nbCalls);
+
+    // Values received during the batch are merged and passed once the batch is done
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(1, setTargetVariablesCb_BatchTest_nbCalls);
+    SOPC_SubTargetVariableConfig_BatchDone(targetConfig);
+    ck_assert_int_eq(2, setTargetVariablesCb_BatchTest_nbCalls);
+
+    // Nothing to pass
+    SOPC_SubTargetVariableConfig_BatchDone(targetConfig);
+    ck_assert_int_eq(2, setTargetVariablesCb_BatchTest_nbCalls);
+
+    // Values not passed are deleted with the configuration
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(3, setTargetVariablesCb_BatchTest_nbCalls);
+
+    // Values not passed and the batch in progress are dropped on reset: next values are passed immediately
+    SOPC_SubTargetVariableConfig_BatchReset(targetConfig);
+    SOPC_SubTargetVariableConfig_BatchDone(targetConfig);
+    ck_assert_int_eq(3, setTargetVariablesCb_BatchTest_nbCalls);
+    ck_assert_int_eq(true, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, dsm));
+    ck_assert_int_eq(4, setTargetVariablesCb_BatchTest_nbCalls);
+    SOPC_SubTargetVariableConfig_BatchDone(targetConfig);
+
+    // A value incompatible with the field metadata is not stored and the target variable is not updated
+    SOPC_Dataset_LL_NetworkMessage* invalidNm = build_NetworkMessage_From_VarArr();
+    SOPC_Dataset_LL_DataSetMessage* invalidDsm = SOPC_Dataset_LL_NetworkMessage_Get_DataSetMsg_At(invalidNm, 0);
+    SOPC_Variant* invalidVariant = SOPC_Variant_Create();
+    ck_assert_ptr_nonnull(invalidVariant);
+    invalidVariant->BuiltInTypeId = SOPC_Boolean_Id;
+    invalidVariant->Value.Boolean = true;
+    ck_assert_int_eq(true, SOPC_Dataset_LL_DataSetMsg_Set_DataSetField_Variant_At(invalidDsm, invalidVariant, 0));
+    ck_assert_int_eq(false, SOPC_SubTargetVariable_SetVariables(targetConfig, *dsr, invalidDsm));
+    SOPC_SubTargetVariableConfig_BatchDone(targetConfig);
+    ck_assert_int_eq(4, setTargetVariablesCb_BatchTest_nbCalls);
+
+    SOPC_SubTargetVariableConfig_Delete(targetConfig);
+    SOPC_PubSubConfiguration_Delete(config);
+    SOPC_Dataset_LL_NetworkMessage_Delete(invalidNm);
+    SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+}
+END_TEST
+
 /* Test Subscriber reader layer */
 
 static bool setTargetVariablesCb_ReaderTest_called = false;
@@ -1406,6 +1901,197 @@ START_TEST(test_subscriber_reader_layer)
 }
 END_TEST
 
+START_TEST(test_subscriber_reader_layer_indexed)
+{
+    // Same checks as above, with the readers lookup index (rebuilt after each configuration change)
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_Helper_Endianness_Check();
+
+    SOPC_DataSetReader* dsr[2];
+    SOPC_PubSubConfiguration* config = build_Sub_Config(dsr, 2);
+    ck_assert_ptr_nonnull(config);
+
+    SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0);
+    SOPC_ReaderGroup* readerGroup = SOPC_DataSetReader_Get_ReaderGroup(*dsr);
+
+    SOPC_SubTargetVariableConfig* targetConfig =
+        SOPC_SubTargetVariableConfig_Create(&setTargetVariablesCb_ReaderTest_Multi);
+
+    // NOMINAL: group without PublisherId
+    SOPC_ReturnStatus status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    setTargetVariablesCb_ReaderTest_nbVal = 0;
+    code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_int_eq(9, setTargetVariablesCb_ReaderTest_nbVal);
+
+    // NOMINAL: group indexed by PublisherId and GroupId, scratch state reused
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID);
+    status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    for (int i = 0; i < 2; i++)
+    {
+        setTargetVariablesCb_ReaderTest_nbVal = 0;
+        code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+        ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+        status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+        ck_assert_int_eq(SOPC_STATUS_OK, status);
+        ck_assert_int_eq(9, setTargetVariablesCb_ReaderTest_nbVal);
+    }
+
+    // WRONG PUBLISHER ID
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID + 1);
+    status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_NoMatchingGroup, code);
+    status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID);
+
+    // WRONG GROUP VERSION
+    SOPC_ReaderGroup_Set_GroupVersion(readerGroup, NETWORK_MSG_GROUP_VERSION + 1);
+    status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_NoMatchingGroup, code);
+    status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_ReaderGroup_Set_GroupVersion(readerGroup, NETWORK_MSG_GROUP_VERSION);
+
+    // WRONG DATA SET WRITER ID on first DSM
+    SOPC_DataSetReader_Set_DataSetWriterId(dsr[0], DATASET_MSG_WRITER_ID_BASE - 1);
+    status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    setTargetVariablesCb_ReaderTest_nbVal = 0;
+    code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    ck_assert_int_eq(4, setTargetVariablesCb_ReaderTest_nbVal);
+
+    // WRONG DATA SET WRITER ID on both DSM
+    SOPC_DataSetReader_Set_DataSetWriterId(dsr[1], DATASET_MSG_WRITER_ID_BASE - 2);
+    status = SOPC_Reader_Index_Connection(connection);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    code = SOPC_Reader_Read_UADP(connection, &encoded_network_msg2, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_NoMatchingReader, code);
+    status = SOPC_Buffer_SetPosition(&encoded_network_msg2, 0);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+
+    // UNINIT
+    SOPC_Reader_Clear_Index(connection);
+    ck_assert_ptr_null(SOPC_PubSubConnection_Get_ReaderIndex(connection));
+    ck_assert_ptr_null(SOPC_ReaderGroup_Get_ReaderIndex(readerGroup));
+    SOPC_SubTargetVariableConfig_Delete(targetConfig);
+    SOPC_PubSubConfiguration_Delete(config);
+}
+END_TEST
+
+/* A JSON message from another vendor: non-reversible encoding, fields typed by the reader FieldMetaData */
+static const char* json_non_reversible_msg =
+    " {\"MessageId\":\"8a7f\",\"MessageType\":\"ua-data\",\"PublisherId\":\"46\",\"Messages\":[{"
+    "\"DataSetWriterId\":255,\"SequenceNumber\":3,\"MessageType\":\"ua-keyframe\","
+    "\"Timestamp\":\"2022-06-30T12:00:00Z\","
+    "\"Payload\":{\"Counter\":12071982,\"Level\":239,\"Speed\":64852,\"Ratio\":0.12,\"Total\":369852}}]}\n";
+
+/* A single DataSetMessage without NetworkMessage header */
+static const char* json_single_dsm_msg =
+    "{\"DataSetWriterId\":255,\"Payload\":{\"a\":12071982,\"b\":239,\"c\":64852,\"d\":1.2e-1,\"e\":369852}}";
+
+static SOPC_NetworkMessage_Error_Code read_JSON_String(SOPC_PubSubConnection* connection,
+                                                       SOPC_SubTargetVariableConfig* targetConfig,
+                                                       const char* message)
+{
+    const uint32_t length = (uint32_t) strlen(message);
+    SOPC_Buffer* buffer = SOPC_Buffer_Create(length);
+    ck_assert_ptr_nonnull(buffer);
+    SOPC_ReturnStatus status = SOPC_Buffer_Write(buffer, (const uint8_t*) message, length);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_Buffer_SetPosition(buffer, 0);
+    SOPC_NetworkMessage_Error_Code code = SOPC_Reader_Read_JSON(connection, buffer, targetConfig, NULL, NULL);
+    SOPC_Buffer_Delete(buffer);
+    return code;
+}
+
+START_TEST(test_subscriber_reader_layer_json)
+{
+    SOPC_NetworkMessage_Error_Code code = SOPC_NetworkMessage_Error_Code_None;
+    SOPC_Helper_Endianness_Check();
+
+    SOPC_DataSetReader* dsr[1];
+    SOPC_PubSubConfiguration* config = build_Sub_Config(dsr, 1);
+    ck_assert_ptr_nonnull(config);
+
+    SOPC_PubSubConnection* connection = SOPC_PubSubConfiguration_Get_SubConnection_At(config, 0);
+    SOPC_ReaderGroup* readerGroup = SOPC_DataSetReader_Get_ReaderGroup(*dsr);
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID);
+
+    SOPC_SubTargetVariableConfig* targetConfig = SOPC_SubTargetVariableConfig_Create(&setTargetVariablesCb_ReaderTest);
+
+    // NOMINAL: round trip of a message encoded by the publisher
+    SOPC_Dataset_LL_NetworkMessage* nm = build_NetworkMessage_From_VarArr();
+    SOPC_Buffer* buffer = NULL;
+    code = SOPC_JSON_NetworkMessage_Encode(nm, NULL, &buffer);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+
+    setTargetVariablesCb_ReaderTest_called = false;
+    code = SOPC_Reader_Read_JSON(connection, buffer, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    ck_assert_int_eq(true, setTargetVariablesCb_ReaderTest_called);
+    setTargetVariablesCb_ReaderTest_called = false;
+
+    // WRONG PUBLISHER ID
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID + 1);
+    SOPC_Buffer_SetPosition(buffer, 0);
+    code = SOPC_Reader_Read_JSON(connection, buffer, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_NoMatchingGroup, code);
+    ck_assert_int_eq(false, setTargetVariablesCb_ReaderTest_called);
+    SOPC_ReaderGroup_Set_PublisherId_UInteger(readerGroup, NETWORK_MSG_PUBLISHER_ID);
+
+    // WRONG DATA SET WRITER ID
+    SOPC_DataSetReader_Set_DataSetWriterId(*dsr, DATASET_MSG_WRITER_ID_BASE + 1);
+    SOPC_Buffer_SetPosition(buffer, 0);
+    code = SOPC_Reader_Read_JSON(connection, buffer, targetConfig, NULL, NULL);
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_NoMatchingReader, code);
+    ck_assert_int_eq(false, setTargetVariablesCb_ReaderTest_called);
+    SOPC_DataSetReader_Set_DataSetWriterId(*dsr, DATASET_MSG_WRITER_ID_BASE);
+    SOPC_Buffer_Delete(buffer);
+    SOPC_Dataset_LL_NetworkMessage_Delete(nm);
+
+    // Non-reversible encoding and single DataSetMessage
+    code = read_JSON_String(connection, targetConfig, json_non_reversible_msg);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    ck_assert_int_eq(true, setTargetVariablesCb_ReaderTest_called);
+    setTargetVariablesCb_ReaderTest_called = false;
+
+    code = read_JSON_String(connection, targetConfig, json_single_dsm_msg);
+    ck_assert_int_eq(SOPC_NetworkMessage_Error_Code_None, code);
+    ck_assert_int_eq(true, setTargetVariablesCb_ReaderTest_called);
+    setTargetVariablesCb_ReaderTest_called = false;
+
+    // Invalid messages
+    code = read_JSON_String(connection, targetConfig, "{\"MessageType\":\"ua-metadata\",\"Messages\":[]}");
+    ck_assert_int_eq(SOPC_JSON_NetworkMessage_Error_Read_MessageType, code);
+    code = read_JSON_String(connection, targetConfig, "{\"Messages\":[{\"DataSetWriterId\":255,\"Payload\":{}},]}");
+    ck_assert_int_eq(SOPC_JSON_NetworkMessage_Error_Read_Syntax, code);
+    code = read_JSON_String(connection, targetConfig, "[{\"DataSetWriterId\":255,\"Payload\":{\"a\":-1}}]");
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_DsmFields_Failed, code);
+    code = read_JSON_String(connection, targetConfig, "[{\"DataSetWriterId\":255,\"Payload\":{\"a\":1}}] x");
+    ck_assert_int_eq(SOPC_JSON_NetworkMessage_Error_Read_Syntax, code);
+    // Fields do not match the reader FieldMetaData
+    code = read_JSON_String(connection, targetConfig, "[{\"DataSetWriterId\":255,\"Payload\":{\"a\":1}}]");
+    ck_assert_int_eq(SOPC_UADP_NetworkMessage_Error_Read_BadMetaData, code);
+    ck_assert_int_eq(false, setTargetVariablesCb_ReaderTest_called);
+
+    // UNINIT
+    SOPC_SubTargetVariableConfig_Delete(targetConfig);
+    SOPC_PubSubConfiguration_Delete(config);
+}
+END_TEST
+
 /* Test source variable layer */
 static SOPC_PubSubConfiguration* build_Pub_Config(SOPC_PublishedDataSet** out_pds)
 {
@@ -1663,6 +2349,68 @@ START_TEST(test_dataset_layer)
 }
 END_TEST
 
+#define KEY_RING_TEST_NB_KEYS 3
+#define KEY_RING_TEST_KEY_LIFETIME 10000
+
+START_TEST(test_sks_key_ring)
+{
+    SOPC_PubSubSKS_Init();
+    SOPC_SKManager* skm = SOPC_SKManager_Create();
+    ck_assert_ptr_nonnull(skm);
+    SOPC_String policy;
+    SOPC_String_Initialize(&policy);
+    SOPC_ReturnStatus status = SOPC_String_CopyFromCString(&policy, SOPC_PUBSUB_SECURITY_POLICY);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_ByteString keys[KEY_RING_TEST_NB_KEYS];
+    SOPC_Byte keyData[32 + 32 + 4];
+    for (uint32_t i = 0; i < KEY_RING_TEST_NB_KEYS; i++)
+    {
+        memset(keyData, (int) i, sizeof(keyData));
+        SOPC_ByteString_Initialize(&keys[i]);
+        status = SOPC_ByteString_CopyFromBytes(&keys[i], keyData, (int32_t) sizeof(keyData));
+        ck_assert_int_eq(SOPC_STATUS_OK, status);
+    }
+    status = SOPC_SKManager_SetKeys(skm, &policy, 1, keys, KEY_RING_TEST_NB_KEYS, KEY_RING_TEST_KEY_LIFETIME,
+                                    KEY_RING_TEST_KEY_LIFETIME);
+    ck_assert_int_eq(SOPC_STATUS_OK, status);
+    SOPC_PubSubSKS_SetSkManager(skm);
+
+    ck_assert_ptr_null(SOPC_PubSubSKS_KeyRing_Create(SOPC_PUBSUB_SKS_DEFAULT_GROUPID + 1));
+    SOPC_PubSubSKS_KeyRing* ring = SOPC_PubSubSKS_KeyRing_Create(SOPC_PUBSUB_SKS_DEFAULT_GROUPID);
+    ck_assert_ptr_nonnull(ring);
+
+    SOPC_PubSubSKS_Keys* current = SOPC_PubSubSKS_KeyRing_GetKeys(ring, SOPC_PUBSUB_SKS_CURRENT_TOKENID);
+    ck_assert_ptr_nonnull(current);
+    ck_assert_uint_eq(1, current->tokenId);
+    ck_assert_ptr_nonnull(current->signingKey);
+    ck_assert_ptr_nonnull(current->encryptKey);
+    ck_assert_ptr_nonnull(current->keyNonce);
+    // The keys are not copied on lookup
+    ck_assert_ptr_eq(current, SOPC_PubSubSKS_KeyRing_GetKeys(ring, 1));
+
+    // The future keys were retrieved with the current one: they are available without the manager
+    SOPC_PubSubSKS_SetSkManager(NULL);
+    for (uint32_t tokenId = 1; tokenId <= KEY_RING_TEST_NB_KEYS; tokenId++)
+    {
+        SOPC_PubSubSKS_Keys* ringKeys = SOPC_PubSubSKS_KeyRing_GetKeys(ring, tokenId);
+        ck_assert_ptr_nonnull(ringKeys);
+        ck_assert_uint_eq(tokenId, ringKeys->tokenId);
+    }
+    ck_assert_ptr_eq(current, SOPC_PubSubSKS_KeyRing_GetKeys(ring, SOPC_PUBSUB_SKS_CURRENT_TOKENID));
+    ck_assert_ptr_null(SOPC_PubSubSKS_KeyRing_GetKeys(ring, KEY_RING_TEST_NB_KEYS + 1));
+
+    SOPC_PubSubSKS_KeyRing_Delete(&ring);
+    ck_assert_ptr_null(ring);
+    for (uint32_t i = 0; i < KEY_RING_TEST_NB_KEYS; i++)
+    {
+        SOPC_ByteString_Clear(&keys[i]);
+    }
+    SOPC_String_Clear(&policy);
+    SOPC_SKManager_Clear(skm);
+    SOPC_Free(skm);
+}
+END_TEST
+
 int main(void)
 {
     int number_failed;
@@ -1677,8 +2425,12 @@ int main(void)
     TCase* tc_hl_network_msg = tcase_create("Network message layer");
     suite_add_tcase(suite, tc_hl_network_msg);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_encode_json);
+    tcase_add_test(tc_hl_network_msg, test_hl_network_msg_decode_json);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_encode);
+    tcase_add_test(tc_hl_network_msg, test_hl_network_msg_encode_preencoded_secured);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_decode);
+    tcase_add_test(tc_hl_network_msg, test_hl_network_msg_chunks);
+    tcase_add_test(tc_hl_network_msg, test_hl_network_msg_chunks_reassembly_limits);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_encode_multi_dsm);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_decode_multi_dsm);
     tcase_add_test(tc_hl_network_msg, test_hl_network_msg_decode_multi_dsm_nok);
@@ -1689,11 +2441,14 @@ int main(void)
     TCase* tc_sub_target_variable_layer = tcase_create("Subscriber target variable layer");
     suite_add_tcase(suite, tc_sub_target_variable_layer);
     tcase_add_test(tc_sub_target_variable_layer, test_target_variable_layer);
+    tcase_add_test(tc_sub_target_variable_layer, test_target_variable_layer_batched);
 
     TCase* tc_sub_reader_layer = tcase_create("Subscriber reader layer");
     suite_add_tcase(suite, tc_sub_reader_layer);
     tcase_add_test(tc_sub_reader_layer, test_subscriber_reader_layer);
     tcase_add_test(tc_sub_reader_layer, test_subscriber_reader_layer_multi_dsm);
+    tcase_add_test(tc_sub_reader_layer, test_subscriber_reader_layer_indexed);
+    tcase_add_test(tc_sub_reader_layer, test_subscriber_reader_layer_json);
 
     TCase* tc_pub_source_variable_layer = tcase_create("Publisher source variable layer");
     suite_add_tcase(suite, tc_pub_source_variable_layer);
@@ -1703,6 +2458,10 @@ int main(void)
     suite_add_tcase(suite, tc_dataset_layer);
     tcase_add_test(tc_dataset_layer, test_dataset_layer);
 
+    TCase* tc_sks = tcase_create("PubSub security keys");
+    suite_add_tcase(suite, tc_sks);
+    tcase_add_test(tc_sks, test_sks_key_ring);
+
     sr = srunner_create(suite);
 
     srunner_run_all(sr, CK_NORMAL);